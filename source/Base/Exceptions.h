@@ -20,6 +20,16 @@ public:
     {}
 };
 
+//a device memory allocation failed; unlike other CUDA errors this leaves the device context
+//intact, so the engine attempts an in-process recovery instead of requiring a restart
+class CudaMemoryAllocationException : public std::runtime_error
+{
+public:
+    CudaMemoryAllocationException(std::string const& what)
+        : std::runtime_error(what.c_str())
+    {}
+};
+
 class SystemRequirementNotMetException : public std::runtime_error
 {
 public:
@@ -0,0 +1,41 @@
+#include "IntervalPacer.h"
+
+#include <algorithm>
+#include <thread>
+
+namespace
+{
+    //the OS timer quantum can round a sleep up by a millisecond or more, so sleeps stop short of
+    //the deadline by this margin and the remaining time is spun on the clock
+    auto constexpr SpinMargin = std::chrono::microseconds(2000);
+
+    //sleeps are sliced so that the idle action runs at a bounded latency even for long intervals
+    auto constexpr MaxSleepSlice = std::chrono::microseconds(1000);
+}
+
+void IntervalPacer::pace(std::chrono::microseconds const& interval, std::function<void()> const& idleAction)
+{
+    auto now = std::chrono::steady_clock::now();
+    if (!_nextDeadline || now > *_nextDeadline + interval) {
+
+        //first call or the loop fell behind by more than one interval: resynchronize instead of
+        //bursting to catch up
+        _nextDeadline = now + interval;
+    }
+    auto deadline = *_nextDeadline;
+    while (now < deadline) {
+        if (deadline - now > SpinMargin) {
+            std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(deadline - SpinMargin - now, MaxSleepSlice));
+        }
+        if (idleAction) {
+            idleAction();
+        }
+        now = std::chrono::steady_clock::now();
+    }
+    _nextDeadline = deadline + interval;
+}
+
+void IntervalPacer::reset()
+{
+    _nextDeadline.reset();
+}
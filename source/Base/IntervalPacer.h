@@ -0,0 +1,25 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+
+/**
+ * Paces a periodic loop to a target interval. Most of the wait is a coarse OS sleep and the final
+ * stretch before the deadline is spun on the clock, so the achieved rate does not depend on the
+ * OS timer quantum. The next deadline is derived from the previous one instead of "now", so sleep
+ * and scheduling overshoot does not accumulate into a lower average rate.
+ */
+class IntervalPacer
+{
+public:
+    //blocks until the next interval boundary; idleAction (optional) is invoked repeatedly while
+    //waiting so that the caller can keep serving requests during the wait
+    void pace(std::chrono::microseconds const& interval, std::function<void()> const& idleAction = nullptr);
+
+    //forgets the current deadline; the next pace call starts a fresh cycle
+    void reset();
+
+private:
+    std::optional<std::chrono::steady_clock::time_point> _nextDeadline;
+};
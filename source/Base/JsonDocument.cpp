@@ -0,0 +1,299 @@
+#include "JsonDocument.h"
+
+#include <cstdio>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace
+{
+    void appendEscaped(std::string& result, std::string const& value)
+    {
+        for (auto const& c : value) {
+            switch (c) {
+            case '"':
+                result += "\\\"";
+                break;
+            case '\\':
+                result += "\\\\";
+                break;
+            case '\n':
+                result += "\\n";
+                break;
+            case '\r':
+                result += "\\r";
+                break;
+            case '\t':
+                result += "\\t";
+                break;
+            case '\b':
+                result += "\\b";
+                break;
+            case '\f':
+                result += "\\f";
+                break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    char buffer[8];
+                    std::snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                    result += buffer;
+                } else {
+                    result += c;
+                }
+            }
+        }
+    }
+
+    std::vector<std::string> splitPath(char const* path)
+    {
+        std::vector<std::string> result;
+        auto start = path;
+        for (auto pos = path;; ++pos) {
+            if (*pos == '.' || *pos == '\0') {
+                result.emplace_back(start, pos);
+                if (*pos == '\0') {
+                    break;
+                }
+                start = pos + 1;
+            }
+        }
+        return result;
+    }
+
+    //minimal recursive-descent parser for the object/scalar subset the settings files consist of
+    class Parser
+    {
+    public:
+        Parser(std::string const& json, JsonDocument& doc)
+            : _json(json)
+            , _doc(doc)
+        {}
+
+        void run()
+        {
+            skipWhitespace();
+            parseObject(std::string());
+            skipWhitespace();
+        }
+
+    private:
+        void parseObject(std::string const& pathPrefix)
+        {
+            expect('{');
+            skipWhitespace();
+            if (peek() == '}') {
+                ++_pos;
+                return;
+            }
+            for (;;) {
+                skipWhitespace();
+                auto key = parseString();
+                skipWhitespace();
+                expect(':');
+                skipWhitespace();
+                auto path = pathPrefix.empty() ? key : pathPrefix + "." + key;
+                if (peek() == '{') {
+                    parseObject(path);
+                } else {
+                    _doc.put(path, parseScalar());
+                }
+                skipWhitespace();
+                auto c = next();
+                if (c == '}') {
+                    return;
+                }
+                if (c != ',') {
+                    fail();
+                }
+            }
+        }
+
+        std::string parseString()
+        {
+            expect('"');
+            std::string result;
+            for (;;) {
+                auto c = next();
+                if (c == '"') {
+                    return result;
+                }
+                if (c != '\\') {
+                    result += c;
+                    continue;
+                }
+                auto escaped = next();
+                switch (escaped) {
+                case '"': result += '"'; break;
+                case '\\': result += '\\'; break;
+                case '/': result += '/'; break;
+                case 'n': result += '\n'; break;
+                case 'r': result += '\r'; break;
+                case 't': result += '\t'; break;
+                case 'b': result += '\b'; break;
+                case 'f': result += '\f'; break;
+                case 'u': {
+                    //settings values are ascii; non-ascii escapes are taken over literally
+                    int code = 0;
+                    for (int i = 0; i < 4; ++i) {
+                        auto digit = next();
+                        code = code * 16
+                            + (digit >= 'a' ? digit - 'a' + 10 : digit >= 'A' ? digit - 'A' + 10 : digit - '0');
+                    }
+                    result += static_cast<char>(code);
+                } break;
+                default:
+                    fail();
+                }
+            }
+        }
+
+        std::string parseScalar()
+        {
+            auto c = peek();
+            if (c == '"') {
+                return parseString();
+            }
+            if (c == '[') {
+                fail();  //the settings files contain no arrays
+            }
+            auto start = _pos;
+            while (_pos < _json.size() && _json[_pos] != ',' && _json[_pos] != '}' && !isWhitespace(_json[_pos])) {
+                ++_pos;
+            }
+            if (_pos == start) {
+                fail();
+            }
+            return _json.substr(start, _pos - start);  //number, true, false or null as literal text
+        }
+
+        static bool isWhitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+        void skipWhitespace()
+        {
+            while (_pos < _json.size() && isWhitespace(_json[_pos])) {
+                ++_pos;
+            }
+        }
+
+        char peek() const
+        {
+            if (_pos >= _json.size()) {
+                fail();
+            }
+            return _json[_pos];
+        }
+
+        char next()
+        {
+            auto result = peek();
+            ++_pos;
+            return result;
+        }
+
+        void expect(char c)
+        {
+            if (next() != c) {
+                fail();
+            }
+        }
+
+        [[noreturn]] static void fail() { throw std::runtime_error("The json settings data could not be parsed."); }
+
+        std::string const& _json;
+        JsonDocument& _doc;
+        size_t _pos = 0;
+    };
+}
+
+void JsonDocument::put(std::string const& path, std::string value)
+{
+    auto internedPath = internPath(path);
+    auto findResult = _indexByPath.find(internedPath);
+    if (findResult != _indexByPath.end()) {
+        _entries[findResult->second].value = std::move(value);
+        return;
+    }
+    _indexByPath.emplace(internedPath, toInt(_entries.size()));
+    _entries.emplace_back(Entry{internedPath, std::move(value)});
+}
+
+std::optional<std::string> JsonDocument::get(std::string const& path) const
+{
+    auto findResult = _indexByPath.find(internPath(path));
+    if (findResult == _indexByPath.end()) {
+        return std::nullopt;
+    }
+    return _entries[findResult->second].value;
+}
+
+std::string JsonDocument::toJson() const
+{
+    std::string result;
+    result.reserve(_entries.size() * 64);
+    result += "{\n";
+
+    std::vector<std::string> openGroups;
+    auto indent = [&result](size_t depth) { result.append(4 * (depth + 1), ' '); };
+
+    auto first = true;
+    for (auto const& entry : _entries) {
+        auto components = splitPath(entry.path);
+
+        //close the groups the current path has left and open the ones it enters
+        size_t commonDepth = 0;
+        while (commonDepth < openGroups.size() && commonDepth + 1 < components.size()
+               && openGroups[commonDepth] == components[commonDepth]) {
+            ++commonDepth;
+        }
+        for (auto depth = openGroups.size(); depth > commonDepth; --depth) {
+            result += "\n";
+            indent(depth - 1);
+            result += "}";
+        }
+        openGroups.resize(commonDepth);
+
+        if (!first) {
+            result += ",\n";
+        }
+        first = false;
+
+        for (size_t depth = commonDepth; depth + 1 < components.size(); ++depth) {
+            indent(depth);
+            result += "\"";
+            appendEscaped(result, components[depth]);
+            result += "\": {\n";
+            openGroups.emplace_back(components[depth]);
+        }
+
+        indent(components.size() - 1);
+        result += "\"";
+        appendEscaped(result, components.back());
+        result += "\": \"";
+        appendEscaped(result, entry.value);
+        result += "\"";
+    }
+
+    for (auto depth = openGroups.size(); depth > 0; --depth) {
+        result += "\n";
+        indent(depth - 1);
+        result += "}";
+    }
+    result += "\n}\n";
+    return result;
+}
+
+JsonDocument JsonDocument::fromJson(std::string const& json)
+{
+    JsonDocument result;
+    Parser(json, result).run();
+    return result;
+}
+
+char const* JsonDocument::internPath(std::string const& path)
+{
+    static std::mutex mutex;
+    static std::unordered_set<std::string> internedPaths;
+
+    std::lock_guard<std::mutex> lock(mutex);
+    return internedPaths.insert(path).first->c_str();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Definitions.h"
+
+//flat json document for the settings codec: the values are stored as strings against their dotted
+//paths (e.g. "general.world size.x"), which avoids the per-node allocations of a generic tree.
+//The path keys are interned process-wide, so parsing many settings files allocates each distinct
+//key once and the index hashes pointers instead of strings
+class JsonDocument
+{
+public:
+    void put(std::string const& path, std::string value);
+    std::optional<std::string> get(std::string const& path) const;
+
+    //nested, pretty-printed json with quoted scalars, matching the layout the previous
+    //boost::property_tree backend produced, so the files stay interchangeable
+    std::string toJson() const;
+    static JsonDocument fromJson(std::string const& json);
+
+private:
+    static char const* internPath(std::string const& path);
+
+    struct Entry
+    {
+        char const* path;  //interned
+        std::string value;
+    };
+    std::vector<Entry> _entries;  //in insertion order, which defines the output layout
+    std::unordered_map<char const*, int> _indexByPath;
+};
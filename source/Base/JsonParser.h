@@ -1,9 +1,9 @@
 #pragma once
 
-#include <boost/property_tree/ptree.hpp>
 #include <boost/algorithm/string.hpp>
 
 #include "Definitions.h"
+#include "JsonDocument.h"
 
 enum class ParserTask
 {
@@ -16,7 +16,7 @@ class JsonParser
 public:
     template <typename T>
     static void encodeDecode(
-        boost::property_tree::ptree& tree,
+        JsonDocument& doc,
         T& parameter,
         T const& defaultValue,
         std::string const& node,
@@ -28,7 +28,7 @@ public:
  */
 template <typename T>
 void JsonParser::encodeDecode(
-    boost::property_tree::ptree& tree,
+    JsonDocument& doc,
     T& parameter,
     T const& defaultValue,
     std::string const& node,
@@ -36,18 +36,33 @@ void JsonParser::encodeDecode(
 {
     if (ParserTask::Encode == task) {
         if constexpr (std::is_same<T, bool>::value) {
-            tree.put(node, parameter ? "true" : "false");
+            doc.put(node, parameter ? "true" : "false");
         } else if constexpr (std::is_same<T, std::string>::value) {
-            tree.put(node, parameter);
+            doc.put(node, parameter);
         } else {
-            tree.put(node, std::to_string(parameter));
+            doc.put(node, std::to_string(parameter));
         }
     } else {
-        if constexpr (std::is_same<T, std::string>::value) {
-            parameter = tree.get<std::string>(node, defaultValue);
-            boost::algorithm::to_lower(parameter);
-        } else {
-            parameter = tree.get<T>(node, defaultValue);
+        auto value = doc.get(node);
+        if (!value) {
+            parameter = defaultValue;
+            return;
+        }
+        try {
+            if constexpr (std::is_same<T, std::string>::value) {
+                parameter = *value;
+                boost::algorithm::to_lower(parameter);
+            } else if constexpr (std::is_same<T, bool>::value) {
+                parameter = *value == "true" || *value == "1";
+            } else if constexpr (std::is_floating_point<T>::value) {
+                parameter = static_cast<T>(std::stod(*value));
+            } else if constexpr (std::is_unsigned<T>::value) {
+                parameter = static_cast<T>(std::stoull(*value));
+            } else {
+                parameter = static_cast<T>(std::stoll(*value));
+            }
+        } catch (...) {
+            parameter = defaultValue;
         }
     }
 }
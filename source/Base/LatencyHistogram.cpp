@@ -0,0 +1,47 @@
+#include "LatencyHistogram.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    auto constexpr MinDurationInMs = 0.001;  //1 us
+}
+
+void LatencyHistogram::addSample(double durationInMs)
+{
+    auto bucket = 0;
+    if (durationInMs > MinDurationInMs) {
+        bucket = std::min(static_cast<int>(std::log10(durationInMs / MinDurationInMs) * BucketsPerDecade), NumBuckets - 1);
+    }
+    ++_counts[bucket];
+    ++_numSamples;
+}
+
+uint64_t LatencyHistogram::getNumSamples() const
+{
+    return _numSamples;
+}
+
+double LatencyHistogram::getPercentileInMs(double fraction) const
+{
+    if (0 == _numSamples) {
+        return 0;
+    }
+    auto threshold = std::max(static_cast<uint64_t>(std::ceil(fraction * _numSamples)), uint64_t(1));
+    uint64_t cumulated = 0;
+    for (int bucket = 0; bucket < NumBuckets; ++bucket) {
+        cumulated += _counts[bucket];
+        if (cumulated >= threshold) {
+            //upper bound of the bucket
+            return MinDurationInMs * std::pow(10.0, static_cast<double>(bucket + 1) / BucketsPerDecade);
+        }
+    }
+    return MinDurationInMs * std::pow(10.0, static_cast<double>(NumBuckets) / BucketsPerDecade);
+}
+
+void LatencyHistogram::reset()
+{
+    _counts.fill(0);
+    _numSamples = 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+//lightweight latency histogram with logarithmic buckets from 1 us to ~100 s; recording a sample
+//is a single increment, percentiles are derived from the cumulative bucket counts
+class LatencyHistogram
+{
+public:
+    void addSample(double durationInMs);
+
+    uint64_t getNumSamples() const;
+    double getPercentileInMs(double fraction) const;  //fraction in (0, 1], e.g. 0.95 for p95
+
+    void reset();
+
+private:
+    static auto constexpr BucketsPerDecade = 20;
+    static auto constexpr NumBuckets = 8 * BucketsPerDecade;
+
+    std::array<uint64_t, NumBuckets> _counts{};
+    uint64_t _numSamples = 0;
+};
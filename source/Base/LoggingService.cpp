@@ -1,10 +1,9 @@
 #include "LoggingService.h"
 
-#include <iostream>
+#include <algorithm>
+#include <chrono>
 #include <iomanip>
-#include <ctime>
 #include <sstream>
-#include <algorithm>
 
 LoggingService& LoggingService::getInstance()
 {
@@ -12,30 +11,107 @@ LoggingService& LoggingService::getInstance()
     return instance;
 }
 
-void LoggingService::log(Priority priority, std::string const& message)
+LoggingService::LoggingService()
 {
-    std::lock_guard<std::mutex> lock(_mutex);
-
-    auto t = std::time(nullptr);
-    auto tm = *std::localtime(&t);
+    _buffer = std::make_unique<Entry[]>(BufferSize);
+    for (uint64_t i = 0; i < BufferSize; ++i) {
+        _buffer[i].sequenceNumber.store(i, std::memory_order_relaxed);
+    }
+    _flushThread = std::thread(&LoggingService::flushLoop, this);
+}
 
-    std::stringstream stream;
-    stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+LoggingService::~LoggingService()
+{
+    _terminate.store(true, std::memory_order_release);
+    _conditionVariable.notify_one();
+    if (_flushThread.joinable()) {
+        _flushThread.join();
+    }
+}
 
-    auto enrichedMessage = stream.str();
-    for (auto const& callback : _callbacks) {
-        callback->newLogMessage(priority, enrichedMessage);
+void LoggingService::log(Priority priority, std::string const& message)
+{
+    auto pos = _enqueuePos.load(std::memory_order_relaxed);
+    for (;;) {
+        auto& entry = _buffer[pos & (BufferSize - 1)];
+        auto sequenceNumber = entry.sequenceNumber.load(std::memory_order_acquire);
+        auto diff = static_cast<int64_t>(sequenceNumber) - static_cast<int64_t>(pos);
+        if (0 == diff) {
+            if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                entry.priority = priority;
+                entry.timestamp = std::time(nullptr);
+                entry.message = message;
+                entry.sequenceNumber.store(pos + 1, std::memory_order_release);
+                _conditionVariable.notify_one();
+                return;
+            }
+        } else if (diff < 0) {
+            //ring full: the flush thread is behind on IO; dropping is preferred over stalling the
+            //calling thread, and the drop is reported once the flush thread catches up
+            _numDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        } else {
+            pos = _enqueuePos.load(std::memory_order_relaxed);
+        }
     }
 }
 
 void LoggingService::registerCallBack(LoggingCallBack* callback)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     _callbacks.emplace_back(callback);
 }
 
 void LoggingService::unregisterCallBack(LoggingCallBack* callback)
 {
+    std::lock_guard<std::mutex> lock(_mutex);
     auto end = std::remove_if(_callbacks.begin(), _callbacks.end(), [&](auto const& callback_) { return callback_ == callback; });
 
     _callbacks.erase(end, _callbacks.end());
 }
+
+void LoggingService::flushLoop()
+{
+    for (;;) {
+        auto idle = true;
+
+        auto& entry = _buffer[_dequeuePos & (BufferSize - 1)];
+        if (entry.sequenceNumber.load(std::memory_order_acquire) == _dequeuePos + 1) {
+            auto priority = entry.priority;
+            auto tm = *std::localtime(&entry.timestamp);
+            auto message = std::move(entry.message);
+            entry.message = std::string();
+            entry.sequenceNumber.store(_dequeuePos + BufferSize, std::memory_order_release);
+            ++_dequeuePos;
+
+            std::stringstream stream;
+            stream << std::put_time(&tm, "%Y-%m-%d %H-%M-%S") << ": " << message;
+            dispatch(priority, stream.str());
+            idle = false;
+        }
+
+        if (auto numDropped = _numDroppedMessages.exchange(0, std::memory_order_relaxed)) {
+            std::stringstream stream;
+            stream << numDropped << " log message(s) dropped due to logging backlog";
+            dispatch(Priority::Important, stream.str());
+            idle = false;
+        }
+
+        if (idle) {
+            //terminate only when the ring is drained, so pending messages still reach the log file
+            if (_terminate.load(std::memory_order_acquire)) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _conditionVariable.wait_for(lock, std::chrono::milliseconds(100));
+        }
+    }
+}
+
+void LoggingService::dispatch(Priority priority, std::string const& message)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (auto const& callback : _callbacks) {
+        callback->newLogMessage(priority, message);
+    }
+}
@@ -1,8 +1,13 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
+#include <ctime>
+#include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
-#include <mutex>
 
 enum class Priority
 {
@@ -21,17 +26,46 @@ class LoggingService
 public:
     static LoggingService& getInstance();
 
+    //never blocks on the callbacks: the message is placed into a bounded ring and the timestamp
+    //formatting and the callback IO happen on a dedicated flush thread; when the ring is full the
+    //message is dropped and the drop is reported later
     void log(Priority priority, std::string const& message);
 
     void registerCallBack(LoggingCallBack* callback);
     void unregisterCallBack(LoggingCallBack* callback);
 
 private:
+    LoggingService();
+    ~LoggingService();
+
+    void flushLoop();
+    void dispatch(Priority priority, std::string const& message);
+
+    struct Entry
+    {
+        //Vyukov-style slot sequencing: equal to the slot position when free for writing and to
+        //position + 1 when the message is published
+        std::atomic<uint64_t> sequenceNumber;
+        Priority priority;
+        std::time_t timestamp;
+        std::string message;
+    };
+    static auto constexpr BufferSize = 8192;  //must be a power of two
+
+    std::unique_ptr<Entry[]> _buffer;
+    std::atomic<uint64_t> _enqueuePos{0};
+    uint64_t _dequeuePos = 0;  //only touched by the flush thread
+    std::atomic<uint64_t> _numDroppedMessages{0};
+
+    std::mutex _mutex;  //guards _callbacks; dispatch runs under it, so unregisterCallBack cannot return mid-call
     std::vector<LoggingCallBack*> _callbacks;
-    std::mutex _mutex;
+
+    std::condition_variable _conditionVariable;
+    std::atomic<bool> _terminate{false};
+    std::thread _flushThread;
 };
 
 inline void log(Priority priority, std::string const& message)
 {
     LoggingService::getInstance().log(priority, message);
-}
\ No newline at end of file
+}
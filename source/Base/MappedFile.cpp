@@ -0,0 +1,109 @@
+#include "MappedFile.h"
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+#if defined(_WIN32)
+
+bool MappedFile::open(std::string const& filename)
+{
+    close();
+
+    auto fileHandle = CreateFileA(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (INVALID_HANDLE_VALUE == fileHandle) {
+        return false;
+    }
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || 0 == fileSize.QuadPart) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+    auto mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mappingHandle) {
+        CloseHandle(fileHandle);
+        return false;
+    }
+    auto data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mappingHandle);
+        CloseHandle(fileHandle);
+        return false;
+    }
+
+    _fileHandle = fileHandle;
+    _mappingHandle = mappingHandle;
+    _data = static_cast<char const*>(data);
+    _size = static_cast<uint64_t>(fileSize.QuadPart);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data) {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+        _mappingHandle = nullptr;
+    }
+    if (_fileHandle) {
+        CloseHandle(_fileHandle);
+        _fileHandle = nullptr;
+    }
+    _size = 0;
+}
+
+#else
+
+bool MappedFile::open(std::string const& filename)
+{
+    close();
+
+    auto fileDescriptor = ::open(filename.c_str(), O_RDONLY);
+    if (-1 == fileDescriptor) {
+        return false;
+    }
+    struct stat fileStat;
+    if (-1 == fstat(fileDescriptor, &fileStat) || 0 == fileStat.st_size) {
+        ::close(fileDescriptor);
+        return false;
+    }
+    auto data = mmap(nullptr, fileStat.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+    if (MAP_FAILED == data) {
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    _fileDescriptor = fileDescriptor;
+    _data = static_cast<char const*>(data);
+    _size = static_cast<uint64_t>(fileStat.st_size);
+    return true;
+}
+
+void MappedFile::close()
+{
+    if (_data) {
+        munmap(const_cast<char*>(_data), _size);
+        _data = nullptr;
+    }
+    if (-1 != _fileDescriptor) {
+        ::close(_fileDescriptor);
+        _fileDescriptor = -1;
+    }
+    _size = 0;
+}
+
+#endif
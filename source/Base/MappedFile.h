@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Read-only memory mapping of a file. The file contents appear as a contiguous byte range backed
+ * by the page cache, so large files can be consumed without read buffers or intermediate copies.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(MappedFile const&) = delete;
+    MappedFile& operator=(MappedFile const&) = delete;
+
+    bool open(std::string const& filename);
+    void close();
+
+    char const* data() const { return _data; }
+    uint64_t size() const { return _size; }
+
+private:
+    char const* _data = nullptr;
+    uint64_t _size = 0;
+
+#if defined(_WIN32)
+    void* _fileHandle = nullptr;
+    void* _mappingHandle = nullptr;
+#else
+    int _fileDescriptor = -1;
+#endif
+};
@@ -19,14 +19,6 @@ float Math::angleOfVector(RealVector2D const& v)
     return angle;
 }
 
-RealVector2D Math::rotateQuarterCounterClockwise(RealVector2D v)
-{
-    auto temp = v.x;
-    v.x = v.y;
-    v.y = -temp;
-    return v;
-}
-
 RealVector2D Math::unitVectorOfAngle(double angle)
 {
     return {sinf(angle * Const::DegToRad), -cosf(angle * Const::DegToRad)};
@@ -14,7 +14,16 @@ class Math
 public:
     static float length(RealVector2D const& v);
     static float angleOfVector(RealVector2D const& v);
-    static RealVector2D rotateQuarterCounterClockwise(RealVector2D v);
+
+    //inline: called per entity in the description batch loops
+    static RealVector2D rotateQuarterCounterClockwise(RealVector2D v)
+    {
+        auto temp = v.x;
+        v.x = v.y;
+        v.y = -temp;
+        return v;
+    }
+
     static RealVector2D unitVectorOfAngle(double angleInDeg);
     static RealMatrix2D calcRotationMatrix(float angleInDeg);  //rotation is clockwise
 };
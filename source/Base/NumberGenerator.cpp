@@ -1,5 +1,3 @@
-#include <sstream>
-#include <thread>
 #include <random>
 
 #include "NumberGenerator.h"
@@ -7,20 +5,25 @@
 namespace
 {
     double const RandMax = 4294967296.0;
+    auto constexpr IdLeaseSize = uint64_t(1024);  //ids handed to a thread per counter bump
+
+    //SplitMix64 finalizer: a bijective mixing of a 64-bit counter, which turns consecutive counter
+    //values into independent-looking outputs
+    uint64_t mix(uint64_t z)
+    {
+        z += 0x9e3779b97f4a7c15ull;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        return z ^ (z >> 31);
+    }
 }
 
 NumberGenerator::NumberGenerator()
 {
-    _threadId = static_cast<uint64_t>(1) << 48;
-    _arrayOfRandomNumbers.reserve(1323781);
-    _runningNumber = 0;
-    std::random_device rd;   //Will be used to obtain a seed for the random number engine
-    std::mt19937 gen(rd());  //Standard mersenne_twister_engine seeded with rd()
-    std::uniform_int_distribution<> distrib(0);
-
-    for (uint32_t i = 0; i < 1323781; ++i) {
-        _arrayOfRandomNumbers.emplace_back(distrib(gen));
-    }
+    _threadId = static_cast<uint64_t>(1) << 48;  //ids with bit 48 set form the reserved host range; the device-side id counter stays below it (see CudaNumberGenerator)
+
+    std::random_device rd;
+    _seed = (static_cast<uint64_t>(rd()) << 32) | rd();
 }
 
 NumberGenerator::~NumberGenerator()
@@ -35,23 +38,23 @@ NumberGenerator& NumberGenerator::getInstance()
 
 uint32_t NumberGenerator::getRandomInt()
 {
-	return getNumberFromArray();
+	return getRandomNumber();
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % range;
+	return getRandomNumber() % range;
 }
 
 uint32_t NumberGenerator::getRandomInt(uint32_t min, uint32_t max)
 {
     auto delta = max - min + 1;
-    return min + (getNumberFromArray() % delta);
+    return min + (getRandomNumber() % delta);
 }
 
 uint32_t NumberGenerator::getLargeRandomInt(uint32_t range)
 {
-	return getNumberFromArray() % (range + 1);
+	return getRandomNumber() % (range + 1);
 }
 
 double NumberGenerator::getRandomReal(double min, double max)
@@ -66,16 +69,32 @@ float NumberGenerator::getRandomFloat(float min, float max)
 
 double NumberGenerator::getRandomReal()
 {
-    return static_cast<double>(getNumberFromArray()) / RandMax;
+    return static_cast<double>(getRandomNumber()) / RandMax;
 }
 
 uint64_t NumberGenerator::getId()
 {
-	return _threadId | ++_runningNumber;
+    //per-thread lease on the shared counter, mirroring the warp-aggregated allocation on the
+    //device side: one atomic bump hands a thread IdLeaseSize consecutive ids
+    thread_local uint64_t nextId = 0;
+    thread_local uint64_t leaseEnd = 0;
+    if (nextId == leaseEnd) {
+        nextId = _runningNumber.fetch_add(IdLeaseSize, std::memory_order_relaxed) + 1;
+        leaseEnd = nextId + IdLeaseSize;
+    }
+    return _threadId | nextId++;
+}
+
+uint64_t NumberGenerator::reserveIdRange(uint64_t count)
+{
+    return _threadId | (_runningNumber.fetch_add(count, std::memory_order_relaxed) + 1);
 }
 
-uint32_t NumberGenerator::getNumberFromArray()
+uint32_t NumberGenerator::getRandomNumber()
 {
-	_index = (_index + 1) % _arrayOfRandomNumbers.size();
-	return _arrayOfRandomNumbers[_index];
+    //counter-based generation with one stream per calling thread: the stream offset places each
+    //thread in a disjoint region of the counter space, so no state is shared after the first call
+    thread_local uint64_t streamOffset = mix(_seed ^ (_nextStreamId.fetch_add(1, std::memory_order_relaxed) << 32));
+    thread_local uint64_t counter = 0;
+    return static_cast<uint32_t>(mix(streamOffset + ++counter));
 }
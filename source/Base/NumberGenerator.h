@@ -1,5 +1,7 @@
 #pragma once
 
+#include <atomic>
+
 #include "Definitions.h"
 
 class NumberGenerator
@@ -7,7 +9,9 @@ class NumberGenerator
 public:
     static NumberGenerator& getInstance();
 
-	uint32_t getRandomInt();
+    //thread-safe without locks: the randoms come from a counter-based generator with one stream
+    //per calling thread, the ids from per-thread leases on a shared counter
+    uint32_t getRandomInt();
     uint32_t getRandomInt(uint32_t range);
     uint32_t getRandomInt(uint32_t min, uint32_t max);
     double getRandomReal();
@@ -16,20 +20,24 @@ public:
 
 	uint64_t getId();
 
+    //reserves a contiguous block of ids with a single counter bump; for bulk creation paths that
+    //hand out the ids themselves
+    uint64_t reserveIdRange(uint64_t count);
+
 public:
     NumberGenerator(NumberGenerator const&) = delete;
     void operator=(NumberGenerator const&) = delete;
 
 	uint32_t getLargeRandomInt(uint32_t range);
-    uint32_t getNumberFromArray();
 
 private:
     NumberGenerator();
     ~NumberGenerator();
 
-	int _index = 0;
-	std::vector<uint32_t> _arrayOfRandomNumbers;
-	uint64_t _runningNumber = 0;
+    uint32_t getRandomNumber();
+
+    uint64_t _seed = 0;
+    std::atomic<uint64_t> _runningNumber{0};
+    std::atomic<uint64_t> _nextStreamId{0};
 	uint64_t _threadId = 0;
 };
-
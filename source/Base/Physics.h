@@ -1,13 +1,16 @@
 #pragma once
 
 #include "Definitions.h"
+#include "Math.h"
 
+//host-side counterpart of the physics math in EngineGpuKernels/Physics.cuh; header-only, so the
+//per-entity calls inline into the batch loops of the description transforms
 class Physics
 {
 public:
-
     static RealVector2D
-    tangentialVelocity(RealVector2D const& positionFromCenter, RealVector2D const& vel, double angularVel);
-
-    static RealVector2D rotateQuarterCounterClockwise(RealVector2D v);
+    tangentialVelocity(RealVector2D const& positionFromCenter, RealVector2D const& vel, double angularVel)
+    {
+        return vel - Math::rotateQuarterCounterClockwise(positionFromCenter) * toFloat(angularVel * Const::DegToRad);
+    }
 };
@@ -8,6 +8,7 @@ namespace Const
 
     auto const LogFilename = "log.txt";
     auto const AutosaveFile = BasePath + "autosave.sim";
+    auto const AutosaveDirectory = BasePath + "autosaves/";
     auto const SettingsFilename = BasePath + "settings.json";
 
     auto const SimulationFragmentShader = BasePath + "shader.fs";
@@ -0,0 +1,107 @@
+#include "SharedMemorySegment.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+SharedMemorySegment::~SharedMemorySegment()
+{
+    close();
+}
+
+#if defined(_WIN32)
+
+bool SharedMemorySegment::create(std::string const& name, uint64_t size)
+{
+    close();
+
+    auto mappingHandle = CreateFileMappingA(
+        INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, static_cast<DWORD>(size >> 32), static_cast<DWORD>(size & 0xffffffff), name.c_str());
+    if (!mappingHandle) {
+        return false;
+    }
+    auto data = MapViewOfFile(mappingHandle, FILE_MAP_WRITE, 0, 0, 0);
+    if (!data) {
+        CloseHandle(mappingHandle);
+        return false;
+    }
+
+    _mappingHandle = mappingHandle;
+    _data = data;
+    _size = size;
+    _name = name;
+    memset(_data, 0, size);
+    return true;
+}
+
+void SharedMemorySegment::close()
+{
+    if (_data) {
+        UnmapViewOfFile(_data);
+        _data = nullptr;
+    }
+    if (_mappingHandle) {
+        CloseHandle(_mappingHandle);
+        _mappingHandle = nullptr;
+    }
+    _size = 0;
+    _name.clear();
+}
+
+#else
+
+bool SharedMemorySegment::create(std::string const& name, uint64_t size)
+{
+    close();
+
+    auto shmName = "/" + name;  //posix shared memory names must start with a slash
+    auto fileDescriptor = shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0644);
+    if (-1 == fileDescriptor) {
+        return false;
+    }
+    if (-1 == ftruncate(fileDescriptor, static_cast<off_t>(size))) {
+        ::close(fileDescriptor);
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+    auto data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+    if (MAP_FAILED == data) {
+        ::close(fileDescriptor);
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    _fileDescriptor = fileDescriptor;
+    _data = data;
+    _size = size;
+    _name = shmName;
+    memset(_data, 0, size);
+    return true;
+}
+
+void SharedMemorySegment::close()
+{
+    if (_data) {
+        munmap(_data, _size);
+        _data = nullptr;
+    }
+    if (-1 != _fileDescriptor) {
+        ::close(_fileDescriptor);
+        _fileDescriptor = -1;
+    }
+    if (!_name.empty()) {
+        shm_unlink(_name.c_str());
+        _name.clear();
+    }
+    _size = 0;
+}
+
+#endif
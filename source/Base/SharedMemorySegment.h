@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+/**
+ * Writable named shared-memory segment, the publishing counterpart of MappedFile. Other processes
+ * can map the segment under the same name and read the contents without any copies through the
+ * engine. The creator owns the segment: close() removes the name, readers that still hold a
+ * mapping keep their view until they unmap.
+ */
+class SharedMemorySegment
+{
+public:
+    SharedMemorySegment() = default;
+    ~SharedMemorySegment();
+
+    SharedMemorySegment(SharedMemorySegment const&) = delete;
+    SharedMemorySegment& operator=(SharedMemorySegment const&) = delete;
+
+    bool create(std::string const& name, uint64_t size);
+    void close();
+
+    void* data() const { return _data; }
+    uint64_t size() const { return _size; }
+
+private:
+    void* _data = nullptr;
+    uint64_t _size = 0;
+    std::string _name;
+
+#if defined(_WIN32)
+    void* _mappingHandle = nullptr;
+#else
+    int _fileDescriptor = -1;
+#endif
+};
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/range/adaptor/indexed.hpp>
+#include <boost/range/adaptors.hpp>
+
+#include "EngineInterface/PatternAnalysis.h"
+#include "EngineInterface/Serializer.h"
+
+namespace
+{
+    struct AnalyzerParameters
+    {
+        std::string directory;
+        int numJobs = 0;  //0 = one per core
+        bool writeMetadataSidecars = false;
+        bool recursive = false;
+    };
+
+    void printUsage()
+    {
+        std::cerr << "usage: alien-analyzer <directory> [options]" << std::endl
+                  << "options:" << std::endl
+                  << "  --jobs <n>       number of worker threads (default: one per core)" << std::endl
+                  << "  --metadata       also write missing .meta.json sidecars" << std::endl
+                  << "  --recursive      descend into subdirectories" << std::endl;
+    }
+
+    bool parseParameters(AnalyzerParameters& parameters, int argc, char** argv)
+    {
+        if (argc < 2) {
+            return false;
+        }
+        parameters.directory = argv[1];
+        for (int i = 2; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--jobs" && i + 1 < argc) {
+                parameters.numJobs = std::stoi(argv[++i]);
+            } else if (option == "--metadata") {
+                parameters.writeMetadataSidecars = true;
+            } else if (option == "--recursive") {
+                parameters.recursive = true;
+            } else {
+                return false;
+            }
+        }
+        return parameters.numJobs >= 0;
+    }
+
+    std::vector<std::filesystem::path> collectSimulationFiles(AnalyzerParameters const& parameters)
+    {
+        std::vector<std::filesystem::path> result;
+        auto addIfSimulationFile = [&result](std::filesystem::path const& path) {
+            if (path.extension() == ".sim") {
+                result.emplace_back(path);
+            }
+        };
+        if (parameters.recursive) {
+            for (auto const& entry : std::filesystem::recursive_directory_iterator(parameters.directory)) {
+                addIfSimulationFile(entry.path());
+            }
+        } else {
+            for (auto const& entry : std::filesystem::directory_iterator(parameters.directory)) {
+                addIfSimulationFile(entry.path());
+            }
+        }
+        std::sort(result.begin(), result.end());
+        return result;
+    }
+
+    bool analyzeFile(std::filesystem::path const& path, AnalyzerParameters const& parameters, std::mutex& logMutex)
+    {
+        DeserializedSimulation simulationData;
+        if (!Serializer::deserializeSimulationFromFiles(simulationData, path.string())) {
+            std::lock_guard guard(logMutex);
+            std::cerr << "skipped '" << path.string() << "': not a readable simulation save" << std::endl;
+            return false;
+        }
+
+        auto const partitionData = PatternAnalysis::calcRepetitiveActiveClusters(simulationData.content);
+
+        auto analysisFilename = path;
+        analysisFilename.replace_extension(std::filesystem::path(".analysis.txt"));
+        std::ofstream file(analysisFilename.string(), std::ios_base::out);
+        if (!file) {
+            std::lock_guard guard(logMutex);
+            std::cerr << "could not write '" << analysisFilename.string() << "'" << std::endl;
+            return false;
+        }
+        file << "file: " << path.filename().string() << std::endl
+             << "timestep: " << simulationData.timestep << std::endl
+             << "clusters: " << simulationData.content.clusters.size() << std::endl
+             << "number of repetitive active clusters: " << partitionData.size() << std::endl
+             << std::endl;
+        for (auto const& [index, partitionClassData] : partitionData | boost::adaptors::indexed(1)) {
+            //the content hash allows matching the same pattern across checkpoints without
+            //extracting the representant
+            file << "cluster " << index << ": " << partitionClassData.numberOfElements << " exemplars, "
+                 << partitionClassData.representant.cells.size() << " cells, hash "
+                 << Serializer::calcClusterHash(partitionClassData.representant) << std::endl;
+        }
+
+        if (parameters.writeMetadataSidecars) {
+            SimulationFileMetadata metadata;
+            if (!Serializer::deserializeMetadataFromFile(metadata, path.string())) {
+                if (!Serializer::serializeMetadataSidecar(path.string(), simulationData)) {
+                    std::lock_guard guard(logMutex);
+                    std::cerr << "could not write metadata sidecar for '" << path.string() << "'" << std::endl;
+                    return false;
+                }
+            }
+        }
+
+        std::lock_guard guard(logMutex);
+        std::cout << path.filename().string() << ": " << partitionData.size() << " repetitive active clusters" << std::endl;
+        return true;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    AnalyzerParameters parameters;
+    if (!parseParameters(parameters, argc, argv)) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        auto const files = collectSimulationFiles(parameters);
+        if (files.empty()) {
+            std::cerr << "no simulation files found in '" << parameters.directory << "'" << std::endl;
+            return 1;
+        }
+
+        auto numJobs = parameters.numJobs != 0 ? parameters.numJobs : std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+        numJobs = std::min(numJobs, static_cast<int>(files.size()));
+        std::cout << "analyzing " << files.size() << " files with " << numJobs << " jobs" << std::endl;
+
+        //the analysis is pure host code, so the files are simply dealt out to one worker thread
+        //per core; each worker grabs the next unprocessed file until the list is exhausted
+        std::atomic<size_t> nextFileIndex{0};
+        std::atomic<int> numFailures{0};
+        std::mutex logMutex;
+        std::vector<std::thread> workers;
+        for (int i = 0; i < numJobs; ++i) {
+            workers.emplace_back([&] {
+                while (true) {
+                    auto fileIndex = nextFileIndex.fetch_add(1);
+                    if (fileIndex >= files.size()) {
+                        return;
+                    }
+                    if (!analyzeFile(files.at(fileIndex), parameters, logMutex)) {
+                        ++numFailures;
+                    }
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        if (0 != numFailures) {
+            std::cerr << numFailures << " of " << files.size() << " files could not be analyzed" << std::endl;
+            return 1;
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "The following exception occurred: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "EngineInterface/Serializer.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+namespace
+{
+    struct CliParameters
+    {
+        std::string inputFilename;
+        int numTimesteps = 0;
+        std::string outputPrefix;  //defaults to the input filename without extension
+        int checkpointInterval = 0;  //0 = only the final state is written
+        int statisticsInterval = 100;
+    };
+
+    void printUsage()
+    {
+        std::cerr << "usage: alien-cli <simulation file> <num timesteps> [options]" << std::endl
+                  << "options:" << std::endl
+                  << "  --output <prefix>       prefix for checkpoints and statistics" << std::endl
+                  << "  --checkpoint <n>        write a checkpoint every n timesteps" << std::endl
+                  << "  --statistics <n>        record statistics every n timesteps (default: 100)" << std::endl;
+    }
+
+    bool parseParameters(CliParameters& parameters, int argc, char** argv)
+    {
+        if (argc < 3) {
+            return false;
+        }
+        parameters.inputFilename = argv[1];
+        parameters.numTimesteps = std::stoi(argv[2]);
+        for (int i = 3; i < argc; ++i) {
+            std::string option = argv[i];
+            if (option == "--output" && i + 1 < argc) {
+                parameters.outputPrefix = argv[++i];
+            } else if (option == "--checkpoint" && i + 1 < argc) {
+                parameters.checkpointInterval = std::stoi(argv[++i]);
+            } else if (option == "--statistics" && i + 1 < argc) {
+                parameters.statisticsInterval = std::stoi(argv[++i]);
+            } else {
+                return false;
+            }
+        }
+        if (parameters.outputPrefix.empty()) {
+            auto path = std::filesystem::path(parameters.inputFilename);
+            parameters.outputPrefix = (path.parent_path() / path.stem()).string();
+        }
+        return parameters.numTimesteps > 0 && parameters.statisticsInterval > 0 && parameters.checkpointInterval >= 0;
+    }
+
+    void writeStatisticsLine(std::ofstream& stream, MonitorData const& statistics)
+    {
+        auto numCells = 0;
+        for (int i = 0; i < 7; ++i) {
+            numCells += statistics.numCellsByColor[i];
+        }
+        stream << statistics.timeStep << "," << numCells << "," << statistics.numConnections << "," << statistics.numParticles << ","
+               << statistics.numTokens << "," << statistics.totalInternalEnergy << "," << statistics.numCreatedCells << ","
+               << statistics.numSuccessfulAttacks << "," << statistics.numFailedAttacks << "," << statistics.numMuscleActivities << std::endl;
+    }
+
+    bool writeCheckpoint(SimulationController const& simController, std::string const& filename)
+    {
+        DeserializedSimulation checkpoint{
+            simController->getCurrentTimestep(), simController->getSettings(), simController->getSymbolMap(), simController->getClusteredSimulationData()};
+        return Serializer::serializeSimulationToFiles(filename, checkpoint);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    CliParameters parameters;
+    if (!parseParameters(parameters, argc, argv)) {
+        printUsage();
+        return 1;
+    }
+
+    try {
+        DeserializedSimulation simulationData;
+        if (!Serializer::deserializeSimulationFromFiles(simulationData, parameters.inputFilename)) {
+            std::cerr << "Could not read simulation file '" << parameters.inputFilename << "'." << std::endl;
+            return 1;
+        }
+
+        auto simController = std::make_shared<_SimulationControllerImpl>();
+        simController->initCuda();
+        simController->newSimulation(simulationData.timestep, simulationData.settings, simulationData.symbolMap);
+        simController->setClusteredSimulationData(simulationData.content);
+
+        auto statisticsFilename = parameters.outputPrefix + ".statistics.csv";
+        std::ofstream statisticsStream(statisticsFilename);
+        if (!statisticsStream) {
+            std::cerr << "Could not open '" << statisticsFilename << "' for writing." << std::endl;
+            return 1;
+        }
+        statisticsStream << "timestep,cells,connections,particles,tokens,internal energy,created cells,successful attacks,failed attacks,muscle activities"
+                         << std::endl;
+        writeStatisticsLine(statisticsStream, simController->getStatistics());
+
+        std::cout << "running " << parameters.numTimesteps << " timesteps from timestep " << simulationData.timestep << std::endl;
+
+        auto timestepsSinceCheckpoint = 0;
+        for (int timestepsDone = 0; timestepsDone < parameters.numTimesteps;) {
+            auto timestepsInChunk = std::min(parameters.statisticsInterval, parameters.numTimesteps - timestepsDone);
+            if (parameters.checkpointInterval > 0) {
+                timestepsInChunk = std::min(timestepsInChunk, parameters.checkpointInterval - timestepsSinceCheckpoint);
+            }
+            simController->calcTimesteps(timestepsInChunk);
+            timestepsDone += timestepsInChunk;
+            timestepsSinceCheckpoint += timestepsInChunk;
+
+            writeStatisticsLine(statisticsStream, simController->getStatistics());
+
+            if (parameters.checkpointInterval > 0 && timestepsSinceCheckpoint == parameters.checkpointInterval) {
+                auto checkpointFilename = parameters.outputPrefix + "_" + std::to_string(simController->getCurrentTimestep()) + ".sim";
+                if (!writeCheckpoint(simController, checkpointFilename)) {
+                    std::cerr << "Could not write checkpoint '" << checkpointFilename << "'." << std::endl;
+                    return 1;
+                }
+                std::cout << "checkpoint written: " << checkpointFilename << std::endl;
+                timestepsSinceCheckpoint = 0;
+            }
+        }
+
+        auto resultFilename = parameters.outputPrefix + "_" + std::to_string(simController->getCurrentTimestep()) + ".sim";
+        if (!writeCheckpoint(simController, resultFilename)) {
+            std::cerr << "Could not write result '" << resultFilename << "'." << std::endl;
+            return 1;
+        }
+        std::cout << "result written: " << resultFilename << std::endl;
+
+        simController->closeSimulation();
+    } catch (std::exception const& e) {
+        std::cerr << "The following exception occurred: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
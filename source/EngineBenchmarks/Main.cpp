@@ -0,0 +1,105 @@
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/Settings.h"
+#include "EngineInterface/SymbolMap.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+namespace
+{
+    auto constexpr NumWarmupTimesteps = 10;
+    auto constexpr DefaultNumTimesteps = 100;
+
+    struct BenchmarkConfig
+    {
+        int cellsPerSide = 0;  //the generated world holds cellsPerSide^2 cells
+        float cellDistance = 0;  //controls the density
+    };
+
+    void runBenchmark(BenchmarkConfig const& config, int numTimesteps)
+    {
+        //margin so that the rect does not wrap onto itself at the world boundary
+        auto worldSideLength = toInt(toFloat(config.cellsPerSide) * config.cellDistance) + 20;
+
+        auto simController = std::make_shared<_SimulationControllerImpl>();
+        simController->initCuda();
+        Settings settings;
+        settings.generalSettings.worldSizeX = worldSideLength;
+        settings.generalSettings.worldSizeY = worldSideLength;
+        SymbolMap symbolMap;
+        simController->newSimulation(0, settings, symbolMap);
+
+        auto world = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters()
+                                                       .width(config.cellsPerSide)
+                                                       .height(config.cellsPerSide)
+                                                       .cellDistance(config.cellDistance)
+                                                       .center({toFloat(worldSideLength) / 2, toFloat(worldSideLength) / 2}));
+        simController->setSimulationData(world);
+        auto numCells = world.cells.size();
+
+        std::cout << "world: " << worldSideLength << " x " << worldSideLength << ", cells: " << numCells << ", cell distance: " << config.cellDistance
+                  << ", timesteps: " << numTimesteps << std::endl;
+
+        for (int i = 0; i < NumWarmupTimesteps; ++i) {
+            simController->calcSingleTimestep();
+        }
+
+        //aggregate by kernel name while preserving the launch order
+        std::vector<std::string> kernelNames;
+        std::unordered_map<std::string, double> totalDurationInMsByKernel;
+        for (int i = 0; i < numTimesteps; ++i) {
+            for (auto const& timing : simController->benchmarkTimestep()) {
+                if (totalDurationInMsByKernel.emplace(timing.kernelName, 0.0).second) {
+                    kernelNames.emplace_back(timing.kernelName);
+                }
+                totalDurationInMsByKernel.at(timing.kernelName) += timing.durationInMs;
+            }
+        }
+
+        std::cout << std::left << std::setw(36) << "kernel" << std::right << std::setw(12) << "avg ms" << std::setw(14) << "MCells/sec" << std::endl;
+        auto totalAvgInMs = 0.0;
+        for (auto const& kernelName : kernelNames) {
+            auto avgInMs = totalDurationInMsByKernel.at(kernelName) / numTimesteps;
+            totalAvgInMs += avgInMs;
+            auto throughput = static_cast<double>(numCells) / (avgInMs * 1000.0);
+            std::cout << std::left << std::setw(36) << kernelName << std::right << std::fixed << std::setprecision(4) << std::setw(12) << avgInMs
+                      << std::setprecision(1) << std::setw(14) << throughput << std::endl;
+        }
+        std::cout << std::left << std::setw(36) << "total" << std::right << std::fixed << std::setprecision(4) << std::setw(12) << totalAvgInMs << std::endl
+                  << std::endl;
+
+        simController->closeSimulation();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    try {
+        auto numTimesteps = DefaultNumTimesteps;
+        std::vector<BenchmarkConfig> configs;
+        if (argc >= 3) {
+            configs.emplace_back(BenchmarkConfig{std::stoi(argv[1]), std::stof(argv[2])});
+            if (argc >= 4) {
+                numTimesteps = std::stoi(argv[3]);
+            }
+        } else {
+            //default sweep over world size and density
+            configs = {{100, 1.0f}, {300, 1.0f}, {1000, 1.0f}, {300, 0.5f}, {300, 2.0f}};
+        }
+
+        for (auto const& config : configs) {
+            runBenchmark(config, numTimesteps);
+        }
+    } catch (std::exception const& e) {
+        std::cerr << "The following exception occurred: " << e.what() << std::endl;
+        std::cerr << std::endl << "usage: benchmarks [cells-per-side cell-distance [num-timesteps]]" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -4,6 +4,7 @@
 #include <stdint.h>
 
 #define MAX_STRING_BYTES 50000000
+#define MAX_GENOME_BYTES 50000000
 #define MAX_TOKEN_MEM_SIZE 256
 #define MAX_CELL_BONDS 6
 #define MAX_CELL_STATIC_BYTES 48
@@ -24,15 +25,17 @@ struct ParticleMetadataAccessTO
     unsigned char color;
 };
 
+//the TO structs are laid out densely (small fields grouped at the end, bounded counters narrowed
+//to bytes): their size directly bounds the transfer rate of snapshots and rendering queries
 struct ParticleAccessTO
 {
 	uint64_t id;
-	float energy;
 	float2 pos;
 	float2 vel;
+	float energy;
     ParticleMetadataAccessTO metadata;
 
-	int selected;
+	char selected;
 };
 
 struct CellMetadataAccessTO
@@ -62,21 +65,21 @@ struct CellAccessTO
 	float2 pos;
     float2 vel;
 	float energy;
-	int maxConnections;
-	int numConnections;
-	int branchNumber;
-	bool tokenBlocked;
+    int cellFunctionType;  //kept full width: legacy saves carry out-of-range values that are mapped via modulo on use
+    int cellFunctionInvocations;
     ConnectionAccessTO connections[MAX_CELL_BONDS];
-    int cellFunctionType;
+    CellMetadataAccessTO metadata;
     unsigned char numStaticBytes;
     char staticData[MAX_CELL_STATIC_BYTES];
     unsigned char numMutableBytes;
     char mutableData[MAX_CELL_MUTABLE_BYTES];
-    int cellFunctionInvocations;
-    CellMetadataAccessTO metadata;
+	unsigned char maxConnections;  //bounded by MAX_CELL_BONDS
+	unsigned char numConnections;  //bounded by MAX_CELL_BONDS
+	unsigned char branchNumber;
+	bool tokenBlocked;
 	bool barrier;
 
-	int selected;
+	char selected;
 };
 
 struct DataAccessTO
@@ -90,6 +93,12 @@ struct DataAccessTO
     int* numStringBytes = nullptr;
     char* stringBytes = nullptr;
 
+    //schema flags, set by the host before an extraction (see DataAccessSchema): when cleared, the
+    //metadata strings resp. the token memories are not serialized and arrive zeroed; not part of
+    //operator== since the cache identifies a TO by its buffers
+    bool includeMetadata = true;
+    bool includeTokenMemories = true;
+
 	bool operator==(DataAccessTO const& other) const
 	{
 		return numCells == other.numCells
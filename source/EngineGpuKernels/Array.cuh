@@ -10,6 +10,19 @@
 namespace Const
 {
     constexpr float ArrayFillLevelFactor = 2.0f / 3.0f;
+
+    //minimum fraction of dead entries an entity heap must carry before a compaction is triggered;
+    //below this a full copy would reclaim almost nothing and the arrays are grown instead
+    constexpr float GarbageRatioForCompaction = 0.1f;
+
+    //the capacity above ArrayFillLevelFactor acts as an overflow reserve for in-flight timesteps
+    //while a resize is pending; once the fill level climbs past this factor the reserve itself is
+    //being consumed and construction must be throttled to avoid losing entities to full arrays
+    constexpr float ArrayOverflowReserveFactor = 0.85f;
+
+    //number of timesteps construction is suspended when the overflow reserve is being consumed;
+    //covers the polling interval of automaticResizeArrays plus the resize itself
+    constexpr int ConstructionThrottleTimesteps = 20;
 }
 
 template <typename T>
@@ -43,7 +56,7 @@ public:
     __host__ __inline__ void init(int size)
     {
         T* data = nullptr;
-        CudaMemoryManager::getInstance().acquireMemory<T>(size, data);
+        CudaMemoryManager::getInstance().acquireGrowableMemory<T>(size, data);
         CudaMemoryManager::getInstance().acquireMemory<T*>(1, _data);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numEntries);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numOrigEntries);
@@ -147,6 +160,29 @@ public:
         return getNumEntries_host() + arraySizeInc > getSize_host() * Const::ArrayFillLevelFactor;
     }
 
+    __device__ __inline__ bool isOverflowReserveTouched() const
+    {
+        return getNumEntries() > getSize() * Const::ArrayOverflowReserveFactor;
+    }
+
+    //grows the array behind its existing device address when the backing block is virtual-memory
+    //backed: the content and all pointers into the array stay valid, so no copy cycle is needed;
+    //returns false when the block is a plain allocation or its reservation is exhausted
+    __host__ __inline__ bool tryGrowInPlace(int newSize) const
+    {
+        auto size = getSize_host();
+        if (newSize <= size) {
+            return true;
+        }
+        T* data;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&data, _data, sizeof(T*), cudaMemcpyDeviceToHost));
+        if (!data || !CudaMemoryManager::getInstance().tryGrowMemory(data, static_cast<uint64_t>(newSize))) {
+            return false;
+        }
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_size, &newSize, sizeof(int), cudaMemcpyHostToDevice));
+        return true;
+    }
+
     __host__ __inline__ void resize(int newSize) const
     {
         auto size = getSize_host();
@@ -155,12 +191,15 @@ public:
             return;
         }
         if (size > 0) {
+            if (newSize > size && tryGrowInPlace(newSize)) {
+                return;
+            }
             T* data;
             CHECK_FOR_CUDA_ERROR(cudaMemcpy(&data, _data, sizeof(T*), cudaMemcpyDeviceToHost));
             CudaMemoryManager::getInstance().freeMemory(data);
         }
         T* newData;
-        CudaMemoryManager::getInstance().acquireMemory<T>(newSize, newData);
+        CudaMemoryManager::getInstance().acquireGrowableMemory<T>(newSize, newData);
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_data, &newData, sizeof(T*), cudaMemcpyHostToDevice));
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_size, &newSize, sizeof(int), cudaMemcpyHostToDevice));
     }
@@ -173,6 +212,7 @@ private:
     int* _size;
     int* _numEntries;
     int* _numOrigEntries;
+    int* _maxNumEntries;  //high-water mark over all epochs (setMemory calls); reported via the memory introspection
 
 public:
     T** _data;
@@ -183,11 +223,13 @@ public:
     {
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numEntries);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numOrigEntries);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _maxNumEntries);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _size);
         CudaMemoryManager::getInstance().acquireMemory<T*>(1, _data);
 
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numOrigEntries, 0, sizeof(int)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numEntries, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_maxNumEntries, 0, sizeof(int)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_size, 0, sizeof(int)));
     }
 
@@ -195,20 +237,39 @@ public:
     {
         CudaMemoryManager::getInstance().freeMemory(_numOrigEntries);
         CudaMemoryManager::getInstance().freeMemory(_numEntries);
+        CudaMemoryManager::getInstance().freeMemory(_maxNumEntries);
         CudaMemoryManager::getInstance().freeMemory(_size);
         CudaMemoryManager::getInstance().freeMemory(_data);
     }
 
     __device__ __inline__ void setMemory(T* data, int size) const
     {
+        *_maxNumEntries = max(*_maxNumEntries, *_numEntries);  //the previous epoch ends here
         *_data = data;
         *_size = size;
         *_numEntries = 0;
         *_numOrigEntries = 0;
     }
     __device__ __inline__ int getSize() const { return *_size; }
+    __host__ __inline__ int getSize_host() const
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _size, sizeof(int), cudaMemcpyDeviceToHost));
+        return result;
+    }
+    __host__ __inline__ int getMaxNumEntries_host() const
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _maxNumEntries, sizeof(int), cudaMemcpyDeviceToHost));
+        return result;
+    }
     __device__ __inline__ int saveNumEntries() const { return *_numOrigEntries = *_numEntries; }
+
+    //device address of the entry counter; needed by the jit-generated kernel which receives raw
+    //pointers instead of this wrapper
+    __host__ __inline__ int* getNumEntriesPointer_host() const { return _numEntries; }
     __device__ __inline__ int getNumEntries() const { return *_numEntries; }
+    __device__ __inline__ void setNumEntries(int value) const { *_numEntries = value; }
     __device__ __inline__ int getNumOrigEntries() const { return *_numOrigEntries; }
 
     __device__ __inline__ T& at(int index) { return (*_data)[index]; }
@@ -216,13 +277,32 @@ public:
 
     __device__ __inline__ bool tryAddEntry(T const& entry)
     {
-        auto index = atomicAdd(_numEntries, 1);
-        if (index < *_size) {
+        //warp-aggregated insertion: the converged threads of a warp reserve their slots with a
+        //single atomic, which avoids serialization when many threads append at once (e.g. mass
+        //cell-death events scheduling structural operations)
+        auto mask = __activemask();
+        auto laneId = threadIdx.x & 31;
+        auto leader = __ffs(mask) - 1;
+        auto count = __popc(mask);
+        auto rank = __popc(mask & ((1u << laneId) - 1));
+
+        int base;
+        if (laneId == leader) {
+            base = atomicAdd(_numEntries, count);
+        }
+        base = __shfl_sync(mask, base, leader);
+
+        auto index = base + rank;
+        auto success = index < *_size;
+        if (success) {
             (*_data)[index] = entry;
-            return true;
-        } else {
-            atomicSub(_numEntries, 1);
-            return false;
         }
+        if (laneId == leader) {
+            auto overflow = min(count, max(0, base + count - *_size));
+            if (overflow > 0) {
+                atomicSub(_numEntries, overflow);
+            }
+        }
+        return success;
     }
 };
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <random>
 #include <vector>
 
 #include <cuda_runtime.h>
@@ -40,6 +41,13 @@ struct PartitionData
     __inline__ __device__ int numElements() const { return endIndex - startIndex + 1; }
 };
 
+namespace Const
+{
+    //ids at or above this value are reserved for host-side assignment (NumberGenerator::getId sets
+    //bit 48); the device id counter must stay below it so the two streams can never collide
+    constexpr unsigned long long HostIdRangeStart = 1ull << 48;
+}
+
 class CudaNumberGenerator
 {
 private:
@@ -50,7 +58,9 @@ private:
     unsigned long long int* _currentId;
 
 public:
-    void init(int size)
+    //seed = 0 fills the array from the process-global rand() stream; a nonzero seed fills it from a
+    //dedicated mt19937 instance so that the stream is reproducible across runs and platforms
+    void init(int size, uint64_t seed = 0)
     {
         _size = size;
 
@@ -63,8 +73,15 @@ public:
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_currentId, &hostCurrentId, sizeof(_currentId), cudaMemcpyHostToDevice));
 
         std::vector<int> randomNumbers(size);
-        for (int i = 0; i < size; ++i) {
-            randomNumbers[i] = rand();
+        if (seed != 0) {
+            std::mt19937 engine(static_cast<std::mt19937::result_type>(seed));
+            for (int i = 0; i < size; ++i) {
+                randomNumbers[i] = static_cast<int>(engine() % (static_cast<unsigned int>(RAND_MAX) + 1));
+            }
+        } else {
+            for (int i = 0; i < size; ++i) {
+                randomNumbers[i] = rand();
+            }
         }
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_array, randomNumbers.data(), sizeof(int) * size, cudaMemcpyHostToDevice));
     }
@@ -88,10 +105,31 @@ public:
         return static_cast<float>(number) / RAND_MAX;
     }
 
-    __device__ __inline__ unsigned long long int createNewId_kernel() { return atomicAdd(_currentId, 1); }
+    __device__ __inline__ unsigned long long int createNewId_kernel()
+    {
+        //warp-aggregated: the converged threads of a warp lease a contiguous id range with a single
+        //atomic, which avoids serialization on the counter during mass construction/radiation events
+        auto mask = __activemask();
+        auto laneId = threadIdx.x & 31;
+        auto leader = __ffs(mask) - 1;
+        auto count = __popc(mask);
+        auto rank = __popc(mask & ((1u << laneId) - 1));
+
+        unsigned long long int base;
+        if (laneId == leader) {
+            base = atomicAdd(_currentId, static_cast<unsigned long long int>(count));
+        }
+        base = __shfl_sync(mask, base, leader);
+        return base + rank;
+    }
 
     __device__ __inline__ void adaptMaxId(unsigned long long int id)
     {
+        //host-assigned ids carry the reserved range tag and must not drag the counter into that
+        //range, otherwise freshly created device ids would collide with future host ids
+        if (id >= Const::HostIdRangeStart) {
+            return;
+        }
         atomicMax(_currentId, id + 1);
     }
 
@@ -287,6 +325,19 @@ inline void copyToDevice(T* target, T* source, int count = 1)
     CHECK_FOR_CUDA_ERROR(cudaMemcpy(target, source, sizeof(T) * count, cudaMemcpyHostToDevice));
 }
 
+//requires pinned host memory to run truly asynchronous
+template <typename T>
+inline void copyToHostAsync(T* target, T* source, int count, cudaStream_t stream)
+{
+    CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(target, source, sizeof(T) * count, cudaMemcpyDeviceToHost, stream));
+}
+
+template <typename T>
+inline void copyToDeviceAsync(T* target, T* source, int count, cudaStream_t stream)
+{
+    CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(target, source, sizeof(T) * count, cudaMemcpyHostToDevice, stream));
+}
+
 template <typename T>
 void setValueToDevice(T* target, T const& value)
 {
@@ -31,6 +31,7 @@ struct CellConnection
 struct Cell
 {
     uint64_t id;
+    uint64_t ancestorId;  //id of the cell that founded this lineage; inherited through construction, while fresh and uploaded cells found their own lineage
     float2 absPos;
     float2 vel;
 
@@ -40,7 +41,7 @@ struct Cell
     int numConnections;
     CellConnection connections[MAX_CELL_BONDS];
     unsigned char numStaticBytes;
-    char staticData[MAX_CELL_STATIC_BYTES];
+    char* staticData;  //shared block of MAX_CELL_STATIC_BYTES bytes in the genome store; immutable, changed only by reinsertion (copy-on-write)
     unsigned char numMutableBytes;
     char mutableData[MAX_CELL_MUTABLE_BYTES];
     int cellFunctionInvocations;
@@ -57,10 +58,9 @@ struct Cell
     int tag;
     float2 temp1;
     float2 temp2;
-    float2 temp3;
 
     //cluster data
-    int clusterIndex;
+    Cell* clusterRepresentative;    //cell with the smallest address within the cluster; remains valid across timesteps as long as no structural change occurs
     int clusterBoundaries;    //1 = cluster occupies left boundary, 2 = cluster occupies upper boundary
     float2 clusterPos;
     float2 clusterVel;
@@ -75,11 +75,8 @@ struct Cell
         energy = 0;
     }
 
-    __device__ __inline__ void getLock()
-    {
-        while (1 == atomicExch(&locked, 1)) {}
-    }
-
+    //deliberately no blocking getLock(): a busy-wait on a popular cell would serialize whole
+    //warps; all users take tryLock and skip or reschedule their work on contention
     __device__ __inline__ bool tryLock()
     {
         auto result = 0 == atomicExch(&locked, 1);
@@ -111,6 +108,10 @@ struct Cell
             numStaticBytes = 0;
             numMutableBytes = 5;
         } break;
+        case Enums::CellFunction_Communication: {
+            numStaticBytes = 0;
+            numMutableBytes = 5;
+        } break;
         default: {
             numStaticBytes = 0;
             numMutableBytes = 0;
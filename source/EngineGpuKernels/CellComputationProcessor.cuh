@@ -13,6 +13,19 @@ class CellComputationProcessor
 public:
     __inline__ __device__ static void process(Token* token);
 
+    //true if the genome block belongs to a jit-compiled program (see GenomeJitCompiler); the
+    //table holds at most MAX_JIT_GENOMES entries and stays cached, so the check is cheap
+    __inline__ __device__ static bool isJitCompiled(SimulationData const& data, char const* staticData)
+    {
+        auto numJitGenomes = *data.numJitGenomes;
+        for (int i = 0; i < numJitGenomes; ++i) {
+            if (data.jitGenomes[i] == staticData) {
+                return true;
+            }
+        }
+        return false;
+    }
+
 private:
     __inline__ __device__ static void
         readInstruction(char const* data, int& instructionPointer, CellInstruction& instructionCoded);
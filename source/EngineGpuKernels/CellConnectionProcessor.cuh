@@ -3,6 +3,7 @@
 #include "Base.cuh"
 #include "Definitions.cuh"
 #include "SimulationData.cuh"
+#include "SimulationResult.cuh"
 #include "ConstantMemory.cuh"
 #include "SpotCalculator.cuh"
 
@@ -15,8 +16,19 @@ public:
     __inline__ __device__ static void scheduleDelCell(SimulationData& data, Cell* cell, int cellIndex);
     __inline__ __device__ static void scheduleDelCellAndConnections(SimulationData& data, Cell* cell, int cellIndex);
 
-    __inline__ __device__ static void processConnectionsOperations(SimulationData& data);
-    __inline__ __device__ static void processDelCellOperations(SimulationData& data);
+    //brings the scheduled operations into a canonical order (sorted by type and involved cell ids)
+    //so that processConnectionsOperations behaves identically regardless of the scheduling order;
+    //single-threaded, must be called from a <<<1, 1>>> kernel and only in deterministic mode
+    __inline__ __device__ static void sortStructuralOperations(SimulationData& data);
+
+    //the result is optional: the timestep kernels pass it to count the structural operations while
+    //the edit kernels process user-triggered operations which should not show up in the statistics
+    //
+    //contention semantics: the scheduled operations are applied under non-blocking try-locks on
+    //the involved cells; an operation that hits a locked cell is dropped for this timestep, it is
+    //never waited on, so contended topology updates cannot stall the kernel
+    __inline__ __device__ static void processConnectionsOperations(SimulationData& data, SimulationResult* result = nullptr);
+    __inline__ __device__ static void processDelCellOperations(SimulationData& data, SimulationResult* result = nullptr);
 
     __inline__ __device__ static void addConnections(
         SimulationData& data,
@@ -26,10 +38,10 @@ public:
         float desiredAngleOnCell2,
         float desiredDistance,
         int angleAlignment = 0);
-    __inline__ __device__ static void delConnections(Cell* cell1, Cell* cell2);
+    __inline__ __device__ static void delConnections(SimulationData& data, Cell* cell1, Cell* cell2);
 
 private:
-    __inline__ __device__ static void addConnectionsIntern(SimulationData& data, Cell* cell1, Cell* cell2, bool addTokens);
+    __inline__ __device__ static void addConnectionsIntern(SimulationData& data, Cell* cell1, Cell* cell2, bool addTokens, SimulationResult* result);
     __inline__ __device__ static void addConnectionIntern(
         SimulationData& data,
         Cell* cell1,
@@ -39,11 +51,11 @@ private:
         float desiredAngleOnCell1 = 0,
         int angleAlignment = 0);
 
-    __inline__ __device__ static void delConnectionsIntern(Cell* cell);
-    __inline__ __device__ static void delConnectionIntern(Cell* cell1, Cell* cell2);
+    __inline__ __device__ static void delConnectionsIntern(Cell* cell, SimulationResult* result);
+    __inline__ __device__ static void delConnectionIntern(Cell* cell1, Cell* cell2, SimulationResult* result);
     __inline__ __device__ static void delConnectionOneWay(Cell* cell1, Cell* cell2);
 
-    __inline__ __device__ static void delCell(SimulationData& data, Cell* cell, int cellIndex);
+    __inline__ __device__ static void delCell(SimulationData& data, Cell* cell, int cellIndex, SimulationResult* result);
 };
 
 /************************************************************************/
@@ -98,20 +110,73 @@ CellConnectionProcessor::scheduleDelCellAndConnections(SimulationData& data, Cel
     data.structuralOperations.tryAddEntry(operation);
 }
 
-__inline__ __device__ void CellConnectionProcessor::processConnectionsOperations(SimulationData& data)
+__inline__ __device__ void CellConnectionProcessor::sortStructuralOperations(SimulationData& data)
+{
+    //sort key: operation type first, then the ids of the involved cells; cell ids are unique and
+    //independent of the scheduling order, so the resulting order is reproducible
+    auto getSortKeys = [](StructuralOperation const& operation, uint64_t& id1, uint64_t& id2) {
+        id1 = 0;
+        id2 = 0;
+        switch (operation.type) {
+        case StructuralOperation::Type::AddConnections:
+            id1 = operation.data.addConnectionOperation.cell->id;
+            id2 = operation.data.addConnectionOperation.otherCell->id;
+            break;
+        case StructuralOperation::Type::DelConnections:
+            id1 = operation.data.delConnectionsOperation.cell->id;
+            break;
+        case StructuralOperation::Type::DelConnection:
+            id1 = operation.data.delConnectionOperation.cell1->id;
+            id2 = operation.data.delConnectionOperation.cell2->id;
+            break;
+        case StructuralOperation::Type::DelCell:
+            id1 = operation.data.delCellOperation.cell->id;
+            break;
+        case StructuralOperation::Type::DelCellAndConnections:
+            id1 = operation.data.delCellAndConnectionOperation.cell->id;
+            break;
+        }
+    };
+    auto isOrderedBefore = [&getSortKeys](StructuralOperation const& left, StructuralOperation const& right) {
+        if (left.type != right.type) {
+            return static_cast<int>(left.type) < static_cast<int>(right.type);
+        }
+        uint64_t leftId1, leftId2, rightId1, rightId2;
+        getSortKeys(left, leftId1, leftId2);
+        getSortKeys(right, rightId1, rightId2);
+        if (leftId1 != rightId1) {
+            return leftId1 < rightId1;
+        }
+        return leftId2 < rightId2;
+    };
+
+    //insertion sort: the number of scheduled operations per timestep is small compared to the
+    //number of cells and deterministic mode does not aim for speed
+    auto numEntries = data.structuralOperations.getNumEntries();
+    for (int i = 1; i < numEntries; ++i) {
+        auto operation = data.structuralOperations.at(i);
+        int j = i - 1;
+        for (; j >= 0 && isOrderedBefore(operation, data.structuralOperations.at(j)); --j) {
+            data.structuralOperations.at(j + 1) = data.structuralOperations.at(j);
+        }
+        data.structuralOperations.at(j + 1) = operation;
+    }
+}
+
+__inline__ __device__ void CellConnectionProcessor::processConnectionsOperations(SimulationData& data, SimulationResult* result)
 {
     auto partition = calcAllThreadsPartition(data.structuralOperations.getNumOrigEntries());
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto const& operation = data.structuralOperations.at(index);
         if (StructuralOperation::Type::DelConnection == operation.type) {
-            delConnectionIntern(operation.data.delConnectionOperation.cell1, operation.data.delConnectionOperation.cell2);
+            delConnectionIntern(operation.data.delConnectionOperation.cell1, operation.data.delConnectionOperation.cell2, result);
         }
         if (StructuralOperation::Type::DelConnections == operation.type) {
-            delConnectionsIntern(operation.data.delConnectionsOperation.cell);
+            delConnectionsIntern(operation.data.delConnectionsOperation.cell, result);
         }
         if (StructuralOperation::Type::DelCellAndConnections == operation.type) {
-            delConnectionsIntern(operation.data.delConnectionsOperation.cell);
+            delConnectionsIntern(operation.data.delConnectionsOperation.cell, result);
 
             scheduleDelCell(
                 data,
@@ -123,19 +188,20 @@ __inline__ __device__ void CellConnectionProcessor::processConnectionsOperations
                 data,
                 operation.data.addConnectionOperation.cell,
                 operation.data.addConnectionOperation.otherCell,
-                operation.data.addConnectionOperation.addTokens);
+                operation.data.addConnectionOperation.addTokens,
+                result);
         }
     }
 }
 
-__inline__ __device__ void CellConnectionProcessor::processDelCellOperations(SimulationData& data)
+__inline__ __device__ void CellConnectionProcessor::processDelCellOperations(SimulationData& data, SimulationResult* result)
 {
     auto partition = calcAllThreadsPartition(data.structuralOperations.getNumEntries());
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto const& operation = data.structuralOperations.at(index);
         if (StructuralOperation::Type::DelCell == operation.type) {
-            delCell(data, operation.data.delCellOperation.cell, operation.data.delCellOperation.cellIndex);
+            delCell(data, operation.data.delCellOperation.cell, operation.data.delCellOperation.cellIndex, result);
         }
     }
 }
@@ -153,17 +219,19 @@ __inline__ __device__ void CellConnectionProcessor::addConnections(
     data.cellMap.correctDirection(posDelta);
     addConnectionIntern(data, cell1, cell2, posDelta, desiredDistance, desiredAngleOnCell1, angleAlignment);
     addConnectionIntern(data, cell2, cell1, posDelta * (-1), desiredDistance, desiredAngleOnCell2, angleAlignment);
+    atomicAdd(data.numStructuralChanges, 1);
 }
 
 __inline__ __device__ void
-CellConnectionProcessor::delConnections(Cell* cell1, Cell* cell2)
+CellConnectionProcessor::delConnections(SimulationData& data, Cell* cell1, Cell* cell2)
 {
     delConnectionOneWay(cell1, cell2);
     delConnectionOneWay(cell2, cell1);
+    atomicAdd(data.numStructuralChanges, 1);
 }
 
 __inline__ __device__ void
-CellConnectionProcessor::addConnectionsIntern(SimulationData& data, Cell* cell1, Cell* cell2, bool addTokens)
+CellConnectionProcessor::addConnectionsIntern(SimulationData& data, Cell* cell1, Cell* cell2, bool addTokens, SimulationResult* result)
 {
     SystemDoubleLock lock;
     lock.init(&cell1->locked, &cell2->locked);
@@ -183,6 +251,9 @@ CellConnectionProcessor::addConnectionsIntern(SimulationData& data, Cell* cell1,
             data.cellMap.correctDirection(posDelta);
             addConnectionIntern(data, cell1, cell2, posDelta, Math::length(posDelta));
             addConnectionIntern(data, cell2, cell1, posDelta * (-1), Math::length(posDelta));
+            if (result) {
+                result->incCreatedConnection();
+            }
 
 /*
             //align connections
@@ -312,7 +383,7 @@ __inline__ __device__ void CellConnectionProcessor::addConnectionIntern(
 
 }
 
-__inline__ __device__ void CellConnectionProcessor::delConnectionsIntern(Cell* cell)
+__inline__ __device__ void CellConnectionProcessor::delConnectionsIntern(Cell* cell, SimulationResult* result)
 {
     for (int i = cell->numConnections - 1; i >= 0; --i) {
         auto connectedCell = cell->connections[0].cell;
@@ -323,6 +394,9 @@ __inline__ __device__ void CellConnectionProcessor::delConnectionsIntern(Cell* c
             if (cell->numConnections > 0) {
                 delConnectionOneWay(cell, connectedCell);
                 delConnectionOneWay(connectedCell, cell);
+                if (result) {
+                    result->incDestroyedConnection();
+                }
             }
 
             lock.releaseLock();
@@ -330,13 +404,16 @@ __inline__ __device__ void CellConnectionProcessor::delConnectionsIntern(Cell* c
     }
 }
 
-__inline__ __device__ void CellConnectionProcessor::delConnectionIntern(Cell* cell1, Cell* cell2)
+__inline__ __device__ void CellConnectionProcessor::delConnectionIntern(Cell* cell1, Cell* cell2, SimulationResult* result)
 {
     SystemDoubleLock lock;
     lock.init(&cell1->locked, &cell2->locked);
     if (lock.tryLock()) {
         delConnectionOneWay(cell1, cell2);
         delConnectionOneWay(cell2, cell1);
+        if (result) {
+            result->incDestroyedConnection();
+        }
         lock.releaseLock();
     }
 }
@@ -362,7 +439,7 @@ __inline__ __device__ void CellConnectionProcessor::delConnectionOneWay(Cell* ce
     }
 }
 
-__inline__ __device__ void CellConnectionProcessor::delCell(SimulationData& data, Cell* cell, int cellIndex)
+__inline__ __device__ void CellConnectionProcessor::delCell(SimulationData& data, Cell* cell, int cellIndex, SimulationResult* result)
 {
     if (cell->tryLock()) {
 
@@ -371,8 +448,12 @@ __inline__ __device__ void CellConnectionProcessor::delCell(SimulationData& data
             factory.init(&data);
             factory.createParticle(cell->energy, cell->absPos, cell->vel, {cell->metadata.color});
             cell->setDeleted();
+            data.logCellEvent(CellEvent::Type_CellDeath, cell->id, cell->absPos, cell->metadata.color);
 
             data.entities.cellPointers.at(cellIndex) = nullptr;
+            if (result) {
+                result->incDeletedCell();
+            }
         }
 
         cell->releaseLock();
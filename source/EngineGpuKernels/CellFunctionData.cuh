@@ -1,15 +1,22 @@
 #pragma once
 
+#include "CommunicatorMap.cuh"
 #include "DensityMap.cuh"
 
 struct CellFunctionData
 {
     DensityMap densityMap;
+    CommunicatorMap communicatorMap;
 
     __host__ __inline__ void init(int2 const& worldSize)
     {
         densityMap.init(worldSize, 8);
+        communicatorMap.init(worldSize);
     }
 
-    __host__ __inline__ void free() { densityMap.free(); }
+    __host__ __inline__ void free()
+    {
+        densityMap.free();
+        communicatorMap.free();
+    }
 };
@@ -19,24 +19,35 @@ public:
     __inline__ __device__ void updateMap(SimulationData& data);
     __inline__ __device__ void clearDensityMap(SimulationData& data);
     __inline__ __device__ void fillDensityMap(SimulationData& data);
+    __inline__ __device__ void compactActiveCells(SimulationData& data);  //builds the list of non-barrier cells for the dynamics stages
+    template<bool hasSpots>
     __inline__ __device__ void applyMutation(SimulationData& data);
 
+    template<bool hasSpots>
     __inline__ __device__ void collisions(SimulationData& data);    //prerequisite: clearTag
+    template<bool hasSpots>
     __inline__ __device__ void checkForces(SimulationData& data);
     __inline__ __device__ void updateVelocities(SimulationData& data);    //prerequisite: tag from collisions
 
+    template<bool hasSpots>
     __inline__ __device__ void calcConnectionForces(SimulationData& data);
     __inline__ __device__ void checkConnections(SimulationData& data);
     __inline__ __device__ void verletUpdatePositions(SimulationData& data);
     __inline__ __device__ void verletUpdateVelocities(SimulationData& data);
 
     __inline__ __device__ void applyInnerFriction(SimulationData& data);
+    template<bool hasSpots>
     __inline__ __device__ void applyFriction(SimulationData& data);
 
+    template<bool hasSpots>
     __inline__ __device__ void radiation(SimulationData& data);
+    template<bool hasSpots>
     __inline__ __device__ void decay(SimulationData& data);
 
 private:
+    template<bool hasSpots>
+    __inline__ __device__ void processCollision(SimulationData& data, Cell* cell, Cell* otherCell);
+
     SimulationData* _data;
     PartitionData _partition;
 };
@@ -79,29 +90,51 @@ __inline__ __device__ void CellProcessor::updateMap(SimulationData& data)
 __inline__ __device__ void CellProcessor::clearDensityMap(SimulationData& data)
 {
     data.cellFunctionData.densityMap.clear();
+    data.cellFunctionData.communicatorMap.clear();
 }
 
 __inline__ __device__ void CellProcessor::fillDensityMap(SimulationData& data)
 {
     auto const partition = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        data.cellFunctionData.densityMap.addCell(data.entities.cellPointers.at(index));
+        auto& cell = data.entities.cellPointers.at(index);
+        data.cellFunctionData.densityMap.addCell(cell);
+        data.cellFunctionData.communicatorMap.addCell(cell);
+    }
+}
+
+__inline__ __device__ void CellProcessor::compactActiveCells(SimulationData& data)
+{
+    auto const partition = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& cell = data.entities.cellPointers.at(index);
+        if (!cell->barrier && !data.isFrozen(cell->absPos)) {
+            data.activeCellIndexes.tryAddEntry(index);
+        }
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::applyMutation(SimulationData& data)
 {
     auto const partition = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = data.entities.cellPointers.at(index);
-        if (cell->barrier) {
+        if (cell->barrier || data.isFrozen(cell->absPos)) {
             continue;
         }
-        auto mutationRate = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMutationRate, data, cell->absPos);
+        auto mutationRate = SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellMutationRate, data, cell->absPos);
         if (data.numberGen2.random() < 0.001f && data.numberGen1.random() < mutationRate * 1000) {
             auto address = data.numberGen1.random(MAX_CELL_STATIC_BYTES + 2);
             if (address < MAX_CELL_STATIC_BYTES) {
-                cell->staticData[address] = data.numberGen1.random(255);
+
+                //the genome block is shared with the clones => mutate a private copy and reinsert it (copy-on-write)
+                char staticData[MAX_CELL_STATIC_BYTES];
+                for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+                    staticData[i] = cell->staticData[i];
+                }
+                staticData[address] = data.numberGen1.random(255);
+                cell->staticData = data.entities.genomes.getOrInsert(staticData);
             } else if (address == MAX_CELL_STATIC_BYTES) {
                 cell->metadata.color = data.numberGen1.random(6);
             } else if (address == MAX_CELL_STATIC_BYTES + 1) {
@@ -115,132 +148,213 @@ __inline__ __device__ void CellProcessor::applyMutation(SimulationData& data)
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::collisions(SimulationData& data)
 {
     _data = &data;
+
+    auto constexpr tileSize = CellMap::TileSize;
+    auto constexpr haloSize = tileSize + 2;
+
+    //each block stages one map tile plus a one-position halo in shared memory and resolves all
+    //collisions of the tile's cells against it; this replaces the former per-thread neighborhood
+    //probing which re-read the same map slots many times across a block
+    //(a persistent per-cell verlet list was evaluated as an alternative and costs more than it
+    //saves here: collisions is the only broad-phase consumer, and the remaining probes in the
+    //token functions are too sparse to amortize the list construction)
+    __shared__ Cell* tile[haloSize * haloSize * 2];
+
+    //blocks claim tiles from a shared cursor instead of owning a static blockIdx-strided range:
+    //the occupied tiles concentrate in few index ranges on dense worlds, so a static assignment
+    //leaves most blocks finished while few straggle through the dense ranges
+    __shared__ int claimedTileIndex;
+    auto numTiles = data.cellMap.getNumTiles();
+    while (true) {
+        __syncthreads();
+        if (0 == threadIdx.x) {
+            claimedTileIndex = atomicAdd(data.workCursors + SimulationData::WorkCursor_Collisions, 1);
+        }
+        __syncthreads();
+        auto tileIndex = claimedTileIndex;
+        if (tileIndex >= numTiles) {
+            break;
+        }
+        auto tileOrigin = data.cellMap.getTileOrigin(tileIndex);
+        if (!data.cellMap.isTileOccupied(tileOrigin)) {
+            continue;
+        }
+
+        auto loadPartition = calcPartition(haloSize * haloSize, threadIdx.x, blockDim.x);
+        for (int index = loadPartition.startIndex; index <= loadPartition.endIndex; ++index) {
+            int2 scanPos{tileOrigin.x + index % haloSize - 1, tileOrigin.y + index / haloSize - 1};
+            data.cellMap.correctPosition(scanPos);
+            tile[index * 2] = data.cellMap.getFromSlot(scanPos, 0);
+            tile[index * 2 + 1] = data.cellMap.getFromSlot(scanPos, 1);
+        }
+        __syncthreads();
+
+        auto tilePartition = calcPartition(tileSize * tileSize, threadIdx.x, blockDim.x);
+        for (int index = tilePartition.startIndex; index <= tilePartition.endIndex; ++index) {
+            int2 tilePos{index % tileSize, index / tileSize};
+            if (tileOrigin.x + tilePos.x >= data.worldSize.x || tileOrigin.y + tilePos.y >= data.worldSize.y) {
+                continue;
+            }
+            for (int slot = 0; slot < 2; ++slot) {
+                auto cell = tile[((tilePos.x + 1) + (tilePos.y + 1) * haloSize) * 2 + slot];
+                if (!cell) {
+                    break;  //the second slot is only occupied if the first one is
+                }
+                for (int dx = -1; dx <= 1; ++dx) {
+                    for (int dy = -1; dy <= 1; ++dy) {
+                        auto tileEntry = ((tilePos.x + 1 + dx) + (tilePos.y + 1 + dy) * haloSize) * 2;
+                        for (int otherSlot = 0; otherSlot < 2; ++otherSlot) {
+                            auto otherCell = tile[tileEntry + otherSlot];
+                            if (!otherCell) {
+                                break;
+                            }
+                            if (otherCell == cell) {
+                                continue;
+                            }
+                            processCollision<hasSpots>(data, cell, otherCell);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    //cells that did not obtain one of the two slots of their map position are not part of any
+    //tile (they are already invisible to neighbors); they still exert their own-side forces
     auto& cells = data.entities.cellPointers;
-    _partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    auto partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
     Cell* otherCells[18];
     int numOtherCells;
-    for (int index = _partition.startIndex; index <= _partition.endIndex; ++index) {
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
+        if (data.cellMap.isRegistered(cell)) {
+            continue;
+        }
         data.cellMap.get(otherCells, numOtherCells, cell->absPos);
         for (int i = 0; i < numOtherCells; ++i) {
             Cell* otherCell = otherCells[i];
-
             if (!otherCell || otherCell == cell) {
                 continue;
             }
+            processCollision<hasSpots>(data, cell, otherCell);
+        }
+    }
+}
 
-            auto posDelta = cell->absPos - otherCell->absPos;
-            data.cellMap.correctDirection(posDelta);
+template<bool hasSpots>
+__inline__ __device__ void CellProcessor::processCollision(SimulationData& data, Cell* cell, Cell* otherCell)
+{
+    auto posDelta = cell->absPos - otherCell->absPos;
+    data.cellMap.correctDirection(posDelta);
 
-            auto distance = Math::length(posDelta);
-            if (distance >= cudaSimulationParameters.cellMaxCollisionDistance
-                /*|| distance <= cudaSimulationParameters.cellMinDistance*/) {
-                continue;
-            }
+    auto distance = Math::length(posDelta);
+    if (distance >= cudaSimulationParameters.cellMaxCollisionDistance
+        /*|| distance <= cudaSimulationParameters.cellMinDistance*/) {
+        return;
+    }
 
-            if (distance < cudaSimulationParameters.cellMinDistance && cell->numConnections > 1 && !cell->barrier) {
-                CellConnectionProcessor::scheduleDelConnections(data, cell);
-            }
+    if (distance < cudaSimulationParameters.cellMinDistance && cell->numConnections > 1 && !cell->barrier) {
+        CellConnectionProcessor::scheduleDelConnections(data, cell);
+    }
 
-            bool alreadyConnected = false;
-            for (int i = 0; i < cell->numConnections; ++i) {
-                auto const& connectedCell = cell->connections[i].cell;
-                if (connectedCell == otherCell) {
-                    alreadyConnected = true;
-                    break;
-                }
-            }
+    bool alreadyConnected = false;
+    for (int i = 0; i < cell->numConnections; ++i) {
+        auto const& connectedCell = cell->connections[i].cell;
+        if (connectedCell == otherCell) {
+            alreadyConnected = true;
+            break;
+        }
+    }
 
-            if (!alreadyConnected) {
-                auto velDelta = cell->vel - otherCell->vel;
-                auto isApproaching = Math::dot(posDelta, velDelta) < 0;
-                auto barrierFactor = cell->barrier ? 2 : 1;
-
-                if (Math::length(cell->vel) > 0.5f && isApproaching) {  //&& cell->numConnections == 0 
-                    auto distanceSquared = distance * distance + 0.25;
-                    auto force = posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
-                    atomicAdd(&cell->temp1.x, force.x);
-                    atomicAdd(&cell->temp1.y, force.y);
-                    atomicAdd(&otherCell->temp1.x, -force.x);
-                    atomicAdd(&otherCell->temp1.y, -force.y);
-                }
-                else {
-                    auto force = Math::normalized(posDelta)
-                        * (cudaSimulationParameters.cellMaxCollisionDistance - Math::length(posDelta))
-                        * cudaSimulationParameters.cellRepulsionStrength * barrierFactor;  ///12, 32
-                    atomicAdd(&cell->temp1.x, force.x);
-                    atomicAdd(&cell->temp1.y, force.y);
-                    atomicAdd(&otherCell->temp1.x, -force.x);
-                    atomicAdd(&otherCell->temp1.y, -force.y);
-                }
+    if (!alreadyConnected) {
+        auto velDelta = cell->vel - otherCell->vel;
+        auto isApproaching = Math::dot(posDelta, velDelta) < 0;
+        auto barrierFactor = cell->barrier ? 2 : 1;
+
+        if (Math::length(cell->vel) > 0.5f && isApproaching) {  //&& cell->numConnections == 0
+            auto distanceSquared = distance * distance + 0.25;
+            auto force = posDelta * Math::dot(velDelta, posDelta) / (-2 * distanceSquared) * barrierFactor;
+            atomicAdd(&cell->temp1.x, force.x);
+            atomicAdd(&cell->temp1.y, force.y);
+            atomicAdd(&otherCell->temp1.x, -force.x);
+            atomicAdd(&otherCell->temp1.y, -force.y);
+        }
+        else {
+            auto force = Math::normalized(posDelta)
+                * (cudaSimulationParameters.cellMaxCollisionDistance - Math::length(posDelta))
+                * cudaSimulationParameters.cellRepulsionStrength * barrierFactor;  ///12, 32
+            atomicAdd(&cell->temp1.x, force.x);
+            atomicAdd(&cell->temp1.y, force.y);
+            atomicAdd(&otherCell->temp1.x, -force.x);
+            atomicAdd(&otherCell->temp1.y, -force.y);
+        }
 
-                if (cell->numConnections < cell->maxConnections && otherCell->numConnections < otherCell->maxConnections
-                    && Math::length(velDelta)
-                        >= SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFusionVelocity, data, cell->absPos)
-                    && isApproaching && cell->energy <= cudaSimulationParameters.spotValues.cellMaxBindingEnergy
-                    && otherCell->energy <= cudaSimulationParameters.spotValues.cellMaxBindingEnergy
-                    && !cell->barrier && !otherCell->barrier) {
-                        CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell, true);
+        if (cell->numConnections < cell->maxConnections && otherCell->numConnections < otherCell->maxConnections
+            && Math::length(velDelta)
+                >= SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellFusionVelocity, data, cell->absPos)
+            && isApproaching && cell->energy <= cudaSimulationParameters.spotValues.cellMaxBindingEnergy
+            && otherCell->energy <= cudaSimulationParameters.spotValues.cellMaxBindingEnergy
+            && !cell->barrier && !otherCell->barrier) {
+                CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell, true);
 /*
-                    //create connection only in case branch numbers fit
-                    bool ascending = cell->numConnections > 0
-                        && ((cell->branchNumber - (cell->connections[0].cell->branchNumber + 1)) % cudaSimulationParameters.cellMaxTokenBranchNumber == 0);
-                    if (ascending && (otherCell->branchNumber - (cell->branchNumber + 1)) % cudaSimulationParameters.cellMaxTokenBranchNumber == 0) {
-                        CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell, true);
-                    }
-                    if (!ascending && (cell->branchNumber - (otherCell->branchNumber + 1)) % cudaSimulationParameters.cellMaxTokenBranchNumber == 0) {
-                        CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell, true);
-                    }
+            //create connection only in case branch numbers fit
+            bool ascending = cell->numConnections > 0
+                && ((cell->branchNumber - (cell->connections[0].cell->branchNumber + 1)) % cudaSimulationParameters.cellMaxTokenBranchNumber == 0);
+            if (ascending && (otherCell->branchNumber - (cell->branchNumber + 1)) % cudaSimulationParameters.cellMaxTokenBranchNumber == 0) {
+                CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell, true);
+            }
+            if (!ascending && (cell->branchNumber - (otherCell->branchNumber + 1)) % cudaSimulationParameters.cellMaxTokenBranchNumber == 0) {
+                CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell, true);
+            }
 */
 
-                }
-            }
+        }
+    }
 /*
-            if (!alreadyConnected) {
-                auto velDelta = cell->vel - otherCell->vel;
-                auto isApproaching = Math::dot(posDelta, velDelta) < 0;
-
-                if (Math::length(cell->vel) < 0.5f || !isApproaching || cell->numConnections > 0) {
-                    auto force = Math::normalized(posDelta)
-                        * (cudaSimulationParameters.cellMaxDistance - Math::length(posDelta)) / 6;
-                    atomicAdd(&cell->temp1.x, force.x);
-                    atomicAdd(&cell->temp1.y, force.y);
-                } else {
-                    auto force1 = posDelta * Math::dot(velDelta, posDelta) / (-2 * Math::lengthSquared(posDelta));
-                    auto force2 = posDelta * Math::dot(velDelta, posDelta) / (2 * Math::lengthSquared(posDelta));
-                    atomicAdd(&cell->temp1.x, force1.x);
-                    atomicAdd(&cell->temp1.y, force1.y);
-                    atomicAdd(&otherCell->temp1.x, force2.x);
-                    atomicAdd(&otherCell->temp1.y, force2.y);
-                }
+    if (!alreadyConnected) {
+        auto velDelta = cell->vel - otherCell->vel;
+        auto isApproaching = Math::dot(posDelta, velDelta) < 0;
+
+        if (Math::length(cell->vel) < 0.5f || !isApproaching || cell->numConnections > 0) {
+            auto force = Math::normalized(posDelta)
+                * (cudaSimulationParameters.cellMaxDistance - Math::length(posDelta)) / 6;
+            atomicAdd(&cell->temp1.x, force.x);
+            atomicAdd(&cell->temp1.y, force.y);
+        } else {
+            auto force1 = posDelta * Math::dot(velDelta, posDelta) / (-2 * Math::lengthSquared(posDelta));
+            auto force2 = posDelta * Math::dot(velDelta, posDelta) / (2 * Math::lengthSquared(posDelta));
+            atomicAdd(&cell->temp1.x, force1.x);
+            atomicAdd(&cell->temp1.y, force1.y);
+            atomicAdd(&otherCell->temp1.x, force2.x);
+            atomicAdd(&otherCell->temp1.y, force2.y);
+        }
 
-                if (cell->numConnections < cell->maxConnections && otherCell->numConnections < otherCell->maxConnections
-                    && Math::length(velDelta) >= cudaSimulationParameters.cellFusionVelocity && isApproaching) {
-                    CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell);
-                }
-            }
-*/
+        if (cell->numConnections < cell->maxConnections && otherCell->numConnections < otherCell->maxConnections
+            && Math::length(velDelta) >= cudaSimulationParameters.cellFusionVelocity && isApproaching) {
+            CellConnectionProcessor::scheduleAddConnections(data, cell, otherCell);
         }
     }
+*/
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::checkForces(SimulationData& data)
 {
     auto& cells = data.entities.cellPointers;
-    auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    auto const partition =
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
     _data = &data;
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+    for (int activeIndex = partition.startIndex; activeIndex <= partition.endIndex; ++activeIndex) {
+        auto index = data.activeCellIndexes.at(activeIndex);
         auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
-        }
 
-        if (Math::length(cell->temp1) > SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMaxForce, data, cell->absPos)) {
+        if (Math::length(cell->temp1) > SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellMaxForce, data, cell->absPos)) {
             if (data.numberGen1.random() < cudaSimulationParameters.cellMaxForceDecayProb) {
                 CellConnectionProcessor::scheduleDelCellAndConnections(data, cell, index);
             }
@@ -255,41 +369,54 @@ __inline__ __device__ void CellProcessor::updateVelocities(SimulationData& data)
         calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
     _data = &data;
 
+    auto cellArray = data.entities.cells.getArray();
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
+        if (!cell->barrier && !data.isFrozen(cell->absPos)) {
+            cell->vel = cell->vel + cell->temp1;
+            if (Math::length(cell->vel) > cudaSimulationParameters.cellMaxVel) {
+                cell->vel = Math::normalized(cell->vel) * cudaSimulationParameters.cellMaxVel;
+            }
+            cell->temp1 = {0, 0};
+        } else {
+            cell->temp1 = {0, 0};    //collision forces from unfrozen neighbors must not accumulate
         }
 
-        cell->vel = cell->vel + cell->temp1;
-        if (Math::length(cell->vel) > cudaSimulationParameters.cellMaxVel) {
-            cell->vel = Math::normalized(cell->vel) * cudaSimulationParameters.cellMaxVel;
-        }
-        cell->temp1 = {0, 0};
+        //refresh the SoA mirror for the subsequent physics substeps (also for barrier cells)
+        auto slot = toInt(cell - cellArray);
+        data.cellSoA.absPos[slot] = cell->absPos;
+        data.cellSoA.vel[slot] = cell->vel;
+        data.cellSoA.energy[slot] = cell->energy;
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::calcConnectionForces(SimulationData& data)
 {
     _data = &data;
     auto& cells = data.entities.cellPointers;
-    auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    auto const partition =
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        auto& cell = cells.at(index);
-        if (0 == cell->numConnections || cell->barrier) {
+    auto cellArray = data.entities.cells.getArray();
+    for (int activeIndex = partition.startIndex; activeIndex <= partition.endIndex; ++activeIndex) {
+        auto& cell = cells.at(data.activeCellIndexes.at(activeIndex));
+        if (0 == cell->numConnections) {
             continue;
         }
         float2 force{0, 0};
-        float2 prevDisplacement = cell->connections[cell->numConnections - 1].cell->absPos - cell->absPos;
+
+        //neighbor positions are loaded from the SoA mirror to avoid dragging whole Cell records through the cache
+        auto const& cellSoA = data.cellSoA;
+        float2 prevDisplacement = cellSoA.absPos[cell->connections[cell->numConnections - 1].cell - cellArray] - cell->absPos;
         data.cellMap.correctDirection(prevDisplacement);
 
-        auto cellBindingForce = SpotCalculator::calcParameter(
+        auto cellBindingForce = SpotCalculator::calcParameter<hasSpots>(
             &SimulationParametersSpotValues::cellBindingForce, data, cell->absPos);
         for (int i = 0; i < cell->numConnections; ++i) {
             auto connectedCell = cell->connections[i].cell;
 
-            auto displacement = connectedCell->absPos - cell->absPos;
+            auto displacement = cellSoA.absPos[connectedCell - cellArray] - cell->absPos;
             data.cellMap.correctDirection(displacement);
 
             auto actualDistance = Math::length(displacement);
@@ -351,19 +478,19 @@ __inline__ __device__ void CellProcessor::checkConnections(SimulationData& data)
 {
     _data = &data;
     auto& cells = data.entities.cellPointers;
-    auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    auto const partition =
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
-        }
+    auto cellArray = data.entities.cells.getArray();
+    for (int activeIndex = partition.startIndex; activeIndex <= partition.endIndex; ++activeIndex) {
+        auto& cell = cells.at(data.activeCellIndexes.at(activeIndex));
 
         bool scheduleForDestruction = false;
         for (int i = 0; i < cell->numConnections; ++i) {
             auto connectingCell = cell->connections[i].cell;
 
-            auto displacement = connectingCell->absPos - cell->absPos;
+            //neighbor positions are loaded from the SoA mirror to avoid dragging whole Cell records through the cache
+            auto displacement = data.cellSoA.absPos[connectingCell - cellArray] - cell->absPos;
             data.cellMap.correctDirection(displacement);
             auto actualDistance = Math::length(displacement);
             if (actualDistance > cudaSimulationParameters.cellMaxBindingDistance) {
@@ -381,17 +508,16 @@ __inline__ __device__ void CellProcessor::verletUpdatePositions(SimulationData&
     _data = &data;
     auto& cells = data.entities.cellPointers;
     auto const partition =
-        calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
-        }
+    auto cellArray = data.entities.cells.getArray();
+    for (int activeIndex = partition.startIndex; activeIndex <= partition.endIndex; ++activeIndex) {
+        auto& cell = cells.at(data.activeCellIndexes.at(activeIndex));
 
         cell->absPos = cell->absPos + cell->vel * cudaSimulationParameters.timestepSize
             + cell->temp1 * cudaSimulationParameters.timestepSize * cudaSimulationParameters.timestepSize / 2;
         data.cellMap.correctPosition(cell->absPos);
+        data.cellSoA.absPos[cell - cellArray] = cell->absPos;
         cell->temp2 = cell->temp1;  //forces
         cell->temp1 = {0, 0};
     }
@@ -405,7 +531,7 @@ __inline__ __device__ void CellProcessor::verletUpdateVelocities(SimulationData&
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        if (cell->barrier) {
+        if (cell->barrier || data.isFrozen(cell->absPos)) {
             cell->vel = {0, 0};
         } else {
             auto acceleration = (cell->temp1 + cell->temp2) / 2;
@@ -418,14 +544,11 @@ __inline__ __device__ void CellProcessor::applyInnerFriction(SimulationData& dat
 {
     auto& cells = data.entities.cellPointers;
     auto const partition =
-        calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
     constexpr float innerFriction = 0.3f;
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
-        }
+        auto& cell = cells.at(data.activeCellIndexes.at(index));
         for (int index = 0; index < cell->numConnections; ++index) {
             auto connectingCell = cell->connections[index].cell;
 
@@ -441,34 +564,63 @@ __inline__ __device__ void CellProcessor::applyInnerFriction(SimulationData& dat
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::applyFriction(SimulationData& data)
 {
     auto& cells = data.entities.cellPointers;
     auto const partition =
-        calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
+    auto cellArray = data.entities.cells.getArray();
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
-        auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
+        auto& cell = cells.at(data.activeCellIndexes.at(index));
+
+        //drain the muscle impulses accumulated in this timestep; this loop is the only writer of
+        //vel in this substep, so the buffer can be applied without atomics
+        auto& impulse = data.cellSoA.impulse[cell - cellArray];
+        if (impulse.x != 0 || impulse.y != 0) {
+            cell->vel = cell->vel + impulse;
+            impulse = {0, 0};
         }
 
-        auto friction = SpotCalculator::calcParameter(&SimulationParametersSpotValues::friction, data, cell->absPos);
+        auto friction = SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::friction, data, cell->absPos);
         cell->vel = cell->vel * (1.0f - friction);
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::radiation(SimulationData& data)
 {
     auto& cells = data.entities.cellPointers;
 
     auto partition =
         calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+
+    auto const radiationProb = cudaSimulationParameters.radiationProb;
+    if (radiationProb <= 0) {
+        return;
+    }
+
+    //geometric-gap sampling: emission is rare, so instead of one dice roll per cell each thread
+    //draws the gap to its next emitting cell from the geometric distribution and jumps there
+    //directly; equivalent in distribution to a bernoulli draw per cell, but the number of random
+    //numbers consumed scales with the emission events instead of with the population
+    auto const logOneMinusProb = logf(1.0f - radiationProb);
+    int index = partition.startIndex;
+    while (index <= partition.endIndex) {
+        auto u = data.numberGen1.random();
+        if (u <= 0) {
+            break;
+        }
+        auto gap = logf(u) / logOneMinusProb;  //gap == 0 with probability radiationProb (and always for radiationProb >= 1)
+        if (!(gap <= toFloat(partition.endIndex - index))) {
+            break;
+        }
+        index += floorInt(gap);
         auto& cell = cells.at(index);
-        if (data.numberGen1.random() < cudaSimulationParameters.radiationProb && !cell->barrier) {
+        if (!cell->barrier && !data.isFrozen(cell->absPos)) {
             auto radiationFactor =
-                SpotCalculator::calcParameter(&SimulationParametersSpotValues::radiationFactor, data, cell->absPos);
+                SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::radiationFactor, data, cell->absPos);
             if (radiationFactor > 0) {
 
                 auto& pos = cell->absPos;
@@ -496,37 +648,36 @@ __inline__ __device__ void CellProcessor::radiation(SimulationData& data)
                 }
             }
         }
+        ++index;
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void CellProcessor::decay(SimulationData& data)
 {
     _data = &data;
     auto& cells = data.entities.cellPointers;
     auto partition =
-        calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        calcPartition(data.activeCellIndexes.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+    for (int activeIndex = partition.startIndex; activeIndex <= partition.endIndex; ++activeIndex) {
+        auto index = data.activeCellIndexes.at(activeIndex);
         auto& cell = cells.at(index);
-        if (cell->barrier) {
-            continue;
-        }
-
         bool destroyDueToInvocations = false;
         if (cell->cellFunctionInvocations > 0) {
-            auto cellFunctionMinInvocations = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionMinInvocations, data, cell->absPos);
+            auto cellFunctionMinInvocations = SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellFunctionMinInvocations, data, cell->absPos);
             if (cell->cellFunctionInvocations > cellFunctionMinInvocations) {
                 auto cellFunctionInvocationDecayProb =
-                    SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionInvocationDecayProb, data, cell->absPos);
+                    SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellFunctionInvocationDecayProb, data, cell->absPos);
                 if (_data->numberGen1.random() < cellFunctionInvocationDecayProb) {
                     destroyDueToInvocations = true;
                 }
             }
         }
 
-        auto cellMinEnergy = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
+        auto cellMinEnergy = SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
         auto cellMaxBindingEnergy =
-            SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMaxBindingEnergy, data, cell->absPos);
+            SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellMaxBindingEnergy, data, cell->absPos);
         if (cell->energy < cellMinEnergy || destroyDueToInvocations) {
             CellConnectionProcessor::scheduleDelCellAndConnections(data, cell, index);
         } else if (cell->energy > cellMaxBindingEnergy) {
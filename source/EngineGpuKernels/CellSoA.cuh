@@ -0,0 +1,55 @@
+#pragma once
+
+#include "CudaMemoryManager.cuh"
+#include "Definitions.cuh"
+
+//mirror of the hot Cell fields in structure-of-arrays form to allow coalesced loads in the physics kernels;
+//a cell occupies the slot which corresponds to its index within the cells array
+struct CellSoA
+{
+    float2* absPos;
+    float2* vel;
+    float* energy;
+
+    //velocity impulses accumulated by the muscle operations during a timestep and drained into
+    //Cell::vel once per cell in applyFriction; zero outside that window, so it only needs to be
+    //cleared when it is allocated
+    float2* impulse;
+
+    void init()
+    {
+        absPos = nullptr;
+        vel = nullptr;
+        energy = nullptr;
+        impulse = nullptr;
+        _size = 0;
+    }
+
+    void resize(int size)
+    {
+        if (size == _size) {
+            return;
+        }
+        free();
+        CudaMemoryManager::getInstance().acquireMemory<float2>(size, absPos);
+        CudaMemoryManager::getInstance().acquireMemory<float2>(size, vel);
+        CudaMemoryManager::getInstance().acquireMemory<float>(size, energy);
+        CudaMemoryManager::getInstance().acquireMemory<float2>(size, impulse);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(impulse, 0, sizeof(float2) * size));
+        _size = size;
+    }
+
+    void free()
+    {
+        if (_size > 0) {
+            CudaMemoryManager::getInstance().freeMemory(absPos);
+            CudaMemoryManager::getInstance().freeMemory(vel);
+            CudaMemoryManager::getInstance().freeMemory(energy);
+            CudaMemoryManager::getInstance().freeMemory(impulse);
+            _size = 0;
+        }
+    }
+
+private:
+    int _size = 0;
+};
@@ -25,9 +25,12 @@ __device__ __inline__ void ClusterProcessor::initClusterData(SimulationData& dat
     auto& cells = data.entities.cellPointers;
     auto const partition = calcAllThreadsPartition(cells.getNumEntries());
 
+    auto relabelingNeeded = 0 != *data.numStructuralChanges;
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        cell->clusterIndex = index;
+        if (relabelingNeeded) {
+            cell->clusterRepresentative = cell;
+        }
         cell->clusterBoundaries = 0;
         cell->clusterPos = {0, 0};
         cell->clusterVel = {0, 0};
@@ -39,6 +42,10 @@ __device__ __inline__ void ClusterProcessor::initClusterData(SimulationData& dat
 
 __device__ __inline__ void ClusterProcessor::findClusterIteration(SimulationData& data)
 {
+    if (0 == *data.numStructuralChanges) {
+        //the connection topology did not change since the last relabeling => the representatives are still valid
+        return;
+    }
     auto& cells = data.entities.cellPointers;
     auto const partition = calcAllThreadsPartition(cells.getNumEntries());
 
@@ -50,8 +57,8 @@ __device__ __inline__ void ClusterProcessor::findClusterIteration(SimulationData
             bool found = false;
             for (int j = 0; j < currentCell->numConnections; ++j) {
                 auto candidateCell = currentCell->connections[j].cell;
-                auto cellTag = currentCell->clusterIndex;
-                auto origTag = atomicMin(&candidateCell->clusterIndex, cellTag);
+                auto cellTag = reinterpret_cast<unsigned long long>(currentCell->clusterRepresentative);
+                auto origTag = atomicMin(reinterpret_cast<unsigned long long*>(&candidateCell->clusterRepresentative), cellTag);
                 if (cellTag < origTag) {
                     currentCell = candidateCell;
                     found = true;
@@ -72,7 +79,7 @@ __device__ __inline__ void ClusterProcessor::findClusterBoundaries(SimulationDat
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto cell = cells.at(index);
-        auto cluster = cells.at(cell->clusterIndex);
+        auto cluster = cell->clusterRepresentative;
         if (cell->absPos.x < data.worldSize.x / 3) {
             atomicOr(&cluster->clusterBoundaries, 1);
         }
@@ -89,7 +96,7 @@ __device__ __inline__ void ClusterProcessor::accumulateClusterPosAndVel(Simulati
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto cell = cells.at(index);
-        auto cluster = cells.at(cell->clusterIndex);
+        auto cluster = cell->clusterRepresentative;
         atomicAdd(&cluster->clusterVel.x, cell->vel.x);
         atomicAdd(&cluster->clusterVel.y, cell->vel.y);
 
@@ -116,7 +123,7 @@ __device__ __inline__ void ClusterProcessor::accumulateClusterAngularProp(Simula
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto cell = cells.at(index);
-        auto cluster = cells.at(cell->clusterIndex);
+        auto cluster = cell->clusterRepresentative;
         auto clusterVel = cluster->clusterVel / cluster->numCellsInCluster;
         auto clusterPos = cluster->clusterPos / cluster->numCellsInCluster;
 
@@ -144,7 +151,7 @@ __device__ __inline__ void ClusterProcessor::applyClusterData(SimulationData& da
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto cell = cells.at(index);
-        auto cluster = cells.at(cell->clusterIndex);
+        auto cluster = cell->clusterRepresentative;
         auto clusterPos = cluster->clusterPos / cluster->numCellsInCluster;
         auto clusterVel = cluster->clusterVel / cluster->numCellsInCluster;
 
@@ -1,13 +1,32 @@
 #pragma once
 
+#include "EngineInterface/Enums.h"
+
 #include "SimulationData.cuh"
+#include "Math.cuh"
 #include "QuantityConverter.cuh"
+#include "Token.cuh"
+#include "Cell.cuh"
 
 class CommunicationProcessor
 {
 public:
     __inline__ __device__ static void process(Token* token, SimulationData& data);
 
+private:
+    //layout of the communicator state in the cell's mutable data
+    enum MutableDataIndex
+    {
+        Communicator_Channel = 0,
+        Communicator_NewMessageFlag,
+        Communicator_MessageData,
+        Communicator_MessageAngle,
+        Communicator_MessageDistance,
+        Communicator_StateSize
+    };
+
+    __inline__ __device__ static void sendMessage(Token* token, SimulationData& data);
+    __inline__ __device__ static void receiveMessage(Token* token);
 };
 
 /************************************************************************/
@@ -16,5 +35,84 @@ public:
 
 __inline__ __device__ void CommunicationProcessor::process(Token* token, SimulationData& data)
 {
-    //#TODO
-} 
\ No newline at end of file
+    auto const command = calcMod(token->memory[Enums::Communicator_Input], Enums::CommunicatorIn_Count);
+    auto cell = token->cell;
+
+    //cells from old saved files may carry no communicator state
+    if (cell->numMutableBytes < Communicator_StateSize) {
+        return;
+    }
+    if (command == Enums::CommunicatorIn_SetListeningChannel) {
+        cell->mutableData[Communicator_Channel] = token->memory[Enums::Communicator_InChannel];
+        cell->mutableData[Communicator_NewMessageFlag] = Enums::CommunicatorOutReceivedNewMessage_No;
+    }
+    if (command == Enums::CommunicatorIn_SendMessage) {
+        sendMessage(token, data);
+    }
+    if (command == Enums::CommunicatorIn_ReceiveMessage) {
+        receiveMessage(token);
+    }
+}
+
+__inline__ __device__ void CommunicationProcessor::sendMessage(Token* token, SimulationData& data)
+{
+    auto cell = token->cell;
+    auto const channel = token->memory[Enums::Communicator_InChannel];
+    auto const message = token->memory[Enums::Communicator_InMessage];
+    auto const range = cudaSimulationParameters.cellFunctionCommunicatorRange;
+
+    //the communicator map narrows the delivery to the receivers of the surrounding sectors;
+    //without it each send would have to scan every map position within the range
+    auto const& communicatorMap = data.cellFunctionData.communicatorMap;
+    auto const sectorRadius = toInt(range) / CommunicatorMap::SectorSize + 1;
+    auto const center = communicatorMap.getSectorCoordinates(cell->absPos);
+
+    auto numReceivers = 0;
+    for (int sectorDx = -sectorRadius; sectorDx <= sectorRadius; ++sectorDx) {
+        for (int sectorDy = -sectorRadius; sectorDy <= sectorRadius; ++sectorDy) {
+            auto const numCells = communicatorMap.getNumCells(center.x + sectorDx, center.y + sectorDy);
+            for (int slot = 0; slot < numCells; ++slot) {
+                auto receiver = communicatorMap.getCell(center.x + sectorDx, center.y + sectorDy, slot);
+                if (receiver == cell) {
+                    continue;
+                }
+                auto posDelta = receiver->absPos - cell->absPos;
+                data.cellMap.correctDirection(posDelta);
+                if (Math::length(posDelta) > range) {
+                    continue;
+                }
+
+                //the sender already holds its own cell lock => a single non-blocking attempt on
+                //the receiver avoids deadlocks; a contended receiver misses the message
+                if (receiver->tryLock()) {
+                    if (receiver->numMutableBytes >= Communicator_StateSize
+                        && receiver->mutableData[Communicator_Channel] == channel) {
+                        receiver->mutableData[Communicator_NewMessageFlag] = Enums::CommunicatorOutReceivedNewMessage_Yes;
+                        receiver->mutableData[Communicator_MessageData] = message;
+                        receiver->mutableData[Communicator_MessageAngle] =
+                            QuantityConverter::convertAngleToData(Math::angleOfVector(float2{-posDelta.x, -posDelta.y}));
+                        receiver->mutableData[Communicator_MessageDistance] =
+                            QuantityConverter::convertDistanceToData(Math::length(posDelta));
+                        ++numReceivers;
+                    }
+                    receiver->releaseLock();
+                }
+            }
+        }
+    }
+    token->memory[Enums::Communicator_OutSentNumMessage] = static_cast<unsigned char>(min(numReceivers, 255));
+}
+
+__inline__ __device__ void CommunicationProcessor::receiveMessage(Token* token)
+{
+    auto cell = token->cell;
+    if (cell->mutableData[Communicator_NewMessageFlag] == Enums::CommunicatorOutReceivedNewMessage_Yes) {
+        token->memory[Enums::Communicator_OutReceivedNewMessage] = Enums::CommunicatorOutReceivedNewMessage_Yes;
+        token->memory[Enums::Communicator_OutReceivedMessage] = cell->mutableData[Communicator_MessageData];
+        token->memory[Enums::Communicator_OutReceivedAngle] = cell->mutableData[Communicator_MessageAngle];
+        token->memory[Enums::Communicator_OutReceivedDistance] = cell->mutableData[Communicator_MessageDistance];
+        cell->mutableData[Communicator_NewMessageFlag] = Enums::CommunicatorOutReceivedNewMessage_No;
+    } else {
+        token->memory[Enums::Communicator_OutReceivedNewMessage] = Enums::CommunicatorOutReceivedNewMessage_No;
+    }
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+#include "EngineInterface/Enums.h"
+
+#include "Base.cuh"
+#include "Cell.cuh"
+#include "CudaMemoryManager.cuh"
+
+//spatial mailbox index for the communicator cells: a sender looks up the candidate receivers in
+//the sectors surrounding its position instead of scanning every map position within its range
+class CommunicatorMap
+{
+public:
+    static int constexpr SectorSize = 16;
+    static int constexpr MaxCellsPerSector = 16;  //surplus communicators of an overcrowded sector are not indexed
+
+    __host__ __inline__ void init(int2 const& worldSize)
+    {
+        _sectorMapSize = {worldSize.x / SectorSize, worldSize.y / SectorSize};
+        auto numSectors = _sectorMapSize.x * _sectorMapSize.y;
+        CudaMemoryManager::getInstance().acquireMemory<int>(numSectors, _numCellsBySector);
+        CudaMemoryManager::getInstance().acquireMemory<Cell*>(numSectors * MaxCellsPerSector, _cellsBySector);
+    }
+
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_numCellsBySector);
+        CudaMemoryManager::getInstance().freeMemory(_cellsBySector);
+    }
+
+    __device__ __inline__ void clear()
+    {
+        auto const partition = calcAllThreadsPartition(_sectorMapSize.x * _sectorMapSize.y);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            _numCellsBySector[index] = 0;
+        }
+    }
+
+    __device__ __inline__ void addCell(Cell* cell)
+    {
+        if (cell->getCellFunctionType() != Enums::CellFunction_Communication) {
+            return;
+        }
+        auto sectorX = toInt(cell->absPos.x) / SectorSize;
+        auto sectorY = toInt(cell->absPos.y) / SectorSize;
+        if (sectorX < 0 || sectorX >= _sectorMapSize.x || sectorY < 0 || sectorY >= _sectorMapSize.y) {
+            return;
+        }
+        auto sectorIndex = sectorX + sectorY * _sectorMapSize.x;
+        auto slot = atomicAdd(&_numCellsBySector[sectorIndex], 1);
+        if (slot < MaxCellsPerSector) {
+            _cellsBySector[sectorIndex * MaxCellsPerSector + slot] = cell;
+        }
+    }
+
+    __device__ __inline__ int2 getSectorMapSize() const { return _sectorMapSize; }
+
+    __device__ __inline__ int2 getSectorCoordinates(float2 const& pos) const
+    {
+        return {toInt(pos.x) / SectorSize, toInt(pos.y) / SectorSize};
+    }
+
+    //sector coordinates are wrapped at the world border
+    __device__ __inline__ int getNumCells(int sectorX, int sectorY) const
+    {
+        return min(_numCellsBySector[calcWrappedSectorIndex(sectorX, sectorY)], MaxCellsPerSector);
+    }
+
+    __device__ __inline__ Cell* getCell(int sectorX, int sectorY, int slot) const
+    {
+        return _cellsBySector[calcWrappedSectorIndex(sectorX, sectorY) * MaxCellsPerSector + slot];
+    }
+
+private:
+    __device__ __inline__ int calcWrappedSectorIndex(int sectorX, int sectorY) const
+    {
+        sectorX = ((sectorX % _sectorMapSize.x) + _sectorMapSize.x) % _sectorMapSize.x;
+        sectorY = ((sectorY % _sectorMapSize.y) + _sectorMapSize.y) % _sectorMapSize.y;
+        return sectorX + sectorY * _sectorMapSize.x;
+    }
+
+    int2 _sectorMapSize;
+    int* _numCellsBySector;
+    Cell** _cellsBySector;
+};
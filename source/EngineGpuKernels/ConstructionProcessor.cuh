@@ -10,6 +10,7 @@
 class ConstructionProcessor
 {
 public:
+    template<bool instrumented>
     __inline__ __device__ static void process(Token* token, SimulationData& data, SimulationResult& result);
 
 private:
@@ -32,11 +33,13 @@ private:
     __inline__ __device__ static void readConstructionData(Token* token, ConstructionData& data);
 
     __inline__ __device__ static Cell* getFirstCellOfConstructionSite(Token* token);
+    template<bool instrumented>
     __inline__ __device__ static void startNewConstruction(
         Token* token,
         SimulationData& data,
         SimulationResult& result,
         ConstructionData& constructionData);
+    template<bool instrumented>
     __inline__ __device__ static void continueConstruction(
         Token* token,
         SimulationData& data,
@@ -95,6 +98,7 @@ private:
 /************************************************************************/
 /* Implementation                                                       */
 /************************************************************************/
+template<bool instrumented>
 __inline__ __device__ void ConstructionProcessor::process(Token* token, SimulationData& data, SimulationResult& result)
 {
     //    mutateToken(token, data);
@@ -107,6 +111,14 @@ __inline__ __device__ void ConstructionProcessor::process(Token* token, Simulati
         return;
     }
 
+    //backpressure: the entity arrays are consuming their overflow reserve, so construction is
+    //suspended for a few steps until the resize has happened; the lock error is the transient
+    //failure code, the constructor simply tries again on a later activation
+    if (data.isConstructionThrottled()) {
+        token->memory[Enums::Constr_Output] = Enums::ConstrOut_ErrorLock;
+        return;
+    }
+
     Cell* firstCellOfConstructionSite = getFirstCellOfConstructionSite(token);
 
     if (firstCellOfConstructionSite) {
@@ -115,10 +127,10 @@ __inline__ __device__ void ConstructionProcessor::process(Token* token, Simulati
             return;
         }
 
-        continueConstruction(token, data, result, constructionData, firstCellOfConstructionSite);
+        continueConstruction<instrumented>(token, data, result, constructionData, firstCellOfConstructionSite);
         firstCellOfConstructionSite->releaseLock();
     } else {
-        startNewConstruction(token, data, result, constructionData);
+        startNewConstruction<instrumented>(token, data, result, constructionData);
     }
 }
 
@@ -172,6 +184,7 @@ __inline__ __device__ Cell* ConstructionProcessor::getFirstCellOfConstructionSit
     return result;
 }
 
+template<bool instrumented>
 __inline__ __device__ void ConstructionProcessor::startNewConstruction(
     Token* token,
     SimulationData& data,
@@ -233,9 +246,12 @@ __inline__ __device__ void ConstructionProcessor::startNewConstruction(
 
     token->memory[Enums::Constr_Output] = Enums::ConstrOut_Success;
     token->memory[Enums::Constr_InOutAngle] = 0;
-    result.incCreatedCell();
+    if constexpr (instrumented) {
+        result.incCreatedCell();
+    }
 }
 
+template<bool instrumented>
 __inline__ __device__ void ConstructionProcessor::continueConstruction(
     Token* token,
     SimulationData& data,
@@ -299,7 +315,7 @@ __inline__ __device__ void ConstructionProcessor::continueConstruction(
             break;
         }
     }
-    CellConnectionProcessor::delConnections(cell, firstConstructedCell);
+    CellConnectionProcessor::delConnections(data, cell, firstConstructedCell);
     if (!constructionData.isFinishConstruction || !constructionData.isSeparateConstruction) {
         CellConnectionProcessor::addConnections(
             data,
@@ -380,7 +396,9 @@ __inline__ __device__ void ConstructionProcessor::continueConstruction(
     newCell->releaseLock();
 
     token->memory[Enums::Constr_Output] = Enums::ConstrOut_Success;
-    result.incCreatedCell();
+    if constexpr (instrumented) {
+        result.incCreatedCell();
+    }
 }
 
 __inline__ __device__ void ConstructionProcessor::constructCell(
@@ -412,12 +430,21 @@ __inline__ __device__ void ConstructionProcessor::constructCell(
         % (MAX_CELL_MUTABLE_BYTES + 1);
     result->metadata.color = constructionData.metaData;
 
-    for (int i = 0; i < result->numStaticBytes; ++i) {
-        result->staticData[i] = token->memory[(Enums::Constr_InCellFunctionData + i + 1) % MAX_TOKEN_MEM_SIZE];
-    }
-    for (int i = 0; i <= result->numMutableBytes; ++i) {
-        result->mutableData[i] =
-            token->memory[(Enums::Constr_InCellFunctionData + offset + i + 1) % MAX_TOKEN_MEM_SIZE];
+    //the zeroed tail makes identically constructed cells hash to the same genome block
+    char staticData[MAX_CELL_STATIC_BYTES] = {0};
+    QuantityConverter::copyTokenMemoryBytes(
+        staticData, token->memory, Enums::Constr_InCellFunctionData + 1, result->numStaticBytes);
+    result->staticData = data.entities.genomes.getOrInsert(staticData);
+    QuantityConverter::copyTokenMemoryBytes(
+        result->mutableData, token->memory, Enums::Constr_InCellFunctionData + offset + 1, result->numMutableBytes + 1);
+
+    //logged here rather than in createCell: position and color are only set above
+    data.logCellEvent(CellEvent::Type_CellBirth, result->id, result->absPos, result->metadata.color);
+
+    //the constructing cell passes its lineage on to the new cell
+    result->ancestorId = token->cell->ancestorId;
+    if (data.lineageTrackingActive) {
+        data.logLineageRecord(result->id, token->cell->id, token->cell->ancestorId);
     }
 }
 
@@ -578,11 +605,19 @@ __inline__ __device__ void ConstructorFunction::mutateCellFunctionData(Simulatio
         cell->numStaticBytes = data.numberGen.random(MAX_CELL_STATIC_BYTES);
     }
 
-    for (int i = 0; i <= MAX_CELL_STATIC_BYTES; ++i) {
+    //mutations are applied to a private copy which is then reinserted (copy-on-write)
+    auto staticDataMutated = false;
+    char staticData[MAX_CELL_STATIC_BYTES];
+    QuantityConverter::copyBytes(staticData, cell->staticData, MAX_CELL_STATIC_BYTES);
+    for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
         if (data.numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellDataMutationProb) {
-            cell->staticData[i] = data.numberGen.random(255);
+            staticData[i] = data.numberGen.random(255);
+            staticDataMutated = true;
         }
     }
+    if (staticDataMutated) {
+        cell->staticData = data.entities.genomes.getOrInsert(staticData);
+    }
 
     if (data.numberGen.random() < cudaSimulationParameters.cellFunctionConstructorCellDataMutationProb) {
         cell->numMutableBytes = data.numberGen.random(MAX_CELL_MUTABLE_BYTES);
@@ -1,12 +1,37 @@
 #pragma once
 
+#include <algorithm>
+#include <functional>
 #include <map>
+#include <mutex>
+#include <vector>
 
+#include <cuda.h>
 #include <cuda/helper_cuda.h>
 
 #include "Base.cuh"
 #include "Macros.cuh"
 
+namespace Const
+{
+    //limits for the size-class block pool below; generous enough to absorb a resize cycle of the
+    //large entity arrays, small enough not to hoard memory on cards running near capacity
+    constexpr uint64_t MaxPooledBytes = 1024ull * 1024 * 1024;
+    constexpr uint64_t MaxPooledBlocksPerSizeClass = 4;
+
+    //blocks at least this large are backed by a virtual-memory reservation so that they can grow
+    //in place later; below it the mapping granularity (typically 2MB) would waste more than it saves
+    constexpr uint64_t GrowableMemoryThreshold = 2ull * 1024 * 1024;
+
+    //virtual address space reserved per growable block; address space is plentiful (49 bits), so
+    //the reservation is generous - only the mapped chunks occupy physical memory
+    constexpr uint64_t GrowableReserveFactor = 256;
+    constexpr uint64_t MinGrowableReserveBytes = 1024ull * 1024 * 1024;
+
+    //eviction priorities for registerEvictionHandler; lower values are reclaimed first
+    constexpr int EvictionPriorityRenderingBuffers = 0;
+}
+
 class CudaMemoryManager
 {
 public:
@@ -21,15 +46,82 @@ public:
 
     void reset()
     {
+        std::lock_guard guard(_mutex);
+        purgeFreeBlocksIntern();
+        _pointerToSizeMap.clear();
+        _growableBlocks.clear();
         _bytes = 0;
+        _peakBytes = 0;
     }
 
+    //allocations are rounded up to size classes and freed blocks of a class are pooled for reuse:
+    //the resize cycles of the entity arrays then recycle the same few large blocks instead of
+    //fragmenting the device heap with ever-new cudaMalloc/cudaFree pairs
     template<typename T>
     void acquireMemory(uint64_t arraySize, T*& result)
     {
-        CHECK_FOR_CUDA_ERROR(cudaMalloc(&result, sizeof(T)*arraySize));
-        _bytes += sizeof(T)*arraySize;
-        _pointerToSizeMap.emplace(reinterpret_cast<void*>(result), arraySize);
+        auto numBytes = calcSizeClass(sizeof(T) * arraySize);
+
+        {
+            std::lock_guard guard(_mutex);
+            auto freeBlocksIter = _freeBlocksBySizeClass.find(numBytes);
+            if (freeBlocksIter != _freeBlocksBySizeClass.end() && !freeBlocksIter->second.empty()) {
+                auto data = freeBlocksIter->second.back();
+                freeBlocksIter->second.pop_back();
+                _pooledBytes -= numBytes;
+                _bytes += numBytes;
+                _peakBytes = std::max(_peakBytes, _bytes + _pooledBytes);
+                _pointerToSizeMap.emplace(data, numBytes);
+                result = reinterpret_cast<T*>(data);
+                return;
+            }
+        }
+
+        void* data = nullptr;
+        if (cudaSuccess != cudaMalloc(&data, numBytes)) {
+            cudaGetLastError();  //clear the error state
+
+            //recovery ladder: the pooled blocks are free space from the allocator's point of view
+            //but occupied from the driver's; if purging them is not enough, the registered
+            //low-priority consumers are evicted (the emergency pool remains the last resort of the
+            //resize path in CudaSimulationFacade)
+            purgeFreeBlocks();
+            if (cudaSuccess != cudaMalloc(&data, numBytes)) {
+                cudaGetLastError();  //clear the error state
+                runEvictionHandlers();
+                purgeFreeBlocks();  //evicted blocks may have landed in the pool
+                CHECK_FOR_CUDA_ERROR(cudaMalloc(&data, numBytes));
+            }
+        }
+        result = reinterpret_cast<T*>(data);
+
+        std::lock_guard guard(_mutex);
+        _bytes += numBytes;
+        _peakBytes = std::max(_peakBytes, _bytes + _pooledBytes);
+        _pointerToSizeMap.emplace(data, numBytes);
+    }
+
+    //allocates a block backed by a virtual-memory reservation when the driver supports it and the
+    //request is large enough: the block can then grow in place via tryGrowMemory without its device
+    //address changing; otherwise this degrades to a plain pooled allocation
+    template<typename T>
+    void acquireGrowableMemory(uint64_t arraySize, T*& result)
+    {
+        auto data = acquireGrowableMemoryIntern(sizeof(T) * arraySize);
+        if (data) {
+            result = reinterpret_cast<T*>(data);
+            return;
+        }
+        acquireMemory(arraySize, result);
+    }
+
+    //extends a block obtained from acquireGrowableMemory by mapping additional physical chunks
+    //behind the reserved address range; the existing content and all pointers into the block stay
+    //valid; returns false for plain blocks or when the reservation or device memory is exhausted
+    template<typename T>
+    bool tryGrowMemory(T* memory, uint64_t newArraySize)
+    {
+        return tryGrowMemoryIntern(reinterpret_cast<void*>(memory), sizeof(T) * newArraySize);
     }
 
     template<typename T>
@@ -38,23 +130,293 @@ public:
         if (!memory) {
             return;
         }
+        std::lock_guard guard(_mutex);
+        auto growableIter = _growableBlocks.find(reinterpret_cast<void*>(memory));
+        if (growableIter != _growableBlocks.end()) {
+            freeGrowableBlockIntern(growableIter->second);
+            _growableBlocks.erase(growableIter);
+            return;
+        }
         auto findResult = _pointerToSizeMap.find(reinterpret_cast<void*>(memory));
         if (findResult != _pointerToSizeMap.end()) {
-            cudaFree(memory);
-            _bytes -= sizeof(T) * findResult->second;
-            _pointerToSizeMap.erase(findResult->first);
+            auto numBytes = findResult->second;
+            _bytes -= numBytes;
+            _pointerToSizeMap.erase(findResult);
+
+            auto& freeBlocks = _freeBlocksBySizeClass[numBytes];
+            if (_pooledBytes + numBytes <= Const::MaxPooledBytes && freeBlocks.size() < Const::MaxPooledBlocksPerSizeClass) {
+                freeBlocks.emplace_back(reinterpret_cast<void*>(memory));
+                _pooledBytes += numBytes;
+            } else {
+                cudaFree(memory);
+            }
         }
     }
 
+    //returns all pooled blocks to the driver; used as a defragmentation step when an allocation
+    //fails and by the out-of-memory recovery before the emergency pool is touched
+    bool purgeFreeBlocks()
+    {
+        std::lock_guard guard(_mutex);
+        return purgeFreeBlocksIntern();
+    }
+
+    //owners of reclaimable device memory register a handler together with a priority; under
+    //memory pressure the handlers run in ascending priority order, so low-priority pools (e.g.
+    //the rendering buffers) shrink before simulation growth fails. all allocations happen inside
+    //facade operations that hold the device slice mutex, so a handler may free buffers of any
+    //simulation instance without further locking; returns a handle for unregistration
+    int registerEvictionHandler(int priority, std::function<bool()> const& handler)
+    {
+        std::lock_guard guard(_evictionMutex);
+        auto handleId = _nextEvictionHandleId++;
+        _evictionHandlers.emplace(std::make_pair(priority, handleId), handler);
+        return handleId;
+    }
+
+    void unregisterEvictionHandler(int handleId)
+    {
+        std::lock_guard guard(_evictionMutex);
+        for (auto it = _evictionHandlers.begin(); it != _evictionHandlers.end(); ++it) {
+            if (it->first.second == handleId) {
+                _evictionHandlers.erase(it);
+                return;
+            }
+        }
+    }
+
+    //reserved at engine start and only freed when an allocation fails: releasing it creates the
+    //headroom needed to finish a resize or to snapshot the world during recovery
+    void reserveEmergencyPool(uint64_t bytes)
+    {
+        if (!_emergencyPool) {
+            if (cudaSuccess != cudaMalloc(&_emergencyPool, bytes)) {
+                cudaGetLastError();  //clear the error state
+                _emergencyPool = nullptr;
+            }
+        }
+    }
+
+    bool releaseEmergencyPool()
+    {
+        if (!_emergencyPool) {
+            return false;
+        }
+        cudaFree(_emergencyPool);
+        _emergencyPool = nullptr;
+        return true;
+    }
+
     uint64_t getSizeOfAcquiredMemory() const
     {
         return _bytes;
     }
 
+    uint64_t getPeakSizeOfAcquiredMemory() const
+    {
+        return _peakBytes;
+    }
+
+    uint64_t getSizeOfPooledMemory() const
+    {
+        return _pooledBytes;
+    }
+
 private:
     CudaMemoryManager() {}
     ~CudaMemoryManager() {}
 
+    //rounds up to eighth steps between two powers of two (jemalloc-style size classes); keeps the
+    //per-block waste below 12.5% while mapping the slightly varying resize requests of the entity
+    //arrays onto a handful of reusable classes
+    static uint64_t calcSizeClass(uint64_t numBytes)
+    {
+        uint64_t constexpr MinBlockSize = 256;
+        if (numBytes <= MinBlockSize) {
+            return MinBlockSize;
+        }
+        uint64_t base = MinBlockSize;
+        while (base * 2 < numBytes) {
+            base *= 2;
+        }
+        auto step = base / 8;
+        return ((numBytes + step - 1) / step) * step;
+    }
+
+    struct GrowableBlock
+    {
+        CUdeviceptr va = 0;
+        uint64_t reservedBytes = 0;
+        uint64_t mappedBytes = 0;
+        std::vector<CUmemGenericAllocationHandle> chunkHandles;
+    };
+
+    //lazily probed on the first growable request; requires a current context, which exists by then
+    //because the runtime API has already been used during engine initialization
+    bool checkVmmSupportIntern()
+    {
+        if (-1 == _vmmSupport) {
+            _vmmSupport = 0;
+            CUdevice device;
+            int supported = 0;
+            if (CUDA_SUCCESS == cuCtxGetDevice(&device)
+                && CUDA_SUCCESS == cuDeviceGetAttribute(&supported, CU_DEVICE_ATTRIBUTE_VIRTUAL_MEMORY_MANAGEMENT_SUPPORTED, device)
+                && supported) {
+                auto prop = createAllocationPropIntern(static_cast<int>(device));
+                size_t granularity = 0;
+                if (CUDA_SUCCESS == cuMemGetAllocationGranularity(&granularity, &prop, CU_MEM_ALLOC_GRANULARITY_MINIMUM)) {
+                    _vmmDeviceId = static_cast<int>(device);
+                    _allocationGranularity = granularity;
+                    _vmmSupport = 1;
+                }
+            }
+        }
+        return 1 == _vmmSupport;
+    }
+
+    static CUmemAllocationProp createAllocationPropIntern(int deviceId)
+    {
+        CUmemAllocationProp prop{};
+        prop.type = CU_MEM_ALLOCATION_TYPE_PINNED;
+        prop.location.type = CU_MEM_LOCATION_TYPE_DEVICE;
+        prop.location.id = deviceId;
+        return prop;
+    }
+
+    uint64_t roundUpToGranularityIntern(uint64_t numBytes) const
+    {
+        return ((numBytes + _allocationGranularity - 1) / _allocationGranularity) * _allocationGranularity;
+    }
+
+    //maps one physical chunk to the end of the mapped region of the block
+    bool mapChunkIntern(GrowableBlock& block, uint64_t chunkBytes)
+    {
+        auto prop = createAllocationPropIntern(_vmmDeviceId);
+        CUmemGenericAllocationHandle handle;
+        if (CUDA_SUCCESS != cuMemCreate(&handle, chunkBytes, &prop, 0)) {
+            return false;
+        }
+        if (CUDA_SUCCESS != cuMemMap(block.va + block.mappedBytes, chunkBytes, 0, handle, 0)) {
+            cuMemRelease(handle);
+            return false;
+        }
+        CUmemAccessDesc accessDesc{};
+        accessDesc.location = prop.location;
+        accessDesc.flags = CU_MEM_ACCESS_FLAGS_PROT_READWRITE;
+        if (CUDA_SUCCESS != cuMemSetAccess(block.va + block.mappedBytes, chunkBytes, &accessDesc, 1)) {
+            cuMemUnmap(block.va + block.mappedBytes, chunkBytes);
+            cuMemRelease(handle);
+            return false;
+        }
+        block.chunkHandles.emplace_back(handle);
+        block.mappedBytes += chunkBytes;
+        return true;
+    }
+
+    void* acquireGrowableMemoryIntern(uint64_t numBytes)
+    {
+        if (numBytes < Const::GrowableMemoryThreshold) {
+            return nullptr;
+        }
+        std::lock_guard guard(_mutex);
+        if (!checkVmmSupportIntern()) {
+            return nullptr;
+        }
+        GrowableBlock block;
+        auto mappedBytes = roundUpToGranularityIntern(numBytes);
+        block.reservedBytes = roundUpToGranularityIntern(std::max(numBytes * Const::GrowableReserveFactor, Const::MinGrowableReserveBytes));
+        if (CUDA_SUCCESS != cuMemAddressReserve(&block.va, block.reservedBytes, 0, 0, 0)) {
+            return nullptr;
+        }
+        if (!mapChunkIntern(block, mappedBytes)) {
+            cuMemAddressFree(block.va, block.reservedBytes);
+            return nullptr;
+        }
+        _bytes += block.mappedBytes;
+        _peakBytes = std::max(_peakBytes, _bytes + _pooledBytes);
+        auto result = reinterpret_cast<void*>(block.va);
+        _growableBlocks.emplace(result, block);
+        return result;
+    }
+
+    bool tryGrowMemoryIntern(void* memory, uint64_t newNumBytes)
+    {
+        std::lock_guard guard(_mutex);
+        auto findResult = _growableBlocks.find(memory);
+        if (findResult == _growableBlocks.end()) {
+            return false;
+        }
+        auto& block = findResult->second;
+        auto targetBytes = roundUpToGranularityIntern(newNumBytes);
+        if (targetBytes <= block.mappedBytes) {
+            return true;
+        }
+        if (targetBytes > block.reservedBytes) {
+            return false;
+        }
+        auto chunkBytes = targetBytes - block.mappedBytes;
+        if (!mapChunkIntern(block, chunkBytes)) {
+            return false;
+        }
+        _bytes += chunkBytes;
+        _peakBytes = std::max(_peakBytes, _bytes + _pooledBytes);
+        return true;
+    }
+
+    void freeGrowableBlockIntern(GrowableBlock& block)
+    {
+        cuMemUnmap(block.va, block.mappedBytes);
+        for (auto const& handle : block.chunkHandles) {
+            cuMemRelease(handle);
+        }
+        cuMemAddressFree(block.va, block.reservedBytes);
+        _bytes -= block.mappedBytes;
+    }
+
+    //must not be called while _mutex is held: the handlers free memory through this manager
+    bool runEvictionHandlers()
+    {
+        std::vector<std::function<bool()>> handlers;
+        {
+            std::lock_guard guard(_evictionMutex);
+            for (auto const& [priorityAndHandle, handler] : _evictionHandlers) {
+                handlers.emplace_back(handler);
+            }
+        }
+        auto evictedSomething = false;
+        for (auto const& handler : handlers) {
+            evictedSomething |= handler();
+        }
+        return evictedSomething;
+    }
+
+    bool purgeFreeBlocksIntern()
+    {
+        auto purgedSomething = false;
+        for (auto& [sizeClass, freeBlocks] : _freeBlocksBySizeClass) {
+            for (auto const& block : freeBlocks) {
+                cudaFree(block);
+                purgedSomething = true;
+            }
+            freeBlocks.clear();
+        }
+        _freeBlocksBySizeClass.clear();
+        _pooledBytes = 0;
+        return purgedSomething;
+    }
+
+    std::mutex _mutex;  //facade instances on different worker threads share this singleton
     uint64_t _bytes = 0;
-    std::map<void*, uint64_t> _pointerToSizeMap;
-};
\ No newline at end of file
+    uint64_t _peakBytes = 0;
+    uint64_t _pooledBytes = 0;
+    void* _emergencyPool = nullptr;
+    std::map<void*, uint64_t> _pointerToSizeMap;  //in-use blocks, by size class in bytes
+    std::map<uint64_t, std::vector<void*>> _freeBlocksBySizeClass;
+    std::map<void*, GrowableBlock> _growableBlocks;
+    std::mutex _evictionMutex;  //separate from _mutex: handlers free memory and would self-deadlock otherwise
+    std::map<std::pair<int, int>, std::function<bool()>> _evictionHandlers;  //keyed by (priority, handle)
+    int _nextEvictionHandleId = 0;
+    int _vmmSupport = -1;  //-1: not yet probed
+    int _vmmDeviceId = 0;
+    uint64_t _allocationGranularity = 0;
+};
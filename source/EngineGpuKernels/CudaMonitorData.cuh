@@ -16,15 +16,20 @@ public:
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numTokens);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _numParticles);
         CudaMemoryManager::getInstance().acquireMemory<double>(1, _internalEnergy);
+        CudaMemoryManager::getInstance().acquireMemory<RegionValues>(MonitorRegions::MaxRegions, _regionValues);
 
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numCellsByColor, 0, sizeof(NumCellsByColor)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numConnections, 0, sizeof(int)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numTokens, 0, sizeof(int)));
         CHECK_FOR_CUDA_ERROR(cudaMemset(_numParticles, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_regionValues, 0, sizeof(RegionValues) * MonitorRegions::MaxRegions));
 
         double zero = 0.0;
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_internalEnergy, &zero, sizeof(double), cudaMemcpyHostToDevice));
 
+        //pinned staging buffer so that snapshots can be copied to the host asynchronously
+        CHECK_FOR_CUDA_ERROR(cudaHostAlloc(&_stagingData, sizeof(MonitorData), cudaHostAllocDefault));
+        *_stagingData = MonitorData();
     }
 
     __host__ void free()
@@ -34,9 +39,22 @@ public:
         CudaMemoryManager::getInstance().freeMemory(_numTokens);
         CudaMemoryManager::getInstance().freeMemory(_numParticles);
         CudaMemoryManager::getInstance().freeMemory(_internalEnergy);
+        CudaMemoryManager::getInstance().freeMemory(_regionValues);
+        CHECK_FOR_CUDA_ERROR(cudaFreeHost(_stagingData));
     }
 
     using NumCellsByColor = int[7];
+
+    //per-region counters for the statistics regions (see MonitorRegions); energy is accumulated
+    //in single precision since the device does not support double atomics natively
+    struct RegionValues
+    {
+        NumCellsByColor numCellsByColor;
+        int numTokens = 0;
+        int numParticles = 0;
+        float totalEnergy = 0;
+    };
+
     struct MonitorData
     {
         uint64_t timeStep = 0;
@@ -45,6 +63,7 @@ public:
         int numParticles = 0;
         int numTokens = 0;
         double totalInternalEnergy = 0.0;
+        RegionValues regionValues[MonitorRegions::MaxRegions];
     };
     __host__ MonitorData getMonitorData(uint64_t timeStep)
     {
@@ -54,6 +73,27 @@ public:
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numParticles, _numParticles, sizeof(int), cudaMemcpyDeviceToHost));
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.numTokens, _numTokens, sizeof(int), cudaMemcpyDeviceToHost));
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.totalInternalEnergy, _internalEnergy, sizeof(double), cudaMemcpyDeviceToHost));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result.regionValues, _regionValues, sizeof(RegionValues) * MonitorRegions::MaxRegions, cudaMemcpyDeviceToHost));
+        result.timeStep = timeStep;
+        return result;
+    }
+
+    //asynchronous variant: the values are copied into the pinned staging buffer in stream order
+    __host__ void copyToHostAsync(cudaStream_t stream)
+    {
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(&_stagingData->numCellsByColor, _numCellsByColor, sizeof(NumCellsByColor), cudaMemcpyDeviceToHost, stream));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(&_stagingData->numConnections, _numConnections, sizeof(int), cudaMemcpyDeviceToHost, stream));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(&_stagingData->numParticles, _numParticles, sizeof(int), cudaMemcpyDeviceToHost, stream));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(&_stagingData->numTokens, _numTokens, sizeof(int), cudaMemcpyDeviceToHost, stream));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(&_stagingData->totalInternalEnergy, _internalEnergy, sizeof(double), cudaMemcpyDeviceToHost, stream));
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpyAsync(&_stagingData->regionValues, _regionValues, sizeof(RegionValues) * MonitorRegions::MaxRegions, cudaMemcpyDeviceToHost, stream));
+    }
+
+    //only valid after the copy issued by copyToHostAsync has finished
+    __host__ MonitorData getStagedData(uint64_t timeStep)
+    {
+        auto result = *_stagingData;
         result.timeStep = timeStep;
         return result;
     }
@@ -67,14 +107,28 @@ public:
         *_numTokens = 0;
         *_numParticles = 0;
         *_internalEnergy = 0.0f;
+        for (int i = 0; i < MonitorRegions::MaxRegions; ++i) {
+            auto& regionValues = _regionValues[i];
+            for (int j = 0; j < 7; ++j) {
+                regionValues.numCellsByColor[j] = 0;
+            }
+            regionValues.numTokens = 0;
+            regionValues.numParticles = 0;
+            regionValues.totalEnergy = 0;
+        }
     }
 
-    __inline__ __device__ void incNumCell(int color) { atomicAdd(&(*_numCellsByColor)[color], 1); }
+    __inline__ __device__ void incNumCells(int color, int count) { atomicAdd(&(*_numCellsByColor)[color], count); }
     __inline__ __device__ void incNumConnections(int numConnections) { atomicAdd(_numConnections, numConnections); }
     __inline__ __device__ void setNumParticles(int value) { *_numParticles = value; }
     __inline__ __device__ void setNumTokens(int value) { *_numTokens = value; }
     __inline__ __device__ void halveNumConnections() { *_numConnections /= 2; }
 
+    __inline__ __device__ void incRegionCells(int regionIndex, int color, int count) { atomicAdd(&_regionValues[regionIndex].numCellsByColor[color], count); }
+    __inline__ __device__ void incRegionTokens(int regionIndex, int count) { atomicAdd(&_regionValues[regionIndex].numTokens, count); }
+    __inline__ __device__ void incRegionParticles(int regionIndex, int count) { atomicAdd(&_regionValues[regionIndex].numParticles, count); }
+    __inline__ __device__ void incRegionEnergy(int regionIndex, float energy) { atomicAdd(&_regionValues[regionIndex].totalEnergy, energy); }
+
 
 /*
     __inline__ __device__ void incInternalEnergy(float changeValue)
@@ -89,5 +143,7 @@ private:
     int* _numTokens;
     int* _numParticles;
     double* _internalEnergy;
+    RegionValues* _regionValues;
+    MonitorData* _stagingData;
 };
 
@@ -1,5 +1,6 @@
 #include "CudaSimulationFacade.cuh"
 
+#include <algorithm>
 #include <functional>
 #include <iostream>
 #include <list>
@@ -40,6 +41,12 @@
 
 namespace
 {
+    namespace Const
+    {
+        uint64_t const DeterministicRandomSeed = 40312357;
+        uint64_t const EmergencyPoolSize = 64 * 1024 * 1024;  //see CudaMemoryManager::reserveEmergencyPool
+    }
+
     class CudaInitializer
     {
     public:
@@ -57,6 +64,8 @@ namespace
             std::stringstream stream;
             stream << "device " << deviceNumber << " is set";
             log(Priority::Important, stream.str());
+
+            enablePeerAccess(deviceNumber);
         }
 
         ~CudaInitializer() { cudaDeviceReset(); }
@@ -103,6 +112,29 @@ namespace
 
             return result;
         }
+
+        //groundwork for a future multi-GPU domain decomposition: peer access to the other devices
+        //is enabled where the hardware supports it, so boundary strips could be exchanged with
+        //direct peer-to-peer copies instead of staging through host memory
+        void enablePeerAccess(int deviceNumber)
+        {
+            int numberOfDevices;
+            CHECK_FOR_CUDA_ERROR(cudaGetDeviceCount(&numberOfDevices));
+            for (int peerDeviceNumber = 0; peerDeviceNumber < numberOfDevices; ++peerDeviceNumber) {
+                if (peerDeviceNumber == deviceNumber) {
+                    continue;
+                }
+                int canAccessPeer = 0;
+                CHECK_FOR_CUDA_ERROR(cudaDeviceCanAccessPeer(&canAccessPeer, deviceNumber, peerDeviceNumber));
+                if (canAccessPeer) {
+                    cudaDeviceEnablePeerAccess(peerDeviceNumber, 0);
+
+                    std::stringstream stream;
+                    stream << "peer access from device " << deviceNumber << " to device " << peerDeviceNumber << " is enabled";
+                    log(Priority::Important, stream.str());
+                }
+            }
+        }
     };
 }
 
@@ -111,6 +143,35 @@ void _CudaSimulationFacade::initCuda()
     CudaInitializer::init();
 }
 
+std::recursive_mutex _CudaSimulationFacade::s_deviceSliceMutex;
+_CudaSimulationFacade* _CudaSimulationFacade::s_constantMemoryOwner = nullptr;
+
+std::unique_lock<std::recursive_mutex> _CudaSimulationFacade::claimDeviceSlice()
+{
+    std::unique_lock<std::recursive_mutex> lock(s_deviceSliceMutex);
+    if (s_constantMemoryOwner != this) {
+
+        //another simulation instance ran in between: re-upload this instance's constant state
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpyToSymbol(cudaThreadSettings, &_settings.gpuSettings, sizeof(GpuSettings), 0, cudaMemcpyHostToDevice));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(
+            cudaSimulationParameters, &_settings.simulationParameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(
+            cudaSimulationParametersSpots, &_settings.simulationParametersSpots, sizeof(SimulationParametersSpots), 0, cudaMemcpyHostToDevice));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(
+            cudaFlowFieldSettings, &_settings.flowFieldSettings, sizeof(FlowFieldSettings), 0, cudaMemcpyHostToDevice));
+        s_constantMemoryOwner = this;
+    }
+
+    //parameter changes scheduled since the last device access are uploaded here, stream-ordered
+    //and coalesced (see setSimulationParameters); every facade entry point claims the slice, so
+    //the next batch, render or data access always runs with the latest parameters
+    if (_simulationKernels && _cudaSimulationData) {
+        _simulationKernels->flushPendingConstantUpdates(_settings.gpuSettings, *_cudaSimulationData);
+    }
+    return lock;
+}
+
 _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const& settings)
 {
     CHECK_FOR_CUDA_ERROR(cudaGetLastError());
@@ -123,6 +184,11 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     log(Priority::Important, "initialize simulation");
 
     _currentTimestep.store(timestep);
+    CHECK_FOR_CUDA_ERROR(cudaStreamCreate(&_renderStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamCreate(&_transferStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamCreate(&_monitorStream));
+    CHECK_FOR_CUDA_ERROR(cudaEventCreateWithFlags(&_monitorEvent, cudaEventDisableTiming));
+    CHECK_FOR_CUDA_ERROR(cudaEventCreateWithFlags(&_renderEvent, cudaEventDisableTiming));
     _cudaSimulationData = std::make_shared<SimulationData>();
     _cudaRenderingData = std::make_shared<RenderingData>();
     _cudaSimulationResult = std::make_shared<SimulationResult>();
@@ -130,7 +196,9 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     _cudaAccessTO = std::make_shared<DataAccessTO>();
     _cudaMonitorData = std::make_shared<CudaMonitorData>();
 
-    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY});
+    //a fixed seed in deterministic mode makes the random number streams identical for every run
+    auto randomSeed = settings.gpuSettings.deterministicMode ? Const::DeterministicRandomSeed : 0;
+    _cudaSimulationData->init({settings.generalSettings.worldSizeX, settings.generalSettings.worldSizeY}, randomSeed);
     _cudaRenderingData->init();
     _cudaMonitorData->init();
     _cudaSimulationResult->init();
@@ -143,6 +211,11 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
     _editKernels = std::make_shared<_EditKernelsLauncher>();
     _monitorKernels = std::make_shared<_MonitorKernelsLauncher>();
 
+    //the spot parameters were uploaded before the simulation data existed => compute the initial weight field now
+    _simulationKernels->updateSpotWeightField(settings.gpuSettings, *_cudaSimulationData);
+
+    syncTimestepToDevice();
+
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numCells);
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numParticles);
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaAccessTO->numTokens);
@@ -150,12 +223,39 @@ _CudaSimulationFacade::_CudaSimulationFacade(uint64_t timestep, Settings const&
 
     //default array sizes for empty simulation (will be resized later if not sufficient)
     resizeArrays({100000, 100000, 10000});
+
+    CudaMemoryManager::getInstance().reserveEmergencyPool(Const::EmergencyPoolSize);
 }
 
 _CudaSimulationFacade::~_CudaSimulationFacade()
 {
+    {
+        std::lock_guard guard(s_deviceSliceMutex);
+        if (s_constantMemoryOwner == this) {
+            s_constantMemoryOwner = nullptr;
+        }
+    }
+
+    cudaStreamSynchronize(_renderStream);
+    cudaStreamDestroy(_renderStream);
+    cudaStreamSynchronize(_transferStream);
+    cudaStreamDestroy(_transferStream);
+    cudaStreamSynchronize(_monitorStream);
+    cudaStreamDestroy(_monitorStream);
+    if (_exportStream) {
+        cudaStreamSynchronize(_exportStream);
+        cudaStreamDestroy(_exportStream);
+    }
+    cudaEventDestroy(_monitorEvent);
+    cudaEventDestroy(_renderEvent);
     _cudaSimulationData->free();
     _cudaRenderingData->free();
+    if (_cudaExportRenderingData) {
+        _cudaExportRenderingData->free();
+    }
+    if (_cudaThumbnailImage) {
+        CudaMemoryManager::getInstance().freeMemory(_cudaThumbnailImage);
+    }
     _cudaMonitorData->free();
     _cudaSimulationResult->free();
     _cudaSelectionResult->free();
@@ -184,11 +284,55 @@ void* _CudaSimulationFacade::registerImageResource(GLuint image)
 
 void _CudaSimulationFacade::calcTimestep()
 {
-    _simulationKernels->calcTimestep(_settings, *_cudaSimulationData, *_cudaSimulationResult);
+    calcTimesteps(1);
+}
+
+void _CudaSimulationFacade::calcTimesteps(int numTimesteps)
+{
+    auto deviceSlice = claimDeviceSlice();
+    if (_kernelProfilingEnabled) {
+        for (int i = 0; i < numTimesteps; ++i) {
+            accumulateKernelProfileData(_simulationKernels->benchmarkTimestep(_settings, *_cudaSimulationData, *_cudaSimulationResult));
+        }
+    } else {
+        _simulationKernels->calcTimesteps(_settings, *_cudaSimulationData, *_cudaSimulationResult, numTimesteps);
+    }
+    syncAndCheck();
+
+    automaticResizeArrays();
+    reportInvariantViolationsIfAny();
+    _currentTimestep += numTimesteps;
+}
+
+std::vector<KernelTiming> _CudaSimulationFacade::benchmarkTimestep()
+{
+    auto deviceSlice = claimDeviceSlice();
+    auto timings = _simulationKernels->benchmarkTimestep(_settings, *_cudaSimulationData, *_cudaSimulationResult);
     syncAndCheck();
 
     automaticResizeArrays();
     ++_currentTimestep;
+    return timings;
+}
+
+void _CudaSimulationFacade::setKernelProfilingEnabled(bool enabled)
+{
+    if (enabled && !_kernelProfilingEnabled) {
+        std::lock_guard lock(_mutexForKernelProfileData);
+        _kernelProfileData = KernelProfileData();
+    }
+    _kernelProfilingEnabled = enabled;
+}
+
+bool _CudaSimulationFacade::isKernelProfilingEnabled() const
+{
+    return _kernelProfilingEnabled;
+}
+
+KernelProfileData _CudaSimulationFacade::getKernelProfileData() const
+{
+    std::lock_guard lock(_mutexForKernelProfileData);
+    return _kernelProfileData;
 }
 
 void _CudaSimulationFacade::drawVectorGraphics(
@@ -198,29 +342,173 @@ void _CudaSimulationFacade::drawVectorGraphics(
     int2 const& imageSize,
     double zoom)
 {
+    auto deviceSlice = claimDeviceSlice();
+
+    //the buffers are about to be used: an allocation below must not evict them (it may still evict
+    //the rendering buffers of other facade instances, which cannot be mid-frame while the device
+    //slice is held here)
+    _cudaRenderingData->evictionLocked = true;
+
     auto cudaResourceImpl = reinterpret_cast<cudaGraphicsResource*>(cudaResource);
-    CHECK_FOR_CUDA_ERROR(cudaGraphicsMapResources(1, &cudaResourceImpl));
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsMapResources(1, &cudaResourceImpl, _renderStream));
 
     cudaArray* mappedArray;
     CHECK_FOR_CUDA_ERROR(cudaGraphicsSubResourceGetMappedArray(&mappedArray, cudaResourceImpl, 0, 0));
 
-    _cudaRenderingData->resizeImageIfNecessary(imageSize);
+    //three stages: the back buffer is drawn into, the front buffer holds the latest completed
+    //frame and the GL texture presents; a finished draw is taken over via event query, so no one
+    //ever waits for the rendering kernels
+    takeOverCompletedFrame();
+
+    auto resizeNeeded = imageSize.x * imageSize.y > _cudaRenderingData->numPixels;
+    auto tileResizeNeeded = zoom < Const::ZoomLevelForTileRendering
+        && _cudaRenderingData->tileDataNeedsResize(imageSize, _cudaSimulationData->entities.cellPointers.getSize_host());
+    if (resizeNeeded || tileResizeNeeded) {
+        //the buffers may only be replaced when no draw is in flight
+        if (_renderingInFlight) {
+            CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_renderStream));
+            takeOverCompletedFrame();
+        }
+        _cudaRenderingData->resizeImageIfNecessary(imageSize);
+        if (tileResizeNeeded) {
+            _cudaRenderingData->resizeTileDataIfNecessary(imageSize, _cudaSimulationData->entities.cellPointers.getSize_host());
+        }
+    }
 
-    _renderingKernels->drawImage(_settings.gpuSettings, rectUpperLeft, rectLowerRight, imageSize, static_cast<float>(zoom), *_cudaSimulationData, *_cudaRenderingData);
-    syncAndCheck();
+    if (!_cudaRenderingData->frontValid) {
+        //no completed frame available yet (first frame or resize): draw synchronously
+        _renderingKernels->drawImage(
+            _settings.gpuSettings, rectUpperLeft, rectLowerRight, imageSize, static_cast<float>(zoom), *_cudaSimulationData, *_cudaRenderingData, _renderStream);
+        CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_renderStream));
+        _cudaRenderingData->swapBuffers();
+        _frontImageSize = imageSize;
+    }
+
+    //present the last completed frame
+    if (_frontImageSize.x == imageSize.x && _frontImageSize.y == imageSize.y) {
+        const size_t widthBytes = sizeof(uint64_t) * imageSize.x;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy2DToArrayAsync(
+            mappedArray,
+            0,
+            0,
+            _cudaRenderingData->imageData,
+            widthBytes,
+            widthBytes,
+            imageSize.y,
+            cudaMemcpyDeviceToDevice,
+            _renderStream));
+        CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_renderStream));
+    }
 
-    const size_t widthBytes = sizeof(uint64_t) * imageSize.x;
-    CHECK_FOR_CUDA_ERROR(cudaMemcpy2DToArray(
-        mappedArray,
-        0,
-        0,
-        _cudaRenderingData->imageData,
-        widthBytes,
-        widthBytes,
-        imageSize.y,
-        cudaMemcpyDeviceToDevice));
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsUnmapResources(1, &cudaResourceImpl, _renderStream));
 
-    CHECK_FOR_CUDA_ERROR(cudaGraphicsUnmapResources(1, &cudaResourceImpl));
+    //draw the next frame asynchronously on the rendering stream, so the GUI does not stall the
+    //timestep loop
+    if (!_renderingInFlight) {
+        _renderingKernels->drawImage(
+            _settings.gpuSettings, rectUpperLeft, rectLowerRight, imageSize, static_cast<float>(zoom), *_cudaSimulationData, *_cudaRenderingData, _renderStream);
+        CHECK_FOR_CUDA_ERROR(cudaEventRecord(_renderEvent, _renderStream));
+        _backImageSize = imageSize;
+        _renderingInFlight = true;
+    }
+
+    //a draw that is still in flight outlasts this call: the buffers then stay protected until the
+    //frame is taken over
+    _cudaRenderingData->evictionLocked = _renderingInFlight;
+}
+
+void _CudaSimulationFacade::presentLastFrame(void* cudaResource, int2 const& imageSize)
+{
+    auto cudaResourceImpl = reinterpret_cast<cudaGraphicsResource*>(cudaResource);
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsMapResources(1, &cudaResourceImpl, _renderStream));
+
+    cudaArray* mappedArray;
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsSubResourceGetMappedArray(&mappedArray, cudaResourceImpl, 0, 0));
+
+    //a draw that finished in the meantime is still taken over; no new draw is launched here
+    takeOverCompletedFrame();
+
+    if (_cudaRenderingData->frontValid && _frontImageSize.x == imageSize.x && _frontImageSize.y == imageSize.y) {
+        const size_t widthBytes = sizeof(uint64_t) * imageSize.x;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy2DToArrayAsync(
+            mappedArray,
+            0,
+            0,
+            _cudaRenderingData->imageData,
+            widthBytes,
+            widthBytes,
+            imageSize.y,
+            cudaMemcpyDeviceToDevice,
+            _renderStream));
+        CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_renderStream));
+    }
+
+    CHECK_FOR_CUDA_ERROR(cudaGraphicsUnmapResources(1, &cudaResourceImpl, _renderStream));
+}
+
+void _CudaSimulationFacade::drawImageToHost(
+    float2 const& rectUpperLeft,
+    float2 const& rectLowerRight,
+    int2 const& imageSize,
+    double zoom,
+    uint64_t* hostImageData)
+{
+    auto deviceSlice = claimDeviceSlice();
+    //the offscreen buffer and its stream are created on the first export; a simulation that never
+    //exports images pays nothing
+    if (!_exportStream) {
+        CHECK_FOR_CUDA_ERROR(cudaStreamCreate(&_exportStream));
+    }
+    if (!_cudaExportRenderingData) {
+        _cudaExportRenderingData = std::make_shared<RenderingData>();
+        _cudaExportRenderingData->init();
+    }
+    _cudaExportRenderingData->evictionLocked = true;
+    _cudaExportRenderingData->resizeImageIfNecessary(imageSize);
+    if (zoom < Const::ZoomLevelForTileRendering) {
+        _cudaExportRenderingData->resizeTileDataIfNecessary(imageSize, _cudaSimulationData->entities.cellPointers.getSize_host());
+    }
+
+    _renderingKernels->drawImage(
+        _settings.gpuSettings, rectUpperLeft, rectLowerRight, imageSize, static_cast<float>(zoom), *_cudaSimulationData, *_cudaExportRenderingData, _exportStream);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(
+        hostImageData,
+        _cudaExportRenderingData->imageDataBack,
+        sizeof(uint64_t) * imageSize.x * imageSize.y,
+        cudaMemcpyDeviceToHost,
+        _exportStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_exportStream));
+    _cudaExportRenderingData->evictionLocked = false;
+}
+
+void _CudaSimulationFacade::drawThumbnailToHost(int2 const& imageSize, uint64_t* hostImageData)
+{
+    auto deviceSlice = claimDeviceSlice();
+    if (!_exportStream) {
+        CHECK_FOR_CUDA_ERROR(cudaStreamCreate(&_exportStream));
+    }
+    if (_thumbnailSize.x != imageSize.x || _thumbnailSize.y != imageSize.y) {
+        if (_cudaThumbnailImage) {
+            CudaMemoryManager::getInstance().freeMemory(_cudaThumbnailImage);
+        }
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(imageSize.x * imageSize.y, _cudaThumbnailImage);
+        _thumbnailSize = imageSize;
+    }
+
+    _renderingKernels->drawThumbnail(_settings.gpuSettings, *_cudaSimulationData, _cudaThumbnailImage, imageSize, _exportStream);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(
+        hostImageData, _cudaThumbnailImage, sizeof(uint64_t) * imageSize.x * imageSize.y, cudaMemcpyDeviceToHost, _exportStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_exportStream));
+}
+
+void _CudaSimulationFacade::takeOverCompletedFrame()
+{
+    if (_renderingInFlight && cudaSuccess == cudaEventQuery(_renderEvent)) {
+        _cudaRenderingData->swapBuffers();
+        _frontImageSize = _backImageSize;
+        _renderingInFlight = false;
+        _cudaRenderingData->evictionLocked = false;
+    }
 }
 
 void _CudaSimulationFacade::getSimulationData(
@@ -228,22 +516,40 @@ void _CudaSimulationFacade::getSimulationData(
     int2 const& rectLowerRight,
     DataAccessTO const& dataTO)
 {
-    _dataAccessKernels->getData(_settings.gpuSettings, *_cudaSimulationData, rectUpperLeft, rectLowerRight, *_cudaAccessTO);
+    auto deviceSlice = claimDeviceSlice();
+
+    //the schema flags travel with the kernel launch argument; the device buffers stay shared
+    auto accessTO = *_cudaAccessTO;
+    accessTO.includeMetadata = dataTO.includeMetadata;
+    accessTO.includeTokenMemories = dataTO.includeTokenMemories;
+    _dataAccessKernels->getData(_settings.gpuSettings, *_cudaSimulationData, rectUpperLeft, rectLowerRight, accessTO);
     syncAndCheck();
 
     copyDataTOtoHost(dataTO);
 }
 
-void _CudaSimulationFacade::getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO)
+auto _CudaSimulationFacade::extractSelectedSimulationData(bool includeClusters) -> ArraySizes
 {
+    auto deviceSlice = claimDeviceSlice();
     _dataAccessKernels->getSelectedData(_settings.gpuSettings, *_cudaSimulationData, includeClusters, *_cudaAccessTO);
     syncAndCheck();
 
+    ArraySizes result;
+    copyToHost(&result.cellArraySize, _cudaAccessTO->numCells);
+    copyToHost(&result.particleArraySize, _cudaAccessTO->numParticles);
+    copyToHost(&result.tokenArraySize, _cudaAccessTO->numTokens);
+    return result;
+}
+
+void _CudaSimulationFacade::retrieveExtractedSimulationData(DataAccessTO const& dataTO)
+{
+    auto deviceSlice = claimDeviceSlice();
     copyDataTOtoHost(dataTO);
 }
 
 void _CudaSimulationFacade::getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO)
 {
+    auto deviceSlice = claimDeviceSlice();
     InspectedEntityIds ids;
     if (entityIds.size() > Const::MaxInspectedEntities) {
         return;
@@ -259,9 +565,11 @@ void _CudaSimulationFacade::getInspectedSimulationData(std::vector<uint64_t> ent
     copyDataTOtoHost(dataTO);
 }
 
-void _CudaSimulationFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO)
+void _CudaSimulationFacade::getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, double zoom, DataAccessTO const& dataTO)
 {
-    _dataAccessKernels->getOverlayData(_settings.gpuSettings, *_cudaSimulationData, rectUpperLeft, rectLowerRight, *_cudaAccessTO);
+    auto deviceSlice = claimDeviceSlice();
+    _dataAccessKernels->getOverlayData(
+        _settings.gpuSettings, *_cudaSimulationData, rectUpperLeft, rectLowerRight, static_cast<float>(zoom), *_cudaAccessTO);
     syncAndCheck();
 
     copyToHost(dataTO.numCells, _cudaAccessTO->numCells);
@@ -272,6 +580,7 @@ void _CudaSimulationFacade::getOverlayData(int2 const& rectUpperLeft, int2 const
 
 void _CudaSimulationFacade::addAndSelectSimulationData(DataAccessTO const& dataTO)
 {
+    auto deviceSlice = claimDeviceSlice();
     copyDataTOtoDevice(dataTO);
     _editKernels->removeSelection(_settings.gpuSettings, *_cudaSimulationData);
     _dataAccessKernels->addData(_settings.gpuSettings, *_cudaSimulationData, *_cudaAccessTO, true, true);
@@ -280,50 +589,59 @@ void _CudaSimulationFacade::addAndSelectSimulationData(DataAccessTO const& dataT
 
 void _CudaSimulationFacade::setSimulationData(DataAccessTO const& dataTO)
 {
+    auto deviceSlice = claimDeviceSlice();
     copyDataTOtoDevice(dataTO);
     _dataAccessKernels->clearData(_settings.gpuSettings, *_cudaSimulationData);
     _dataAccessKernels->addData(_settings.gpuSettings, *_cudaSimulationData, *_cudaAccessTO, false, false);
+    _dataAccessKernels->warmStartAfterLoad(_settings.gpuSettings, *_cudaSimulationData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::removeSelectedEntities(bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->removeSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, includeClusters);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::relaxSelectedEntities(bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->relaxSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, includeClusters);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::uniformVelocitiesForSelectedEntities(bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->uniformVelocitiesForSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, includeClusters);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::makeSticky(bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->makeSticky(_settings.gpuSettings, *_cudaSimulationData, includeClusters);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::removeStickiness(bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->removeStickiness(_settings.gpuSettings, *_cudaSimulationData, includeClusters);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::setBarrier(bool value, bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->setBarrier(_settings.gpuSettings, *_cudaSimulationData, value, includeClusters);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::changeInspectedSimulationData(DataAccessTO const& changeDataTO)
 {
+    auto deviceSlice = claimDeviceSlice();
     copyDataTOtoDevice(changeDataTO);
     _editKernels->changeSimulationData(_settings.gpuSettings, *_cudaSimulationData, *_cudaAccessTO);
     syncAndCheck();
@@ -331,29 +649,34 @@ void _CudaSimulationFacade::changeInspectedSimulationData(DataAccessTO const& ch
 
 void _CudaSimulationFacade::applyForce(ApplyForceData const& applyData)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->applyForce(_settings.gpuSettings, *_cudaSimulationData, applyData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::switchSelection(PointSelectionData const& pointData)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->switchSelection(_settings.gpuSettings, *_cudaSimulationData, pointData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::swapSelection(PointSelectionData const& pointData)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->swapSelection(_settings.gpuSettings, *_cudaSimulationData, pointData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::setSelection(AreaSelectionData const& selectionData)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->setSelection(_settings.gpuSettings, *_cudaSimulationData, selectionData);
 }
 
  SelectionShallowData _CudaSimulationFacade::getSelectionShallowData()
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->getSelectionShallowData(_settings.gpuSettings, *_cudaSimulationData, *_cudaSelectionResult);
     syncAndCheck();
     return _cudaSelectionResult->getSelectionShallowData();
@@ -361,40 +684,184 @@ void _CudaSimulationFacade::setSelection(AreaSelectionData const& selectionData)
 
 void _CudaSimulationFacade::shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& shallowUpdateData)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->shallowUpdateSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, shallowUpdateData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::removeSelection()
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->removeSelection(_settings.gpuSettings, *_cudaSimulationData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::updateSelection()
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->updateSelection(_settings.gpuSettings, *_cudaSimulationData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::colorSelectedEntities(unsigned char color, bool includeClusters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->colorSelectedCells(_settings.gpuSettings, *_cudaSimulationData, color, includeClusters);
     syncAndCheck();
 }
 
+void _CudaSimulationFacade::scaleEnergyForSelectedEntities(float factor, bool includeClusters)
+{
+    auto deviceSlice = claimDeviceSlice();
+    _editKernels->scaleEnergyForSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, factor, includeClusters);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters)
+{
+    auto deviceSlice = claimDeviceSlice();
+    _editKernels->setBranchNumberForSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, branchNumber, includeClusters);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta)
+{
+    auto deviceSlice = claimDeviceSlice();
+    _editKernels->applyEnergyDeltaToCells(_settings.gpuSettings, *_cudaSimulationData, cellIds, energyDelta);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::colorizeClusters(std::vector<int> const& colorCodes, unsigned int seed)
+{
+    auto deviceSlice = claimDeviceSlice();
+
+    ColorizeClustersData colorizeData;
+    colorizeData.numColorCodes = std::min(toInt(colorCodes.size()), 7);
+    for (int i = 0; i < colorizeData.numColorCodes; ++i) {
+        colorizeData.colorCodes[i] = static_cast<unsigned char>(colorCodes[i]);
+    }
+    colorizeData.seed = seed;
+    _editKernels->colorizeClusters(_settings.gpuSettings, *_cudaSimulationData, colorizeData);
+    syncAndCheck();
+}
+
 void _CudaSimulationFacade::reconnectSelectedEntities()
 {
+    auto deviceSlice = claimDeviceSlice();
     _editKernels->reconnectSelectedEntities(_settings.gpuSettings, *_cudaSimulationData);
     syncAndCheck();
 }
 
+void _CudaSimulationFacade::cloneSelectedEntities(float2 const& posDelta, bool includeClusters)
+{
+    auto deviceSlice = claimDeviceSlice();
+    auto const requirements = _editKernels->measureCloneRequirements(_settings.gpuSettings, *_cudaSimulationData, includeClusters);
+    resizeArraysIfNecessary(requirements);
+
+    _editKernels->cloneSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, posDelta, includeClusters);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, float2 const& center)
+{
+    auto deviceSlice = claimDeviceSlice();
+    auto const requirements = _editKernels->measureCloneRequirements(_settings.gpuSettings, *_cudaSimulationData, true);
+    auto numCopies = static_cast<int>(transforms.size());
+    resizeArraysIfNecessary(
+        {requirements.cellArraySize * numCopies, requirements.particleArraySize * numCopies, requirements.tokenArraySize * numCopies});
+
+    _editKernels->replicateSelectedEntities(_settings.gpuSettings, *_cudaSimulationData, transforms, center);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::drawBarrier(std::vector<float2> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode)
+{
+    auto deviceSlice = claimDeviceSlice();
+    //upper bound of the painted cells for the resize check
+    auto numNewCells = paintFirstVertex ? 1 : 0;
+    for (int i = 0; i + 1 < static_cast<int>(stroke.size()); ++i) {
+        auto dx = stroke[i + 1].x - stroke[i].x;
+        auto dy = stroke[i + 1].y - stroke[i].y;
+        numNewCells += static_cast<int>(sqrtf(dx * dx + dy * dy) / cellDistance) + 1;
+    }
+    resizeArraysIfNecessary({numNewCells, 0, 0});
+
+    _editKernels->drawBarrier(_settings.gpuSettings, *_cudaSimulationData, stroke, paintFirstVertex, cellDistance, energy, colorCode);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, float2 const& center)
+{
+    auto deviceSlice = claimDeviceSlice();
+
+    //upper bound of the instantiated cells for the resize check: the kernel skips pixels below
+    //the brightness threshold
+    auto numNewCells = 0;
+    for (int i = 0; i < width * height; ++i) {
+        auto address = i * numChannels;
+        if (imageData[address] > 20 || imageData[address + 1] > 20 || imageData[address + 2] > 20) {
+            ++numNewCells;
+        }
+    }
+    resizeArraysIfNecessary({numNewCells, 0, 0});
+
+    _editKernels->removeSelection(_settings.gpuSettings, *_cudaSimulationData);
+    _editKernels->convertImageToPattern(_settings.gpuSettings, *_cudaSimulationData, imageData, width, height, numChannels, center);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::generateWorld(WorldGenerationSpec const& spec)
+{
+    auto deviceSlice = claimDeviceSlice();
+
+    auto const worldSizeX = _settings.generalSettings.worldSizeX;
+    auto const worldSizeY = _settings.generalSettings.worldSizeY;
+    auto const area = toFloat(worldSizeX) * toFloat(worldSizeY);
+    auto const numCells = toInt(area * spec.cellDensity);
+    auto const numParticles = toInt(area * spec.particleDensity);
+    auto const numBorderCells = spec.borderBarrier ? 2 * (worldSizeX + worldSizeY) : 0;
+    resizeArraysIfNecessary({numCells + numBorderCells, numParticles, 0});
+
+    _editKernels->generateWorld(_settings.gpuSettings, *_cudaSimulationData, spec, numCells, numParticles, numBorderCells);
+    syncAndCheck();
+}
+
+void _CudaSimulationFacade::setFreezeZone(bool active, float2 const& topLeft, float2 const& bottomRight)
+{
+    auto deviceSlice = claimDeviceSlice();
+    _cudaSimulationData->freezeZoneActive = active;
+    _cudaSimulationData->freezeZoneTopLeft = topLeft;
+    _cudaSimulationData->freezeZoneBottomRight = bottomRight;
+
+    if (_simulationKernels) {
+        _simulationKernels->invalidateTimestepGraphs();  //the zone is baked into the captured graphs
+    }
+}
+
 void _CudaSimulationFacade::setGpuConstants(GpuSettings const& gpuConstants)
 {
+    auto deviceSlice = claimDeviceSlice();
     _settings.gpuSettings = gpuConstants;
 
-    CHECK_FOR_CUDA_ERROR(
-        cudaMemcpyToSymbol(cudaThreadSettings, &gpuConstants, sizeof(GpuSettings), 0, cudaMemcpyHostToDevice));
+    if (_simulationKernels) {
+
+        //stream-ordered constant update plus eager rebuild of the hot graph variant: tuning the
+        //launch geometry under live load neither synchronizes the whole device nor drops a batch
+        //to graph capture
+        _simulationKernels->updateGpuConstants(gpuConstants);
+    } else {
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpyToSymbol(cudaThreadSettings, &gpuConstants, sizeof(GpuSettings), 0, cudaMemcpyHostToDevice));
+    }
+}
+
+void _CudaSimulationFacade::setTurboMode(bool value)
+{
+    auto deviceSlice = claimDeviceSlice();
+    if (_simulationKernels) {
+        //no graph invalidation needed: the turbo variants occupy their own graph index range
+        _simulationKernels->setTurboMode(value);
+    }
 }
 
 auto _CudaSimulationFacade::getArraySizes() const -> ArraySizes
@@ -407,11 +874,51 @@ auto _CudaSimulationFacade::getArraySizes() const -> ArraySizes
 
 MonitorData _CudaSimulationFacade::getMonitorData()
 {
-    _monitorKernels->getMonitorData(_settings.gpuSettings, *_cudaSimulationData, *_cudaMonitorData);
-    syncAndCheck();
-    
+    auto deviceSlice = claimDeviceSlice();
+    //monitoring runs on its own stream: a finished snapshot is consumed here and the next
+    //collection is kicked off without blocking the caller
+    if (_monitorCollectionPending && cudaSuccess == cudaEventQuery(_monitorEvent)) {
+        _lastMonitorData = assembleMonitorData();
+        _monitorCollectionPending = false;
+    }
+    if (!_monitorCollectionPending) {
+        auto regions = assembleMonitorRegions();
+        _numRegionsInCollection = regions.numRegions;
+        _monitorKernels->getMonitorData(_settings.gpuSettings, *_cudaSimulationData, *_cudaMonitorData, regions, _monitorStream);
+        _cudaMonitorData->copyToHostAsync(_monitorStream);
+        CHECK_FOR_CUDA_ERROR(cudaEventRecord(_monitorEvent, _monitorStream));
+        _monitorCollectionPending = true;
+    }
+
+    //only the very first call waits so that a valid snapshot is always returned
+    if (!_lastMonitorData) {
+        CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_monitorStream));
+        _lastMonitorData = assembleMonitorData();
+        _monitorCollectionPending = false;
+    }
+    return *_lastMonitorData;
+}
+
+MonitorData _CudaSimulationFacade::getQuickMonitorData()
+{
+    auto deviceSlice = claimDeviceSlice();
+
+    //entity counts from the host-side array mirrors: these are refreshed by the per-batch array
+    //compaction, so the values may lag behind the device by one batch. No color breakdown is
+    //available on the host => the total cell count is reported under the first color
+    MonitorData result;
+    result.timeStep = getCurrentTimestep();
+    auto const& entities = _cudaSimulationData->entities;
+    result.numCellsByColor[0] = entities.cellPointers.getNumEntries_host();
+    result.numParticles = entities.particlePointers.getNumEntries_host();
+    result.numTokens = entities.tokenPointers.getNumEntries_host();
+    return result;
+}
+
+MonitorData _CudaSimulationFacade::assembleMonitorData()
+{
     MonitorData result;
-    auto monitorData = _cudaMonitorData->getMonitorData(getCurrentTimestep());
+    auto monitorData = _cudaMonitorData->getStagedData(getCurrentTimestep());
     result.timeStep = monitorData.timeStep;
     for (int i = 0; i < 7; ++i) {
         result.numCellsByColor[i] = monitorData.numCellsByColor[i];
@@ -426,6 +933,222 @@ MonitorData _CudaSimulationFacade::getMonitorData()
     result.numSuccessfulAttacks = processStatistics.sucessfulAttacks;
     result.numFailedAttacks = processStatistics.failedAttacks;
     result.numMuscleActivities = processStatistics.muscleActivities;
+    result.numCreatedConnections = processStatistics.createdConnections;
+    result.numDestroyedConnections = processStatistics.destroyedConnections;
+    result.numDeletedCells = processStatistics.deletedCells;
+    result.numMovedTokens = processStatistics.movedTokens;
+
+    result.numRegions = _numRegionsInCollection;
+    for (int i = 0; i < result.numRegions; ++i) {
+        auto const& regionValues = monitorData.regionValues[i];
+        for (int j = 0; j < 7; ++j) {
+            result.regions[i].numCellsByColor[j] = regionValues.numCellsByColor[j];
+        }
+        result.regions[i].numTokens = regionValues.numTokens;
+        result.regions[i].numParticles = regionValues.numParticles;
+        result.regions[i].totalEnergy = regionValues.totalEnergy;
+    }
+    return result;
+}
+
+MonitorRegions _CudaSimulationFacade::assembleMonitorRegions() const
+{
+    //the parameter spots come first (their core area, without the fadeout zone), followed by the
+    //user-defined rects; surplus rects beyond MaxRegions are ignored
+    MonitorRegions result;
+    auto const& spots = _settings.simulationParametersSpots;
+    for (int i = 0; i < spots.numSpots && result.numRegions < MonitorRegions::MaxRegions; ++i) {
+        auto const& spot = spots.spots[i];
+        auto& region = result.regions[result.numRegions++];
+        region.circular = spot.shape == SpotShape::Circular;
+        region.posX = spot.posX;
+        region.posY = spot.posY;
+        region.radius = spot.coreRadius;
+        region.width = spot.width;
+        region.height = spot.height;
+    }
+    for (auto const& rect : _statisticsRects) {
+        if (result.numRegions >= MonitorRegions::MaxRegions) {
+            break;
+        }
+        auto& region = result.regions[result.numRegions++];
+        region.circular = false;
+        region.posX = (rect.topLeft.x + rect.bottomRight.x) / 2;
+        region.posY = (rect.topLeft.y + rect.bottomRight.y) / 2;
+        region.width = rect.bottomRight.x - rect.topLeft.x;
+        region.height = rect.bottomRight.y - rect.topLeft.y;
+    }
+    return result;
+}
+
+void _CudaSimulationFacade::setStatisticsRects(std::vector<RealRect> const& rects)
+{
+    //host-only state, but the slice lock serializes the change with a concurrent getMonitorData
+    auto deviceSlice = claimDeviceSlice();
+    _statisticsRects = rects;
+}
+
+template <typename Record>
+std::vector<Record>
+_CudaSimulationFacade::drainRecordRing(Record* deviceRecords, unsigned long long* deviceCursor, uint64_t bufferSize, uint64_t& drainedCursor)
+{
+    //the cursor tells how many records are new; the copies run on the monitor stream so that the
+    //drain shares the transfer ordering with the statistics collection
+    unsigned long long writeCursor = 0;
+    CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(&writeCursor, deviceCursor, sizeof(unsigned long long), cudaMemcpyDeviceToHost, _monitorStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_monitorStream));
+
+    auto readCursor = drainedCursor;
+    if (writeCursor - readCursor > bufferSize) {
+        //the ring wrapped since the last drain: resume at the oldest record that still exists
+        readCursor = writeCursor - bufferSize;
+    }
+    std::vector<Record> result(writeCursor - readCursor);
+    if (!result.empty()) {
+        auto startSlot = readCursor % bufferSize;
+        auto numUntilWrap = std::min(static_cast<uint64_t>(result.size()), bufferSize - startSlot);
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(
+            result.data(), deviceRecords + startSlot, sizeof(Record) * numUntilWrap, cudaMemcpyDeviceToHost, _monitorStream));
+        if (numUntilWrap < result.size()) {
+            CHECK_FOR_CUDA_ERROR(cudaMemcpyAsync(
+                result.data() + numUntilWrap,
+                deviceRecords,
+                sizeof(Record) * (result.size() - numUntilWrap),
+                cudaMemcpyDeviceToHost,
+                _monitorStream));
+        }
+        CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_monitorStream));
+    }
+    drainedCursor = writeCursor;
+    return result;
+}
+
+std::vector<CellEvent> _CudaSimulationFacade::retrieveCellEvents()
+{
+    auto deviceSlice = claimDeviceSlice();
+    return drainRecordRing(
+        _cudaSimulationData->cellEvents,
+        _cudaSimulationData->numCellEvents,
+        static_cast<uint64_t>(SimulationData::CellEventBufferSize),
+        _drainedCellEventCursor);
+}
+
+void _CudaSimulationFacade::setLineageTrackingEnabled(bool enabled)
+{
+    auto deviceSlice = claimDeviceSlice();
+    if (_cudaSimulationData->lineageTrackingActive == enabled) {
+        return;
+    }
+    _cudaSimulationData->lineageTrackingActive = enabled;
+
+    if (_simulationKernels) {
+        _simulationKernels->invalidateTimestepGraphs();  //the flag is baked into the captured graphs
+    }
+}
+
+std::vector<LineageRecord> _CudaSimulationFacade::retrieveLineageRecords()
+{
+    auto deviceSlice = claimDeviceSlice();
+    return drainRecordRing(
+        _cudaSimulationData->lineageRecords,
+        _cudaSimulationData->numLineageRecords,
+        static_cast<uint64_t>(SimulationData::LineageBufferSize),
+        _drainedLineageRecordCursor);
+}
+
+void _CudaSimulationFacade::syncTimestepToDevice()
+{
+    auto timestep = _currentTimestep.load();
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(_cudaSimulationData->timestep, &timestep, sizeof(uint64_t), cudaMemcpyHostToDevice));
+}
+
+uint64_t _CudaSimulationFacade::calcWorldHash()
+{
+    auto deviceSlice = claimDeviceSlice();
+    return _monitorKernels->calcWorldHash(_settings.gpuSettings, *_cudaSimulationData);
+}
+
+GpuMemoryInfo _CudaSimulationFacade::getMemoryInfo()
+{
+    GpuMemoryInfo result;
+    result.acquiredInBytes = CudaMemoryManager::getInstance().getSizeOfAcquiredMemory();
+    result.peakAcquiredInBytes = CudaMemoryManager::getInstance().getPeakSizeOfAcquiredMemory();
+
+    size_t freeBytes = 0;
+    size_t totalBytes = 0;
+    CHECK_FOR_CUDA_ERROR(cudaMemGetInfo(&freeBytes, &totalBytes));
+    result.freeDeviceMemoryInBytes = freeBytes;
+    result.totalDeviceMemoryInBytes = totalBytes;
+
+    //a resize allocates the enlarged cleanup copies (twice the current fill level, see
+    //SimulationData::resizeEntitiesForCleanup) while the old arrays are still alive
+    auto& entities = _cudaSimulationData->entities;
+    auto addArrayInfo = [&result](std::string const& name, uint64_t elementSize, int size, int numEntries) {
+        GpuArrayMemoryInfo info;
+        info.name = name;
+        info.sizeInBytes = elementSize * size;
+        info.usedInBytes = elementSize * numEntries;
+        result.nextResizeForecastInBytes += elementSize * numEntries * 2;
+        result.entityArrays.emplace_back(info);
+    };
+    addArrayInfo("cells", sizeof(Cell), entities.cells.getSize_host(), entities.cells.getNumEntries_host());
+    addArrayInfo("cell pointers", sizeof(Cell*), entities.cellPointers.getSize_host(), entities.cellPointers.getNumEntries_host());
+    addArrayInfo("tokens", sizeof(Token), entities.tokens.getSize_host(), entities.tokens.getNumEntries_host());
+    addArrayInfo("token memories", sizeof(TokenMemory), entities.tokenMemories.getSize_host(), entities.tokenMemories.getNumEntries_host());
+    addArrayInfo("token pointers", sizeof(Token*), entities.tokenPointers.getSize_host(), entities.tokenPointers.getNumEntries_host());
+    addArrayInfo("particles", sizeof(Particle), entities.particles.getSize_host(), entities.particles.getNumEntries_host());
+    addArrayInfo(
+        "particle pointers", sizeof(Particle*), entities.particlePointers.getSize_host(), entities.particlePointers.getNumEntries_host());
+
+    //string bytes are compacted in place and therefore not part of the resize forecast
+    GpuArrayMemoryInfo stringInfo;
+    stringInfo.name = "string bytes";
+    stringInfo.sizeInBytes = entities.stringBytes.getSize();
+    stringInfo.usedInBytes = entities.stringBytes.getBytesOccupied_host();
+    result.entityArrays.emplace_back(stringInfo);
+
+    //the deduplicated genome blocks live in their own fixed-size arena
+    GpuArrayMemoryInfo genomeInfo;
+    genomeInfo.name = "genome bytes";
+    genomeInfo.sizeInBytes = entities.genomes.getArenaSize();
+    genomeInfo.usedInBytes = entities.genomes.getArenaNumBytes_host();
+    result.entityArrays.emplace_back(genomeInfo);
+
+    //the per-timestep scratch arena and its consumers: usedInBytes is the high-water mark over all
+    //timesteps so far, i.e. the demand the sizing heuristic in resizeTransientStructures can be
+    //checked against instead of being overprovisioned blindly
+    auto& data = *_cudaSimulationData;
+    GpuArrayMemoryInfo processMemoryInfo;
+    processMemoryInfo.name = "process memory";
+    processMemoryInfo.sizeInBytes = data.processMemory.getSize();
+    processMemoryInfo.usedInBytes = data.processMemory.getMaxBytesOccupied_host();
+    result.entityArrays.emplace_back(processMemoryInfo);
+
+    auto addTempArrayInfo = [&result](std::string const& name, uint64_t elementSize, int size, int maxNumEntries) {
+        GpuArrayMemoryInfo info;
+        info.name = name;
+        info.sizeInBytes = elementSize * size;
+        info.usedInBytes = elementSize * maxNumEntries;
+        result.entityArrays.emplace_back(info);
+    };
+    addTempArrayInfo(
+        "process memory: structural ops",
+        sizeof(StructuralOperation),
+        data.structuralOperations.getSize_host(),
+        data.structuralOperations.getMaxNumEntries_host());
+    addTempArrayInfo(
+        "process memory: sensor ops", sizeof(SensorOperation), data.sensorOperations.getSize_host(), data.sensorOperations.getMaxNumEntries_host());
+    addTempArrayInfo(
+        "process memory: binned tokens",
+        sizeof(Token*),
+        data.binnedTokenPointers.getSize_host(),
+        data.binnedTokenPointers.getMaxNumEntries_host());
+    addTempArrayInfo(
+        "process memory: active cell indexes",
+        sizeof(int),
+        data.activeCellIndexes.getSize_host(),
+        data.activeCellIndexes.getMaxNumEntries_host());
+
     return result;
 }
 
@@ -436,24 +1159,45 @@ uint64_t _CudaSimulationFacade::getCurrentTimestep() const
 
 void _CudaSimulationFacade::setCurrentTimestep(uint64_t timestep)
 {
+    auto deviceSlice = claimDeviceSlice();
     _currentTimestep.store(timestep);
+    syncTimestepToDevice();
 }
 
 void _CudaSimulationFacade::setSimulationParameters(SimulationParameters const& parameters)
 {
+    auto deviceSlice = claimDeviceSlice();
     _settings.simulationParameters = parameters;
-    CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(cudaSimulationParameters, &parameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
+
+    //deferred to the next device access so that a burst of slider changes coalesces into a single
+    //stream-ordered upload (see claimDeviceSlice); during construction the kernels launcher does
+    //not exist yet and the upload happens directly
+    if (_simulationKernels) {
+        _simulationKernels->scheduleSimulationParametersUpdate(parameters);
+    } else {
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpyToSymbol(cudaSimulationParameters, &parameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice));
+    }
 }
 
 void _CudaSimulationFacade::setSimulationParametersSpots(SimulationParametersSpots const& spots)
 {
+    auto deviceSlice = claimDeviceSlice();
     _settings.simulationParametersSpots = spots;
-    CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(
-        cudaSimulationParametersSpots, &spots, sizeof(SimulationParametersSpots), 0, cudaMemcpyHostToDevice));
+
+    //deferred like setSimulationParameters; the flush also refreshes the spot weight field. During
+    //construction the weight field is computed once the simulation data exists (see constructor)
+    if (_simulationKernels) {
+        _simulationKernels->scheduleSimulationParametersSpotsUpdate(spots);
+    } else {
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbol(
+            cudaSimulationParametersSpots, &spots, sizeof(SimulationParametersSpots), 0, cudaMemcpyHostToDevice));
+    }
 }
 
 void _CudaSimulationFacade::setFlowFieldSettings(FlowFieldSettings const& settings)
 {
+    auto deviceSlice = claimDeviceSlice();
     CHECK_FOR_CUDA_ERROR(
         cudaMemcpyToSymbol(cudaFlowFieldSettings, &settings, sizeof(FlowFieldSettings), 0, cudaMemcpyHostToDevice));
 
@@ -463,12 +1207,14 @@ void _CudaSimulationFacade::setFlowFieldSettings(FlowFieldSettings const& settin
 
 void _CudaSimulationFacade::clear()
 {
+    auto deviceSlice = claimDeviceSlice();
     _dataAccessKernels->clearData(_settings.gpuSettings, *_cudaSimulationData);
     syncAndCheck();
 }
 
 void _CudaSimulationFacade::resizeArraysIfNecessary(ArraySizes const& additionals)
 {
+    auto deviceSlice = claimDeviceSlice();
     if (_cudaSimulationData->shouldResize(
             additionals.cellArraySize, additionals.particleArraySize, additionals.tokenArraySize)) {
         resizeArrays(additionals);
@@ -481,17 +1227,36 @@ void _CudaSimulationFacade::syncAndCheck()
     CHECK_FOR_CUDA_ERROR(cudaGetLastError());
 }
 
-void _CudaSimulationFacade::copyDataTOtoDevice(DataAccessTO const& dataTO)
+void _CudaSimulationFacade::accumulateKernelProfileData(std::vector<KernelTiming> const& timings)
 {
-    copyToDevice(_cudaAccessTO->numCells, dataTO.numCells);
-    copyToDevice(_cudaAccessTO->numParticles, dataTO.numParticles);
-    copyToDevice(_cudaAccessTO->numTokens, dataTO.numTokens);
-    copyToDevice(_cudaAccessTO->numStringBytes, dataTO.numStringBytes);
+    std::lock_guard lock(_mutexForKernelProfileData);
+    for (auto const& timing : timings) {
+        auto& totalTimings = _kernelProfileData.totalTimings;
+        auto entry =
+            std::find_if(totalTimings.begin(), totalTimings.end(), [&timing](KernelTiming const& total) { return total.kernelName == timing.kernelName; });
+        if (entry != totalTimings.end()) {
+            entry->durationInMs += timing.durationInMs;
+        } else {
+            totalTimings.emplace_back(timing);
+        }
+    }
+    ++_kernelProfileData.numTimesteps;
+}
 
-    copyToDevice(_cudaAccessTO->cells, dataTO.cells, *dataTO.numCells);
-    copyToDevice(_cudaAccessTO->particles, dataTO.particles, *dataTO.numParticles);
-    copyToDevice(_cudaAccessTO->tokens, dataTO.tokens, *dataTO.numTokens);
-    copyToDevice(_cudaAccessTO->stringBytes, dataTO.stringBytes, *dataTO.numStringBytes);
+void _CudaSimulationFacade::copyDataTOtoDevice(DataAccessTO const& dataTO)
+{
+    //the TO buffers are pinned host memory (see _AccessDataTOCache), so the transfers can be
+    //overlapped on the transfer stream and synchronized only once
+    copyToDeviceAsync(_cudaAccessTO->numCells, dataTO.numCells, 1, _transferStream);
+    copyToDeviceAsync(_cudaAccessTO->numParticles, dataTO.numParticles, 1, _transferStream);
+    copyToDeviceAsync(_cudaAccessTO->numTokens, dataTO.numTokens, 1, _transferStream);
+    copyToDeviceAsync(_cudaAccessTO->numStringBytes, dataTO.numStringBytes, 1, _transferStream);
+
+    copyToDeviceAsync(_cudaAccessTO->cells, dataTO.cells, *dataTO.numCells, _transferStream);
+    copyToDeviceAsync(_cudaAccessTO->particles, dataTO.particles, *dataTO.numParticles, _transferStream);
+    copyToDeviceAsync(_cudaAccessTO->tokens, dataTO.tokens, *dataTO.numTokens, _transferStream);
+    copyToDeviceAsync(_cudaAccessTO->stringBytes, dataTO.stringBytes, *dataTO.numStringBytes, _transferStream);
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_transferStream));
 }
 
 void _CudaSimulationFacade::copyDataTOtoHost(DataAccessTO const& dataTO)
@@ -501,10 +1266,11 @@ void _CudaSimulationFacade::copyDataTOtoHost(DataAccessTO const& dataTO)
     copyToHost(dataTO.numTokens, _cudaAccessTO->numTokens);
     copyToHost(dataTO.numStringBytes, _cudaAccessTO->numStringBytes);
 
-    copyToHost(dataTO.cells, _cudaAccessTO->cells, *dataTO.numCells);
-    copyToHost(dataTO.particles, _cudaAccessTO->particles, *dataTO.numParticles);
-    copyToHost(dataTO.tokens, _cudaAccessTO->tokens, *dataTO.numTokens);
-    copyToHost(dataTO.stringBytes, _cudaAccessTO->stringBytes, *dataTO.numStringBytes);
+    copyToHostAsync(dataTO.cells, _cudaAccessTO->cells, *dataTO.numCells, _transferStream);
+    copyToHostAsync(dataTO.particles, _cudaAccessTO->particles, *dataTO.numParticles, _transferStream);
+    copyToHostAsync(dataTO.tokens, _cudaAccessTO->tokens, *dataTO.numTokens, _transferStream);
+    copyToHostAsync(dataTO.stringBytes, _cudaAccessTO->stringBytes, *dataTO.numStringBytes, _transferStream);
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_transferStream));
 }
 
 void _CudaSimulationFacade::automaticResizeArrays()
@@ -512,27 +1278,81 @@ void _CudaSimulationFacade::automaticResizeArrays()
     //make check after every 10th time step
     if (_currentTimestep.load() % 10 == 0) {
         if (_cudaSimulationResult->isArrayResizeNeeded()) {
+
+            //the overflow reserve is already being consumed: suspend construction for the next few
+            //steps so the resize completes before the arrays run hard against their capacity and
+            //entities would be lost
+            if (_cudaSimulationResult->isOverflowReserveTouched()) {
+                setValueToDevice(_cudaSimulationData->constructionThrottle, Const::ConstructionThrottleTimesteps);
+            }
             resizeArrays({0, 0, 0});
         }
     }
 }
 
+void _CudaSimulationFacade::reportInvariantViolationsIfAny()
+{
+    //make check after every 10th time step (the device counters are cumulative, so nothing is lost)
+    if (_currentTimestep.load() % 10 != 0) {
+        return;
+    }
+    auto violations = _cudaSimulationResult->getInvariantViolationData();
+    if (violations.asymmetricConnections != _reportedAsymmetricConnections
+        || violations.mapResidencyViolations != _reportedMapResidencyViolations
+        || violations.invalidEnergies != _reportedInvalidEnergies) {
+        std::stringstream stream;
+        stream << "invariant violations detected: " << violations.asymmetricConnections << " asymmetric connection(s), "
+               << violations.mapResidencyViolations << " stale map entrie(s), " << violations.invalidEnergies
+               << " invalid energy value(s) since simulation start";
+        log(Priority::Important, stream.str());
+        _reportedAsymmetricConnections = violations.asymmetricConnections;
+        _reportedMapResidencyViolations = violations.mapResidencyViolations;
+        _reportedInvalidEnergies = violations.invalidEnergies;
+    }
+}
+
 void _CudaSimulationFacade::resizeArrays(ArraySizes const& additionals)
+{
+    try {
+        resizeArraysIntern(additionals);
+    } catch (CudaMemoryAllocationException const&) {
+
+        //out of device memory: release the emergency pool to regain headroom and retry once; if
+        //that also fails the exception travels up to EngineWorker, which snapshots the world to
+        //the host and rebuilds the device context
+        if (!CudaMemoryManager::getInstance().releaseEmergencyPool()) {
+            throw;
+        }
+        log(Priority::Important, "gpu memory exhausted: emergency pool released, retrying resize");
+        resizeArraysIntern(additionals);
+    }
+}
+
+void _CudaSimulationFacade::resizeArraysIntern(ArraySizes const& additionals)
 {
     log(Priority::Important, "resize arrays");
 
-    _cudaSimulationData->resizeEntitiesForCleanup(
+    //preferred path: the entity arrays are backed by virtual-memory reservations, so growing them
+    //maps additional physical chunks behind the existing device addresses - no entity is copied
+    //and no pointer has to be rewired, which turns the stop-the-world copy cycle below into a few
+    //driver calls; the captured graphs stay valid because the data addresses do not change
+    auto grownInPlace = _cudaSimulationData->tryGrowEntityArraysInPlace(
         additionals.cellArraySize, additionals.particleArraySize, additionals.tokenArraySize);
-    if (!_cudaSimulationData->isEmpty()) {
-        _garbageCollectorKernels->copyArrays(_settings.gpuSettings, *_cudaSimulationData);
-        syncAndCheck();
 
-        _cudaSimulationData->resizeRemainings();
+    if (!grownInPlace) {
+        _cudaSimulationData->resizeEntitiesForCleanup(
+            additionals.cellArraySize, additionals.particleArraySize, additionals.tokenArraySize);
+        if (!_cudaSimulationData->isEmpty()) {
+            _garbageCollectorKernels->copyArrays(_settings.gpuSettings, *_cudaSimulationData);
+            syncAndCheck();
 
-        _garbageCollectorKernels->swapArrays(_settings.gpuSettings, *_cudaSimulationData);
-        syncAndCheck();
-    } else {
-        _cudaSimulationData->resizeRemainings();
+            _cudaSimulationData->resizeRemainings();
+
+            _garbageCollectorKernels->swapArrays(_settings.gpuSettings, *_cudaSimulationData);
+            syncAndCheck();
+        } else {
+            _cudaSimulationData->resizeRemainings();
+        }
     }
 
     CudaMemoryManager::getInstance().freeMemory(_cudaAccessTO->cells);
@@ -549,6 +1369,10 @@ void _CudaSimulationFacade::resizeArrays(ArraySizes const& additionals)
 
     CHECK_FOR_CUDA_ERROR(cudaGetLastError());
 
+    if (_simulationKernels && !grownInPlace) {
+        _simulationKernels->invalidateTimestepGraphs();  //device array pointers are baked into the captured graphs
+    }
+
     log(Priority::Unimportant, "cell array size: " + std::to_string(cellArraySize));
     log(Priority::Unimportant, "particle array size: " + std::to_string(cellArraySize));
     log(Priority::Unimportant, "token array size: " + std::to_string(tokenArraySize));
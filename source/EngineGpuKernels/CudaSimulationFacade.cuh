@@ -2,18 +2,30 @@
 
 #include <cstdint>
 #include <atomic>
+#include <mutex>
+#include <optional>
 #include <vector>
 
+#include <cuda_runtime.h>
+
 #if defined(_WIN32)
 #define NOMINMAX
 #include <windows.h>
 #endif
 #include <GL/gl.h>
 
+#include "Base/Definitions.h"
+
+#include "EngineInterface/CellEvent.h"
+#include "EngineInterface/GpuMemoryInfo.h"
+#include "EngineInterface/LineageRecord.h"
+#include "EngineInterface/KernelProfileData.h"
+#include "EngineInterface/KernelTiming.h"
 #include "EngineInterface/MonitorData.h"
 #include "EngineInterface/Settings.h"
 #include "EngineInterface/SelectionShallowData.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/WorldGenerationSpec.h"
 
 #include "Definitions.cuh"
 
@@ -28,12 +40,46 @@ public:
     void* registerImageResource(GLuint image);
 
     void calcTimestep();
+    void calcTimesteps(int numTimesteps);  //single synchronization at the end of the batch
+
+    //advances one timestep with every kernel launched individually and timed via cuda events;
+    //far slower than calcTimestep, only used by the benchmarks target
+    std::vector<KernelTiming> benchmarkTimestep();
+
+    //opt-in profiling: while enabled, calcTimesteps uses the per-kernel timed launch path
+    //instead of the captured graphs (considerably slower) and accumulates the times per kernel;
+    //enabling resets the accumulated data
+    void setKernelProfilingEnabled(bool enabled);
+    bool isKernelProfilingEnabled() const;
+    KernelProfileData getKernelProfileData() const;
 
     void drawVectorGraphics(float2 const& rectUpperLeft, float2 const& rectLowerRight, void* cudaResource, int2 const& imageSize, double zoom);
+
+    //copies the last completed frame to the GL texture without drawing a new one; touches only
+    //the rendering buffers, so it can be called while another operation holds the access gate
+    void presentLastFrame(void* cudaResource, int2 const& imageSize);
+
+    //renders into an offscreen buffer on a dedicated stream and copies the result to hostImageData
+    //(imageSize.x * imageSize.y pixels in bbbbggggrrrr format); independent of the double-buffered
+    //GUI frames, so exports neither disturb nor wait for them
+    void drawImageToHost(float2 const& rectUpperLeft, float2 const& rectLowerRight, int2 const& imageSize, double zoom, uint64_t* hostImageData);
+
+    //renders the whole world into a small thumbnail (imageSize.x * imageSize.y pixels in
+    //bbbbggggrrrr format) from the density map maintained for the sensors; the cost is per
+    //thumbnail pixel and independent of the population size, so this stays cheap enough to be
+    //polled periodically for the navigation minimap. Shows the state as of the last computed
+    //timestep
+    void drawThumbnailToHost(int2 const& imageSize, uint64_t* hostImageData);
     void getSimulationData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
-    void getSelectedSimulationData(bool includeClusters, DataAccessTO const& dataTO);
+    //two-phase extraction of the selection: the kernels fill the device-side transfer arrays and
+    //return the entity counts, so the host buffers can be sized from the actual selection size
+    //before the arrays are copied via retrieveExtractedSimulationData
+    ArraySizes extractSelectedSimulationData(bool includeClusters);
+    void retrieveExtractedSimulationData(DataAccessTO const& dataTO);
     void getInspectedSimulationData(std::vector<uint64_t> entityIds, DataAccessTO const& dataTO);
-    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
+    //the overlay is decimated on the device: overcrowded screen areas transfer only a stable
+    //subset of their cells, so overlay mode stays interactive at any zoom
+    void getOverlayData(int2 const& rectUpperLeft, int2 const& rectLowerRight, double zoom, DataAccessTO const& dataTO);
     void addAndSelectSimulationData(DataAccessTO const& dataTO);
     void setSimulationData(DataAccessTO const& dataTO);
     void removeSelectedEntities(bool includeClusters);
@@ -53,9 +99,32 @@ public:
     void removeSelection();
     void updateSelection();
     void colorSelectedEntities(unsigned char color, bool includeClusters);
+    void scaleEnergyForSelectedEntities(float factor, bool includeClusters);
+    void setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters);
+    void applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta);  //batch primitive: one kernel pass for the whole id list
+    void colorizeClusters(std::vector<int> const& colorCodes, unsigned int seed);
     void reconnectSelectedEntities();
+    //duplicates the selected entities with fresh ids at an offset position entirely on the GPU;
+    //the clones take over the selection
+    void cloneSelectedEntities(float2 const& posDelta, bool includeClusters);
+    //stamps one transformed copy of the selection per transform entirely on the GPU; requires a
+    //cluster-complete selection and leaves the originals and the copies selected
+    void replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, float2 const& center);
+    void drawBarrier(std::vector<float2> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode);
+    //converts an image to a cell pattern entirely on the GPU: one cell per sufficiently bright
+    //pixel, connected to its lattice neighbors; the created pattern takes over the selection
+    void convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, float2 const& center);
+    //seeds the world with randomly distributed cells and energy particles drawn from the spec,
+    //entirely on the GPU; intended for freshly created (empty) worlds
+    void generateWorld(WorldGenerationSpec const& spec);
+    void setFreezeZone(bool active, float2 const& topLeft, float2 const& bottomRight);
 
     void setGpuConstants(GpuSettings const& cudaConstants);
+
+    //turbo mode runs the instrumentation-free timestep kernel variants: the process statistics,
+    //the sampled invariant checks and the adaptive slow cadence are disabled while active; use
+    //getQuickMonitorData instead of getMonitorData to avoid the statistics kernels as well
+    void setTurboMode(bool value);
     void setSimulationParameters(SimulationParameters const& parameters);
     void setSimulationParametersSpots(SimulationParametersSpots const& spots);
     void setFlowFieldSettings(FlowFieldSettings const& settings);
@@ -63,6 +132,33 @@ public:
     ArraySizes getArraySizes() const;
 
     MonitorData getMonitorData();
+
+    //cheap monitoring variant for turbo mode: only the timestep and the entity counts are filled,
+    //straight from the host-side array mirrors without any kernel launch or device transfer
+    MonitorData getQuickMonitorData();
+
+    //defines the user rects for the region-scoped statistics; the regions appear in
+    //MonitorData::regions behind the parameter spots
+    void setStatisticsRects(std::vector<RealRect> const& rects);
+
+    //drains the birth/death records the kernels appended to the device ring buffer since the last
+    //call; on a buffer overflow the oldest records are lost and the drain resumes at the oldest
+    //still available record
+    std::vector<CellEvent> retrieveCellEvents();
+
+    //optional lineage tracking: while enabled, every constructed cell appends a replication
+    //record (child, parent, lineage founder); disabled by default since most sessions do not
+    //study descent
+    void setLineageTrackingEnabled(bool enabled);
+    std::vector<LineageRecord> retrieveLineageRecords();  //same drain semantics as retrieveCellEvents
+
+    //order-independent hash over entity ids, quantized positions and connections, computed on the
+    //GPU; much cheaper than downloading and comparing the full world state
+    uint64_t calcWorldHash();
+
+    //snapshot of the allocation situation including a per-array breakdown of the entity arrays
+    GpuMemoryInfo getMemoryInfo();
+
     uint64_t getCurrentTimestep() const;
     void setCurrentTimestep(uint64_t timestep);
 
@@ -71,17 +167,68 @@ public:
     void resizeArraysIfNecessary(ArraySizes const& additionals);
 
 private:
+    //multiple facade instances can be time-sliced on one gpu: the slice mutex serializes device
+    //use across instances and the owner pointer tracks whose settings currently occupy the
+    //__constant__ memory, which is global per cuda context. claiming re-uploads this instance's
+    //constant state if another instance ran in between; the captured graphs stay valid since
+    //constant memory is read at execution time, not at capture time
+    std::unique_lock<std::recursive_mutex> claimDeviceSlice();
+    static std::recursive_mutex s_deviceSliceMutex;
+    static _CudaSimulationFacade* s_constantMemoryOwner;
+
     void syncAndCheck();
+    void syncTimestepToDevice();
+
+    //shared drain for the device-side record rings (events, lineage); copies the slots between
+    //the drained cursor and the current write cursor in at most two chunks
+    template <typename Record>
+    std::vector<Record> drainRecordRing(Record* deviceRecords, unsigned long long* deviceCursor, uint64_t bufferSize, uint64_t& drainedCursor);
+    void accumulateKernelProfileData(std::vector<KernelTiming> const& timings);
+    void takeOverCompletedFrame();
+    MonitorData assembleMonitorData();
+    MonitorRegions assembleMonitorRegions() const;
     void copyDataTOtoDevice(DataAccessTO const& dataTO);
     void copyDataTOtoHost(DataAccessTO const& dataTO);
     void automaticResizeArrays();
+    void reportInvariantViolationsIfAny();
     void resizeArrays(ArraySizes const& additionals);
+    void resizeArraysIntern(ArraySizes const& additionals);
 
     std::atomic<uint64_t> _currentTimestep;
     Settings _settings;
+    cudaStream_t _renderStream = nullptr;
+    cudaStream_t _transferStream = nullptr;
+    cudaStream_t _monitorStream = nullptr;
+    cudaEvent_t _monitorEvent = nullptr;
+    bool _monitorCollectionPending = false;
+    cudaEvent_t _renderEvent = nullptr;
+    bool _renderingInFlight = false;
+    int2 _frontImageSize{0, 0};
+    int2 _backImageSize{0, 0};
+    std::optional<MonitorData> _lastMonitorData;
+    std::vector<RealRect> _statisticsRects;
+    int _numRegionsInCollection = 0;  //region count of the in-flight statistics collection; the rects may change before it is consumed
+    uint64_t _drainedCellEventCursor = 0;  //value of the device-side event write cursor up to which the records have been drained
+    uint64_t _drainedLineageRecordCursor = 0;
+
+    cudaStream_t _exportStream = nullptr;
+
+    //offscreen thumbnail buffer for the navigation minimap; created on first use
+    uint64_t* _cudaThumbnailImage = nullptr;
+    int2 _thumbnailSize{0, 0};
+
+    //violation counts already written to the log (the device counters are cumulative)
+    int _reportedAsymmetricConnections = 0;
+    int _reportedMapResidencyViolations = 0;
+    int _reportedInvalidEnergies = 0;
+
+    std::atomic<bool> _kernelProfilingEnabled{false};
+    mutable std::mutex _mutexForKernelProfileData;
+    KernelProfileData _kernelProfileData;
 
     std::shared_ptr<SimulationData> _cudaSimulationData;
     std::shared_ptr<RenderingData> _cudaRenderingData;
+    std::shared_ptr<RenderingData> _cudaExportRenderingData;  //created on first export
     std::shared_ptr<SimulationResult> _cudaSimulationResult;
     std::shared_ptr<SelectionResult> _cudaSelectionResult;
     std::shared_ptr<DataAccessTO> _cudaAccessTO;
@@ -1,7 +1,23 @@
 ﻿#include "DataAccessKernels.cuh"
 
+#include "CellProcessor.cuh"
+#include "CellConnectionProcessor.cuh"
+#include "ConstantMemory.cuh"
+
 namespace
 {
+    //budget of one overlay element per this many screen pixels; slots more crowded than the budget
+    //are thinned out on the device before the transfer to the host
+    auto constexpr PixelsPerOverlayElement = 256.0f;
+
+    //maps an entity id to [0, 1); the overlay decimation is a pure function of the id, so the
+    //visible subset stays stable from frame to frame
+    __device__ float hashToUnitInterval(uint64_t id)
+    {
+        auto hash = static_cast<uint32_t>(id) * 2654435761u;
+        return toFloat(hash >> 16) / 65536.0f;
+    }
+
     __device__ void copyString(int& targetLen, int& targetStringIndex, int sourceLen, char* sourceString, int& numStringBytes, char*& stringBytes)
     {
         targetLen = sourceLen;
@@ -32,22 +48,29 @@ namespace
         cellTO.cellFunctionInvocations = cell->cellFunctionInvocations;
         cellTO.metadata.color = cell->metadata.color;
 
-        copyString(
-            cellTO.metadata.nameLen, cellTO.metadata.nameStringIndex, cell->metadata.nameLen, cell->metadata.name, *dataTO.numStringBytes, dataTO.stringBytes);
-        copyString(
-            cellTO.metadata.descriptionLen,
-            cellTO.metadata.descriptionStringIndex,
-            cell->metadata.descriptionLen,
-            cell->metadata.description,
-            *dataTO.numStringBytes,
-            dataTO.stringBytes);
-        copyString(
-            cellTO.metadata.sourceCodeLen,
-            cellTO.metadata.sourceCodeStringIndex,
-            cell->metadata.sourceCodeLen,
-            cell->metadata.sourceCode,
-            *dataTO.numStringBytes,
-            dataTO.stringBytes);
+        if (dataTO.includeMetadata) {
+            copyString(
+                cellTO.metadata.nameLen, cellTO.metadata.nameStringIndex, cell->metadata.nameLen, cell->metadata.name, *dataTO.numStringBytes, dataTO.stringBytes);
+            copyString(
+                cellTO.metadata.descriptionLen,
+                cellTO.metadata.descriptionStringIndex,
+                cell->metadata.descriptionLen,
+                cell->metadata.description,
+                *dataTO.numStringBytes,
+                dataTO.stringBytes);
+            copyString(
+                cellTO.metadata.sourceCodeLen,
+                cellTO.metadata.sourceCodeStringIndex,
+                cell->metadata.sourceCodeLen,
+                cell->metadata.sourceCode,
+                *dataTO.numStringBytes,
+                dataTO.stringBytes);
+        } else {
+            //zeroed lengths suffice: the converter never touches the string indices of empty strings
+            cellTO.metadata.nameLen = 0;
+            cellTO.metadata.descriptionLen = 0;
+            cellTO.metadata.sourceCodeLen = 0;
+        }
 
         cell->tag = cellTOIndex;
         for (int i = 0; i < cell->numConnections; ++i) {
@@ -161,9 +184,13 @@ __global__ void cudaGetInspectedParticleData(InspectedEntityIds ids, SimulationD
     }
 }
 
-__global__ void cudaGetOverlayData(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data, DataAccessTO dataTO)
+__global__ void cudaGetOverlayData(int2 rectUpperLeft, int2 rectLowerRight, float zoom, SimulationData data, DataAccessTO dataTO)
 {
     {
+        auto& densityMap = data.cellFunctionData.densityMap;
+        auto slotSize = densityMap.getSlotSize();
+        auto maxElementsPerSlot = toFloat(slotSize * slotSize) * zoom * zoom / PixelsPerOverlayElement;
+
         auto const& cells = data.entities.cellPointers;
         auto const partition = calcAllThreadsPartition(cells.getNumEntries());
 
@@ -175,6 +202,20 @@ __global__ void cudaGetOverlayData(int2 rectUpperLeft, int2 rectLowerRight, Simu
             if (!isContainedInRect(rectUpperLeft, rectLowerRight, pos)) {
                 continue;
             }
+            if (!cell->selected) {
+                //probabilistic decimation against the density map: each cell of an overcrowded
+                //slot survives with probability maxElementsPerSlot / numCellsInSlot, so the
+                //number of transferred elements is capped per screen area; selected cells are
+                //always kept as their selection markers must not vanish
+                auto densities = densityMap.getDensities(pos);
+                auto numCellsInSlot = 0;
+                for (int i = 0; i < 7; ++i) {
+                    numCellsInSlot += toInt((densities >> (i * 8)) & 0xff);
+                }
+                if (toFloat(numCellsInSlot) * hashToUnitInterval(cell->id) > maxElementsPerSlot) {
+                    continue;
+                }
+            }
             auto cellTOIndex = atomicAdd(dataTO.numCells, 1);
             auto& cellTO = dataTO.cells[cellTOIndex];
 
@@ -259,8 +300,10 @@ __global__ void cudaGetTokenData(SimulationData data, DataAccessTO dataTO)
         auto& tokenTO = dataTO.tokens[tokenTOIndex];
 
         tokenTO.energy = token->energy;
-        for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
-            tokenTO.memory[i] = token->memory[i];
+        if (dataTO.includeTokenMemories) {
+            for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
+                tokenTO.memory[i] = token->memory[i];
+            }
         }
         tokenTO.cellIndex = token->cell->tag;
         tokenTO.sequenceNumber = tokenIndex;
@@ -357,3 +400,49 @@ __global__ void cudaSaveNumEntries(SimulationData data)
 {
     data.entities.saveNumEntries();
 }
+
+__global__ void cudaWarmStartPrepare(SimulationData data)
+{
+    data.prepareForNextTimestep();
+}
+
+__global__ void cudaWarmStartRefreshCellState(SimulationData data)
+{
+    auto& cells = data.entities.cellPointers;
+    auto const partition = calcAllThreadsPartition(cells.getNumEntries());
+
+    auto cellArray = data.entities.cells.getArray();
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& cell = cells.at(index);
+
+        //the loaded cells have not passed through updateVelocities yet, so the SoA mirror that
+        //checkConnections and the connection forces read is still unpopulated
+        auto slot = toInt(cell - cellArray);
+        data.cellSoA.absPos[slot] = cell->absPos;
+        data.cellSoA.vel[slot] = cell->vel;
+        data.cellSoA.energy[slot] = cell->energy;
+
+        if (!cell->barrier) {
+            data.activeCellIndexes.tryAddEntry(index);
+        }
+    }
+}
+
+__global__ void cudaWarmStartCheckConnections(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.checkConnections(data);
+}
+
+__global__ void cudaWarmStartPrepareOperations(SimulationData data)
+{
+    data.structuralOperations.saveNumEntries();
+    if (cudaThreadSettings.deterministicMode) {
+        CellConnectionProcessor::sortStructuralOperations(data);
+    }
+}
+
+__global__ void cudaWarmStartProcessOperations(SimulationData data)
+{
+    CellConnectionProcessor::processConnectionsOperations(data);
+}
@@ -18,7 +18,7 @@ __global__ void cudaGetSelectedCellDataWithoutConnections(SimulationData data, b
 __global__ void cudaGetSelectedParticleData(SimulationData data, DataAccessTO access);
 __global__ void cudaGetInspectedCellDataWithoutConnections(InspectedEntityIds ids, SimulationData data, DataAccessTO dataTO);
 __global__ void cudaGetInspectedParticleData(InspectedEntityIds ids, SimulationData data, DataAccessTO access);
-__global__ void cudaGetOverlayData(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data, DataAccessTO dataTO);
+__global__ void cudaGetOverlayData(int2 rectUpperLeft, int2 rectLowerRight, float zoom, SimulationData data, DataAccessTO dataTO);
 __global__ void cudaGetCellDataWithoutConnections(int2 rectUpperLeft, int2 rectLowerRight, SimulationData data, DataAccessTO dataTO);
 __global__ void cudaResolveConnections(SimulationData data, DataAccessTO dataTO);
 __global__ void cudaGetTokenData(SimulationData data, DataAccessTO dataTO);
@@ -28,3 +28,12 @@ __global__ void cudaAdaptNumberGenerator(CudaNumberGenerator numberGen, DataAcce
 __global__ void cudaClearDataTO(DataAccessTO dataTO);
 __global__ void cudaSaveNumEntries(SimulationData data);
 __global__ void cudaClearData(SimulationData data);
+
+//one-shot warm start after a full world load: rebuilds the derived per-cell state that the
+//timestep kernels otherwise refresh incrementally and validates the loaded connections, so the
+//first timesteps after a load run at steady-state speed
+__global__ void cudaWarmStartPrepare(SimulationData data);
+__global__ void cudaWarmStartRefreshCellState(SimulationData data);
+__global__ void cudaWarmStartCheckConnections(SimulationData data);
+__global__ void cudaWarmStartPrepareOperations(SimulationData data);
+__global__ void cudaWarmStartProcessOperations(SimulationData data);
@@ -3,6 +3,7 @@
 #include "DataAccessKernels.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
 #include "EditKernelsLauncher.cuh"
+#include "SimulationKernels.cuh"
 
 _DataAccessKernelsLauncher::_DataAccessKernelsLauncher()
 {
@@ -55,10 +56,11 @@ void _DataAccessKernelsLauncher::getOverlayData(
     SimulationData const& data,
     int2 rectUpperLeft,
     int2 rectLowerRight,
+    float zoom,
     DataAccessTO const& dataTO)
 {
     KERNEL_CALL_1_1(cudaClearDataTO, dataTO);
-    KERNEL_CALL(cudaGetOverlayData, rectUpperLeft, rectLowerRight, data, dataTO);
+    KERNEL_CALL(cudaGetOverlayData, rectUpperLeft, rectLowerRight, zoom, data, dataTO);
 }
 
 void _DataAccessKernelsLauncher::addData(GpuSettings const& gpuSettings, SimulationData const& data, DataAccessTO const& dataTO, bool selectData, bool createIds)
@@ -70,9 +72,36 @@ void _DataAccessKernelsLauncher::addData(GpuSettings const& gpuSettings, Simulat
     if (selectData) {
         _editKernels->rolloutSelection(gpuSettings, data);
     }
+
+    //the density map is normally refreshed by the timestep kernels; after an upload it is rebuilt
+    //here so that the density-based renderer and the sensors see the new world immediately
+    KERNEL_CALL(cudaClearDensityMap, data);
+    KERNEL_CALL(cudaFillDensityMap, data);
 }
 
 void _DataAccessKernelsLauncher::clearData(GpuSettings const& gpuSettings, SimulationData const& data)
 {
     KERNEL_CALL(cudaClearData, data);
 }
+
+void _DataAccessKernelsLauncher::warmStartAfterLoad(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    //rebuild the derived per-cell state (SoA mirror, active cell list) and delete over-stretched
+    //connections once, instead of letting the first timesteps discover them all at the same time
+    KERNEL_CALL_1_1(cudaWarmStartPrepare, data);
+    KERNEL_CALL(cudaWarmStartRefreshCellState, data);
+    KERNEL_CALL(cudaWarmStartCheckConnections, data);
+    KERNEL_CALL_1_1(cudaWarmStartPrepareOperations, data);
+    KERNEL_CALL(cudaWarmStartProcessOperations, data);
+
+    //pre-compute the cluster data: the load compaction has flagged a structural change, so the
+    //relabeling runs from scratch here and the first in-simulation rigidity updates can skip it
+    KERNEL_CALL(cudaInitClusterData, data);
+    KERNEL_CALL(cudaFindClusterIteration, data);
+    KERNEL_CALL(cudaFindClusterIteration, data);
+    KERNEL_CALL(cudaFindClusterIteration, data);
+    KERNEL_CALL(cudaFindClusterBoundaries, data);  //also clears the pending-change counter
+    KERNEL_CALL(cudaAccumulateClusterPosAndVel, data);
+    KERNEL_CALL(cudaAccumulateClusterAngularProp, data);
+    //no cudaApplyClusterData here: the warm start must not alter any velocities
+}
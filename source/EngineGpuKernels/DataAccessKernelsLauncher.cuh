@@ -16,11 +16,16 @@ public:
     void getData(GpuSettings const& gpuSettings, SimulationData const& data, int2 const& rectUpperLeft, int2 const& rectLowerRight, DataAccessTO const& dataTO);
     void getSelectedData(GpuSettings const& gpuSettings, SimulationData const& data, bool includeClusters, DataAccessTO const& dataTO);
     void getInspectedData(GpuSettings const& gpuSettings, SimulationData const& data, InspectedEntityIds entityIds, DataAccessTO const& dataTO);
-    void getOverlayData(GpuSettings const& gpuSettings, SimulationData const& data, int2 rectUpperLeft, int2 rectLowerRight, DataAccessTO const& dataTO);
+    void getOverlayData(GpuSettings const& gpuSettings, SimulationData const& data, int2 rectUpperLeft, int2 rectLowerRight, float zoom, DataAccessTO const& dataTO);
 
     void addData(GpuSettings const& gpuSettings, SimulationData const& data, DataAccessTO const& dataTO, bool selectData, bool createIds);
     void clearData(GpuSettings const& gpuSettings, SimulationData const& data);
 
+    //one-shot kernel sequence after a full world load: validates the loaded connections and
+    //pre-computes the cluster data so that the first timesteps do not pay for fixing up the
+    //whole world at once
+    void warmStartAfterLoad(GpuSettings const& gpuSettings, SimulationData const& data);
+
 private:
     GarbageCollectorKernelsLauncher _garbageCollectorKernels;
     EditKernelsLauncher _editKernels;
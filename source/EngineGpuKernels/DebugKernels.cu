@@ -49,6 +49,79 @@ __global__ void DEBUG_checkCellsAndParticles(SimulationData data, float* sumEner
     DEBUG_checkParticles(data, sumEnergy, location);
 }
 
+namespace
+{
+    //finalizer of the splitmix64 generator: cheap and well-mixed, so the sample is uncorrelated
+    //with the cell order and varies from timestep to timestep via the salt
+    __device__ __inline__ uint64_t hash64(uint64_t x)
+    {
+        x ^= x >> 30;
+        x *= 0xbf58476d1ce4e5b9ull;
+        x ^= x >> 27;
+        x *= 0x94d049bb133111ebull;
+        x ^= x >> 31;
+        return x;
+    }
+}
+
+__device__ void DEBUG_checkInvariantsSampled(SimulationData& data, SimulationResult& result)
+{
+    auto const salt = *data.invariantCheckSalt;
+    auto& cells = data.entities.cellPointers;
+    auto partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+
+        //validate roughly 1% of the cells per timestep
+        if ((hash64((static_cast<uint64_t>(salt) << 32) | index) & 127) != 0) {
+            continue;
+        }
+        auto const& cell = cells.at(index);
+        if (!cell) {
+            continue;
+        }
+
+        //energy sanity
+        if (cell->energy < 0 || isnan(cell->energy)) {
+            result.incInvalidEnergy();
+        }
+
+        //connection symmetry: every connection must be mirrored by the connected cell
+        for (int i = 0; i < cell->numConnections; ++i) {
+            auto connectingCell = cell->connections[i].cell;
+            bool mirrored = false;
+            for (int j = 0; j < connectingCell->numConnections; ++j) {
+                if (connectingCell->connections[j].cell == cell) {
+                    mirrored = true;
+                    break;
+                }
+            }
+            if (!mirrored) {
+                result.incAsymmetricConnection();
+            }
+        }
+
+        //map residency: the occupied slots of the cell's map sector must hold cells which are
+        //actually located there; a mismatch indicates a stale or dangling map entry
+        int2 posInt = {floorInt(cell->absPos.x), floorInt(cell->absPos.y)};
+        data.cellMap.correctPosition(posInt);
+        for (int slot = 0; slot < 2; ++slot) {
+            if (auto mapCell = data.cellMap.getFromSlot(posInt, slot)) {
+                int2 mapCellPosInt = {floorInt(mapCell->absPos.x), floorInt(mapCell->absPos.y)};
+                data.cellMap.correctPosition(mapCellPosInt);
+                if (mapCellPosInt.x != posInt.x || mapCellPosInt.y != posInt.y) {
+                    result.incMapResidencyViolation();
+                }
+            }
+        }
+    }
+}
+
+__global__ void cudaCheckInvariantsSampled(SimulationData data, SimulationResult result)
+{
+    DEBUG_checkInvariantsSampled(data, result);
+}
+
 /*
 __global__ void DEBUG_kernel(SimulationData data, int location)
 {
@@ -4,6 +4,7 @@
 #include "sm_60_atomic_functions.h"
 
 #include "SimulationData.cuh"
+#include "SimulationResult.cuh"
 #include "CellProcessor.cuh"
 #include "ParticleProcessor.cuh"
 
@@ -11,3 +12,10 @@ __device__ void DEBUG_checkCells(SimulationData& data, float* sumEnergy, int loc
 __device__ void DEBUG_checkParticles(SimulationData& data, float* sumEnergy, int location);
 __global__ void DEBUG_checkCellsAndParticles(SimulationData data, float* sumEnergy, int location);
 __global__ void DEBUG_kernel(SimulationData data, int location);
+
+//always-on invariant check: validates a small random sample of cells (connection symmetry, map
+//residency, energy sanity) and aggregates violations in SimulationResult; unlike the
+//all-or-nothing DEBUG_ kernels above it is cheap enough to run every timestep. Must run while the
+//cell map is fresh, i.e. after updateMap and before the positions move
+__device__ void DEBUG_checkInvariantsSampled(SimulationData& data, SimulationResult& result);
+__global__ void cudaCheckInvariantsSampled(SimulationData data, SimulationResult result);
@@ -4,6 +4,7 @@
 
 struct Cell;
 struct Token;
+struct TokenMemory;
 struct Particle;
 struct Entities;
 
@@ -27,6 +28,9 @@ using DataAccessKernelsLauncher = std::shared_ptr<_DataAccessKernelsLauncher>;
 class _GarbageCollectorKernelsLauncher;
 using GarbageCollectorKernelsLauncher = std::shared_ptr<_GarbageCollectorKernelsLauncher>;
 
+class _GenomeJitCompiler;
+using GenomeJitCompiler = std::shared_ptr<_GenomeJitCompiler>;
+
 class _RenderingKernelsLauncher;
 using RenderingKernelsLauncher = std::shared_ptr<_RenderingKernelsLauncher>;
 
@@ -57,6 +61,34 @@ struct AreaSelectionData
     float2 endPos;
 };
 
+//target palette for the per-cluster colorization (see cudaColorizeClusters); the seed varies
+//the color assignment between invocations
+struct ColorizeClustersData
+{
+    int numColorCodes = 0;
+    unsigned char colorCodes[7];
+    unsigned int seed = 0;
+};
+
+//geometry of the statistics regions (the parameter spot cores followed by the user-defined
+//rects), assembled on the host (see _CudaSimulationFacade::assembleMonitorRegions) and passed to
+//the monitor kernels by value; MaxRegions bounds MonitorData::regions on the host side
+struct MonitorRegions
+{
+    static int constexpr MaxRegions = 8;
+    struct Region
+    {
+        bool circular = false;
+        float posX = 0;
+        float posY = 0;
+        float radius = 0;  //for circular regions
+        float width = 0;   //for rectangular regions
+        float height = 0;
+    };
+    int numRegions = 0;
+    Region regions[MaxRegions];
+};
+
 struct ArraySizes
 {
     int cellArraySize;
@@ -8,14 +8,29 @@
 class DensityMap
 {
 public:
+    //edge length of a coarse slot in units of base slots; the coarse level is only consumed by
+    //the zoomed-out renderer, the sensors always sample the exact base resolution
+    static int constexpr CoarseFactor = 4;
+
     __host__ __inline__ void init(int2 const& worldSize, int slotSize)
     {
         _densityMapSize = {worldSize.x / slotSize, worldSize.y / slotSize};
         CudaMemoryManager::getInstance().acquireMemory<uint64_t>(_densityMapSize.x * _densityMapSize.y, _densityMap);
+        _coarseMapSize = {(_densityMapSize.x + CoarseFactor - 1) / CoarseFactor, (_densityMapSize.y + CoarseFactor - 1) / CoarseFactor};
+        CudaMemoryManager::getInstance().acquireMemory<uint32_t>(_coarseMapSize.x * _coarseMapSize.y * 7, _coarseDensityMap);
         _slotSize = slotSize;
+
+        //the map is rebuilt every timestep, but it may already be read (e.g. by the minimap
+        //thumbnail) before the first timestep has run
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_densityMap, 0, sizeof(uint64_t) * _densityMapSize.x * _densityMapSize.y));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_coarseDensityMap, 0, sizeof(uint32_t) * _coarseMapSize.x * _coarseMapSize.y * 7));
     }
 
-    __host__ __inline__ void free() { CudaMemoryManager::getInstance().freeMemory(_densityMap); }
+    __host__ __inline__ void free()
+    {
+        CudaMemoryManager::getInstance().freeMemory(_densityMap);
+        CudaMemoryManager::getInstance().freeMemory(_coarseDensityMap);
+    }
 
     __device__ __inline__ void clear()
     {
@@ -34,6 +49,62 @@ public:
         return 0;
     }
 
+    //all 7 color counts of a slot in one read (8 bit per color)
+    __device__ __inline__ uint64_t getDensities(float2 const& pos) const
+    {
+        auto slotX = toInt(pos.x) / _slotSize;
+        auto slotY = toInt(pos.y) / _slotSize;
+        if (slotX < 0 || slotX >= _densityMapSize.x || slotY < 0 || slotY >= _densityMapSize.y) {
+            return 0;
+        }
+        return _densityMap[slotX + slotY * _densityMapSize.x];
+    }
+
+    __device__ __inline__ int getSlotSize() const { return _slotSize; }
+
+    //aggregates the base slots into the coarse level; rebuilt from scratch on demand right
+    //before the coarse level is read so that it can never drift from the base counts
+    __device__ __inline__ void buildCoarseLevel()
+    {
+        auto const partition = calcAllThreadsPartition(_coarseMapSize.x * _coarseMapSize.y);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto coarseX = index % _coarseMapSize.x;
+            auto coarseY = index / _coarseMapSize.x;
+            uint32_t counts[7] = {0, 0, 0, 0, 0, 0, 0};
+            for (int dy = 0; dy < CoarseFactor; ++dy) {
+                auto y = coarseY * CoarseFactor + dy;
+                if (y >= _densityMapSize.y) {
+                    break;
+                }
+                for (int dx = 0; dx < CoarseFactor; ++dx) {
+                    auto x = coarseX * CoarseFactor + dx;
+                    if (x >= _densityMapSize.x) {
+                        break;
+                    }
+                    auto densities = _densityMap[x + y * _densityMapSize.x];
+                    for (int color = 0; color < 7; ++color) {
+                        counts[color] += static_cast<uint32_t>((densities >> (color * 8)) & 0xff);
+                    }
+                }
+            }
+            for (int color = 0; color < 7; ++color) {
+                _coarseDensityMap[index * 7 + color] = counts[color];
+            }
+        }
+    }
+
+    __device__ __inline__ uint32_t getCoarseDensity(float2 const& pos, int color) const
+    {
+        auto slotX = toInt(pos.x) / (_slotSize * CoarseFactor);
+        auto slotY = toInt(pos.y) / (_slotSize * CoarseFactor);
+        if (slotX < 0 || slotX >= _coarseMapSize.x || slotY < 0 || slotY >= _coarseMapSize.y) {
+            return 0;
+        }
+        return _coarseDensityMap[(slotX + slotY * _coarseMapSize.x) * 7 + color];
+    }
+
+    __device__ __inline__ int getCoarseSlotSize() const { return _slotSize * CoarseFactor; }
+
     __device__ __inline__ void addCell(Cell* cell)
     {
         auto index = toInt(cell->absPos.x) / _slotSize + toInt(cell->absPos.y) / _slotSize * _densityMapSize.x;
@@ -48,5 +119,10 @@ private:
     int _slotSize;
     int2 _densityMapSize;
     uint64_t* _densityMap;
+
+    //coarse level with CoarseFactor^2 base slots per entry, 7 plain uint32 counts per slot since
+    //the aggregated counts exceed the 8 bit fields of the packed base representation
+    int2 _coarseMapSize;
+    uint32_t* _coarseDensityMap;
 };
 
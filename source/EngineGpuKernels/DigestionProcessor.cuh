@@ -9,6 +9,7 @@
 class DigestionProcessor
 {
 public:
+    template<bool instrumented>
     __inline__ __device__ static void process(Token* token, SimulationData& data, SimulationResult& result);
 
 private:
@@ -16,133 +17,186 @@ private:
     __inline__ __device__ static float calcOpenAngle(Cell* cell, float2 direction);
 
     __inline__ __device__ static bool isConnectedConnected(Cell* cell, Cell* otherCell);
+
+    //the attack multiplier from the weapon penalties; pure reads, no locks
+    __inline__ __device__ static float calcAttackFactor(Cell* cell, Cell* otherCell, unsigned char color, SimulationData& data);
+
+    //atomically claims the attack transfer from the victim: the amount is determined from the
+    //victim's energy at claim time and the claim succeeds only while the victim retains energy
+    //afterwards, so concurrent attackers on the same victim resolve without locks and without
+    //overdrawing; returns the claimed amount (0 if nothing could be claimed)
+    __inline__ __device__ static float claimEnergyFromVictim(Cell* victim, float factor);
+
+    //atomically deducts up to the given amount, clamped at the available energy
+    __inline__ __device__ static float deductEnergy(Cell* cell, float amount);
 };
 
 /************************************************************************/
 /* Implementation                                                       */
 /************************************************************************/
 
+template<bool instrumented>
 __inline__ __device__ void DigestionProcessor::process(Token* token, SimulationData& data, SimulationResult& result)
 {
     auto const& cell = token->cell;
     auto& tokenMem = token->memory;
     tokenMem[Enums::Digestion_Output] = Enums::DigestionOut_NoTarget;
 
-    if (cell->tryLock()) {
-
-        auto color = calcMod(token->memory[Enums::Digestion_InColor], 7);
-
-        Cell* otherCells[18];
-        int numOtherCells;
-        data.cellMap.get(otherCells, 18, numOtherCells, cell->absPos, 1.6f);
-        for (int i = 0; i < numOtherCells; ++i) {
-            Cell* otherCell = otherCells[i];
-            if (otherCell->tryLock()) {
-                if (!isConnectedConnected(cell, otherCell) && !otherCell->barrier) {
-                    auto energyToTransfer = otherCell->energy * cudaSimulationParameters.cellFunctionWeaponStrength + 1.0f;
-
-                    auto cellFunctionWeaponGeometryDeviationExponent =
-                        SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponGeometryDeviationExponent, data, cell->absPos);
-
-                    if (abs(cellFunctionWeaponGeometryDeviationExponent) > FP_PRECISION) {
-                        auto d = otherCell->absPos - cell->absPos;
-                        auto angle1 = calcOpenAngle(cell, d);
-                        auto angle2 = calcOpenAngle(otherCell, d * (-1));
-                        auto deviation = 1.0f - abs(360.0f - (angle1 + angle2)) / 360.0f;  //1 = no deviation, 0 = max deviation
-
-                        energyToTransfer *= powf(max(0.0f, min(1.0f, deviation)), cellFunctionWeaponGeometryDeviationExponent);
-                    }
-
-                    auto otherCellColor = calcMod(otherCell->metadata.color, 7);
-                    if (otherCellColor != color) {
-                        auto cellFunctionWeaponColorTargetMismatchPenalty =
-                            SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponColorTargetMismatchPenalty, data, cell->absPos);
-
-                        energyToTransfer *= (1.0f - cellFunctionWeaponColorTargetMismatchPenalty);
-                    }
-
-                    auto cellFunctionWeaponColorPenalty =
-                        SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponColorDominance, data, cell->absPos);
-
-                    auto homogene = isHomogene(cell);
-                    auto otherHomogene = isHomogene(otherCell);
-                    if (!homogene /* && otherHomogene*/) {
-                        energyToTransfer *= (1.0f - cellFunctionWeaponColorPenalty);
-                    }
-                    auto isColorSuperior = [](unsigned char color1, unsigned char color2) {
-                        color1 = color1 % 7;
-                        color2 = color2 % 7;
-                        if (color1 == color2 + 1 || (color1 == 0 && color2 == 6)) {
-                            return true;
-                        }
-                        return false;
-                    };
-                    if (homogene && otherHomogene && !isColorSuperior(cell->metadata.color, otherCell->metadata.color)) {
-                        energyToTransfer *= (1.0f - cellFunctionWeaponColorPenalty);
-                    }
-
-                    auto cellFunctionWeaponConnectionsMismatchPenalty =
-                        SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponConnectionsMismatchPenalty, data, cell->absPos);
-                    if (otherCell->numConnections > cell->numConnections + 1) {
-                        energyToTransfer *= (1 - cellFunctionWeaponConnectionsMismatchPenalty) * (1 - cellFunctionWeaponConnectionsMismatchPenalty);
-                    }
-                    if (otherCell->numConnections == cell->numConnections + 1) {
-                        energyToTransfer *= (1 - cellFunctionWeaponConnectionsMismatchPenalty);
-                    }
-                    //tag = number of tokens on cell
-                    if (otherCell->tag > 0) {
-                        auto cellFunctionWeaponTokenPenalty =
-                            SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponTokenPenalty, data, cell->absPos);
-                        energyToTransfer *= (1.0f - cellFunctionWeaponTokenPenalty);
-                    }
-
-                    if (energyToTransfer >= 0) {
-                        if (otherCell->energy > energyToTransfer) {
-                            otherCell->energy -= energyToTransfer;
-                            token->energy += energyToTransfer / 2;
-                            cell->energy += energyToTransfer / 2;
-                            if (token->memory[Enums::Digestion_Output] != Enums::DigestionOut_Poisoned) {
-                                token->memory[Enums::Digestion_Output] = Enums::DigestionOut_Success;
-                            }
-                            result.incSuccessfulAttack();
-                        }
-                    } else {
-                        auto cellMinEnergy = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
-
-                        if (token->energy > -energyToTransfer / 2 + cudaSimulationParameters.tokenMinEnergy * 2
-                            && cell->energy > -energyToTransfer / 2 + cellMinEnergy) {
-                            otherCell->energy -= energyToTransfer;
-                            token->energy += energyToTransfer / 2;
-                            cell->energy += energyToTransfer / 2;
-                            token->memory[Enums::Digestion_Output] = Enums::DigestionOut_Poisoned;
-                        }
-                    }
+    //lock-free mutual attack resolution: the attack multiplier is gathered from pure reads and
+    //the energy transfer is then resolved per victim with an atomic claim on its energy, so
+    //attackers facing each other in a feeding wave neither contend on cell locks nor skip their
+    //targets on lock failure
+    auto color = calcMod(token->memory[Enums::Digestion_InColor], 7);
+
+    Cell* otherCells[18];
+    int numOtherCells;
+    data.cellMap.get(otherCells, 18, numOtherCells, cell->absPos, 1.6f);
+    for (int i = 0; i < numOtherCells; ++i) {
+        Cell* otherCell = otherCells[i];
+        if (isConnectedConnected(cell, otherCell) || otherCell->barrier) {
+            continue;
+        }
+        auto factor = calcAttackFactor(cell, otherCell, color, data);
+
+        if (factor >= 0) {
+            auto energyToTransfer = claimEnergyFromVictim(otherCell, factor);
+            if (energyToTransfer > 0) {
+                token->energy += energyToTransfer / 2;
+                atomicAdd(&cell->energy, energyToTransfer / 2);  //the attacker itself can be a victim of a concurrent attack
+                if (token->memory[Enums::Digestion_Output] != Enums::DigestionOut_Poisoned) {
+                    token->memory[Enums::Digestion_Output] = Enums::DigestionOut_Success;
+                }
+                if constexpr (instrumented) {
+                    result.incSuccessfulAttack();
                 }
-                otherCell->releaseLock();
+            }
+        } else {
+            auto cellMinEnergy = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
+
+            auto energyToTransfer = (otherCell->energy * cudaSimulationParameters.cellFunctionWeaponStrength + 1.0f) * factor;
+            if (token->energy > -energyToTransfer / 2 + cudaSimulationParameters.tokenMinEnergy * 2
+                && cell->energy > -energyToTransfer / 2 + cellMinEnergy) {
+                atomicAdd(&otherCell->energy, -energyToTransfer);
+                token->energy += energyToTransfer / 2;
+                atomicAdd(&cell->energy, energyToTransfer / 2);
+                token->memory[Enums::Digestion_Output] = Enums::DigestionOut_Poisoned;
             }
         }
-        if (Enums::DigestionOut_NoTarget == token->memory[Enums::Digestion_Output]) {
+    }
+    if (Enums::DigestionOut_NoTarget == token->memory[Enums::Digestion_Output]) {
+        if constexpr (instrumented) {
             result.incFailedAttack();
         }
-        auto cellFunctionWeaponEnergyCost = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponEnergyCost, data, cell->absPos);
-        if (cellFunctionWeaponEnergyCost > 0) {
-            auto const cellEnergy = cell->energy;
-            auto& pos = cell->absPos;
-            float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
-                + float2{
-                    (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
-                    (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
-            float2 particlePos = pos + Math::normalized(particleVel) * 1.5f;
-            data.cellMap.correctPosition(particlePos);
-
-            particlePos = particlePos - particleVel;  //because particle will still be moved in current time step
-            auto const radiationEnergy = min(cellEnergy, cellFunctionWeaponEnergyCost);
-            cell->energy -= radiationEnergy;
-            EntityFactory factory;
-            factory.init(&data);
-            auto particle = factory.createParticle(radiationEnergy, particlePos, particleVel, {cell->metadata.color});
+    }
+    auto cellFunctionWeaponEnergyCost = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponEnergyCost, data, cell->absPos);
+    if (cellFunctionWeaponEnergyCost > 0) {
+        auto& pos = cell->absPos;
+        float2 particleVel = (cell->vel * cudaSimulationParameters.radiationVelocityMultiplier)
+            + float2{
+                (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation,
+                (data.numberGen1.random() - 0.5f) * cudaSimulationParameters.radiationVelocityPerturbation};
+        float2 particlePos = pos + Math::normalized(particleVel) * 1.5f;
+        data.cellMap.correctPosition(particlePos);
+
+        particlePos = particlePos - particleVel;  //because particle will still be moved in current time step
+        auto const radiationEnergy = deductEnergy(cell, cellFunctionWeaponEnergyCost);
+        EntityFactory factory;
+        factory.init(&data);
+        auto particle = factory.createParticle(radiationEnergy, particlePos, particleVel, {cell->metadata.color});
+    }
+}
+
+__inline__ __device__ float DigestionProcessor::calcAttackFactor(Cell* cell, Cell* otherCell, unsigned char color, SimulationData& data)
+{
+    auto factor = 1.0f;
+
+    auto cellFunctionWeaponGeometryDeviationExponent =
+        SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponGeometryDeviationExponent, data, cell->absPos);
+
+    if (abs(cellFunctionWeaponGeometryDeviationExponent) > FP_PRECISION) {
+        auto d = otherCell->absPos - cell->absPos;
+        auto angle1 = calcOpenAngle(cell, d);
+        auto angle2 = calcOpenAngle(otherCell, d * (-1));
+        auto deviation = 1.0f - abs(360.0f - (angle1 + angle2)) / 360.0f;  //1 = no deviation, 0 = max deviation
+
+        factor *= powf(max(0.0f, min(1.0f, deviation)), cellFunctionWeaponGeometryDeviationExponent);
+    }
+
+    auto otherCellColor = calcMod(otherCell->metadata.color, 7);
+    if (otherCellColor != color) {
+        auto cellFunctionWeaponColorTargetMismatchPenalty =
+            SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponColorTargetMismatchPenalty, data, cell->absPos);
+
+        factor *= (1.0f - cellFunctionWeaponColorTargetMismatchPenalty);
+    }
+
+    auto cellFunctionWeaponColorPenalty =
+        SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponColorDominance, data, cell->absPos);
+
+    auto homogene = isHomogene(cell);
+    auto otherHomogene = isHomogene(otherCell);
+    if (!homogene /* && otherHomogene*/) {
+        factor *= (1.0f - cellFunctionWeaponColorPenalty);
+    }
+    auto isColorSuperior = [](unsigned char color1, unsigned char color2) {
+        color1 = color1 % 7;
+        color2 = color2 % 7;
+        if (color1 == color2 + 1 || (color1 == 0 && color2 == 6)) {
+            return true;
+        }
+        return false;
+    };
+    if (homogene && otherHomogene && !isColorSuperior(cell->metadata.color, otherCell->metadata.color)) {
+        factor *= (1.0f - cellFunctionWeaponColorPenalty);
+    }
+
+    auto cellFunctionWeaponConnectionsMismatchPenalty =
+        SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponConnectionsMismatchPenalty, data, cell->absPos);
+    if (otherCell->numConnections > cell->numConnections + 1) {
+        factor *= (1 - cellFunctionWeaponConnectionsMismatchPenalty) * (1 - cellFunctionWeaponConnectionsMismatchPenalty);
+    }
+    if (otherCell->numConnections == cell->numConnections + 1) {
+        factor *= (1 - cellFunctionWeaponConnectionsMismatchPenalty);
+    }
+    //tag = number of tokens on cell
+    if (otherCell->tag > 0) {
+        auto cellFunctionWeaponTokenPenalty =
+            SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellFunctionWeaponTokenPenalty, data, cell->absPos);
+        factor *= (1.0f - cellFunctionWeaponTokenPenalty);
+    }
+    return factor;
+}
+
+__inline__ __device__ float DigestionProcessor::claimEnergyFromVictim(Cell* victim, float factor)
+{
+    auto address = reinterpret_cast<int*>(&victim->energy);
+    auto old = *address;
+    while (true) {
+        auto victimEnergy = __int_as_float(old);
+        auto energyToTransfer = (victimEnergy * cudaSimulationParameters.cellFunctionWeaponStrength + 1.0f) * factor;
+        if (victimEnergy <= energyToTransfer) {
+            return 0;
+        }
+        auto assumed = old;
+        old = atomicCAS(address, assumed, __float_as_int(victimEnergy - energyToTransfer));
+        if (old == assumed) {
+            return energyToTransfer;
+        }
+    }
+}
+
+__inline__ __device__ float DigestionProcessor::deductEnergy(Cell* cell, float amount)
+{
+    auto address = reinterpret_cast<int*>(&cell->energy);
+    auto old = *address;
+    while (true) {
+        auto energy = __int_as_float(old);
+        auto deducted = min(energy, amount);
+        auto assumed = old;
+        old = atomicCAS(address, assumed, __float_as_int(energy - deducted));
+        if (old == assumed) {
+            return deducted;
         }
-        cell->releaseLock();
     }
 }
 
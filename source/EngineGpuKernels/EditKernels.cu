@@ -19,6 +19,112 @@ __global__ void cudaColorSelectedCells(SimulationData data, unsigned char color,
     }
 }
 
+__global__ void cudaScaleEnergyForSelection(SimulationData data, float factor, bool includeClusters)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if ((0 != cell->selected && includeClusters) || (1 == cell->selected && !includeClusters)) {
+            cell->energy *= factor;
+        }
+    }
+
+    auto const particleBlock = calcAllThreadsPartition(data.entities.particlePointers.getNumEntries());
+    for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
+        auto const& particle = data.entities.particlePointers.at(index);
+        if (0 != particle->selected) {
+            particle->energy *= factor;
+        }
+    }
+}
+
+__global__ void cudaSetBranchNumberForSelection(SimulationData data, int branchNumber, bool includeClusters)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if ((0 != cell->selected && includeClusters) || (1 == cell->selected && !includeClusters)) {
+            cell->branchNumber = branchNumber % cudaSimulationParameters.cellMaxTokenBranchNumber;
+        }
+    }
+}
+
+namespace
+{
+    __device__ bool containsId(uint64_t const* sortedIds, int numIds, uint64_t id)
+    {
+        int low = 0;
+        int high = numIds - 1;
+        while (low <= high) {
+            auto mid = (low + high) / 2;
+            if (sortedIds[mid] == id) {
+                return true;
+            }
+            if (sortedIds[mid] < id) {
+                low = mid + 1;
+            } else {
+                high = mid - 1;
+            }
+        }
+        return false;
+    }
+}
+
+__global__ void cudaApplyEnergyDeltaToIds(SimulationData data, uint64_t* sortedCellIds, int numCellIds, float energyDelta)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if (cell->isDeleted()) {
+            continue;
+        }
+        if (containsId(sortedCellIds, numCellIds, cell->id)) {
+            //never drop to 0, which marks the cell as deleted; an underfed cell decays through
+            //the regular minimum-energy path in the next timestep instead
+            cell->energy = max(cell->energy + energyDelta, 0.01f);
+        }
+    }
+}
+
+__global__ void cudaResetClusterRepresentatives(SimulationData data)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        cell->clusterRepresentative = cell;
+    }
+}
+
+__global__ void cudaFindClusterRepresentativeStep(SimulationData data, int* result)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+
+        auto minTag = reinterpret_cast<unsigned long long>(cell->clusterRepresentative);
+        for (int j = 0; j < cell->numConnections; ++j) {
+            minTag = min(minTag, reinterpret_cast<unsigned long long>(cell->connections[j].cell->clusterRepresentative));
+        }
+        if (minTag < atomicMin(reinterpret_cast<unsigned long long*>(&cell->clusterRepresentative), minTag)) {
+            *result = 1;
+        }
+    }
+}
+
+__global__ void cudaColorizeClusters(SimulationData data, ColorizeClustersData colorizeData)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+
+        //multiplicative hash of the representative address mixed with the seed: uniform within a
+        //cluster, pseudo-random across clusters and invocations
+        auto hash = static_cast<unsigned int>(reinterpret_cast<unsigned long long>(cell->clusterRepresentative) >> 4);
+        hash = (hash ^ colorizeData.seed) * 2654435761u;
+        cell->metadata.color = colorizeData.colorCodes[hash % colorizeData.numColorCodes];
+    }
+}
+
 __global__ void cudaPrepareForUpdate(SimulationData data)
 {
     data.prepareForNextTimestep();
@@ -125,7 +231,7 @@ __global__ void cudaRemoveSelectedCellConnections(SimulationData data, bool incl
                 if ((includeClusters && connectedCell->selected == 0) || (!includeClusters && connectedCell->selected != 1)) {
 
                     if (connectedCell->tryLock()) {
-                        CellConnectionProcessor::delConnections(cell, connectedCell);
+                        CellConnectionProcessor::delConnections(data, cell, connectedCell);
                         --i;
                         connectedCell->releaseLock();
                     } else {
@@ -570,6 +676,39 @@ __global__ void cudaRolloutSelectionStep(SimulationData data, int* result)
     }
 }
 
+__global__ void cudaPrepareClusterSelectionRollout(SimulationData data)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        data.entities.cellPointers.at(index)->tag = 0;
+    }
+}
+
+__global__ void cudaMarkSelectedClusters(SimulationData data)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if (0 != cell->selected) {
+            atomicExch(&cell->clusterRepresentative->tag, 1);
+        }
+    }
+}
+
+__global__ void cudaRolloutClusterSelection(SimulationData data)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if (0 == cell->selected && 1 == cell->clusterRepresentative->tag) {
+            cell->selected = 2;
+        }
+    }
+}
+
 __global__ void cudaApplyForce(SimulationData data, ApplyForceData applyData)
 {
     {
@@ -631,3 +770,639 @@ __global__ void cudaFinalizeSelectionResult(SelectionResult result)
 {
     result.finalize();
 }
+
+namespace
+{
+    __device__ char* cloneStringBytes(SimulationData& data, char* source, int len)
+    {
+        auto result = data.entities.stringBytes.getNewSubarray(len);
+        for (int i = 0; i < len; ++i) {
+            result[i] = source[i];
+        }
+        return result;
+    }
+}
+
+__global__ void cudaMeasureCloneRequirements(SimulationData data, bool includeClusters, int* numCells, int* numParticles, int* numTokens)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        if (isSelected(data.entities.cellPointers.at(index), includeClusters)) {
+            atomicAdd(numCells, 1);
+        }
+    }
+
+    auto const particleBlock = calcAllThreadsPartition(data.entities.particlePointers.getNumEntries());
+    for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
+        if (1 == data.entities.particlePointers.at(index)->selected) {
+            atomicAdd(numParticles, 1);
+        }
+    }
+
+    auto const tokenBlock = calcAllThreadsPartition(data.entities.tokenPointers.getNumEntries());
+    for (int index = tokenBlock.startIndex; index <= tokenBlock.endIndex; ++index) {
+        if (isSelected(data.entities.tokenPointers.at(index)->cell, includeClusters)) {
+            atomicAdd(numTokens, 1);
+        }
+    }
+}
+
+__global__ void cudaTagCellsForCloning(SimulationData data, bool includeClusters, int* numCloneCells)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumOrigEntries());
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if (isSelected(cell, includeClusters)) {
+            cell->tag = atomicAdd(numCloneCells, 1);
+        } else {
+            cell->tag = -1;
+        }
+    }
+}
+
+__global__ void cudaAllocCloneCells(SimulationData data, int* numCloneCells, Cell** cloneCellArray)
+{
+    *cloneCellArray = *numCloneCells > 0 ? data.entities.cells.getNewSubarray(*numCloneCells) : nullptr;
+    if (*numCloneCells > 0) {
+
+        //the cluster labeling is stale after cloning
+        *data.numStructuralChanges = 1;
+    }
+}
+
+__global__ void cudaCloneTaggedCells(SimulationData data, Cell** cloneCellArray, float2 posDelta)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumOrigEntries());
+
+    auto cloneArray = *cloneCellArray;
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if (cell->tag < 0) {
+            continue;
+        }
+        auto clone = cloneArray + cell->tag;
+        *clone = *cell;
+        *data.entities.cellPointers.getNewElement() = clone;
+
+        clone->id = data.numberGen1.createNewId_kernel();
+        clone->absPos = clone->absPos + posDelta;
+        data.cellMap.correctPosition(clone->absPos);
+        clone->locked = 0;
+        clone->clusterRepresentative = clone;
+
+        //rewire the connections to the corresponding clones; connections leaving the selection
+        //are dropped and their angle is added to the following connection as delConnectionOneWay
+        //does (with cluster rollout no connection can leave the selection)
+        auto pendingAngle = 0.0f;
+        auto numKept = 0;
+        for (int i = 0; i < cell->numConnections; ++i) {
+            auto const& connection = cell->connections[i];
+            if (connection.cell->tag >= 0) {
+                clone->connections[numKept].cell = cloneArray + connection.cell->tag;
+                clone->connections[numKept].distance = connection.distance;
+                clone->connections[numKept].angleFromPrevious = connection.angleFromPrevious + pendingAngle;
+                pendingAngle = 0;
+                ++numKept;
+            } else {
+                pendingAngle += connection.angleFromPrevious;
+            }
+        }
+        if (pendingAngle != 0 && numKept > 0) {
+            clone->connections[0].angleFromPrevious += pendingAngle;
+        }
+        clone->numConnections = numKept;
+
+        //the metadata strings are duplicated; the static data block in the genome store is
+        //immutable and therefore shared with the original
+        if (clone->metadata.nameLen > 0) {
+            clone->metadata.name = cloneStringBytes(data, cell->metadata.name, cell->metadata.nameLen);
+        }
+        if (clone->metadata.descriptionLen > 0) {
+            clone->metadata.description = cloneStringBytes(data, cell->metadata.description, cell->metadata.descriptionLen);
+        }
+        if (clone->metadata.sourceCodeLen > 0) {
+            clone->metadata.sourceCode = cloneStringBytes(data, cell->metadata.sourceCode, cell->metadata.sourceCodeLen);
+        }
+
+        //the clone takes over the selection state of the original
+        cell->selected = 0;
+    }
+}
+
+__global__ void cudaCloneTokensOfTaggedCells(SimulationData data, Cell** cloneCellArray)
+{
+    auto const tokenBlock = calcAllThreadsPartition(data.entities.tokenPointers.getNumOrigEntries());
+
+    auto cloneArray = *cloneCellArray;
+    for (int index = tokenBlock.startIndex; index <= tokenBlock.endIndex; ++index) {
+        auto const& token = data.entities.tokenPointers.at(index);
+        if (token->cell->tag < 0) {
+            continue;
+        }
+        auto newToken = data.entities.tokens.getNewElement();
+        *data.entities.tokenPointers.getNewElement() = newToken;
+
+        *newToken = *token;
+        newToken->memory = data.entities.tokenMemories.getNewElement()->bytes;
+        for (int i = 0; i < MAX_TOKEN_MEM_SIZE; ++i) {
+            newToken->memory[i] = token->memory[i];
+        }
+        newToken->cell = cloneArray + token->cell->tag;
+        newToken->sourceCell =
+            token->sourceCell && token->sourceCell->tag >= 0 ? cloneArray + token->sourceCell->tag : newToken->cell;
+    }
+}
+
+__global__ void cudaCloneSelectedParticles(SimulationData data, float2 posDelta)
+{
+    auto const particleBlock = calcAllThreadsPartition(data.entities.particlePointers.getNumOrigEntries());
+
+    EntityFactory factory;
+    factory.init(&data);
+    for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
+        auto const& particle = data.entities.particlePointers.at(index);
+        if (1 != particle->selected) {
+            continue;
+        }
+        auto pos = particle->absPos + posDelta;
+        data.particleMap.correctPosition(pos);
+        auto clone = factory.createParticle(particle->energy, pos, particle->vel, particle->metadata);
+        clone->selected = particle->selected;
+        particle->selected = 0;
+    }
+}
+
+__global__ void cudaAllocReplicatedCells(SimulationData data, int* numCellsPerCopy, int numCopies, Cell** cloneCellArray)
+{
+    *cloneCellArray = *numCellsPerCopy > 0 ? data.entities.cells.getNewSubarray(*numCellsPerCopy * numCopies) : nullptr;
+    if (*numCellsPerCopy > 0) {
+
+        //the cluster labeling is stale after replication
+        *data.numStructuralChanges = 1;
+    }
+}
+
+__global__ void cudaReplicateTaggedCells(
+    SimulationData data,
+    Cell** cloneCellArray,
+    int* numCellsPerCopy,
+    int numCopies,
+    ReplicationTransform* transforms,
+    float2 center)
+{
+    auto const cellBlock = calcAllThreadsPartition(data.entities.cellPointers.getNumOrigEntries());
+
+    auto cloneArray = *cloneCellArray;
+    for (int index = cellBlock.startIndex; index <= cellBlock.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        if (cell->tag < 0) {
+            continue;
+        }
+        auto relPos = cell->absPos - center;
+        for (int copyIndex = 0; copyIndex < numCopies; ++copyIndex) {
+            auto const& transform = transforms[copyIndex];
+            auto copyArray = cloneArray + copyIndex * *numCellsPerCopy;
+            auto clone = copyArray + cell->tag;
+            *clone = *cell;
+            *data.entities.cellPointers.getNewElement() = clone;
+
+            clone->id = data.numberGen1.createNewId_kernel();
+            auto rotatedRelPos = Math::rotateClockwise(relPos, transform.angle);
+            clone->absPos = center + rotatedRelPos + float2{transform.posDeltaX, transform.posDeltaY};
+            data.cellMap.correctPosition(clone->absPos);
+
+            //velocity increment as DataDescription::accelerate applies it
+            auto tangVel = rotatedRelPos;
+            Math::rotateQuarterCounterClockwise(tangVel);
+            clone->vel = cell->vel + float2{transform.velDeltaX, transform.velDeltaY}
+                - tangVel * (transform.angularVelDelta * DEG_TO_RAD);
+
+            clone->locked = 0;
+            clone->clusterRepresentative = clone;
+
+            //the selection is cluster-complete, so every connected neighbor carries a valid tag
+            for (int i = 0; i < cell->numConnections; ++i) {
+                clone->connections[i].cell = copyArray + cell->connections[i].cell->tag;
+            }
+
+            //the copies carry no metadata strings, matching the host-side multiplication
+            clone->metadata.nameLen = 0;
+            clone->metadata.name = nullptr;
+            clone->metadata.descriptionLen = 0;
+            clone->metadata.description = nullptr;
+            clone->metadata.sourceCodeLen = 0;
+            clone->metadata.sourceCode = nullptr;
+        }
+    }
+}
+
+__global__ void cudaReplicateTokensOfTaggedCells(SimulationData data, Cell** cloneCellArray, int* numCellsPerCopy, int numCopies)
+{
+    auto const tokenBlock = calcAllThreadsPartition(data.entities.tokenPointers.getNumOrigEntries());
+
+    auto cloneArray = *cloneCellArray;
+    for (int index = tokenBlock.startIndex; index <= tokenBlock.endIndex; ++index) {
+        auto const& token = data.entities.tokenPointers.at(index);
+        if (token->cell->tag < 0) {
+            continue;
+        }
+        for (int copyIndex = 0; copyIndex < numCopies; ++copyIndex) {
+            auto copyArray = cloneArray + copyIndex * *numCellsPerCopy;
+            auto newToken = data.entities.tokens.getNewElement();
+            *data.entities.tokenPointers.getNewElement() = newToken;
+
+            *newToken = *token;
+            newToken->memory = data.entities.tokenMemories.getNewElement()->bytes;
+            for (int i = 0; i < MAX_TOKEN_MEM_SIZE; ++i) {
+                newToken->memory[i] = token->memory[i];
+            }
+            newToken->cell = copyArray + token->cell->tag;
+            newToken->sourceCell =
+                token->sourceCell && token->sourceCell->tag >= 0 ? copyArray + token->sourceCell->tag : newToken->cell;
+        }
+    }
+}
+
+__global__ void cudaReplicateSelectedParticles(SimulationData data, int numCopies, ReplicationTransform* transforms, float2 center)
+{
+    auto const particleBlock = calcAllThreadsPartition(data.entities.particlePointers.getNumOrigEntries());
+
+    EntityFactory factory;
+    factory.init(&data);
+    for (int index = particleBlock.startIndex; index <= particleBlock.endIndex; ++index) {
+        auto const& particle = data.entities.particlePointers.at(index);
+        if (1 != particle->selected) {
+            continue;
+        }
+        auto relPos = particle->absPos - center;
+        for (int copyIndex = 0; copyIndex < numCopies; ++copyIndex) {
+            auto const& transform = transforms[copyIndex];
+            auto rotatedRelPos = Math::rotateClockwise(relPos, transform.angle);
+            auto pos = center + rotatedRelPos + float2{transform.posDeltaX, transform.posDeltaY};
+            data.particleMap.correctPosition(pos);
+
+            auto tangVel = rotatedRelPos;
+            Math::rotateQuarterCounterClockwise(tangVel);
+            auto vel = particle->vel + float2{transform.velDeltaX, transform.velDeltaY}
+                - tangVel * (transform.angularVelDelta * DEG_TO_RAD);
+
+            auto clone = factory.createParticle(particle->energy, pos, vel, particle->metadata);
+            clone->selected = particle->selected;
+        }
+    }
+}
+
+namespace
+{
+    __inline__ __device__ Cell* createBarrierCell(SimulationData& data, EntityFactory& factory, float2 pos, float energy, int colorCode)
+    {
+        auto cell = factory.createCell();
+        data.cellMap.correctPosition(pos);
+        cell->absPos = pos;
+        cell->vel = {0, 0};
+        cell->energy = energy;
+        cell->maxConnections = 0;
+        cell->numConnections = 0;
+        cell->branchNumber = 0;
+        cell->tokenBlocked = false;
+        cell->cellFunctionType = Enums::CellFunction_Computation;
+        cell->initMemorySizes();
+        char staticData[MAX_CELL_STATIC_BYTES];
+        for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+            staticData[i] = 0;
+        }
+        cell->staticData = data.entities.genomes.getOrInsert(staticData);
+        for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
+            cell->mutableData[i] = 0;
+        }
+        cell->barrier = true;
+        cell->metadata.color = colorCode;
+        cell->selected = 1;
+        return cell;
+    }
+}
+
+__global__ void
+cudaDrawBarrierCells(SimulationData data, float2* stroke, int numVertices, bool paintFirstVertex, float cellDistance, float energy, int colorCode)
+{
+    EntityFactory factory;
+    factory.init(&data);
+
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        *data.numStructuralChanges = 1;
+        if (paintFirstVertex) {
+            createBarrierCell(data, factory, stroke[0], energy, colorCode);
+        }
+    }
+
+    auto const partition = calcAllThreadsPartition(numVertices - 1);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& startPos = stroke[index];
+        auto const& endPos = stroke[index + 1];
+        auto distance = Math::length(endPos - startPos);
+        for (float l = cellDistance; l <= distance; l += cellDistance) {
+            createBarrierCell(data, factory, startPos + (endPos - startPos) * (l / distance), energy, colorCode);
+        }
+    }
+}
+
+namespace
+{
+    __inline__ __device__ int drawColorFromMix(SimulationData& data, WorldGenerationSpec const& spec)
+    {
+        float ratioSum = 0;
+        for (int i = 0; i < 7; ++i) {
+            ratioSum += spec.colorRatios[i];
+        }
+        if (ratioSum <= 0) {
+            return 0;
+        }
+        auto sample = data.numberGen1.random(ratioSum);
+        for (int i = 0; i < 7; ++i) {
+            sample -= spec.colorRatios[i];
+            if (sample <= 0) {
+                return i;
+            }
+        }
+        return 6;
+    }
+}
+
+__global__ void cudaGenerateWorld(SimulationData data, WorldGenerationSpec spec, int numCells, int numParticles, int numBorderCells)
+{
+    EntityFactory factory;
+    factory.init(&data);
+
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        *data.numStructuralChanges = 1;
+    }
+
+    auto const cellPartition = calcAllThreadsPartition(numCells);
+    for (int index = cellPartition.startIndex; index <= cellPartition.endIndex; ++index) {
+        float2 pos{data.numberGen1.random(toFloat(data.worldSize.x)), data.numberGen1.random(toFloat(data.worldSize.y))};
+        data.cellMap.correctPosition(pos);
+        float2 vel{
+            data.numberGen1.random(spec.maxVelocity * 2) - spec.maxVelocity,
+            data.numberGen1.random(spec.maxVelocity * 2) - spec.maxVelocity};
+        auto energy = spec.minCellEnergy + data.numberGen1.random(spec.maxCellEnergy - spec.minCellEnergy);
+        auto cell = factory.createRandomCell(energy, pos, vel);
+        cell->metadata.color = drawColorFromMix(data, spec);
+    }
+
+    auto const particlePartition = calcAllThreadsPartition(numParticles);
+    for (int index = particlePartition.startIndex; index <= particlePartition.endIndex; ++index) {
+        float2 pos{data.numberGen1.random(toFloat(data.worldSize.x)), data.numberGen1.random(toFloat(data.worldSize.y))};
+        data.particleMap.correctPosition(pos);
+        float2 vel{
+            data.numberGen1.random(spec.maxVelocity * 2) - spec.maxVelocity,
+            data.numberGen1.random(spec.maxVelocity * 2) - spec.maxVelocity};
+        factory.createParticle(spec.particleEnergy, pos, vel, {static_cast<unsigned char>(drawColorFromMix(data, spec))});
+    }
+
+    //barrier frame: the index is walked along the world border rectangle, one cell per unit
+    auto const borderPartition = calcAllThreadsPartition(numBorderCells);
+    for (int index = borderPartition.startIndex; index <= borderPartition.endIndex; ++index) {
+        auto const w = data.worldSize.x;
+        auto const h = data.worldSize.y;
+        float2 pos;
+        if (index < w) {
+            pos = {toFloat(index) + 0.5f, 0.5f};
+        } else if (index < w + h) {
+            pos = {toFloat(w) - 0.5f, toFloat(index - w) + 0.5f};
+        } else if (index < 2 * w + h) {
+            pos = {toFloat(2 * w + h - index) - 0.5f, toFloat(h) - 0.5f};
+        } else {
+            pos = {0.5f, toFloat(2 * w + 2 * h - index) - 0.5f};
+        }
+        auto cell = createBarrierCell(data, factory, pos, spec.barrierEnergy, 0);
+        cell->selected = 0;  //unlike the barrier brush, the generated frame does not take over the selection
+    }
+}
+
+namespace
+{
+    __inline__ __device__ void convertRGBtoHSV(uint32_t rgb, float& h, float& s, float& v)
+    {
+        auto r = static_cast<float>((rgb >> 16) & 0xff) / 255;
+        auto g = static_cast<float>((rgb >> 8) & 0xff) / 255;
+        auto b = static_cast<float>(rgb & 0xff) / 255;
+
+        auto k = 0.0f;
+        if (g < b) {
+            auto t = g;
+            g = b;
+            b = t;
+            k = -1.0f;
+        }
+        if (r < g) {
+            auto t = r;
+            r = g;
+            g = t;
+            k = -2.0f / 6.0f - k;
+        }
+        auto chroma = r - (g < b ? g : b);
+        h = fabsf(k + (g - b) / (6.0f * chroma + 1e-20f));
+        s = chroma / (r + 1e-20f);
+        v = r;
+    }
+
+    //same matching metric as the former host-side conversion: hue distance weighted by the pixel
+    //saturation plus the saturation distance; the pixel value becomes the cell energy scale
+    __inline__ __device__ void matchCellColor(uint32_t rgb, int& matchedCellColor, float& matchedCellIntensity)
+    {
+        uint32_t const cellColors[] = {
+            Const::IndividualCellColor1,
+            Const::IndividualCellColor2,
+            Const::IndividualCellColor3,
+            Const::IndividualCellColor4,
+            Const::IndividualCellColor5,
+            Const::IndividualCellColor6,
+            Const::IndividualCellColor7};
+
+        float pixelH, pixelS, pixelV;
+        convertRGBtoHSV(rgb, pixelH, pixelS, pixelV);
+
+        auto bestMatchIndex = 0;
+        auto bestMatchDistance = -1.0f;
+        for (int i = 0; i < 7; ++i) {
+            float h, s, v;
+            convertRGBtoHSV(cellColors[i], h, s, v);
+            auto distance = pixelH - h;
+            if (distance > 0.5f) {
+                distance -= 1.0f;
+            }
+            if (distance < -0.5f) {
+                distance += 1.0f;
+            }
+            distance = fabsf(distance) * pixelS + fabsf(pixelS - s);
+            if (bestMatchDistance < 0 || bestMatchDistance > distance) {
+                bestMatchIndex = i;
+                bestMatchDistance = distance;
+            }
+        }
+        matchedCellColor = bestMatchIndex;
+        matchedCellIntensity = pixelV;
+    }
+
+    //collects the cells on the neighboring lattice pixels in ascending angular order and returns
+    //their number; the pattern rows are offset by half a cell, so the neighborhood is hexagonal:
+    //two neighbors in the same row at distance 1 and two per adjacent row at distance ~1.12
+    __inline__ __device__ int collectLatticeNeighbors(
+        SimulationData& data,
+        Cell** cellGrid,
+        int width,
+        int height,
+        int x,
+        int y,
+        Cell* neighborCells[6],
+        float neighborAngles[6],
+        int neighborX[6],
+        int neighborY[6])
+    {
+        auto rowShift = y % 2 == 0 ? -1 : 0;
+        int const candidateX[] = {x + 1, x - 1, x + rowShift, x + rowShift + 1, x + rowShift, x + rowShift + 1};
+        int const candidateY[] = {y, y, y - 1, y - 1, y + 1, y + 1};
+
+        auto cell = cellGrid[x + y * width];
+        auto numNeighbors = 0;
+        for (int i = 0; i < 6; ++i) {
+            if (candidateX[i] < 0 || candidateX[i] >= width || candidateY[i] < 0 || candidateY[i] >= height) {
+                continue;
+            }
+            auto otherCell = cellGrid[candidateX[i] + candidateY[i] * width];
+            if (!otherCell) {
+                continue;
+            }
+            auto posDelta = data.cellMap.getCorrectedDirection(otherCell->absPos - cell->absPos);
+            auto angle = Math::angleOfVector(posDelta);
+
+            //insertion sort by angle so that angleFromPrevious can be accumulated in one sweep
+            auto insertIndex = numNeighbors;
+            while (insertIndex > 0 && neighborAngles[insertIndex - 1] > angle) {
+                neighborCells[insertIndex] = neighborCells[insertIndex - 1];
+                neighborAngles[insertIndex] = neighborAngles[insertIndex - 1];
+                neighborX[insertIndex] = neighborX[insertIndex - 1];
+                neighborY[insertIndex] = neighborY[insertIndex - 1];
+                --insertIndex;
+            }
+            neighborCells[insertIndex] = otherCell;
+            neighborAngles[insertIndex] = angle;
+            neighborX[insertIndex] = candidateX[i];
+            neighborY[insertIndex] = candidateY[i];
+            ++numNeighbors;
+        }
+        return numNeighbors;
+    }
+}
+
+__global__ void
+cudaConvertImageToPattern(SimulationData data, unsigned char* image, int width, int height, int numChannels, float2 center, Cell** cellGrid)
+{
+    EntityFactory factory;
+    factory.init(&data);
+
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        *data.numStructuralChanges = 1;
+    }
+
+    auto const partition = calcAllThreadsPartition(width * height);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto x = index % width;
+        auto y = index / width;
+        auto address = index * numChannels;
+        int r = image[address];
+        int g = image[address + 1];
+        int b = image[address + 2];
+
+        cellGrid[index] = nullptr;
+        if (r <= 20 && g <= 20 && b <= 20) {
+            continue;
+        }
+        int matchedCellColor;
+        float matchedCellIntensity;
+        matchCellColor((static_cast<uint32_t>(r) << 16) | (static_cast<uint32_t>(g) << 8) | static_cast<uint32_t>(b), matchedCellColor, matchedCellIntensity);
+
+        auto xOffset = y % 2 == 0 ? 0.0f : 0.5f;
+        auto pos = center
+            + float2{static_cast<float>(x) + xOffset - static_cast<float>(width) / 2, static_cast<float>(y) - static_cast<float>(height) / 2};
+        data.cellMap.correctPosition(pos);
+
+        auto cell = factory.createCell();
+        cell->absPos = pos;
+        cell->vel = {0, 0};
+        cell->energy = matchedCellIntensity * 200;
+        cell->maxConnections = cudaSimulationParameters.cellMaxBonds;
+        cell->numConnections = 0;
+        cell->branchNumber = 0;
+        cell->tokenBlocked = false;
+        cell->cellFunctionType = Enums::CellFunction_Computation;
+        cell->initMemorySizes();
+        char staticData[MAX_CELL_STATIC_BYTES];
+        for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+            staticData[i] = 0;
+        }
+        cell->staticData = data.entities.genomes.getOrInsert(staticData);
+        for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
+            cell->mutableData[i] = 0;
+        }
+        cell->barrier = false;
+        cell->metadata.color = matchedCellColor;
+        cell->selected = 1;
+
+        cellGrid[index] = cell;
+    }
+}
+
+__global__ void cudaConnectImagePatternCells(SimulationData data, int width, int height, Cell** cellGrid)
+{
+    auto const partition = calcAllThreadsPartition(width * height);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto cell = cellGrid[index];
+        if (!cell) {
+            continue;
+        }
+        auto x = index % width;
+        auto y = index / width;
+
+        Cell* neighborCells[6];
+        float neighborAngles[6];
+        int neighborX[6], neighborY[6];
+        auto numNeighbors = collectLatticeNeighbors(data, cellGrid, width, height, x, y, neighborCells, neighborAngles, neighborX, neighborY);
+
+        //every thread writes only the connection list of its own cell, so no locking is needed;
+        //when cellMaxBonds < 6 a connection is kept only if it fits on both cells, judged by the
+        //angular neighbor rank that both sides compute identically from the grid - the resulting
+        //lattice stays symmetric
+        Cell* keptCells[6];
+        float keptAngles[6];
+        auto numKept = 0;
+        for (int i = 0; i < numNeighbors; ++i) {
+            if (i >= cell->maxConnections) {
+                continue;
+            }
+            Cell* otherNeighborCells[6];
+            float otherNeighborAngles[6];
+            int otherNeighborX[6], otherNeighborY[6];
+            auto numOtherNeighbors = collectLatticeNeighbors(
+                data, cellGrid, width, height, neighborX[i], neighborY[i], otherNeighborCells, otherNeighborAngles, otherNeighborX, otherNeighborY);
+            auto rank = 0;
+            while (rank < numOtherNeighbors && otherNeighborCells[rank] != cell) {
+                ++rank;
+            }
+            if (rank >= neighborCells[i]->maxConnections) {
+                continue;
+            }
+            keptCells[numKept] = neighborCells[i];
+            keptAngles[numKept] = neighborAngles[i];
+            ++numKept;
+        }
+
+        cell->numConnections = numKept;
+        for (int i = 0; i < numKept; ++i) {
+            cell->connections[i].cell = keptCells[i];
+            cell->connections[i].distance = Math::length(data.cellMap.getCorrectedDirection(keptCells[i]->absPos - cell->absPos));
+            auto prevAngle = i > 0 ? keptAngles[i - 1] : keptAngles[numKept - 1] - 360.0f;
+            cell->connections[i].angleFromPrevious = keptAngles[i] - prevAngle;
+        }
+    }
+}
@@ -3,6 +3,8 @@
 #include "EngineInterface/Colors.h"
 #include "EngineInterface/SimulationParameters.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/ReplicationTransform.h"
+#include "EngineInterface/WorldGenerationSpec.h"
 
 #include "cuda_runtime_api.h"
 #include "sm_60_atomic_functions.h"
@@ -19,6 +21,15 @@
 #include "SimulationData.cuh"
 
 __global__ void cudaColorSelectedCells(SimulationData data, unsigned char color, bool includeClusters);
+__global__ void cudaScaleEnergyForSelection(SimulationData data, float factor, bool includeClusters);
+__global__ void cudaSetBranchNumberForSelection(SimulationData data, int branchNumber, bool includeClusters);
+__global__ void cudaApplyEnergyDeltaToIds(SimulationData data, uint64_t* sortedCellIds, int numCellIds, float energyDelta);
+
+//per-cluster colorization over the whole world: the representatives must be exact, see
+//_EditKernelsLauncher::colorizeClusters
+__global__ void cudaResetClusterRepresentatives(SimulationData data);
+__global__ void cudaFindClusterRepresentativeStep(SimulationData data, int* result);
+__global__ void cudaColorizeClusters(SimulationData data, ColorizeClustersData colorizeData);
 __global__ void cudaPrepareForUpdate(SimulationData data);
 __global__ void cudaChangeCell(SimulationData data, DataAccessTO changeDataTO);  //assumes that *changeDataTO.numCells == 1
 __global__ void cudaChangeParticle(SimulationData data, DataAccessTO changeDataTO); //assumes that *changeDataTO.numParticles == 1
@@ -43,7 +54,54 @@ __global__ void cudaSetSelection(AreaSelectionData selectionData, SimulationData
 __global__ void cudaRemoveSelection(SimulationData data, bool onlyClusterSelection);
 __global__ void cudaSwapSelection(float2 pos, float radius, SimulationData data);
 __global__ void cudaRolloutSelectionStep(SimulationData data, int* result);
+
+//iteration-free selection rollout via the cluster representatives; only valid while no
+//structural change has occurred since the last cluster relabeling
+__global__ void cudaPrepareClusterSelectionRollout(SimulationData data);
+__global__ void cudaMarkSelectedClusters(SimulationData data);
+__global__ void cudaRolloutClusterSelection(SimulationData data);
 __global__ void cudaApplyForce(SimulationData data, ApplyForceData applyData);
 __global__ void cudaResetSelectionResult(SelectionResult result);
 __global__ void cudaGetSelectionShallowData(SimulationData data, SelectionResult result);
 __global__ void cudaFinalizeSelectionResult(SelectionResult result);
+
+//device-side cloning of the selected entities with fresh ids and offset positions; the caller
+//must save the array sizes beforehand (the clone kernels iterate over the original entries only)
+__global__ void cudaMeasureCloneRequirements(SimulationData data, bool includeClusters, int* numCells, int* numParticles, int* numTokens);
+__global__ void cudaTagCellsForCloning(SimulationData data, bool includeClusters, int* numCloneCells);
+__global__ void cudaAllocCloneCells(SimulationData data, int* numCloneCells, Cell** cloneCellArray);
+__global__ void cudaCloneTaggedCells(SimulationData data, Cell** cloneCellArray, float2 posDelta);
+__global__ void cudaCloneTokensOfTaggedCells(SimulationData data, Cell** cloneCellArray);
+__global__ void cudaCloneSelectedParticles(SimulationData data, float2 posDelta);
+
+//N-way replication for the multiplier: stamps one transformed copy of the tagged cells per
+//transform; assumes a cluster-complete selection, so no connection leaves the tagged set
+__global__ void cudaAllocReplicatedCells(SimulationData data, int* numCellsPerCopy, int numCopies, Cell** cloneCellArray);
+__global__ void cudaReplicateTaggedCells(
+    SimulationData data,
+    Cell** cloneCellArray,
+    int* numCellsPerCopy,
+    int numCopies,
+    ReplicationTransform* transforms,
+    float2 center);
+__global__ void cudaReplicateTokensOfTaggedCells(SimulationData data, Cell** cloneCellArray, int* numCellsPerCopy, int numCopies);
+__global__ void cudaReplicateSelectedParticles(SimulationData data, int numCopies, ReplicationTransform* transforms, float2 center);
+
+//barrier brush: instantiates unconnected barrier cells along the stroke polyline at the given
+//spacing; the first vertex is only painted on request so that stroke continuations do not
+//duplicate the cell at their starting point
+__global__ void
+cudaDrawBarrierCells(SimulationData data, float2* stroke, int numVertices, bool paintFirstVertex, float cellDistance, float energy, int colorCode);
+
+//procedural world seeding: instantiates the given numbers of random unconnected cells and energy
+//particles at uniformly distributed positions, drawing energies, velocities and colors from the
+//spec; optionally paints a barrier frame along the world border. The counts are passed in so that
+//the host can size the arrays with the same values beforehand
+__global__ void cudaGenerateWorld(SimulationData data, WorldGenerationSpec spec, int numCells, int numParticles, int numBorderCells);
+
+//image-to-pattern conversion: instantiates one cell per sufficiently bright pixel with the closest
+//matching individual cell color; cellGrid holds one slot per pixel so that the connection pass can
+//look up its lattice neighbors without any spatial search
+__global__ void
+cudaConvertImageToPattern(SimulationData data, unsigned char* image, int width, int height, int numChannels, float2 center, Cell** cellGrid);
+__global__ void cudaConnectImagePatternCells(SimulationData data, int width, int height, Cell** cellGrid);
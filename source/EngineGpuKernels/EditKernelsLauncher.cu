@@ -1,8 +1,11 @@
 ﻿#include "EditKernelsLauncher.cuh"
 
+#include <algorithm>
+
 #include "DataAccessKernels.cuh"
 #include "EditKernels.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
+#include "SimulationKernels.cuh"
 
 _EditKernelsLauncher::_EditKernelsLauncher()
 {
@@ -13,6 +16,10 @@ _EditKernelsLauncher::_EditKernelsLauncher()
     CudaMemoryManager::getInstance().acquireMemory<float2>(1, _cudaCenter);
     CudaMemoryManager::getInstance().acquireMemory<float2>(1, _cudaVelocity);
     CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaNumEntities);
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaNumCloneCells);
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaNumCloneParticles);
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, _cudaNumCloneTokens);
+    CudaMemoryManager::getInstance().acquireMemory<Cell*>(1, _cudaCloneCellArray);
     _garbageCollector = std::make_shared<_GarbageCollectorKernelsLauncher>();
 }
 
@@ -25,6 +32,10 @@ _EditKernelsLauncher::~_EditKernelsLauncher()
     CudaMemoryManager::getInstance().freeMemory(_cudaCenter);
     CudaMemoryManager::getInstance().freeMemory(_cudaVelocity);
     CudaMemoryManager::getInstance().freeMemory(_cudaNumEntities);
+    CudaMemoryManager::getInstance().freeMemory(_cudaNumCloneCells);
+    CudaMemoryManager::getInstance().freeMemory(_cudaNumCloneParticles);
+    CudaMemoryManager::getInstance().freeMemory(_cudaNumCloneTokens);
+    CudaMemoryManager::getInstance().freeMemory(_cudaCloneCellArray);
 }
 
 void _EditKernelsLauncher::removeSelection(GpuSettings const& gpuSettings, SimulationData const& data)
@@ -76,7 +87,8 @@ void _EditKernelsLauncher::shallowUpdateSelectedEntities(
     SimulationData const& data,
     ShallowUpdateSelectionData const& updateData)
 {
-    bool reconnectionRequired = !updateData.considerClusters && (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.angleDelta != 0);
+    bool reconnectionRequired = !updateData.deferReconnection && !updateData.considerClusters
+        && (updateData.posDeltaX != 0 || updateData.posDeltaY != 0 || updateData.angleDelta != 0);
 
     //disconnect selection in case of reconnection
     if (reconnectionRequired) {
@@ -242,6 +254,61 @@ void _EditKernelsLauncher::colorSelectedCells(GpuSettings const& gpuSettings, Si
     KERNEL_CALL(cudaColorSelectedCells, data, color, includeClusters);
 }
 
+void _EditKernelsLauncher::scaleEnergyForSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data, float factor, bool includeClusters)
+{
+    KERNEL_CALL(cudaScaleEnergyForSelection, data, factor, includeClusters);
+}
+
+void _EditKernelsLauncher::setBranchNumberForSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data, int branchNumber, bool includeClusters)
+{
+    KERNEL_CALL(cudaSetBranchNumberForSelection, data, branchNumber, includeClusters);
+}
+
+void _EditKernelsLauncher::applyEnergyDeltaToCells(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    std::vector<uint64_t> const& cellIds,
+    float energyDelta)
+{
+    auto numIds = static_cast<int>(cellIds.size());
+    if (0 == numIds) {
+        return;
+    }
+
+    //the kernel matches by binary search, so the id list is uploaded in sorted order
+    auto sortedIds = cellIds;
+    std::sort(sortedIds.begin(), sortedIds.end());
+
+    uint64_t* cudaCellIds;
+    CudaMemoryManager::getInstance().acquireMemory<uint64_t>(numIds, cudaCellIds);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(cudaCellIds, sortedIds.data(), sizeof(uint64_t) * numIds, cudaMemcpyHostToDevice));
+
+    KERNEL_CALL(cudaApplyEnergyDeltaToIds, data, cudaCellIds, numIds, energyDelta);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    CudaMemoryManager::getInstance().freeMemory(cudaCellIds);
+}
+
+void _EditKernelsLauncher::colorizeClusters(GpuSettings const& gpuSettings, SimulationData const& data, ColorizeClustersData const& colorizeData)
+{
+    //the coloring must be uniform per cluster and therefore needs exact representatives; after a
+    //structural change they are re-derived to fixpoint (the relabeling iterations of the timestep
+    //only provide an approximation) and are exact afterwards, so the pending-change counter can
+    //be cleared
+    if (0 != copyToHost(data.numStructuralChanges)) {
+        KERNEL_CALL(cudaResetClusterRepresentatives, data);
+        do {
+            setValueToDevice(_cudaRolloutResult, 0);
+            KERNEL_CALL(cudaFindClusterRepresentativeStep, data, _cudaRolloutResult);
+            cudaDeviceSynchronize();
+
+        } while (1 == copyToHost(_cudaRolloutResult));
+        setValueToDevice(data.numStructuralChanges, 0);
+    }
+    KERNEL_CALL(cudaColorizeClusters, data, colorizeData);
+}
+
 void _EditKernelsLauncher::applyForce(GpuSettings const& gpuSettings, SimulationData const& data, ApplyForceData const& applyData)
 {
     KERNEL_CALL(cudaApplyForce, data, applyData);
@@ -249,6 +316,17 @@ void _EditKernelsLauncher::applyForce(GpuSettings const& gpuSettings, Simulation
 
 void _EditKernelsLauncher::rolloutSelection(GpuSettings const& gpuSettings, SimulationData const& data)
 {
+    //fast path: while the cluster representatives are up to date the rollout needs no fixpoint
+    //iteration and no per-iteration host synchronization - the selection is marked on the
+    //representatives and distributed to their clusters in three passes
+    if (0 == copyToHost(data.numStructuralChanges)) {
+        KERNEL_CALL(cudaPrepareClusterSelectionRollout, data);
+        KERNEL_CALL(cudaMarkSelectedClusters, data);
+        KERNEL_CALL(cudaRolloutClusterSelection, data);
+        return;
+    }
+
+    //fallback after structural changes: propagate along the connections to fixpoint
     do {
         setValueToDevice(_cudaRolloutResult, 0);
         KERNEL_CALL(cudaRolloutSelectionStep, data, _cudaRolloutResult);
@@ -256,3 +334,141 @@ void _EditKernelsLauncher::rolloutSelection(GpuSettings const& gpuSettings, Simu
 
     } while (1 == copyToHost(_cudaRolloutResult));
 }
+
+ArraySizes _EditKernelsLauncher::measureCloneRequirements(GpuSettings const& gpuSettings, SimulationData const& data, bool includeClusters)
+{
+    setValueToDevice(_cudaNumCloneCells, 0);
+    setValueToDevice(_cudaNumCloneParticles, 0);
+    setValueToDevice(_cudaNumCloneTokens, 0);
+    KERNEL_CALL(cudaMeasureCloneRequirements, data, includeClusters, _cudaNumCloneCells, _cudaNumCloneParticles, _cudaNumCloneTokens);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    return {copyToHost(_cudaNumCloneCells), copyToHost(_cudaNumCloneParticles), copyToHost(_cudaNumCloneTokens)};
+}
+
+void _EditKernelsLauncher::cloneSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data, float2 const& posDelta, bool includeClusters)
+{
+    KERNEL_CALL_1_1(cudaSaveNumEntries, data);
+
+    setValueToDevice(_cudaNumCloneCells, 0);
+    KERNEL_CALL(cudaTagCellsForCloning, data, includeClusters, _cudaNumCloneCells);
+    KERNEL_CALL_1_1(cudaAllocCloneCells, data, _cudaNumCloneCells, _cudaCloneCellArray);
+    KERNEL_CALL(cudaCloneTaggedCells, data, _cudaCloneCellArray, posDelta);
+    KERNEL_CALL(cudaCloneTokensOfTaggedCells, data, _cudaCloneCellArray);
+    KERNEL_CALL(cudaCloneSelectedParticles, data, posDelta);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    _garbageCollector->cleanupAfterDataManipulation(gpuSettings, data);
+
+    KERNEL_CALL(cudaClearDensityMap, data);
+    KERNEL_CALL(cudaFillDensityMap, data);
+}
+
+void _EditKernelsLauncher::replicateSelectedEntities(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    std::vector<ReplicationTransform> const& transforms,
+    float2 const& center)
+{
+    auto numCopies = static_cast<int>(transforms.size());
+    if (0 == numCopies) {
+        return;
+    }
+    ReplicationTransform* cudaTransforms;
+    CudaMemoryManager::getInstance().acquireMemory<ReplicationTransform>(numCopies, cudaTransforms);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(cudaTransforms, transforms.data(), sizeof(ReplicationTransform) * numCopies, cudaMemcpyHostToDevice));
+
+    KERNEL_CALL_1_1(cudaSaveNumEntries, data);
+
+    setValueToDevice(_cudaNumCloneCells, 0);
+    KERNEL_CALL(cudaTagCellsForCloning, data, true, _cudaNumCloneCells);
+    KERNEL_CALL_1_1(cudaAllocReplicatedCells, data, _cudaNumCloneCells, numCopies, _cudaCloneCellArray);
+    KERNEL_CALL(cudaReplicateTaggedCells, data, _cudaCloneCellArray, _cudaNumCloneCells, numCopies, cudaTransforms, center);
+    KERNEL_CALL(cudaReplicateTokensOfTaggedCells, data, _cudaCloneCellArray, _cudaNumCloneCells, numCopies);
+    KERNEL_CALL(cudaReplicateSelectedParticles, data, numCopies, cudaTransforms, center);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    CudaMemoryManager::getInstance().freeMemory(cudaTransforms);
+
+    _garbageCollector->cleanupAfterDataManipulation(gpuSettings, data);
+
+    KERNEL_CALL(cudaClearDensityMap, data);
+    KERNEL_CALL(cudaFillDensityMap, data);
+}
+
+void _EditKernelsLauncher::drawBarrier(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    std::vector<float2> const& stroke,
+    bool paintFirstVertex,
+    float cellDistance,
+    float energy,
+    int colorCode)
+{
+    auto numVertices = static_cast<int>(stroke.size());
+    if (0 == numVertices) {
+        return;
+    }
+    float2* cudaStroke;
+    CudaMemoryManager::getInstance().acquireMemory<float2>(numVertices, cudaStroke);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(cudaStroke, stroke.data(), sizeof(float2) * numVertices, cudaMemcpyHostToDevice));
+
+    KERNEL_CALL(cudaDrawBarrierCells, data, cudaStroke, numVertices, paintFirstVertex, cellDistance, energy, colorCode);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    CudaMemoryManager::getInstance().freeMemory(cudaStroke);
+
+    KERNEL_CALL(cudaClearDensityMap, data);
+    KERNEL_CALL(cudaFillDensityMap, data);
+}
+
+void _EditKernelsLauncher::generateWorld(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    WorldGenerationSpec const& spec,
+    int numCells,
+    int numParticles,
+    int numBorderCells)
+{
+    KERNEL_CALL(cudaGenerateWorld, data, spec, numCells, numParticles, numBorderCells);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    KERNEL_CALL(cudaClearDensityMap, data);
+    KERNEL_CALL(cudaFillDensityMap, data);
+}
+
+void _EditKernelsLauncher::convertImageToPattern(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    std::vector<unsigned char> const& imageData,
+    int width,
+    int height,
+    int numChannels,
+    float2 const& center)
+{
+    auto numPixels = width * height;
+    if (0 == numPixels) {
+        return;
+    }
+    unsigned char* cudaImage;
+    CudaMemoryManager::getInstance().acquireMemory<unsigned char>(imageData.size(), cudaImage);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(cudaImage, imageData.data(), imageData.size(), cudaMemcpyHostToDevice));
+    Cell** cudaCellGrid;
+    CudaMemoryManager::getInstance().acquireMemory<Cell*>(numPixels, cudaCellGrid);
+
+    KERNEL_CALL(cudaConvertImageToPattern, data, cudaImage, width, height, numChannels, center, cudaCellGrid);
+    KERNEL_CALL(cudaConnectImagePatternCells, data, width, height, cudaCellGrid);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    CudaMemoryManager::getInstance().freeMemory(cudaImage);
+    CudaMemoryManager::getInstance().freeMemory(cudaCellGrid);
+
+    KERNEL_CALL(cudaClearDensityMap, data);
+    KERNEL_CALL(cudaFillDensityMap, data);
+}
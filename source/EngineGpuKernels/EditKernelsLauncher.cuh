@@ -1,7 +1,11 @@
 ﻿#pragma once
 
+#include <vector>
+
 #include "EngineInterface/GpuSettings.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/ReplicationTransform.h"
+#include "EngineInterface/WorldGenerationSpec.h"
 
 #include "Base.cuh"
 #include "Definitions.cuh"
@@ -32,11 +36,62 @@ public:
     void reconnectSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data);
     void changeSimulationData(GpuSettings const& gpuSettings, SimulationData const& data, DataAccessTO const& changeDataTO);
     void colorSelectedCells(GpuSettings const& gpuSettings, SimulationData const& data, unsigned char color, bool includeClusters);
+    void scaleEnergyForSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data, float factor, bool includeClusters);
+    void setBranchNumberForSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data, int branchNumber, bool includeClusters);
+
+    //adds the delta to the energy of every cell whose id appears in the list; batch primitive for
+    //automation clients, so one call covers an arbitrarily large id set
+    void applyEnergyDeltaToCells(GpuSettings const& gpuSettings, SimulationData const& data, std::vector<uint64_t> const& cellIds, float energyDelta);
+
+    //recolors every cluster with a random color from the given palette entirely on the GPU
+    void colorizeClusters(GpuSettings const& gpuSettings, SimulationData const& data, ColorizeClustersData const& colorizeData);
 
     void applyForce(GpuSettings const& gpuSettings, SimulationData const& data, ApplyForceData const& applyData);
 
     void rolloutSelection(GpuSettings const& gpuSettings, SimulationData const& data);
 
+    //on-GPU duplication of the selected entities with fresh ids and offset positions; the caller
+    //must grow the arrays by the measured amounts before cloning
+    ArraySizes measureCloneRequirements(GpuSettings const& gpuSettings, SimulationData const& data, bool includeClusters);
+    void cloneSelectedEntities(GpuSettings const& gpuSettings, SimulationData const& data, float2 const& posDelta, bool includeClusters);
+
+    //stamps one transformed copy of the selected entities per transform; requires a
+    //cluster-complete selection
+    void replicateSelectedEntities(
+        GpuSettings const& gpuSettings,
+        SimulationData const& data,
+        std::vector<ReplicationTransform> const& transforms,
+        float2 const& center);
+    void drawBarrier(
+        GpuSettings const& gpuSettings,
+        SimulationData const& data,
+        std::vector<float2> const& stroke,
+        bool paintFirstVertex,
+        float cellDistance,
+        float energy,
+        int colorCode);
+
+    //seeds the world with randomly distributed cells and energy particles drawn from the spec,
+    //entirely on the GPU; the counts must match the values the arrays were sized with
+    void generateWorld(
+        GpuSettings const& gpuSettings,
+        SimulationData const& data,
+        WorldGenerationSpec const& spec,
+        int numCells,
+        int numParticles,
+        int numBorderCells);
+
+    //instantiates one cell per sufficiently bright image pixel and connects the resulting
+    //lattice, entirely on the GPU; the image is uploaded once instead of a per-cell description
+    void convertImageToPattern(
+        GpuSettings const& gpuSettings,
+        SimulationData const& data,
+        std::vector<unsigned char> const& imageData,
+        int width,
+        int height,
+        int numChannels,
+        float2 const& center);
+
 private:
     GarbageCollectorKernelsLauncher _garbageCollector;
 
@@ -48,4 +103,8 @@ private:
     float2* _cudaCenter;
     float2* _cudaVelocity;
     int* _cudaNumEntities;
+    int* _cudaNumCloneCells;
+    int* _cudaNumCloneParticles;
+    int* _cudaNumCloneTokens;
+    Cell** _cudaCloneCellArray;
 };
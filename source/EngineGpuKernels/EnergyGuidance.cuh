@@ -11,61 +11,70 @@ class EnergyGuidance
 public:
     static __inline__ __device__ void processing(SimulationData& data, Token * token)
     {
-        auto cell = token->cell;
         uint8_t cmd = token->memory[Enums::EnergyGuidance_Input] % static_cast<int>(Enums::EnergyGuidanceIn_Count);
+        if (Enums::EnergyGuidanceIn_Deactivated == cmd) {
+            return;
+        }
+
+        auto cell = token->cell;
         float valueCell = static_cast<uint8_t>(token->memory[Enums::EnergyGuidance_InValueCell]);
         float valueToken = static_cast<uint8_t>(token->memory[Enums::EnergyGuidance_InValueToken]);
         const float amount = 10.0;
 
         auto cellMinEnergy = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
 
-        if (Enums::EnergyGuidanceIn_Deactivated == cmd) {
-            return;
-        }
+        //the balancing works on register copies with a single write-back at the end; the branch-wise
+        //read-modify-writes on the original fields would each go through global memory since the
+        //compiler cannot prove that the cell and token energies do not alias
+        auto cellEnergy = cell->energy;
+        auto tokenEnergy = token->energy;
 
         if (Enums::EnergyGuidanceIn_BalanceCell == cmd) {
-            if (cell->energy > (cellMinEnergy + valueCell + amount)) {
-                cell->energy -= amount;
-                token->energy += amount;
+            if (cellEnergy > (cellMinEnergy + valueCell + amount)) {
+                cellEnergy -= amount;
+                tokenEnergy += amount;
             }
-            else if (token->energy > (cudaSimulationParameters.tokenMinEnergy + valueToken + amount)) {
-                cell->energy += amount;
-                token->energy -= amount;
+            else if (tokenEnergy > (cudaSimulationParameters.tokenMinEnergy + valueToken + amount)) {
+                cellEnergy += amount;
+                tokenEnergy -= amount;
             }
         }
         if (Enums::EnergyGuidanceIn_BalanceToken == cmd) {
-            if (token->energy > (cudaSimulationParameters.tokenMinEnergy + valueToken + amount)) {
-                cell->energy += amount;
-                token->energy -= amount;
-            } else if (cell->energy > (cellMinEnergy + valueCell + amount)) {
-                cell->energy -= amount;
-                token->energy += amount;
+            if (tokenEnergy > (cudaSimulationParameters.tokenMinEnergy + valueToken + amount)) {
+                cellEnergy += amount;
+                tokenEnergy -= amount;
+            } else if (cellEnergy > (cellMinEnergy + valueCell + amount)) {
+                cellEnergy -= amount;
+                tokenEnergy += amount;
             }
         }
         if (Enums::EnergyGuidanceIn_BalanceBoth == cmd) {
-            if (token->energy > cudaSimulationParameters.tokenMinEnergy + valueToken + amount
-                && cell->energy < cellMinEnergy + valueCell) {
-                cell->energy += amount;
-                token->energy -= amount;
+            if (tokenEnergy > cudaSimulationParameters.tokenMinEnergy + valueToken + amount
+                && cellEnergy < cellMinEnergy + valueCell) {
+                cellEnergy += amount;
+                tokenEnergy -= amount;
             }
-            if (token->energy < cudaSimulationParameters.tokenMinEnergy + valueToken
-                && cell->energy > cellMinEnergy + valueCell + amount) {
-                cell->energy -= amount;
-                token->energy += amount;
+            if (tokenEnergy < cudaSimulationParameters.tokenMinEnergy + valueToken
+                && cellEnergy > cellMinEnergy + valueCell + amount) {
+                cellEnergy -= amount;
+                tokenEnergy += amount;
             }
         }
         if (Enums::EnergyGuidanceIn_HarvestCell == cmd) {
-            if (cell->energy > cellMinEnergy + valueCell + amount) {
-                cell->energy -= amount;
-                token->energy += amount;
+            if (cellEnergy > cellMinEnergy + valueCell + amount) {
+                cellEnergy -= amount;
+                tokenEnergy += amount;
             }
         }
         if (Enums::EnergyGuidanceIn_HarvestToken == cmd) {
-            if (token->energy > cudaSimulationParameters.tokenMinEnergy + valueToken + amount) {
-                cell->energy += amount;
-                token->energy -= amount;
+            if (tokenEnergy > cudaSimulationParameters.tokenMinEnergy + valueToken + amount) {
+                cellEnergy += amount;
+                tokenEnergy -= amount;
             }
         }
+
+        cell->energy = cellEnergy;
+        token->energy = tokenEnergy;
     }
 
 };
\ No newline at end of file
@@ -10,10 +10,12 @@ void Entities::init()
     cells.init();
     tokenPointers.init();
     tokens.init();
+    tokenMemories.init();
     particles.init();
     particlePointers.init();
     stringBytes.init();
     stringBytes.resize(MAX_STRING_BYTES);
+    genomes.init(MAX_GENOME_BYTES);
 }
 
 void Entities::free()
@@ -22,7 +24,9 @@ void Entities::free()
     cells.free();
     tokenPointers.free();
     tokens.free();
+    tokenMemories.free();
     particles.free();
     particlePointers.free();
     stringBytes.free();
+    genomes.free();
 }
@@ -4,6 +4,7 @@
 
 #include "Base.cuh"
 #include "Definitions.cuh"
+#include "GenomeStore.cuh"
 #include "RawMemory.cuh"
 
 struct Entities
@@ -14,9 +15,11 @@ struct Entities
 
     Array<Cell> cells;
     Array<Token> tokens;
+    Array<TokenMemory> tokenMemories;
     Array<Particle> particles;
 
     RawMemory stringBytes;
+    GenomeStore genomes;
 
     void init();
     void free();
@@ -28,6 +31,7 @@ struct Entities
         particlePointers.saveNumEntries();
         cells.saveNumEntries();
         tokens.saveNumEntries();
+        tokenMemories.saveNumEntries();
         particles.saveNumEntries();
     }
 };
@@ -70,6 +70,7 @@ EntityFactory::createCellFromTO(int targetIndex, CellAccessTO const& cellTO, Cel
     *cellPointer = cell;
 
     cell->id = createIds ? _data->numberGen1.createNewId_kernel() : cellTO.id;
+    cell->ancestorId = cell->id;  //uploaded cells found their own lineage; ancestry is not part of the transfer format
     cell->absPos = cellTO.pos;
     _map.correctPosition(cell->absPos);
     cell->vel = cellTO.vel;
@@ -87,9 +88,7 @@ EntityFactory::createCellFromTO(int targetIndex, CellAccessTO const& cellTO, Cel
     cell->cellFunctionType = cellTO.cellFunctionType;
     cell->numStaticBytes = cellTO.numStaticBytes;
     cell->numMutableBytes = cellTO.numMutableBytes;
-    for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-        cell->staticData[i] = cellTO.staticData[i];
-    }
+    cell->staticData = _data->entities.genomes.getOrInsert(cellTO.staticData);
     for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
         cell->mutableData[i] = cellTO.mutableData[i];
     }
@@ -120,7 +119,7 @@ EntityFactory::createCellFromTO(int targetIndex, CellAccessTO const& cellTO, Cel
 
     cell->selected = 0;
     cell->locked = 0;
-    cell->temp3 = {0, 0};
+    cell->clusterRepresentative = cell;
 
     return cell;
 }
@@ -148,14 +147,16 @@ __inline__ __device__ void EntityFactory::changeCellFromTO(
         cell->numStaticBytes = 0;
         cell->numMutableBytes = 5;
     } break;
+    case Enums::CellFunction_Communication: {
+        cell->numStaticBytes = 0;
+        cell->numMutableBytes = 5;
+    } break;
     default: {
         cell->numStaticBytes = 0;
         cell->numMutableBytes = 0;
     }
     }
-    for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-        cell->staticData[i] = cellTO.staticData[i];
-    }
+    cell->staticData = _data->entities.genomes.getOrInsert(cellTO.staticData);
     for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
         cell->mutableData[i] = cellTO.mutableData[i];
     }
@@ -190,6 +191,7 @@ __inline__ __device__ Token* EntityFactory::createTokenFromTO(TokenAccessTO cons
     *tokenPointer = token;
 
     token->energy = tokenTO.energy;
+    token->memory = _data->entities.tokenMemories.getNewElement()->bytes;
     for (int i = 0; i < cudaSimulationParameters.tokenMemorySize; ++i) {
         token->memory[i] = tokenTO.memory[i];
     }
@@ -240,6 +242,7 @@ __inline__ __device__ Cell* EntityFactory::createRandomCell(float energy, float2
     *cellPointers = cell;
 
     cell->id = _data->numberGen1.createNewId_kernel();
+    cell->ancestorId = cell->id;
     cell->absPos = pos;
     cell->vel = vel;
     cell->energy = energy;
@@ -249,7 +252,6 @@ __inline__ __device__ Cell* EntityFactory::createRandomCell(float energy, float2
     cell->tokenBlocked = false;
     cell->locked = 0;
     cell->selected = 0;
-    cell->temp3 = {0, 0};
     cell->metadata.color = 0;
     cell->metadata.nameLen = 0;
     cell->metadata.descriptionLen = 0;
@@ -257,13 +259,17 @@ __inline__ __device__ Cell* EntityFactory::createRandomCell(float energy, float2
     cell->barrier = false;
     cell->cellFunctionType = _data->numberGen1.random(Enums::CellFunction_Count - 1);
     cell->initMemorySizes();
+    char staticData[MAX_CELL_STATIC_BYTES];
     for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
-        cell->staticData[i] = _data->numberGen1.random(255);
+        staticData[i] = _data->numberGen1.random(255);
     }
+    cell->staticData = _data->entities.genomes.getOrInsert(staticData);
     for (int i = 0; i < MAX_CELL_MUTABLE_BYTES; ++i) {
         cell->mutableData[i] = _data->numberGen1.random(255);
     }
     cell->cellFunctionInvocations = 0;
+    cell->clusterRepresentative = cell;
+    _data->logCellEvent(CellEvent::Type_CellBirth, cell->id, cell->absPos, cell->metadata.color);
     return cell;
 }
 
@@ -274,14 +280,15 @@ __inline__ __device__ Cell* EntityFactory::createCell()
     *cellPointer = result;
     result->cellFunctionInvocations = 0;
     result->id = _data->numberGen1.createNewId_kernel();
+    result->ancestorId = result->id;  //overridden by ConstructionProcessor, which knows the constructing cell
     result->selected = 0;
     result->locked = 0;
-    result->temp3 = {0, 0};
     result->metadata.color = 0;
     result->metadata.nameLen = 0;
     result->metadata.descriptionLen = 0;
     result->metadata.sourceCodeLen = 0;
     result->barrier = 0;
+    result->clusterRepresentative = result;
     return result;
 }
 
@@ -292,6 +299,13 @@ __inline__ __device__ Token* EntityFactory::duplicateToken(Cell* targetCell, Tok
     *tokenPointer = token;
 
     *token = *sourceToken;
+
+    //branch duplication is the only place where token memory is copied; plain movement just
+    //transfers the handle
+    token->memory = _data->entities.tokenMemories.getNewElement()->bytes;
+    for (int i = 0; i < MAX_TOKEN_MEM_SIZE; ++i) {
+        token->memory[i] = sourceToken->memory[i];
+    }
     token->memory[0] = targetCell->branchNumber;
     token->sourceCell = token->cell;
     token->cell = targetCell;
@@ -306,6 +320,7 @@ __inline__ __device__ Token* EntityFactory::createToken(Cell* cell, Cell* source
 
     token->cell = cell;
     token->sourceCell = sourceCell;
+    token->memory = _data->entities.tokenMemories.getNewElement()->bytes;
     token->memory[0] = cell->branchNumber;
     for (int i = 1; i < MAX_TOKEN_MEM_SIZE; ++i) {
         token->memory[i] = 0;
@@ -37,7 +37,19 @@ namespace
 
 }
 
-__global__ void cudaApplyFlowFieldSettings(SimulationData data)
+//the flow velocities are constant until the flow settings change => they are evaluated once per
+//world position and the per-timestep kernel below merely samples the resulting texture
+__global__ void cudaGenerateFlowFieldGrid(SimulationData data, float2* flowFieldGrid)
+{
+    auto partition = calcAllThreadsPartition(data.worldSize.x * data.worldSize.y);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        float2 pos{toFloat(index % data.worldSize.x), toFloat(index / data.worldSize.x)};
+        flowFieldGrid[index] = calcVelocity(pos, data.cellMap);
+    }
+}
+
+__global__ void cudaApplyFlowFieldSettings(SimulationData data, cudaTextureObject_t flowFieldGrid)
 {
     auto& cells = data.entities.cellPointers;
     auto partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
@@ -47,6 +59,12 @@ __global__ void cudaApplyFlowFieldSettings(SimulationData data)
         if (cell->barrier) {
             continue;
         }
-        cell->vel = cell->vel + calcVelocity(cell->absPos, data.cellMap);
+
+        //hardware-interpolated lookup; the texture uses wrapping in both directions since the world is a torus
+        auto flowVel = tex2D<float2>(
+            flowFieldGrid,
+            (cell->absPos.x + 0.5f) / data.worldSize.x,
+            (cell->absPos.y + 0.5f) / data.worldSize.y);
+        cell->vel = cell->vel + flowVel;
     }
 }
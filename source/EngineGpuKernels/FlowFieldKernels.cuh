@@ -4,4 +4,8 @@
 #include "Map.cuh"
 #include "SimulationData.cuh"
 
-__global__ void cudaApplyFlowFieldSettings(SimulationData data);
\ No newline at end of file
+//evaluates the analytic flow field per world position into a linear grid; only executed when the
+//cached field needs to be regenerated (see _SimulationKernelsLauncher::updateFlowFieldGridIfNecessary)
+__global__ void cudaGenerateFlowFieldGrid(SimulationData data, float2* flowFieldGrid);
+
+__global__ void cudaApplyFlowFieldSettings(SimulationData data, cudaTextureObject_t flowFieldGrid);
\ No newline at end of file
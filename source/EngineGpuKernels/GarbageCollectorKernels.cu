@@ -12,7 +12,76 @@ __global__ void cudaPrepareArraysForCleanup(SimulationData data)
     data.entitiesForCleanup.particles.reset();
     data.entitiesForCleanup.cells.reset();
     data.entitiesForCleanup.tokens.reset();
+    data.entitiesForCleanup.tokenMemories.reset();
     data.entitiesForCleanup.stringBytes.reset();
+
+    //the compaction copies the cells to new addresses => the cluster representatives have to be redetermined
+    *data.numStructuralChanges = 1;
+}
+
+namespace
+{
+    __device__ int calcMortonBucket(SimulationData& data, float2 pos)
+    {
+        data.cellMap.correctPosition(pos);
+        auto x = min((1 << Const::SpatialSortGridBits) - 1, max(0, floorInt(pos.x) * (1 << Const::SpatialSortGridBits) / data.worldSize.x));
+        auto y = min((1 << Const::SpatialSortGridBits) - 1, max(0, floorInt(pos.y) * (1 << Const::SpatialSortGridBits) / data.worldSize.y));
+
+        int result = 0;
+        for (int i = 0; i < Const::SpatialSortGridBits; ++i) {
+            result |= ((x >> i) & 1) << (2 * i);
+            result |= ((y >> i) & 1) << (2 * i + 1);
+        }
+        return result;
+    }
+}
+
+__global__ void cudaPrepareSpatialSort(SimulationData data, int* bucketOffsets)
+{
+    auto const partition = calcAllThreadsPartition(Const::NumSpatialSortBuckets);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        bucketOffsets[index] = 0;
+    }
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        data.entitiesForCleanup.cellPointers.setNumEntries(data.entities.cellPointers.getNumEntries());
+    }
+}
+
+__global__ void cudaCountSpatialSortBuckets(SimulationData data, int* bucketOffsets)
+{
+    auto const partition = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        atomicAdd(&bucketOffsets[calcMortonBucket(data, cell->absPos)], 1);
+    }
+}
+
+__global__ void cudaCalcSpatialSortOffsets(int* bucketOffsets)
+{
+    int sum = 0;
+    for (int i = 0; i < Const::NumSpatialSortBuckets; ++i) {
+        auto count = bucketOffsets[i];
+        bucketOffsets[i] = sum;
+        sum += count;
+    }
+}
+
+__global__ void cudaSpatialSortCellPointers(SimulationData data, int* bucketOffsets)
+{
+    auto const partition = calcAllThreadsPartition(data.entities.cellPointers.getNumEntries());
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& cell = data.entities.cellPointers.at(index);
+        auto newIndex = atomicAdd(&bucketOffsets[calcMortonBucket(data, cell->absPos)], 1);
+        data.entitiesForCleanup.cellPointers.at(newIndex) = cell;
+    }
+}
+
+__global__ void cudaSwapCellPointerArray(SimulationData data)
+{
+    data.entities.cellPointers.swapContent(data.entitiesForCleanup.cellPointers);
 }
 
 __global__ void cudaCleanupCellsStep1(Array<Cell*> cellPointers, Array<Cell> cells)
@@ -29,6 +98,7 @@ __global__ void cudaCleanupCellsStep1(Array<Cell*> cellPointers, Array<Cell> cel
             auto& cellPointer = cellPointers.at(index);
             auto& newCell = newCells[newCellIndex];
             newCell = *cellPointer;
+            newCell.clusterRepresentative = &newCell;  //do not rewrite the old representative in step 2: it may point to a deleted cell
 
             cellPointer->tag = &newCell - cells.getArray();  //save index of new cell in old cell
             cellPointer = &newCell;
@@ -63,18 +133,24 @@ __global__ void cudaCleanupCellsStep2(Array<Token*> tokenPointers, Array<Cell> c
     }
 }
 
-__global__ void cudaCleanupTokens(Array<Token*> tokenPointers, Array<Token> newToken)
+__global__ void cudaCleanupTokens(Array<Token*> tokenPointers, Array<Token> newToken, Array<TokenMemory> newTokenMemories)
 {
     auto partition = calcPartition(tokenPointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
     if (partition.numElements() > 0) {
         Token* newEntities = newToken.getNewSubarray(partition.numElements());
+        TokenMemory* newMemories = newTokenMemories.getNewSubarray(partition.numElements());
 
         int targetIndex = 0;
         for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
             auto& token = tokenPointers.at(index);
-            newEntities[targetIndex] = *token;
-            token = &newEntities[targetIndex];
+            auto& newEntity = newEntities[targetIndex];
+            newEntity = *token;
+            newEntity.memory = newMemories[targetIndex].bytes;
+            for (int i = 0; i < MAX_TOKEN_MEM_SIZE; ++i) {
+                newEntity.memory[i] = token->memory[i];
+            }
+            token = &newEntity;
             ++targetIndex;
         }
     }
@@ -106,6 +182,23 @@ __global__ void cudaCleanupStringBytes(Array<Cell*> cellPointers, RawMemory stri
     }
 }
 
+__global__ void cudaPrepareGenomeStoreForCleanup(SimulationData data)
+{
+    data.entitiesForCleanup.genomes.reset_system();
+}
+
+__global__ void cudaCleanupGenomes(Array<Cell*> cellPointers, GenomeStore genomes)
+{
+    //reinserting every live genome into the emptied store compacts the arena and re-deduplicates
+    //blocks whose sharers have died out
+    auto const partition = calcAllThreadsPartition(cellPointers.getNumEntries());
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& cell = cellPointers.at(index);
+        cell->staticData = genomes.getOrInsert(cell->staticData);
+    }
+}
+
 __global__ void cudaCleanupCellMap(SimulationData data)
 {
     data.cellMap.cleanup_system();
@@ -127,10 +220,24 @@ __global__ void cudaSwapArrays(SimulationData data)
 {
     data.entities.cells.swapContent(data.entitiesForCleanup.cells);
     data.entities.tokens.swapContent(data.entitiesForCleanup.tokens);
+    data.entities.tokenMemories.swapContent(data.entitiesForCleanup.tokenMemories);
     data.entities.particles.swapContent(data.entitiesForCleanup.particles);
+}
+
+__global__ void cudaSwapStringBytes(SimulationData data)
+{
+    //must only be called after cudaCleanupStringBytes, otherwise the metadata strings
+    //would still point into the swapped-out arena
     data.entities.stringBytes.swapContent(data.entitiesForCleanup.stringBytes);
 }
 
+__global__ void cudaSwapGenomeStore(SimulationData data)
+{
+    //must only be called after cudaCleanupGenomes, otherwise the cells would still point into the
+    //swapped-out arena
+    data.entities.genomes.swapContent(data.entitiesForCleanup.genomes);
+}
+
 
 __global__ void cudaCleanupParticles(Array<Particle*> particlePointers, Array<Particle> particles)
 {
@@ -153,11 +260,29 @@ __global__ void cudaCleanupParticles(Array<Particle*> particlePointers, Array<Pa
     }
 }
 
+namespace
+{
+    //a heap justifies a compaction when it is running full AND carries enough dead entries to make
+    //the full copy worthwhile; a full heap with almost only live entries is left to the array
+    //resize instead, otherwise stable worlds would pay a full copy cycle for <1% of garbage
+    template <typename Entity, typename EntityPointer>
+    __device__ bool compactionWorthwhile(Array<Entity> const& heap, Array<EntityPointer> const& livePointers)
+    {
+        auto numEntries = heap.getNumEntries();
+        if (numEntries <= heap.getSize() * Const::ArrayFillLevelFactor) {
+            return false;
+        }
+        auto numGarbageEntries = numEntries - livePointers.getNumEntries();
+        return numGarbageEntries > numEntries * Const::GarbageRatioForCompaction;
+    }
+}
+
 __global__ void cudaCheckIfCleanupIsNecessary(SimulationData data, bool* result)
 {
-    if (data.entities.particles.getNumEntries() > data.entities.particles.getSize() * Const::ArrayFillLevelFactor
-        || data.entities.cells.getNumEntries() > data.entities.cells.getSize() * Const::ArrayFillLevelFactor
-        || data.entities.tokens.getNumEntries() > data.entities.tokens.getSize() * Const::ArrayFillLevelFactor) {
+    //the pointer arrays are compacted every timestep, so their entry counts are the live counts
+    if (compactionWorthwhile(data.entities.particles, data.entities.particlePointers)
+        || compactionWorthwhile(data.entities.cells, data.entities.cellPointers)
+        || compactionWorthwhile(data.entities.tokens, data.entities.tokenPointers)) {
         *result = true;
     } else {
         *result = false;
@@ -7,9 +7,21 @@
 #include "Cell.cuh"
 #include "Token.cuh"
 
+namespace Const
+{
+    constexpr int SpatialSortGridBits = 6;  //cells are bucketed on a 64 x 64 grid for the Morton resort
+    constexpr int NumSpatialSortBuckets = 1 << (SpatialSortGridBits * 2);
+}
+
 __global__ void cudaPreparePointerArraysForCleanup(SimulationData data);
 __global__ void cudaPrepareArraysForCleanup(SimulationData data);
 
+__global__ void cudaPrepareSpatialSort(SimulationData data, int* bucketOffsets);
+__global__ void cudaCountSpatialSortBuckets(SimulationData data, int* bucketOffsets);
+__global__ void cudaCalcSpatialSortOffsets(int* bucketOffsets);
+__global__ void cudaSpatialSortCellPointers(SimulationData data, int* bucketOffsets);
+__global__ void cudaSwapCellPointerArray(SimulationData data);
+
 template<typename Entity>
 __global__ void cudaCleanupPointerArray(Array<Entity> entityArray, Array<Entity> newEntityArray)
 {
@@ -51,10 +63,14 @@ __global__ void cudaCleanupPointerArray(Array<Entity> entityArray, Array<Entity>
 __global__ void cudaCleanupParticles(Array<Particle*> particlePointers, Array<Particle> particles);
 __global__ void cudaCleanupCellsStep1(Array<Cell*> cellPointers, Array<Cell> cells);
 __global__ void cudaCleanupCellsStep2(Array<Token*> tokenPointers, Array<Cell> cells);
-__global__ void cudaCleanupTokens(Array<Token*> tokenPointers, Array<Token> newToken);
+__global__ void cudaCleanupTokens(Array<Token*> tokenPointers, Array<Token> newToken, Array<TokenMemory> newTokenMemories);
 __global__ void cudaCleanupStringBytes(Array<Cell*> cellPointers, RawMemory stringBytes);
+__global__ void cudaPrepareGenomeStoreForCleanup(SimulationData data);
+__global__ void cudaCleanupGenomes(Array<Cell*> cellPointers, GenomeStore genomes);
 __global__ void cudaCleanupCellMap(SimulationData data);
 __global__ void cudaCleanupParticleMap(SimulationData data);
 __global__ void cudaSwapPointerArrays(SimulationData data);
 __global__ void cudaSwapArrays(SimulationData data);
+__global__ void cudaSwapStringBytes(SimulationData data);
+__global__ void cudaSwapGenomeStore(SimulationData data);
 __global__ void cudaCheckIfCleanupIsNecessary(SimulationData data, bool* result);
@@ -3,34 +3,60 @@
 _GarbageCollectorKernelsLauncher::_GarbageCollectorKernelsLauncher()
 {
     CudaMemoryManager::getInstance().acquireMemory<bool>(1, _cudaBool);
+    CudaMemoryManager::getInstance().acquireMemory<int>(Const::NumSpatialSortBuckets, _cudaSortBucketOffsets);
 }
 
 _GarbageCollectorKernelsLauncher::~_GarbageCollectorKernelsLauncher()
 {
     CudaMemoryManager::getInstance().freeMemory(_cudaBool);
+    CudaMemoryManager::getInstance().freeMemory(_cudaSortBucketOffsets);
 }
 
-void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& gpuSettings, SimulationData const& data)
+void _GarbageCollectorKernelsLauncher::cleanupAfterTimestep(GpuSettings const& gpuSettings, SimulationData const& data, cudaStream_t stream)
 {
-    KERNEL_CALL(cudaCleanupCellMap, data);
-    KERNEL_CALL(cudaCleanupParticleMap, data);
+    KERNEL_CALL_STREAM(stream, cudaCleanupCellMap, data);
+    KERNEL_CALL_STREAM(stream, cudaCleanupParticleMap, data);
 
-    KERNEL_CALL_1_1(cudaPreparePointerArraysForCleanup, data);
-    KERNEL_CALL(cudaCleanupPointerArray<Particle*>, data.entities.particlePointers, data.entitiesForCleanup.particlePointers);
-    KERNEL_CALL(cudaCleanupPointerArray<Cell*>, data.entities.cellPointers, data.entitiesForCleanup.cellPointers);
-    KERNEL_CALL(cudaCleanupPointerArray<Token*>, data.entities.tokenPointers, data.entitiesForCleanup.tokenPointers);
-    KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
+    KERNEL_CALL_1_1_STREAM(stream, cudaPreparePointerArraysForCleanup, data);
+    KERNEL_CALL_STREAM(stream, cudaCleanupPointerArray<Particle*>, data.entities.particlePointers, data.entitiesForCleanup.particlePointers);
+    KERNEL_CALL_STREAM(stream, cudaCleanupPointerArray<Cell*>, data.entities.cellPointers, data.entitiesForCleanup.cellPointers);
+    KERNEL_CALL_STREAM(stream, cudaCleanupPointerArray<Token*>, data.entities.tokenPointers, data.entitiesForCleanup.tokenPointers);
+    KERNEL_CALL_1_1_STREAM(stream, cudaSwapPointerArrays, data);
+}
+
+void _GarbageCollectorKernelsLauncher::compactArraysIfNecessary(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    //periodically resort the cell pointers along a Morton curve so that the subsequent compaction
+    //lays out spatially neighboring cells adjacent in memory
+    auto spatialSort = ++_cleanupsSinceSpatialSort >= SpatialSortInterval;
+    if (spatialSort) {
+        _cleanupsSinceSpatialSort = 0;
+        KERNEL_CALL(cudaPrepareSpatialSort, data, _cudaSortBucketOffsets);
+        KERNEL_CALL(cudaCountSpatialSortBuckets, data, _cudaSortBucketOffsets);
+        KERNEL_CALL_1_1(cudaCalcSpatialSortOffsets, _cudaSortBucketOffsets);
+        KERNEL_CALL(cudaSpatialSortCellPointers, data, _cudaSortBucketOffsets);
+        KERNEL_CALL_1_1(cudaSwapCellPointerArray, data);
+    }
 
     KERNEL_CALL_1_1(cudaCheckIfCleanupIsNecessary, data, _cudaBool);
     cudaDeviceSynchronize();
-    if (copyToHost(_cudaBool)) {
+    if (copyToHost(_cudaBool) || spatialSort) {
         KERNEL_CALL_1_1(cudaPrepareArraysForCleanup, data);
         KERNEL_CALL(cudaCleanupParticles, data.entities.particlePointers, data.entitiesForCleanup.particles);
         KERNEL_CALL(cudaCleanupCellsStep1, data.entities.cellPointers, data.entitiesForCleanup.cells);
         KERNEL_CALL(cudaCleanupCellsStep2, data.entities.tokenPointers, data.entitiesForCleanup.cells);
-        KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens);
+        KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens, data.entitiesForCleanup.tokenMemories);
         KERNEL_CALL_1_1(cudaSwapArrays, data);
     }
+
+    //construction and mutation insert into the genome arena every timestep => rebuild the store
+    //when the arena is running full, analogous to the entity arrays above
+    auto genomes = data.entities.genomes;
+    if (genomes.getArenaNumBytes_host() > genomes.getArenaSize() * Const::ArrayFillLevelFactor) {
+        KERNEL_CALL(cudaPrepareGenomeStoreForCleanup, data);
+        KERNEL_CALL(cudaCleanupGenomes, data.entities.cellPointers, data.entitiesForCleanup.genomes);
+        KERNEL_CALL_1_1(cudaSwapGenomeStore, data);
+    }
 }
 
 void _GarbageCollectorKernelsLauncher::cleanupAfterDataManipulation(GpuSettings const& gpuSettings, SimulationData const& data)
@@ -45,9 +71,25 @@ void _GarbageCollectorKernelsLauncher::cleanupAfterDataManipulation(GpuSettings
     KERNEL_CALL(cudaCleanupParticles, data.entities.particlePointers, data.entitiesForCleanup.particles);
     KERNEL_CALL(cudaCleanupCellsStep1, data.entities.cellPointers, data.entitiesForCleanup.cells);
     KERNEL_CALL(cudaCleanupCellsStep2, data.entities.tokenPointers, data.entitiesForCleanup.cells);
-    KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens);
-    KERNEL_CALL(cudaCleanupStringBytes, data.entities.cellPointers, data.entitiesForCleanup.stringBytes);
+    KERNEL_CALL(cudaCleanupTokens, data.entities.tokenPointers, data.entitiesForCleanup.tokens, data.entitiesForCleanup.tokenMemories);
     KERNEL_CALL_1_1(cudaSwapArrays, data);
+
+    //the metadata strings live in a generational arena: they are immutable once written, so the
+    //expensive recopy of all string bytes is only performed when the arena is running full
+    auto stringBytes = data.entities.stringBytes;
+    if (stringBytes.getNumBytes_host() > stringBytes.getSize() * Const::ArrayFillLevelFactor) {
+        KERNEL_CALL(cudaCleanupStringBytes, data.entities.cellPointers, data.entitiesForCleanup.stringBytes);
+        KERNEL_CALL_1_1(cudaSwapStringBytes, data);
+    }
+
+    //the genome store follows the same policy: rebuilding compacts the arena and re-deduplicates,
+    //but is only worth the cost when the arena is running full
+    auto genomes = data.entities.genomes;
+    if (genomes.getArenaNumBytes_host() > genomes.getArenaSize() * Const::ArrayFillLevelFactor) {
+        KERNEL_CALL(cudaPrepareGenomeStoreForCleanup, data);
+        KERNEL_CALL(cudaCleanupGenomes, data.entities.cellPointers, data.entitiesForCleanup.genomes);
+        KERNEL_CALL_1_1(cudaSwapGenomeStore, data);
+    }
 }
 
 void _GarbageCollectorKernelsLauncher::copyArrays(GpuSettings const& gpuSettings, SimulationData const& data)
@@ -61,12 +103,16 @@ void _GarbageCollectorKernelsLauncher::copyArrays(GpuSettings const& gpuSettings
     KERNEL_CALL(cudaCleanupParticles, data.entitiesForCleanup.particlePointers, data.entitiesForCleanup.particles);
     KERNEL_CALL(cudaCleanupCellsStep1, data.entitiesForCleanup.cellPointers, data.entitiesForCleanup.cells);
     KERNEL_CALL(cudaCleanupCellsStep2, data.entitiesForCleanup.tokenPointers, data.entitiesForCleanup.cells);
-    KERNEL_CALL(cudaCleanupTokens, data.entitiesForCleanup.tokenPointers, data.entitiesForCleanup.tokens);
+    KERNEL_CALL(cudaCleanupTokens, data.entitiesForCleanup.tokenPointers, data.entitiesForCleanup.tokens, data.entitiesForCleanup.tokenMemories);
     KERNEL_CALL(cudaCleanupStringBytes, data.entitiesForCleanup.cellPointers, data.entitiesForCleanup.stringBytes);
+    KERNEL_CALL(cudaPrepareGenomeStoreForCleanup, data);
+    KERNEL_CALL(cudaCleanupGenomes, data.entitiesForCleanup.cellPointers, data.entitiesForCleanup.genomes);
 }
 
 void _GarbageCollectorKernelsLauncher::swapArrays(GpuSettings const& gpuSettings, SimulationData const& data)
 {
     KERNEL_CALL_1_1(cudaSwapPointerArrays, data);
     KERNEL_CALL_1_1(cudaSwapArrays, data);
+    KERNEL_CALL_1_1(cudaSwapStringBytes, data);
+    KERNEL_CALL_1_1(cudaSwapGenomeStore, data);
 }
@@ -13,12 +13,22 @@ public:
     _GarbageCollectorKernelsLauncher();
     ~_GarbageCollectorKernelsLauncher();
 
-    void cleanupAfterTimestep(GpuSettings const& gpuSettings, SimulationData const& simulationData);
+    //stream-ordered per-timestep cleanup without host-side decisions; suitable for batched execution
+    void cleanupAfterTimestep(GpuSettings const& gpuSettings, SimulationData const& simulationData, cudaStream_t stream);
+
+    //compacts the entity arrays if their fill level requires it; involves a device synchronization
+    void compactArraysIfNecessary(GpuSettings const& gpuSettings, SimulationData const& simulationData);
+
     void cleanupAfterDataManipulation(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void copyArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
     void swapArrays(GpuSettings const& gpuSettings, SimulationData const& simulationData);
 
 private:
+    static auto constexpr SpatialSortInterval = 10000;  //number of cleanup cycles between two Morton resorts
+
+    int _cleanupsSinceSpatialSort = 0;
+
     //gpu memory
     bool* _cudaBool;
+    int* _cudaSortBucketOffsets;
 };
@@ -0,0 +1,439 @@
+#include "GenomeJitCompiler.cuh"
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <sstream>
+
+#include <nvrtc.h>
+
+#include "Base/Definitions.h"
+#include "Base/LoggingService.h"
+#include "EngineInterface/Enums.h"
+
+#include "Base.cuh"
+#include "Cell.cuh"
+#include "CudaMemoryManager.cuh"
+#include "Entities.cuh"
+#include "GenomeStore.cuh"
+#include "Macros.cuh"
+#include "Token.cuh"
+
+namespace
+{
+    auto constexpr MaxJitGenomes = MAX_JIT_GENOMES;
+
+    //a program is only worth compiling if enough tokens run it
+    auto constexpr MinTokensForJit = 1000;
+
+    //recount and recompile only at a coarse interval; a compile takes on the order of 100 ms
+    auto constexpr UpdateInterval = 200;
+
+    __global__ void cudaCountGenomeUsage(Array<Token*> tokenPointers, GenomeStore genomes, int* counts)
+    {
+        auto const partition = calcAllThreadsPartition(tokenPointers.getNumEntries());
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto const& token = tokenPointers.at(index);
+            if (!token) {
+                continue;
+            }
+            auto const& cell = token->cell;
+            if (cell->getCellFunctionType() != Enums::CellFunction_Computation) {
+                continue;
+            }
+            auto slot = genomes.findSlotIndex(cell->staticData);
+            if (slot >= 0) {
+                atomicAdd(&counts[slot], 1);
+            }
+        }
+    }
+
+    bool check(nvrtcResult result, std::string const& what)
+    {
+        if (result != NVRTC_SUCCESS) {
+            log(Priority::Important, "jit: " + what + " failed: " + nvrtcGetErrorString(result));
+            return false;
+        }
+        return true;
+    }
+
+    bool check(CUresult result, std::string const& what)
+    {
+        if (result != CUDA_SUCCESS) {
+            char const* errorString = nullptr;
+            cuGetErrorString(result, &errorString);
+            log(Priority::Important, "jit: " + what + " failed: " + (errorString ? errorString : "unknown error"));
+            return false;
+        }
+        return true;
+    }
+}
+
+_GenomeJitCompiler::_GenomeJitCompiler()
+{
+    CudaMemoryManager::getInstance().acquireMemory<int>(GenomeStore::NumSlots, _usageCounts);
+}
+
+_GenomeJitCompiler::~_GenomeJitCompiler()
+{
+    unloadModule();
+    CudaMemoryManager::getInstance().freeMemory(_usageCounts);
+}
+
+bool _GenomeJitCompiler::updateCacheIfDue(Settings const& settings, SimulationData const& data)
+{
+    if (_failed) {
+        return false;
+    }
+    if (_callCounter++ % UpdateInterval != 0) {
+        return false;
+    }
+
+    auto candidates = collectDominantGenomes(settings.gpuSettings, data);
+
+    std::vector<char*> blocks;
+    for (auto const& candidate : candidates) {
+        blocks.emplace_back(candidate.block);
+    }
+    if (blocks == _compiledBlocks) {
+        return false;
+    }
+
+    if (blocks.empty()) {
+        return clearCache(data);
+    }
+
+    auto source = generateSource(candidates, settings.simulationParameters);
+    if (!compile(source)) {
+        //fall back to the interpreter for everything; a failure here is a setup problem
+        //(e.g. missing NVRTC) and would only repeat on every attempt
+        _failed = true;
+        clearCache(data);
+        return true;
+    }
+
+    //publish the compiled set: the interpreter skips these genomes from now on
+    _compiledBlocks = blocks;
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(data.jitGenomes, blocks.data(), sizeof(char*) * blocks.size(), cudaMemcpyHostToDevice));
+    auto numBlocks = toInt(blocks.size());
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(data.numJitGenomes, &numBlocks, sizeof(int), cudaMemcpyHostToDevice));
+
+    _tokenArrayData = reinterpret_cast<char***>(data.binnedTokenPointers._data);
+    _numTokens = data.binnedTokenPointers.getNumEntriesPointer_host();
+    _jitGenomes = data.jitGenomes;
+    _numJitGenomes = data.numJitGenomes;
+    _kernelParams[0] = &_tokenArrayData;
+    _kernelParams[1] = &_numTokens;
+    _kernelParams[2] = &_jitGenomes;
+    _kernelParams[3] = &_numJitGenomes;
+
+    log(Priority::Important, "jit: " + std::to_string(blocks.size()) + " dominant cell programs compiled");
+    return true;
+}
+
+bool _GenomeJitCompiler::clearCache(SimulationData const& data)
+{
+    unloadModule();
+    if (_compiledBlocks.empty()) {
+        return false;
+    }
+    _compiledBlocks.clear();
+    CHECK_FOR_CUDA_ERROR(cudaMemset(data.numJitGenomes, 0, sizeof(int)));
+    return true;
+}
+
+bool _GenomeJitCompiler::isActive() const
+{
+    return !_compiledBlocks.empty();
+}
+
+void _GenomeJitCompiler::launchPrograms(GpuSettings const& gpuSettings, cudaStream_t stream)
+{
+    if (!_function) {
+        return;
+    }
+    if (!check(
+            cuLaunchKernel(
+                _function,
+                gpuSettings.numBlocks,
+                1,
+                1,
+                gpuSettings.numThreadsPerBlock,
+                1,
+                1,
+                0,
+                stream,
+                _kernelParams,
+                nullptr),
+            "kernel launch")) {
+        _failed = true;
+    }
+}
+
+auto _GenomeJitCompiler::collectDominantGenomes(GpuSettings const& gpuSettings, SimulationData const& data)
+    -> std::vector<Candidate>
+{
+    CHECK_FOR_CUDA_ERROR(cudaMemset(_usageCounts, 0, sizeof(int) * GenomeStore::NumSlots));
+    KERNEL_CALL(cudaCountGenomeUsage, data.entities.tokenPointers, data.entities.genomes, _usageCounts);
+    cudaDeviceSynchronize();
+    CHECK_FOR_CUDA_ERROR(cudaGetLastError());
+
+    std::vector<int> counts(GenomeStore::NumSlots);
+    CHECK_FOR_CUDA_ERROR(
+        cudaMemcpy(counts.data(), _usageCounts, sizeof(int) * GenomeStore::NumSlots, cudaMemcpyDeviceToHost));
+
+    std::vector<std::pair<int, int>> slotsByCount;  //(count, slot)
+    for (int slot = 0; slot < GenomeStore::NumSlots; ++slot) {
+        if (counts[slot] >= MinTokensForJit) {
+            slotsByCount.emplace_back(counts[slot], slot);
+        }
+    }
+    std::sort(slotsByCount.begin(), slotsByCount.end(), std::greater<>());
+    if (toInt(slotsByCount.size()) > MaxJitGenomes) {
+        slotsByCount.resize(MaxJitGenomes);
+    }
+
+    //sort by slot so that an unchanged dominant set yields an identical block list
+    std::sort(slotsByCount.begin(), slotsByCount.end(), [](auto const& a, auto const& b) { return a.second < b.second; });
+
+    std::vector<Candidate> result;
+    for (auto const& [count, slot] : slotsByCount) {
+        Candidate candidate;
+        candidate.block = data.entities.genomes.getSlotBlock_host(slot);
+        candidate.numTokens = count;
+        if (!candidate.block) {
+            continue;
+        }
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpy(candidate.bytes.data(), candidate.block, MAX_CELL_STATIC_BYTES, cudaMemcpyDeviceToHost));
+        result.emplace_back(candidate);
+    }
+    return result;
+}
+
+std::string _GenomeJitCompiler::generateSource(std::vector<Candidate> const& candidates, SimulationParameters const& parameters) const
+{
+    auto const tokenMemSize = std::max(1, parameters.tokenMemorySize);
+    auto const cellMemSize = std::max(1, parameters.cellFunctionComputerCellMemorySize);
+    auto const numInstructions =
+        std::min(parameters.cellFunctionComputerMaxInstructions, MAX_CELL_STATIC_BYTES / 3);
+    auto convertToAddress = [](char operand, int size) { return static_cast<unsigned char>(operand) % size; };
+
+    std::stringstream s;
+    s << "__device__ inline bool executeAllowed(bool const* condTable, int condPointer)\n"
+      << "{\n"
+      << "    for (int k = 0; k < condPointer; ++k) {\n"
+      << "        if (!condTable[k]) {\n"
+      << "            return false;\n"
+      << "        }\n"
+      << "    }\n"
+      << "    return true;\n"
+      << "}\n\n";
+
+    //one straight-line device function per program: opcodes and addresses are constants, only
+    //the indirect addressing mode needs a runtime lookup
+    for (int progIndex = 0; progIndex < toInt(candidates.size()); ++progIndex) {
+        auto const& bytes = candidates[progIndex].bytes;
+        s << "__device__ void program" << progIndex << "(char* tokenMem, char* cellMem)\n"
+          << "{\n"
+          << "    bool condTable[" << (MAX_CELL_STATIC_BYTES / 3 + 1) << "];\n"
+          << "    int condPointer = 0;\n";
+        for (int i = 0; i < numInstructions; ++i) {
+            auto operation = (bytes[i * 3] >> 4) & 0xF;
+            auto opType1 = ((bytes[i * 3] >> 2) & 0x3) % 3;
+            auto opType2 = bytes[i * 3] & 0x3;
+            auto operand1 = bytes[i * 3 + 1];
+            auto operand2 = bytes[i * 3 + 2];
+
+            //operand 1: memory reference
+            std::string lhs;
+            if (opType1 == Enums::ComputationOpType_MemMem) {
+                s << "    unsigned char p" << i << " = static_cast<unsigned char>(tokenMem["
+                  << convertToAddress(operand1, tokenMemSize) << "]) % " << tokenMemSize << ";\n";
+                lhs = "tokenMem[p" + std::to_string(i) + "]";
+            } else if (opType1 == Enums::ComputationOpType_Cmem) {
+                lhs = "cellMem[" + std::to_string(convertToAddress(operand1, cellMemSize)) + "]";
+            } else {
+                lhs = "tokenMem[" + std::to_string(convertToAddress(operand1, tokenMemSize)) + "]";
+            }
+
+            //operand 2: value
+            std::string value;
+            if (opType2 == Enums::ComputationOpType_Mem) {
+                value = "tokenMem[" + std::to_string(convertToAddress(operand2, tokenMemSize)) + "]";
+            } else if (opType2 == Enums::ComputationOpType_MemMem) {
+                value = "tokenMem[static_cast<unsigned char>(tokenMem["
+                    + std::to_string(convertToAddress(operand2, tokenMemSize)) + "]) % " + std::to_string(tokenMemSize)
+                    + "]";
+            } else if (opType2 == Enums::ComputationOpType_Cmem) {
+                value = "cellMem[" + std::to_string(convertToAddress(operand2, cellMemSize)) + "]";
+            } else {
+                value = std::to_string(static_cast<int>(operand2));
+            }
+            s << "    signed char b" << i << " = static_cast<signed char>(" << value << ");\n";
+
+            switch (operation) {
+            case Enums::ComputationOperation_Mov:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = b" << i << "; }\n";
+                break;
+            case Enums::ComputationOperation_Add:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = static_cast<signed char>(" << lhs
+                  << " + b" << i << "); }\n";
+                break;
+            case Enums::ComputationOperation_Sub:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = static_cast<signed char>(" << lhs
+                  << " - b" << i << "); }\n";
+                break;
+            case Enums::ComputationOperation_Mul:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = static_cast<signed char>(" << lhs
+                  << " * b" << i << "); }\n";
+                break;
+            case Enums::ComputationOperation_Div:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = b" << i
+                  << " > 0 ? static_cast<signed char>(" << lhs << " / b" << i << ") : 0; }\n";
+                break;
+            case Enums::ComputationOperation_Xor:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = static_cast<signed char>(" << lhs
+                  << " ^ b" << i << "); }\n";
+                break;
+            case Enums::ComputationOperation_Or:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = static_cast<signed char>(" << lhs
+                  << " | b" << i << "); }\n";
+                break;
+            case Enums::ComputationOperation_And:
+                s << "    if (executeAllowed(condTable, condPointer)) { " << lhs << " = static_cast<signed char>(" << lhs
+                  << " & b" << i << "); }\n";
+                break;
+            case Enums::ComputationOperation_Ifg:
+                s << "    condTable[condPointer++] = static_cast<signed char>(" << lhs << ") > b" << i << ";\n";
+                break;
+            case Enums::ComputationOperation_Ifge:
+                s << "    condTable[condPointer++] = static_cast<signed char>(" << lhs << ") >= b" << i << ";\n";
+                break;
+            case Enums::ComputationOperation_Ife:
+                s << "    condTable[condPointer++] = static_cast<signed char>(" << lhs << ") == b" << i << ";\n";
+                break;
+            case Enums::ComputationOperation_Ifne:
+                s << "    condTable[condPointer++] = static_cast<signed char>(" << lhs << ") != b" << i << ";\n";
+                break;
+            case Enums::ComputationOperation_Ifle:
+                s << "    condTable[condPointer++] = static_cast<signed char>(" << lhs << ") <= b" << i << ";\n";
+                break;
+            case Enums::ComputationOperation_Ifl:
+                s << "    condTable[condPointer++] = static_cast<signed char>(" << lhs << ") < b" << i << ";\n";
+                break;
+            case Enums::ComputationOperation_Else:
+                s << "    if (condPointer > 0) { condTable[condPointer - 1] = !condTable[condPointer - 1]; }\n";
+                break;
+            case Enums::ComputationOperation_Endif:
+                s << "    if (condPointer > 0) { --condPointer; }\n";
+                break;
+            }
+        }
+        s << "}\n\n";
+    }
+
+    //the kernel accesses Token and Cell via byte offsets taken from the structs of this
+    //translation unit, so it stays in sync with the real layout without redeclaring the types
+    s << "extern \"C\" __global__ void cudaJitCellComputation(char*** tokenArrayData, int* numTokens, char** jitGenomes, int* numJitGenomes)\n"
+      << "{\n"
+      << "    char** tokens = *tokenArrayData;\n"
+      << "    int n = *numTokens;\n"
+      << "    int numJit = *numJitGenomes;\n"
+      << "    for (int i = blockIdx.x * blockDim.x + threadIdx.x; i < n; i += gridDim.x * blockDim.x) {\n"
+      << "        char* token = tokens[i];\n"
+      << "        char* cell = *reinterpret_cast<char**>(token + " << offsetof(Token, cell) << ");\n"
+      << "        if (static_cast<unsigned int>(*reinterpret_cast<int*>(cell + " << offsetof(Cell, cellFunctionType)
+      << ")) % " << static_cast<int>(Enums::CellFunction_Count) << " != " << static_cast<int>(Enums::CellFunction_Computation) << ") {\n"
+      << "            continue;\n"
+      << "        }\n"
+      << "        char* staticData = *reinterpret_cast<char**>(cell + " << offsetof(Cell, staticData) << ");\n"
+      << "        int progIndex = -1;\n"
+      << "        for (int k = 0; k < numJit; ++k) {\n"
+      << "            if (jitGenomes[k] == staticData) {\n"
+      << "                progIndex = k;\n"
+      << "                break;\n"
+      << "            }\n"
+      << "        }\n"
+      << "        if (progIndex < 0) {\n"
+      << "            continue;\n"
+      << "        }\n"
+      << "        char* tokenMem = *reinterpret_cast<char**>(token + " << offsetof(Token, memory) << ");\n"
+      << "        char* cellMem = cell + " << offsetof(Cell, mutableData) << ";\n"
+      << "        int* lock = reinterpret_cast<int*>(cell + " << offsetof(Cell, locked) << ");\n"
+      << "        for (int attempt = 0; attempt < 100; ++attempt) {\n"
+      << "            if (0 == atomicExch(lock, 1)) {\n"
+      << "                __threadfence();\n"
+      << "                switch (progIndex) {\n";
+    for (int progIndex = 0; progIndex < toInt(candidates.size()); ++progIndex) {
+        s << "                case " << progIndex << ": program" << progIndex << "(tokenMem, cellMem); break;\n";
+    }
+    s << "                }\n"
+      << "                __threadfence();\n"
+      << "                atomicExch(lock, 0);\n"
+      << "                break;\n"
+      << "            }\n"
+      << "        }\n"
+      << "    }\n"
+      << "}\n";
+    return s.str();
+}
+
+bool _GenomeJitCompiler::compile(std::string const& source)
+{
+    unloadModule();
+
+    int device = 0;
+    CHECK_FOR_CUDA_ERROR(cudaGetDevice(&device));
+    int ccMajor = 0, ccMinor = 0;
+    CHECK_FOR_CUDA_ERROR(cudaDeviceGetAttribute(&ccMajor, cudaDevAttrComputeCapabilityMajor, device));
+    CHECK_FOR_CUDA_ERROR(cudaDeviceGetAttribute(&ccMinor, cudaDevAttrComputeCapabilityMinor, device));
+    auto archOption = "--gpu-architecture=compute_" + std::to_string(ccMajor) + std::to_string(ccMinor);
+
+    nvrtcProgram program;
+    if (!check(nvrtcCreateProgram(&program, source.c_str(), "cellPrograms.cu", 0, nullptr, nullptr), "program creation")) {
+        return false;
+    }
+    char const* options[] = {archOption.c_str()};
+    auto compileResult = nvrtcCompileProgram(program, 1, options);
+    if (compileResult != NVRTC_SUCCESS) {
+        size_t logSize = 0;
+        nvrtcGetProgramLogSize(program, &logSize);
+        std::string compileLog(logSize, 0);
+        nvrtcGetProgramLog(program, compileLog.data());
+        log(Priority::Important, "jit: compilation failed: " + compileLog);
+        nvrtcDestroyProgram(&program);
+        return false;
+    }
+
+    size_t ptxSize = 0;
+    if (!check(nvrtcGetPTXSize(program, &ptxSize), "ptx query")) {
+        nvrtcDestroyProgram(&program);
+        return false;
+    }
+    std::string ptx(ptxSize, 0);
+    if (!check(nvrtcGetPTX(program, ptx.data()), "ptx retrieval")) {
+        nvrtcDestroyProgram(&program);
+        return false;
+    }
+    nvrtcDestroyProgram(&program);
+
+    if (!check(cuModuleLoadDataEx(&_module, ptx.data(), 0, nullptr, nullptr), "module load")) {
+        _module = nullptr;
+        return false;
+    }
+    if (!check(cuModuleGetFunction(&_function, _module, "cudaJitCellComputation"), "function lookup")) {
+        unloadModule();
+        return false;
+    }
+    return true;
+}
+
+void _GenomeJitCompiler::unloadModule()
+{
+    if (_module) {
+        cuModuleUnload(_module);
+        _module = nullptr;
+        _function = nullptr;
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cuda_runtime.h>
+#include <cuda.h>
+
+#include <array>
+#include <vector>
+
+#include "EngineInterface/Settings.h"
+
+#include "Definitions.cuh"
+#include "SimulationData.cuh"
+
+//experimental jit path for the cell computation function: the most frequent programs (identified
+//via the genome store) are translated to CUDA source, compiled with NVRTC and executed by a
+//generated kernel, while the interpreter in CellComputationProcessor keeps handling the rare
+//genomes; stable ecosystems run essentially fixed code, which makes the compiled programs
+//straight-line device code with constant addresses
+class _GenomeJitCompiler
+{
+public:
+    _GenomeJitCompiler();
+    ~_GenomeJitCompiler();
+
+    //recounts the genome usage and recompiles the dominant programs at a coarse interval;
+    //returns true if the program set changed (the caller must invalidate its captured graphs);
+    //performs device synchronization and must not be called between unsynchronized kernel launches
+    bool updateCacheIfDue(Settings const& settings, SimulationData const& data);
+
+    //removes all compiled programs so that every token falls back to the interpreter
+    bool clearCache(SimulationData const& data);
+
+    bool isActive() const;
+
+    //launches the generated kernel over the binned tokens; no-op while no program is compiled
+    void launchPrograms(GpuSettings const& gpuSettings, cudaStream_t stream);
+
+private:
+    struct Candidate
+    {
+        char* block;  //device address of the genome block
+        int numTokens;
+        std::array<char, MAX_CELL_STATIC_BYTES> bytes;
+    };
+    std::vector<Candidate> collectDominantGenomes(GpuSettings const& gpuSettings, SimulationData const& data);
+    std::string generateSource(std::vector<Candidate> const& candidates, SimulationParameters const& parameters) const;
+    bool compile(std::string const& source);
+    void unloadModule();
+
+    int* _usageCounts = nullptr;  //device array with one counter per genome store slot
+    std::vector<char*> _compiledBlocks;  //device addresses of the genome blocks with a compiled program
+
+    CUmodule _module = nullptr;
+    CUfunction _function = nullptr;
+    void* _kernelParams[4] = {};
+    char*** _tokenArrayData = nullptr;
+    int* _numTokens = nullptr;
+    char** _jitGenomes = nullptr;
+    int* _numJitGenomes = nullptr;
+
+    int _callCounter = 0;
+    bool _failed = false;  //a compilation failure disables the jit path until the next simulation
+};
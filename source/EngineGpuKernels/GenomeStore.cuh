@@ -0,0 +1,169 @@
+#pragma once
+
+#include <cuda_runtime.h>
+#include <device_launch_parameters.h>
+#include <sm_60_atomic_functions.h>
+
+#include "AccessTOs.cuh"
+#include "Base.cuh"
+#include "CudaMemoryManager.cuh"
+#include "RawMemory.cuh"
+#include "Swap.cuh"
+
+//deduplicated storage for the cells' static data (the compiled programs): after replication a
+//million clones of one organism carry the same program, so the cells alias one shared block
+//instead of each holding a private copy; blocks are immutable once published => a mutation has
+//to reinsert the modified copy (copy-on-write)
+class GenomeStore
+{
+public:
+    static int constexpr NumSlots = 1 << 16;
+    static int constexpr MaxProbes = 8;
+
+    __host__ __inline__ void init(uint64_t arenaSize)
+    {
+        _arena.init();
+        _arena.resize(arenaSize);
+
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long*>(1, _slotHashes);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long*>(1, _slotBlocks);
+
+        unsigned long long* slotHashes = nullptr;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long>(NumSlots, slotHashes);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(slotHashes, 0, NumSlots * sizeof(unsigned long long)));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_slotHashes, &slotHashes, sizeof(unsigned long long*), cudaMemcpyHostToDevice));
+
+        unsigned long long* slotBlocks = nullptr;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned long long>(NumSlots, slotBlocks);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(slotBlocks, 0, NumSlots * sizeof(unsigned long long)));
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(_slotBlocks, &slotBlocks, sizeof(unsigned long long*), cudaMemcpyHostToDevice));
+    }
+
+    __host__ __inline__ void free()
+    {
+        unsigned long long* slotHashes = nullptr;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&slotHashes, _slotHashes, sizeof(unsigned long long*), cudaMemcpyDeviceToHost));
+        CudaMemoryManager::getInstance().freeMemory(slotHashes);
+
+        unsigned long long* slotBlocks = nullptr;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&slotBlocks, _slotBlocks, sizeof(unsigned long long*), cudaMemcpyDeviceToHost));
+        CudaMemoryManager::getInstance().freeMemory(slotBlocks);
+
+        CudaMemoryManager::getInstance().freeMemory(_slotHashes);
+        CudaMemoryManager::getInstance().freeMemory(_slotBlocks);
+        _arena.free();
+    }
+
+    uint64_t getArenaSize() const { return _arena.getSize(); }
+    __host__ __inline__ int getArenaNumBytes_host() { return _arena.getNumBytes_host(); }
+
+    //returns the published block address of a slot (nullptr for an empty slot); used by the
+    //host-side genome usage analysis (see GenomeJitCompiler)
+    __host__ __inline__ char* getSlotBlock_host(int slot) const
+    {
+        unsigned long long* slotBlocks = nullptr;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&slotBlocks, _slotBlocks, sizeof(unsigned long long*), cudaMemcpyDeviceToHost));
+        unsigned long long block = 0;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&block, slotBlocks + slot, sizeof(unsigned long long), cudaMemcpyDeviceToHost));
+        return reinterpret_cast<char*>(block);
+    }
+
+    //returns the table slot holding the given block or -1; unshared fallback copies are not part
+    //of the table
+    __device__ __inline__ int findSlotIndex(char const* block) const
+    {
+        auto hash = calcHash(block);
+        auto slot = static_cast<int>(hash % NumSlots);
+        for (int probe = 0; probe < MaxProbes; ++probe, slot = (slot + 1) % NumSlots) {
+            if ((*_slotHashes)[slot] == hash && reinterpret_cast<char const*>((*_slotBlocks)[slot]) == block) {
+                return slot;
+            }
+        }
+        return -1;
+    }
+
+    //returns a shared block holding the given MAX_CELL_STATIC_BYTES bytes; the blocks always have
+    //full length so that a later change of numStaticBytes (e.g. a cell function mutation) can
+    //never read beyond the block
+    __device__ __inline__ char* getOrInsert(char const* bytes)
+    {
+        auto hash = calcHash(bytes);
+        auto slot = static_cast<int>(hash % NumSlots);
+        for (int probe = 0; probe < MaxProbes; ++probe, slot = (slot + 1) % NumSlots) {
+            auto slotHash = atomicCAS(&(*_slotHashes)[slot], 0ull, hash);
+            if (0 == slotHash) {
+
+                //slot claimed => write the block and publish it afterwards
+                auto block = _arena.getArray<char>(MAX_CELL_STATIC_BYTES);
+                for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+                    block[i] = bytes[i];
+                }
+                __threadfence();
+                atomicExch(&(*_slotBlocks)[slot], reinterpret_cast<unsigned long long>(block));
+                return block;
+            }
+            if (slotHash == hash) {
+                auto block = reinterpret_cast<char*>(atomicAdd(&(*_slotBlocks)[slot], 0ull));
+                if (!block) {
+                    break;  //another thread is still writing the block => fall back to an unshared copy instead of spinning
+                }
+                if (matches(block, bytes)) {
+                    return block;
+                }
+
+                //hash collision with different content => probe the next slot
+            }
+        }
+
+        //table full or contended: an unshared copy is still correct, merely not deduplicated
+        auto block = _arena.getArray<char>(MAX_CELL_STATIC_BYTES);
+        for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+            block[i] = bytes[i];
+        }
+        return block;
+    }
+
+    //empties the store; must be called from all threads of all blocks
+    __device__ __inline__ void reset_system()
+    {
+        auto const partition = calcAllThreadsPartition(NumSlots);
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            (*_slotHashes)[index] = 0;
+            (*_slotBlocks)[index] = 0;
+        }
+        if (0 == threadIdx.x && 0 == blockIdx.x) {
+            _arena.reset();
+        }
+    }
+
+    __device__ __inline__ void swapContent(GenomeStore& other)
+    {
+        swap(*_slotHashes, *other._slotHashes);
+        swap(*_slotBlocks, *other._slotBlocks);
+        _arena.swapContent(other._arena);
+    }
+
+private:
+    __device__ __inline__ static uint64_t calcHash(char const* bytes)
+    {
+        uint64_t hash = 14695981039346656037ull;  //fnv-1a
+        for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+            hash = (hash ^ static_cast<unsigned char>(bytes[i])) * 1099511628211ull;
+        }
+        return hash != 0 ? hash : 1;  //0 marks an empty slot
+    }
+
+    __device__ __inline__ static bool matches(char const* block, char const* bytes)
+    {
+        for (int i = 0; i < MAX_CELL_STATIC_BYTES; ++i) {
+            if (block[i] != bytes[i]) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    unsigned long long** _slotHashes;  //hash of the block content per slot; 0 = empty
+    unsigned long long** _slotBlocks;  //published block address per slot; 0 = claimed but not yet written
+    RawMemory _arena;
+};
@@ -3,6 +3,10 @@
 #include "HashSet.cuh"
 #include "Array.cuh"
 
+//lock-free open-addressing hash map: a slot is claimed with a single CAS on its state word and
+//published with a fence, so neither insertion nor lookup takes a lock; probing is linear and starts
+//at a bucket boundary, so a probe sequence walks the slots of one cache-line-sized bucket before
+//spilling into the next one, which keeps lookups local even at high load factors
 template <typename Key, typename Value, typename Hash = HashFunctor<Key>>
 class HashMap
 {
@@ -10,21 +14,26 @@ public:
     __device__ __inline__ void init_block(int size, RawMemory& arrays)
     {
         __shared__ Entry* entries;
+        __shared__ int* numEntries;
         if (0 == threadIdx.x) {
             entries = arrays.getArray<Entry>(size);
+            numEntries = arrays.getArray<int>(1);
         }
         __syncthreads();
 
         _size = size;
         _entries = entries;
+        _numEntries = numEntries;
     }
 
     __device__ __inline__ void reset_block()
     {
         auto const threadBlock = calcPartition(_size, threadIdx.x, blockDim.x);
         for (int i = threadBlock.startIndex; i <= threadBlock.endIndex; ++i) {
-            _entries[i].setFree(0);
-            _entries[i].initLock();
+            _entries[i]._state = State_Free;
+        }
+        if (0 == threadIdx.x) {
+            *_numEntries = 0;
         }
         __syncthreads();
     }
@@ -32,133 +41,104 @@ public:
     //return true if key was present
     __device__ __inline__ bool insertOrAssign(Key const& key, Value const& value)
     {
-        int index = _hash(key) % _size;
-        int wasFree;
-        do {
+        auto index = calcStartIndex(key);
+        for (int i = 0; i < _size; ++i, index = incIndex(index)) {
             auto& entry = _entries[index];
-            entry.getLock(1);
-            wasFree = entry.setFree(1);
-            if (1 == wasFree) {
-                if (entry.getKey() == key) {
-                    entry.setValue(value);
-                    entry.releaseLock();
-                    return true;
-                }
-                entry.releaseLock();
-                index = (++index) % _size;
+            auto state = atomicCAS_block(&entry._state, State_Free, State_Reserved);
+            if (State_Free == state) {
+                entry._key = key;
+                entry._value = value;
+                __threadfence_block();
+                atomicExch_block(&entry._state, State_Occupied);
+                atomicAdd_block(_numEntries, 1);
+                return false;
             }
-        } while (1 == wasFree);
-
-        auto& newEntry = _entries[index];
-        newEntry.setKey(key);
-        newEntry.setValue(value);
-        newEntry.releaseLock();
-        return false;
+            awaitPublication(entry);
+            if (entry._key == key) {
+                entry._value = value;  //last writer wins, as with the former per-entry locks
+                return true;
+            }
+        }
+        return false;  //map is full
     }
 
     __device__ __inline__ bool contains(Key const& key) const
     {
-        int index = _hash(key) % _size;
-        for (int i = 0; i < 10; ++i, index = (++index) % _size) {   //workaround: 10 is set to avoid too long runtime
+        auto index = calcStartIndex(key);
+        for (int i = 0; i < _size; ++i, index = incIndex(index)) {
             auto& entry = _entries[index];
-            entry.getLock(2);
-            if (0 == entry.getFree()) {
-                entry.releaseLock();
+            auto state = atomicAdd_block(&entry._state, 0);
+            if (State_Free == state) {
                 return false;
             }
-            if (entry.getKey() == key) {
-                entry.releaseLock();
+            awaitPublication(entry);
+            if (entry._key == key) {
                 return true;
             }
-            entry.releaseLock();
         }
         return false;
     }
 
-    __device__ __inline__ Value at(Key const& key)
+    __device__ __inline__ Value at(Key const& key) const
     {
-        for (int i = 0; i < 10; ++i) {  //workaround: 10 is set to avoid too long runtime
-            int index = _hash(key) % _size;
+        auto index = calcStartIndex(key);
+        for (int i = 0; i < _size; ++i, index = incIndex(index)) {
             auto& entry = _entries[index];
-            entry.getLock(3);
-            if (0 == entry.getFree()) {
-                entry.releaseLock();
+            auto state = atomicAdd_block(&entry._state, 0);
+            if (State_Free == state) {
                 return Value();
             }
-            if (entry.getKey() == key) {
-                auto result = entry.getValue();
-                entry.releaseLock();
-                return result;
+            awaitPublication(entry);
+            if (entry._key == key) {
+                return entry._value;
             }
-            entry.releaseLock();
-            index = (++index) % _size;
         }
         return Value();
     }
 
-private:
-    Hash _hash;
-
-    class Entry
+    __device__ __inline__ int getCapacity() const { return _size; }
+    __device__ __inline__ int getNumEntries() const { return atomicAdd_block(_numEntries, 0); }
+    __device__ __inline__ float getLoadFactor() const
     {
-    public:
-        __device__ __inline__ int setFree(int value)
-        {
-            int origValue = _free;
-            _free = value;
-            return origValue;
-        }
-        __device__ __inline__ int getFree()
-        {
-            return _free;
-        }
+        return 0 == _size ? 0.0f : static_cast<float>(getNumEntries()) / static_cast<float>(_size);
+    }
 
-        __device__ __inline__ void setValue(Value const& value)
-        {
-            _value = value;
-        }
-        __device__ __inline__ Value getValue()
-        {
-            return _value;
-        }
+private:
+    //entries probed consecutively before hashing moves on; sized so that a bucket of small
+    //key/value pairs spans roughly one cache line
+    static int constexpr BucketSize = 8;
 
-        __device__ __inline__ void setKey(Key const& value)
-        {
-            _key = value;
-        }
-        __device__ __inline__ Key getKey()
-        {
-            return _key;
-        }
+    static int constexpr State_Free = 0;
+    static int constexpr State_Reserved = 1;  //claimed, key and value not yet visible
+    static int constexpr State_Occupied = 2;
 
-        __device__ __inline__ void initLock()
-        {
-            atomicExch_block(&_locked, 0);
-        }
+    struct Entry
+    {
+        int _state;
+        Key _key;
+        Value _value;
+    };
 
-        __device__ __inline__ bool tryLock()
-        {
-            return 0 == atomicExch_block(&_locked, 1);
-        }
+    __device__ __inline__ int calcStartIndex(Key const& key) const
+    {
+        auto numBuckets = max(1, _size / BucketSize);
+        return (_hash(key) % numBuckets) * BucketSize;
+    }
 
-        __device__ __inline__ void getLock(int parameter)
-        {
-            while (1 == atomicExch_block(&_locked, 1)) {}
-            __threadfence_block();
-        }
+    __device__ __inline__ int incIndex(int index) const { return index + 1 == _size ? 0 : index + 1; }
 
-        __device__ __inline__ void releaseLock()
-        {
-            __threadfence_block();
-            atomicExch_block(&_locked, 0);
+    //a reserved slot is being published by another thread; its key is needed for the comparison
+    //that follows, so spin until the state flips to occupied (spinning is safe on the independent
+    //thread scheduling the engine targets, cf. SystemLock)
+    __device__ __inline__ void awaitPublication(Entry& entry) const
+    {
+        while (State_Reserved == atomicAdd_block(&entry._state, 0)) {
         }
+        __threadfence_block();
+    }
 
-    private:
-        int _free;   //0 = free, 1 = used
-        int _locked;	//0 = unlocked, 1 = locked
-        Value _value;
-        Key _key;
-    };
+    Hash _hash;
     int _size;
     Entry* _entries;
+    int* _numEntries;
 };
@@ -12,6 +12,16 @@ template< typename T >
 void checkAndThrowError(T result, char const *const func, const char *const file, int const line)
 {
     if (result) {
+        if (cudaError::cudaErrorMemoryAllocation == result) {
+
+            //an allocation failure is not sticky and leaves the device context intact, so the
+            //device is deliberately not reset here; the engine can still snapshot the world to
+            //the host and rebuild the context (see EngineWorker)
+            cudaGetLastError();  //clear the error state
+            std::stringstream stream;
+            stream << "CUDA memory allocation failed at " << file << ":" << line << " \"" << func << "\"";
+            throw CudaMemoryAllocationException(stream.str());
+        }
         DEVICE_RESET
         if (cudaError::cudaErrorInsufficientDriver == result) {
             throw SpecificCudaException(
@@ -50,3 +60,8 @@ void checkAndThrowError(T result, char const *const func, const char *const file
 
 #define KERNEL_CALL(func, ...) \
     func<<<gpuSettings.numBlocks, gpuSettings.numThreadsPerBlock>>>(__VA_ARGS__);
+
+#define KERNEL_CALL_1_1_STREAM(stream, func, ...) func<<<1, 1, 0, stream>>>(__VA_ARGS__);
+
+#define KERNEL_CALL_STREAM(stream, func, ...) \
+    func<<<gpuSettings.numBlocks, gpuSettings.numThreadsPerBlock, 0, stream>>>(__VA_ARGS__);
@@ -9,11 +9,22 @@
 class BaseMap
 {
 public:
-    __inline__ __host__ __device__ void init(int2 const& size) { _size = size; }
+    __inline__ __host__ __device__ void init(int2 const& size)
+    {
+        _size = size;
+
+        //power-of-two extents permit wrap-around via masking instead of the double modulo, which
+        //matters for the very large worlds where position corrections occur on every map access
+        _sizeMask = {
+            0 == (size.x & (size.x - 1)) ? size.x - 1 : 0,
+            0 == (size.y & (size.y - 1)) ? size.y - 1 : 0};
+    }
 
     __inline__ __host__ __device__ void correctPosition(int2& pos) const
     {
-        pos = {((pos.x % _size.x) + _size.x) % _size.x, ((pos.y % _size.y) + _size.y) % _size.y};
+        pos = {
+            0 != _sizeMask.x ? pos.x & _sizeMask.x : ((pos.x % _size.x) + _size.x) % _size.x,
+            0 != _sizeMask.y ? pos.y & _sizeMask.y : ((pos.y % _size.y) + _size.y) % _size.y};
     }
 
     __inline__ __host__ __device__ void correctPosition(float2& pos) const
@@ -64,6 +75,7 @@ public:
 
 protected:
     int2 _size;
+    int2 _sizeMask;  //size - 1 per axis if the extent is a power of two, otherwise 0
 };
 
 template <typename T>
@@ -75,6 +87,8 @@ public:
 class CellMap : public BaseMap
 {
 public:
+    static int constexpr SectorSizeExp = 5;  //occupancy is tracked per 32x32 sector
+
     __host__ __inline__ void init(int2 const& size)
     {
         BaseMap::init(size);
@@ -83,6 +97,15 @@ public:
 
         std::vector<Cell*> hostMap(size.x * size.y * 2, 0);
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_map, hostMap.data(), sizeof(Cell*) * size.x * size.y * 2, cudaMemcpyHostToDevice));
+
+        //coarse occupancy layer: one bit per sector; worlds are largely empty space, so
+        //neighborhood queries consult the small (and therefore well-cached) bitmask before
+        //probing the map itself; only complete sectors are tracked, a remainder strip at the
+        //world border counts as always occupied
+        _numSectors = {size.x >> SectorSizeExp, size.y >> SectorSizeExp};
+        auto numOccupancyWords = std::max(1, (_numSectors.x * _numSectors.y + 31) / 32);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(numOccupancyWords, _sectorOccupancy);
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_sectorOccupancy, 0, sizeof(unsigned int) * numOccupancyWords));
     }
 
     __host__ __inline__ void resize(int maxEntries) { _mapEntries.resize(maxEntries); }
@@ -92,6 +115,7 @@ public:
     __host__ __inline__ void free()
     {
         CudaMemoryManager::getInstance().freeMemory(_map);
+        CudaMemoryManager::getInstance().freeMemory(_sectorOccupancy);
         _mapEntries.free();
     }
 
@@ -121,6 +145,18 @@ public:
                 alienAtomicExch(&_map[mapEntry + 1], entity);
             }
             entrySubarray[index] = mapEntry;
+
+            //mark the containing sector as occupied; checking first avoids the atomic in the
+            //common case that a neighboring cell has already set the bit
+            auto sectorX = posInt.x >> SectorSizeExp;
+            auto sectorY = posInt.y >> SectorSizeExp;
+            if (sectorX < _numSectors.x && sectorY < _numSectors.y) {
+                auto sectorIndex = sectorX + sectorY * _numSectors.x;
+                auto mask = 1u << (sectorIndex & 31);
+                if (0 == (_sectorOccupancy[sectorIndex >> 5] & mask)) {
+                    atomicOr(&_sectorOccupancy[sectorIndex >> 5], mask);
+                }
+            }
         }
         __syncthreads();
     }
@@ -130,6 +166,9 @@ public:
     {
         int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         numCells = 0;
+        if (!isAreaOccupied(posInt, 1)) {
+            return;
+        }
         for (int dx = -1; dx <= 1; ++dx) {
             for (int dy = -1; dy <= 1; ++dy) {
                 int2 scanPos{posInt.x + dx, posInt.y + dy};
@@ -151,6 +190,9 @@ public:
         int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         numCells = 0;
         int radiusInt = ceilf(radius);
+        if (!isAreaOccupied(posInt, radiusInt)) {
+            return;
+        }
         for (int dx = -radiusInt; dx <= radiusInt; ++dx) {
             for (int dy = -radiusInt; dy <= radiusInt; ++dy) {
                 int2 scanPos{posInt.x + dx, posInt.y + dy};
@@ -172,10 +214,49 @@ public:
         }
     }
 
+    //support for kernels that stage a map tile plus halo in shared memory (see CellProcessor::collisions)
+    static int constexpr TileSizeExp = 4;  //16x16 positions per tile
+    static int constexpr TileSize = 1 << TileSizeExp;
+
+    __device__ __inline__ int getNumTiles() const
+    {
+        return ((_size.x + TileSize - 1) >> TileSizeExp) * ((_size.y + TileSize - 1) >> TileSizeExp);
+    }
+
+    __device__ __inline__ int2 getTileOrigin(int tileIndex) const
+    {
+        auto numTilesX = (_size.x + TileSize - 1) >> TileSizeExp;
+        return {(tileIndex % numTilesX) << TileSizeExp, (tileIndex / numTilesX) << TileSizeExp};
+    }
+
+    __device__ __inline__ bool isTileOccupied(int2 const& tileOrigin) const
+    {
+        //conservative: checks a square covering the tile including its halo
+        return isAreaOccupied({tileOrigin.x + TileSize / 2, tileOrigin.y + TileSize / 2}, TileSize / 2 + 1);
+    }
+
+    //raw slot access for staging tiles; expects a corrected position
+    __device__ __inline__ Cell* getFromSlot(int2 const& posInt, int slotIndex) const
+    {
+        return _map[(posInt.x + posInt.y * _size.x) * 2 + slotIndex];
+    }
+
+    //false for cells that did not obtain one of the two slots of their map position in set_block
+    __device__ __inline__ bool isRegistered(Cell* cell) const
+    {
+        int2 posInt = {floorInt(cell->absPos.x), floorInt(cell->absPos.y)};
+        correctPosition(posInt);
+        auto mapEntry = (posInt.x + posInt.y * _size.x) * 2;
+        return _map[mapEntry] == cell || _map[mapEntry + 1] == cell;
+    }
+
     __device__ __inline__ Cell* getFirst(float2 const& pos) const
     {
         int2 posInt = {floorInt(pos.x), floorInt(pos.y)};
         correctPosition(posInt);
+        if (!isSectorOccupied(posInt)) {
+            return nullptr;
+        }
         auto mapEntry = (posInt.x + posInt.y * _size.x) * 2;
         return _map[mapEntry];
     }
@@ -189,11 +270,50 @@ public:
             _map[mapEntry] = nullptr;
             _map[mapEntry + 1] = nullptr;
         }
+
+        //the map is emptied completely here, so the occupancy bits can simply be cleared alongside
+        auto numOccupancyWords = max(1, (_numSectors.x * _numSectors.y + 31) / 32);
+        auto wordPartition =
+            calcPartition(numOccupancyWords, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        for (int index = wordPartition.startIndex; index <= wordPartition.endIndex; ++index) {
+            _sectorOccupancy[index] = 0;
+        }
     }
 
 private:
+    //expects a corrected position
+    __device__ __inline__ bool isSectorOccupied(int2 const& posInt) const
+    {
+        auto sectorX = posInt.x >> SectorSizeExp;
+        auto sectorY = posInt.y >> SectorSizeExp;
+        if (sectorX >= _numSectors.x || sectorY >= _numSectors.y) {
+            return true;  //border strip is not tracked
+        }
+        auto sectorIndex = sectorX + sectorY * _numSectors.x;
+        return 0 != (_sectorOccupancy[sectorIndex >> 5] & (1u << (sectorIndex & 31)));
+    }
+
+    //checks every sector overlapped by the quadratic neighborhood: samples spaced one sector
+    //apart (plus the clamped far edge) hit each overlapped sector at least once
+    __device__ __inline__ bool isAreaOccupied(int2 const& posInt, int radius) const
+    {
+        auto constexpr step = 1 << SectorSizeExp;
+        for (int dy = -radius; dy - step < radius; dy += step) {
+            for (int dx = -radius; dx - step < radius; dx += step) {
+                int2 scanPos{posInt.x + min(dx, radius), posInt.y + min(dy, radius)};
+                correctPosition(scanPos);
+                if (isSectorOccupied(scanPos)) {
+                    return true;
+                }
+            }
+        }
+        return false;
+    }
+
     Cell** _map;
     Array<int> _mapEntries;
+    unsigned int* _sectorOccupancy;
+    int2 _numSectors;
 };
 
 class ParticleMap : public BaseMap
@@ -1,5 +1,6 @@
 ﻿#include "MonitorKernels.cuh"
 
+#include "Math.cuh"
 #include "Token.cuh"
 
 namespace
@@ -51,13 +52,33 @@ __global__ void cudaGetCudaMonitorData_substep1(SimulationData data, CudaMonitor
 
 __global__ void cudaGetCudaMonitorData_substep2(SimulationData data, CudaMonitorData monitorData)
 {
+    //the counts are first reduced per block in shared memory and pushed to the global counters
+    //once per block; with per-cell global atomics the sweep serializes on the few counter words
+    __shared__ int numCellsByColor[7];
+    __shared__ int numConnections;
+    if (threadIdx.x < 7) {
+        numCellsByColor[threadIdx.x] = 0;
+    }
+    if (0 == threadIdx.x) {
+        numConnections = 0;
+    }
+    __syncthreads();
+
     auto& cells = data.entities.cellPointers;
     auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& cell = cells.at(index);
-        monitorData.incNumCell(calcMod(cell->metadata.color, 7));
-        monitorData.incNumConnections(cell->numConnections);
+        atomicAdd(&numCellsByColor[calcMod(cell->metadata.color, 7)], 1);
+        atomicAdd(&numConnections, cell->numConnections);
+    }
+    __syncthreads();
+
+    if (threadIdx.x < 7) {
+        monitorData.incNumCells(threadIdx.x, numCellsByColor[threadIdx.x]);
+    }
+    if (0 == threadIdx.x) {
+        monitorData.incNumConnections(numConnections);
     }
 }
 
@@ -65,3 +86,144 @@ __global__ void cudaGetCudaMonitorData_substep3(SimulationData data, CudaMonitor
 {
     monitorData.halveNumConnections();
 }
+
+namespace
+{
+    __device__ __inline__ bool isInsideRegion(MonitorRegions::Region const& region, BaseMap const& map, float2 const& pos)
+    {
+        auto delta = float2{region.posX, region.posY} - pos;
+        map.correctDirection(delta);  //the world is toroidal, a region may straddle the boundary
+        if (region.circular) {
+            return Math::lengthSquared(delta) <= region.radius * region.radius;
+        }
+        return abs(delta.x) <= region.width / 2 && abs(delta.y) <= region.height / 2;
+    }
+}
+
+__global__ void cudaGetRegionMonitorData(SimulationData data, CudaMonitorData monitorData, MonitorRegions regions)
+{
+    //like substep2, the counts are first reduced per block in shared memory and pushed to the
+    //global counters once per block and region
+    __shared__ int numCellsByColor[MonitorRegions::MaxRegions][7];
+    __shared__ int numTokens[MonitorRegions::MaxRegions];
+    __shared__ int numParticles[MonitorRegions::MaxRegions];
+    __shared__ float totalEnergy[MonitorRegions::MaxRegions];
+    for (int regionIndex = 0; regionIndex < regions.numRegions; ++regionIndex) {
+        if (threadIdx.x < 7) {
+            numCellsByColor[regionIndex][threadIdx.x] = 0;
+        }
+        if (0 == threadIdx.x) {
+            numTokens[regionIndex] = 0;
+            numParticles[regionIndex] = 0;
+            totalEnergy[regionIndex] = 0;
+        }
+    }
+    __syncthreads();
+
+    {
+        auto& cells = data.entities.cellPointers;
+        auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto& cell = cells.at(index);
+            for (int regionIndex = 0; regionIndex < regions.numRegions; ++regionIndex) {
+                if (isInsideRegion(regions.regions[regionIndex], data.cellMap, cell->absPos)) {
+                    atomicAdd(&numCellsByColor[regionIndex][calcMod(cell->metadata.color, 7)], 1);
+                    atomicAdd(&totalEnergy[regionIndex], cell->energy);
+                }
+            }
+        }
+    }
+    {
+        auto& tokens = data.entities.tokenPointers;
+        auto const partition = calcPartition(tokens.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto& token = tokens.at(index);
+            for (int regionIndex = 0; regionIndex < regions.numRegions; ++regionIndex) {
+                if (isInsideRegion(regions.regions[regionIndex], data.cellMap, token->cell->absPos)) {
+                    atomicAdd(&numTokens[regionIndex], 1);
+                    atomicAdd(&totalEnergy[regionIndex], token->energy);
+                }
+            }
+        }
+    }
+    {
+        auto& particles = data.entities.particlePointers;
+        auto const partition = calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto& particle = particles.at(index);
+            for (int regionIndex = 0; regionIndex < regions.numRegions; ++regionIndex) {
+                if (isInsideRegion(regions.regions[regionIndex], data.particleMap, particle->absPos)) {
+                    atomicAdd(&numParticles[regionIndex], 1);
+                    atomicAdd(&totalEnergy[regionIndex], particle->energy);
+                }
+            }
+        }
+    }
+    __syncthreads();
+
+    for (int regionIndex = 0; regionIndex < regions.numRegions; ++regionIndex) {
+        if (threadIdx.x < 7) {
+            monitorData.incRegionCells(regionIndex, threadIdx.x, numCellsByColor[regionIndex][threadIdx.x]);
+        }
+        if (0 == threadIdx.x) {
+            monitorData.incRegionTokens(regionIndex, numTokens[regionIndex]);
+            monitorData.incRegionParticles(regionIndex, numParticles[regionIndex]);
+            monitorData.incRegionEnergy(regionIndex, totalEnergy[regionIndex]);
+        }
+    }
+}
+
+namespace
+{
+    //splitmix64 finalizer: cheap and well-distributed enough for equality checks
+    __device__ __inline__ uint64_t mixHash(uint64_t value)
+    {
+        value += 0x9e3779b97f4a7c15ull;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ull;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebull;
+        return value ^ (value >> 31);
+    }
+
+    //positions are quantized to 1/1024 so that the hash ignores the least significant bits, which
+    //may differ between otherwise identical checkpoints due to rounding in the transfer path
+    __device__ __inline__ uint64_t quantizePosition(float value)
+    {
+        return static_cast<uint64_t>(llrintf(value * 1024.0f));
+    }
+}
+
+__global__ void cudaCalcWorldHash(SimulationData data, unsigned long long int* hash)
+{
+    //the per-entity hashes are combined via xor, which is commutative => the result depends
+    //neither on the thread scheduling nor on the in-memory order of the entities
+    {
+        auto& cells = data.entities.cellPointers;
+        auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto& cell = cells.at(index);
+            auto entityHash = mixHash(cell->id);
+            entityHash = mixHash(entityHash ^ quantizePosition(cell->absPos.x));
+            entityHash = mixHash(entityHash ^ quantizePosition(cell->absPos.y));
+            for (int i = 0; i < cell->numConnections; ++i) {
+                entityHash = mixHash(entityHash ^ cell->connections[i].cell->id);
+            }
+            atomicXor(hash, static_cast<unsigned long long int>(entityHash));
+        }
+    }
+    {
+        auto& particles = data.entities.particlePointers;
+        auto const partition = calcPartition(particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+        for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+            auto& particle = particles.at(index);
+            auto entityHash = mixHash(~particle->id);  //complement avoids collisions with cells of the same id
+            entityHash = mixHash(entityHash ^ quantizePosition(particle->absPos.x));
+            entityHash = mixHash(entityHash ^ quantizePosition(particle->absPos.y));
+            atomicXor(hash, static_cast<unsigned long long int>(entityHash));
+        }
+    }
+}
@@ -9,3 +9,11 @@
 __global__ void cudaGetCudaMonitorData_substep1(SimulationData data, CudaMonitorData monitorData);
 __global__ void cudaGetCudaMonitorData_substep2(SimulationData data, CudaMonitorData monitorData);
 __global__ void cudaGetCudaMonitorData_substep3(SimulationData data, CudaMonitorData monitorData);
+
+//reduces cell/token/particle counts and energy within each statistics region (parameter spots
+//and user-defined rects); the region counters must have been reset beforehand (see substep1)
+__global__ void cudaGetRegionMonitorData(SimulationData data, CudaMonitorData monitorData, MonitorRegions regions);
+
+//order-independent hash over the world state (entity ids, quantized positions and connections);
+//*hash must be zeroed beforehand
+__global__ void cudaCalcWorldHash(SimulationData data, unsigned long long int* hash);
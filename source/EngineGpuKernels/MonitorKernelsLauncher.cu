@@ -2,9 +2,34 @@
 
 #include "MonitorKernels.cuh"
 
-void _MonitorKernelsLauncher::getMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData)
+_MonitorKernelsLauncher::_MonitorKernelsLauncher()
 {
-    KERNEL_CALL_1_1(cudaGetCudaMonitorData_substep1, data, monitorData);
-    KERNEL_CALL(cudaGetCudaMonitorData_substep2, data, monitorData);
-    KERNEL_CALL_1_1(cudaGetCudaMonitorData_substep3, data, monitorData);
+    CudaMemoryManager::getInstance().acquireMemory<unsigned long long int>(1, _cudaWorldHash);
+}
+
+_MonitorKernelsLauncher::~_MonitorKernelsLauncher()
+{
+    CudaMemoryManager::getInstance().freeMemory(_cudaWorldHash);
+}
+
+void _MonitorKernelsLauncher::getMonitorData(
+    GpuSettings const& gpuSettings,
+    SimulationData const& data,
+    CudaMonitorData const& monitorData,
+    MonitorRegions const& regions,
+    cudaStream_t stream)
+{
+    KERNEL_CALL_1_1_STREAM(stream, cudaGetCudaMonitorData_substep1, data, monitorData);
+    KERNEL_CALL_STREAM(stream, cudaGetCudaMonitorData_substep2, data, monitorData);
+    KERNEL_CALL_1_1_STREAM(stream, cudaGetCudaMonitorData_substep3, data, monitorData);
+    if (regions.numRegions > 0) {
+        KERNEL_CALL_STREAM(stream, cudaGetRegionMonitorData, data, monitorData, regions);
+    }
+}
+
+uint64_t _MonitorKernelsLauncher::calcWorldHash(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    setValueToDevice(_cudaWorldHash, 0ull);
+    KERNEL_CALL(cudaCalcWorldHash, data, _cudaWorldHash);
+    return copyToHost(_cudaWorldHash);  //the copy waits for the kernel
 }
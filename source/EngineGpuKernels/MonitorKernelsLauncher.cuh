@@ -3,13 +3,26 @@
 #include "EngineInterface/GpuSettings.h"
 
 #include "Base.cuh"
+#include "CudaMonitorData.cuh"
 #include "Definitions.cuh"
 #include "Macros.cuh"
 
 class _MonitorKernelsLauncher
 {
 public:
-    void getMonitorData(GpuSettings const& gpuSettings, SimulationData const& data, CudaMonitorData const& monitorData);
+    _MonitorKernelsLauncher();
+    ~_MonitorKernelsLauncher();
+
+    void getMonitorData(
+        GpuSettings const& gpuSettings,
+        SimulationData const& data,
+        CudaMonitorData const& monitorData,
+        MonitorRegions const& regions,
+        cudaStream_t stream = nullptr);
+
+    //order-independent hash over the world state; blocks until the result is available
+    uint64_t calcWorldHash(GpuSettings const& gpuSettings, SimulationData const& data);
 
 private:
+    unsigned long long int* _cudaWorldHash;
 };
@@ -10,6 +10,7 @@
 class MuscleProcessor
 {
 public:
+    template<bool instrumented>
     __inline__ __device__ static void process(Token* token, SimulationData& data, SimulationResult& result);
 
 private:
@@ -20,6 +21,7 @@ private:
 /* Implementation                                                       */
 /************************************************************************/
 
+template<bool instrumented>
 __inline__ __device__ void MuscleProcessor::process(Token* token, SimulationData& data, SimulationResult& result)
 {
     auto const& sourceCell = token->sourceCell;
@@ -58,14 +60,23 @@ __inline__ __device__ void MuscleProcessor::process(Token* token, SimulationData
             auto velInc = cell->absPos - sourceCell->absPos;
             data.cellMap.correctDirection(velInc);
             Math::normalize(velInc);
-            cell->vel = cell->vel + velInc * (origDistance - distance) * 0.5f;
+            auto impulse = velInc * (origDistance - distance) * 0.5f;
+
+            //accumulated into the impulse buffer instead of read-modify-writing the hot vel field:
+            //several muscle tokens can fire on the same cell in this substep and the sum is drained
+            //into vel exactly once per cell in applyFriction
+            auto slot = cell - data.entities.cells.getArray();
+            atomicAdd(&data.cellSoA.impulse[slot].x, impulse.x);
+            atomicAdd(&data.cellSoA.impulse[slot].y, impulse.y);
         }
 
         sourceCell->releaseLock();
     }
 
     tokenMem[Enums::Muscle_Output] = Enums::MuscleOut_Success;
-    result.incMuscleActivity();
+    if constexpr (instrumented) {
+        result.incMuscleActivity();
+    }
 }
 
 __inline__ __device__ int MuscleProcessor::getConnectionIndex(Cell* cell, Cell* otherCell)
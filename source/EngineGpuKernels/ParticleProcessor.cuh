@@ -1,10 +1,11 @@
-#pragma once
+﻿#pragma once
 
 #include "cuda_runtime_api.h"
 #include "sm_60_atomic_functions.h"
 
 #include "AccessTOs.cuh"
 #include "Base.cuh"
+#include "ConstantMemory.cuh"
 #include "Physics.cuh"
 #include "Map.cuh"
 
@@ -13,8 +14,14 @@ class ParticleProcessor
 public:
     __inline__ __device__ void updateMap(SimulationData& data);
     __inline__ __device__ void movement(SimulationData& data);
+    template<bool hasSpots>
     __inline__ __device__ void collision(SimulationData& data);
     __inline__ __device__ void transformation(SimulationData& data);
+
+private:
+    //a particle may take a strided step only if the density map shows no cell along the whole
+    //path; the midpoint is checked as well since a strided step can cross a full slot
+    __inline__ __device__ static bool isStridedPathCellFree(SimulationData& data, Particle const& particle, int stride);
 };
 
 
@@ -32,23 +39,76 @@ __inline__ __device__ void ParticleProcessor::updateMap(SimulationData& data)
 
 __inline__ __device__ void ParticleProcessor::movement(SimulationData& data)
 {
+    //movement is pure streaming work => iterate the dense particle array instead of the pointer
+    //array so that each thread issues sequential loads rather than two dependent scattered ones;
+    //slots of particles deleted since the last compaction are moved as well, which is harmless
+    //since they are no longer referenced anywhere
+    auto& particles = data.entities.particles;
     auto partition = calcPartition(
-        data.entities.particlePointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+        particles.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
+    auto const stride = cudaSimulationParameters.particleSubcyclingStride;
+    auto const timestep = *data.timestep;
     for (int particleIndex = partition.startIndex; particleIndex <= partition.endIndex; ++particleIndex) {
-        auto& particle = data.entities.particlePointers.at(particleIndex);
-        particle->absPos = particle->absPos + particle->vel;
-        data.particleMap.correctPosition(particle->absPos);
+        auto& particle = particles.at(particleIndex);
+        if (data.isFrozen(particle.absPos)) {
+            continue;
+        }
+
+        //subcycling: a particle whose strided path stays clear of cells integrates only every
+        //stride-th timestep with dt scaled accordingly; the phase derives from the particle id so
+        //that the strided updates spread evenly over the timesteps. Switching between the modes
+        //can displace a particle by up to stride times its velocity once, which is irrelevant for
+        //ballistic flight through empty space
+        if (stride > 1 && isStridedPathCellFree(data, particle, stride)) {
+            if (0 != (timestep + particle.id) % stride) {
+                continue;
+            }
+            particle.absPos = particle.absPos + particle.vel * toFloat(stride);
+        } else {
+            particle.absPos = particle.absPos + particle.vel;
+        }
+        data.particleMap.correctPosition(particle.absPos);
     }
 }
 
+__inline__ __device__ bool ParticleProcessor::isStridedPathCellFree(SimulationData& data, Particle const& particle, int stride)
+{
+    auto& densityMap = data.cellFunctionData.densityMap;
+    if (0 != densityMap.getDensities(particle.absPos)) {
+        return false;
+    }
+    auto midPos = particle.absPos + particle.vel * (toFloat(stride) * 0.5f);
+    data.particleMap.correctPosition(midPos);
+    if (0 != densityMap.getDensities(midPos)) {
+        return false;
+    }
+    auto targetPos = particle.absPos + particle.vel * toFloat(stride);
+    data.particleMap.correctPosition(targetPos);
+    return 0 == densityMap.getDensities(targetPos);
+}
+
+template<bool hasSpots>
 __inline__ __device__ void ParticleProcessor::collision(SimulationData& data)
 {
     auto partition = calcPartition(
         data.entities.particlePointers.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
+    auto const stride = cudaSimulationParameters.particleSubcyclingStride;
+    auto const timestep = *data.timestep;
     for (int particleIndex = partition.startIndex; particleIndex <= partition.endIndex; ++particleIndex) {
         auto& particle = data.entities.particlePointers.at(particleIndex);
+        if (data.isFrozen(particle->absPos)) {
+            continue;
+        }
+
+        //subcycled particles in cell-free sectors also collide only on their integration step:
+        //no cell can absorb them there, and particle-particle merging deep in empty space
+        //tolerates the reduced check rate
+        if (stride > 1 && 0 != (timestep + particle->id) % stride
+            && 0 == data.cellFunctionData.densityMap.getDensities(particle->absPos)) {
+            continue;
+        }
         auto otherParticle = data.particleMap.get(particle->absPos);
         if (otherParticle && otherParticle != particle
             && Math::lengthSquared(particle->absPos - otherParticle->absPos) < 0.5) {
@@ -98,7 +158,9 @@ __inline__ __device__ void ParticleProcessor::transformation(SimulationData& dat
 
     for (int particleIndex = partition.startIndex; particleIndex <= partition.endIndex; ++particleIndex) {
         if (auto& particle = data.entities.particlePointers.at(particleIndex)) {
-            
+            if (data.isFrozen(particle->absPos)) {
+                continue;
+            }
             auto cellMinEnergy = SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, particle->absPos);
             if (particle->energy >= cellMinEnergy) {
                 EntityFactory factory;
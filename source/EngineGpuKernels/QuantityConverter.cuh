@@ -1,5 +1,6 @@
 #pragma once
 
+#include "AccessTOs.cuh"
 #include "Base.cuh"
 
 class QuantityConverter
@@ -13,6 +14,13 @@ public:
     __inline__ __device__ static unsigned char convertURealToData(float r);
     __inline__ __device__ static float convertDataToUReal(unsigned char d);
     __inline__ __device__ static unsigned char convertIntToData(int i);
+
+    //batched counterparts of the per-byte copy loops in the scanner and constructor ops; the
+    //blocks move word-wise where the alignment allows, which replaces up to four byte transactions
+    //by one (the host-side DataConverter already copies its blocks via memcpy)
+    __inline__ __device__ static void copyBytes(char* target, char const* source, int numBytes);
+    __inline__ __device__ static void
+    copyTokenMemoryBytes(char* target, char const* tokenMemory, int sourceIndex, int numBytes);
 };
 
 /************************************************************************/
@@ -84,3 +92,40 @@ __inline__ __device__ unsigned char QuantityConverter::convertIntToData(int i)
     }
     return i;
 }
+
+__inline__ __device__ void QuantityConverter::copyBytes(char* target, char const* source, int numBytes)
+{
+    //word-wise only when source and target share the same alignment; the blocks are small, so
+    //misaligned pairs simply keep the byte loop
+    if ((reinterpret_cast<uintptr_t>(target) & 3) == (reinterpret_cast<uintptr_t>(source) & 3)) {
+        while (numBytes > 0 && (reinterpret_cast<uintptr_t>(source) & 3) != 0) {
+            *target++ = *source++;
+            --numBytes;
+        }
+        while (numBytes >= 4) {
+            *reinterpret_cast<uint32_t*>(target) = *reinterpret_cast<uint32_t const*>(source);
+            target += 4;
+            source += 4;
+            numBytes -= 4;
+        }
+    }
+    while (numBytes > 0) {
+        *target++ = *source++;
+        --numBytes;
+    }
+}
+
+__inline__ __device__ void
+QuantityConverter::copyTokenMemoryBytes(char* target, char const* tokenMemory, int sourceIndex, int numBytes)
+{
+    //token memory is addressed modulo MAX_TOKEN_MEM_SIZE, so a block wraps around at most once
+    //and splits into two straight copies
+    sourceIndex %= MAX_TOKEN_MEM_SIZE;
+    auto numBytesUntilEnd = MAX_TOKEN_MEM_SIZE - sourceIndex;
+    if (numBytes <= numBytesUntilEnd) {
+        copyBytes(target, tokenMemory + sourceIndex, numBytes);
+    } else {
+        copyBytes(target, tokenMemory + sourceIndex, numBytesUntilEnd);
+        copyBytes(target + numBytesUntilEnd, tokenMemory, numBytes - numBytesUntilEnd);
+    }
+}
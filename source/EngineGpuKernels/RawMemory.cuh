@@ -12,6 +12,8 @@ class RawMemory
 private:
     uint64_t _size;
     int* _bytesOccupied;
+    int* _maxBytesOccupied;  //high-water mark over all epochs (timesteps) since creation; the basis for judging the arena sizing
+    int* _generation;  //incremented on each compaction; data from older generations may contain garbage
     unsigned char** _data;
 
 public:
@@ -24,8 +26,12 @@ public:
         _size = 0;
         CudaMemoryManager::getInstance().acquireMemory<unsigned char*>(1, _data);
         CudaMemoryManager::getInstance().acquireMemory<int>(1, _bytesOccupied);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _maxBytesOccupied);
+        CudaMemoryManager::getInstance().acquireMemory<int>(1, _generation);
 
         CHECK_FOR_CUDA_ERROR(cudaMemset(_bytesOccupied, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_maxBytesOccupied, 0, sizeof(int)));
+        CHECK_FOR_CUDA_ERROR(cudaMemset(_generation, 0, sizeof(int)));
     }
 
     __host__ __inline__ void resize(uint64_t size)
@@ -44,6 +50,13 @@ public:
 
     uint64_t getSize() const { return _size; }
 
+    __host__ __inline__ int getBytesOccupied_host() const
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _bytesOccupied, sizeof(int), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
     __host__ __inline__ void free()
     {
 
@@ -54,6 +67,8 @@ public:
         }
         CudaMemoryManager::getInstance().freeMemory(_data);
         CudaMemoryManager::getInstance().freeMemory(_bytesOccupied);
+        CudaMemoryManager::getInstance().freeMemory(_maxBytesOccupied);
+        CudaMemoryManager::getInstance().freeMemory(_generation);
         _size = 0;
     }
 
@@ -91,11 +106,26 @@ public:
     }
     __host__ __inline__ void setNumBytes_host(int value) { checkCudaErrors(cudaMemcpy(_bytesOccupied, &value, sizeof(int), cudaMemcpyHostToDevice)); }
 
-    __device__ __inline__ void reset() { *_bytesOccupied = 0; }
+    //an epoch ends here: the occupancy is folded into the high-water mark before it is cleared
+    __device__ __inline__ void reset()
+    {
+        *_maxBytesOccupied = max(*_maxBytesOccupied, *_bytesOccupied);
+        *_bytesOccupied = 0;
+    }
+
+    __host__ __inline__ int getMaxBytesOccupied_host() const
+    {
+        int result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _maxBytesOccupied, sizeof(int), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
+    __device__ __inline__ int getGeneration() { return *_generation; }
 
     __device__ __inline__ void swapContent(RawMemory& other)
     {
         swap(*_bytesOccupied, *other._bytesOccupied);
         swap(*_data, *other._data);
+        ++(*_generation);
     }
 };
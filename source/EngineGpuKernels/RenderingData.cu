@@ -1,17 +1,98 @@
-﻿#include "RenderingData.cuh"
+#include "RenderingData.cuh"
 
-void RenderingData::init() {}
+void RenderingData::init()
+{
+    //the rendering buffers are the lowest-priority consumer of device memory: under pressure they
+    //are evicted so that simulation growth does not fail, and they are rebuilt on the next frame
+    evictionHandle = CudaMemoryManager::getInstance().registerEvictionHandler(Const::EvictionPriorityRenderingBuffers, [this] {
+        if (evictionLocked || (0 == numPixels && 0 == numTiles && 0 == numTileCellEntries)) {
+            return false;
+        }
+        freeBuffers();
+        return true;
+    });
+}
 
 void RenderingData::resizeImageIfNecessary(int2 const& newSize)
 {
     if (newSize.x * newSize.y > numPixels) {
         CudaMemoryManager::getInstance().freeMemory(imageData);
+        CudaMemoryManager::getInstance().freeMemory(imageDataBack);
+
+        //the allocations below may trigger the eviction handler, which must not see stale state
+        imageData = nullptr;
+        imageDataBack = nullptr;
+        numPixels = 0;
+        frontValid = false;
+
         CudaMemoryManager::getInstance().acquireMemory<uint64_t>(newSize.x * newSize.y, imageData);
+        CudaMemoryManager::getInstance().acquireMemory<uint64_t>(newSize.x * newSize.y, imageDataBack);
         numPixels = newSize.x * newSize.y;
     }
 }
 
-void RenderingData::free()
+bool RenderingData::tileDataNeedsResize(int2 const& imageSize, int numCells) const
+{
+    auto newNumTiles = ((imageSize.x + Const::RenderingTileSize - 1) / Const::RenderingTileSize)
+        * ((imageSize.y + Const::RenderingTileSize - 1) / Const::RenderingTileSize);
+    return newNumTiles > numTiles || numCells * 4 > numTileCellEntries;
+}
+
+void RenderingData::resizeTileDataIfNecessary(int2 const& imageSize, int numCells)
+{
+    auto newNumTiles = ((imageSize.x + Const::RenderingTileSize - 1) / Const::RenderingTileSize)
+        * ((imageSize.y + Const::RenderingTileSize - 1) / Const::RenderingTileSize);
+    if (newNumTiles > numTiles) {
+        CudaMemoryManager::getInstance().freeMemory(tileCellCursors);
+        CudaMemoryManager::getInstance().freeMemory(tileCellOffsets);
+        tileCellCursors = nullptr;
+        tileCellOffsets = nullptr;
+        numTiles = 0;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(newNumTiles + 1, tileCellCursors);
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(newNumTiles + 1, tileCellOffsets);
+        numTiles = newNumTiles;
+    }
+
+    //the dot pattern of a cell spans at most 4 x 4 pixels, so a cell is binned into at most 2 x 2 tiles
+    auto newNumTileCellEntries = numCells * 4;
+    if (newNumTileCellEntries > numTileCellEntries) {
+        CudaMemoryManager::getInstance().freeMemory(tileCells);
+        tileCells = nullptr;
+        numTileCellEntries = 0;
+        CudaMemoryManager::getInstance().acquireMemory<unsigned int>(newNumTileCellEntries, tileCells);
+        numTileCellEntries = newNumTileCellEntries;
+    }
+}
+
+void RenderingData::swapBuffers()
+{
+    auto temp = imageData;
+    imageData = imageDataBack;
+    imageDataBack = temp;
+    frontValid = true;
+}
+
+void RenderingData::freeBuffers()
 {
     CudaMemoryManager::getInstance().freeMemory(imageData);
+    CudaMemoryManager::getInstance().freeMemory(imageDataBack);
+    CudaMemoryManager::getInstance().freeMemory(tileCellCursors);
+    CudaMemoryManager::getInstance().freeMemory(tileCellOffsets);
+    CudaMemoryManager::getInstance().freeMemory(tileCells);
+
+    imageData = nullptr;
+    imageDataBack = nullptr;
+    tileCellCursors = nullptr;
+    tileCellOffsets = nullptr;
+    tileCells = nullptr;
+    numPixels = 0;
+    numTiles = 0;
+    numTileCellEntries = 0;
+    frontValid = false;
+}
+
+void RenderingData::free()
+{
+    CudaMemoryManager::getInstance().unregisterEvictionHandler(evictionHandle);
+    freeBuffers();
 }
@@ -5,12 +5,38 @@
 #include "Base.cuh"
 #include "Definitions.cuh"
 
+namespace Const
+{
+    //edge length of a screen tile in pixels for the tile-based cell renderer
+    int const RenderingTileSize = 16;
+}
+
 struct RenderingData
 {
     int numPixels = 0;
+
+    //double-buffered target: the front buffer holds the last completed frame and can be presented
+    //while the next frame is drawn into the back buffer on the rendering stream
     uint64_t* imageData = nullptr;  //pixel in bbbbggggrrrr format (3 x 16 bit + 16 bit unused)
+    uint64_t* imageDataBack = nullptr;
+    bool frontValid = false;
+
+    //tile binning for the zoomed-out cell renderer: the cells are grouped by the screen tiles
+    //their dots touch and each tile is composited in shared memory
+    int numTiles = 0;
+    int numTileCellEntries = 0;
+    unsigned int* tileCellCursors = nullptr;    //numTiles + 1 entries; counts, then fill cursors
+    unsigned int* tileCellOffsets = nullptr;    //numTiles + 1 entries; begin of each tile's range in tileCells
+    unsigned int* tileCells = nullptr;          //cell indices, grouped by tile
+
+    int evictionHandle = -1;  //registration with the memory budget of CudaMemoryManager; the buffers are evicted under pressure and rebuilt on the next frame
+    bool evictionLocked = false;  //held by the owner while a frame is in flight: the buffers are then referenced by queued kernels and must not be reclaimed
 
     void init();
     void resizeImageIfNecessary(int2 const& newSize);
+    bool tileDataNeedsResize(int2 const& imageSize, int numCells) const;
+    void resizeTileDataIfNecessary(int2 const& imageSize, int numCells);
+    void swapBuffers();
+    void freeBuffers();
     void free();
 };
@@ -25,39 +25,36 @@ namespace
         return float2{(pos.x - rectUpperLeft.x) * zoom, (pos.y - rectUpperLeft.y) * zoom};
     }
 
-    __device__ __inline__ float3 calcColor(Cell* cell, int selected)
+    __device__ __inline__ uint32_t calcIndividualCellColor(int color)
     {
-        uint32_t cellColor;
-        switch (cell->metadata.color % 7) {
+        switch (color % 7) {
         case 0: {
-            cellColor = Const::IndividualCellColor1;
-            break;
+            return Const::IndividualCellColor1;
         }
         case 1: {
-            cellColor = Const::IndividualCellColor2;
-            break;
+            return Const::IndividualCellColor2;
         }
         case 2: {
-            cellColor = Const::IndividualCellColor3;
-            break;
+            return Const::IndividualCellColor3;
         }
         case 3: {
-            cellColor = Const::IndividualCellColor4;
-            break;
+            return Const::IndividualCellColor4;
         }
         case 4: {
-            cellColor = Const::IndividualCellColor5;
-            break;
+            return Const::IndividualCellColor5;
         }
         case 5: {
-            cellColor = Const::IndividualCellColor6;
-            break;
+            return Const::IndividualCellColor6;
         }
-        case 6: {
-            cellColor = Const::IndividualCellColor7;
-            break;
+        default: {
+            return Const::IndividualCellColor7;
         }
         }
+    }
+
+    __device__ __inline__ float3 calcColor(Cell* cell, int selected)
+    {
+        uint32_t cellColor = calcIndividualCellColor(cell->metadata.color);
 
         float factor = min(300.0f, cell->energy) / 320.0f;
         if (1 == selected) {
@@ -143,6 +140,76 @@ namespace
             pos = pos + v;
         }
     }
+
+    //*** tile-based cell renderer for zoomed-out views ***
+    //below Const::ZoomLevelForTileRendering a cell is a plain dot without connection lines; the
+    //cells are binned into screen tiles and each tile is composited in shared memory, so the
+    //blending needs no global atomics even for dense populations
+
+    __device__ __inline__ int2 calcTileGridSize(int2 const& imageSize)
+    {
+        return {
+            (imageSize.x + Const::RenderingTileSize - 1) / Const::RenderingTileSize,
+            (imageSize.y + Const::RenderingTileSize - 1) / Const::RenderingTileSize};
+    }
+
+    //range of tiles touched by the dot pattern of a cell; false if it lies outside the image
+    __device__ __inline__ bool calcTileRange(float2 const& imagePos, int2 const& imageSize, int2& tileStart, int2& tileEnd)
+    {
+        int2 minPixel{toInt(imagePos.x) - 1, toInt(imagePos.y) - 1};
+        int2 maxPixel{toInt(imagePos.x) + 2, toInt(imagePos.y) + 2};
+        if (maxPixel.x < 0 || maxPixel.y < 0 || minPixel.x >= imageSize.x || minPixel.y >= imageSize.y) {
+            return false;
+        }
+        tileStart = {max(minPixel.x, 0) / Const::RenderingTileSize, max(minPixel.y, 0) / Const::RenderingTileSize};
+        tileEnd = {min(maxPixel.x, imageSize.x - 1) / Const::RenderingTileSize, min(maxPixel.y, imageSize.y - 1) / Const::RenderingTileSize};
+        return true;
+    }
+
+    //one screen tile accumulated in shared memory; pixels outside the tile are dropped since the
+    //neighboring tile draws them itself
+    struct TileImage
+    {
+        float* color;    //3 floats per pixel
+        int2 origin;
+
+        __device__ __inline__ void addPixel(int x, int y, float3 const& colorToAdd)
+        {
+            auto tileX = x - origin.x;
+            auto tileY = y - origin.y;
+            if (tileX < 0 || tileX >= Const::RenderingTileSize || tileY < 0 || tileY >= Const::RenderingTileSize) {
+                return;
+            }
+            auto index = (tileX + tileY * Const::RenderingTileSize) * 3;
+            atomicAdd(&color[index], colorToAdd.x);
+            atomicAdd(&color[index + 1], colorToAdd.y);
+            atomicAdd(&color[index + 2], colorToAdd.z);
+        }
+    };
+
+    __device__ __inline__ void drawDotToTile(TileImage& tileImage, int2 const& imageSize, float2 const& pos, float3 const& colorToAdd)
+    {
+        int2 intPos{toInt(pos.x), toInt(pos.y)};
+        if (intPos.x >= 1 && intPos.x < imageSize.x - 1 && intPos.y >= 1 && intPos.y < imageSize.y - 1) {
+            float2 posFrac{pos.x - intPos.x, pos.y - intPos.y};
+            tileImage.addPixel(intPos.x, intPos.y, colorToAdd * (1.0f - posFrac.x) * (1.0f - posFrac.y));
+            tileImage.addPixel(intPos.x + 1, intPos.y, colorToAdd * posFrac.x * (1.0f - posFrac.y));
+            tileImage.addPixel(intPos.x, intPos.y + 1, colorToAdd * (1.0f - posFrac.x) * posFrac.y);
+            tileImage.addPixel(intPos.x + 1, intPos.y + 1, colorToAdd * posFrac.x * posFrac.y);
+        }
+    }
+
+    //same dot pattern as the small-radius branch of drawCircle
+    __device__ __inline__ void drawCellDotToTile(TileImage& tileImage, int2 const& imageSize, float2 const& pos, float3 color, float radius)
+    {
+        color = color * radius * 2;
+        drawDotToTile(tileImage, imageSize, pos, color);
+        color = color * 0.3f;
+        drawDotToTile(tileImage, imageSize, pos + float2{1, 0}, color);
+        drawDotToTile(tileImage, imageSize, pos + float2{-1, 0}, color);
+        drawDotToTile(tileImage, imageSize, pos + float2{0, 1}, color);
+        drawDotToTile(tileImage, imageSize, pos + float2{0, -1}, color);
+    }
 }
 
 /************************************************************************/
@@ -251,6 +318,271 @@ __global__ void cudaDrawCells(int2 universeSize, float2 rectUpperLeft, float2 re
     }
 }
 
+__global__ void cudaDrawCellsDensityLod(int2 worldSize, float2 rectUpperLeft, DensityMap densityMap, uint64_t* imageData, int2 imageSize, float zoom)
+{
+    auto const partition = calcPartition(imageSize.x * imageSize.y, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    //at extreme overview zoom the pre-aggregated coarse level yields the same average with a
+    //fraction of the reads per pixel
+    auto useCoarseLevel = zoom < Const::ZoomLevelForCoarseDensityLodRendering;
+    auto slotSize = useCoarseLevel ? toFloat(densityMap.getCoarseSlotSize()) : toFloat(densityMap.getSlotSize());
+
+    //brightness of one cell as the small-radius branch of drawCircle would draw it, with a
+    //nominal energy factor instead of the per-cell energy
+    auto brightnessPerCell = 0.3f * zoom * 2 / 3;
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto x = index % imageSize.x;
+        auto y = index / imageSize.x;
+        float2 worldStart{toFloat(x) / zoom + rectUpperLeft.x, toFloat(y) / zoom + rectUpperLeft.y};
+        if (worldStart.x < 0 || worldStart.y < 0 || worldStart.x >= worldSize.x || worldStart.y >= worldSize.y) {
+            continue;
+        }
+        float2 worldEnd{worldStart.x + 1.0f / zoom, worldStart.y + 1.0f / zoom};
+
+        //a pixel covers several density slots at overview zoom; the covered slots are averaged
+        float3 colorSum{0, 0, 0};
+        int numSlots = 0;
+        for (float worldY = worldStart.y; worldY < worldEnd.y; worldY += slotSize) {
+            for (float worldX = worldStart.x; worldX < worldEnd.x; worldX += slotSize) {
+                uint64_t densities = 0;
+                if (!useCoarseLevel) {
+                    densities = densityMap.getDensities({worldX, worldY});
+                }
+                for (int color = 0; color < 7; ++color) {
+                    auto count = useCoarseLevel ? toFloat(toInt(densityMap.getCoarseDensity({worldX, worldY}, color)))
+                                                : toFloat(toInt((densities >> (color * 8)) & 0xff));
+                    if (count > 0) {
+                        auto cellColor = calcIndividualCellColor(color);
+                        colorSum.x += toFloat((cellColor >> 16) & 0xff) / 256.0f * count;
+                        colorSum.y += toFloat((cellColor >> 8) & 0xff) / 256.0f * count;
+                        colorSum.z += toFloat(cellColor & 0xff) / 256.0f * count;
+                    }
+                }
+                ++numSlots;
+            }
+        }
+
+        //cells per pixel = average density per world area times the world area of the pixel
+        auto scale = brightnessPerCell / (toFloat(numSlots) * slotSize * slotSize * zoom * zoom);
+        auto color = colorSum * scale;
+        auto rawColor = min(toUInt64(color.y * 255.0f), 0xffffull) << 16 | min(toUInt64(color.x * 255.0f), 0xffffull)
+            | min(toUInt64(color.z * 255.0f), 0xffffull) << 32;
+        if (0 != rawColor) {
+            imageData[index] += rawColor;
+        }
+    }
+}
+
+__global__ void cudaBuildCoarseDensityLod(DensityMap densityMap)
+{
+    densityMap.buildCoarseLevel();
+}
+
+namespace
+{
+    //a channel of the thumbnail saturates at this cell density (cells per world area); chosen so
+    //that colonies stand out clearly while single drifting cells remain faintly visible
+    auto constexpr ThumbnailFullBrightnessDensity = 0.125f;
+}
+
+__global__ void cudaDrawThumbnail(int2 worldSize, DensityMap densityMap, uint64_t* imageData, int2 imageSize)
+{
+    auto const partition = calcAllThreadsPartition(imageSize.x * imageSize.y);
+
+    auto slotSize = toFloat(densityMap.getCoarseSlotSize());
+    float2 worldPerPixel{toFloat(worldSize.x) / toFloat(imageSize.x), toFloat(worldSize.y) / toFloat(imageSize.y)};
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto x = index % imageSize.x;
+        auto y = index / imageSize.x;
+        float2 worldStart{toFloat(x) * worldPerPixel.x, toFloat(y) * worldPerPixel.y};
+        float2 worldEnd{worldStart.x + worldPerPixel.x, worldStart.y + worldPerPixel.y};
+
+        //a thumbnail pixel covers several coarse slots; the covered slots are averaged
+        float3 colorSum{0, 0, 0};
+        int numSlots = 0;
+        for (float worldY = worldStart.y; worldY < worldEnd.y; worldY += slotSize) {
+            for (float worldX = worldStart.x; worldX < worldEnd.x; worldX += slotSize) {
+                for (int color = 0; color < 7; ++color) {
+                    auto count = toFloat(toInt(densityMap.getCoarseDensity({worldX, worldY}, color)));
+                    if (count > 0) {
+                        auto cellColor = calcIndividualCellColor(color);
+                        colorSum.x += toFloat((cellColor >> 16) & 0xff) / 256.0f * count;
+                        colorSum.y += toFloat((cellColor >> 8) & 0xff) / 256.0f * count;
+                        colorSum.z += toFloat(cellColor & 0xff) / 256.0f * count;
+                    }
+                }
+                ++numSlots;
+            }
+        }
+
+        //average density per world area, scaled so that ThumbnailFullBrightnessDensity saturates
+        //a channel; written in the 16 bit lane convention of the other renderers
+        auto scale = 1.0f / (ThumbnailFullBrightnessDensity * toFloat(numSlots) * slotSize * slotSize);
+        auto color = colorSum * scale;
+        imageData[index] = min(toUInt64(color.y * 65280.0f), 0xffffull) << 16 | min(toUInt64(color.x * 65280.0f), 0xffffull)
+            | min(toUInt64(color.z * 65280.0f), 0xffffull) << 32;
+    }
+}
+
+__global__ void cudaResetTileCursors(unsigned int* tileCellCursors, int2 imageSize)
+{
+    auto tileGridSize = calcTileGridSize(imageSize);
+    auto const partition = calcPartition(tileGridSize.x * tileGridSize.y + 1, threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        tileCellCursors[index] = 0;
+    }
+}
+
+__global__ void
+cudaCountCellsPerTile(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Array<Cell*> cells, int2 imageSize, float zoom, unsigned int* tileCellCursors)
+{
+    auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    BaseMap map;
+    map.init(universeSize);
+    auto tileGridSize = calcTileGridSize(imageSize);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& cell = cells.at(index);
+
+        auto cellPos = cell->absPos;
+        map.correctPosition(cellPos);
+        if (isContainedInRect(rectUpperLeft, rectLowerRight, cellPos)) {
+            auto cellImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, cellPos, zoom);
+            int2 tileStart, tileEnd;
+            if (calcTileRange(cellImagePos, imageSize, tileStart, tileEnd)) {
+                for (int tileY = tileStart.y; tileY <= tileEnd.y; ++tileY) {
+                    for (int tileX = tileStart.x; tileX <= tileEnd.x; ++tileX) {
+                        atomicAdd(&tileCellCursors[tileX + tileY * tileGridSize.x], 1);
+                    }
+                }
+            }
+        }
+    }
+}
+
+//single-threaded: the tile count is a few thousand and the scan is not measurable next to the
+//draw kernels
+__global__ void cudaCalcTileOffsets(unsigned int* tileCellCursors, unsigned int* tileCellOffsets, int2 imageSize)
+{
+    auto tileGridSize = calcTileGridSize(imageSize);
+    auto numTiles = tileGridSize.x * tileGridSize.y;
+    unsigned int sum = 0;
+    for (int index = 0; index < numTiles; ++index) {
+        auto count = tileCellCursors[index];
+        tileCellOffsets[index] = sum;
+        tileCellCursors[index] = sum;    //reused as fill cursor by cudaBinCellsToTiles
+        sum += count;
+    }
+    tileCellOffsets[numTiles] = sum;
+}
+
+__global__ void cudaBinCellsToTiles(
+    int2 universeSize,
+    float2 rectUpperLeft,
+    float2 rectLowerRight,
+    Array<Cell*> cells,
+    int2 imageSize,
+    float zoom,
+    unsigned int* tileCellCursors,
+    unsigned int* tileCellOffsets,
+    unsigned int* tileCells)
+{
+    auto const partition = calcPartition(cells.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
+
+    BaseMap map;
+    map.init(universeSize);
+    auto tileGridSize = calcTileGridSize(imageSize);
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto const& cell = cells.at(index);
+
+        auto cellPos = cell->absPos;
+        map.correctPosition(cellPos);
+        if (isContainedInRect(rectUpperLeft, rectLowerRight, cellPos)) {
+            auto cellImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, cellPos, zoom);
+            int2 tileStart, tileEnd;
+            if (calcTileRange(cellImagePos, imageSize, tileStart, tileEnd)) {
+                for (int tileY = tileStart.y; tileY <= tileEnd.y; ++tileY) {
+                    for (int tileX = tileStart.x; tileX <= tileEnd.x; ++tileX) {
+                        auto tileIndex = tileX + tileY * tileGridSize.x;
+                        auto slot = atomicAdd(&tileCellCursors[tileIndex], 1);
+
+                        //the simulation runs concurrently and a cell can move between the count
+                        //and the fill pass; such a cell is dropped for this frame
+                        if (slot < tileCellOffsets[tileIndex + 1]) {
+                            tileCells[slot] = index;
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
+
+__global__ void cudaDrawCellsTiled(
+    int2 universeSize,
+    float2 rectUpperLeft,
+    Array<Cell*> cells,
+    uint64_t* imageData,
+    int2 imageSize,
+    float zoom,
+    unsigned int* tileCellCursors,
+    unsigned int* tileCellOffsets,
+    unsigned int* tileCells)
+{
+    __shared__ float tileColor[Const::RenderingTileSize * Const::RenderingTileSize * 3];
+
+    BaseMap map;
+    map.init(universeSize);
+    auto tileGridSize = calcTileGridSize(imageSize);
+    auto numTiles = tileGridSize.x * tileGridSize.y;
+
+    for (int tileIndex = blockIdx.x; tileIndex < numTiles; tileIndex += gridDim.x) {
+        auto start = tileCellOffsets[tileIndex];
+        auto end = min(tileCellOffsets[tileIndex + 1], tileCellCursors[tileIndex]);    //the fill pass may have dropped entries
+        if (start == end) {
+            continue;
+        }
+
+        for (int i = threadIdx.x; i < Const::RenderingTileSize * Const::RenderingTileSize * 3; i += blockDim.x) {
+            tileColor[i] = 0;
+        }
+        __syncthreads();
+
+        TileImage tileImage{
+            tileColor,
+            {tileIndex % tileGridSize.x * Const::RenderingTileSize, tileIndex / tileGridSize.x * Const::RenderingTileSize}};
+        for (auto slot = start + threadIdx.x; slot < end; slot += blockDim.x) {
+            auto const& cell = cells.at(toInt(tileCells[slot]));
+
+            auto cellPos = cell->absPos;
+            map.correctPosition(cellPos);
+            auto cellImagePos = mapUniversePosToVectorImagePos(rectUpperLeft, cellPos, zoom);
+            auto color = calcColor(cell, cell->selected);
+            auto radius = 1 == cell->selected ? zoom / 2 : zoom / 3;
+            drawCellDotToTile(tileImage, imageSize, cellImagePos, color, radius);
+        }
+        __syncthreads();
+
+        //one plain global write per pixel; no other block touches this tile
+        for (int i = threadIdx.x; i < Const::RenderingTileSize * Const::RenderingTileSize; i += blockDim.x) {
+            auto x = tileImage.origin.x + i % Const::RenderingTileSize;
+            auto y = tileImage.origin.y + i / Const::RenderingTileSize;
+            if (x < imageSize.x && y < imageSize.y) {
+                auto rawColor = min(toUInt64(tileColor[i * 3 + 1] * 255.0f), 0xffffull) << 16
+                    | min(toUInt64(tileColor[i * 3] * 255.0f), 0xffffull) | min(toUInt64(tileColor[i * 3 + 2] * 255.0f), 0xffffull) << 32;
+                if (0 != rawColor) {
+                    imageData[x + y * imageSize.x] += rawColor;
+                }
+            }
+        }
+        __syncthreads();
+    }
+}
+
 __global__ void
 cudaDrawTokens(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Array<Token*> tokens, uint64_t* imageData, int2 imageSize, float zoom)
 {
@@ -17,6 +17,47 @@
 __global__ void cudaDrawBackground(uint64_t* imageData, int2 imageSize, int2 worldSize, float zoom, float2 rectUpperLeft, float2 rectLowerRight);
 __global__ void
 cudaDrawCells(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Array<Cell*> cells, uint64_t* imageData, int2 imageSize, float zoom);
+
+//level-of-detail renderer for overview zoom: samples the density map that the simulation
+//maintains for the sensors instead of iterating the cells, so the cost is per pixel and
+//independent of the population size
+__global__ void cudaDrawCellsDensityLod(int2 worldSize, float2 rectUpperLeft, DensityMap densityMap, uint64_t* imageData, int2 imageSize, float zoom);
+
+//rebuilds the coarse level of the density map from the base slots; must run before
+//cudaDrawCellsDensityLod whenever the zoom is below ZoomLevelForCoarseDensityLodRendering
+__global__ void cudaBuildCoarseDensityLod(DensityMap densityMap);
+
+//renders the entire world into a small thumbnail image from the coarse density level; used by
+//the navigation minimap, so the cost is per thumbnail pixel and independent of both the
+//population size and the main view. Requires cudaBuildCoarseDensityLod to have run before
+__global__ void cudaDrawThumbnail(int2 worldSize, DensityMap densityMap, uint64_t* imageData, int2 imageSize);
+
+//tile-based cell renderer for zoomed-out views: the cells are counted and binned per screen tile
+//and each tile is composited in shared memory before one global write per pixel
+__global__ void cudaResetTileCursors(unsigned int* tileCellCursors, int2 imageSize);
+__global__ void
+cudaCountCellsPerTile(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Array<Cell*> cells, int2 imageSize, float zoom, unsigned int* tileCellCursors);
+__global__ void cudaCalcTileOffsets(unsigned int* tileCellCursors, unsigned int* tileCellOffsets, int2 imageSize);
+__global__ void cudaBinCellsToTiles(
+    int2 universeSize,
+    float2 rectUpperLeft,
+    float2 rectLowerRight,
+    Array<Cell*> cells,
+    int2 imageSize,
+    float zoom,
+    unsigned int* tileCellCursors,
+    unsigned int* tileCellOffsets,
+    unsigned int* tileCells);
+__global__ void cudaDrawCellsTiled(
+    int2 universeSize,
+    float2 rectUpperLeft,
+    Array<Cell*> cells,
+    uint64_t* imageData,
+    int2 imageSize,
+    float zoom,
+    unsigned int* tileCellCursors,
+    unsigned int* tileCellOffsets,
+    unsigned int* tileCells);
 __global__ void
 cudaDrawTokens(int2 universeSize, float2 rectUpperLeft, float2 rectLowerRight, Array<Token*> tokens, uint64_t* imageData, int2 imageSize, float zoom);
 __global__ void
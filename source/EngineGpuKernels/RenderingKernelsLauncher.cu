@@ -10,13 +10,74 @@ void _RenderingKernelsLauncher::drawImage(
     int2 imageSize,
     float zoom,
     SimulationData data,
-    RenderingData renderingData)
+    RenderingData renderingData,
+    cudaStream_t stream)
 {
-    uint64_t* targetImage = renderingData.imageData;
+    uint64_t* targetImage = renderingData.imageDataBack;
 
-    KERNEL_CALL(cudaDrawBackground, targetImage, imageSize, data.worldSize, zoom, rectUpperLeft, rectLowerRight);
-    KERNEL_CALL(cudaDrawCells, data.worldSize, rectUpperLeft, rectLowerRight, data.entities.cellPointers, targetImage, imageSize, zoom);
-    KERNEL_CALL(cudaDrawTokens, data.worldSize, rectUpperLeft, rectLowerRight, data.entities.tokenPointers, targetImage, imageSize, zoom);
-    KERNEL_CALL(cudaDrawParticles, data.worldSize, rectUpperLeft, rectLowerRight, data.entities.particlePointers, targetImage, imageSize, zoom);
-    KERNEL_CALL_1_1(cudaDrawFlowCenters, targetImage, rectUpperLeft, imageSize, zoom);
+    KERNEL_CALL_STREAM(stream, cudaDrawBackground, targetImage, imageSize, data.worldSize, zoom, rectUpperLeft, rectLowerRight);
+    if (zoom < Const::ZoomLevelForDensityLodRendering) {
+        //overview zoom: each pixel aggregates hundreds of cells, so the image is rendered from
+        //the density map that the simulation maintains for the sensors anyway
+        if (zoom < Const::ZoomLevelForCoarseDensityLodRendering) {
+            KERNEL_CALL_STREAM(stream, cudaBuildCoarseDensityLod, data.cellFunctionData.densityMap);
+        }
+        KERNEL_CALL_STREAM(
+            stream, cudaDrawCellsDensityLod, data.worldSize, rectUpperLeft, data.cellFunctionData.densityMap, targetImage, imageSize, zoom);
+    } else if (zoom < Const::ZoomLevelForTileRendering) {
+        //dense zoomed-out views collapse the per-pixel atomics of cudaDrawCells; the cells are
+        //binned into screen tiles and each tile is composited in shared memory instead
+        KERNEL_CALL_STREAM(stream, cudaResetTileCursors, renderingData.tileCellCursors, imageSize);
+        KERNEL_CALL_STREAM(
+            stream,
+            cudaCountCellsPerTile,
+            data.worldSize,
+            rectUpperLeft,
+            rectLowerRight,
+            data.entities.cellPointers,
+            imageSize,
+            zoom,
+            renderingData.tileCellCursors);
+        KERNEL_CALL_1_1_STREAM(stream, cudaCalcTileOffsets, renderingData.tileCellCursors, renderingData.tileCellOffsets, imageSize);
+        KERNEL_CALL_STREAM(
+            stream,
+            cudaBinCellsToTiles,
+            data.worldSize,
+            rectUpperLeft,
+            rectLowerRight,
+            data.entities.cellPointers,
+            imageSize,
+            zoom,
+            renderingData.tileCellCursors,
+            renderingData.tileCellOffsets,
+            renderingData.tileCells);
+        KERNEL_CALL_STREAM(
+            stream,
+            cudaDrawCellsTiled,
+            data.worldSize,
+            rectUpperLeft,
+            data.entities.cellPointers,
+            targetImage,
+            imageSize,
+            zoom,
+            renderingData.tileCellCursors,
+            renderingData.tileCellOffsets,
+            renderingData.tileCells);
+    } else {
+        KERNEL_CALL_STREAM(stream, cudaDrawCells, data.worldSize, rectUpperLeft, rectLowerRight, data.entities.cellPointers, targetImage, imageSize, zoom);
+    }
+    KERNEL_CALL_STREAM(stream, cudaDrawTokens, data.worldSize, rectUpperLeft, rectLowerRight, data.entities.tokenPointers, targetImage, imageSize, zoom);
+    KERNEL_CALL_STREAM(stream, cudaDrawParticles, data.worldSize, rectUpperLeft, rectLowerRight, data.entities.particlePointers, targetImage, imageSize, zoom);
+    KERNEL_CALL_1_1_STREAM(stream, cudaDrawFlowCenters, targetImage, rectUpperLeft, imageSize, zoom);
+}
+
+void _RenderingKernelsLauncher::drawThumbnail(
+    GpuSettings const& gpuSettings,
+    SimulationData data,
+    uint64_t* targetImage,
+    int2 imageSize,
+    cudaStream_t stream)
+{
+    KERNEL_CALL_STREAM(stream, cudaBuildCoarseDensityLod, data.cellFunctionData.densityMap);
+    KERNEL_CALL_STREAM(stream, cudaDrawThumbnail, data.worldSize, data.cellFunctionData.densityMap, targetImage, imageSize);
 }
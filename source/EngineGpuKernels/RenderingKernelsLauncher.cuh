@@ -19,5 +19,10 @@ public:
         int2 imageSize,
         float zoom,
         SimulationData data,
-        RenderingData renderingData);
+        RenderingData renderingData,
+        cudaStream_t stream = nullptr);
+
+    //renders the whole world into a small thumbnail image from the density map that the
+    //simulation maintains for the sensors; no cell-level rendering is involved
+    void drawThumbnail(GpuSettings const& gpuSettings, SimulationData data, uint64_t* targetImage, int2 imageSize, cudaStream_t stream = nullptr);
 };
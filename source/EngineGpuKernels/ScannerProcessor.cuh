@@ -98,21 +98,25 @@ __device__ __inline__ void ScannerProcessor::process(Token* token, SimulationDat
     tokenMem[Enums::Scanner_OutCellColor] = lookupResult.prevCell->metadata.color;
     tokenMem[Enums::Scanner_OutCellFunction] = static_cast<char>(lookupResult.prevCell->getCellFunctionType());
     tokenMem[Enums::Scanner_OutCellFunctionData] = lookupResult.prevCell->numStaticBytes;
-    for (int i = 0; i < lookupResult.prevCell->numStaticBytes; ++i) {
-        tokenMem[Enums::Scanner_OutCellFunctionData + 1 + i] = lookupResult.prevCell->staticData[i];
-    }
+    QuantityConverter::copyBytes(
+        &tokenMem[Enums::Scanner_OutCellFunctionData + 1],
+        lookupResult.prevCell->staticData,
+        lookupResult.prevCell->numStaticBytes);
     int mutableDataIndex = lookupResult.prevCell->numStaticBytes + 1;
     tokenMem[Enums::Scanner_OutCellFunctionData + mutableDataIndex] = lookupResult.prevCell->numMutableBytes;
-    for (int i = 0; i < lookupResult.prevCell->numMutableBytes; ++i) {
-        tokenMem[Enums::Scanner_OutCellFunctionData + mutableDataIndex + 1 + i] = lookupResult.prevCell->mutableData[i];
-    }
+    QuantityConverter::copyBytes(
+        &tokenMem[Enums::Scanner_OutCellFunctionData + mutableDataIndex + 1],
+        lookupResult.prevCell->mutableData,
+        lookupResult.prevCell->numMutableBytes);
 }
 
 __device__ __inline__ auto ScannerProcessor::spiralLookupAlgorithm(int depth, Cell* cell, Cell* sourceCell, SimulationData& data) -> SpiralLookupResult
 {
     SpiralLookupResult result;
 
-    auto visitedCellData = data.processMemory.getArray<Cell*>(256 * 2);
+    //the hash set only uses depth * 2 slots => allocating the worst case of 512 entries per
+    //lookup just multiplied the allocation traffic on the process memory
+    auto visitedCellData = data.processMemory.getArray<Cell*>(depth * 2);
     HashSet<Cell*, HashFunctor<Cell*>> visitedCell(depth * 2, visitedCellData);
 
     result.cell = cell;
@@ -42,6 +42,15 @@ public:
         _selectionShallowData->clusterCenterPosY = 0;
         _selectionShallowData->clusterCenterVelX = 0;
         _selectionShallowData->clusterCenterVelY = 0;
+
+        _selectionShallowData->cellEnergy = 0;
+        _selectionShallowData->particleEnergy = 0;
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            _selectionShallowData->numCellsByFunction[i] = 0;
+        }
+        for (int i = 0; i < 7; ++i) {
+            _selectionShallowData->numCellsByColor[i] = 0;
+        }
     }
 
     __device__ void collectCell(Cell* cell)
@@ -52,6 +61,9 @@ public:
             atomicAdd(&_selectionShallowData->centerPosY, cell->absPos.y);
             atomicAdd(&_selectionShallowData->centerVelX, cell->vel.x);
             atomicAdd(&_selectionShallowData->centerVelY, cell->vel.y);
+            atomicAdd(&_selectionShallowData->cellEnergy, cell->energy);
+            atomicAdd(&_selectionShallowData->numCellsByFunction[cell->getCellFunctionType()], 1);
+            atomicAdd(&_selectionShallowData->numCellsByColor[cell->metadata.color % 7], 1);
         }
 
         atomicAdd(&_selectionShallowData->numClusterCells, 1);
@@ -64,6 +76,7 @@ public:
     __device__ void collectParticle(Particle* particle)
     {
         atomicAdd(&_selectionShallowData->numParticles, 1);
+        atomicAdd(&_selectionShallowData->particleEnergy, particle->energy);
         atomicAdd(&_selectionShallowData->centerPosX, particle->absPos.x);
         atomicAdd(&_selectionShallowData->centerPosY, particle->absPos.y);
         atomicAdd(&_selectionShallowData->centerVelX, particle->vel.x);
@@ -69,44 +69,46 @@ __device__ __inline__ void SensorProcessor::searchVicinity(Token* token, Simulat
     }
     __syncthreads();
 
-    auto const partition = calcPartition(32, threadIdx.x, blockDim.x);
+    //all (radius, sector) samples are scanned in one flattened sweep so that every lane of the
+    //block stays busy; the former radius-by-radius loop synchronized the whole block per ring
+    //while only 32 lanes were working, which made sensor-heavy blocks the stragglers of the
+    //substep; the min-reduction on (radius, density, angle) keys preserves the nearest-ring-first
+    //semantics of the serial loop
+    auto numRadii = 0;
     for (float radius = 14.0f; radius <= cudaSimulationParameters.cellFunctionSensorRange; radius += 8.0f) {
-        for (int angleIndex = partition.startIndex; angleIndex <= partition.endIndex; ++angleIndex) {
-            float angle = 360.0f / 32 * angleIndex;
-
-            auto delta = Math::unitVectorOfAngle(angle) * radius;
-            auto scanPos = token->cell->absPos + delta;
-            data.cellMap.correctPosition(scanPos);
-            auto density = static_cast<unsigned char>(data.cellFunctionData.densityMap.getDensity(scanPos, color));
-            if (density >= minDensity && density <= maxDensity) {
-                auto relAngle = Math::subtractAngle(angle, originAngle);
-                uint32_t angle = static_cast<uint32_t>(QuantityConverter::convertAngleToData(relAngle));
-                uint32_t combined = density << 8 | angle;
-                atomicExch(&result, combined);
-            }
-        }
-        __syncthreads();
-
-        if (threadIdx.x == 0) {
-            if (result != 0xffffffff) {
-                token->memory[Enums::Sensor_Output] = Enums::SensorOut_ClusterFound;
-                token->memory[Enums::Sensor_OutMass] = static_cast<unsigned char>((result >> 8) & 0xff);
-                auto radiusInt = static_cast<uint32_t>(radius);
-                if (radiusInt > 255) {
-                    radiusInt = 255;
-                }
-                token->memory[Enums::Sensor_OutDistance] = static_cast<unsigned char>(radiusInt);
-                token->memory[Enums::Sensor_InOutAngle] = static_cast<unsigned char>(result & 0xff);
-            }
-        }
-        if (result != 0xffffffff) {
-            break;
+        ++numRadii;
+    }
+    auto const partition = calcPartition(numRadii * 32, threadIdx.x, blockDim.x);
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto radiusIndex = index / 32;
+        auto angleIndex = index % 32;
+        auto radius = 14.0f + 8.0f * radiusIndex;
+        float angle = 360.0f / 32 * angleIndex;
+
+        auto delta = Math::unitVectorOfAngle(angle) * radius;
+        auto scanPos = token->cell->absPos + delta;
+        data.cellMap.correctPosition(scanPos);
+        auto density = static_cast<unsigned char>(data.cellFunctionData.densityMap.getDensity(scanPos, color));
+        if (density >= minDensity && density <= maxDensity) {
+            auto relAngle = Math::subtractAngle(angle, originAngle);
+            uint32_t angleData = static_cast<uint32_t>(QuantityConverter::convertAngleToData(relAngle));
+            uint32_t combined = static_cast<uint32_t>(radiusIndex) << 16 | density << 8 | angleData;
+            atomicMin(&result, combined);
         }
     }
     __syncthreads();
 
     if (threadIdx.x == 0) {
-        if (result == 0xffffffff) {
+        if (result != 0xffffffff) {
+            token->memory[Enums::Sensor_Output] = Enums::SensorOut_ClusterFound;
+            token->memory[Enums::Sensor_OutMass] = static_cast<unsigned char>((result >> 8) & 0xff);
+            auto radiusInt = static_cast<uint32_t>(14.0f + 8.0f * (result >> 16));
+            if (radiusInt > 255) {
+                radiusInt = 255;
+            }
+            token->memory[Enums::Sensor_OutDistance] = static_cast<unsigned char>(radiusInt);
+            token->memory[Enums::Sensor_InOutAngle] = static_cast<unsigned char>(result & 0xff);
+        } else {
             token->memory[Enums::Sensor_Output] = Enums::SensorOut_NothingFound;
         }
     }
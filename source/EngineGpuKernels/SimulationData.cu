@@ -1,24 +1,76 @@
 ﻿#include "SimulationData.cuh"
 
+#include "EngineInterface/Enums.h"
+
 #include "Token.cuh"
 #include "GarbageCollectorKernels.cuh"
 
-void SimulationData::init(int2 const& worldSize_)
+void SimulationData::init(int2 const& worldSize_, uint64_t randomSeed)
 {
     worldSize = worldSize_;
 
     entities.init();
     entitiesForCleanup.init();
+    cellSoA.init();
     cellFunctionData.init(worldSize);
     cellMap.init(worldSize);
     particleMap.init(worldSize);
 
     processMemory.init();
-    numberGen1.init(40312357);   //some array size for random numbers (~ 40 MB)
-    numberGen2.init(1536941);  //some array size for random numbers (~ 1.5 MB)
+    //the two generators must produce distinct streams, hence the derived second seed
+    numberGen1.init(40312357, randomSeed);   //some array size for random numbers (~ 40 MB)
+    numberGen2.init(1536941, randomSeed != 0 ? randomSeed + 1 : 0);  //some array size for random numbers (~ 1.5 MB)
 
     structuralOperations.init();
     sensorOperations.init();
+    binnedTokenPointers.init();
+    tokenBinOffsets.init();
+    activeCellIndexes.init();
+
+    freezeZoneActive = false;
+    freezeZoneTopLeft = {0, 0};
+    freezeZoneBottomRight = {0, 0};
+
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, numStructuralChanges);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numStructuralChanges, 0, sizeof(int)));
+
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, numTokenBinningBlocksDone);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numTokenBinningBlocksDone, 0, sizeof(int)));
+
+    CudaMemoryManager::getInstance().acquireMemory<CellEvent>(CellEventBufferSize, cellEvents);
+    CudaMemoryManager::getInstance().acquireMemory<unsigned long long>(1, numCellEvents);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numCellEvents, 0, sizeof(unsigned long long)));
+
+    CudaMemoryManager::getInstance().acquireMemory<uint64_t>(1, timestep);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(timestep, 0, sizeof(uint64_t)));
+
+    lineageTrackingActive = false;
+    CudaMemoryManager::getInstance().acquireMemory<LineageRecord>(LineageBufferSize, lineageRecords);
+    CudaMemoryManager::getInstance().acquireMemory<unsigned long long>(1, numLineageRecords);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numLineageRecords, 0, sizeof(unsigned long long)));
+
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, constructionThrottle);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(constructionThrottle, 0, sizeof(int)));
+
+    CudaMemoryManager::getInstance().acquireMemory<unsigned int>(1, invariantCheckSalt);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(invariantCheckSalt, 0, sizeof(unsigned int)));
+
+    CudaMemoryManager::getInstance().acquireMemory<int>(NumWorkCursors, workCursors);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(workCursors, 0, sizeof(int) * NumWorkCursors));
+
+    numSpotWeightBlocks = {
+        (worldSize.x + (1 << SpotWeightBlockSizeExp) - 1) >> SpotWeightBlockSizeExp,
+        (worldSize.y + (1 << SpotWeightBlockSizeExp) - 1) >> SpotWeightBlockSizeExp};
+    auto numBlocks = numSpotWeightBlocks.x * numSpotWeightBlocks.y;
+    CudaMemoryManager::getInstance().acquireMemory<float2>(numBlocks, spotWeightField);
+
+    //weight 1 = base value everywhere; the actual field is computed once the spot parameters are set
+    std::vector<float2> hostWeights(numBlocks, {1.0f, 1.0f});
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy(spotWeightField, hostWeights.data(), sizeof(float2) * numBlocks, cudaMemcpyHostToDevice));
+
+    CudaMemoryManager::getInstance().acquireMemory<char*>(MAX_JIT_GENOMES, jitGenomes);
+    CudaMemoryManager::getInstance().acquireMemory<int>(1, numJitGenomes);
+    CHECK_FOR_CUDA_ERROR(cudaMemset(numJitGenomes, 0, sizeof(int)));
 }
 
 __device__ void SimulationData::prepareForNextTimestep()
@@ -33,6 +85,25 @@ __device__ void SimulationData::prepareForNextTimestep()
     auto maxSensorOperations = entities.cellPointers.getNumEntries() / 2;
     sensorOperations.setMemory(processMemory.getArray<SensorOperation>(maxSensorOperations), maxSensorOperations);
 
+    auto maxBinnedTokens = entities.tokenPointers.getSize();
+    binnedTokenPointers.setMemory(processMemory.getArray<Token*>(maxBinnedTokens), maxBinnedTokens);
+    auto numTokenBins = Enums::CellFunction_Count + NUM_GENOME_TOKEN_BINS + NUM_CONSTRUCTOR_TOKEN_BINS;
+    tokenBinOffsets.setMemory(processMemory.getArray<int>(numTokenBins), numTokenBins);
+    for (int i = 0; i < numTokenBins; ++i) {
+        tokenBinOffsets.at(i) = 0;
+    }
+
+    auto maxActiveCells = entities.cellPointers.getNumEntries();
+    activeCellIndexes.setMemory(processMemory.getArray<int>(maxActiveCells), maxActiveCells);
+
+    if (*constructionThrottle > 0) {
+        --(*constructionThrottle);
+    }
+    ++(*invariantCheckSalt);
+    for (int i = 0; i < NumWorkCursors; ++i) {
+        workCursors[i] = 0;
+    }
+
     entities.saveNumEntries();
 }
 
@@ -46,6 +117,7 @@ bool SimulationData::shouldResize(int additionalCells, int additionalParticles,
         || entities.particles.shouldResize_host(cellAndParticleArraySizeInc)
         || entities.particlePointers.shouldResize_host(cellAndParticleArraySizeInc * 10)
         || entities.tokens.shouldResize_host(tokenArraySizeInc)
+        || entities.tokenMemories.shouldResize_host(tokenArraySizeInc)
         || entities.tokenPointers.shouldResize_host(tokenArraySizeInc * 10);
 }
 
@@ -53,7 +125,35 @@ __device__ bool SimulationData::shouldResize()
 {
     return entities.cells.shouldResize(0) || entities.cellPointers.shouldResize(0)
         || entities.particles.shouldResize(0) || entities.particlePointers.shouldResize(0)
-        || entities.tokens.shouldResize(0) || entities.tokenPointers.shouldResize(0);
+        || entities.tokens.shouldResize(0) || entities.tokenMemories.shouldResize(0)
+        || entities.tokenPointers.shouldResize(0);
+}
+
+__device__ bool SimulationData::isOverflowReserveTouched()
+{
+    return entities.cells.isOverflowReserveTouched() || entities.cellPointers.isOverflowReserveTouched()
+        || entities.particles.isOverflowReserveTouched() || entities.particlePointers.isOverflowReserveTouched()
+        || entities.tokens.isOverflowReserveTouched() || entities.tokenMemories.isOverflowReserveTouched()
+        || entities.tokenPointers.isOverflowReserveTouched();
+}
+
+bool SimulationData::tryGrowEntityArraysInPlace(int additionalCells, int additionalParticles, int additionalTokens)
+{
+    auto cellAndParticleArraySizeInc = std::max(additionalCells, additionalParticles);
+    auto tokenArraySizeInc = std::max(additionalTokens, cellAndParticleArraySizeInc / 3);
+
+    auto result = tryGrowPairIntern(entities.cells, entitiesForCleanup.cells, cellAndParticleArraySizeInc);
+    result &= tryGrowPairIntern(entities.cellPointers, entitiesForCleanup.cellPointers, cellAndParticleArraySizeInc * 10);
+    result &= tryGrowPairIntern(entities.particles, entitiesForCleanup.particles, cellAndParticleArraySizeInc);
+    result &= tryGrowPairIntern(entities.particlePointers, entitiesForCleanup.particlePointers, cellAndParticleArraySizeInc * 10);
+    result &= tryGrowPairIntern(entities.tokens, entitiesForCleanup.tokens, tokenArraySizeInc);
+    result &= tryGrowPairIntern(entities.tokenMemories, entitiesForCleanup.tokenMemories, tokenArraySizeInc);
+    result &= tryGrowPairIntern(entities.tokenPointers, entitiesForCleanup.tokenPointers, tokenArraySizeInc * 10);
+    if (!result) {
+        return false;
+    }
+    resizeTransientStructures();
+    return true;
 }
 
 void SimulationData::resizeEntitiesForCleanup(int additionalCells, int additionalParticles, int additionalTokens)
@@ -66,6 +166,7 @@ void SimulationData::resizeEntitiesForCleanup(int additionalCells, int additiona
     resizeTargetIntern(entities.particles, entitiesForCleanup.particles, cellAndParticleArraySizeInc);
     resizeTargetIntern(entities.particlePointers, entitiesForCleanup.particlePointers, cellAndParticleArraySizeInc * 10);
     resizeTargetIntern(entities.tokens, entitiesForCleanup.tokens, tokenArraySizeInc);
+    resizeTargetIntern(entities.tokenMemories, entitiesForCleanup.tokenMemories, tokenArraySizeInc);
     resizeTargetIntern(entities.tokenPointers, entitiesForCleanup.tokenPointers, tokenArraySizeInc * 10);
 }
 
@@ -76,15 +177,10 @@ void SimulationData::resizeRemainings()
     entities.particles.resize(entitiesForCleanup.particles.getSize_host());
     entities.particlePointers.resize(entitiesForCleanup.particlePointers.getSize_host());
     entities.tokens.resize(entitiesForCleanup.tokens.getSize_host());
+    entities.tokenMemories.resize(entitiesForCleanup.tokenMemories.getSize_host());
     entities.tokenPointers.resize(entitiesForCleanup.tokenPointers.getSize_host());
 
-    auto cellArraySize = entities.cells.getSize_host();
-    cellMap.resize(cellArraySize);
-    particleMap.resize(cellArraySize);
-
-    //heuristic
-    int upperBoundDynamicMemory = (sizeof(StructuralOperation) + 200) * (cellArraySize + 1000);
-    processMemory.resize(upperBoundDynamicMemory);
+    resizeTransientStructures();
 }
 
 bool SimulationData::isEmpty()
@@ -97,6 +193,7 @@ void SimulationData::free()
 {
     entities.free();
     entitiesForCleanup.free();
+    cellSoA.free();
     cellFunctionData.free();
     cellMap.free();
     particleMap.free();
@@ -106,6 +203,38 @@ void SimulationData::free()
 
     structuralOperations.free();
     sensorOperations.free();
+    binnedTokenPointers.free();
+    tokenBinOffsets.free();
+    activeCellIndexes.free();
+
+    CudaMemoryManager::getInstance().freeMemory(numStructuralChanges);
+    CudaMemoryManager::getInstance().freeMemory(numTokenBinningBlocksDone);
+    CudaMemoryManager::getInstance().freeMemory(cellEvents);
+    CudaMemoryManager::getInstance().freeMemory(numCellEvents);
+    CudaMemoryManager::getInstance().freeMemory(timestep);
+    CudaMemoryManager::getInstance().freeMemory(lineageRecords);
+    CudaMemoryManager::getInstance().freeMemory(numLineageRecords);
+    CudaMemoryManager::getInstance().freeMemory(constructionThrottle);
+    CudaMemoryManager::getInstance().freeMemory(invariantCheckSalt);
+    CudaMemoryManager::getInstance().freeMemory(workCursors);
+    CudaMemoryManager::getInstance().freeMemory(spotWeightField);
+    CudaMemoryManager::getInstance().freeMemory(jitGenomes);
+    CudaMemoryManager::getInstance().freeMemory(numJitGenomes);
+}
+
+//these structures are rebuilt from scratch every timestep (see prepareForNextTimestep), so the
+//plain reallocation below moves no data and is cheap compared to the entity arrays
+void SimulationData::resizeTransientStructures()
+{
+    auto cellArraySize = entities.cells.getSize_host();
+    cellMap.resize(cellArraySize);
+    particleMap.resize(cellArraySize);
+    cellSoA.resize(cellArraySize);
+
+    //heuristic
+    int upperBoundDynamicMemory = (sizeof(StructuralOperation) + 200) * (cellArraySize + 1000)
+        + sizeof(Token*) * (entities.tokenPointers.getSize_host() + 1000) + sizeof(int) * (cellArraySize + 1000);
+    processMemory.resize(upperBoundDynamicMemory);
 }
 
 template <typename Entity>
@@ -116,3 +245,16 @@ void SimulationData::resizeTargetIntern(Array<Entity> const& sourceArray, Array<
         targetArray.resize(newSize);
     }
 }
+
+template <typename Entity>
+bool SimulationData::tryGrowPairIntern(Array<Entity>& sourceArray, Array<Entity>& targetArray, int additionalEntities)
+{
+    if (!sourceArray.shouldResize_host(additionalEntities)) {
+        return true;
+    }
+    auto newSize = (sourceArray.getNumEntries_host() + additionalEntities) * 2;
+
+    //the cleanup twin is grown first: if the live array then fails to grow, the copy-based
+    //fallback still finds a large enough compaction target and nothing is left inconsistent
+    return targetArray.tryGrowInPlace(newSize) && sourceArray.tryGrowInPlace(newSize);
+}
@@ -4,13 +4,28 @@
 
 #include "Base.cuh"
 #include "CellFunctionData.cuh"
+#include "CellSoA.cuh"
 #include "Definitions.cuh"
+#include "EngineInterface/CellEvent.h"
 #include "EngineInterface/GpuSettings.h"
+#include "EngineInterface/LineageRecord.h"
 #include "Entities.cuh"
 #include "Map.cuh"
 #include "Operations.cuh"
 #include "Token.cuh"
 
+//number of extra token bins for grouping computation tokens by genome hash (see TokenProcessor);
+//more bins reduce hash collisions between distinct genomes at negligible memory cost
+#define NUM_GENOME_TOKEN_BINS 64
+
+//number of extra token bins for grouping constructor tokens by map sector (see TokenProcessor);
+//constructions batched by sector touch overlapping map regions, so their neighborhood queries
+//are served from cache instead of scattered global reads
+#define NUM_CONSTRUCTOR_TOKEN_BINS 64
+
+//maximal number of cell programs that can be jit-compiled at a time (see GenomeJitCompiler)
+#define MAX_JIT_GENOMES 8
+
 struct SimulationData
 {
     int2 worldSize;
@@ -21,25 +36,133 @@ struct SimulationData
 
     Entities entities;
     Entities entitiesForCleanup;
+    CellSoA cellSoA;
 
     RawMemory processMemory;
     TempArray<StructuralOperation> structuralOperations;
     TempArray<SensorOperation> sensorOperations;
+    TempArray<Token*> binnedTokenPointers;  //tokens grouped by cell function (and by genome for computation cells) to avoid warp divergence during function execution
+    TempArray<int> tokenBinOffsets;         //one entry per cell function plus the genome and constructor sub-bins
+    TempArray<int> activeCellIndexes;       //indexes of the non-barrier cells in cellPointers; rebuilt every timestep so that the friction and decay substeps skip inert slots
+
+    //region-of-interest freeze, set from the host between timesteps: cells and particles inside
+    //the rect are excluded from the physics and process stages of the timestep, so a cordoned-off
+    //area costs (almost) nothing while the rest of the world simulates
+    bool freezeZoneActive;
+    float2 freezeZoneTopLeft;
+    float2 freezeZoneBottomRight;
+
+    int* numStructuralChanges;  //counts connect/disconnect events since the last cluster relabeling; a nonzero value invalidates the cluster representatives
+
+    //number of blocks that have finished the token counting stage; lets the last block of
+    //cudaBinTokens_substep1 compute the bin offsets in its epilogue instead of a separate
+    //single-thread kernel; reset to 0 by that same block, so it is always 0 between timesteps
+    int* numTokenBinningBlocksDone;
+
+    //birth/death event stream: cell creations and deletions append compact records which the host
+    //drains alongside the monitor data (see _CudaSimulationFacade::retrieveCellEvents). The write
+    //cursor grows monotonically and the slot is the cursor modulo the capacity, so an overflowing
+    //buffer silently overwrites the oldest records; the host detects the gap from the cursor
+    static int constexpr CellEventBufferSize = 1 << 18;
+    CellEvent* cellEvents;
+    unsigned long long* numCellEvents;  //monotonic write cursor, not the fill level
+
+    //device mirror of the host-side timestep counter, used to stamp the event records; advanced
+    //by the timestep entry kernels and rewritten whenever the host sets the timestep
+    uint64_t* timestep;
+
+    //optional lineage tracking, set from the host between timesteps: while active, every
+    //constructed cell appends a replication record to a second ring buffer with the same
+    //cursor/overwrite semantics as the event stream (see _CudaSimulationFacade::retrieveLineageRecords)
+    bool lineageTrackingActive;
+    static int constexpr LineageBufferSize = 1 << 18;
+    LineageRecord* lineageRecords;
+    unsigned long long* numLineageRecords;  //monotonic write cursor, not the fill level
+
+    //remaining timesteps during which construction is suspended; armed by the host when the
+    //overflow reserve of an entity array is being consumed (see automaticResizeArrays) and
+    //decremented at the start of each timestep
+    int* constructionThrottle;
+
+    //advanced at the start of each timestep; varies which cells the always-on sampled invariant
+    //check inspects (see DEBUG_checkInvariantsSampled)
+    unsigned int* invariantCheckSalt;
+
+    //cursors for dynamic work distribution in kernels with strongly uneven per-item cost
+    //(collisions claim map tiles, the modifying cell functions claim token chunks); one dedicated
+    //slot per consumer since each is zeroed only at the start of the timestep
+    static int constexpr WorkCursor_Collisions = 0;
+    static int constexpr WorkCursor_ModifyingCellFunctions = 1;
+    static int constexpr NumWorkCursors = 2;
+    int* workCursors;
+
+    //spot weights (one per spot) sampled on a block grid covering the world; recomputed whenever
+    //the spot parameters change (see cudaUpdateSpotWeightField) and read by SpotCalculator instead
+    //of re-deriving the weights from the spot geometry on every parameter access
+    static int constexpr SpotWeightBlockSizeExp = 3;  //8x8 world units per block
+    float2* spotWeightField;
+    int2 numSpotWeightBlocks;
+
+    //genome blocks with a jit-compiled program; written by the host (see GenomeJitCompiler), the
+    //interpreter skips the listed genomes
+    char** jitGenomes;
+    int* numJitGenomes;
 
     CudaNumberGenerator numberGen1;
     CudaNumberGenerator numberGen2;  //second random number generator used in combination with the first generator for evaluating very low probabilities
 
-    void init(int2 const& worldSize);
+    void init(int2 const& worldSize, uint64_t randomSeed = 0);  //randomSeed = 0: random number streams are not reproducible
     bool shouldResize(int additionalCells, int additionalParticles, int additionalTokens);
+
+    //grows the entity arrays behind their existing device addresses (see Array::tryGrowInPlace);
+    //succeeds only if every affected array can grow in place, so that the caller can skip the
+    //copy cycle entirely; on false nothing needs to be rolled back and the copy-based
+    //resizeEntitiesForCleanup/resizeRemainings path must be used instead
+    bool tryGrowEntityArraysInPlace(int additionalCells, int additionalParticles, int additionalTokens);
     void resizeEntitiesForCleanup(int additionalCells, int additionalParticles, int additionalTokens);
     void resizeRemainings();
     bool isEmpty();
     void free();
 
     __device__ void prepareForNextTimestep();
+
+    __device__ __inline__ bool isFrozen(float2 const& pos) const
+    {
+        return freezeZoneActive && pos.x >= freezeZoneTopLeft.x && pos.x <= freezeZoneBottomRight.x && pos.y >= freezeZoneTopLeft.y
+            && pos.y <= freezeZoneBottomRight.y;
+    }
     __device__ bool shouldResize();
+    __device__ bool isOverflowReserveTouched();
+    __device__ __inline__ bool isConstructionThrottled() const { return *constructionThrottle > 0; }
+
+    __device__ __inline__ void logCellEvent(int type, uint64_t id, float2 const& pos, int color)
+    {
+        auto index = atomicAdd(numCellEvents, static_cast<unsigned long long>(1));
+        auto& event = cellEvents[index % CellEventBufferSize];
+        event.type = type;
+        event.color = color;
+        event.id = id;
+        event.timestep = *timestep;
+        event.posX = pos.x;
+        event.posY = pos.y;
+    }
+
+    __device__ __inline__ void logLineageRecord(uint64_t childId, uint64_t parentId, uint64_t ancestorId)
+    {
+        auto index = atomicAdd(numLineageRecords, static_cast<unsigned long long>(1));
+        auto& record = lineageRecords[index % LineageBufferSize];
+        record.childId = childId;
+        record.parentId = parentId;
+        record.ancestorId = ancestorId;
+        record.timestep = *timestep;
+    }
 
 private:
     template <typename Entity>
     void resizeTargetIntern(Array<Entity> const& sourceArray, Array<Entity>& targetArray, int additionalEntities);
+
+    template <typename Entity>
+    bool tryGrowPairIntern(Array<Entity>& sourceArray, Array<Entity>& targetArray, int additionalEntities);
+
+    void resizeTransientStructures();
 };
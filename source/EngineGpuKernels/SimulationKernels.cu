@@ -4,54 +4,124 @@
 
 __global__ void cudaPrepareNextTimestep(SimulationData data, SimulationResult result)
 {
+    ++(*data.timestep);  //only here and in the fused prologue: prepareForNextTimestep also runs outside of timesteps
     data.prepareForNextTimestep();
     result.resetStatistics();
     result.setArrayResizeNeeded(data.shouldResize());
+    result.setOverflowReserveTouched(data.isOverflowReserveTouched());
 }
 
+//fused variant of substep1 to substep5: the grid-wide syncs replace the kernel boundaries, which
+//saves the repeated reload of the cell array between the physics stages
+template<bool hasSpots, bool instrumented>
+__global__ void cudaNextTimestep_physics(SimulationData data, SimulationResult result)
+{
+    auto grid = cooperative_groups::this_grid();
+
+    //the timestep bookkeeping (cudaPrepareNextTimestep in the substep path) is folded into the
+    //prologue here: the grid-wide sync provides the same ordering as the former kernel boundary
+    //at the cost of zero extra launches
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        ++(*data.timestep);
+        data.prepareForNextTimestep();
+        if constexpr (instrumented) {
+            result.resetStatistics();
+        }
+        result.setArrayResizeNeeded(data.shouldResize());  //functional signals, kept in turbo mode
+        result.setOverflowReserveTouched(data.isOverflowReserveTouched());
+    }
+    grid.sync();
+
+    CellProcessor cellProcessor;
+    cellProcessor.init(data);
+    cellProcessor.clearTag(data);
+    cellProcessor.updateMap(data);
+    cellProcessor.radiation<hasSpots>(data);  //do not use ParticleProcessor in this stage
+    cellProcessor.clearDensityMap(data);
+    cellProcessor.compactActiveCells(data);
+    grid.sync();
+
+    if constexpr (instrumented) {
+        DEBUG_checkInvariantsSampled(data, result);  //the map is fresh and no position has moved yet
+    }
+
+    cellProcessor.collisions<hasSpots>(data);
+    cellProcessor.fillDensityMap(data);
+
+    ParticleProcessor particleProcessor;
+    particleProcessor.updateMap(data);
+    grid.sync();
+
+    cellProcessor.checkForces<hasSpots>(data);
+    cellProcessor.updateVelocities(data);
+    cellProcessor.clearTag(data);
+    cellProcessor.applyMutation<hasSpots>(data);
+
+    particleProcessor.movement(data);
+    particleProcessor.collision<hasSpots>(data);
+
+    TokenProcessor tokenProcessor;
+    tokenProcessor.applyMutation<hasSpots>(data);
+    grid.sync();
+
+    cellProcessor.calcConnectionForces<hasSpots>(data);
+    tokenProcessor.movement<hasSpots, instrumented>(data, result);
+    grid.sync();
+
+    cellProcessor.verletUpdatePositions(data);
+    cellProcessor.checkConnections(data);
+
+    data.entities.tokenPointers.saveNumEntries();
+}
+
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep1(SimulationData data)
 {
     CellProcessor cellProcessor;
     cellProcessor.init(data);
     cellProcessor.clearTag(data);
     cellProcessor.updateMap(data);
-    cellProcessor.radiation(data);  //do not use ParticleProcessor in this kernel
+    cellProcessor.radiation<hasSpots>(data);  //do not use ParticleProcessor in this kernel
     cellProcessor.clearDensityMap(data);
+    cellProcessor.compactActiveCells(data);
 }
 
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep2(SimulationData data)
 {
     CellProcessor cellProcessor;
-    cellProcessor.collisions(data);
+    cellProcessor.collisions<hasSpots>(data);
     cellProcessor.fillDensityMap(data);
 
     ParticleProcessor particleProcessor;
     particleProcessor.updateMap(data);
 }
 
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep3(SimulationData data)
 {
     CellProcessor cellProcessor;
-    cellProcessor.checkForces(data);
+    cellProcessor.checkForces<hasSpots>(data);
     cellProcessor.updateVelocities(data);
     cellProcessor.clearTag(data);
-    cellProcessor.applyMutation(data);
+    cellProcessor.applyMutation<hasSpots>(data);
 
     ParticleProcessor particleProcessor;
     particleProcessor.movement(data);
-    particleProcessor.collision(data);
+    particleProcessor.collision<hasSpots>(data);
 
     TokenProcessor tokenProcessor;
-    tokenProcessor.applyMutation(data);
+    tokenProcessor.applyMutation<hasSpots>(data);
 }
 
-__global__ void cudaNextTimestep_substep4(SimulationData data)
+template<bool hasSpots, bool instrumented>
+__global__ void cudaNextTimestep_substep4(SimulationData data, SimulationResult result)
 {
     CellProcessor cellProcessor;
-    cellProcessor.calcConnectionForces(data);
+    cellProcessor.calcConnectionForces<hasSpots>(data);
 
     TokenProcessor tokenProcessor;
-    tokenProcessor.movement(data);
+    tokenProcessor.movement<hasSpots, instrumented>(data, result);
 }
 
 __global__ void cudaNextTimestep_substep5(SimulationData data)
@@ -63,13 +133,37 @@ __global__ void cudaNextTimestep_substep5(SimulationData data)
     data.entities.tokenPointers.saveNumEntries();
 }
 
+__global__ void cudaBinTokens_substep1(SimulationData data)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.countCellFunctions(data);
+
+    //the block that retires last turns the bin counts into offsets right away (threadfence
+    //reduction pattern), which replaces the former single-thread prefix-sum kernel in between
+    __syncthreads();
+    __threadfence();
+    if (0 == threadIdx.x) {
+        if (atomicAdd(data.numTokenBinningBlocksDone, 1) == gridDim.x - 1) {
+            *data.numTokenBinningBlocksDone = 0;
+            tokenProcessor.calcCellFunctionBinOffsets(data);
+        }
+    }
+}
+
+__global__ void cudaBinTokens_substep3(SimulationData data)
+{
+    TokenProcessor tokenProcessor;
+    tokenProcessor.binTokensByCellFunction(data);
+}
+
+template<bool hasSpots, bool instrumented>
 __global__ void cudaNextTimestep_substep6(SimulationData data, SimulationResult result)
 {
     CellProcessor cellProcessor;
-    cellProcessor.calcConnectionForces(data);
+    cellProcessor.calcConnectionForces<hasSpots>(data);
 
     TokenProcessor tokenProcessor;
-    tokenProcessor.executeReadonlyCellFunctions(data, result);
+    tokenProcessor.executeReadonlyCellFunctions<instrumented>(data, result);
 }
 
 __global__ void cudaNextTimestep_substep7(SimulationData data)
@@ -80,10 +174,11 @@ __global__ void cudaNextTimestep_substep7(SimulationData data)
     cellProcessor.verletUpdateVelocities(data);
 }
 
+template<bool instrumented>
 __global__ void cudaNextTimestep_substep8(SimulationData data, SimulationResult result)
 {
     TokenProcessor tokenProcessor;
-    tokenProcessor.executeModifyingCellFunctions(data, result);
+    tokenProcessor.executeModifyingCellFunctions<instrumented>(data, result);
 }
 
 __global__ void cudaNextTimestep_substep9(SimulationData data)
@@ -92,31 +187,74 @@ __global__ void cudaNextTimestep_substep9(SimulationData data)
     cellProcessor.applyInnerFriction(data);
 }
 
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep10(SimulationData data)
 {
     CellProcessor cellProcessor;
-    cellProcessor.applyFriction(data);
-    cellProcessor.decay(data);
+    cellProcessor.applyFriction<hasSpots>(data);
+    cellProcessor.decay<hasSpots>(data);
 }
 
+//instantiate the specialized kernel variants; the launcher selects one of them at launch time
+//depending on whether spots are configured and whether turbo mode is active
+template __global__ void cudaNextTimestep_physics<true, true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_physics<true, false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_physics<false, true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_physics<false, false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep1<true>(SimulationData data);
+template __global__ void cudaNextTimestep_substep1<false>(SimulationData data);
+template __global__ void cudaNextTimestep_substep2<true>(SimulationData data);
+template __global__ void cudaNextTimestep_substep2<false>(SimulationData data);
+template __global__ void cudaNextTimestep_substep3<true>(SimulationData data);
+template __global__ void cudaNextTimestep_substep3<false>(SimulationData data);
+template __global__ void cudaNextTimestep_substep4<true, true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep4<true, false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep4<false, true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep4<false, false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep6<true, true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep6<true, false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep6<false, true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep6<false, false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep8<true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep8<false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep10<true>(SimulationData data);
+template __global__ void cudaNextTimestep_substep10<false>(SimulationData data);
+
 __global__ void cudaNextTimestep_substep11(SimulationData data)
 {
     data.structuralOperations.saveNumEntries();
+
+    //the scheduled operations are processed in the subsequent substeps, i.e. after the rigidity update
+    //=> account for them here so that the next rigidity update relabels the clusters
+    *data.numStructuralChanges += data.structuralOperations.getNumEntries();
+
+    //in deterministic mode the operations are brought into a canonical order before they are
+    //processed, since their scheduling order depends on the thread scheduling of the prior substeps
+    if (cudaThreadSettings.deterministicMode) {
+        CellConnectionProcessor::sortStructuralOperations(data);
+    }
 }
 
-__global__ void cudaNextTimestep_substep12(SimulationData data)
+template<bool instrumented>
+__global__ void cudaNextTimestep_substep12(SimulationData data, SimulationResult result)
 {
-    CellConnectionProcessor::processConnectionsOperations(data);
+    CellConnectionProcessor::processConnectionsOperations(data, instrumented ? &result : nullptr);
 }
 
-__global__ void cudaNextTimestep_substep13(SimulationData data)
+template<bool instrumented>
+__global__ void cudaNextTimestep_substep13(SimulationData data, SimulationResult result)
 {
     ParticleProcessor particleProcessor;
     particleProcessor.transformation(data);
 
-    CellConnectionProcessor::processDelCellOperations(data);
+    CellConnectionProcessor::processDelCellOperations(data, instrumented ? &result : nullptr);
 }
 
+template __global__ void cudaNextTimestep_substep12<true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep12<false>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep13<true>(SimulationData data, SimulationResult result);
+template __global__ void cudaNextTimestep_substep13<false>(SimulationData data, SimulationResult result);
+
 __global__ void cudaNextTimestep_substep14(SimulationData data)
 {
     TokenProcessor tokenProcessor;
@@ -135,6 +273,11 @@ __global__ void cudaFindClusterIteration(SimulationData data)
 
 __global__ void cudaFindClusterBoundaries(SimulationData data)
 {
+    //the cluster representatives are up to date when this kernel runs, so the pending-change
+    //counter is cleared alongside; the boundary search itself does not read it
+    if (0 == threadIdx.x && 0 == blockIdx.x) {
+        *data.numStructuralChanges = 0;
+    }
     ClusterProcessor::findClusterBoundaries(data);
 }
 
@@ -153,6 +296,32 @@ __global__ void cudaApplyClusterData(SimulationData data)
     ClusterProcessor::applyClusterData(data);
 }
 
+__global__ void cudaUpdateSpotWeightField(SimulationData data)
+{
+    auto const numBlocks = data.numSpotWeightBlocks.x * data.numSpotWeightBlocks.y;
+    auto const partition = calcAllThreadsPartition(numBlocks);
+
+    auto constexpr blockSize = 1 << SimulationData::SpotWeightBlockSizeExp;
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        float2 blockCenter = {
+            toFloat((index % data.numSpotWeightBlocks.x) * blockSize) + blockSize / 2,
+            toFloat((index / data.numSpotWeightBlocks.x) * blockSize) + blockSize / 2};
+        data.spotWeightField[index] = SpotCalculator::calcSpotWeights(data.cellMap, blockCenter);
+    }
+}
+
+__global__ void cudaClearDensityMap(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.clearDensityMap(data);
+}
+
+__global__ void cudaFillDensityMap(SimulationData data)
+{
+    CellProcessor cellProcessor;
+    cellProcessor.fillDensityMap(data);
+}
+
 
 //This is the only kernel that uses dynamic parallelism.
 //When it is removed, performance drops by about 20% for unknown reasons.
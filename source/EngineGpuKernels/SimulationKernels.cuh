@@ -15,25 +15,80 @@
 #include "DebugKernels.cuh"
 #include "SimulationResult.cuh" 
 
-__global__ void cudaPrepareNextTimestep(SimulationData data, SimulationResult result);
+__global__ void cudaPrepareNextTimestep(SimulationData data, SimulationResult result);  //substep path only; the fused physics kernel performs this bookkeeping in its prologue
+//the physics kernels are specialized at compile time for worlds with and without spots; the
+//hasSpots == false variants skip the per-cell spot interpolation entirely (see SpotCalculator).
+//the instrumented == false ('turbo') variants additionally compile out the process statistics and
+//the sampled invariant checks; the functional result signals (array resize, overflow reserve) are
+//kept in all variants since the launcher acts on them
+template<bool hasSpots, bool instrumented>
+__global__ void cudaNextTimestep_physics(SimulationData data, SimulationResult result);  //fuses substeps 1 - 5, must be launched cooperatively
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep1(SimulationData data);
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep2(SimulationData data);
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep3(SimulationData data);
-__global__ void cudaNextTimestep_substep4(SimulationData data);
+template<bool hasSpots, bool instrumented>
+__global__ void cudaNextTimestep_substep4(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep5(SimulationData data);
+__global__ void cudaBinTokens_substep1(SimulationData data);  //also computes the bin offsets in a last-block epilogue
+__global__ void cudaBinTokens_substep3(SimulationData data);
+template<bool hasSpots, bool instrumented>
 __global__ void cudaNextTimestep_substep6(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep7(SimulationData data);
+template<bool instrumented>
 __global__ void cudaNextTimestep_substep8(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep9(SimulationData data);
+template<bool hasSpots>
 __global__ void cudaNextTimestep_substep10(SimulationData data);
 __global__ void cudaNextTimestep_substep11(SimulationData data);
-__global__ void cudaNextTimestep_substep12(SimulationData data);
-__global__ void cudaNextTimestep_substep13(SimulationData data);
+template<bool instrumented>
+__global__ void cudaNextTimestep_substep12(SimulationData data, SimulationResult result);
+template<bool instrumented>
+__global__ void cudaNextTimestep_substep13(SimulationData data, SimulationResult result);
 __global__ void cudaNextTimestep_substep14(SimulationData data);
 
+//the specialized variants are instantiated in SimulationKernels.cu
+extern template __global__ void cudaNextTimestep_physics<true, true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_physics<true, false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_physics<false, true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_physics<false, false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep1<true>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep1<false>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep2<true>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep2<false>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep3<true>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep3<false>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep4<true, true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep4<true, false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep4<false, true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep4<false, false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep6<true, true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep6<true, false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep6<false, true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep6<false, false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep8<true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep8<false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep10<true>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep10<false>(SimulationData data);
+extern template __global__ void cudaNextTimestep_substep12<true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep12<false>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep13<true>(SimulationData data, SimulationResult result);
+extern template __global__ void cudaNextTimestep_substep13<false>(SimulationData data, SimulationResult result);
+
+//rebuild the density map outside the timestep loop (e.g. after a data upload), so that the
+//density-based renderer and the sensors see the new world before the next timestep
+__global__ void cudaClearDensityMap(SimulationData data);
+__global__ void cudaFillDensityMap(SimulationData data);
+
+//refill the precomputed spot weight field from the spot geometry in constant memory; must be
+//launched after every change of the spot parameters
+__global__ void cudaUpdateSpotWeightField(SimulationData data);
+
 __global__ void cudaInitClusterData(SimulationData data);
 __global__ void cudaFindClusterIteration(SimulationData data);
-__global__ void cudaFindClusterBoundaries(SimulationData data);
+__global__ void cudaFindClusterBoundaries(SimulationData data);  //also clears numStructuralChanges, hence only valid after the relabeling iterations
 __global__ void cudaAccumulateClusterPosAndVel(SimulationData data);
 __global__ void cudaAccumulateClusterAngularProp(SimulationData data);
 __global__ void cudaApplyClusterData(SimulationData data);
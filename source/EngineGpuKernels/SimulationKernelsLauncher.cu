@@ -1,54 +1,511 @@
-﻿#include "SimulationKernelsLauncher.cuh"
+#include "SimulationKernelsLauncher.cuh"
 
+#include <algorithm>
+
+#include "ConstantMemory.cuh"
+#include "CudaMemoryManager.cuh"
 #include "SimulationKernels.cuh"
 #include "FlowFieldKernels.cuh"
 #include "GarbageCollectorKernelsLauncher.cuh"
+#include "GenomeJitCompiler.cuh"
+
+namespace
+{
+    //bounds of the adaptive cadence for the slowly-varying substeps; 3 is the historical fixed
+    //period, and the maximum keeps the inner friction and rigidity updates frequent enough that
+    //a waking world cannot drift visibly before the cadence snaps back
+    auto constexpr MinSlowCadence = 3;
+    auto constexpr MaxSlowCadence = 9;
+
+    //below this rate of activity events per cell and timestep the world counts as quiescent
+    auto constexpr QuiescentActivityRate = 1.0e-3f;
+
+    //number of consecutive quiescent batches before the cadence is stretched by one step
+    auto constexpr NumQuiescentBatchesUntilStretch = 10;
+}
 
 _SimulationKernelsLauncher::_SimulationKernelsLauncher()
 {
     _garbageCollector = std::make_shared<_GarbageCollectorKernelsLauncher>();
+    _jitCompiler = std::make_shared<_GenomeJitCompiler>();
+    CHECK_FOR_CUDA_ERROR(cudaStreamCreate(&_timestepStream));
+}
+
+_SimulationKernelsLauncher::~_SimulationKernelsLauncher()
+{
+    invalidateTimestepGraphs();
+    if (0 != _flowFieldGrid) {
+        cudaDestroyTextureObject(_flowFieldGrid);
+        cudaFreeArray(_flowFieldArray);
+    }
+    cudaStreamDestroy(_timestepStream);
 }
 
 void _SimulationKernelsLauncher::calcTimestep(Settings const& settings, SimulationData const& data, SimulationResult const& result)
+{
+    calcTimesteps(settings, data, result, 1);
+}
+
+void _SimulationKernelsLauncher::calcTimesteps(Settings const& settings, SimulationData const& data, SimulationResult const& result, int numTimesteps)
+{
+    auto adjustedSettings = settings;
+    adjustedSettings.gpuSettings.numBlocks = calcNumBlocksForLiveEntities(settings.gpuSettings, data);
+
+    //the jit cache update is rare and synchronizes the device, hence outside the timestep loop
+    if (settings.gpuSettings.jitCellComputation) {
+        if (_jitCompiler->updateCacheIfDue(adjustedSettings, data)) {
+            invalidateTimestepGraphs();
+        }
+    } else if (_jitCompiler->clearCache(data)) {
+        invalidateTimestepGraphs();
+    }
+
+    if (settings.flowFieldSettings.active) {
+        updateFlowFieldGridIfNecessary(adjustedSettings, data);
+    }
+
+    auto widthLevel = calcWidthLevel(adjustedSettings.gpuSettings.numBlocks);
+    _lastLaunchContext = LaunchContext{adjustedSettings, data, result};
+
+    for (int i = 0; i < numTimesteps; ++i) {
+        auto graphIndex = calcGraphIndex(settings, widthLevel, 0 == _counter);
+        buildTimestepGraphIfMissing(graphIndex, adjustedSettings, data, result);
+        CHECK_FOR_CUDA_ERROR(cudaGraphLaunch(_timestepGraphs[graphIndex], _timestepStream));
+
+        //the per-timestep garbage collection is stream-ordered and needs no host-side decision,
+        //so the batch proceeds without intermediate synchronization
+        _garbageCollector->cleanupAfterTimestep(adjustedSettings.gpuSettings, data, _timestepStream);
+        if (++_counter >= _slowCadence) {
+            _counter = 0;
+        }
+    }
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_timestepStream));
+
+    //array compaction involves a host-side decision and is therefore performed once per batch
+    _garbageCollector->compactArraysIfNecessary(settings.gpuSettings, data);
+
+    //no statistics in turbo mode => the cadence controller has no input and stays at the minimum
+    if (!_turboMode) {
+        updateSlowCadence(data, result);
+    }
+}
+
+std::vector<KernelTiming> _SimulationKernelsLauncher::benchmarkTimestep(
+    Settings const& settings,
+    SimulationData const& data,
+    SimulationResult const& result)
+{
+    auto adjustedSettings = settings;
+    adjustedSettings.gpuSettings.numBlocks = calcNumBlocksForLiveEntities(settings.gpuSettings, data);
+    auto const gpuSettings = adjustedSettings.gpuSettings;
+    auto const stream = _timestepStream;
+
+    cudaEvent_t startEvent, stopEvent;
+    CHECK_FOR_CUDA_ERROR(cudaEventCreate(&startEvent));
+    CHECK_FOR_CUDA_ERROR(cudaEventCreate(&stopEvent));
+
+    std::vector<KernelTiming> timings;
+    auto timeKernel = [&](char const* kernelName, auto const& launchKernel) {
+        CHECK_FOR_CUDA_ERROR(cudaEventRecord(startEvent, stream));
+        launchKernel();
+        CHECK_FOR_CUDA_ERROR(cudaEventRecord(stopEvent, stream));
+        CHECK_FOR_CUDA_ERROR(cudaEventSynchronize(stopEvent));
+        float durationInMs = 0;
+        CHECK_FOR_CUDA_ERROR(cudaEventElapsedTime(&durationInMs, startEvent, stopEvent));
+        timings.emplace_back(KernelTiming{kernelName, durationInMs});
+    };
+
+    if (settings.flowFieldSettings.active) {
+        updateFlowFieldGridIfNecessary(adjustedSettings, data);
+    }
+
+    if (settings.flowFieldSettings.active) {
+        timeKernel("cudaApplyFlowFieldSettings", [&] { KERNEL_CALL_STREAM(stream, cudaApplyFlowFieldSettings, data, _flowFieldGrid); });
+    }
+    auto const hasSpots = settings.simulationParametersSpots.numSpots > 0;
+    if (gpuSettings.fusedPhysics) {
+        //the timestep bookkeeping is part of the fused kernel's prologue, so there is no
+        //cudaPrepareNextTimestep sample in this mode
+        auto numBlocks = std::min(gpuSettings.numBlocks, calcMaxCooperativeBlocks(gpuSettings));
+        timeKernel("cudaNextTimestep_physics", [&] {
+            auto dataForFusedKernel = data;
+            auto resultForFusedKernel = result;
+            void* args[] = {&dataForFusedKernel, &resultForFusedKernel};
+            auto kernel = hasSpots ? reinterpret_cast<void const*>(cudaNextTimestep_physics<true, true>)
+                                   : reinterpret_cast<void const*>(cudaNextTimestep_physics<false, true>);
+            CHECK_FOR_CUDA_ERROR(
+                cudaLaunchCooperativeKernel(kernel, numBlocks, gpuSettings.numThreadsPerBlock, args, 0, stream));
+        });
+    } else {
+        timeKernel("cudaPrepareNextTimestep", [&] { KERNEL_CALL_1_1_STREAM(stream, cudaPrepareNextTimestep, data, result); });
+        timeKernel("cudaNextTimestep_substep1", [&] {
+            KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep1<true> : cudaNextTimestep_substep1<false>), data);
+        });
+        timeKernel("cudaCheckInvariantsSampled", [&] { KERNEL_CALL_STREAM(stream, cudaCheckInvariantsSampled, data, result); });
+        timeKernel("cudaNextTimestep_substep2", [&] {
+            KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep2<true> : cudaNextTimestep_substep2<false>), data);
+        });
+        timeKernel("cudaNextTimestep_substep3", [&] {
+            KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep3<true> : cudaNextTimestep_substep3<false>), data);
+        });
+        timeKernel("cudaNextTimestep_substep4", [&] {
+            KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep4<true, true> : cudaNextTimestep_substep4<false, true>), data, result);
+        });
+        timeKernel("cudaNextTimestep_substep5", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep5, data); });
+    }
+
+    timeKernel("cudaBinTokens_substep1", [&] { KERNEL_CALL_STREAM(stream, cudaBinTokens_substep1, data); });
+    timeKernel("cudaBinTokens_substep3", [&] { KERNEL_CALL_STREAM(stream, cudaBinTokens_substep3, data); });
+
+    timeKernel("cudaNextTimestep_substep6", [&] {
+        KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep6<true, true> : cudaNextTimestep_substep6<false, true>), data, result);
+    });
+    timeKernel("cudaNextTimestep_substep7", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep7, data); });
+    timeKernel("cudaNextTimestep_substep8", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep8<true>, data, result); });
+    if (_jitCompiler->isActive()) {
+        timeKernel("cudaJitCellComputation", [&] { _jitCompiler->launchPrograms(gpuSettings, stream); });
+    }
+    timeKernel("cudaNextTimestep_substep9", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep9, data); });
+    timeKernel("cudaNextTimestep_substep10", [&] {
+        KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep10<true> : cudaNextTimestep_substep10<false>), data);
+    });
+
+    if (isRigidityUpdateEnabled(settings)) {
+        timeKernel("cudaInitClusterData", [&] { KERNEL_CALL_STREAM(stream, cudaInitClusterData, data); });
+        timeKernel("cudaFindClusterIteration", [&] { KERNEL_CALL_STREAM(stream, cudaFindClusterIteration, data); });
+        timeKernel("cudaFindClusterIteration", [&] { KERNEL_CALL_STREAM(stream, cudaFindClusterIteration, data); });
+        timeKernel("cudaFindClusterIteration", [&] { KERNEL_CALL_STREAM(stream, cudaFindClusterIteration, data); });
+        timeKernel("cudaFindClusterBoundaries", [&] { KERNEL_CALL_STREAM(stream, cudaFindClusterBoundaries, data); });
+        timeKernel("cudaAccumulateClusterPosAndVel", [&] { KERNEL_CALL_STREAM(stream, cudaAccumulateClusterPosAndVel, data); });
+        timeKernel("cudaAccumulateClusterAngularProp", [&] { KERNEL_CALL_STREAM(stream, cudaAccumulateClusterAngularProp, data); });
+        timeKernel("cudaApplyClusterData", [&] { KERNEL_CALL_STREAM(stream, cudaApplyClusterData, data); });
+    }
+    timeKernel("cudaNextTimestep_substep11", [&] { KERNEL_CALL_1_1_STREAM(stream, cudaNextTimestep_substep11, data); });
+    timeKernel("cudaNextTimestep_substep12", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep12<true>, data, result); });
+    timeKernel("cudaNextTimestep_substep13", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep13<true>, data, result); });
+    timeKernel("cudaNextTimestep_substep14", [&] { KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep14, data); });
+
+    CHECK_FOR_CUDA_ERROR(cudaEventDestroy(stopEvent));
+    CHECK_FOR_CUDA_ERROR(cudaEventDestroy(startEvent));
+
+    //leave the world in the same state as a regular timestep
+    _garbageCollector->cleanupAfterTimestep(adjustedSettings.gpuSettings, data, stream);
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(stream));
+    _garbageCollector->compactArraysIfNecessary(settings.gpuSettings, data);
+
+    return timings;
+}
+
+void _SimulationKernelsLauncher::invalidateTimestepGraphs()
+{
+    for (auto& graphExec : _timestepGraphs) {
+        if (graphExec) {
+            cudaGraphExecDestroy(graphExec);
+            graphExec = nullptr;
+        }
+    }
+    _lastLaunchContext.reset();  //the captured device pointers may be stale after a reallocation
+}
+
+void _SimulationKernelsLauncher::updateSpotWeightField(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    KERNEL_CALL_STREAM(_timestepStream, cudaUpdateSpotWeightField, data);
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_timestepStream));
+}
+
+void _SimulationKernelsLauncher::updateGpuConstants(GpuSettings const& gpuConstants)
+{
+    //ordered on the timestep stream instead of the default stream, so the update does not
+    //synchronize the whole device
+    CHECK_FOR_CUDA_ERROR(
+        cudaMemcpyToSymbolAsync(cudaThreadSettings, &gpuConstants, sizeof(GpuSettings), 0, cudaMemcpyHostToDevice, _timestepStream));
+    CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_timestepStream));  //the source lives on the caller's stack
+
+    auto lastLaunchContext = _lastLaunchContext;
+    invalidateTimestepGraphs();
+
+    //double buffering of the hot path: the graph variant the next batch will launch is rebuilt
+    //with the new geometry immediately, so tuning under live load does not drop a batch to
+    //graph capture. The remaining variants are recaptured lazily as before
+    if (lastLaunchContext) {
+        auto settings = lastLaunchContext->settings;
+        settings.gpuSettings = gpuConstants;
+        settings.gpuSettings.numBlocks = calcNumBlocksForLiveEntities(gpuConstants, lastLaunchContext->data);
+        auto widthLevel = calcWidthLevel(settings.gpuSettings.numBlocks);
+        buildTimestepGraphIfMissing(calcGraphIndex(settings, widthLevel, 0 == _counter), settings, lastLaunchContext->data, lastLaunchContext->result);
+        _lastLaunchContext = LaunchContext{settings, lastLaunchContext->data, lastLaunchContext->result};
+    }
+}
+
+void _SimulationKernelsLauncher::setTurboMode(bool value)
+{
+    if (_turboMode == value) {
+        return;
+    }
+    _turboMode = value;
+
+    //the cadence controller is blind without statistics => pin the conservative period
+    _slowCadence = MinSlowCadence;
+    _numQuiescentBatches = 0;
+}
+
+void _SimulationKernelsLauncher::scheduleSimulationParametersUpdate(SimulationParameters const& parameters)
+{
+    _pendingSimulationParameters = parameters;
+}
+
+void _SimulationKernelsLauncher::scheduleSimulationParametersSpotsUpdate(SimulationParametersSpots const& spots)
+{
+    _pendingSimulationParametersSpots = spots;
+}
+
+void _SimulationKernelsLauncher::flushPendingConstantUpdates(GpuSettings const& gpuSettings, SimulationData const& data)
+{
+    //ordered on the timestep stream instead of the default stream, so the uploads never
+    //synchronize the whole device; the stream is idle between batches (calcTimesteps ends with a
+    //stream sync), so the synchronize below returns immediately
+    if (_pendingSimulationParameters) {
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbolAsync(
+            cudaSimulationParameters, &*_pendingSimulationParameters, sizeof(SimulationParameters), 0, cudaMemcpyHostToDevice, _timestepStream));
+        CHECK_FOR_CUDA_ERROR(cudaStreamSynchronize(_timestepStream));  //the source is overwritten by the next schedule call
+        _pendingSimulationParameters.reset();
+    }
+    if (_pendingSimulationParametersSpots) {
+        CHECK_FOR_CUDA_ERROR(cudaMemcpyToSymbolAsync(
+            cudaSimulationParametersSpots,
+            &*_pendingSimulationParametersSpots,
+            sizeof(SimulationParametersSpots),
+            0,
+            cudaMemcpyHostToDevice,
+            _timestepStream));
+        _pendingSimulationParametersSpots.reset();
+        updateSpotWeightField(gpuSettings, data);  //synchronizes the stream
+    }
+}
+
+int _SimulationKernelsLauncher::calcWidthLevel(int numBlocks) const
+{
+    auto widthLevel = 0;
+    for (auto blocks = 8; blocks < numBlocks && widthLevel < NumLaunchWidthLevels - 1; blocks *= 2) {
+        ++widthLevel;
+    }
+    return widthLevel;
+}
+
+int _SimulationKernelsLauncher::calcGraphIndex(Settings const& settings, int widthLevel, bool counterAtZero) const
+{
+    return (settings.flowFieldSettings.active ? 1 : 0) | (isRigidityUpdateEnabled(settings) ? 2 : 0) | (counterAtZero ? 4 : 0)
+        | (settings.simulationParametersSpots.numSpots > 0 ? 8 : 0) | (_turboMode ? 16 : 0) | (widthLevel << 5);
+}
+
+void _SimulationKernelsLauncher::buildTimestepGraphIfMissing(
+    int graphIndex,
+    Settings const& settings,
+    SimulationData const& data,
+    SimulationResult const& result)
+{
+    auto& graphExec = _timestepGraphs[graphIndex];
+    if (graphExec) {
+        return;
+    }
+    CHECK_FOR_CUDA_ERROR(cudaStreamBeginCapture(_timestepStream, cudaStreamCaptureModeThreadLocal));
+    launchTimestepKernels(settings, data, result, _timestepStream);
+    cudaGraph_t graph;
+    CHECK_FOR_CUDA_ERROR(cudaStreamEndCapture(_timestepStream, &graph));
+    CHECK_FOR_CUDA_ERROR(cudaGraphInstantiate(&graphExec, graph, nullptr, nullptr, 0));
+    CHECK_FOR_CUDA_ERROR(cudaGraphDestroy(graph));
+}
+
+void _SimulationKernelsLauncher::launchTimestepKernels(
+    Settings const& settings,
+    SimulationData const& data,
+    SimulationResult const& result,
+    cudaStream_t stream)
 {
     auto const gpuSettings = settings.gpuSettings;
-    KERNEL_CALL_1_1(cudaPrepareNextTimestep, data, result);
+
+    //select the spot-specialized physics kernel variants: most worlds run without spots, and the
+    //hasSpots == false instantiations compile out the per-cell spot interpolation; turbo mode
+    //additionally selects the instrumentation-free variants
+    auto const hasSpots = settings.simulationParametersSpots.numSpots > 0;
+    auto const instrumented = !_turboMode;
+
+    //the flow field kernel only touches cell velocities and is independent of the timestep
+    //bookkeeping, so it may run before it
     if (settings.flowFieldSettings.active) {
-        KERNEL_CALL(cudaApplyFlowFieldSettings, data);
-    }
-    KERNEL_CALL(cudaNextTimestep_substep1, data);
-    KERNEL_CALL(cudaNextTimestep_substep2, data);
-    KERNEL_CALL(cudaNextTimestep_substep3, data);
-    KERNEL_CALL(cudaNextTimestep_substep4, data);
-    KERNEL_CALL(cudaNextTimestep_substep5, data);
-    KERNEL_CALL(cudaNextTimestep_substep6, data, result);
-    KERNEL_CALL(cudaNextTimestep_substep7, data);
-    KERNEL_CALL(cudaNextTimestep_substep8, data, result);
+        KERNEL_CALL_STREAM(stream, cudaApplyFlowFieldSettings, data, _flowFieldGrid);
+    }
+    if (gpuSettings.fusedPhysics) {
+        //no cudaPrepareNextTimestep here: the fused kernel performs the bookkeeping in its prologue
+
+        //cooperative launches must not exceed the number of blocks that can be resident on the device at once
+        auto numBlocks = std::min(gpuSettings.numBlocks, calcMaxCooperativeBlocks(gpuSettings));
+        auto dataForFusedKernel = data;
+        auto resultForFusedKernel = result;
+        void* args[] = {&dataForFusedKernel, &resultForFusedKernel};
+        auto kernel = hasSpots
+            ? (instrumented ? reinterpret_cast<void const*>(cudaNextTimestep_physics<true, true>)
+                            : reinterpret_cast<void const*>(cudaNextTimestep_physics<true, false>))
+            : (instrumented ? reinterpret_cast<void const*>(cudaNextTimestep_physics<false, true>)
+                            : reinterpret_cast<void const*>(cudaNextTimestep_physics<false, false>));
+        CHECK_FOR_CUDA_ERROR(
+            cudaLaunchCooperativeKernel(kernel, numBlocks, gpuSettings.numThreadsPerBlock, args, 0, stream));
+    } else {
+        KERNEL_CALL_1_1_STREAM(stream, cudaPrepareNextTimestep, data, result);
+        KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep1<true> : cudaNextTimestep_substep1<false>), data);
+        if (instrumented) {
+            KERNEL_CALL_STREAM(stream, cudaCheckInvariantsSampled, data, result);  //the map is fresh and no position has moved yet
+        }
+        KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep2<true> : cudaNextTimestep_substep2<false>), data);
+        KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep3<true> : cudaNextTimestep_substep3<false>), data);
+        KERNEL_CALL_STREAM(
+            stream,
+            (hasSpots ? (instrumented ? cudaNextTimestep_substep4<true, true> : cudaNextTimestep_substep4<true, false>)
+                      : (instrumented ? cudaNextTimestep_substep4<false, true> : cudaNextTimestep_substep4<false, false>)),
+            data,
+            result);
+        KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep5, data);
+    }
+
+    //group the tokens by cell function (and by genome for computation cells) so that the function
+    //execution below runs with convergent warps; the first kernel also computes the bin offsets
+    //in a last-block epilogue
+    KERNEL_CALL_STREAM(stream, cudaBinTokens_substep1, data);
+    KERNEL_CALL_STREAM(stream, cudaBinTokens_substep3, data);
+
+    KERNEL_CALL_STREAM(
+        stream,
+        (hasSpots ? (instrumented ? cudaNextTimestep_substep6<true, true> : cudaNextTimestep_substep6<true, false>)
+                  : (instrumented ? cudaNextTimestep_substep6<false, true> : cudaNextTimestep_substep6<false, false>)),
+        data,
+        result);
+    KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep7, data);
+    KERNEL_CALL_STREAM(stream, (instrumented ? cudaNextTimestep_substep8<true> : cudaNextTimestep_substep8<false>), data, result);
+    _jitCompiler->launchPrograms(gpuSettings, stream);  //no-op unless cell programs are jit-compiled
     if (_counter == 0) {
-        KERNEL_CALL(cudaNextTimestep_substep9, data);
+        KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep9, data);
     }
-    KERNEL_CALL(cudaNextTimestep_substep10, data);
+    KERNEL_CALL_STREAM(stream, (hasSpots ? cudaNextTimestep_substep10<true> : cudaNextTimestep_substep10<false>), data);
 
     if (isRigidityUpdateEnabled(settings)) {
-        if (_counter == 0) {  //execute rigidity update only every 3rd time step for performance reasons
-            KERNEL_CALL(cudaInitClusterData, data);
-            KERNEL_CALL(cudaFindClusterIteration, data);  //3 iterations should provide a good approximation
-            KERNEL_CALL(cudaFindClusterIteration, data);
-            KERNEL_CALL(cudaFindClusterIteration, data);
-            KERNEL_CALL(cudaFindClusterBoundaries, data);
-            KERNEL_CALL(cudaAccumulateClusterPosAndVel, data);
-            KERNEL_CALL(cudaAccumulateClusterAngularProp, data);
-            KERNEL_CALL(cudaApplyClusterData, data);
-        }
-    }
-    KERNEL_CALL_1_1(cudaNextTimestep_substep11, data);
-    KERNEL_CALL(cudaNextTimestep_substep12, data);
-    KERNEL_CALL(cudaNextTimestep_substep13, data);
-    KERNEL_CALL(cudaNextTimestep_substep14, data);
-
-    _garbageCollector->cleanupAfterTimestep(settings.gpuSettings, data);
-    if (++_counter == 3) {
-        _counter = 0;
+        if (_counter == 0) {  //execute rigidity update only on counter wrap (see _slowCadence) for performance reasons
+            KERNEL_CALL_STREAM(stream, cudaInitClusterData, data);
+            KERNEL_CALL_STREAM(stream, cudaFindClusterIteration, data);  //3 iterations should provide a good approximation
+            KERNEL_CALL_STREAM(stream, cudaFindClusterIteration, data);
+            KERNEL_CALL_STREAM(stream, cudaFindClusterIteration, data);
+            KERNEL_CALL_STREAM(stream, cudaFindClusterBoundaries, data);  //the cluster representatives are now up to date; also clears numStructuralChanges
+            KERNEL_CALL_STREAM(stream, cudaAccumulateClusterPosAndVel, data);
+            KERNEL_CALL_STREAM(stream, cudaAccumulateClusterAngularProp, data);
+            KERNEL_CALL_STREAM(stream, cudaApplyClusterData, data);
+        }
+    }
+    KERNEL_CALL_1_1_STREAM(stream, cudaNextTimestep_substep11, data);
+    KERNEL_CALL_STREAM(stream, (instrumented ? cudaNextTimestep_substep12<true> : cudaNextTimestep_substep12<false>), data, result);
+    KERNEL_CALL_STREAM(stream, (instrumented ? cudaNextTimestep_substep13<true> : cudaNextTimestep_substep13<false>), data, result);
+    KERNEL_CALL_STREAM(stream, cudaNextTimestep_substep14, data);
+}
+
+int _SimulationKernelsLauncher::calcNumBlocksForLiveEntities(GpuSettings const& gpuSettings, SimulationData const& data) const
+{
+    auto maxEntries = std::max(
+        {data.entities.cellPointers.getNumEntries_host(),
+         data.entities.particlePointers.getNumEntries_host(),
+         data.entities.tokenPointers.getNumEntries_host()});
+    auto requiredBlocks = (maxEntries + gpuSettings.numThreadsPerBlock - 1) / gpuSettings.numThreadsPerBlock;
+
+    //quantize to the next power of two so that only a few launch width levels (and thus captured
+    //graphs) arise while the population grows
+    auto result = 8;
+    while (result < requiredBlocks) {
+        result *= 2;
+    }
+    return std::min(result, gpuSettings.numBlocks);
+}
+
+int _SimulationKernelsLauncher::calcMaxCooperativeBlocks(GpuSettings const& gpuSettings) const
+{
+    int device;
+    CHECK_FOR_CUDA_ERROR(cudaGetDevice(&device));
+    int numMultiprocessors;
+    CHECK_FOR_CUDA_ERROR(cudaDeviceGetAttribute(&numMultiprocessors, cudaDevAttrMultiProcessorCount, device));
+    int numBlocksPerMultiprocessor;
+    //the spots variant is the conservative reference: it needs at least as many registers as the
+    //specialized one, so the resulting block count is safe for both
+    CHECK_FOR_CUDA_ERROR(cudaOccupancyMaxActiveBlocksPerMultiprocessor(
+        &numBlocksPerMultiprocessor, cudaNextTimestep_physics<true, true>, gpuSettings.numThreadsPerBlock, 0));
+    return numMultiprocessors * numBlocksPerMultiprocessor;
+}
+
+void _SimulationKernelsLauncher::updateFlowFieldGridIfNecessary(Settings const& settings, SimulationData const& data)
+{
+    auto worldSizeChanged = data.worldSize.x != _flowFieldWorldSize.x || data.worldSize.y != _flowFieldWorldSize.y;
+    if (0 != _flowFieldGrid && !worldSizeChanged && settings.flowFieldSettings == _flowFieldSettings) {
+        return;
+    }
+
+    if (worldSizeChanged) {
+        if (0 != _flowFieldGrid) {
+            CHECK_FOR_CUDA_ERROR(cudaDestroyTextureObject(_flowFieldGrid));
+            CHECK_FOR_CUDA_ERROR(cudaFreeArray(_flowFieldArray));
+            _flowFieldGrid = 0;
+        }
+        auto channelDesc = cudaCreateChannelDesc<float2>();
+        CHECK_FOR_CUDA_ERROR(cudaMallocArray(&_flowFieldArray, &channelDesc, data.worldSize.x, data.worldSize.y));
+
+        cudaResourceDesc resourceDesc = {};
+        resourceDesc.resType = cudaResourceTypeArray;
+        resourceDesc.res.array.array = _flowFieldArray;
+        cudaTextureDesc textureDesc = {};
+        textureDesc.addressMode[0] = cudaAddressModeWrap;  //the world is a torus
+        textureDesc.addressMode[1] = cudaAddressModeWrap;
+        textureDesc.filterMode = cudaFilterModeLinear;
+        textureDesc.readMode = cudaReadModeElementType;
+        textureDesc.normalizedCoords = 1;
+        CHECK_FOR_CUDA_ERROR(cudaCreateTextureObject(&_flowFieldGrid, &resourceDesc, &textureDesc, nullptr));
+        _flowFieldWorldSize = data.worldSize;
+
+        //the texture handle is baked into the captured graphs
+        invalidateTimestepGraphs();
+    }
+
+    //evaluate the analytic field into a temporary linear grid and copy it into the texture array
+    float2* flowFieldGrid;
+    CudaMemoryManager::getInstance().acquireMemory<float2>(data.worldSize.x * data.worldSize.y, flowFieldGrid);
+    auto const& gpuSettings = settings.gpuSettings;
+    KERNEL_CALL(cudaGenerateFlowFieldGrid, data, flowFieldGrid);
+    CHECK_FOR_CUDA_ERROR(cudaMemcpy2DToArray(
+        _flowFieldArray,
+        0,
+        0,
+        flowFieldGrid,
+        data.worldSize.x * sizeof(float2),
+        data.worldSize.x * sizeof(float2),
+        data.worldSize.y,
+        cudaMemcpyDeviceToDevice));
+    CudaMemoryManager::getInstance().freeMemory(flowFieldGrid);
+    _flowFieldSettings = settings.flowFieldSettings;
+}
+
+void _SimulationKernelsLauncher::updateSlowCadence(SimulationData const& data, SimulationResult const& result)
+{
+    //activity of the last timestep of the batch; the statistics are reset every timestep, so
+    //this is a rate sample, not a batch total
+    auto resultAccessor = result;
+    auto statistics = resultAccessor.getProcessMonitorData();
+    auto numActivityEvents = statistics.createdCells + statistics.deletedCells + statistics.createdConnections
+        + statistics.destroyedConnections + statistics.muscleActivities;
+    auto numCells = std::max(1, data.entities.cellPointers.getNumEntries_host());
+
+    if (toFloat(numActivityEvents) / toFloat(numCells) < QuiescentActivityRate) {
+        if (++_numQuiescentBatches >= NumQuiescentBatchesUntilStretch && _slowCadence < MaxSlowCadence) {
+            ++_slowCadence;
+            _numQuiescentBatches = 0;
+        }
+    } else {
+        //activity snaps the cadence back immediately: a stretched period must not delay the
+        //response to a burst of structural changes or muscle impulses
+        _slowCadence = MinSlowCadence;
+        _numQuiescentBatches = 0;
     }
 }
 
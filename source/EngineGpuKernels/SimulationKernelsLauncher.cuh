@@ -1,22 +1,119 @@
-﻿#pragma once
+#pragma once
 
+#include <optional>
+
+#include <cuda_runtime.h>
+
+#include "EngineInterface/KernelTiming.h"
 #include "EngineInterface/Settings.h"
 
 #include "Definitions.cuh"
 #include "Macros.cuh"
+#include "SimulationData.cuh"
 #include "SimulationKernels.cuh"
+#include "SimulationResult.cuh"
 
 class _SimulationKernelsLauncher
 {
 public:
     _SimulationKernelsLauncher();
+    ~_SimulationKernelsLauncher();
 
     void calcTimestep(Settings const& settings, SimulationData const& simulationData, SimulationResult const& result);
 
+    //executes several timesteps back-to-back with a single synchronization at the end; array
+    //compaction is deferred to the end of the batch
+    void calcTimesteps(Settings const& settings, SimulationData const& simulationData, SimulationResult const& result, int numTimesteps);
+
+    //executes one timestep with every kernel launched individually and timed via cuda events;
+    //bypasses the captured graphs and synchronizes after each kernel, so it is far slower than
+    //calcTimestep and only intended for the benchmarks target; kernels that production runs
+    //only every few timesteps (substep9 and the rigidity update, see _slowCadence) are launched
+    //unconditionally so that each call yields one sample per kernel
+    std::vector<KernelTiming> benchmarkTimestep(Settings const& settings, SimulationData const& simulationData, SimulationResult const& result);
+
+    //must be called whenever settings change or device arrays are reallocated since kernel launch
+    //parameters are baked into the captured graphs
+    void invalidateTimestepGraphs();
+
+    //applies new launch geometry without a device-wide synchronization: the constant memory
+    //update is ordered on the timestep stream and the graph variant in active use is rebuilt
+    //with the new geometry right away, so the next batch launches without a capture pause
+    void updateGpuConstants(GpuSettings const& gpuConstants);
+
+    //refills the precomputed spot weight field from the spot geometry in constant memory; must
+    //be called after every spot parameter change
+    void updateSpotWeightField(GpuSettings const& gpuSettings, SimulationData const& data);
+
+    //deferred constant-memory updates for the parameter blocks: a schedule call only stores the
+    //new value (successive slider ticks coalesce by overwriting it) and the upload happens
+    //stream-ordered at the next flush, i.e. at the next batch or device access; this keeps live
+    //parameter tuning off the timestep critical path entirely
+    //turbo mode selects the instrumented == false kernel variants, which compile out the process
+    //statistics and the sampled invariant checks; the functional result signals (array resize,
+    //overflow reserve) stay active. The adaptive slow cadence is frozen at its minimum since its
+    //controller reads the statistics that turbo mode no longer collects
+    void setTurboMode(bool value);
+
+    void scheduleSimulationParametersUpdate(SimulationParameters const& parameters);
+    void scheduleSimulationParametersSpotsUpdate(SimulationParametersSpots const& spots);
+    void flushPendingConstantUpdates(GpuSettings const& gpuSettings, SimulationData const& data);
+
 private:
     bool isRigidityUpdateEnabled(Settings const& settings) const;
+    void updateSlowCadence(SimulationData const& simulationData, SimulationResult const& result);
+    void updateFlowFieldGridIfNecessary(Settings const& settings, SimulationData const& simulationData);
+    int calcNumBlocksForLiveEntities(GpuSettings const& gpuSettings, SimulationData const& simulationData) const;
+    int calcWidthLevel(int numBlocks) const;
+    int calcGraphIndex(Settings const& settings, int widthLevel, bool counterAtZero) const;
+    void buildTimestepGraphIfMissing(int graphIndex, Settings const& settings, SimulationData const& simulationData, SimulationResult const& result);
+    int calcMaxCooperativeBlocks(GpuSettings const& gpuSettings) const;
+    void launchTimestepKernels(
+        Settings const& settings,
+        SimulationData const& simulationData,
+        SimulationResult const& result,
+        cudaStream_t stream);
 
     GarbageCollectorKernelsLauncher _garbageCollector;
+    GenomeJitCompiler _jitCompiler;
+
+    //cadence of the slowly-varying substeps (inner friction and the rigidity update): they run
+    //whenever the counter wraps. The period is adapted to the activity of the world, see
+    //updateSlowCadence
     int _counter = 0;
-};
+    int _slowCadence = 3;
+    int _numQuiescentBatches = 0;
+
+    bool _turboMode = false;
 
+    //cached flow field velocities, sampled by cudaApplyFlowFieldSettings with hardware
+    //interpolation; regenerated only when the flow settings or the world size change
+    FlowFieldSettings _flowFieldSettings;
+    cudaArray_t _flowFieldArray = nullptr;
+    cudaTextureObject_t _flowFieldGrid = 0;
+    int2 _flowFieldWorldSize{0, 0};
+
+    //the substep sequence is captured into CUDA graphs to avoid per-kernel launch overhead;
+    //one graph per variant of the launch sequence (flow field, rigidity update, counter cycle,
+    //turbo mode) and per launch width level: the grid size is adapted to the live entity count and
+    //quantized to powers of two so that only a handful of graph variants is ever instantiated
+    static auto constexpr NumLaunchWidthLevels = 12;
+    static auto constexpr NumTimestepGraphs = 32 * NumLaunchWidthLevels;
+    cudaStream_t _timestepStream = nullptr;
+    cudaGraphExec_t _timestepGraphs[NumTimestepGraphs] = {};
+
+    //the launch arguments of the last batch, kept so that a settings change can rebuild the
+    //affected graph variant off the hot path; cleared on invalidation since the captured device
+    //pointers may be stale afterwards
+    struct LaunchContext
+    {
+        Settings settings;
+        SimulationData data;
+        SimulationResult result;
+    };
+    std::optional<LaunchContext> _lastLaunchContext;
+
+    //latest parameter values not yet uploaded to constant memory (see flushPendingConstantUpdates)
+    std::optional<SimulationParameters> _pendingSimulationParameters;
+    std::optional<SimulationParametersSpots> _pendingSimulationParametersSpots;
+};
@@ -6,14 +6,21 @@ public:
     __host__ void init()
     {
         CudaMemoryManager::getInstance().acquireMemory<bool>(1, _arrayResizingNeeded);
+        CudaMemoryManager::getInstance().acquireMemory<bool>(1, _overflowReserveTouched);
         CudaMemoryManager::getInstance().acquireMemory<ProcessMonitorData>(1, _statistics);
         ProcessMonitorData statistics;
         CHECK_FOR_CUDA_ERROR(cudaMemcpy(_statistics, &statistics, sizeof(ProcessMonitorData), cudaMemcpyHostToDevice));
+        CudaMemoryManager::getInstance().acquireMemory<InvariantViolationData>(1, _invariantViolations);
+        InvariantViolationData invariantViolations;
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpy(_invariantViolations, &invariantViolations, sizeof(InvariantViolationData), cudaMemcpyHostToDevice));
     }
 
     __host__ void free() {
+        CudaMemoryManager::getInstance().freeMemory(_invariantViolations);
         CudaMemoryManager::getInstance().freeMemory(_statistics);
         CudaMemoryManager::getInstance().freeMemory(_arrayResizingNeeded);
+        CudaMemoryManager::getInstance().freeMemory(_overflowReserveTouched);
     }
 
     __host__ bool isArrayResizeNeeded()
@@ -29,6 +36,12 @@ public:
         int sucessfulAttacks = 0;
         int failedAttacks = 0;
         int muscleActivities = 0;
+
+        //structural churn: a leading indicator of atomic contention in the connection processing
+        int createdConnections = 0;
+        int destroyedConnections = 0;
+        int deletedCells = 0;
+        int movedTokens = 0;
     };
     __host__ ProcessMonitorData getProcessMonitorData()
     {
@@ -37,15 +50,65 @@ public:
         return result;
     }
 
+    //counters of the always-on sampled invariant check (see DEBUG_checkInvariantsSampled);
+    //cumulative since simulation start so that no violation is lost between readouts
+    struct InvariantViolationData
+    {
+        int asymmetricConnections = 0;
+        int mapResidencyViolations = 0;
+        int invalidEnergies = 0;
+    };
+    __host__ InvariantViolationData getInvariantViolationData()
+    {
+        InvariantViolationData result;
+        CHECK_FOR_CUDA_ERROR(
+            cudaMemcpy(&result, _invariantViolations, sizeof(InvariantViolationData), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
+    //backpressure signal: the overflow reserve of an entity array is already being consumed, so a
+    //plain resize would come too late for the entities constructed in the meantime
+    __host__ bool isOverflowReserveTouched()
+    {
+        bool result;
+        CHECK_FOR_CUDA_ERROR(cudaMemcpy(&result, _overflowReserveTouched, sizeof(bool), cudaMemcpyDeviceToHost));
+        return result;
+    }
+
     __device__ void setArrayResizeNeeded(bool value) { *_arrayResizingNeeded = value; }
+    __device__ void setOverflowReserveTouched(bool value) { *_overflowReserveTouched = value; }
 
     __device__ void resetStatistics() { *_statistics = ProcessMonitorData(); }
-    __device__ void incCreatedCell() { atomicAdd(&_statistics->createdCells, 1); }
-    __device__ void incSuccessfulAttack() { atomicAdd(&_statistics->sucessfulAttacks, 1); }
-    __device__ void incFailedAttack() { atomicAdd(&_statistics->failedAttacks, 1); }
-    __device__ void incMuscleActivity() { atomicAdd(&_statistics->muscleActivities, 1); }
+    __device__ void incCreatedCell() { incIntern(&_statistics->createdCells); }
+    __device__ void incSuccessfulAttack() { incIntern(&_statistics->sucessfulAttacks); }
+    __device__ void incFailedAttack() { incIntern(&_statistics->failedAttacks); }
+    __device__ void incMuscleActivity() { incIntern(&_statistics->muscleActivities); }
+    __device__ void incCreatedConnection() { incIntern(&_statistics->createdConnections); }
+    __device__ void incDestroyedConnection() { incIntern(&_statistics->destroyedConnections); }
+    __device__ void incDeletedCell() { incIntern(&_statistics->deletedCells); }
+    __device__ void incMovedToken() { incIntern(&_statistics->movedTokens); }
+
+    //violations are rare by definition, so plain atomics suffice here
+    __device__ void incAsymmetricConnection() { atomicAdd(&_invariantViolations->asymmetricConnections, 1); }
+    __device__ void incMapResidencyViolation() { atomicAdd(&_invariantViolations->mapResidencyViolations, 1); }
+    __device__ void incInvalidEnergy() { atomicAdd(&_invariantViolations->invalidEnergies, 1); }
 
 private:
+    __device__ static void incIntern(int* counter)
+    {
+        //warp-aggregated increment: the converged threads of a warp combine their increments into a
+        //single atomic (same scheme as TempArray::tryAddEntry), which avoids serialization when many
+        //threads count an event at once (e.g. mass attacks)
+        auto mask = __activemask();
+        auto laneId = threadIdx.x & 31;
+        auto leader = __ffs(mask) - 1;
+        if (laneId == leader) {
+            atomicAdd(counter, __popc(mask));
+        }
+    }
+
     ProcessMonitorData* _statistics;
+    InvariantViolationData* _invariantViolations;
     bool* _arrayResizingNeeded;
+    bool* _overflowReserveTouched;
 };
\ No newline at end of file
@@ -4,30 +4,63 @@
 
 #include "EngineInterface/SimulationParametersSpotValues.h"
 #include "ConstantMemory.cuh"
+#include "SimulationData.cuh"
 
 class SpotCalculator
 {
 public:
+    //with hasSpots == false the spot interpolation is compiled out entirely and the base value is
+    //returned directly; the specialized physics kernels use this for worlds without spots.
+    //with spots, the weights are not derived from the spot geometry here but read from the
+    //precomputed per-block field (see cudaUpdateSpotWeightField), leaving only the mix per access
+    template<bool hasSpots = true>
     __device__ __inline__ static float calcParameter(float SimulationParametersSpotValues::*value, SimulationData const& data, float2 const& worldPos)
     {
-        return calcResultingValue(
-            data.cellMap,
+        if constexpr (!hasSpots) {
+            return cudaSimulationParameters.spotValues.*value;
+        }
+        return mixFromWeightField(
+            data,
             worldPos,
             cudaSimulationParameters.spotValues.*value,
             cudaSimulationParametersSpots.spots[0].values.*value,
             cudaSimulationParametersSpots.spots[1].values.*value);
     }
 
+    template<bool hasSpots = true>
     __device__ __inline__ static int calcParameter(int SimulationParametersSpotValues::*value, SimulationData const& data, float2 const& worldPos)
     {
-        return toInt(calcResultingValue(
-            data.cellMap,
+        if constexpr (!hasSpots) {
+            return cudaSimulationParameters.spotValues.*value;
+        }
+        return toInt(mixFromWeightField(
+            data,
             worldPos,
             toFloat(cudaSimulationParameters.spotValues.*value),
             toFloat(cudaSimulationParametersSpots.spots[0].values.*value),
             toFloat(cudaSimulationParametersSpots.spots[1].values.*value)));
     }
 
+    //weights of the spots at the given position (1 = spot has no influence); evaluated from the
+    //spot geometry, used to fill the precomputed weight field
+    __device__ __inline__ static float2 calcSpotWeights(BaseMap const& map, float2 const& worldPos)
+    {
+        float2 result{1.0f, 1.0f};
+        if (cudaSimulationParametersSpots.numSpots >= 1) {
+            float2 spotPos = {cudaSimulationParametersSpots.spots[0].posX, cudaSimulationParametersSpots.spots[0].posY};
+            auto delta = spotPos - worldPos;
+            map.correctDirection(delta);
+            result.x = calcWeight(delta, 0);
+        }
+        if (cudaSimulationParametersSpots.numSpots >= 2) {
+            float2 spotPos = {cudaSimulationParametersSpots.spots[1].posX, cudaSimulationParametersSpots.spots[1].posY};
+            auto delta = spotPos - worldPos;
+            map.correctDirection(delta);
+            result.y = calcWeight(delta, 1);
+        }
+        return result;
+    }
+
     __device__ __inline__ static float3
     calcColor(BaseMap const& map, float2 const& worldPos, float3 const& baseColor, float3 const& spotColor1, float3 const& spotColor2)
     {
@@ -35,6 +68,25 @@ public:
     }
 
 private:
+    __device__ __inline__ static float
+    mixFromWeightField(SimulationData const& data, float2 const& worldPos, float baseValue, float spotValue1, float spotValue2)
+    {
+        if (0 == cudaSimulationParametersSpots.numSpots) {
+            return baseValue;
+        }
+        int2 posInt = {floorInt(worldPos.x), floorInt(worldPos.y)};
+        data.cellMap.correctPosition(posInt);
+        auto blockIndex = (posInt.x >> SimulationData::SpotWeightBlockSizeExp)
+            + (posInt.y >> SimulationData::SpotWeightBlockSizeExp) * data.numSpotWeightBlocks.x;
+        auto const weights = data.spotWeightField[blockIndex];
+        if (1 == cudaSimulationParametersSpots.numSpots) {
+            return mix(baseValue, spotValue1, weights.x);
+        }
+        return mix(baseValue, spotValue1, spotValue2, weights.x, weights.y);
+    }
+
+    //exact evaluation from the spot geometry; still used for the color gradients in the rendering,
+    //where the block quantization of the weight field would be visible
     template<typename T>
     __device__ __inline__ static T calcResultingValue(BaseMap const& map, float2 const& worldPos, T const& baseValue, T const& spotValue1, T const& spotValue2)
     {
@@ -3,9 +3,16 @@
 #include "Definitions.cuh"
 #include "ConstantMemory.cuh"
 
+//pooled token memory: a token carries a handle to an exclusively owned block, so hopping to the
+//next cell transfers the handle and only branch duplication copies the bytes
+struct TokenMemory
+{
+    char bytes[MAX_TOKEN_MEM_SIZE];
+};
+
 struct Token
 {
-    char memory[MAX_TOKEN_MEM_SIZE];
+    char* memory;  //points into the bytes of a TokenMemory block
     Cell* cell;
     float energy;
 
@@ -19,19 +19,37 @@
 class TokenProcessor
 {
 public:
-    __inline__ __device__ void movement(SimulationData& data);  //prerequisite: cell tags = 0
+    template<bool hasSpots, bool instrumented>
+    __inline__ __device__ void movement(SimulationData& data, SimulationResult& result);  //prerequisite: cell tags = 0
 
+    template<bool hasSpots>
     __inline__ __device__ void applyMutation(SimulationData& data);
+
+    //the three binning stages group the tokens by cell function and, for computation cells, by
+    //genome (count, prefix sum, scatter) so that the function execution below runs with convergent
+    //warps; the scatter must run in a separate kernel since it requires the completed offsets
+    //grid-wide, whereas the prefix sum is executed by the last retiring block of the counting
+    //kernel (see cudaBinTokens_substep1)
+    __inline__ __device__ void countCellFunctions(SimulationData& data);
+    __inline__ __device__ void calcCellFunctionBinOffsets(SimulationData& data);
+    __inline__ __device__ void binTokensByCellFunction(SimulationData& data);
+
+    template<bool instrumented>
     __inline__ __device__ void executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result);  //energy values are allowed to change
+    template<bool instrumented>
     __inline__ __device__ void executeModifyingCellFunctions(SimulationData& data, SimulationResult& result);
     __inline__ __device__ void deleteTokenIfCellDeleted(SimulationData& data);
+
+private:
+    __inline__ __device__ static int calcTokenBinIndex(Cell* cell);
 };
 
 /************************************************************************/
 /* Implementation                                                       */
 /************************************************************************/
 
-__inline__ __device__ void TokenProcessor::movement(SimulationData& data)
+template<bool hasSpots, bool instrumented>
+__inline__ __device__ void TokenProcessor::movement(SimulationData& data, SimulationResult& result)
 {
     auto& tokens = data.entities.tokenPointers;
     auto const partition = calcAllThreadsPartition(tokens.getNumOrigEntries());
@@ -39,6 +57,9 @@ __inline__ __device__ void TokenProcessor::movement(SimulationData& data)
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& token = tokens.at(index);
         auto cell = token->cell;
+        if (data.isFrozen(cell->absPos)) {
+            continue;    //time stands still in the freeze zone: the token is kept as it is
+        }
         atomicAdd(&cell->cellFunctionInvocations, 1);
 
         int numNextTokenCells = 0;
@@ -50,7 +71,7 @@ __inline__ __device__ void TokenProcessor::movement(SimulationData& data)
             auto tokenBranchNumber = token->getTokenBranchNumber();
 
             auto cellMinEnergy =
-                SpotCalculator::calcParameter(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
+                SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::cellMinEnergy, data, cell->absPos);
 
             for (int i = 0; i < cell->numConnections; ++i) {
                 auto const& connectedCell = cell->connections[i].cell;
@@ -91,6 +112,9 @@ __inline__ __device__ void TokenProcessor::movement(SimulationData& data)
                     newToken = factory.duplicateToken(connectedCell, token);
                 }
                 newToken->energy = tokenEnergy;
+                if constexpr (instrumented) {
+                    result.incMovedToken();
+                }
 
                 //token has too low energy? => try to steal energy from underlying cell
                 if (tokenEnergy < cudaSimulationParameters.tokenMinEnergy) {
@@ -119,6 +143,7 @@ __inline__ __device__ void TokenProcessor::movement(SimulationData& data)
     }
 }
 
+template<bool hasSpots>
 __inline__ __device__ void TokenProcessor::applyMutation(SimulationData& data)
 {
     auto& tokens = data.entities.tokenPointers;
@@ -127,71 +152,161 @@ __inline__ __device__ void TokenProcessor::applyMutation(SimulationData& data)
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& token = tokens.at(index);
         auto const& cell = token->cell;
-        auto mutationRate = SpotCalculator::calcParameter(&SimulationParametersSpotValues::tokenMutationRate, data, cell->absPos);
+        if (data.isFrozen(cell->absPos)) {
+            continue;
+        }
+        auto mutationRate = SpotCalculator::calcParameter<hasSpots>(&SimulationParametersSpotValues::tokenMutationRate, data, cell->absPos);
         if (data.numberGen1.random() < mutationRate) {
             token->memory[data.numberGen1.random(MAX_TOKEN_MEM_SIZE - 1)] = data.numberGen1.random(255);
         }
     }
 }
 
-__inline__ __device__ void TokenProcessor::executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result)
+__inline__ __device__ int TokenProcessor::calcTokenBinIndex(Cell* cell)
+{
+    auto cellFunctionType = cell->getCellFunctionType();
+
+    //constructor tokens are additionally grouped by map sector: constructions batched this way
+    //act on nearby sites, so the neighborhood queries of a warp cover overlapping map regions
+    //and are largely served from cache
+    if (cellFunctionType == Enums::CellFunction_Constructor) {
+        auto sectorX = toInt(cell->absPos.x) >> 4;
+        auto sectorY = toInt(cell->absPos.y) >> 4;
+        return Enums::CellFunction_Count + NUM_GENOME_TOKEN_BINS
+            + static_cast<int>((sectorX * 92821 + sectorY) % NUM_CONSTRUCTOR_TOKEN_BINS);
+    }
+    if (cellFunctionType != Enums::CellFunction_Computation) {
+        return cellFunctionType;
+    }
+
+    //computation tokens are additionally grouped by genome: after replication many cells share an
+    //identical program, so tokens hashed into the same bin run the same instruction stream and the
+    //per-instruction dispatch in CellComputationProcessor stays convergent across the warp; a hash
+    //collision merely merges two genome groups and does not affect correctness
+    //cells with the same program alias one deduplicated block (see GenomeStore) => the block
+    //address identifies the genome; arena blocks are 16-byte aligned, hence the shift
+    auto block = reinterpret_cast<unsigned long long>(cell->staticData);
+    return Enums::CellFunction_Count + static_cast<int>((block >> 4) % NUM_GENOME_TOKEN_BINS);
+}
+
+__inline__ __device__ void TokenProcessor::countCellFunctions(SimulationData& data)
 {
     auto& tokens = data.entities.tokenPointers;
+    auto const partition = calcAllThreadsPartition(tokens.getNumOrigEntries());
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& token = tokens.at(index);
+        if (token && !data.isFrozen(token->cell->absPos)) {
+            atomicAdd(&data.tokenBinOffsets.at(calcTokenBinIndex(token->cell)), 1);
+        }
+    }
+}
+
+__inline__ __device__ void TokenProcessor::calcCellFunctionBinOffsets(SimulationData& data)
+{
+    int sum = 0;
+    for (int i = 0; i < Enums::CellFunction_Count + NUM_GENOME_TOKEN_BINS + NUM_CONSTRUCTOR_TOKEN_BINS; ++i) {
+        auto count = data.tokenBinOffsets.at(i);
+        data.tokenBinOffsets.at(i) = sum;
+        sum += count;
+    }
+    data.binnedTokenPointers.setNumEntries(sum);
+}
+
+__inline__ __device__ void TokenProcessor::binTokensByCellFunction(SimulationData& data)
+{
+    auto& tokens = data.entities.tokenPointers;
+    auto const partition = calcAllThreadsPartition(tokens.getNumOrigEntries());
+
+    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+        auto& token = tokens.at(index);
+        if (token && !data.isFrozen(token->cell->absPos)) {
+            //the bin index is recomputed instead of stored; no genome can change between the
+            //count and the scatter stage, so both computations agree
+            auto newIndex = atomicAdd(&data.tokenBinOffsets.at(calcTokenBinIndex(token->cell)), 1);
+            data.binnedTokenPointers.at(newIndex) = token;
+        }
+    }
+}
+
+template<bool instrumented>
+__inline__ __device__ void TokenProcessor::executeReadonlyCellFunctions(SimulationData& data, SimulationResult& result)
+{
+    auto& tokens = data.binnedTokenPointers;
     auto partition =
         calcPartition(tokens.getNumEntries(), threadIdx.x + blockIdx.x * blockDim.x, blockDim.x * gridDim.x);
 
     for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
         auto& token = tokens.at(index);
         auto& cell = token->cell;
-        if (token) {
-            auto cellFunctionType = cell->getCellFunctionType();
-            if (Enums::CellFunction_Scanner == cellFunctionType) {
-                ScannerProcessor::process(token, data);
-            }
-            if (Enums::CellFunction_Sensor == cellFunctionType) {
-                SensorProcessor::scheduleOperation(token, data);
-            }
-            if (Enums::CellFunction_Digestion == cellFunctionType) {  //modifies energy
-                DigestionProcessor::process(token, data, result);
-            }
+        auto cellFunctionType = cell->getCellFunctionType();
+        if (Enums::CellFunction_Scanner == cellFunctionType) {
+            ScannerProcessor::process(token, data);
+        }
+        if (Enums::CellFunction_Sensor == cellFunctionType) {
+            SensorProcessor::scheduleOperation(token, data);
+        }
+        if (Enums::CellFunction_Digestion == cellFunctionType) {  //modifies energy
+            DigestionProcessor::process<instrumented>(token, data, result);
         }
     }
 }
 
+template<bool instrumented>
 __inline__ __device__ void
 TokenProcessor::executeModifyingCellFunctions(SimulationData& data, SimulationResult& result)
 {
-    auto& tokens = data.entities.tokenPointers;
-    auto const partition = calcAllThreadsPartition(tokens.getNumOrigEntries());
+    auto& tokens = data.binnedTokenPointers;
+    auto numTokens = tokens.getNumEntries();
 
-    for (int index = partition.startIndex; index <= partition.endIndex; ++index) {
+    //warps claim small chunks from a shared cursor instead of owning a static slice: a
+    //construction token costs orders of magnitude more than a computation token and the binning
+    //sorts the expensive ones into contiguous ranges, so a static partition leaves most warps
+    //idle behind a few stragglers
+    auto constexpr chunkSize = 32;
+    auto const laneIndex = threadIdx.x & 31;
+    while (true) {
+        int chunkStart;
+        if (0 == laneIndex) {
+            chunkStart = atomicAdd(data.workCursors + SimulationData::WorkCursor_ModifyingCellFunctions, chunkSize);
+        }
+        chunkStart = __shfl_sync(0xffffffff, chunkStart, 0);
+        if (chunkStart >= numTokens) {
+            break;
+        }
+        auto index = chunkStart + laneIndex;
+        if (index >= numTokens) {
+            continue;  //the lane is idle for this chunk but must keep participating in the claims
+        }
         auto& token = tokens.at(index);
         auto& cell = token->cell;
-        if (token) {
-            auto cellFunctionType = cell->getCellFunctionType();
+        auto cellFunctionType = cell->getCellFunctionType();
 
-            //cell functions need a lock since they should be executed consecutively on a cell
-            //make a certain number of attempts
-            for (int i = 0; i < 100; ++i) {
-                if (cell->tryLock()) {
+        //cell functions need a lock since they should be executed consecutively on a cell
+        //make a certain number of attempts
+        for (int i = 0; i < 100; ++i) {
+            if (cell->tryLock()) {
 
-                    EnergyGuidance::processing(data, token);
-                    if (Enums::CellFunction_Computation == cellFunctionType) {
+                EnergyGuidance::processing(data, token);
+                if (Enums::CellFunction_Computation == cellFunctionType) {
+
+                    //jit-compiled genomes are executed by the generated kernel afterwards (see GenomeJitCompiler)
+                    if (!CellComputationProcessor::isJitCompiled(data, cell->staticData)) {
                         CellComputationProcessor::process(token);
                     }
-                    if (Enums::CellFunction_Constructor == cellFunctionType) {
-                        ConstructionProcessor::process(token, data, result);
-                    }
-                    if (Enums::CellFunction_Communication == cellFunctionType) {
-                        CommunicationProcessor::process(token, data);
-                    }
-                    if (Enums::CellFunction_Muscle == cellFunctionType) {
-                        MuscleProcessor::process(token, data, result);
-                    }
-
-                    cell->releaseLock();
-                    break;
                 }
+                if (Enums::CellFunction_Constructor == cellFunctionType) {
+                    ConstructionProcessor::process<instrumented>(token, data, result);
+                }
+                if (Enums::CellFunction_Communication == cellFunctionType) {
+                    CommunicationProcessor::process(token, data);
+                }
+                if (Enums::CellFunction_Muscle == cellFunctionType) {
+                    MuscleProcessor::process<instrumented>(token, data, result);
+                }
+
+                cell->releaseLock();
+                break;
             }
         }
     }
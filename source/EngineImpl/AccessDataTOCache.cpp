@@ -1,32 +1,24 @@
 #include "AccessDataTOCache.h"
 
+#include <cuda_runtime.h>
+
 _AccessDataTOCache::_AccessDataTOCache(GpuSettings const& gpuConstants)
     : _gpuConstants(gpuConstants)
 {}
 
 _AccessDataTOCache::~_AccessDataTOCache()
 {
-    for (DataAccessTO const& dataTO : _freeDataTOs) {
-        deleteDataTO(dataTO);
+    for (CachedTO const& cachedTO : _freeDataTOs) {
+        deleteDataTO(cachedTO.dataTO);
     }
-    for (DataAccessTO const& dataTO : _usedDataTOs) {
-        deleteDataTO(dataTO);
+    for (CachedTO const& cachedTO : _usedDataTOs) {
+        deleteDataTO(cachedTO.dataTO);
     }
 }
 
 DataAccessTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
 {
-    if (!_arraySizes || *_arraySizes != arraySizes) {
-        for (DataAccessTO const& dataTO : _freeDataTOs) {
-            deleteDataTO(dataTO);
-        }
-        for (DataAccessTO const& dataTO : _usedDataTOs) {
-            deleteDataTO(dataTO);
-        }
-        _freeDataTOs.clear();
-        _usedDataTOs.clear();
-        _arraySizes = arraySizes;
-    }
+    std::lock_guard lock(_mutex);
 
     auto clear = [](auto& result) {
             *result.numCells = 0;
@@ -35,25 +27,42 @@ DataAccessTO _AccessDataTOCache::getDataTO(ArraySizes const& arraySizes)
             *result.numStringBytes = 0;
     };
 
-    DataAccessTO result;
-    if (!_freeDataTOs.empty()) {
-        result = *_freeDataTOs.begin();
-        _freeDataTOs.erase(_freeDataTOs.begin());
+    //reuse the smallest fitting cached TO; a TO that is still in use (e.g. by the background
+    //snapshot writer) is never touched
+    auto bestFit = _freeDataTOs.end();
+    for (auto it = _freeDataTOs.begin(); it != _freeDataTOs.end(); ++it) {
+        if (it->sizes.fits(arraySizes) && (bestFit == _freeDataTOs.end() || it->sizes.cellArraySize < bestFit->sizes.cellArraySize)) {
+            bestFit = it;
+        }
+    }
+    if (bestFit != _freeDataTOs.end()) {
+        auto result = *bestFit;
+        _freeDataTOs.erase(bestFit);
         _usedDataTOs.emplace_back(result);
 
-        clear(result);
-        return result;
+        clear(result.dataTO);
+        return result.dataTO;
     }
-    result = getNewDataTO();
-    _usedDataTOs.emplace_back(result);
+
+    //nothing fits: drop the cached TOs that are too small (typically leftovers from an earlier
+    //world size or from small selection extractions) and allocate at the requested capacities
+    for (CachedTO const& cachedTO : _freeDataTOs) {
+        deleteDataTO(cachedTO.dataTO);
+    }
+    _freeDataTOs.clear();
+
+    auto result = getNewDataTO(arraySizes);
+    _usedDataTOs.emplace_back(CachedTO{result, arraySizes});
     clear(result);
     return result;
 }
 
 void _AccessDataTOCache::releaseDataTO(DataAccessTO const& dataTO)
 {
-    auto usedDataTO = std::find_if(_usedDataTOs.begin(), _usedDataTOs.end(), [&dataTO](DataAccessTO const& usedDataTO) {
-        return usedDataTO == dataTO;
+    std::lock_guard lock(_mutex);
+
+    auto usedDataTO = std::find_if(_usedDataTOs.begin(), _usedDataTOs.end(), [&dataTO](CachedTO const& usedDataTO) {
+        return usedDataTO.dataTO == dataTO;
     });
     if (usedDataTO != _usedDataTOs.end()) {
         _freeDataTOs.emplace_back(*usedDataTO);
@@ -61,32 +70,48 @@ void _AccessDataTOCache::releaseDataTO(DataAccessTO const& dataTO)
     }
 }
 
-DataAccessTO _AccessDataTOCache::getNewDataTO()
+namespace
 {
-    try {
-        DataAccessTO result;
-        result.numCells = new int;
-        result.numParticles = new int;
-        result.numTokens = new int;
-        result.numStringBytes = new int;
-        result.cells = new CellAccessTO[_arraySizes->cellArraySize];
-        result.particles = new ParticleAccessTO[_arraySizes->particleArraySize];
-        result.tokens = new TokenAccessTO[_arraySizes->tokenArraySize];
-        result.stringBytes = new char[MAX_STRING_BYTES];
-        return result;
-    } catch (std::bad_alloc const&) {
-        throw BugReportException("There is not sufficient CPU memory available.");
+    //the TO buffers are allocated as pinned memory so that the transfers to and from the device
+    //run at full PCIe bandwidth and can be issued asynchronously
+    template <typename T>
+    void acquirePinnedMemory(int count, T*& result)
+    {
+        count = std::max(1, count);    //an empty selection must still yield valid buffers
+        if (cudaSuccess != cudaHostAlloc(reinterpret_cast<void**>(&result), sizeof(T) * count, cudaHostAllocDefault)) {
+            throw BugReportException("There is not sufficient CPU memory available.");
+        }
     }
+
+    template <typename T>
+    void freePinnedMemory(T* buffer)
+    {
+        cudaFreeHost(buffer);
+    }
+}
+
+DataAccessTO _AccessDataTOCache::getNewDataTO(ArraySizes const& arraySizes)
+{
+    DataAccessTO result;
+    acquirePinnedMemory(1, result.numCells);
+    acquirePinnedMemory(1, result.numParticles);
+    acquirePinnedMemory(1, result.numTokens);
+    acquirePinnedMemory(1, result.numStringBytes);
+    acquirePinnedMemory(arraySizes.cellArraySize, result.cells);
+    acquirePinnedMemory(arraySizes.particleArraySize, result.particles);
+    acquirePinnedMemory(arraySizes.tokenArraySize, result.tokens);
+    acquirePinnedMemory(arraySizes.stringBytesSize, result.stringBytes);
+    return result;
 }
 
 void _AccessDataTOCache::deleteDataTO(DataAccessTO const& dataTO)
 {
-    delete dataTO.numCells;
-    delete dataTO.numParticles;
-    delete dataTO.numTokens;
-    delete dataTO.numStringBytes;
-    delete[] dataTO.cells;
-    delete[] dataTO.particles;
-    delete[] dataTO.tokens;
-    delete[] dataTO.stringBytes;
+    freePinnedMemory(dataTO.numCells);
+    freePinnedMemory(dataTO.numParticles);
+    freePinnedMemory(dataTO.numTokens);
+    freePinnedMemory(dataTO.numStringBytes);
+    freePinnedMemory(dataTO.cells);
+    freePinnedMemory(dataTO.particles);
+    freePinnedMemory(dataTO.tokens);
+    freePinnedMemory(dataTO.stringBytes);
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <mutex>
+
 #include "Base/Definitions.h"
 
 #include "EngineInterface/GpuSettings.h"
@@ -19,24 +21,44 @@ public:
         int particleArraySize;
         int tokenArraySize;
 
+        //a metadata-less extraction (see DataAccessSchema) needs no string blob, which spares the
+        //50 MB pinned allocation per cached TO
+        int stringBytesSize = MAX_STRING_BYTES;
+
         bool operator==(ArraySizes const& other) const
         {
             return cellArraySize == other.cellArraySize && particleArraySize == other.particleArraySize
-                && tokenArraySize == other.tokenArraySize;
+                && tokenArraySize == other.tokenArraySize && stringBytesSize == other.stringBytesSize;
         }
 
         bool operator!=(ArraySizes const& other) const { return !operator==(other); };
+
+        bool fits(ArraySizes const& request) const
+        {
+            return cellArraySize >= request.cellArraySize && particleArraySize >= request.particleArraySize
+                && tokenArraySize >= request.tokenArraySize && stringBytesSize >= request.stringBytesSize;
+        }
     };
+
+    //returns a TO with at least the requested capacities; a fitting cached TO is reused, otherwise
+    //a new one with exactly the requested capacities is allocated
     DataAccessTO getDataTO(ArraySizes const& arraySizes);
     void releaseDataTO(DataAccessTO const& dataTO);
 
 private:
-    DataAccessTO getNewDataTO();
+    struct CachedTO
+    {
+        DataAccessTO dataTO;
+        ArraySizes sizes;
+    };
+
+    DataAccessTO getNewDataTO(ArraySizes const& arraySizes);
     void deleteDataTO(DataAccessTO const& dataTO);
 
     GpuSettings _gpuConstants;
-    std::vector<DataAccessTO> _freeDataTOs;
-    std::vector<DataAccessTO> _usedDataTOs;
-    std::optional<ArraySizes> _arraySizes;
-};
 
+    //the cache is accessed from the worker thread and from the background snapshot writer
+    mutable std::mutex _mutex;
+    std::vector<CachedTO> _freeDataTOs;
+    std::vector<CachedTO> _usedDataTOs;
+};
@@ -1,7 +1,9 @@
 #include "DataConverter.h"
 
 #include <algorithm>
-#include <boost/range/adaptor/map.hpp>
+#include <cstring>
+#include <numeric>
+#include <thread>
 
 #include "Base/NumberGenerator.h"
 #include "Base/Exceptions.h"
@@ -16,42 +18,89 @@ ClusteredDataDescription DataConverter::convertAccessTOtoClusteredDataDescriptio
 {
 	ClusteredDataDescription result;
 
-    //cells
-    std::vector<ClusterDescription> clusters;
-    std::unordered_set<int> freeCellIndices;
-    for (int i = 0; i < *dataTO.numCells; ++i) {
-        freeCellIndices.insert(i);
-    }
-    std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-    std::unordered_map<int, int> cellTOIndexToClusterDescIndex;
-    int clusterDescIndex = 0;
-    while (!freeCellIndices.empty()) {
-        auto freeCellIndex = *freeCellIndices.begin();
-        auto createClusterData = scanAndCreateClusterDescription(dataTO, freeCellIndex, freeCellIndices);
-        clusters.emplace_back(createClusterData.cluster);
-
-        //update index maps
-        cellTOIndexToCellDescIndex.insert(
-            createClusterData.cellTOIndexToCellDescIndex.begin(), createClusterData.cellTOIndexToCellDescIndex.end());
-        for (auto const& cellTOIndex : createClusterData.cellTOIndexToCellDescIndex | boost::adaptors::map_keys) {
-            cellTOIndexToClusterDescIndex.emplace(cellTOIndex, clusterDescIndex);
+    //cells: label the clusters via union-find over the connection graph (with path halving)
+    auto numCells = *dataTO.numCells;
+    std::vector<int> parent(numCells);
+    std::iota(parent.begin(), parent.end(), 0);
+    auto findRoot = [&parent](int index) {
+        while (parent[index] != index) {
+            parent[index] = parent[parent[index]];
+            index = parent[index];
+        }
+        return index;
+    };
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        for (int j = 0; j < cellTO.numConnections; ++j) {
+            auto connectionIndex = cellTO.connections[j].cellIndex;
+            if (connectionIndex != -1) {
+                auto root1 = findRoot(i);
+                auto root2 = findRoot(connectionIndex);
+                if (root1 != root2) {
+                    parent[root2] = root1;
+                }
+            }
         }
-        ++clusterDescIndex;
     }
-    result.addClusters(clusters);
+
+    //assign cluster indices in deterministic order together with each cell's position within its cluster
+    std::unordered_map<int, int> clusterDescIndexByRoot;
+    std::vector<int> clusterDescIndexByCell(numCells);
+    std::vector<int> cellDescIndexByCell(numCells);
+    std::vector<int> numCellsByCluster;
+    for (int i = 0; i < numCells; ++i) {
+        auto root = findRoot(i);
+        auto [it, inserted] = clusterDescIndexByRoot.emplace(root, toInt(numCellsByCluster.size()));
+        if (inserted) {
+            numCellsByCluster.emplace_back(0);
+        }
+        clusterDescIndexByCell[i] = it->second;
+        cellDescIndexByCell[i] = numCellsByCluster[it->second]++;
+    }
+
+    //build the cell descriptions in parallel on all host cores
+    std::vector<CellDescription> cellDescs(numCells);
+    auto numThreads = std::max(1u, std::thread::hardware_concurrency());
+    if (numCells < 10000) {
+        numThreads = 1;
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    for (unsigned int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&, t] {
+            for (int i = t; i < numCells; i += numThreads) {
+                cellDescs[i] = createCellDescription(dataTO, i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    //assemble the clusters
+    std::vector<ClusterDescription> clusters(numCellsByCluster.size());
+    for (size_t i = 0; i < clusters.size(); ++i) {
+        clusters[i].id = NumberGenerator::getInstance().getId();
+        clusters[i].cells.resize(numCellsByCluster[i]);
+    }
+    for (int i = 0; i < numCells; ++i) {
+        clusters[clusterDescIndexByCell[i]].cells[cellDescIndexByCell[i]] = std::move(cellDescs[i]);
+    }
+    result.clusters = std::move(clusters);  //addClusters would deep-copy every cell with its metadata strings
 
     //tokens
     for (int i = 0; i < *dataTO.numTokens; ++i) {
         TokenAccessTO const& token = dataTO.tokens[i];
 
-        std::string data(_parameters.tokenMemorySize, 0);
-        for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
-            data[i] = token.memory[i];
+        std::string data;
+        if (dataTO.includeTokenMemories) {
+            data.assign(token.memory, _parameters.tokenMemorySize);
         }
-        auto clusterDescIndex = cellTOIndexToClusterDescIndex.at(token.cellIndex);
-        auto cellDescIndex = cellTOIndexToCellDescIndex.at(token.cellIndex);
+        auto clusterDescIndex = clusterDescIndexByCell.at(token.cellIndex);
+        auto cellDescIndex = cellDescIndexByCell.at(token.cellIndex);
         CellDescription& cell = result.clusters.at(clusterDescIndex).cells.at(cellDescIndex);
-        cell.addToken(TokenDescription().setEnergy(token.energy).setData(data).setSequenceNumber(token.sequenceNumber));
+        auto& newToken = cell.tokens.emplace_back(TokenDescription().setEnergy(token.energy).setSequenceNumber(token.sequenceNumber));
+        newToken.data = std::move(data);  //addToken would copy the token memory string twice
     }
     //sort tokens by sequence number
     if (sortTokens == SortTokens::Yes) {
@@ -69,6 +118,7 @@ ClusteredDataDescription DataConverter::convertAccessTOtoClusteredDataDescriptio
 
     //particles
     std::vector<ParticleDescription> particles;
+    particles.reserve(*dataTO.numParticles);
     for (int i = 0; i < *dataTO.numParticles; ++i) {
         ParticleAccessTO const& particle = dataTO.particles[i];
         particles.emplace_back(ParticleDescription()
@@ -78,7 +128,7 @@ ClusteredDataDescription DataConverter::convertAccessTOtoClusteredDataDescriptio
                                    .setEnergy(particle.energy)
                                    .setMetadata(ParticleMetadata().setColor(particle.metadata.color)));
     }
-    result.addParticles(particles);
+    result.particles = std::move(particles);
 
     return result;
 }
@@ -89,22 +139,24 @@ DataDescription DataConverter::convertAccessTOtoDataDescription(DataAccessTO con
 
     //cells
     std::vector<CellDescription> cells;
+    cells.reserve(*dataTO.numCells);
     for (int i = 0; i < *dataTO.numCells; ++i) {
         cells.emplace_back(createCellDescription(dataTO, i));
     }
-    result.addCells(cells);
+    result.cells = std::move(cells);  //addCells would deep-copy every cell with its metadata strings
 
     //tokens
     for (int i = 0; i < *dataTO.numTokens; ++i) {
         TokenAccessTO const& token = dataTO.tokens[i];
 
-        std::string data(_parameters.tokenMemorySize, 0);
-        for (int i = 0; i < _parameters.tokenMemorySize; ++i) {
-            data[i] = token.memory[i];
+        std::string data;
+        if (dataTO.includeTokenMemories) {
+            data.assign(token.memory, _parameters.tokenMemorySize);
         }
         auto cellDescIndex = token.cellIndex;
         CellDescription& cell = result.cells.at(cellDescIndex);
-        cell.addToken(TokenDescription().setEnergy(token.energy).setData(data).setSequenceNumber(token.sequenceNumber));
+        auto& newToken = cell.tokens.emplace_back(TokenDescription().setEnergy(token.energy).setSequenceNumber(token.sequenceNumber));
+        newToken.data = std::move(data);  //addToken would copy the token memory string twice
     }
     //sort tokens by sequence number
     if (sortTokens == SortTokens::Yes) {
@@ -117,6 +169,7 @@ DataDescription DataConverter::convertAccessTOtoDataDescription(DataAccessTO con
 
     //particles
     std::vector<ParticleDescription> particles;
+    particles.reserve(*dataTO.numParticles);
     for (int i = 0; i < *dataTO.numParticles; ++i) {
         ParticleAccessTO const& particle = dataTO.particles[i];
         particles.emplace_back(ParticleDescription()
@@ -126,7 +179,7 @@ DataDescription DataConverter::convertAccessTOtoDataDescription(DataAccessTO con
                                    .setEnergy(particle.energy)
                                    .setMetadata(ParticleMetadata().setColor(particle.metadata.color)));
     }
-    result.addParticles(particles);
+    result.particles = std::move(particles);
 
     return result;
 }
@@ -209,80 +262,19 @@ void DataConverter::convertParticleDescriptionToAccessTO(DataAccessTO& result, P
 namespace
 {
     std::string convertToString(char const* data, int size) {
-        std::string result(size, 0);
-        for (int i = 0; i < size; ++i) {
-            result[i] = data[i];
-        }
-        return result;
+        return std::string(data, size);    //bulk copy; embedded zeros are preserved
     }
 
     void convertToArray(std::string const& source, char* target, int size)
     {
-        for (int i = 0; i < size; ++i) {
-            if (i < source.size()) {
-                target[i] = source.at(i);
-            }
-            else {
-                target[i] = 0;
-            }
+        auto numBytes = std::min(static_cast<size_t>(size), source.size());
+        std::memcpy(target, source.data(), numBytes);
+        if (numBytes < static_cast<size_t>(size)) {
+            std::memset(target + numBytes, 0, size - numBytes);
         }
     }
 }
 
-namespace
-{
-    template <typename T>
-    void setInplaceDifference(std::unordered_set<T>& a, std::unordered_set<T> const& b)
-    {
-        for (auto const& element : b) {
-            a.erase(element);
-        }
-    }
-}
-
-auto DataConverter::scanAndCreateClusterDescription(
-    DataAccessTO const& dataTO,
-    int startCellIndex,
-    std::unordered_set<int>& freeCellIndices) const
-    -> CreateClusterReturnData
-{
-    CreateClusterReturnData result; 
-
-    std::unordered_set<int> currentCellIndices;
-    currentCellIndices.insert(startCellIndex);
-    std::unordered_set<int> scannedCellIndices = currentCellIndices;
-
-    std::vector<CellDescription> cells;
-    std::unordered_set<int> nextCellIndices;
-    int cellDescIndex = 0;
-    do {
-        for (auto const& currentCellIndex : currentCellIndices) {
-            cells.emplace_back(createCellDescription(dataTO, currentCellIndex));
-            result.cellTOIndexToCellDescIndex.emplace(currentCellIndex, cellDescIndex);
-            auto const& cellTO = dataTO.cells[currentCellIndex];
-            for (int i = 0; i < cellTO.numConnections; ++i) {
-                auto connectionTO = cellTO.connections[i];
-                if (connectionTO.cellIndex != -1) {
-                    if (scannedCellIndices.find(connectionTO.cellIndex) == scannedCellIndices.end()) {
-                        nextCellIndices.insert(connectionTO.cellIndex);
-                        scannedCellIndices.insert(connectionTO.cellIndex);
-                    }
-                }
-            }
-            ++cellDescIndex;
-        }
-        currentCellIndices = nextCellIndices;
-        nextCellIndices.clear();
-    } while (!currentCellIndices.empty());
-
-    setInplaceDifference(freeCellIndices, scannedCellIndices);
-
-    result.cluster.id = NumberGenerator::getInstance().getId();
-    result.cluster.addCells(cells);
-
-    return result;
-}
-
 CellDescription DataConverter::createCellDescription(DataAccessTO const& dataTO, int cellIndex) const
 {
     CellDescription result;
@@ -293,7 +285,7 @@ CellDescription DataConverter::createCellDescription(DataAccessTO const& dataTO,
     result.vel = RealVector2D(cellTO.vel.x, cellTO.vel.y);
     result.energy = cellTO.energy;
     result.maxConnections = cellTO.maxConnections;
-    std::vector<ConnectionDescription> connections;
+    result.connections.reserve(cellTO.numConnections);
     for (int i = 0; i < cellTO.numConnections; ++i) {
         auto const& connectionTO = cellTO.connections[i];
         ConnectionDescription connection;
@@ -304,9 +296,8 @@ CellDescription DataConverter::createCellDescription(DataAccessTO const& dataTO,
         }
         connection.distance = connectionTO.distance;
         connection.angleFromPrevious = connectionTO.angleFromPrevious;
-        connections.emplace_back(connection);
+        result.connections.emplace_back(connection);
     }
-    result.connections = connections;
     result.tokenBlocked = cellTO.tokenBlocked;
     result.tokenBranchNumber = cellTO.branchNumber;
     result.barrier = cellTO.barrier;
@@ -355,9 +346,7 @@ int DataConverter::convertStringAndReturnStringIndex(DataAccessTO const& dataTO,
 {
     auto result = *dataTO.numStringBytes;
     int len = static_cast<int>(s.size());
-    for (int i = 0; i < len; ++i) {
-        dataTO.stringBytes[result + i] = s.at(i);
-    }
+    std::memcpy(&dataTO.stringBytes[result], s.data(), len);
     (*dataTO.numStringBytes) += len;
     return result;
 }
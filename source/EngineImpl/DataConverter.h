@@ -26,15 +26,6 @@ public:
     void convertParticleDescriptionToAccessTO(DataAccessTO& result, ParticleDescription const& particle) const;
 
 private:
-	struct CreateClusterReturnData
-    {
-        ClusterDescription cluster;
-        std::unordered_map<int, int> cellTOIndexToCellDescIndex;
-	};
-    CreateClusterReturnData scanAndCreateClusterDescription(
-        DataAccessTO const& dataTO,
-        int startCellIndex,
-        std::unordered_set<int>& freeCellIndices) const;
     CellDescription createCellDescription(DataAccessTO const& dataTO, int cellIndex) const;
 
 	void addCell(
@@ -1,8 +1,27 @@
 #include "EngineWorker.h"
 
 #include <chrono>
+#include <cmath>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
 #include <thread>
 
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#define STB_IMAGE_WRITE_IMPLEMENTATION
+#include <stb_image_write.h>
+
+#include "Base/Exceptions.h"
+#include "Base/LoggingService.h"
+#include "Base/MappedFile.h"
+#include "Base/NumberGenerator.h"
+
+#include "EngineInterface/LiveTelemetry.h"
+
 #include "EngineGpuKernels/AccessTOs.cuh"
 #include "EngineGpuKernels/CudaSimulationFacade.cuh"
 #include "AccessDataTOCache.h"
@@ -12,6 +31,129 @@ namespace
 {
     std::chrono::milliseconds const FrameTimeout(500);
     std::chrono::milliseconds const MonitorUpdate(30);
+
+    //upper bound for the idle sleep of the paused worker; wakeups normally come from the
+    //notifications of the work sources, the timeout only guards against a missed one
+    std::chrono::milliseconds const WorkerIdleTimeout(250);
+    std::chrono::seconds const TelemetryLogInterval(10);
+
+    //number of timesteps executed back-to-back on the device when no TPS restriction is active;
+    //keeps launch and synchronization overhead off the critical path for small worlds while the
+    //access gate stays responsive
+    int const TimestepBatchSize = 8;
+
+    //number of checkpoints kept in the rewind ring; each one holds a full set of pinned transfer
+    //buffers, so the ring is kept short
+    int const CheckpointRingCapacity = 5;
+
+    //latency SLO for the watchdog: a timestep slower than this triggers a diagnostic bundle in
+    //the log; the cooldown keeps a persistently slow world from flooding it
+    std::chrono::milliseconds const SlowTimestepThreshold(1000);
+    std::chrono::seconds const WatchdogCooldown(60);
+
+    //auto-tuning candidates: the launch geometry sweet spot differs considerably between GPU
+    //generations, so a coarse grid is swept against the live world
+    int const TuningThreadsPerBlockCandidates[] = {32, 64, 128};
+    int const TuningNumBlocksCandidates[] = {512, 1024, 2048, 4096, 8192};
+    int const TuningNumWarmupTimesteps = 16;    //covers the graph capture for the new launch geometry
+    int const TuningNumTimestepsPerCandidate = 200;
+
+    //identifies the raw snapshot format and its version; the format is a plain dump of the transfer
+    //arrays and changes whenever their in-memory layout changes. Version 2 carries the payload size
+    //and a hash behind the header so that a load rejects truncated or corrupt files before parsing.
+    std::string const RawSnapshotHeader = "alien raw snapshot 2\n";
+    std::string const RawSnapshotHeaderV1 = "alien raw snapshot 1\n";
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    //FNV-1a; computed while the snapshot is streamed to disk and verified over the mapped pages on
+    //load, without pulling a compression library into the engine
+    uint64_t constexpr HashOffsetBasis = 0xcbf29ce484222325ull;
+
+    uint64_t updateHash(uint64_t hash, char const* data, uint64_t numBytes)
+    {
+        for (uint64_t i = 0; i < numBytes; ++i) {
+            hash ^= static_cast<unsigned char>(data[i]);
+            hash *= 0x100000001b3ull;
+        }
+        return hash;
+    }
+
+    //streams the snapshot payload and computes its size and hash in the same pass
+    struct HashingWriter
+    {
+        std::ostream& stream;
+        uint64_t hash = HashOffsetBasis;
+        uint64_t numBytesWritten = 0;
+
+        template <typename T>
+        void writeValue(T const& value)
+        {
+            write(reinterpret_cast<char const*>(&value), sizeof(T));
+        }
+
+        template <typename T>
+        void writeArray(T const* data, int count)
+        {
+            write(reinterpret_cast<char const*>(data), sizeof(T) * static_cast<uint64_t>(count));
+        }
+
+        void write(char const* data, uint64_t numBytes)
+        {
+            stream.write(data, static_cast<std::streamsize>(numBytes));
+            hash = updateHash(hash, data, numBytes);
+            numBytesWritten += numBytes;
+        }
+    };
+
+    //cursor over a memory-mapped snapshot; the arrays are copied straight from the mapped pages
+    //into the pinned transfer buffers
+    struct MappedFileReader
+    {
+        char const* pos;
+        char const* end;
+
+        template <typename T>
+        bool readValue(T& value)
+        {
+            if (end - pos < static_cast<ptrdiff_t>(sizeof(T))) {
+                return false;
+            }
+            std::memcpy(&value, pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        template <typename T>
+        bool readArray(T* data, int count)
+        {
+            auto numBytes = sizeof(T) * static_cast<uint64_t>(count);
+            if (static_cast<uint64_t>(end - pos) < numBytes) {
+                return false;
+            }
+            std::memcpy(data, pos, numBytes);
+            pos += numBytes;
+            return true;
+        }
+    };
+
+    //converts the rendered pixels (3 x 16 bit lanes in bbbbggggrrrr format) to 8 bit rgb and
+    //writes a png file
+    bool writePngFile(std::string const& filename, std::vector<uint64_t> const& imageData, IntVector2D const& imageSize)
+    {
+        std::vector<unsigned char> rgb(static_cast<size_t>(imageSize.x) * imageSize.y * 3);
+        for (size_t i = 0; i < imageData.size(); ++i) {
+            auto pixel = imageData[i];
+            rgb[i * 3] = static_cast<unsigned char>((pixel >> 8) & 0xff);
+            rgb[i * 3 + 1] = static_cast<unsigned char>((pixel >> 24) & 0xff);
+            rgb[i * 3 + 2] = static_cast<unsigned char>((pixel >> 40) & 0xff);
+        }
+        return stbi_write_png(filename.c_str(), imageSize.x, imageSize.y, 3, rgb.data(), imageSize.x * 3) != 0;
+    }
 }
 
 void EngineWorker::initCuda()
@@ -22,12 +164,19 @@ void EngineWorker::initCuda()
 void EngineWorker::newSimulation(uint64_t timestep, Settings const& settings)
 {
     _accessState = 0;
+
+    //the checkpoints hold buffers of the old cache and would be stale anyway
+    if (_dataTOCache) {
+        clearCheckpoints();
+    }
+
     _settings = settings;
     _dataTOCache = std::make_shared<_AccessDataTOCache>(settings.gpuSettings);
     _cudaSimulation = std::make_shared<_CudaSimulationFacade>(timestep, settings);
 
     if (_imageResourceToRegister) {
         _cudaResource = _cudaSimulation->registerImageResource(*_imageResourceToRegister);
+        _registeredImageResource = _imageResourceToRegister;
         _imageResourceToRegister = std::nullopt;
     }
     updateMonitorDataIntern();
@@ -35,7 +184,10 @@ void EngineWorker::newSimulation(uint64_t timestep, Settings const& settings)
 
 void EngineWorker::clear()
 {
+    clearCheckpoints();
+
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     return _cudaSimulation->clear();
 }
 
@@ -50,6 +202,7 @@ void EngineWorker::registerImageResource(void* image)
 
         EngineWorkerGuard access(this);
         _cudaResource = _cudaSimulation->registerImageResource(imageId);
+        _registeredImageResource = imageId;
     }
 }
 
@@ -59,7 +212,8 @@ void EngineWorker::tryDrawVectorGraphics(
     IntVector2D const& imageSize,
     double zoom)
 {
-    EngineWorkerGuard access(this, FrameTimeout);
+    noteRenderRequest();
+    EngineWorkerGuard access(this, calcRenderGateTimeout());
 
 
     if (!access.isTimeout()) {
@@ -69,6 +223,11 @@ void EngineWorker::tryDrawVectorGraphics(
             _cudaResource,
             {imageSize.x, imageSize.y},
             zoom);
+    } else {
+
+        //a long-running operation holds the access gate; the last completed frame is still
+        //presented so that the view does not freeze
+        _cudaSimulation->presentLastFrame(_cudaResource, {imageSize.x, imageSize.y});
     }
 }
 
@@ -78,7 +237,8 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
     IntVector2D const& imageSize,
     double zoom)
 {
-    EngineWorkerGuard access(this, FrameTimeout);
+    noteRenderRequest();
+    EngineWorkerGuard access(this, calcRenderGateTimeout());
 
     if (!access.isTimeout()) {
         _cudaSimulation->drawVectorGraphics(
@@ -92,9 +252,13 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
         DataAccessTO dataTO = _dataTOCache->getDataTO(
             {arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
 
+        //floor/ceil instead of truncation toward zero: the extraction rect tightly covers the
+        //visible area without cutting cells at the lower-right edge or, for negative
+        //coordinates, at the upper-left edge
         _cudaSimulation->getOverlayData(
-            {toInt(rectUpperLeft.x), toInt(rectUpperLeft.y)},
-            int2{toInt(rectLowerRight.x), toInt(rectLowerRight.y)},
+            {toInt(std::floor(rectUpperLeft.x)), toInt(std::floor(rectUpperLeft.y))},
+            int2{toInt(std::ceil(rectLowerRight.x)), toInt(std::ceil(rectLowerRight.y))},
+            zoom,
             dataTO);
 
         DataConverter converter(_settings.simulationParameters);
@@ -103,34 +267,71 @@ std::optional<OverlayDescription> EngineWorker::tryDrawVectorGraphicsAndReturnOv
 
         return result;
     }
+
+    //see tryDrawVectorGraphics
+    _cudaSimulation->presentLastFrame(_cudaResource, {imageSize.x, imageSize.y});
     return std::nullopt;
 }
 
 ClusteredDataDescription EngineWorker::getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
-    EngineWorkerGuard access(this);
+    //a cache hit is served without acquiring the access gate: timestep and world version are
+    //atomics, so a stale read only leads to a harmless extraction below
+    {
+        std::lock_guard guard(_mutexForExtractionCache);
+        auto timestep = _cudaSimulation->getCurrentTimestep();
+        auto worldVersion = _worldVersion.load();
+        if (_extractionCache && _extractionCache->timestep == timestep && _extractionCache->worldVersion == worldVersion
+            && _extractionCache->rectUpperLeft == rectUpperLeft && _extractionCache->rectLowerRight == rectLowerRight) {
+            return _extractionCache->data;
+        }
+    }
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSimulationData(
-        {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    uint64_t timestep;
+    uint64_t worldVersion;
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
+
+        timestep = _cudaSimulation->getCurrentTimestep();
+        worldVersion = _worldVersion.load();
+        dataTO = transferSimulationDataTO(rectUpperLeft, rectLowerRight);
+    }
 
+    //the conversion only touches the leased host buffers, so the access gate is released first
+    //and the worker resumes timesteps while the description is built
     DataConverter converter(_settings.simulationParameters);
 
     auto result = converter.convertAccessTOtoClusteredDataDescription(dataTO);
     _dataTOCache->releaseDataTO(dataTO);
 
+    {
+        std::lock_guard guard(_mutexForExtractionCache);
+        _extractionCache = ExtractionCache{timestep, worldVersion, rectUpperLeft, rectLowerRight, result};
+    }
     return result;
 }
 
-DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataAccessSchema const& schema)
 {
-    EngineWorkerGuard access(this);
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
+        dataTO = transferSimulationDataTO(rectUpperLeft, rectLowerRight, schema);
+    }
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    //see getClusteredSimulationData: the conversion runs with the access gate released
+    DataConverter converter(_settings.simulationParameters);
+
+    auto result = converter.convertAccessTOtoDataDescription(dataTO);
+    _dataTOCache->releaseDataTO(dataTO);
+
+    return result;
+}
+
+DataDescription EngineWorker::getSimulationDataIntern(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataAccessSchema const& schema)
+{
+    DataAccessTO dataTO = transferSimulationDataTO(rectUpperLeft, rectLowerRight, schema);
 
     DataConverter converter(_settings.simulationParameters);
 
@@ -140,14 +341,76 @@ DataDescription EngineWorker::getSimulationData(IntVector2D const& rectUpperLeft
     return result;
 }
 
-ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool includeClusters)
+CellBatchData EngineWorker::queryCellBatch(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
 {
-    EngineWorkerGuard access(this);
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
+        dataTO = transferSimulationDataTO(rectUpperLeft, rectLowerRight);
+    }
+
+    //columnar copy straight from the leased transfer buffers with the access gate released; no
+    //per-cell description objects are built, which is what keeps the query cheap enough to be
+    //issued once per automation step
+    CellBatchData result;
+    auto numCells = *dataTO.numCells;
+    result.ids.reserve(numCells);
+    result.posX.reserve(numCells);
+    result.posY.reserve(numCells);
+    result.velX.reserve(numCells);
+    result.velY.reserve(numCells);
+    result.energies.reserve(numCells);
+    result.colors.reserve(numCells);
+    result.numConnections.reserve(numCells);
+    for (int i = 0; i < numCells; ++i) {
+        auto const& cellTO = dataTO.cells[i];
+        result.ids.emplace_back(cellTO.id);
+        result.posX.emplace_back(cellTO.pos.x);
+        result.posY.emplace_back(cellTO.pos.y);
+        result.velX.emplace_back(cellTO.vel.x);
+        result.velY.emplace_back(cellTO.vel.y);
+        result.energies.emplace_back(cellTO.energy);
+        result.colors.emplace_back(cellTO.metadata.color);
+        result.numConnections.emplace_back(cellTO.numConnections);
+    }
+    _dataTOCache->releaseDataTO(dataTO);
+    return result;
+}
 
+DataAccessTO EngineWorker::transferSimulationDataTO(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight, DataAccessSchema const& schema)
+{
     auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
 
+    //a metadata-less extraction requests a TO without string blob, so repeated monitoring
+    //snapshots do not occupy a full-sized cached TO
+    DataAccessTO dataTO = _dataTOCache->getDataTO(
+        {arraySizes.cellArraySize,
+         arraySizes.particleArraySize,
+         arraySizes.tokenArraySize,
+         schema.includeMetadata ? MAX_STRING_BYTES : 0});
+    dataTO.includeMetadata = schema.includeMetadata;
+    dataTO.includeTokenMemories = schema.includeTokenMemories;
+    auto transferStart = std::chrono::steady_clock::now();
+    _cudaSimulation->getSimulationData({rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    recordLatency(_transferLatency, transferStart);
+    return dataTO;
+}
+
+ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool includeClusters)
+{
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
+
+        //the host buffers are sized from the actual selection counts, not the full array capacities
+        auto numEntities = _cudaSimulation->extractSelectedSimulationData(includeClusters);
+        dataTO = _dataTOCache->getDataTO({numEntities.cellArraySize, numEntities.particleArraySize, numEntities.tokenArraySize});
+        auto transferStart = std::chrono::steady_clock::now();
+        _cudaSimulation->retrieveExtractedSimulationData(dataTO);
+        recordLatency(_transferLatency, transferStart);
+    }
+
+    //see getClusteredSimulationData: the conversion runs with the access gate released
     DataConverter converter(_settings.simulationParameters);
 
     auto result = converter.convertAccessTOtoClusteredDataDescription(dataTO);
@@ -158,13 +421,19 @@ ClusteredDataDescription EngineWorker::getSelectedClusteredSimulationData(bool i
 
 DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 {
-    EngineWorkerGuard access(this);
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getSelectedSimulationData(includeClusters, dataTO);
+        //the host buffers are sized from the actual selection counts, not the full array capacities
+        auto numEntities = _cudaSimulation->extractSelectedSimulationData(includeClusters);
+        dataTO = _dataTOCache->getDataTO({numEntities.cellArraySize, numEntities.particleArraySize, numEntities.tokenArraySize});
+        auto transferStart = std::chrono::steady_clock::now();
+        _cudaSimulation->retrieveExtractedSimulationData(dataTO);
+        recordLatency(_transferLatency, transferStart);
+    }
 
+    //see getClusteredSimulationData: the conversion runs with the access gate released
     DataConverter converter(_settings.simulationParameters);
 
     auto result = converter.convertAccessTOtoDataDescription(dataTO);
@@ -175,13 +444,18 @@ DataDescription EngineWorker::getSelectedSimulationData(bool includeClusters)
 
 DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> entityIds)
 {
-    EngineWorkerGuard access(this);
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
 
-    auto arraySizes = _cudaSimulation->getArraySizes();
-    DataAccessTO dataTO =
-        _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
-    _cudaSimulation->getInspectedSimulationData(entityIds, dataTO);
+        auto arraySizes = _cudaSimulation->getArraySizes();
+        dataTO = _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        auto transferStart = std::chrono::steady_clock::now();
+        _cudaSimulation->getInspectedSimulationData(entityIds, dataTO);
+        recordLatency(_transferLatency, transferStart);
+    }
 
+    //see getClusteredSimulationData: the conversion runs with the access gate released
     DataConverter converter(_settings.simulationParameters);
 
     auto result = converter.convertAccessTOtoDataDescription(dataTO, DataConverter::SortTokens::Yes);
@@ -190,6 +464,23 @@ DataDescription EngineWorker::getInspectedSimulationData(std::vector<uint64_t> e
     return result;
 }
 
+void EngineWorker::setInspectedEntityIds(std::vector<uint64_t> const& entityIds, std::chrono::milliseconds const& updateInterval)
+{
+    std::lock_guard guard(_mutexForInspection);
+    _inspectedEntityIds = entityIds;
+    _inspectionUpdateInterval = updateInterval;
+    _lastInspectionUpdate.reset();    //the new set is pushed with the next worker loop iteration
+    _pushedInspectionData.reset();    //data for the old set must not be applied to the new one
+}
+
+std::optional<DataDescription> EngineWorker::fetchInspectionData()
+{
+    std::lock_guard guard(_mutexForInspection);
+    auto result = std::move(_pushedInspectionData);
+    _pushedInspectionData.reset();
+    return result;
+}
+
 MonitorData EngineWorker::getMonitorData() const
 {
     std::lock_guard guard(_mutexForStatistics);
@@ -197,6 +488,44 @@ MonitorData EngineWorker::getMonitorData() const
     return _lastStatistics;
 }
 
+std::vector<CellEvent> EngineWorker::retrieveCellEvents()
+{
+    std::lock_guard guard(_mutexForStatistics);
+
+    auto result = std::move(_bufferedCellEvents);
+    _bufferedCellEvents.clear();
+    return result;
+}
+
+void EngineWorker::setLineageTrackingEnabled(bool enabled)
+{
+    EngineWorkerGuard access(this);
+    _cudaSimulation->setLineageTrackingEnabled(enabled);
+}
+
+std::vector<LineageRecord> EngineWorker::retrieveLineageRecords()
+{
+    std::lock_guard guard(_mutexForStatistics);
+
+    auto result = std::move(_bufferedLineageRecords);
+    _bufferedLineageRecords.clear();
+    return result;
+}
+
+uint64_t EngineWorker::calcWorldHash()
+{
+    EngineWorkerGuard access(this);
+
+    return _cudaSimulation->calcWorldHash();
+}
+
+GpuMemoryInfo EngineWorker::getGpuMemoryInfo()
+{
+    EngineWorkerGuard access(this);
+
+    return _cudaSimulation->getMemoryInfo();
+}
+
 namespace
 {
     struct NumberOfEntities
@@ -234,6 +563,7 @@ void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdat
     auto numberOfEntities = getNumberOfEntities(dataToUpdate);
 
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->resizeArraysIfNecessary(
         {numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
@@ -243,17 +573,25 @@ void EngineWorker::addAndSelectSimulationData(DataDescription const& dataToUpdat
     DataConverter converter(_settings.simulationParameters);
     converter.convertDataDescriptionToAccessTO(dataTO, dataToUpdate);
 
+    auto transferStart = std::chrono::steady_clock::now();
     _cudaSimulation->addAndSelectSimulationData(dataTO);
+    recordLatency(_transferLatency, transferStart);
     updateMonitorDataIntern();
 
     _dataTOCache->releaseDataTO(dataTO);
 }
 
 void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate)
+{
+    EngineWorkerGuard access(this);
+    setClusteredSimulationDataIntern(dataToUpdate);
+}
+
+void EngineWorker::setClusteredSimulationDataIntern(ClusteredDataDescription const& dataToUpdate)
 {
     auto numberOfEntities = getNumberOfEntities(dataToUpdate);
 
-    EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->resizeArraysIfNecessary(
         {numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
@@ -263,17 +601,25 @@ void EngineWorker::setClusteredSimulationData(ClusteredDataDescription const& da
     DataConverter converter(_settings.simulationParameters);
     converter.convertClusteredDataDescriptionToAccessTO(dataTO, dataToUpdate);
 
+    auto transferStart = std::chrono::steady_clock::now();
     _cudaSimulation->setSimulationData(dataTO);
+    recordLatency(_transferLatency, transferStart);
     updateMonitorDataIntern();
 
     _dataTOCache->releaseDataTO(dataTO);
 }
 
 void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
+{
+    EngineWorkerGuard access(this);
+    setSimulationDataIntern(dataToUpdate);
+}
+
+void EngineWorker::setSimulationDataIntern(DataDescription const& dataToUpdate)
 {
     auto numberOfEntities = getNumberOfEntities(dataToUpdate);
 
-    EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->resizeArraysIfNecessary({numberOfEntities.cells, numberOfEntities.particles, numberOfEntities.tokens});
 
@@ -282,15 +628,273 @@ void EngineWorker::setSimulationData(DataDescription const& dataToUpdate)
     DataConverter converter(_settings.simulationParameters);
     converter.convertDataDescriptionToAccessTO(dataTO, dataToUpdate);
 
+    auto transferStart = std::chrono::steady_clock::now();
+    _cudaSimulation->setSimulationData(dataTO);
+    recordLatency(_transferLatency, transferStart);
+    updateMonitorDataIntern();
+
+    _dataTOCache->releaseDataTO(dataTO);
+}
+
+bool EngineWorker::saveSimulationDataToFile(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    joinSnapshotWriterThread();    //a pending background write could target the same file
+
+    DataAccessTO dataTO;
+    {
+        //hold the access gate only for the extraction into the pinned transfer buffers so that the
+        //simulation resumes while the snapshot is streamed to disk
+        EngineWorkerGuard access(this);
+        dataTO = provideTO();
+        _cudaSimulation->getSimulationData(
+            {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    }
+
+    auto result = writeSnapshotFile(filename, dataTO);
+    _dataTOCache->releaseDataTO(dataTO);
+    return result;
+}
+
+void EngineWorker::saveSimulationDataToFile_async(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    joinSnapshotWriterThread();
+
+    DataAccessTO dataTO;
+    {
+        EngineWorkerGuard access(this);
+        dataTO = provideTO();
+        _cudaSimulation->getSimulationData(
+            {rectUpperLeft.x, rectUpperLeft.y}, int2{rectLowerRight.x, rectLowerRight.y}, dataTO);
+    }
+
+    //the transfer buffers are an independent copy of the world; the disk write proceeds on a
+    //background thread while the simulation and the gui continue
+    _snapshotWriterThread = std::thread([this, filename, dataTO] {
+        writeSnapshotFile(filename, dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
+    });
+}
+
+bool EngineWorker::writeSnapshotFile(std::string const& filename, DataAccessTO const& dataTO)
+{
+    //the snapshot is written to a temporary file and renamed into place so that an interrupted
+    //save never destroys the previous snapshot
+    auto tmpFilename = std::filesystem::path(filename);
+    tmpFilename += ".tmp";
+    {
+        std::ofstream stream(tmpFilename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        stream.write(RawSnapshotHeader.data(), RawSnapshotHeader.size());
+        writeValue(stream, uint64_t(0));    //payload size, patched below
+        writeValue(stream, uint64_t(0));    //payload hash, patched below
+
+        HashingWriter writer{stream};
+        writer.writeValue(*dataTO.numCells);
+        writer.writeValue(*dataTO.numParticles);
+        writer.writeValue(*dataTO.numTokens);
+        writer.writeValue(*dataTO.numStringBytes);
+        writer.writeArray(dataTO.cells, *dataTO.numCells);
+        writer.writeArray(dataTO.particles, *dataTO.numParticles);
+        writer.writeArray(dataTO.tokens, *dataTO.numTokens);
+        writer.writeArray(dataTO.stringBytes, *dataTO.numStringBytes);
+
+        stream.seekp(RawSnapshotHeader.size());
+        writeValue(stream, writer.numBytesWritten);
+        writeValue(stream, writer.hash);
+
+        if (!stream) {
+            stream.close();
+            std::error_code errorCode;
+            std::filesystem::remove(tmpFilename, errorCode);
+            return false;
+        }
+    }
+    std::error_code errorCode;
+    std::filesystem::rename(tmpFilename, std::filesystem::path(filename), errorCode);
+    if (errorCode) {
+        std::filesystem::remove(tmpFilename, errorCode);
+        return false;
+    }
+    return true;
+}
+
+void EngineWorker::joinSnapshotWriterThread()
+{
+    if (_snapshotWriterThread.joinable()) {
+        _snapshotWriterThread.join();
+    }
+}
+
+void EngineWorker::joinImageWriterThread()
+{
+    if (_imageWriterThread.joinable()) {
+        _imageWriterThread.join();
+    }
+}
+
+bool EngineWorker::loadSimulationDataFromFile(std::string const& filename)
+{
+    //the file is memory-mapped: the operating system pages the contents in on demand and the
+    //arrays are copied from the mapped pages directly into the pinned transfer buffers
+    MappedFile file;
+    if (!file.open(filename)) {
+        return false;
+    }
+    if (file.size() < RawSnapshotHeader.size()) {
+        return false;
+    }
+    MappedFileReader reader{file.data(), file.data() + file.size()};
+    if (0 == std::memcmp(file.data(), RawSnapshotHeader.data(), RawSnapshotHeader.size())) {
+        reader.pos += RawSnapshotHeader.size();
+
+        //a wrong size or hash means the file is truncated or corrupt; it is rejected here before
+        //anything is parsed
+        uint64_t payloadSize, hash;
+        if (!reader.readValue(payloadSize) || !reader.readValue(hash)) {
+            return false;
+        }
+        if (static_cast<uint64_t>(reader.end - reader.pos) != payloadSize) {
+            return false;
+        }
+        if (hash != updateHash(HashOffsetBasis, reader.pos, payloadSize)) {
+            return false;
+        }
+    } else if (0 == std::memcmp(file.data(), RawSnapshotHeaderV1.data(), RawSnapshotHeaderV1.size())) {
+        //version 1 carries no integrity data; still accepted so that existing autosaves load
+        reader.pos += RawSnapshotHeaderV1.size();
+    } else {
+        return false;
+    }
+
+    int numCells, numParticles, numTokens, numStringBytes;
+    if (!reader.readValue(numCells) || !reader.readValue(numParticles) || !reader.readValue(numTokens)
+        || !reader.readValue(numStringBytes)) {
+        return false;
+    }
+    if (numCells < 0 || numParticles < 0 || numTokens < 0 || numStringBytes < 0 || numStringBytes > MAX_STRING_BYTES) {
+        return false;
+    }
+
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+
+    _cudaSimulation->resizeArraysIfNecessary({numCells, numParticles, numTokens});
+
+    DataAccessTO dataTO = provideTO();
+    *dataTO.numCells = numCells;
+    *dataTO.numParticles = numParticles;
+    *dataTO.numTokens = numTokens;
+    *dataTO.numStringBytes = numStringBytes;
+    if (!reader.readArray(dataTO.cells, numCells) || !reader.readArray(dataTO.particles, numParticles)
+        || !reader.readArray(dataTO.tokens, numTokens) || !reader.readArray(dataTO.stringBytes, numStringBytes)) {
+        _dataTOCache->releaseDataTO(dataTO);
+        return false;
+    }
+
     _cudaSimulation->setSimulationData(dataTO);
     updateMonitorDataIntern();
 
     _dataTOCache->releaseDataTO(dataTO);
+    return true;
+}
+
+std::vector<uint64_t> EngineWorker::getImageData(
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    std::vector<uint64_t> result(static_cast<size_t>(imageSize.x) * imageSize.y);
+
+    EngineWorkerGuard access(this);
+    _cudaSimulation->drawImageToHost(
+        {rectUpperLeft.x, rectUpperLeft.y}, {rectLowerRight.x, rectLowerRight.y}, {imageSize.x, imageSize.y}, zoom, result.data());
+    return result;
+}
+
+std::vector<uint64_t> EngineWorker::getThumbnail(IntVector2D const& imageSize)
+{
+    std::vector<uint64_t> result(static_cast<size_t>(imageSize.x) * imageSize.y);
+
+    EngineWorkerGuard access(this);
+    _cudaSimulation->drawThumbnailToHost({imageSize.x, imageSize.y}, result.data());
+    return result;
+}
+
+void EngineWorker::saveSimulationImageToFile_async(
+    std::string const& filename,
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    joinImageWriterThread();    //a pending background write could target the same file
+
+    auto imageData = std::make_shared<std::vector<uint64_t>>(static_cast<size_t>(imageSize.x) * imageSize.y);
+    {
+        //hold the access gate only for the offscreen render and the copy to host; the png encoding
+        //and the disk write run on a background thread
+        EngineWorkerGuard access(this);
+        _cudaSimulation->drawImageToHost(
+            {rectUpperLeft.x, rectUpperLeft.y},
+            {rectLowerRight.x, rectLowerRight.y},
+            {imageSize.x, imageSize.y},
+            zoom,
+            imageData->data());
+    }
+
+    _imageWriterThread = std::thread([filename, imageSize, imageData] { writePngFile(filename, *imageData, imageSize); });
+}
+
+void EngineWorker::startTimelapse(
+    std::string const& filenamePrefix,
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom,
+    int timestepStride)
+{
+    stopTimelapse();    //a running timelapse is replaced, not stacked
+
+    {
+        std::lock_guard guard(_mutexForTimelapse);
+        _timelapse = TimelapseSettings{filenamePrefix, rectUpperLeft, rectLowerRight, imageSize, zoom, std::max(1, timestepStride)};
+        _nextTimelapseTimestep = 0;  //capture the first frame with the next batch
+        _timelapseFrameCounter = 0;
+        _numDroppedTimelapseFrames = 0;
+        _timelapseEncoderShutdown = false;
+    }
+    _timelapseEncoderThread = std::thread([this] { timelapseEncoderLoop(); });
+    _timelapseActive.store(true);
+}
+
+void EngineWorker::stopTimelapse()
+{
+    if (!_timelapseActive.exchange(false)) {
+        return;
+    }
+    {
+        std::lock_guard guard(_mutexForTimelapse);
+        _timelapse.reset();
+        _timelapseEncoderShutdown = true;
+    }
+    _timelapseConditionVariable.notify_all();
+    _timelapseEncoderThread.join();
+
+    std::lock_guard guard(_mutexForTimelapse);
+    if (_numDroppedTimelapseFrames > 0) {
+        log(Priority::Important,
+            "timelapse: " + std::to_string(_numDroppedTimelapseFrames) + " of "
+                + std::to_string(_timelapseFrameCounter + _numDroppedTimelapseFrames) + " frames dropped because the encoder fell behind");
+    }
 }
 
 void EngineWorker::removeSelectedEntities(bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->removeSelectedEntities(includeClusters);
     updateMonitorDataIntern();
@@ -299,6 +903,7 @@ void EngineWorker::removeSelectedEntities(bool includeClusters)
 void EngineWorker::relaxSelectedEntities(bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->relaxSelectedEntities(includeClusters);
 }
@@ -306,6 +911,7 @@ void EngineWorker::relaxSelectedEntities(bool includeClusters)
 void EngineWorker::uniformVelocitiesForSelectedEntities(bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->uniformVelocitiesForSelectedEntities(includeClusters);
 }
@@ -313,6 +919,7 @@ void EngineWorker::uniformVelocitiesForSelectedEntities(bool includeClusters)
 void EngineWorker::makeSticky(bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->makeSticky(includeClusters);
 }
@@ -320,6 +927,7 @@ void EngineWorker::makeSticky(bool includeClusters)
 void EngineWorker::removeStickiness(bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->removeStickiness(includeClusters);
 }
@@ -327,13 +935,44 @@ void EngineWorker::removeStickiness(bool includeClusters)
 void EngineWorker::setBarrier(bool value, bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     _cudaSimulation->setBarrier(value, includeClusters);
 }
 
+void EngineWorker::executeEditBatch(std::vector<EditCommand> const& commands)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+
+    for (auto const& command : commands) {
+        if (std::holds_alternative<EditCommands::RemoveSelectedEntities>(command)) {
+            _cudaSimulation->removeSelectedEntities(std::get<EditCommands::RemoveSelectedEntities>(command).includeClusters);
+        } else if (std::holds_alternative<EditCommands::RelaxSelectedEntities>(command)) {
+            _cudaSimulation->relaxSelectedEntities(std::get<EditCommands::RelaxSelectedEntities>(command).includeClusters);
+        } else if (std::holds_alternative<EditCommands::UniformVelocitiesForSelectedEntities>(command)) {
+            _cudaSimulation->uniformVelocitiesForSelectedEntities(std::get<EditCommands::UniformVelocitiesForSelectedEntities>(command).includeClusters);
+        } else if (std::holds_alternative<EditCommands::MakeSticky>(command)) {
+            _cudaSimulation->makeSticky(std::get<EditCommands::MakeSticky>(command).includeClusters);
+        } else if (std::holds_alternative<EditCommands::RemoveStickiness>(command)) {
+            _cudaSimulation->removeStickiness(std::get<EditCommands::RemoveStickiness>(command).includeClusters);
+        } else if (std::holds_alternative<EditCommands::SetBarrier>(command)) {
+            auto const& setBarrier = std::get<EditCommands::SetBarrier>(command);
+            _cudaSimulation->setBarrier(setBarrier.value, setBarrier.includeClusters);
+        } else if (std::holds_alternative<EditCommands::ColorSelectedEntities>(command)) {
+            auto const& colorEntities = std::get<EditCommands::ColorSelectedEntities>(command);
+            _cudaSimulation->colorSelectedEntities(colorEntities.color, colorEntities.includeClusters);
+        } else if (std::holds_alternative<EditCommands::ReconnectSelectedEntities>(command)) {
+            _cudaSimulation->reconnectSelectedEntities();
+        }
+    }
+    updateMonitorDataIntern();
+}
+
 void EngineWorker::changeCell(CellDescription const& changedCell)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     auto dataTO = provideTO();
 
@@ -348,6 +987,7 @@ void EngineWorker::changeCell(CellDescription const& changedCell)
 void EngineWorker::changeParticle(ParticleDescription const& changedParticle)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
 
     auto dataTO = provideTO();
 
@@ -367,13 +1007,131 @@ void EngineWorker::calcSingleTimestep()
     updateMonitorDataIntern();
 }
 
-void EngineWorker::beginShutdown()
+std::future<DataDescription> EngineWorker::getSimulationData_async(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    auto task = std::make_shared<std::packaged_task<DataDescription()>>(
+        [this, rectUpperLeft, rectLowerRight] { return getSimulationDataIntern(rectUpperLeft, rectLowerRight); });
+    auto result = task->get_future();
+    std::unique_lock<std::mutex> lock(_mutexForAsyncJobs);
+    _commandJobs.emplace_back([task] { (*task)(); });
+    notifyWorker();
+    return result;
+}
+
+std::future<void> EngineWorker::setSimulationData_async(DataDescription dataToUpdate)
+{
+    auto task = std::make_shared<std::packaged_task<void()>>(
+        [this, dataToUpdate = std::move(dataToUpdate)] { setSimulationDataIntern(dataToUpdate); });
+    auto result = task->get_future();
+    std::unique_lock<std::mutex> lock(_mutexForAsyncJobs);
+    _commandJobs.emplace_back([task] { (*task)(); });
+    notifyWorker();
+    return result;
+}
+
+std::future<void> EngineWorker::calcSingleTimestep_async()
+{
+    auto task = std::make_shared<std::packaged_task<void()>>([this] {
+        _cudaSimulation->calcTimestep();
+        updateMonitorDataIntern();
+    });
+    auto result = task->get_future();
+    std::unique_lock<std::mutex> lock(_mutexForAsyncJobs);
+    _commandJobs.emplace_back([task] { (*task)(); });
+    notifyWorker();
+    return result;
+}
+
+void EngineWorker::calcTimesteps(int numTimesteps)
+{
+    EngineWorkerGuard access(this);
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    _cudaSimulation->calcTimesteps(numTimesteps);
+    recordLatency(_timestepLatency, startTimepoint, numTimesteps);
+    updateMonitorDataIntern();
+}
+
+std::vector<KernelTiming> EngineWorker::benchmarkTimestep()
+{
+    EngineWorkerGuard access(this);
+
+    auto timings = _cudaSimulation->benchmarkTimestep();
+    updateMonitorDataIntern();
+    return timings;
+}
+
+GpuSettings EngineWorker::autoTuneGpuSettings()
+{
+    EngineWorkerGuard access(this);
+
+    auto origGpuSettings = _settings.gpuSettings;
+    auto bestGpuSettings = origGpuSettings;
+    auto bestDuration = std::chrono::microseconds::max();
+
+    for (auto const& numThreadsPerBlock : TuningThreadsPerBlockCandidates) {
+        for (auto const& numBlocks : TuningNumBlocksCandidates) {
+            auto candidate = origGpuSettings;
+            candidate.numThreadsPerBlock = numThreadsPerBlock;
+            candidate.numBlocks = numBlocks;
+            _cudaSimulation->setGpuConstants(candidate);
+
+            _cudaSimulation->calcTimesteps(TuningNumWarmupTimesteps);
+
+            auto startTimepoint = std::chrono::steady_clock::now();
+            _cudaSimulation->calcTimesteps(TuningNumTimestepsPerCandidate);
+            auto duration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
+
+            std::stringstream stream;
+            stream << "auto-tuning: " << numBlocks << " blocks with " << numThreadsPerBlock << " threads per block took "
+                   << duration.count() / 1000 << " ms";
+            log(Priority::Unimportant, stream.str());
+
+            if (duration < bestDuration) {
+                bestDuration = duration;
+                bestGpuSettings = candidate;
+            }
+        }
+    }
+
+    _cudaSimulation->setGpuConstants(bestGpuSettings);
+    _settings.gpuSettings = bestGpuSettings;
+
+    std::stringstream stream;
+    stream << "auto-tuning finished: adopting " << bestGpuSettings.numBlocks << " blocks with " << bestGpuSettings.numThreadsPerBlock
+           << " threads per block";
+    log(Priority::Important, stream.str());
+
+    updateMonitorDataIntern();
+    return bestGpuSettings;
+}
+
+void EngineWorker::setKernelProfilingEnabled(bool enabled)
+{
+    _cudaSimulation->setKernelProfilingEnabled(enabled);
+}
+
+bool EngineWorker::isKernelProfilingEnabled() const
+{
+    return _cudaSimulation->isKernelProfilingEnabled();
+}
+
+KernelProfileData EngineWorker::getKernelProfileData() const
+{
+    return _cudaSimulation->getKernelProfileData();
+}
+
+void EngineWorker::beginShutdown()
 {
     _isShutdown.store(true);
+    notifyWorker();
 }
 
 void EngineWorker::endShutdown()
 {
+    stopTimelapse();
+    joinSnapshotWriterThread();
+    joinImageWriterThread();
     _isSimulationRunning = false;
     _isShutdown = false;
     _cudaSimulation.reset();
@@ -390,6 +1148,11 @@ void EngineWorker::setTpsRestriction(int value)
     _tpsRestriction.store(value);
 }
 
+void EngineWorker::setFramesPerSecond(int value)
+{
+    _framesPerSecond.store(value);
+}
+
 float EngineWorker::getTps() const
 {
     return _tps.load();
@@ -400,34 +1163,200 @@ uint64_t EngineWorker::getCurrentTimestep() const
     return _cudaSimulation->getCurrentTimestep();
 }
 
+uint64_t EngineWorker::getWorldVersion() const
+{
+    return _worldVersion.load();
+}
+
 void EngineWorker::setCurrentTimestep(uint64_t value)
 {
     EngineWorkerGuard access(this);
     _cudaSimulation->setCurrentTimestep(value);
 }
 
+void EngineWorker::setCheckpointInterval(int timesteps)
+{
+    if (_checkpointInterval.exchange(timesteps) == timesteps) {
+        return;
+    }
+    if (0 == timesteps) {
+        clearCheckpoints();
+    } else {
+
+        //capture the first checkpoint with the next batch
+        _nextCheckpointTimestep.store(0);
+    }
+}
+
+std::vector<uint64_t> EngineWorker::getCheckpointTimesteps() const
+{
+    std::lock_guard guard(_mutexForCheckpoints);
+    std::vector<uint64_t> result;
+    result.reserve(_checkpoints.size());
+    for (auto const& checkpoint : _checkpoints) {
+        result.emplace_back(checkpoint.timestep);
+    }
+    return result;
+}
+
+std::optional<uint64_t> EngineWorker::rewindToLastCheckpoint()
+{
+    Checkpoint checkpoint;
+    {
+        std::lock_guard guard(_mutexForCheckpoints);
+        if (_checkpoints.empty()) {
+            return std::nullopt;
+        }
+        checkpoint = _checkpoints.back();
+        _checkpoints.pop_back();
+    }
+
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+
+    //the stored transfer objects are uploaded as-is: no serialization and no description
+    //conversion is involved, so a rewind costs a single host-to-device transfer
+    auto const& dataTO = *checkpoint.dataTO;
+    _cudaSimulation->resizeArraysIfNecessary({*dataTO.numCells, *dataTO.numParticles, *dataTO.numTokens});
+    auto transferStart = std::chrono::steady_clock::now();
+    _cudaSimulation->setSimulationData(dataTO);
+    recordLatency(_transferLatency, transferStart);
+    _cudaSimulation->setCurrentTimestep(checkpoint.timestep);
+    _nextCheckpointTimestep.store(checkpoint.timestep + _checkpointInterval.load());
+    updateMonitorDataIntern();
+
+    _dataTOCache->releaseDataTO(dataTO);
+    return checkpoint.timestep;
+}
+
+void EngineWorker::captureCheckpointIfDue()
+{
+    auto interval = _checkpointInterval.load();
+    if (interval <= 0) {
+        return;
+    }
+    auto timestep = _cudaSimulation->getCurrentTimestep();
+    if (timestep < _nextCheckpointTimestep.load()) {
+        return;
+    }
+    _nextCheckpointTimestep.store(timestep + interval);
+
+    auto dataTO = transferSimulationDataTO(
+        {-10, -10}, {_settings.generalSettings.worldSizeX + 10, _settings.generalSettings.worldSizeY + 10});
+
+    std::lock_guard guard(_mutexForCheckpoints);
+    _checkpoints.emplace_back(Checkpoint{timestep, std::make_shared<DataAccessTO>(dataTO)});
+    if (_checkpoints.size() > CheckpointRingCapacity) {
+        _dataTOCache->releaseDataTO(*_checkpoints.front().dataTO);
+        _checkpoints.pop_front();
+    }
+}
+
+void EngineWorker::clearCheckpoints()
+{
+    std::lock_guard guard(_mutexForCheckpoints);
+    for (auto const& checkpoint : _checkpoints) {
+        _dataTOCache->releaseDataTO(*checkpoint.dataTO);
+    }
+    _checkpoints.clear();
+}
+
+void EngineWorker::captureTimelapseFrameIfDue()
+{
+    if (!_timelapseActive.load()) {
+        return;
+    }
+    TimelapseSettings settings;
+    {
+        std::lock_guard guard(_mutexForTimelapse);
+        if (!_timelapse) {
+            return;
+        }
+        auto timestep = _cudaSimulation->getCurrentTimestep();
+        if (timestep < _nextTimelapseTimestep) {
+            return;
+        }
+        _nextTimelapseTimestep = timestep + _timelapse->timestepStride;
+        settings = *_timelapse;
+    }
+
+    //runs on the worker thread between timestep batches, so the render needs no access gate
+    auto imageData = std::make_shared<std::vector<uint64_t>>(static_cast<size_t>(settings.imageSize.x) * settings.imageSize.y);
+    _cudaSimulation->drawImageToHost(
+        {settings.rectUpperLeft.x, settings.rectUpperLeft.y},
+        {settings.rectLowerRight.x, settings.rectLowerRight.y},
+        {settings.imageSize.x, settings.imageSize.y},
+        settings.zoom,
+        imageData->data());
+
+    {
+        std::lock_guard guard(_mutexForTimelapse);
+        if (_timelapseFrameQueue.size() >= MaxQueuedTimelapseFrames) {
+
+            //the encoder fell behind; dropping the frame keeps the simulation running at full
+            //speed, a stale timelapse frame is worthless anyway
+            ++_numDroppedTimelapseFrames;
+            return;
+        }
+        std::stringstream filename;
+        filename << settings.filenamePrefix << std::setfill('0') << std::setw(6) << _timelapseFrameCounter++ << ".png";
+        _timelapseFrameQueue.emplace_back(TimelapseFrame{filename.str(), settings.imageSize, imageData});
+    }
+    _timelapseConditionVariable.notify_all();
+}
+
+void EngineWorker::timelapseEncoderLoop()
+{
+    while (true) {
+        TimelapseFrame frame;
+        {
+            std::unique_lock uniqueLock(_mutexForTimelapse);
+            _timelapseConditionVariable.wait(uniqueLock, [this] { return !_timelapseFrameQueue.empty() || _timelapseEncoderShutdown; });
+            if (_timelapseFrameQueue.empty()) {
+                return;  //shutdown and the queue is drained
+            }
+            frame = _timelapseFrameQueue.front();
+            _timelapseFrameQueue.pop_front();
+        }
+        if (!writePngFile(frame.filename, *frame.imageData, frame.imageSize)) {
+            log(Priority::Important, "timelapse: could not write '" + frame.filename + "'");
+        }
+    }
+}
+
 void EngineWorker::setSimulationParameters_async(SimulationParameters const& parameters)
 {
     std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
     _updateSimulationParametersJob = parameters;
+    notifyWorker();
 }
 
 void EngineWorker::setSimulationParametersSpots_async(SimulationParametersSpots const& spots)
 {
     std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
     _updateSimulationParametersSpotsJob = spots;
+    notifyWorker();
 }
 
 void EngineWorker::setGpuSettings_async(GpuSettings const& gpuSettings)
 {
     std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
     _updateGpuSettingsJob = gpuSettings;
+    notifyWorker();
 }
 
 void EngineWorker::setFlowFieldSettings_async(FlowFieldSettings const& flowFieldSettings)
 {
     std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
     _flowFieldSettings = flowFieldSettings;
+    notifyWorker();
+}
+
+void EngineWorker::setStatisticsRects_async(std::vector<RealRect> const& rects)
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+    _updateStatisticsRectsJob = rects;
+    notifyWorker();
 }
 
 void EngineWorker::applyForce_async(
@@ -438,17 +1367,20 @@ void EngineWorker::applyForce_async(
 {
     std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
     _applyForceJobs.emplace_back(ApplyForceJob{start, end, force, radius});
+    notifyWorker();
 }
 
 void EngineWorker::switchSelection(RealVector2D const& pos, float radius)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->switchSelection(PointSelectionData{{pos.x, pos.y}, radius});
 }
 
 void EngineWorker::swapSelection(RealVector2D const& pos, float radius)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->swapSelection(PointSelectionData{{pos.x, pos.y}, radius});
 }
 
@@ -461,12 +1393,14 @@ SelectionShallowData EngineWorker::getSelectionShallowData()
 void EngineWorker::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->setSelection(AreaSelectionData{{startPos.x, startPos.y}, {endPos.x, endPos.y}});
 }
 
 void EngineWorker::removeSelection()
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->removeSelection();
 
     updateMonitorDataIntern();
@@ -475,31 +1409,180 @@ void EngineWorker::removeSelection()
 void EngineWorker::updateSelection()
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->updateSelection();
 }
 
 void EngineWorker::shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& updateData)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->shallowUpdateSelectedEntities(updateData);
 
     updateMonitorDataIntern();
 }
 
+void EngineWorker::shallowUpdateSelectedEntities_async(ShallowUpdateSelectionData const& updateData)
+{
+    std::unique_lock<std::mutex> uniqueLock(_mutexForAsyncJobs);
+
+    //a drag gesture changes one kind of delta at a time, so summing the deltas of compatible
+    //jobs is equivalent to applying them one after another
+    if (!_shallowUpdateSelectionJobs.empty() && _shallowUpdateSelectionJobs.back().considerClusters == updateData.considerClusters) {
+        auto& lastJob = _shallowUpdateSelectionJobs.back();
+        lastJob.posDeltaX += updateData.posDeltaX;
+        lastJob.posDeltaY += updateData.posDeltaY;
+        lastJob.velDeltaX += updateData.velDeltaX;
+        lastJob.velDeltaY += updateData.velDeltaY;
+        lastJob.angleDelta += updateData.angleDelta;
+        lastJob.angularVelDelta += updateData.angularVelDelta;
+    } else {
+        _shallowUpdateSelectionJobs.emplace_back(updateData);
+    }
+    notifyWorker();
+}
+
 void EngineWorker::colorSelectedEntities(unsigned char color, bool includeClusters)
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->colorSelectedEntities(color, includeClusters);
 
     updateMonitorDataIntern();
 }
 
+void EngineWorker::scaleEnergyForSelectedEntities(float factor, bool includeClusters)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->scaleEnergyForSelectedEntities(factor, includeClusters);
+
+    updateMonitorDataIntern();
+}
+
+void EngineWorker::setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->setBranchNumberForSelectedEntities(branchNumber, includeClusters);
+}
+
+void EngineWorker::colorizeClusters(std::vector<int> const& colorCodes)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->colorizeClusters(colorCodes, NumberGenerator::getInstance().getRandomInt());
+}
+
+void EngineWorker::applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->applyEnergyDeltaToCells(cellIds, energyDelta);
+}
+
 void EngineWorker::reconnectSelectedEntities()
 {
     EngineWorkerGuard access(this);
+    ++_worldVersion;
     _cudaSimulation->reconnectSelectedEntities();
 }
 
+void EngineWorker::cloneSelectedEntities(RealVector2D const& posDelta, bool includeClusters)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->cloneSelectedEntities({posDelta.x, posDelta.y}, includeClusters);
+
+    updateMonitorDataIntern();
+}
+
+void EngineWorker::replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, RealVector2D const& center)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->replicateSelectedEntities(transforms, {center.x, center.y});
+
+    updateMonitorDataIntern();
+}
+
+void EngineWorker::drawBarrier(std::vector<RealVector2D> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode)
+{
+    std::vector<float2> cudaStroke;
+    cudaStroke.reserve(stroke.size());
+    for (auto const& vertex : stroke) {
+        cudaStroke.emplace_back(float2{vertex.x, vertex.y});
+    }
+
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->drawBarrier(cudaStroke, paintFirstVertex, cellDistance, energy, colorCode);
+
+    updateMonitorDataIntern();
+}
+
+void EngineWorker::convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, RealVector2D const& center)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->convertImageToPattern(imageData, width, height, numChannels, {center.x, center.y});
+
+    updateMonitorDataIntern();
+}
+
+void EngineWorker::generateWorld(WorldGenerationSpec const& spec)
+{
+    EngineWorkerGuard access(this);
+    ++_worldVersion;
+    _cudaSimulation->generateWorld(spec);
+
+    updateMonitorDataIntern();
+}
+
+void EngineWorker::setFreezeZone(std::optional<RealRect> const& zone)
+{
+    EngineWorkerGuard access(this);
+    if (zone) {
+        _cudaSimulation->setFreezeZone(true, {zone->topLeft.x, zone->topLeft.y}, {zone->bottomRight.x, zone->bottomRight.y});
+    } else {
+        _cudaSimulation->setFreezeZone(false, {0, 0}, {0, 0});
+    }
+}
+
+bool EngineWorker::tryRecoverFromAllocationFailure(std::string const& reason)
+{
+    try {
+        log(Priority::Important, "gpu memory allocation failed (" + reason + "): snapshotting world to host and rebuilding the device context");
+
+        //allocation failures leave the device context intact, so the entities can still be
+        //transferred to the host
+        auto timestep = _cudaSimulation->getCurrentTimestep();
+        auto arraySizes = _cudaSimulation->getArraySizes();
+        DataAccessTO dataTO =
+            _dataTOCache->getDataTO({arraySizes.cellArraySize, arraySizes.particleArraySize, arraySizes.tokenArraySize});
+        _cudaSimulation->getSimulationData(
+            {-10, -10}, int2{_settings.generalSettings.worldSizeX + 10, _settings.generalSettings.worldSizeY + 10}, dataTO);
+        DataConverter converter(_settings.simulationParameters);
+        auto snapshot = converter.convertAccessTOtoClusteredDataDescription(dataTO);
+        _dataTOCache->releaseDataTO(dataTO);
+
+        //destroying the facade frees all device memory; the fresh instance reserves a new
+        //emergency pool
+        _cudaSimulation.reset();
+        _cudaSimulation = std::make_shared<_CudaSimulationFacade>(timestep, _settings);
+        if (_registeredImageResource) {
+            _cudaResource = _cudaSimulation->registerImageResource(*_registeredImageResource);
+        }
+        setClusteredSimulationDataIntern(snapshot);
+
+        log(Priority::Important, "gpu recovery succeeded");
+        return true;
+    } catch (std::exception const& e) {
+        log(Priority::Important, std::string("gpu recovery failed: ") + e.what());
+        return false;
+    }
+}
+
 void EngineWorker::runThreadLoop()
 {
     try {
@@ -508,22 +1591,56 @@ void EngineWorker::runThreadLoop()
 
         while (!_isShutdown.load()) {
 
-            if (_accessState == 0) {
-                if (_isSimulationRunning.load()) {
-                    _cudaSimulation->calcTimestep();
-                    if (++_monitorCounter == 3) {  //for performance reasons...
-                        updateMonitorDataIntern(true);
-                        _monitorCounter = 0;
+            try {
+                if (_accessState == 0) {
+                    auto numTimesteps = 0;
+                    if (_isSimulationRunning.load()) {
+                        numTimesteps = scheduleNumTimesteps();
+                        auto startTimepoint = std::chrono::steady_clock::now();
+                        _cudaSimulation->calcTimesteps(numTimesteps);
+                        recordLatency(_timestepLatency, startTimepoint, numTimesteps);
+
+                        //ewma over the per-timestep wall time, used by the governor to size the next batch
+                        auto durationPerTimestep =
+                            toFloat(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint).count())
+                            / numTimesteps;
+                        auto smoothedDuration = _smoothedTimestepDuration.load();
+                        _smoothedTimestepDuration.store(
+                            smoothedDuration == 0 ? durationPerTimestep : smoothedDuration * 0.9f + durationPerTimestep * 0.1f);
+                        checkTimestepWatchdog(durationPerTimestep, numTimesteps);
+                        if (++_monitorCounter == 3) {  //for performance reasons...
+                            updateMonitorDataIntern(true);
+                            _monitorCounter = 0;
+                        }
+                        captureCheckpointIfDue();
+                        captureTimelapseFrameIfDue();
                     }
+                    measureTPS(numTimesteps);
+                    slowdownTPS();
+                    logTelemetryIfDue();
+                    updateInspectionDataIntern();
+                }
+
+                processJobs();
+            } catch (CudaMemoryAllocationException const& e) {
+
+                //the device ran out of memory even after the emergency pool was released; attempt
+                //an in-process recovery before poisoning the engine
+                if (!tryRecoverFromAllocationFailure(e.what())) {
+                    throw;
                 }
-                measureTPS();
-                slowdownTPS();
             }
 
-            processJobs();
+            grantAccessIfRequested();
 
-            if (_accessState == 1) {
-                _accessState = 2;
+            //paused with nothing to do: sleep until new work arrives instead of polling; the
+            //timeout is only a safety net, every work source notifies the worker
+            if (!_isSimulationRunning.load() && 0 == _accessState.load() && !_isShutdown.load()) {
+                std::unique_lock<std::mutex> wakeupLock(_mutexForWorkerWakeup);
+                _workerWakeupCv.wait_for(wakeupLock, WorkerIdleTimeout, [this] {
+                    return _workerWakeup || 0 != _accessState.load() || _isSimulationRunning.load() || _isShutdown.load();
+                });
+                _workerWakeup = false;
             }
         }
     } catch (std::exception const& e) {
@@ -535,6 +1652,22 @@ void EngineWorker::runThreadLoop()
 void EngineWorker::runSimulation()
 {
     _isSimulationRunning.store(true);
+    notifyWorker();
+}
+
+void EngineWorker::setTurboMode(bool value)
+{
+    if (_turboMode.load() == value) {
+        return;
+    }
+    EngineWorkerGuard access(this);
+    _cudaSimulation->setTurboMode(value);
+    _turboMode.store(value);
+}
+
+bool EngineWorker::isTurboMode() const
+{
+    return _turboMode.load();
 }
 
 void EngineWorker::pauseSimulation()
@@ -559,10 +1692,83 @@ void EngineWorker::updateMonitorDataIntern(bool afterMinDuration)
     auto now = std::chrono::steady_clock::now();
     if (!afterMinDuration  || !_lastMonitorUpdate || now - *_lastMonitorUpdate > MonitorUpdate) {
 
+        //in turbo mode the kernels collect no statistics => only entity counts are published;
+        //the event/lineage rings are not drained either and simply overwrite themselves (they
+        //are lossy by design, the drain resumes at the oldest available record afterwards)
+        if (_turboMode.load()) {
+            auto statistics = _cudaSimulation->getQuickMonitorData();
+
+            std::lock_guard guard(_mutexForStatistics);
+            _lastStatistics = statistics;
+            _lastMonitorUpdate = now;
+            return;
+        }
+
+        auto statistics = _cudaSimulation->getMonitorData();
+        auto cellEvents = _cudaSimulation->retrieveCellEvents();
+        auto lineageRecords = _cudaSimulation->retrieveLineageRecords();
+
         std::lock_guard guard(_mutexForStatistics);
-        _lastStatistics = _cudaSimulation->getMonitorData();
+        _lastStatistics = statistics;
         _lastMonitorUpdate = now;
+
+        if (_liveTelemetryEnabled.load()) {
+            publishLiveTelemetry(statistics);
+        }
+
+        _bufferedCellEvents.insert(_bufferedCellEvents.end(), cellEvents.begin(), cellEvents.end());
+        if (toInt(_bufferedCellEvents.size()) > MaxBufferedCellEvents) {
+            _bufferedCellEvents.erase(
+                _bufferedCellEvents.begin(), _bufferedCellEvents.end() - MaxBufferedCellEvents);
+        }
+        _bufferedLineageRecords.insert(_bufferedLineageRecords.end(), lineageRecords.begin(), lineageRecords.end());
+        if (toInt(_bufferedLineageRecords.size()) > MaxBufferedCellEvents) {
+            _bufferedLineageRecords.erase(
+                _bufferedLineageRecords.begin(), _bufferedLineageRecords.end() - MaxBufferedCellEvents);
+        }
+    }
+}
+
+void EngineWorker::updateInspectionDataIntern()
+{
+    std::vector<uint64_t> entityIds;
+    {
+        std::lock_guard guard(_mutexForInspection);
+        if (_inspectedEntityIds.empty()) {
+            return;
+        }
+        auto now = std::chrono::steady_clock::now();
+        if (_lastInspectionUpdate && now - *_lastInspectionUpdate < _inspectionUpdateInterval) {
+            return;
+        }
+
+        //nothing to push while the world is unchanged since the last update
+        if (_lastInspectionUpdate && _lastInspectionTimestep == _cudaSimulation->getCurrentTimestep()
+            && _lastInspectionWorldVersion == _worldVersion.load()) {
+            return;
+        }
+        entityIds = _inspectedEntityIds;
+    }
+
+    auto timestep = _cudaSimulation->getCurrentTimestep();
+    auto worldVersion = _worldVersion.load();
+    auto dataTO = provideTO();
+    auto transferStart = std::chrono::steady_clock::now();
+    _cudaSimulation->getInspectedSimulationData(entityIds, dataTO);
+    recordLatency(_transferLatency, transferStart);
+
+    DataConverter converter(_settings.simulationParameters);
+    auto data = converter.convertAccessTOtoDataDescription(dataTO, DataConverter::SortTokens::Yes);
+    _dataTOCache->releaseDataTO(dataTO);
+
+    std::lock_guard guard(_mutexForInspection);
+    if (_inspectedEntityIds != entityIds) {    //the subscription changed during the extraction
+        return;
     }
+    _pushedInspectionData = std::move(data);
+    _lastInspectionUpdate = std::chrono::steady_clock::now();
+    _lastInspectionTimestep = timestep;
+    _lastInspectionWorldVersion = worldVersion;
 }
 
 void EngineWorker::processJobs()
@@ -584,6 +1790,10 @@ void EngineWorker::processJobs()
         _cudaSimulation->setFlowFieldSettings(*_flowFieldSettings);
         _flowFieldSettings = std::nullopt;
     }
+    if (_updateStatisticsRectsJob) {
+        _cudaSimulation->setStatisticsRects(*_updateStatisticsRectsJob);
+        _updateStatisticsRectsJob = std::nullopt;
+    }
     if (!_applyForceJobs.empty()) {
         for (auto const& applyForceJob : _applyForceJobs) {
             _cudaSimulation->applyForce(
@@ -594,20 +1804,51 @@ void EngineWorker::processJobs()
                  false});
         }
         _applyForceJobs.clear();
+        ++_worldVersion;
+    }
+    if (!_shallowUpdateSelectionJobs.empty()) {
+        for (auto const& updateData : _shallowUpdateSelectionJobs) {
+            _cudaSimulation->shallowUpdateSelectedEntities(updateData);
+        }
+        _shallowUpdateSelectionJobs.clear();
+        ++_worldVersion;
+        updateMonitorDataIntern(true);
+    }
+    if (!_commandJobs.empty()) {
+
+        //the queue is drained outside the lock so that callers can enqueue further commands while
+        //a long extraction or upload runs; a throwing command fails only its own future
+        auto commandJobs = std::move(_commandJobs);
+        _commandJobs.clear();
+        asyncJobsLock.unlock();
+        for (auto const& job : commandJobs) {
+            job();
+        }
     }
 }
 
-void EngineWorker::waitAndAllowAccess(std::chrono::microseconds const& duration)
+void EngineWorker::grantAccessIfRequested()
 {
-    auto startTimepoint = std::chrono::steady_clock::now();
-    while (std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint) < duration) {
-        if (_accessState == 1) {
-            _accessState = 2;
-        }
+    if (_accessState == 1) {
+
+        //the state transition is made under the mutex so that a thread between its predicate
+        //check and its wait in EngineWorkerGuard cannot miss the notification
+        std::lock_guard guard(_mutexForAccessGrant);
+        _accessState = 2;
+        _accessGrantedCv.notify_all();
+    }
+}
+
+void EngineWorker::notifyWorker()
+{
+    {
+        std::lock_guard guard(_mutexForWorkerWakeup);
+        _workerWakeup = true;
     }
+    _workerWakeupCv.notify_one();
 }
 
-void EngineWorker::measureTPS()
+void EngineWorker::measureTPS(int numTimesteps)
 {
     if (_isSimulationRunning.load()) {
         auto timepoint = std::chrono::steady_clock::now();
@@ -625,51 +1866,269 @@ void EngineWorker::measureTPS()
                 _timestepsSinceMeasurement = 0;
             }
         }
-        ++_timestepsSinceMeasurement;
+        _timestepsSinceMeasurement += numTimesteps;
     } else {
         _tps.store(0);
     }
 }
 
-void EngineWorker::slowdownTPS()
+void EngineWorker::noteRenderRequest()
 {
-    if (_slowDownTimepoint) {
-        auto timestepDuration = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - *_slowDownTimepoint);
-        if (_slowDownOvershot) {
-            timestepDuration += *_slowDownOvershot;
-        }
-        auto tpsRestriction = _tpsRestriction.load();
-        if (_isSimulationRunning.load() && tpsRestriction > 0) {
-            auto desiredDuration = std::chrono::microseconds(1000000 / tpsRestriction);
-            if (desiredDuration > timestepDuration) {
-                waitAndAllowAccess(desiredDuration - timestepDuration);
-            } else {
+    auto framesPerSecond = _framesPerSecond.load();
+    if (framesPerSecond > 0) {
+        auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+        _nextRenderDeadline.store(now + 1000000 / framesPerSecond);
+    }
+}
+
+int EngineWorker::scheduleNumTimesteps() const
+{
+    if (_tpsRestriction.load() > 0) {
+        return 1;
+    }
+    auto framesPerSecond = _framesPerSecond.load();
+    auto timestepDuration = _smoothedTimestepDuration.load();
+    if (framesPerSecond == 0 || timestepDuration <= 0) {
+        return TimestepBatchSize;
+    }
+
+    //fit the batch into the time until the next expected frame request so that a render never
+    //waits behind a long batch; with enough headroom the full batch keeps the TPS up
+    auto now = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    auto remainingTime = toFloat(_nextRenderDeadline.load() - now);
+    if (remainingTime <= timestepDuration) {
+        return 1;
+    }
+    return std::min(TimestepBatchSize, toInt(remainingTime / timestepDuration));
+}
+
+std::chrono::milliseconds EngineWorker::calcRenderGateTimeout() const
+{
+    //when governed, a frame that cannot acquire the gate within half a frame interval is skipped
+    //and the last frame is presented instead of stalling the gui
+    auto framesPerSecond = _framesPerSecond.load();
+    if (framesPerSecond > 0) {
+        return std::min(FrameTimeout, std::chrono::milliseconds(std::max(1, 500 / framesPerSecond)));
+    }
+    return FrameTimeout;
+}
+
+void EngineWorker::recordLatency(LatencyHistogram& histogram, std::chrono::steady_clock::time_point const& startTimepoint, int numSamples)
+{
+    auto durationInMs =
+        static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint).count()) / 1000.0;
+
+    std::lock_guard guard(_mutexForTelemetry);
+
+    //a batched duration is attributed evenly to each timestep of the batch
+    for (int i = 0; i < numSamples; ++i) {
+        histogram.addSample(durationInMs / numSamples);
+    }
+}
+
+void EngineWorker::checkTimestepWatchdog(float durationPerTimestepInMicros, int numTimesteps)
+{
+    if (durationPerTimestepInMicros < toFloat(std::chrono::duration_cast<std::chrono::microseconds>(SlowTimestepThreshold).count())) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    if (_lastWatchdogReportTimepoint && now - *_lastWatchdogReportTimepoint < WatchdogCooldown) {
+        return;
+    }
+    _lastWatchdogReportTimepoint = now;
+
+    //runs on the worker thread right after the slow batch, so the bundle reflects the state that
+    //caused the violation; all device queries below are gate-free
+    boost::property_tree::ptree tree;
+    tree.put("timestep", _cudaSimulation->getCurrentTimestep());
+    tree.put("durationPerTimestepInMs", durationPerTimestepInMicros / 1000);
+    tree.put("sloInMs", SlowTimestepThreshold.count());
+    tree.put("batchSize", numTimesteps);
+
+    //entity counts and structural-operation rates of the last monitored timestep
+    auto monitorData = _cudaSimulation->getMonitorData();
+    auto numCells = 0;
+    for (int i = 0; i < 7; ++i) {
+        numCells += monitorData.numCellsByColor[i];
+    }
+    tree.put("entities.cells", numCells);
+    tree.put("entities.connections", monitorData.numConnections);
+    tree.put("entities.particles", monitorData.numParticles);
+    tree.put("entities.tokens", monitorData.numTokens);
+    tree.put("operations.createdCells", monitorData.numCreatedCells);
+    tree.put("operations.deletedCells", monitorData.numDeletedCells);
+    tree.put("operations.createdConnections", monitorData.numCreatedConnections);
+    tree.put("operations.destroyedConnections", monitorData.numDestroyedConnections);
+    tree.put("operations.movedTokens", monitorData.numMovedTokens);
+
+    //array fill levels and the overall memory situation
+    auto memoryInfo = _cudaSimulation->getMemoryInfo();
+    tree.put("memory.acquiredInBytes", memoryInfo.acquiredInBytes);
+    tree.put("memory.freeDeviceMemoryInBytes", memoryInfo.freeDeviceMemoryInBytes);
+    for (auto const& entityArray : memoryInfo.entityArrays) {
+        auto node = "arrays." + entityArray.name;
+        tree.put(node + ".sizeInBytes", entityArray.sizeInBytes);
+        tree.put(node + ".usedInBytes", entityArray.usedInBytes);
+    }
+
+    //per-kernel timings are only available while the profiling surface is enabled
+    if (_cudaSimulation->isKernelProfilingEnabled()) {
+        auto profileData = _cudaSimulation->getKernelProfileData();
+        if (profileData.numTimesteps > 0) {
+            for (auto const& timing : profileData.totalTimings) {
+                tree.put(boost::property_tree::ptree::path_type("kernels/" + timing.kernelName + "/avgInMs", '/'), timing.durationInMs / profileData.numTimesteps);
             }
-            _slowDownOvershot = std::min(std::max(timestepDuration - desiredDuration, std::chrono::microseconds(0)), desiredDuration);
         }
     }
-    _slowDownTimepoint = std::chrono::steady_clock::now();
+
+    std::stringstream stream;
+    boost::property_tree::json_parser::write_json(stream, tree, false);
+    log(Priority::Important, "watchdog: slow timestep detected: " + stream.str());
+    log(Priority::Important, "watchdog: latency telemetry: " + getTelemetryJson());
+}
+
+void EngineWorker::logTelemetryIfDue()
+{
+    {
+        auto now = std::chrono::steady_clock::now();
+        std::lock_guard guard(_mutexForTelemetry);
+        if (_lastTelemetryLog && now - *_lastTelemetryLog < TelemetryLogInterval) {
+            return;
+        }
+        _lastTelemetryLog = now;
+        if (0 == _timestepLatency.getNumSamples() && 0 == _accessWaitLatency.getNumSamples() && 0 == _transferLatency.getNumSamples()) {
+            return;
+        }
+    }
+    log(Priority::Unimportant, "telemetry: " + getTelemetryJson());
+}
+
+std::string EngineWorker::getTelemetryJson() const
+{
+    std::lock_guard guard(_mutexForTelemetry);
+
+    boost::property_tree::ptree tree;
+    auto encodeHistogram = [&tree](std::string const& node, LatencyHistogram const& histogram) {
+        tree.put(node + ".numSamples", histogram.getNumSamples());
+        tree.put(node + ".p50InMs", histogram.getPercentileInMs(0.5));
+        tree.put(node + ".p95InMs", histogram.getPercentileInMs(0.95));
+        tree.put(node + ".p99InMs", histogram.getPercentileInMs(0.99));
+    };
+    encodeHistogram("timestep", _timestepLatency);
+    encodeHistogram("accessWait", _accessWaitLatency);
+    encodeHistogram("transfer", _transferLatency);
+
+    std::stringstream stream;
+    boost::property_tree::json_parser::write_json(stream, tree, false);
+    return stream.str();
+}
+
+void EngineWorker::setLiveTelemetryEnabled(bool enabled)
+{
+    std::lock_guard guard(_mutexForStatistics);
+    if (enabled == _liveTelemetryEnabled.load()) {
+        return;
+    }
+    if (enabled) {
+        if (!_telemetrySegment.create(LiveTelemetryChannelName, sizeof(LiveTelemetrySnapshot))) {
+            log(Priority::Important, "live telemetry: could not create shared-memory segment '" + std::string(LiveTelemetryChannelName) + "'");
+            return;
+        }
+        *static_cast<LiveTelemetrySnapshot*>(_telemetrySegment.data()) = LiveTelemetrySnapshot();
+        log(Priority::Important, "live telemetry: publishing to shared-memory segment '" + std::string(LiveTelemetryChannelName) + "'");
+    } else {
+        _telemetrySegment.close();
+    }
+    _liveTelemetryEnabled.store(enabled);
+}
+
+//called with _mutexForStatistics held; the sequence counter makes torn reads detectable for the
+//out-of-process readers (seqlock), so no cross-process lock is needed and a crashed reader can
+//never stall the engine
+void EngineWorker::publishLiveTelemetry(MonitorData const& statistics)
+{
+    auto& snapshot = *static_cast<LiveTelemetrySnapshot*>(_telemetrySegment.data());
+
+    ++snapshot.sequence;  //odd: write in progress, readers retry
+    std::atomic_thread_fence(std::memory_order_release);
+
+    snapshot.timestep = _cudaSimulation->getCurrentTimestep();
+    snapshot.tps = _tps.load();
+    snapshot.monitor = statistics;
+
+    auto arraySizes = _cudaSimulation->getArraySizes();
+    snapshot.cellArrayCapacity = arraySizes.cellArraySize;
+    snapshot.particleArrayCapacity = arraySizes.particleArraySize;
+    snapshot.tokenArrayCapacity = arraySizes.tokenArraySize;
+
+    {
+        std::lock_guard telemetryGuard(_mutexForTelemetry);
+        snapshot.timestepP50InMs = _timestepLatency.getPercentileInMs(0.5);
+        snapshot.timestepP95InMs = _timestepLatency.getPercentileInMs(0.95);
+        snapshot.timestepP99InMs = _timestepLatency.getPercentileInMs(0.99);
+        snapshot.accessWaitP50InMs = _accessWaitLatency.getPercentileInMs(0.5);
+        snapshot.accessWaitP95InMs = _accessWaitLatency.getPercentileInMs(0.95);
+        snapshot.accessWaitP99InMs = _accessWaitLatency.getPercentileInMs(0.99);
+        snapshot.transferP50InMs = _transferLatency.getPercentileInMs(0.5);
+        snapshot.transferP95InMs = _transferLatency.getPercentileInMs(0.95);
+        snapshot.transferP99InMs = _transferLatency.getPercentileInMs(0.99);
+    }
+
+    snapshot.numKernels = 0;
+    snapshot.numProfiledTimesteps = 0;
+    if (_cudaSimulation->isKernelProfilingEnabled()) {
+        auto profileData = _cudaSimulation->getKernelProfileData();
+        snapshot.numProfiledTimesteps = profileData.numTimesteps;
+        for (auto const& timing : profileData.totalTimings) {
+            if (toInt(snapshot.numKernels) >= LiveTelemetrySnapshot::MaxKernels) {
+                break;
+            }
+            auto& entry = snapshot.kernels[snapshot.numKernels++];
+            memset(entry.name, 0, sizeof(entry.name));
+            timing.kernelName.copy(entry.name, sizeof(entry.name) - 1);
+            entry.totalDurationInMs = timing.durationInMs;
+        }
+    }
+
+    std::atomic_thread_fence(std::memory_order_release);
+    ++snapshot.sequence;  //even again: the snapshot is consistent
+}
+
+void EngineWorker::slowdownTPS()
+{
+    auto tpsRestriction = _tpsRestriction.load();
+    if (_isSimulationRunning.load() && tpsRestriction > 0) {
+
+        //hybrid sleep/spin pacing against a drift-corrected deadline; access requests from other
+        //threads are still served while waiting
+        _tpsPacer.pace(std::chrono::microseconds(1000000 / tpsRestriction), [this] { grantAccessIfRequested(); });
+    } else {
+        _tpsPacer.reset();
+    }
 }
 
 EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::chrono::milliseconds> const& maxDuration)
     : _worker(worker)
 {
     worker->_accessState = 1;
+    worker->notifyWorker();
 
     auto startTimepoint = std::chrono::steady_clock::now();
-    while (worker->_accessState == 1) {
-        auto timePassed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint);
-        if (maxDuration) {
-            if (timePassed > *maxDuration) {
-                break;
-            }
-        } else {
-            if (timePassed > std::chrono::seconds(5)) {
-                _isTimeout = true;
-                throw std::runtime_error("GPU Timeout");
-            }
+    {
+        //sleep until the worker grants access instead of polling _accessState; the grant happens
+        //under the same mutex (see grantAccessIfRequested), so the notification cannot be missed
+        std::unique_lock<std::mutex> lock(worker->_mutexForAccessGrant);
+        auto deadline = startTimepoint + (maxDuration ? std::chrono::microseconds(*maxDuration) : std::chrono::microseconds(std::chrono::seconds(5)));
+        auto granted = worker->_accessGrantedCv.wait_until(lock, deadline, [worker] { return worker->_accessState != 1; });
+        if (!granted && !maxDuration) {
+            _isTimeout = true;
+            throw std::runtime_error("GPU Timeout");
         }
+
+        //on a maxDuration timeout the caller proceeds without access (e.g. the render gate falls
+        //back to the last completed frame), matching the previous polling behavior
     }
+    worker->recordLatency(worker->_accessWaitLatency, startTimepoint);
 
     checkForException(worker->_exceptionData);
 }
@@ -677,6 +2136,10 @@ EngineWorkerGuard::EngineWorkerGuard(EngineWorker* worker, std::optional<std::ch
 EngineWorkerGuard::~EngineWorkerGuard()
 {
     _worker->_accessState = 0;
+
+    //wake the paused worker so that follow-up work (inspection updates, queued jobs) runs
+    //promptly after the access window closes
+    _worker->notifyWorker();
 }
 
 bool EngineWorkerGuard::isTimeout() const
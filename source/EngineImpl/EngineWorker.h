@@ -1,8 +1,11 @@
 #pragma once
 
 #include <atomic>
+#include <deque>
+#include <future>
 #include <mutex>
 #include <condition_variable>
+#include <thread>
 
 #if defined(_WIN32)
 #define NOMINMAX
@@ -11,16 +14,30 @@
 #include <GL/gl.h>
 
 #include "Base/Definitions.h"
+#include "Base/IntervalPacer.h"
+#include "Base/LatencyHistogram.h"
+#include "Base/SharedMemorySegment.h"
 
+#include "EngineInterface/CellBatchData.h"
+#include "EngineInterface/CellEvent.h"
+#include "EngineInterface/DataAccessSchema.h"
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/EditCommands.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/GpuMemoryInfo.h"
 #include "EngineInterface/GpuSettings.h"
+#include "EngineInterface/KernelProfileData.h"
+#include "EngineInterface/KernelTiming.h"
+#include "EngineInterface/LineageRecord.h"
 #include "EngineInterface/MonitorData.h"
 #include "EngineInterface/OverlayDescriptions.h"
 #include "EngineInterface/FlowFieldSettings.h"
 #include "EngineInterface/Settings.h"
 #include "EngineInterface/SelectionShallowData.h"
 #include "EngineInterface/ShallowUpdateSelectionData.h"
+#include "EngineInterface/ReplicationTransform.h"
+#include "EngineInterface/WorldGenerationSpec.h"
 #include "EngineGpuKernels/Definitions.h"
 
 #include "Definitions.h"
@@ -49,40 +66,161 @@ public:
     tryDrawVectorGraphicsAndReturnOverlay(RealVector2D const& rectUpperLeft, RealVector2D const& rectLowerRight, IntVector2D const& imageSize, double zoom);
 
     ClusteredDataDescription getClusteredSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
-    DataDescription getSimulationData(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    DataDescription getSimulationData(
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight,
+        DataAccessSchema const& schema = DataAccessSchema());
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters);
     DataDescription getSelectedSimulationData(bool includeClusters);
     DataDescription getInspectedSimulationData(std::vector<uint64_t> entityIds);
+
+    //batch query for automation clients: the cell attributes in the rect as columnar arrays,
+    //filled straight from the transfer buffers under a single access gate acquisition; no
+    //per-cell description objects are built
+    CellBatchData queryCellBatch(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+
+    //subscription-based inspection channel: the worker thread extracts and converts the data for
+    //the registered entities at the given rate between timestep batches, so inspecting a running
+    //simulation no longer gates the worker per GUI frame; an empty id list unsubscribes
+    void setInspectedEntityIds(std::vector<uint64_t> const& entityIds, std::chrono::milliseconds const& updateInterval);
+    std::optional<DataDescription> fetchInspectionData();
+
     MonitorData getMonitorData() const;
 
+    //returns the birth/death records accumulated since the last call; the records are drained
+    //from the GPU together with the statistics, so the stream advances while the simulation runs
+    //without a dedicated poller
+    std::vector<CellEvent> retrieveCellEvents();
+
+    void setLineageTrackingEnabled(bool enabled);
+    std::vector<LineageRecord> retrieveLineageRecords();  //drained together with the statistics, like the cell events
+
+    //order-independent hash over the world state, computed on the GPU; much cheaper than a full
+    //data download when comparing two checkpoints for equality
+    uint64_t calcWorldHash();
+
+    //snapshot of the GPU allocation situation including a per-array breakdown
+    GpuMemoryInfo getGpuMemoryInfo();
+
     void addAndSelectSimulationData(DataDescription const& dataToUpdate);
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate);
     void setSimulationData(DataDescription const& dataToUpdate);
+
+    //future-based variants: the command is queued and executed by the worker thread between
+    //timestep batches instead of stalling the caller at the access gate; a caller can thereby
+    //overlap extraction, host-side processing and re-upload
+    std::future<DataDescription> getSimulationData_async(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    std::future<void> setSimulationData_async(DataDescription dataToUpdate);
+    std::future<void> calcSingleTimestep_async();
+
+    //raw snapshots dump the transfer arrays directly to disk and bypass the costly description building;
+    //the format is tied to the in-memory layout and therefore not portable between program versions
+    bool saveSimulationDataToFile(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    void saveSimulationDataToFile_async(std::string const& filename, IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight);
+    bool loadSimulationDataFromFile(std::string const& filename);
+
+    //renders the given world section into an offscreen buffer and returns the pixels
+    //(imageSize.x * imageSize.y values in bbbbggggrrrr format, 3 x 16 bit lanes)
+    std::vector<uint64_t> getImageData(RealVector2D const& rectUpperLeft, RealVector2D const& rectLowerRight, IntVector2D const& imageSize, double zoom);
+
+    //renders a low-resolution thumbnail of the whole world from the density map; much cheaper
+    //than getImageData since no cell-level rendering is involved
+    std::vector<uint64_t> getThumbnail(IntVector2D const& imageSize);
+
+    //renders the given world section into an offscreen buffer and writes a png file from a
+    //background thread; the access gate is held only for the render and the copy to host
+    void saveSimulationImageToFile_async(
+        std::string const& filename,
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom);
+
+    //continuous timelapse capture: the worker thread renders a frame of the given world section
+    //whenever the timestep stride is crossed (between timestep batches, so no extra access gate
+    //acquisition) and hands it to a dedicated encoder thread; when the encoder falls behind,
+    //frames are dropped instead of stalling the simulation
+    void startTimelapse(
+        std::string const& filenamePrefix,
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom,
+        int timestepStride);
+    void stopTimelapse();  //joins the encoder thread after the queued frames are written
+
     void removeSelectedEntities(bool includeClusters);
     void relaxSelectedEntities(bool includeClusters);
     void uniformVelocitiesForSelectedEntities(bool includeClusters);
     void makeSticky(bool includeClusters);
     void removeStickiness(bool includeClusters);
     void setBarrier(bool value, bool includeClusters);
+
+    //executes several edit commands back-to-back within one access acquisition and a single
+    //monitor update at the end, so a batch costs one gate round trip instead of one per command
+    void executeEditBatch(std::vector<EditCommand> const& commands);
     void changeCell(CellDescription const& changedCell);
     void changeParticle(ParticleDescription const& changedParticle);
 
     void calcSingleTimestep();
 
+    //executes several timesteps back-to-back with a single synchronization at the end
+    void calcTimesteps(int numTimesteps);
+
+    //advances one timestep with every kernel timed individually via cuda events; far slower
+    //than calcSingleTimestep, only used by the benchmarks target
+    std::vector<KernelTiming> benchmarkTimestep();
+
+    //sweeps launch geometries (blocks / threads per block) against the live world and adopts the
+    //fastest one; blocks the caller for the whole sweep and advances the simulation meanwhile
+    GpuSettings autoTuneGpuSettings();
+
+    //opt-in profiling: while enabled, the worker thread calculates timesteps with the per-kernel
+    //timed launch path (considerably slower); the accumulated times can be read at any time
+    void setKernelProfilingEnabled(bool enabled);
+    bool isKernelProfilingEnabled() const;
+    KernelProfileData getKernelProfileData() const;
+
+    //latency telemetry for capacity planning: p50/p95/p99 of the per-timestep wall time, the
+    //access gate wait time and the TO transfer time; a summary is also logged periodically
+    //while the simulation runs
+    std::string getTelemetryJson() const;
+
+    //publishes the statistics, the latency percentiles and the entity array fill levels into the
+    //shared-memory segment LiveTelemetryChannelName at the monitor cadence, so external
+    //exporters can scrape them without log parsing (see LiveTelemetrySnapshot for the layout and
+    //the seqlock read protocol)
+    void setLiveTelemetryEnabled(bool enabled);
+
     void beginShutdown(); //caller should wait for termination of thread
     void endShutdown();
 
     int getTpsRestriction() const;
     void setTpsRestriction(int value);
 
+    //rolling in-memory checkpoint ring: while enabled the worker copies the entity arrays to
+    //pinned host memory every <timesteps> steps; rewinding re-uploads the stored transfer
+    //objects directly, without serialization or disk access. 0 disables and clears the ring
+    void setCheckpointInterval(int timesteps);
+    std::vector<uint64_t> getCheckpointTimesteps() const;
+    std::optional<uint64_t> rewindToLastCheckpoint();  //returns the restored timestep
+
+    //display refresh rate for the timestep/render governor: the worker sizes its timestep
+    //batches to finish before the next expected frame request and a render request gives up
+    //after half a frame interval (presenting the last frame) instead of stalling the gui
+    //behind a long batch. 0 disables the governor
+    void setFramesPerSecond(int value);
+
     float getTps() const;
     uint64_t getCurrentTimestep() const;
+    uint64_t getWorldVersion() const;
     void setCurrentTimestep(uint64_t value);
 
     void setSimulationParameters_async(SimulationParameters const& parameters);
     void setSimulationParametersSpots_async(SimulationParametersSpots const& spots);
     void setGpuSettings_async(GpuSettings const& gpuSettings);
     void setFlowFieldSettings_async(FlowFieldSettings const& flowFieldSettings);
+    void setStatisticsRects_async(std::vector<RealRect> const& rects);
 
     void applyForce_async(RealVector2D const& start, RealVector2D const& end, RealVector2D const& force, float radius);
 
@@ -93,8 +231,30 @@ public:
     void removeSelection();
     void updateSelection();
     void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& updateData);
+    void shallowUpdateSelectedEntities_async(ShallowUpdateSelectionData const& updateData);
     void colorSelectedEntities(unsigned char color, bool includeClusters);
+    void scaleEnergyForSelectedEntities(float factor, bool includeClusters);
+    void setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters);
+    void colorizeClusters(std::vector<int> const& colorCodes);
+    void applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta);  //batch mutation: one guarded kernel pass for the whole id list
     void reconnectSelectedEntities();
+    //duplicates the current selection on the GPU; much faster than extracting and re-adding the
+    //data for large patterns
+    void cloneSelectedEntities(RealVector2D const& posDelta, bool includeClusters);
+
+    //stamps one transformed copy of the current selection per transform on the GPU; used by the
+    //multiplier instead of duplicating and re-uploading the pattern per copy
+    void replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, RealVector2D const& center);
+    void drawBarrier(std::vector<RealVector2D> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode);
+    void convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, RealVector2D const& center);
+    void generateWorld(WorldGenerationSpec const& spec);
+    void setFreezeZone(std::optional<RealRect> const& zone);
+
+    //fast-forward mode: the GPU runs the instrumentation-free timestep kernel variants and the
+    //periodic monitoring is reduced to entity counts (no statistics kernels, no event/lineage
+    //drain); intended for skipping ahead quickly, not for observing the world
+    void setTurboMode(bool value);
+    bool isTurboMode() const;
 
     void runThreadLoop();
     void runSimulation();
@@ -102,29 +262,78 @@ public:
     bool isSimulationRunning() const;
 
 private:
-    DataAccessTO provideTO(); 
+    //guard-free bodies, shared between the synchronous api and the command queue (whose jobs
+    //already run on the worker thread and must not wait for access)
+    DataDescription getSimulationDataIntern(
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight,
+        DataAccessSchema const& schema = DataAccessSchema());
+    DataAccessTO transferSimulationDataTO(
+        IntVector2D const& rectUpperLeft,
+        IntVector2D const& rectLowerRight,
+        DataAccessSchema const& schema = DataAccessSchema());
+    void setSimulationDataIntern(DataDescription const& dataToUpdate);
+    void setClusteredSimulationDataIntern(ClusteredDataDescription const& dataToUpdate);
+
+    //snapshots the world to the host, rebuilds the device context and restores the snapshot;
+    //runs on the worker thread after a device memory allocation failed
+    bool tryRecoverFromAllocationFailure(std::string const& reason);
+
+    DataAccessTO provideTO();
+    bool writeSnapshotFile(std::string const& filename, DataAccessTO const& dataTO);
+    void joinSnapshotWriterThread();
+    void joinImageWriterThread();
     void updateMonitorDataIntern(bool afterMinDuration = false);
+    void publishLiveTelemetry(MonitorData const& statistics);
+    void updateInspectionDataIntern();
     void processJobs();
 
-    void waitAndAllowAccess(std::chrono::microseconds const& duration);
-    void measureTPS();
+    void measureTPS(int numTimesteps);
+    void captureCheckpointIfDue();
+    void captureTimelapseFrameIfDue();
+    void timelapseEncoderLoop();
+    void clearCheckpoints();
+    void checkTimestepWatchdog(float durationPerTimestepInMicros, int numTimesteps);
+    void noteRenderRequest();
+    int scheduleNumTimesteps() const;
+    std::chrono::milliseconds calcRenderGateTimeout() const;
     void slowdownTPS();
 
+    void recordLatency(LatencyHistogram& histogram, std::chrono::steady_clock::time_point const& startTimepoint, int numSamples = 1);
+    void logTelemetryIfDue();
+
+    //event-driven worker synchronization: grantAccessIfRequested hands the device over to a
+    //waiting thread and wakes it, notifyWorker wakes the worker from its idle sleep after new
+    //work was enqueued
+    void grantAccessIfRequested();
+    void notifyWorker();
+
     CudaSimulationFacade _cudaSimulation;
 
     //sync
     std::atomic<int> _accessState{0};    //0 = worker thread has access, 1 = require access from other thread, 2 = access granted to other thread
     std::atomic<bool> _isSimulationRunning{false};
+    std::atomic<bool> _turboMode{false};
     std::atomic<bool> _isShutdown{false};
     ExceptionData _exceptionData;
 
+    //wakeup channels: access-waiting threads sleep on _accessGrantedCv instead of polling
+    //_accessState, and the worker sleeps on _workerWakeupCv while paused with nothing to do
+    std::mutex _mutexForAccessGrant;
+    std::condition_variable _accessGrantedCv;
+    std::mutex _mutexForWorkerWakeup;
+    std::condition_variable _workerWakeupCv;
+    bool _workerWakeup = false;
+
     //async jobs
     mutable std::mutex _mutexForAsyncJobs;
     std::optional<SimulationParameters> _updateSimulationParametersJob;
     std::optional<SimulationParametersSpots> _updateSimulationParametersSpotsJob;
     std::optional<GpuSettings> _updateGpuSettingsJob;
     std::optional<FlowFieldSettings> _flowFieldSettings;
+    std::optional<std::vector<RealRect>> _updateStatisticsRectsJob;
     std::optional<GLuint> _imageResourceToRegister;
+    std::optional<GLuint> _registeredImageResource;  //kept for re-registration after a device context rebuild
 
     struct ApplyForceJob
     {
@@ -135,13 +344,41 @@ private:
     };
     std::vector<ApplyForceJob> _applyForceJobs;
 
+    //queued drag updates for the selection; successive deltas of the same kind are summed on
+    //enqueue, so a burst of mouse-move events collapses into a single GPU update
+    std::vector<ShallowUpdateSelectionData> _shallowUpdateSelectionJobs;
+
+    //generic command queue for the future-based api; drained in order on the worker thread,
+    //exceptions are captured in the corresponding future
+    std::deque<std::function<void()>> _commandJobs;
+
     //time step measurements
     std::atomic<int> _tpsRestriction{0};  //0 = no restriction
     std::atomic<float> _tps;
     int _timestepsSinceMeasurement = 0;
     std::optional<std::chrono::steady_clock::time_point> _measureTimepoint;
-    std::optional<std::chrono::steady_clock::time_point> _slowDownTimepoint;
-    std::optional<std::chrono::microseconds> _slowDownOvershot;
+    IntervalPacer _tpsPacer;
+
+    //checkpoint ring (guarded by _mutexForCheckpoints; the worker thread captures, the GUI
+    //thread rewinds and queries); the TOs are leased from _dataTOCache, so the ring reuses the
+    //pinned transfer buffers
+    struct Checkpoint
+    {
+        uint64_t timestep;
+        std::shared_ptr<DataAccessTO> dataTO;  //shared_ptr since DataAccessTO is only forward-declared here
+    };
+    std::atomic<int> _checkpointInterval{0};  //0 = checkpoints disabled
+    std::atomic<uint64_t> _nextCheckpointTimestep{0};
+    mutable std::mutex _mutexForCheckpoints;
+    std::deque<Checkpoint> _checkpoints;
+
+    //slow-timestep watchdog (only touched by the worker thread)
+    std::optional<std::chrono::steady_clock::time_point> _lastWatchdogReportTimepoint;
+
+    //timestep/render governor
+    std::atomic<int> _framesPerSecond{0};  //0 = governor disabled
+    std::atomic<int64_t> _nextRenderDeadline{0};  //microseconds since the steady clock epoch
+    std::atomic<float> _smoothedTimestepDuration{0};  //ewma over the per-timestep wall time in microseconds
   
     //settings
     Settings _settings;
@@ -152,6 +389,85 @@ private:
     MonitorData _lastStatistics;
     int _monitorCounter = 0;
 
+    //birth/death records waiting to be fetched; bounded so that a client which never fetches
+    //does not grow the buffer indefinitely (the oldest records are dropped then, matching the
+    //overwrite semantics of the device ring buffer)
+    static int constexpr MaxBufferedCellEvents = 1 << 20;
+    std::vector<CellEvent> _bufferedCellEvents;
+    std::vector<LineageRecord> _bufferedLineageRecords;  //same bound and drop semantics as the cell events
+
+    //extraction cache: the editor windows poll getClusteredSimulationData repeatedly; the GPU round
+    //trip and conversion are skipped as long as the world has not changed since the last identical request
+    struct ExtractionCache
+    {
+        uint64_t timestep = 0;
+        uint64_t worldVersion = 0;
+        IntVector2D rectUpperLeft;
+        IntVector2D rectLowerRight;
+        ClusteredDataDescription data;
+    };
+    mutable std::mutex _mutexForExtractionCache;
+    std::optional<ExtractionCache> _extractionCache;
+    std::atomic<uint64_t> _worldVersion{0};
+
+    //inspection subscription (guarded by _mutexForInspection; the worker thread pushes, the GUI
+    //thread subscribes and fetches)
+    mutable std::mutex _mutexForInspection;
+    std::vector<uint64_t> _inspectedEntityIds;
+    std::chrono::milliseconds _inspectionUpdateInterval{100};
+    std::optional<std::chrono::steady_clock::time_point> _lastInspectionUpdate;
+    uint64_t _lastInspectionTimestep = 0;
+    uint64_t _lastInspectionWorldVersion = 0;
+    std::optional<DataDescription> _pushedInspectionData;
+
+    //latency telemetry (guarded by _mutexForTelemetry; timestep and transfer samples arrive from
+    //the worker thread, access wait samples from the calling threads)
+    mutable std::mutex _mutexForTelemetry;
+    LatencyHistogram _timestepLatency;
+    LatencyHistogram _accessWaitLatency;
+    LatencyHistogram _transferLatency;
+    std::optional<std::chrono::steady_clock::time_point> _lastTelemetryLog;
+
+    //live telemetry export (segment lifetime guarded by _mutexForStatistics, the flag is the
+    //lock-free fast path for the monitor update)
+    std::atomic<bool> _liveTelemetryEnabled{false};
+    SharedMemorySegment _telemetrySegment;
+
+    //background snapshot writer: owns its transfer buffers until joined
+    std::thread _snapshotWriterThread;
+
+    //background image writer: owns its pixel buffer until joined
+    std::thread _imageWriterThread;
+
+    //timelapse capture (guarded by _mutexForTimelapse; the worker thread renders and enqueues,
+    //the encoder thread dequeues and writes the png files)
+    struct TimelapseSettings
+    {
+        std::string filenamePrefix;
+        RealVector2D rectUpperLeft;
+        RealVector2D rectLowerRight;
+        IntVector2D imageSize;
+        double zoom;
+        int timestepStride;
+    };
+    struct TimelapseFrame
+    {
+        std::string filename;
+        IntVector2D imageSize;
+        std::shared_ptr<std::vector<uint64_t>> imageData;
+    };
+    static int constexpr MaxQueuedTimelapseFrames = 4;  //beyond that frames are dropped, not queued
+    std::atomic<bool> _timelapseActive{false};  //lock-free fast path for the worker loop
+    mutable std::mutex _mutexForTimelapse;
+    std::condition_variable _timelapseConditionVariable;
+    std::optional<TimelapseSettings> _timelapse;
+    uint64_t _nextTimelapseTimestep = 0;
+    int _timelapseFrameCounter = 0;
+    int _numDroppedTimelapseFrames = 0;
+    std::deque<TimelapseFrame> _timelapseFrameQueue;
+    bool _timelapseEncoderShutdown = false;
+    std::thread _timelapseEncoderThread;
+
     //internals
     void* _cudaResource;
     AccessDataTOCache _dataTOCache;
@@ -62,6 +62,12 @@ DataDescription _SimulationControllerImpl::getSimulationData()
     return _worker.getSimulationData({-10, -10}, {size.x + 10, size.y + 10});
 }
 
+DataDescription _SimulationControllerImpl::getSimulationData(DataAccessSchema const& schema)
+{
+    auto size = getWorldSize();
+    return _worker.getSimulationData({-10, -10}, {size.x + 10, size.y + 10}, schema);
+}
+
 ClusteredDataDescription _SimulationControllerImpl::getSelectedClusteredSimulationData(bool includeClusters)
 {
     return _worker.getSelectedClusteredSimulationData(includeClusters);
@@ -77,6 +83,21 @@ DataDescription _SimulationControllerImpl::getInspectedSimulationData(std::vecto
     return _worker.getInspectedSimulationData(entityIds);
 }
 
+CellBatchData _SimulationControllerImpl::queryCellBatch(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight)
+{
+    return _worker.queryCellBatch(rectUpperLeft, rectLowerRight);
+}
+
+void _SimulationControllerImpl::setInspectedEntityIds(std::vector<uint64_t> const& entityIds, std::chrono::milliseconds const& updateInterval)
+{
+    _worker.setInspectedEntityIds(entityIds, updateInterval);
+}
+
+std::optional<DataDescription> _SimulationControllerImpl::fetchInspectionData()
+{
+    return _worker.fetchInspectionData();
+}
+
 void _SimulationControllerImpl::addAndSelectSimulationData(DataDescription const& dataToAdd)
 {
     _worker.addAndSelectSimulationData(dataToAdd);
@@ -94,6 +115,83 @@ void _SimulationControllerImpl::setSimulationData(DataDescription const& dataToU
     _selectionNeedsUpdate = true;
 }
 
+std::future<DataDescription> _SimulationControllerImpl::getSimulationData_async()
+{
+    auto size = getWorldSize();
+    return _worker.getSimulationData_async({-10, -10}, {size.x + 10, size.y + 10});
+}
+
+std::future<void> _SimulationControllerImpl::setSimulationData_async(DataDescription dataToUpdate)
+{
+    _selectionNeedsUpdate = true;
+    return _worker.setSimulationData_async(std::move(dataToUpdate));
+}
+
+std::future<void> _SimulationControllerImpl::calcSingleTimestep_async()
+{
+    _selectionNeedsUpdate = true;
+    return _worker.calcSingleTimestep_async();
+}
+
+bool _SimulationControllerImpl::saveSimulationDataToFile(std::string const& filename)
+{
+    auto size = getWorldSize();
+    return _worker.saveSimulationDataToFile(filename, {-10, -10}, {size.x + 10, size.y + 10});
+}
+
+void _SimulationControllerImpl::saveSimulationDataToFile_async(std::string const& filename)
+{
+    auto size = getWorldSize();
+    _worker.saveSimulationDataToFile_async(filename, {-10, -10}, {size.x + 10, size.y + 10});
+}
+
+std::vector<uint64_t> _SimulationControllerImpl::getImageData(
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    return _worker.getImageData(rectUpperLeft, rectLowerRight, imageSize, zoom);
+}
+
+std::vector<uint64_t> _SimulationControllerImpl::getThumbnail(IntVector2D const& imageSize)
+{
+    return _worker.getThumbnail(imageSize);
+}
+
+void _SimulationControllerImpl::saveSimulationImageToFile_async(
+    std::string const& filename,
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom)
+{
+    _worker.saveSimulationImageToFile_async(filename, rectUpperLeft, rectLowerRight, imageSize, zoom);
+}
+
+void _SimulationControllerImpl::startTimelapse(
+    std::string const& filenamePrefix,
+    RealVector2D const& rectUpperLeft,
+    RealVector2D const& rectLowerRight,
+    IntVector2D const& imageSize,
+    double zoom,
+    int timestepStride)
+{
+    _worker.startTimelapse(filenamePrefix, rectUpperLeft, rectLowerRight, imageSize, zoom, timestepStride);
+}
+
+void _SimulationControllerImpl::stopTimelapse()
+{
+    _worker.stopTimelapse();
+}
+
+bool _SimulationControllerImpl::loadSimulationDataFromFile(std::string const& filename)
+{
+    auto result = _worker.loadSimulationDataFromFile(filename);
+    _selectionNeedsUpdate = true;
+    return result;
+}
+
 void _SimulationControllerImpl::removeSelectedEntities(bool includeClusters)
 {
     _worker.removeSelectedEntities(includeClusters);
@@ -130,11 +228,66 @@ void _SimulationControllerImpl::colorSelectedEntities(unsigned char color, bool
     _worker.colorSelectedEntities(color, includeClusters);
 }
 
+void _SimulationControllerImpl::scaleEnergyForSelectedEntities(float factor, bool includeClusters)
+{
+    _worker.scaleEnergyForSelectedEntities(factor, includeClusters);
+}
+
+void _SimulationControllerImpl::setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters)
+{
+    _worker.setBranchNumberForSelectedEntities(branchNumber, includeClusters);
+}
+
+void _SimulationControllerImpl::colorizeClusters(std::vector<int> const& colorCodes)
+{
+    _worker.colorizeClusters(colorCodes);
+}
+
+void _SimulationControllerImpl::applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta)
+{
+    _worker.applyEnergyDeltaToCells(cellIds, energyDelta);
+}
+
 void _SimulationControllerImpl::reconnectSelectedEntities()
 {
     _worker.reconnectSelectedEntities();
 }
 
+void _SimulationControllerImpl::executeEditBatch(std::vector<EditCommand> const& commands)
+{
+    _worker.executeEditBatch(commands);
+}
+
+void _SimulationControllerImpl::cloneSelectedEntities(RealVector2D const& posDelta, bool includeClusters)
+{
+    _worker.cloneSelectedEntities(posDelta, includeClusters);
+}
+
+void _SimulationControllerImpl::replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, RealVector2D const& center)
+{
+    _worker.replicateSelectedEntities(transforms, center);
+}
+
+void _SimulationControllerImpl::drawBarrier(std::vector<RealVector2D> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode)
+{
+    _worker.drawBarrier(stroke, paintFirstVertex, cellDistance, energy, colorCode);
+}
+
+void _SimulationControllerImpl::convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, RealVector2D const& center)
+{
+    _worker.convertImageToPattern(imageData, width, height, numChannels, center);
+}
+
+void _SimulationControllerImpl::generateWorld(WorldGenerationSpec const& spec)
+{
+    _worker.generateWorld(spec);
+}
+
+void _SimulationControllerImpl::setFreezeZone(std::optional<RealRect> const& zone)
+{
+    _worker.setFreezeZone(zone);
+}
+
 void _SimulationControllerImpl::changeCell(CellDescription const& changedCell)
 {
     _worker.changeCell(changedCell);
@@ -151,6 +304,34 @@ void _SimulationControllerImpl::calcSingleTimestep()
     _selectionNeedsUpdate = true;
 }
 
+void _SimulationControllerImpl::calcTimesteps(int numTimesteps)
+{
+    _worker.calcTimesteps(numTimesteps);
+    _selectionNeedsUpdate = true;
+}
+
+std::vector<KernelTiming> _SimulationControllerImpl::benchmarkTimestep()
+{
+    auto timings = _worker.benchmarkTimestep();
+    _selectionNeedsUpdate = true;
+    return timings;
+}
+
+void _SimulationControllerImpl::setKernelProfilingEnabled(bool enabled)
+{
+    _worker.setKernelProfilingEnabled(enabled);
+}
+
+bool _SimulationControllerImpl::isKernelProfilingEnabled() const
+{
+    return _worker.isKernelProfilingEnabled();
+}
+
+KernelProfileData _SimulationControllerImpl::getKernelProfileData() const
+{
+    return _worker.getKernelProfileData();
+}
+
 void _SimulationControllerImpl::runSimulation()
 {
     _worker.runSimulation();
@@ -181,6 +362,11 @@ uint64_t _SimulationControllerImpl::getCurrentTimestep() const
     return _worker.getCurrentTimestep();
 }
 
+uint64_t _SimulationControllerImpl::getWorldVersion() const
+{
+    return _worker.getWorldVersion();
+}
+
 void _SimulationControllerImpl::setCurrentTimestep(uint64_t value)
 {
     _worker.setCurrentTimestep(value);
@@ -240,6 +426,13 @@ void _SimulationControllerImpl::setGpuSettings_async(GpuSettings const& gpuSetti
     _worker.setGpuSettings_async(gpuSettings);
 }
 
+GpuSettings _SimulationControllerImpl::autoTuneGpuSettings()
+{
+    auto result = _worker.autoTuneGpuSettings();
+    _settings.gpuSettings = result;
+    return result;
+}
+
 FlowFieldSettings _SimulationControllerImpl::getFlowFieldSettings() const
 {
     return _settings.flowFieldSettings;
@@ -290,6 +483,11 @@ void _SimulationControllerImpl::shallowUpdateSelectedEntities(ShallowUpdateSelec
     _worker.shallowUpdateSelectedEntities(updateData);
 }
 
+void _SimulationControllerImpl::shallowUpdateSelectedEntities_async(ShallowUpdateSelectionData const& updateData)
+{
+    _worker.shallowUpdateSelectedEntities_async(updateData);
+}
+
 void _SimulationControllerImpl::setSelection(RealVector2D const& startPos, RealVector2D const& endPos)
 {
     _worker.setSelection(startPos, endPos);
@@ -345,6 +543,56 @@ MonitorData _SimulationControllerImpl::getStatistics() const
     return _worker.getMonitorData();
 }
 
+void _SimulationControllerImpl::setTurboMode(bool value)
+{
+    _worker.setTurboMode(value);
+}
+
+bool _SimulationControllerImpl::isTurboMode() const
+{
+    return _worker.isTurboMode();
+}
+
+void _SimulationControllerImpl::setStatisticsRects(std::vector<RealRect> const& rects)
+{
+    _worker.setStatisticsRects_async(rects);
+}
+
+std::vector<CellEvent> _SimulationControllerImpl::retrieveCellEvents()
+{
+    return _worker.retrieveCellEvents();
+}
+
+void _SimulationControllerImpl::setLineageTrackingEnabled(bool enabled)
+{
+    _worker.setLineageTrackingEnabled(enabled);
+}
+
+std::vector<LineageRecord> _SimulationControllerImpl::retrieveLineageRecords()
+{
+    return _worker.retrieveLineageRecords();
+}
+
+uint64_t _SimulationControllerImpl::calcWorldHash()
+{
+    return _worker.calcWorldHash();
+}
+
+GpuMemoryInfo _SimulationControllerImpl::getGpuMemoryInfo()
+{
+    return _worker.getGpuMemoryInfo();
+}
+
+std::string _SimulationControllerImpl::getTelemetryJson() const
+{
+    return _worker.getTelemetryJson();
+}
+
+void _SimulationControllerImpl::setLiveTelemetryEnabled(bool enabled)
+{
+    _worker.setLiveTelemetryEnabled(enabled);
+}
+
 std::optional<int> _SimulationControllerImpl::getTpsRestriction() const
 {
     auto result = _worker.getTpsRestriction();
@@ -356,6 +604,26 @@ void _SimulationControllerImpl::setTpsRestriction(std::optional<int> const& valu
     _worker.setTpsRestriction(value ? *value : 0);
 }
 
+void _SimulationControllerImpl::setFramesPerSecond(int value)
+{
+    _worker.setFramesPerSecond(value);
+}
+
+void _SimulationControllerImpl::setCheckpointInterval(int timesteps)
+{
+    _worker.setCheckpointInterval(timesteps);
+}
+
+std::vector<uint64_t> _SimulationControllerImpl::getCheckpointTimesteps() const
+{
+    return _worker.getCheckpointTimesteps();
+}
+
+std::optional<uint64_t> _SimulationControllerImpl::rewindToLastCheckpoint()
+{
+    return _worker.rewindToLastCheckpoint();
+}
+
 float _SimulationControllerImpl::getTps() const
 {
     return _worker.getTps();
@@ -42,13 +42,45 @@ public:
 
     ClusteredDataDescription getClusteredSimulationData() override;
     DataDescription getSimulationData() override;
+    DataDescription getSimulationData(DataAccessSchema const& schema) override;
     ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) override;
     DataDescription getSelectedSimulationData(bool includeClusters) override;
     DataDescription getInspectedSimulationData(std::vector<uint64_t> entityIds) override;
+    CellBatchData queryCellBatch(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight) override;
+
+    void setInspectedEntityIds(std::vector<uint64_t> const& entityIds, std::chrono::milliseconds const& updateInterval) override;
+    std::optional<DataDescription> fetchInspectionData() override;
 
     void addAndSelectSimulationData(DataDescription const& dataToAdd) override;
     void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) override;
     void setSimulationData(DataDescription const& dataToUpdate) override;
+
+    std::future<DataDescription> getSimulationData_async() override;
+    std::future<void> setSimulationData_async(DataDescription dataToUpdate) override;
+    std::future<void> calcSingleTimestep_async() override;
+
+    bool saveSimulationDataToFile(std::string const& filename) override;
+    void saveSimulationDataToFile_async(std::string const& filename) override;
+    bool loadSimulationDataFromFile(std::string const& filename) override;
+    std::vector<uint64_t>
+    getImageData(RealVector2D const& rectUpperLeft, RealVector2D const& rectLowerRight, IntVector2D const& imageSize, double zoom) override;
+    std::vector<uint64_t> getThumbnail(IntVector2D const& imageSize) override;
+    void saveSimulationImageToFile_async(
+        std::string const& filename,
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom) override;
+
+    void startTimelapse(
+        std::string const& filenamePrefix,
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom,
+        int timestepStride) override;
+    void stopTimelapse() override;
+
     void removeSelectedEntities(bool includeClusters) override;
     void relaxSelectedEntities(bool includeClusters) override;
     void uniformVelocitiesForSelectedEntities(bool includeClusters) override;
@@ -56,11 +88,27 @@ public:
     void removeStickiness(bool includeClusters) override;
     void setBarrier(bool value, bool includeClusters) override;
     void colorSelectedEntities(unsigned char color, bool includeClusters) override;
+    void scaleEnergyForSelectedEntities(float factor, bool includeClusters) override;
+    void setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters) override;
+    void colorizeClusters(std::vector<int> const& colorCodes) override;
+    void applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta) override;
     void reconnectSelectedEntities() override;
+    void executeEditBatch(std::vector<EditCommand> const& commands) override;
+    void cloneSelectedEntities(RealVector2D const& posDelta, bool includeClusters) override;
+    void replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, RealVector2D const& center) override;
+    void drawBarrier(std::vector<RealVector2D> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode) override;
+    void convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, RealVector2D const& center) override;
+    void generateWorld(WorldGenerationSpec const& spec) override;
+    void setFreezeZone(std::optional<RealRect> const& zone) override;
     void changeCell(CellDescription const& changedCell) override;
     void changeParticle(ParticleDescription const& changedParticle) override;
 
     void calcSingleTimestep() override;
+    void calcTimesteps(int numTimesteps) override;
+    std::vector<KernelTiming> benchmarkTimestep() override;
+    void setKernelProfilingEnabled(bool enabled) override;
+    bool isKernelProfilingEnabled() const override;
+    KernelProfileData getKernelProfileData() const override;
     void runSimulation() override;
     void pauseSimulation() override;
 
@@ -69,6 +117,7 @@ public:
     void closeSimulation() override;
 
     uint64_t getCurrentTimestep() const override;
+    uint64_t getWorldVersion() const override;
     void setCurrentTimestep(uint64_t value) override;
 
     SimulationParameters const& getSimulationParameters() const override;
@@ -83,6 +132,7 @@ public:
     GpuSettings getGpuSettings() const override;
     GpuSettings getOriginalGpuSettings() const override;
     void setGpuSettings_async(GpuSettings const& gpuSettings) override;
+    GpuSettings autoTuneGpuSettings() override;
 
     FlowFieldSettings getFlowFieldSettings() const override;
     FlowFieldSettings getOriginalFlowFieldSettings() const override;
@@ -94,6 +144,7 @@ public:
 
     void switchSelection(RealVector2D const& pos, float radius) override;
     void swapSelection(RealVector2D const& pos, float radius) override;
+    void shallowUpdateSelectedEntities_async(ShallowUpdateSelectionData const& updateData) override;
     SelectionShallowData getSelectionShallowData() override;
     void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& updateData) override;
     void setSelection(RealVector2D const& startPos, RealVector2D const& endPos) override;
@@ -107,9 +158,25 @@ public:
     SymbolMap const& getOriginalSymbolMap() const override;
     void setSymbolMap(SymbolMap const& symbolMap) override;
     MonitorData getStatistics() const override;
+    void setStatisticsRects(std::vector<RealRect> const& rects) override;
+
+    void setTurboMode(bool value) override;
+    bool isTurboMode() const override;
+    std::vector<CellEvent> retrieveCellEvents() override;
+    void setLineageTrackingEnabled(bool enabled) override;
+    std::vector<LineageRecord> retrieveLineageRecords() override;
+    uint64_t calcWorldHash() override;
+    GpuMemoryInfo getGpuMemoryInfo() override;
+    std::string getTelemetryJson() const override;
+    void setLiveTelemetryEnabled(bool enabled) override;
 
     std::optional<int> getTpsRestriction() const override;
     void setTpsRestriction(std::optional<int> const& value) override;
+    void setFramesPerSecond(int value) override;
+
+    void setCheckpointInterval(int timesteps) override;
+    std::vector<uint64_t> getCheckpointTimesteps() const override;
+    std::optional<uint64_t> rewindToLastCheckpoint() override;
 
     float getTps() const override;
 
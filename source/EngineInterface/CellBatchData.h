@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+//columnar result of SimulationController::queryCellBatch: one array per attribute instead of one
+//object per cell, so the data can be handed to numerical tooling or script bindings without
+//per-cell conversion
+struct CellBatchData
+{
+    std::vector<uint64_t> ids;
+    std::vector<float> posX;
+    std::vector<float> posY;
+    std::vector<float> velX;
+    std::vector<float> velY;
+    std::vector<float> energies;
+    std::vector<int> colors;
+    std::vector<int> numConnections;
+};
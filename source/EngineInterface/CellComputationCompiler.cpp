@@ -1,29 +1,20 @@
 #include "CellComputationCompiler.h"
 
 #include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 #include <boost/algorithm/string/case_conv.hpp>
 
+#include "Descriptions.h"
 #include "SymbolMap.h"
 #include "SimulationParameters.h"
 #include "Definitions.h"
 
 namespace
 {
-    enum class CompilerState
-    {
-        LOOKING_FOR_INSTR_START,
-        LOOKING_FOR_INSTR_END,
-        LOOKING_FOR_OP1_START,
-        LOOKING_FOR_OP1_END,
-        LOOKING_FOR_SEPARATOR,
-        LOOKING_FOR_COMPARATOR,
-        LOOKING_FOR_OP2_START,
-        LOOKING_FOR_OP2_END
-    };
-
     struct InstructionUncoded
     {
-        bool readingFinished = false;
         std::string name;
         std::string operand1;
         std::string operand2;
@@ -48,108 +39,96 @@ namespace
 
     bool isNameChar(char const& c) { return std::isalnum(c) || (c == ':'); }
 
-    bool gotoNextStateAndReturnSuccess(
-        CompilerState& state,
-        char& currentSymbol,
-        InstructionUncoded& instruction,
-        int bytePos,
-        int codeSize)
+    bool isOperandStartChar(char const& c)
     {
-        boost::algorithm::to_lower(instruction.name);
+        return isNameChar(c) || (c == '-') || (c == '_') || (c == '[') || (c == '(');
+    }
 
-        switch (state) {
-        case CompilerState::LOOKING_FOR_INSTR_START: {
-            if (std::isalpha(currentSymbol)) {
-                state = CompilerState::LOOKING_FOR_INSTR_END;
-                instruction.name = currentSymbol;
-            }
-        } break;
-        case CompilerState::LOOKING_FOR_INSTR_END: {
-            if (!std::isalpha(currentSymbol)) {
-                if (instruction.name == "else" || instruction.name == "endif")
-                    instruction.readingFinished = true;
-                else
-                    state = CompilerState::LOOKING_FOR_OP1_START;
-            } else {
-                instruction.name += currentSymbol;
-                if ((bytePos + 1) == codeSize
-                    && ((instruction.name == "else") || (instruction.name == "endif")))
-                    instruction.readingFinished = true;
-            }
-        } break;
-        case CompilerState::LOOKING_FOR_OP1_START: {
-            if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[')
-                || (currentSymbol == '(')) {
-                state = CompilerState::LOOKING_FOR_OP1_END;
-                instruction.operand1 = currentSymbol;
-            }
-        } break;
-        case CompilerState::LOOKING_FOR_OP1_END: {
-            if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!')) {
-                state = CompilerState::LOOKING_FOR_COMPARATOR;
-                instruction.comp = currentSymbol;
-            } else if (currentSymbol == ',')
-                state = CompilerState::LOOKING_FOR_OP2_START;
-            else if (
-                !isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[')
-                && (currentSymbol != ']') && (currentSymbol != '(') && (currentSymbol != ')'))
-                state = CompilerState::LOOKING_FOR_SEPARATOR;
-            else
-                instruction.operand1 += currentSymbol;
-        } break;
-        case CompilerState::LOOKING_FOR_SEPARATOR: {
-            if (currentSymbol == ',')
-                state = CompilerState::LOOKING_FOR_OP2_START;
-            else if (
-                (currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!')) {
-                state = CompilerState::LOOKING_FOR_COMPARATOR;
-                instruction.comp = currentSymbol;
-            } else if (
-                isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[')
-                || (currentSymbol == ']') || (currentSymbol == '(') || (currentSymbol == ')'))
-                return false;
-        } break;
-        case CompilerState::LOOKING_FOR_COMPARATOR: {
-            if ((currentSymbol == '<') || (currentSymbol == '>') || (currentSymbol == '=') || (currentSymbol == '!'))
-                instruction.comp += currentSymbol;
-            else if (
-                !isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[')
-                && (currentSymbol != '('))
-                state = CompilerState::LOOKING_FOR_OP2_START;
-            else {
-                state = CompilerState::LOOKING_FOR_OP2_END;
-                instruction.operand2 = currentSymbol;
+    bool isOperandChar(char const& c) { return isOperandStartChar(c) || (c == ']') || (c == ')'); }
+
+    bool isComparatorChar(char const& c)
+    {
+        return (c == '<') || (c == '>') || (c == '=') || (c == '!');
+    }
+
+    //tokenizer working on the whole buffer: each instruction is scanned in one pass; a newline
+    //always terminates the current instruction, several instructions may share a line
+    bool parseSourceCodeAndReturnSuccess(std::string const& code, std::vector<InstructionUncoded>& instructions)
+    {
+        size_t pos = 0;
+        auto const size = code.size();
+        while (pos < size) {
+
+            //instruction name
+            while (pos < size && !std::isalpha(code[pos])) {
+                ++pos;
             }
-        } break;
-        case CompilerState::LOOKING_FOR_OP2_START: {
-            if (isNameChar(currentSymbol) || (currentSymbol == '-') || (currentSymbol == '_') || (currentSymbol == '[')
-                || (currentSymbol == '(')) {
-                state = CompilerState::LOOKING_FOR_OP2_END;
-                instruction.operand2 = currentSymbol;
-                if (bytePos == (codeSize - 1))
-                    instruction.readingFinished = true;
+            if (pos >= size) {
+                break;
             }
-        } break;
-        case CompilerState::LOOKING_FOR_OP2_END: {
-            if (!isNameChar(currentSymbol) && (currentSymbol != '-') && (currentSymbol != '_') && (currentSymbol != '[')
-                && (currentSymbol != ']') && (currentSymbol != '(') && (currentSymbol != ')'))
-                instruction.readingFinished = true;
-            else {
-                instruction.operand2 += currentSymbol;
-                if ((bytePos + 1) == codeSize)
-                    instruction.readingFinished = true;
+            InstructionUncoded instruction;
+            while (pos < size && std::isalpha(code[pos])) {
+                instruction.name += code[pos++];
             }
-        } break;
-        }
-        if ((currentSymbol == '\n') || ((bytePos + 1) == codeSize)) {
-            if (!instruction.name.empty()) {
-                instruction.readingFinished = true;
+            boost::algorithm::to_lower(instruction.name);
+
+            if (instruction.name != "else" && instruction.name != "endif") {
+
+                //operand 1
+                while (pos < size && code[pos] != '\n' && !isOperandStartChar(code[pos])) {
+                    ++pos;
+                }
+                while (pos < size && isOperandChar(code[pos])) {
+                    instruction.operand1 += code[pos++];
+                }
+
+                //separator or comparator
+                while (pos < size && code[pos] != '\n' && code[pos] != ',' && !isComparatorChar(code[pos])) {
+                    if (isOperandChar(code[pos])) {
+                        return false;  //a second operand requires a separator
+                    }
+                    ++pos;
+                }
+                if (pos < size && code[pos] == ',') {
+                    ++pos;
+                } else {
+                    while (pos < size && isComparatorChar(code[pos])) {
+                        instruction.comp += code[pos++];
+                    }
+                }
+
+                //operand 2
+                while (pos < size && code[pos] != '\n' && !isOperandStartChar(code[pos])) {
+                    ++pos;
+                }
+                while (pos < size && isOperandChar(code[pos])) {
+                    instruction.operand2 += code[pos++];
+                }
             }
+            instructions.emplace_back(instruction);
         }
         return true;
     }
 
-    std::string applyTableToCode(SymbolMap const& symbols, std::string s)
+    using SymbolLookup = std::unordered_map<std::string, std::string>;
+
+    //the symbol map is an ordered map for the editor and the serializer, but compilation resolves
+    //two operands per instruction against it; the lookups therefore run against an unordered view
+    //whose keys are hashed once on construction, rebuilt only when the symbols change (the
+    //inspector recompiles on every refresh with the same symbol map)
+    SymbolLookup const& getSymbolLookup(SymbolMap const& symbols)
+    {
+        static thread_local SymbolMap cachedSymbols;
+        static thread_local SymbolLookup lookup;
+        if (lookup.empty() ? !symbols.empty() : cachedSymbols != symbols) {
+            lookup.clear();
+            lookup.insert(symbols.begin(), symbols.end());
+            cachedSymbols = symbols;
+        }
+        return lookup;
+    }
+
+    std::string applyTableToCode(SymbolLookup const& symbols, std::string s)
     {
         std::string prefix;
         std::string postfix;
@@ -175,7 +154,7 @@ namespace
     }
 
     bool resolveInstructionAndReturnSuccess(
-        SymbolMap const& symbols,
+        SymbolLookup const& symbols,
         CellInstruction& instructionCoded,
         InstructionUncoded instructionUncoded)
     {
@@ -298,42 +277,251 @@ namespace
         }
         return true;
     }
+
+    bool isArithmeticInstruction(CellInstruction const& instruction)
+    {
+        return instruction.operation >= Enums::ComputationOperation_Mov
+            && instruction.operation <= Enums::ComputationOperation_And;
+    }
+
+    bool hasDirectTarget(CellInstruction const& instruction)
+    {
+        return instruction.opType1 == Enums::ComputationOpType_Mem
+            || instruction.opType1 == Enums::ComputationOpType_Cmem;
+    }
+
+    //the memory cell an instruction writes to, normalized so that aliased addresses compare equal;
+    //token and cell memory are distinct address spaces
+    std::pair<int, int> getTargetKey(CellInstruction const& instruction, SimulationParameters const& parameters)
+    {
+        auto space = instruction.opType1 == Enums::ComputationOpType_Cmem ? 1 : 0;
+        auto size = instruction.opType1 == Enums::ComputationOpType_Cmem
+            ? parameters.cellFunctionComputerCellMemorySize
+            : parameters.tokenMemorySize;
+        return {space, static_cast<int>(instruction.operand1 % size)};
+    }
+
+    //indirect addressing can touch any token memory cell and conditionals execute their enclosed
+    //stores only sometimes => both end a straight-line segment for the optimization below
+    bool isOptimizationBarrier(CellInstruction const& instruction)
+    {
+        return !isArithmeticInstruction(instruction) || instruction.opType1 == Enums::ComputationOpType_MemMem
+            || instruction.opType2 == Enums::ComputationOpType_MemMem;
+    }
+
+    bool readsTargetKey(CellInstruction const& instruction, std::pair<int, int> const& key, SimulationParameters const& parameters)
+    {
+        //all arithmetic instructions except mov read their target before writing it
+        if (isArithmeticInstruction(instruction) && instruction.operation != Enums::ComputationOperation_Mov
+            && hasDirectTarget(instruction) && getTargetKey(instruction, parameters) == key) {
+            return true;
+        }
+        if (instruction.opType2 == Enums::ComputationOpType_Mem) {
+            return key == std::make_pair(0, static_cast<int>(instruction.operand2 % parameters.tokenMemorySize));
+        }
+        if (instruction.opType2 == Enums::ComputationOpType_Cmem) {
+            return key == std::make_pair(1, static_cast<int>(instruction.operand2 % parameters.cellFunctionComputerCellMemorySize));
+        }
+        return false;
+    }
+
+    //applies an operation with constant operand to a known value, matching the int8 wraparound
+    //semantics of the device-side interpreter in CellComputationProcessor.cuh
+    uint8_t foldConstant(Enums::ComputationOperation operation, uint8_t value, uint8_t operand)
+    {
+        switch (operation) {
+        case Enums::ComputationOperation_Mov:
+            return operand;
+        case Enums::ComputationOperation_Add:
+            return static_cast<uint8_t>(value + operand);
+        case Enums::ComputationOperation_Sub:
+            return static_cast<uint8_t>(value - operand);
+        case Enums::ComputationOperation_Mul:
+            return static_cast<uint8_t>(value * operand);
+        case Enums::ComputationOperation_Div:
+            return operand != 0 ? static_cast<uint8_t>(static_cast<int8_t>(value) / operand) : 0;
+        case Enums::ComputationOperation_Xor:
+            return value ^ operand;
+        case Enums::ComputationOperation_Or:
+            return value | operand;
+        case Enums::ComputationOperation_And:
+            return value & operand;
+        default:
+            return value;
+        }
+    }
+
+    //an instruction which provably leaves its target unchanged
+    bool hasNoEffect(CellInstruction const& instruction)
+    {
+        if (instruction.opType2 != Enums::ComputationOpType_Constant) {
+            return false;
+        }
+        switch (instruction.operation) {
+        case Enums::ComputationOperation_Add:
+        case Enums::ComputationOperation_Sub:
+        case Enums::ComputationOperation_Xor:
+        case Enums::ComputationOperation_Or:
+            return instruction.operand2 == 0;
+        case Enums::ComputationOperation_Mul:
+        case Enums::ComputationOperation_Div:
+            return instruction.operand2 == 1;
+        case Enums::ComputationOperation_And:
+            return instruction.operand2 == 0xff;
+        default:
+            return false;
+        }
+    }
+
+    //can two adjacent instructions with the same operation and constant operands be merged into one?
+    bool canCombineConstants(Enums::ComputationOperation operation, uint8_t operand1, uint8_t operand2, uint8_t& combined)
+    {
+        switch (operation) {
+        case Enums::ComputationOperation_Add:
+            combined = static_cast<uint8_t>(operand1 + operand2);  //x + c1 + c2 = x + (c1 + c2) mod 256
+            return true;
+        case Enums::ComputationOperation_Sub:
+            combined = static_cast<uint8_t>(operand1 + operand2);
+            return true;
+        case Enums::ComputationOperation_Mul:
+            combined = static_cast<uint8_t>(operand1 * operand2);
+            return true;
+        case Enums::ComputationOperation_Xor:
+            combined = operand1 ^ operand2;
+            return true;
+        case Enums::ComputationOperation_Or:
+            combined = operand1 | operand2;
+            return true;
+        case Enums::ComputationOperation_And:
+            combined = operand1 & operand2;
+            return true;
+        default:
+            return false;  //division is not associative under truncation
+        }
+    }
+
+    //compile-time optimization: the device-side interpreter decodes every instruction on every
+    //token visit, so each removed instruction directly reduces the per-token execution time;
+    //only transformations which provably preserve the final memory state are applied, since the
+    //complete token and cell memory is observable simulation state
+    void optimizeInstructions(std::vector<CellInstruction>& instructions, SimulationParameters const& parameters)
+    {
+        auto changed = true;
+        while (changed) {
+            changed = false;
+
+            //drop instructions without effect
+            for (auto it = instructions.begin(); it != instructions.end();) {
+                if (hasNoEffect(*it)) {
+                    it = instructions.erase(it);
+                    changed = true;
+                } else {
+                    ++it;
+                }
+            }
+
+            //constant folding of adjacent instructions on the same target
+            for (size_t i = 0; i + 1 < instructions.size(); ++i) {
+                auto& first = instructions[i];
+                auto const& second = instructions[i + 1];
+                if (!isArithmeticInstruction(first) || !isArithmeticInstruction(second) || !hasDirectTarget(first)
+                    || first.opType1 != second.opType1 || first.opType2 != Enums::ComputationOpType_Constant
+                    || second.opType2 != Enums::ComputationOpType_Constant
+                    || getTargetKey(first, parameters) != getTargetKey(second, parameters)) {
+                    continue;
+                }
+                if (first.operation == Enums::ComputationOperation_Mov) {
+                    //mov followed by an operation with constant operand => mov of the folded value
+                    first.operand2 = foldConstant(second.operation, first.operand2, second.operand2);
+                    instructions.erase(instructions.begin() + i + 1);
+                    changed = true;
+                    --i;
+                } else if (first.operation == second.operation) {
+                    uint8_t combined;
+                    if (canCombineConstants(first.operation, first.operand2, second.operand2, combined)) {
+                        first.operand2 = combined;
+                        instructions.erase(instructions.begin() + i + 1);
+                        changed = true;
+                        --i;
+                    }
+                }
+            }
+
+            //dead store elimination: a store which is overwritten before it can be read has no
+            //effect on the final memory state
+            for (size_t i = 0; i < instructions.size() && !changed; ++i) {
+                auto const& store = instructions[i];
+                if (!isArithmeticInstruction(store) || !hasDirectTarget(store)) {
+                    continue;
+                }
+                auto key = getTargetKey(store, parameters);
+                for (size_t j = i + 1; j < instructions.size(); ++j) {
+                    auto const& other = instructions[j];
+                    if (isOptimizationBarrier(other) || readsTargetKey(other, key, parameters)) {
+                        break;
+                    }
+                    if (other.operation == Enums::ComputationOperation_Mov && hasDirectTarget(other)
+                        && getTargetKey(other, parameters) == key) {
+                        instructions.erase(instructions.begin() + i);
+                        changed = true;
+                        break;
+                    }
+                }
+            }
+        }
+    }
 }
 
 
 CompilationResult CellComputationCompiler::compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters)
 {
-    CompilerState state = CompilerState::LOOKING_FOR_INSTR_START;
-
     CompilationResult result;
-    int linePos = 0;
-    InstructionUncoded instructionUncoded;
-    CellInstruction instructionCoded;
-    for (int bytePos = 0; bytePos < code.length(); ++bytePos) {
-        auto currentSymbol = code[bytePos];
+    std::vector<InstructionUncoded> instructionsUncoded;
+    if (!parseSourceCodeAndReturnSuccess(code, instructionsUncoded)) {
+        result.compilationOk = false;
+        result.lineOfFirstError = static_cast<int>(instructionsUncoded.size());
+        return result;
+    }
 
-        if (!gotoNextStateAndReturnSuccess(state, currentSymbol, instructionUncoded, bytePos, code.length())) {
+    auto const& symbolLookup = getSymbolLookup(symbols);
+    std::vector<CellInstruction> instructions;
+    instructions.reserve(instructionsUncoded.size());
+    for (size_t i = 0; i < instructionsUncoded.size(); ++i) {
+        CellInstruction instructionCoded;
+        if (!resolveInstructionAndReturnSuccess(symbolLookup, instructionCoded, instructionsUncoded[i])) {
             result.compilationOk = false;
-            result.lineOfFirstError = linePos;
+            result.lineOfFirstError = static_cast<int>(i) + 1;
             return result;
         }
-        if (instructionUncoded.readingFinished) {
-            linePos++;
-            if (!resolveInstructionAndReturnSuccess(symbols, instructionCoded, instructionUncoded)) {
-                result.compilationOk = false;
-                result.lineOfFirstError = linePos;
-                return result;
-            }
-            writeInstruction(result.compilation, instructionCoded);
-            state = CompilerState::LOOKING_FOR_INSTR_START;
-            instructionUncoded = InstructionUncoded();
-        }
+        instructions.emplace_back(instructionCoded);
     }
-    if (state == CompilerState::LOOKING_FOR_INSTR_START && result.compilation.size() <= getMaxBytes(parameters)) {
+
+    optimizeInstructions(instructions, parameters);
+    for (auto const& instruction : instructions) {
+        writeInstruction(result.compilation, instruction);
+    }
+    if (result.compilation.size() <= getMaxBytes(parameters)) {
         result.compilationOk = true;
     } else {
         result.compilationOk = false;
-        result.lineOfFirstError = linePos;
+        result.lineOfFirstError = static_cast<int>(instructionsUncoded.size());
+    }
+    return result;
+}
+
+CompilationResult CellComputationCompiler::compileSourceCode(
+    std::string const& code,
+    SymbolMap const& symbols,
+    SimulationParameters const& parameters,
+    std::vector<CellDescription*> const& cells)
+{
+    //bulk creation flows stamp one shared program into thousands of cells: the source is parsed,
+    //optimized and encoded exactly once
+    auto result = compileSourceCode(code, symbols, parameters);
+    if (result.compilationOk) {
+        for (auto const& cell : cells) {
+            cell->cellFeature.constData = result.compilation;
+        }
     }
     return result;
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <vector>
+
 #include "EngineInterface/CellInstruction.h"
 
 #include "Definitions.h"
@@ -21,6 +23,14 @@ class CellComputationCompiler
 {
 public:
     static CompilationResult compileSourceCode(std::string const& code, SymbolMap const& symbols, SimulationParameters const& parameters);
+
+    //compiles the source once and stamps the bytecode into all given cells; intended for bulk
+    //creation flows where thousands of cells share one program
+    static CompilationResult compileSourceCode(
+        std::string const& code,
+        SymbolMap const& symbols,
+        SimulationParameters const& parameters,
+        std::vector<CellDescription*> const& cells);
     static std::string
     decompileSourceCode(std::string const& data, SymbolMap const& symbols, SimulationParameters const& parameters);
 
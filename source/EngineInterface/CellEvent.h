@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstdint>
+
+//compact birth/death record streamed from the engine (see SimulationController::retrieveCellEvents);
+//filled on the GPU, hence trivially copyable and without owning members
+struct CellEvent
+{
+    enum Type
+    {
+        Type_CellBirth,
+        Type_CellDeath,
+    };
+
+    int type = Type_CellBirth;
+    int color = 0;
+    uint64_t id = 0;
+    uint64_t timestep = 0;
+    float posX = 0;
+    float posY = 0;
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+//selects which parts of the entity data an extraction serializes. Consumers that never read the
+//cell metadata strings (e.g. periodic monitoring snapshots) can skip them, which shrinks the
+//string blob transfer and the description conversion; skipping the token memories additionally
+//saves the per-token copies, the memory content then arrives as empty strings
+struct DataAccessSchema
+{
+    bool includeMetadata = true;
+    bool includeTokenMemories = true;
+};
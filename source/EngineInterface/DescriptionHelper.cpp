@@ -9,6 +9,7 @@
 DataDescription DescriptionHelper::createRect(CreateRectParameters const& parameters)
 {
     DataDescription result;
+    result.cells.reserve(parameters._width * parameters._height);
     for (int i = 0; i < parameters._width; ++i) {
         for (int j = 0; j < parameters._height; ++j) {
             result.addCell(CellDescription()
@@ -31,6 +32,9 @@ DataDescription DescriptionHelper::createRect(CreateRectParameters const& parame
 void DescriptionHelper::duplicate(ClusteredDataDescription& data, IntVector2D const& origSize, IntVector2D const& size)
 {
     ClusteredDataDescription result;
+    auto numTiles = ((size.x + origSize.x - 1) / origSize.x) * ((size.y + origSize.y - 1) / origSize.y);
+    result.clusters.reserve(data.clusters.size() * numTiles);
+    result.particles.reserve(data.particles.size() * numTiles);
 
     for (int incX = 0; incX < size.x; incX += origSize.x) {
         for (int incY = 0; incY < size.y; incY += origSize.y) {
@@ -45,7 +49,7 @@ void DescriptionHelper::duplicate(ClusteredDataDescription& data, IntVector2D co
                         }
                     }
                     makeValid(cluster);
-                    result.addCluster(cluster);
+                    result.addCluster(std::move(cluster));
                 }
             }
             for (auto particle : data.particles) {
@@ -58,7 +62,7 @@ void DescriptionHelper::duplicate(ClusteredDataDescription& data, IntVector2D co
             }
         }
     }
-    data = result;
+    data = std::move(result);
 }
 
 namespace
@@ -109,14 +113,15 @@ DataDescription DescriptionHelper::gridMultiply(DataDescription const& input, Gr
                 }
                 return cloneWithoutMetadata;
             }();
-            templateData.shift({i * parameters._horizontalDistance, j * parameters._verticalDistance});
-            templateData.rotate(i * parameters._horizontalAngleInc + j * parameters._verticalAngleInc);
-            templateData.accelerate(
+            //single fused pass instead of shift + rotate + accelerate traversing the copy three times
+            templateData.transform(
+                {i * parameters._horizontalDistance, j * parameters._verticalDistance},
+                i * parameters._horizontalAngleInc + j * parameters._verticalAngleInc,
                 {i * parameters._horizontalVelXinc + j * parameters._verticalVelXinc, i * parameters._horizontalVelYinc + j * parameters._verticalVelYinc},
                 i * parameters._horizontalAngularVelInc + j * parameters._verticalAngularVelInc);
 
             makeValid(templateData);
-            result.add(templateData);
+            result.add(std::move(templateData));
         }
     }
 
@@ -155,9 +160,9 @@ DataDescription DescriptionHelper::randomMultiply(
         do {
             copy = input;
             removeMetadata(copy);
-            copy.shift({toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))});
-            copy.rotate(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle)));
-            copy.accelerate(
+            copy.transform(
+                {toFloat(numberGen.getRandomReal(0, toInt(worldSize.x))), toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)))},
+                toFloat(toInt(numberGen.getRandomReal(parameters._minAngle, parameters._maxAngle))),
                 {toFloat(numberGen.getRandomReal(parameters._minVelX, parameters._maxVelX)),
                  toFloat(numberGen.getRandomReal(parameters._minVelY, parameters._maxVelY))},
                 toFloat(numberGen.getRandomReal(parameters._minAngularVel, parameters._maxAngularVel)));
@@ -179,7 +184,6 @@ DataDescription DescriptionHelper::randomMultiply(
         }
 
         makeValid(copy);
-        result.add(copy);
 
         //add copy to existentData for overlapping check
         if (parameters._overlappingCheck) {
@@ -190,11 +194,43 @@ DataDescription DescriptionHelper::randomMultiply(
                 cellIndicesByPos[intPos].emplace_back(index);
             }
         }
+
+        result.add(std::move(copy));
     }
 
     return result;
 }
 
+void DescriptionHelper::setCenter(DataDescription& data, RealVector2D const& center, IntVector2D const& worldSize)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    std::vector<RealVector2D> positions;
+    positions.reserve(data.cells.size() + data.particles.size());
+    for (auto const& cell : data.cells) {
+        positions.emplace_back(cell.pos);
+    }
+    for (auto const& particle : data.particles) {
+        positions.emplace_back(particle.pos);
+    }
+    data.shift(center - spaceCalculator.calcCenter(positions));
+}
+
+void DescriptionHelper::setCenter(ClusteredDataDescription& data, RealVector2D const& center, IntVector2D const& worldSize)
+{
+    SpaceCalculator spaceCalculator(worldSize);
+    std::vector<RealVector2D> positions;
+    positions.reserve(data.getNumberOfCellAndParticles());
+    for (auto const& cluster : data.clusters) {
+        for (auto const& cell : cluster.cells) {
+            positions.emplace_back(cell.pos);
+        }
+    }
+    for (auto const& particle : data.particles) {
+        positions.emplace_back(particle.pos);
+    }
+    data.shift(center - spaceCalculator.calcCenter(positions));
+}
+
 void DescriptionHelper::reconnectCells(DataDescription& data, float maxDistance)
 {
     std::unordered_map<int, std::unordered_map<int, std::vector<int>>> cellIndicesBySlot;
@@ -59,6 +59,12 @@ public:
         DataDescription&& existentData,
         bool& overlappingCheckSuccessful);
 
+    //wrap-aware replacement for the setCenter on the descriptions: the center of a span which
+    //straddles the torus seam is determined via the bulk operations of SpaceCalculator, so
+    //pasting such a pattern does not scatter it across the world
+    static void setCenter(DataDescription& data, RealVector2D const& center, IntVector2D const& worldSize);
+    static void setCenter(ClusteredDataDescription& data, RealVector2D const& center, IntVector2D const& worldSize);
+
     static void reconnectCells(DataDescription& data, float maxdistance);
     static void removeStickiness(DataDescription& data);
     static void correctConnections(ClusteredDataDescription& data, IntVector2D const& worldSize);
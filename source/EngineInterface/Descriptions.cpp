@@ -103,6 +103,17 @@ DataDescription& DataDescription::add(DataDescription const& other)
     return *this;
 }
 
+DataDescription& DataDescription::add(DataDescription&& other)
+{
+    if (cells.empty() && particles.empty()) {
+        *this = std::move(other);
+        return *this;
+    }
+    cells.insert(cells.end(), std::make_move_iterator(other.cells.begin()), std::make_move_iterator(other.cells.end()));
+    particles.insert(particles.end(), std::make_move_iterator(other.particles.begin()), std::make_move_iterator(other.particles.end()));
+    return *this;
+}
+
 DataDescription& DataDescription::addCells(std::vector<CellDescription> const& value)
 {
     cells.insert(cells.end(), value.begin(), value.end());
@@ -111,7 +122,13 @@ DataDescription& DataDescription::addCells(std::vector<CellDescription> const& v
 
 DataDescription& DataDescription::addCell(CellDescription const& value)
 {
-    addCells({value});
+    cells.emplace_back(value);
+    return *this;
+}
+
+DataDescription& DataDescription::addCell(CellDescription&& value)
+{
+    cells.emplace_back(std::move(value));
     return *this;
 }
 
@@ -123,7 +140,7 @@ DataDescription& DataDescription::addParticles(std::vector<ParticleDescription>
 
 DataDescription& DataDescription::addParticle(ParticleDescription const& value)
 {
-    addParticles({value});
+    particles.emplace_back(value);
     return *this;
 }
 
@@ -209,6 +226,27 @@ void DataDescription::accelerate(RealVector2D const& velDelta, float angularVelD
     }
 }
 
+void DataDescription::transform(RealVector2D const& shiftDelta, float angle, RealVector2D const& velDelta, float angularVelDelta)
+{
+    auto rotationMatrix = Math::calcRotationMatrix(angle);
+
+    //the center is invariant under the rotation about it, so the center after the shift serves
+    //for both the rotation and the tangential velocity
+    auto center = calcCenter() + shiftDelta;
+
+    auto transform = [&](RealVector2D& pos, RealVector2D& vel) {
+        auto relPos = rotationMatrix * (pos + shiftDelta - center);
+        pos = center + relPos;
+        vel += Physics::tangentialVelocity(relPos, velDelta, angularVelDelta);
+    };
+    for (auto& cell : cells) {
+        transform(cell.pos, cell.vel);
+    }
+    for (auto& particle : particles) {
+        transform(particle.pos, particle.vel);
+    }
+}
+
 std::unordered_set<uint64_t> DataDescription::getCellIds() const
 {
     std::unordered_set<uint64_t> result;
@@ -184,7 +184,12 @@ struct ClusterDescription
     }
     ClusterDescription& addCell(CellDescription const& value)
     {
-        addCells({value});
+        cells.emplace_back(value);
+        return *this;
+    }
+    ClusterDescription& addCell(CellDescription&& value)
+    {
+        cells.emplace_back(std::move(value));
         return *this;
     }
 
@@ -241,7 +246,12 @@ struct ClusteredDataDescription
     }
     ClusteredDataDescription& addCluster(ClusterDescription const& value)
     {
-        addClusters({value});
+        clusters.emplace_back(value);
+        return *this;
+    }
+    ClusteredDataDescription& addCluster(ClusterDescription&& value)
+    {
+        clusters.emplace_back(std::move(value));
         return *this;
     }
 
@@ -252,7 +262,7 @@ struct ClusteredDataDescription
     }
     ClusteredDataDescription& addParticle(ParticleDescription const& value)
     {
-        addParticles({value});
+        particles.emplace_back(value);
         return *this;
     }
     void clear()
@@ -287,8 +297,10 @@ struct DataDescription
     explicit DataDescription(ClusteredDataDescription const& clusteredData);
 
     DataDescription& add(DataDescription const& other);
+    DataDescription& add(DataDescription&& other);    //appends by moving the elements of other
     DataDescription& addCells(std::vector<CellDescription> const& value);
     DataDescription& addCell(CellDescription const& value);
+    DataDescription& addCell(CellDescription&& value);
 
     DataDescription& addParticles(std::vector<ParticleDescription> const& value);
     DataDescription& addParticle(ParticleDescription const& value);
@@ -301,6 +313,11 @@ struct DataDescription
     void rotate(float angle);
     void accelerate(RealVector2D const& velDelta, float angularVelDelta);
 
+    //fused shift + rotate + accelerate in a single pass over the entities; equivalent to calling
+    //the three operations in that order, but avoids the repeated traversals and center
+    //computations on large descriptions
+    void transform(RealVector2D const& shiftDelta, float angle, RealVector2D const& velDelta, float angularVelDelta);
+
     std::unordered_set<uint64_t> getCellIds() const;
 
     DataDescription& addConnection(uint64_t const& cellId1, uint64_t const& cellId2, std::unordered_map<uint64_t, int>& cache);
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <variant>
+#include <vector>
+
+//edit commands for _SimulationController::executeEditBatch: the worker runs a whole batch
+//back-to-back within a single access acquisition instead of paying the fixed gate and
+//synchronization overhead once per command
+namespace EditCommands
+{
+    struct RemoveSelectedEntities
+    {
+        bool includeClusters = false;
+    };
+    struct RelaxSelectedEntities
+    {
+        bool includeClusters = false;
+    };
+    struct UniformVelocitiesForSelectedEntities
+    {
+        bool includeClusters = false;
+    };
+    struct MakeSticky
+    {
+        bool includeClusters = false;
+    };
+    struct RemoveStickiness
+    {
+        bool includeClusters = false;
+    };
+    struct SetBarrier
+    {
+        bool value = false;
+        bool includeClusters = false;
+    };
+    struct ColorSelectedEntities
+    {
+        unsigned char color = 0;
+        bool includeClusters = false;
+    };
+    struct ReconnectSelectedEntities
+    {
+    };
+}
+
+using EditCommand = std::variant<
+    EditCommands::RemoveSelectedEntities,
+    EditCommands::RelaxSelectedEntities,
+    EditCommands::UniformVelocitiesForSelectedEntities,
+    EditCommands::MakeSticky,
+    EditCommands::RemoveStickiness,
+    EditCommands::SetBarrier,
+    EditCommands::ColorSelectedEntities,
+    EditCommands::ReconnectSelectedEntities>;
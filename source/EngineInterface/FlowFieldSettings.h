@@ -31,7 +31,8 @@ struct FlowFieldSettings
 
     bool operator==(FlowFieldSettings const& other) const
     {
-        return active == other.active && numCenters == other.numCenters && centers == other.centers;
+        return active == other.active && numCenters == other.numCenters && centers[0] == other.centers[0]
+            && centers[1] == other.centers[1];
     }
     bool operator!=(FlowFieldSettings const& other) const { return !operator==(other); }
 };
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+struct GpuArrayMemoryInfo
+{
+    std::string name;
+    uint64_t sizeInBytes = 0;
+    uint64_t usedInBytes = 0;
+};
+
+//snapshot of the GPU memory situation, used to judge whether the next entity array resize
+//will exceed the device memory
+struct GpuMemoryInfo
+{
+    uint64_t acquiredInBytes = 0;        //currently allocated by the engine
+    uint64_t peakAcquiredInBytes = 0;    //maximum since simulation creation (resizes allocate transiently on top)
+    uint64_t freeDeviceMemoryInBytes = 0;
+    uint64_t totalDeviceMemoryInBytes = 0;
+
+    //additional bytes the next entity array resize would allocate while the old arrays are still
+    //alive; a rough lower bound, derived from the current fill levels
+    uint64_t nextResizeForecastInBytes = 0;
+
+    std::vector<GpuArrayMemoryInfo> entityArrays;
+};
@@ -4,10 +4,20 @@ struct GpuSettings
 {
     int numThreadsPerBlock = 32;
     int numBlocks = 2048;
+    bool fusedPhysics = false;
+
+    //experimental: jit-compile the dominant cell programs with NVRTC and execute them natively
+    //instead of interpreting them (see GenomeJitCompiler)
+    bool jitCellComputation = false;
+
+    //reproducible runs: random number streams are seeded and scheduled structural operations are
+    //processed in a canonical order; considerably slower and only effective from the start of a simulation
+    bool deterministicMode = false;
 
     bool operator==(GpuSettings const& other) const
     {
-        return numThreadsPerBlock == other.numThreadsPerBlock && numBlocks == other.numBlocks;
+        return numThreadsPerBlock == other.numThreadsPerBlock && numBlocks == other.numBlocks && fusedPhysics == other.fusedPhysics
+            && jitCellComputation == other.jitCellComputation && deterministicMode == other.deterministicMode;
     }
 
     bool operator!=(GpuSettings const& other) const { return !operator==(other); }
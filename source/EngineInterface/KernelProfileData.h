@@ -0,0 +1,13 @@
+#pragma once
+
+#include <cstdint>
+
+#include "KernelTiming.h"
+
+//accumulated result of the opt-in kernel profiling mode (see
+//_SimulationController::setKernelProfilingEnabled)
+struct KernelProfileData
+{
+    std::vector<KernelTiming> totalTimings;  //summed over numTimesteps, launch order preserved
+    uint64_t numTimesteps = 0;
+};
@@ -0,0 +1,12 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+//wall clock time of a single kernel launch, measured with CUDA events; produced by
+//benchmarkTimestep and consumed by the benchmarks target
+struct KernelTiming
+{
+    std::string kernelName;
+    float durationInMs = 0;
+};
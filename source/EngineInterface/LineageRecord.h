@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+//one replication event of the optional lineage tracking (see
+//SimulationController::setLineageTrackingEnabled): the constructed cell, the cell whose
+//constructor token built it and the founder of their lineage; filled on the GPU, hence trivially
+//copyable
+struct LineageRecord
+{
+    uint64_t childId = 0;
+    uint64_t parentId = 0;
+    uint64_t ancestorId = 0;
+    uint64_t timestep = 0;
+};
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+
+#include "MonitorData.h"
+
+//name of the shared-memory segment for the live telemetry export (see
+//_SimulationController::setLiveTelemetryEnabled); posix readers map "/alien_live_telemetry"
+auto const LiveTelemetryChannelName = "alien_live_telemetry";
+
+//binary layout of the live telemetry segment, refreshed at the monitor cadence while the export
+//is enabled. External exporters map the segment read-only and copy the snapshot with seqlock
+//semantics: read `sequence`, retry while it is odd, copy the snapshot and retry if `sequence`
+//changed during the copy. The layout is a versioned contract: bump Version on every change,
+//including changes to MonitorData
+struct LiveTelemetrySnapshot
+{
+    static uint32_t constexpr Magic = 0x4d544c41;  //"ALTM"
+    static uint32_t constexpr Version = 1;
+    static int constexpr MaxKernels = 32;
+
+    uint32_t magic = Magic;
+    uint32_t version = Version;
+    uint32_t sequence = 0;  //odd while the engine is writing
+    uint32_t numKernels = 0;
+
+    uint64_t timestep = 0;
+    float tps = 0;
+
+    MonitorData monitor;
+
+    //capacities of the entity arrays; together with the counts in `monitor` they give the fill levels
+    int cellArrayCapacity = 0;
+    int particleArrayCapacity = 0;
+    int tokenArrayCapacity = 0;
+
+    //latency percentiles in ms (same values as the json telemetry, see getTelemetryJson)
+    double timestepP50InMs = 0;
+    double timestepP95InMs = 0;
+    double timestepP99InMs = 0;
+    double accessWaitP50InMs = 0;
+    double accessWaitP95InMs = 0;
+    double accessWaitP99InMs = 0;
+    double transferP50InMs = 0;
+    double transferP95InMs = 0;
+    double transferP99InMs = 0;
+
+    //per-kernel accumulated timings; only filled while kernel profiling is enabled
+    uint64_t numProfiledTimesteps = 0;
+    struct KernelEntry
+    {
+        char name[48] = {};
+        float totalDurationInMs = 0;
+    };
+    KernelEntry kernels[MaxKernels];
+};
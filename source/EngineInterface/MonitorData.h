@@ -1,5 +1,16 @@
 #pragma once
 
+//statistics reduced over a single world region: one entry per simulation parameter spot (the
+//spot core, without the fadeout zone) followed by one entry per user-defined rect (see
+//_SimulationController::setStatisticsRects)
+struct RegionMonitorData
+{
+    int numCellsByColor[7] = {0, 0, 0, 0, 0, 0, 0};
+    int numTokens = 0;
+    int numParticles = 0;
+    double totalEnergy = 0.0;  //summed over the cells, tokens and particles inside the region
+};
+
 struct MonitorData
 {
     uint64_t timeStep = 0;
@@ -16,4 +27,15 @@ struct MonitorData
     int numSuccessfulAttacks = 0;
     int numFailedAttacks = 0;
     int numMuscleActivities = 0;
+
+    //structural operations per timestep
+    int numCreatedConnections = 0;
+    int numDestroyedConnections = 0;
+    int numDeletedCells = 0;
+    int numMovedTokens = 0;
+
+    //region-scoped statistics, reduced on the GPU together with the global values
+    static int constexpr MaxRegions = 8;
+    int numRegions = 0;
+    RegionMonitorData regions[MaxRegions];
 };
@@ -0,0 +1,129 @@
+#include "ParallelGzipStream.h"
+
+#include <algorithm>
+#include <stdexcept>
+#include <thread>
+
+#include <zlib.h>
+
+namespace
+{
+    auto constexpr ChunkSize = 8 * 1024 * 1024;
+
+    CompressedGzipChunk compressGzipMember(std::string const& data, int level)
+    {
+        z_stream zs{};
+        if (Z_OK != deflateInit2(&zs, level, Z_DEFLATED, 15 + 16 /*gzip wrapper*/, 8, Z_DEFAULT_STRATEGY)) {
+            throw std::runtime_error("Gzip compression could not be initialized.");
+        }
+        std::string result(deflateBound(&zs, static_cast<uLong>(data.size())), '\0');
+        zs.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+        zs.avail_in = static_cast<uInt>(data.size());
+        zs.next_out = reinterpret_cast<Bytef*>(result.data());
+        zs.avail_out = static_cast<uInt>(result.size());
+        auto returnCode = deflate(&zs, Z_FINISH);
+        deflateEnd(&zs);
+        if (Z_STREAM_END != returnCode) {
+            throw std::runtime_error("Gzip compression failed.");
+        }
+        result.resize(result.size() - zs.avail_out);
+        auto checksum = crc32(0L, reinterpret_cast<Bytef const*>(result.data()), static_cast<uInt>(result.size()));
+        return CompressedGzipChunk{std::move(result), checksum};
+    }
+}
+
+ParallelGzipStreamBuf::ParallelGzipStreamBuf(std::ostream& sink, int level)
+    : _sink(sink)
+    , _level(level)
+{
+    _maxPendingJobs = std::max(2u, std::thread::hardware_concurrency());
+    _chunk.reserve(ChunkSize);
+}
+
+ParallelGzipStreamBuf::~ParallelGzipStreamBuf()
+{
+    try {
+        finish();
+    } catch (...) {
+        //destructors must not throw; a failed write is reflected in the state of the sink
+    }
+}
+
+void ParallelGzipStreamBuf::finish()
+{
+    if (_finished) {
+        return;
+    }
+    _finished = true;
+    if (!_chunk.empty()) {
+        dispatchChunk();
+    }
+    drainPendingJobs(0);
+    _sink.flush();
+}
+
+ParallelGzipStreamBuf::int_type ParallelGzipStreamBuf::overflow(int_type ch)
+{
+    if (traits_type::eof() != ch) {
+        auto c = traits_type::to_char_type(ch);
+        xsputn(&c, 1);
+    }
+    return ch;
+}
+
+std::streamsize ParallelGzipStreamBuf::xsputn(char const* s, std::streamsize count)
+{
+    auto remaining = count;
+    while (remaining > 0) {
+        auto numBytes = std::min(remaining, static_cast<std::streamsize>(ChunkSize - _chunk.size()));
+        _chunk.append(s, numBytes);
+        s += numBytes;
+        remaining -= numBytes;
+        if (ChunkSize == _chunk.size()) {
+            dispatchChunk();
+        }
+    }
+    return count;
+}
+
+int ParallelGzipStreamBuf::sync()
+{
+    if (!_chunk.empty()) {
+        dispatchChunk();
+    }
+    drainPendingJobs(0);
+    _sink.flush();
+    return _sink ? 0 : -1;
+}
+
+void ParallelGzipStreamBuf::dispatchChunk()
+{
+    drainPendingJobs(_maxPendingJobs - 1);
+    _pendingJobs.emplace_back(std::async(std::launch::async, [chunk = std::move(_chunk), level = _level] { return compressGzipMember(chunk, level); }));
+    _chunk = {};
+    _chunk.reserve(ChunkSize);
+}
+
+void ParallelGzipStreamBuf::drainPendingJobs(size_t maxRemaining)
+{
+    while (_pendingJobs.size() > maxRemaining) {
+        auto compressed = _pendingJobs.front().get();
+        _pendingJobs.pop_front();
+        _sink.write(compressed.bytes.data(), compressed.bytes.size());
+        _checksum = 0 == _numBytesWritten
+            ? compressed.checksum
+            : crc32_combine(_checksum, compressed.checksum, static_cast<z_off_t>(compressed.bytes.size()));
+        _numBytesWritten += compressed.bytes.size();
+    }
+}
+
+ParallelGzipOStream::ParallelGzipOStream(std::ostream& sink, int level)
+    : std::ostream(&_buf)
+    , _buf(sink, level)
+{
+}
+
+void ParallelGzipOStream::finish()
+{
+    _buf.finish();
+}
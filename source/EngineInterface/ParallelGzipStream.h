@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <future>
+#include <ostream>
+#include <streambuf>
+#include <string>
+
+struct CompressedGzipChunk
+{
+    std::string bytes;
+    unsigned long checksum;    //crc32 of the compressed bytes, computed on the compression thread
+};
+
+/**
+ * Compresses the written data in fixed-size chunks on background threads. Each chunk becomes an
+ * independent gzip member and the members are concatenated in order, which is a valid gzip stream
+ * and can be read by any gzip decompressor (in particular by zstr::istream). The number of
+ * buffered chunks is bounded, so large archives stream to the sink without being held in memory.
+ */
+class ParallelGzipStreamBuf : public std::streambuf
+{
+public:
+    //level: zlib compression level; the default favors speed (autosaves), maximum level is worth
+    //its cpu time when the output goes over the wire
+    ParallelGzipStreamBuf(std::ostream& sink, int level = -1 /*Z_DEFAULT_COMPRESSION*/);
+    ~ParallelGzipStreamBuf() override;
+
+    void finish();    //waits for the pending compression jobs and writes the remaining data to the sink
+
+    //valid after finish(); checksum and length of the compressed output, for integrity verification
+    uint32_t getChecksum() const { return static_cast<uint32_t>(_checksum); }
+    uint64_t getNumBytesWritten() const { return _numBytesWritten; }
+
+protected:
+    int_type overflow(int_type ch) override;
+    std::streamsize xsputn(char const* s, std::streamsize count) override;
+    int sync() override;
+
+private:
+    void dispatchChunk();
+    void drainPendingJobs(size_t maxRemaining);
+
+    std::ostream& _sink;
+    int _level = 0;
+    std::string _chunk;
+    std::deque<std::future<CompressedGzipChunk>> _pendingJobs;
+    size_t _maxPendingJobs = 0;
+    bool _finished = false;
+    unsigned long _checksum = 0;
+    uint64_t _numBytesWritten = 0;
+};
+
+class ParallelGzipOStream : public std::ostream
+{
+public:
+    ParallelGzipOStream(std::ostream& sink, int level = -1 /*Z_DEFAULT_COMPRESSION*/);
+
+    void finish();
+
+    uint32_t getChecksum() const { return _buf.getChecksum(); }
+    uint64_t getNumBytesWritten() const { return _buf.getNumBytesWritten(); }
+
+private:
+    ParallelGzipStreamBuf _buf;
+};
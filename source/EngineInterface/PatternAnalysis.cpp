@@ -0,0 +1,70 @@
+#include "PatternAnalysis.h"
+
+#include <algorithm>
+#include <map>
+
+#include <boost/range/adaptor/indexed.hpp>
+#include <boost/range/adaptors.hpp>
+
+std::vector<PatternAnalysis::PartitionClass> PatternAnalysis::calcRepetitiveActiveClusters(ClusteredDataDescription const& data)
+{
+    std::map<ClusterAnalysisDescription, PartitionClass> partitionClassByDescription;
+    for (auto const& cluster : data.clusters) {
+        auto const clusterAnalysisData = getAnalysisDescription(cluster);
+        auto& partitionClass = partitionClassByDescription[clusterAnalysisData];
+        if (1 == ++partitionClass.numberOfElements) {
+            partitionClass.representant = cluster;
+        }
+    }
+
+    std::vector<PartitionClass> result;
+    for (auto const& [analysisDesc, partitionClass] : partitionClassByDescription) {
+        if (partitionClass.numberOfElements > 1 && analysisDesc.hasToken) {
+            result.emplace_back(partitionClass);
+        }
+    }
+    std::sort(result.begin(), result.end(), [](PartitionClass const& left, PartitionClass const& right) { return right < left; });
+    return result;
+}
+
+auto PatternAnalysis::getAnalysisDescription(ClusterDescription const& cluster) -> ClusterAnalysisDescription
+{
+    ClusterAnalysisDescription result;
+    result.hasToken = false;
+
+    std::map<uint64_t, CellAnalysisDescription> cellAnalysisDescById;
+    auto insertCellAnalysisDescription = [&cellAnalysisDescById](CellDescription const& cell) {
+        if (cellAnalysisDescById.find(cell.id) == cellAnalysisDescById.end()) {
+            CellAnalysisDescription result;
+            result.maxConnections = cell.maxConnections;
+            result.numConnections = cell.connections.size();
+            result.tokenBlocked = cell.tokenBlocked;
+            result.tokenBranchNumber = cell.tokenBranchNumber;
+            //            result.color = cell.metadata.color;
+
+            CellFeatureAnalysisDescription featureAnalysisData;
+            featureAnalysisData.cellFunction = cell.cellFeature.getType();
+            result.feature = featureAnalysisData;
+
+            cellAnalysisDescById.insert_or_assign(cell.id, result);
+        }
+    };
+
+    std::map<uint64_t, int> cellDescIndexById;
+    for (auto const& [index, cell] : cluster.cells | boost::adaptors::indexed(0)) {
+        cellDescIndexById.insert_or_assign(cell.id, toInt(index));
+    }
+
+    for (auto const& cell : cluster.cells) {
+        insertCellAnalysisDescription(cell);
+        for (auto const& connection : cell.connections) {
+            auto connectingCellId = connection.cellId;
+            insertCellAnalysisDescription(cluster.cells.at(cellDescIndexById.at(connectingCellId)));
+            result.connectedCells.insert(std::set<CellAnalysisDescription>{cellAnalysisDescById.at(cell.id), cellAnalysisDescById.at(connectingCellId)});
+        }
+        if (cell.tokens.size() > 0) {
+            result.hasToken = true;
+        }
+    }
+    return result;
+}
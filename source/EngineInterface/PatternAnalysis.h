@@ -0,0 +1,104 @@
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "Descriptions.h"
+
+//structural partition of a world into topology classes: clusters whose cells agree in their
+//connection structure, branch numbers and cell functions fall into the same class regardless of
+//position and orientation. Extracted from the GUI pattern analysis so that the offline analyzer
+//can run the same analysis on deserialized saves without an engine
+class PatternAnalysis
+{
+public:
+    struct PartitionClass
+    {
+        int numberOfElements = 0;
+        ClusterDescription representant;
+
+        bool operator<(PartitionClass const& other) const { return numberOfElements < other.numberOfElements; }
+    };
+
+    //repetitive active clusters: topology classes with more than one exemplar of which at least
+    //one cell carries a token, sorted by descending number of exemplars; the usual signature of
+    //self-replicators that took over a world
+    static std::vector<PartitionClass> calcRepetitiveActiveClusters(ClusteredDataDescription const& data);
+
+private:
+    struct CellFeatureAnalysisDescription
+    {
+        int cellFunction;
+
+        bool operator<(CellFeatureAnalysisDescription const& other) const
+        {
+            if (cellFunction != other.cellFunction) {
+                return cellFunction < other.cellFunction;
+            }
+            return false;
+        }
+        bool operator==(CellFeatureAnalysisDescription const& other) const { return cellFunction == other.cellFunction; }
+        bool operator!=(CellFeatureAnalysisDescription const& other) const { return !operator==(other); }
+    };
+    struct CellAnalysisDescription
+    {
+        int maxConnections;
+        int numConnections;
+        bool tokenBlocked;
+        int tokenBranchNumber;
+        int color;
+        CellFeatureAnalysisDescription feature;
+
+        bool operator==(CellAnalysisDescription const& other) const
+        {
+            return maxConnections == other.maxConnections && numConnections == other.numConnections && tokenBlocked == other.tokenBlocked
+                && tokenBranchNumber == other.tokenBranchNumber && feature == other.feature
+                /*&& color == other.color*/;
+        }
+
+        bool operator!=(CellAnalysisDescription const& other) const { return !operator==(other); }
+
+        bool operator<(CellAnalysisDescription const& other) const
+        {
+            if (maxConnections != other.maxConnections) {
+                return maxConnections < other.maxConnections;
+            }
+            if (numConnections != other.numConnections) {
+                return numConnections < other.numConnections;
+            }
+            if (tokenBlocked != other.tokenBlocked) {
+                return tokenBlocked < other.tokenBlocked;
+            }
+            if (tokenBranchNumber != other.tokenBranchNumber) {
+                return tokenBranchNumber < other.tokenBranchNumber;
+            }
+            if (feature != other.feature) {
+                return feature < other.feature;
+            }
+            /*
+            if (color != other.color) {
+                return color < other.color;
+            }
+*/
+            return false;
+        }
+    };
+    struct ClusterAnalysisDescription
+    {
+        bool hasToken;
+        std::set<std::set<CellAnalysisDescription>> connectedCells;
+
+        bool operator<(ClusterAnalysisDescription const& other) const
+        {
+            if (hasToken != other.hasToken) {
+                return hasToken < other.hasToken;
+            }
+            if (connectedCells != other.connectedCells) {
+                return connectedCells < other.connectedCells;
+            }
+            return false;
+        }
+    };
+
+    static ClusterAnalysisDescription getAnalysisDescription(ClusterDescription const& cluster);
+};
@@ -0,0 +1,13 @@
+#pragma once
+
+//transform of one copy stamped by replicateSelectedEntities, relative to the selection center;
+//the semantics match DataDescription::shift/rotate/accelerate
+struct ReplicationTransform
+{
+    float posDeltaX = 0;
+    float posDeltaY = 0;
+    float angle = 0;    //in degrees, applied around the copy's center
+    float velDeltaX = 0;
+    float velDeltaY = 0;
+    float angularVelDelta = 0;
+};
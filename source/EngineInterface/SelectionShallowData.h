@@ -1,5 +1,7 @@
 #pragma once
 
+#include "Enums.h"
+
 struct SelectionShallowData
 {
     int numCells = 0;
@@ -16,6 +18,13 @@ struct SelectionShallowData
     float clusterCenterVelX = 0;
     float clusterCenterVelY = 0;
 
+    //aggregate statistics over the direct selection, reduced on the GPU alongside the counts so
+    //that reading them does not require a full TO extraction
+    float cellEnergy = 0;
+    float particleEnergy = 0;
+    int numCellsByFunction[Enums::CellFunction_Count] = {0, 0, 0, 0, 0, 0, 0};
+    int numCellsByColor[7] = {0, 0, 0, 0, 0, 0, 0};
+
     bool compareNumbers(SelectionShallowData const& other) const
     {
         return numCells == other.numCells && numClusterCells == other.numClusterCells && numParticles == other.numParticles;
@@ -19,9 +19,63 @@
 
 #include "Base/Resources.h"
 #include "Descriptions.h"
+#include "ParallelGzipStream.h"
 #include "SimulationParameters.h"
 #include "SettingsParser.h"
 
+namespace
+{
+    //written ahead of the compressed archive; allows O(1) format detection without decompressing
+    //the file or probing deprecated layouts via failed deserialization attempts.
+    //the header is followed by the length (uint64) and the crc32 (uint32) of the compressed
+    //payload so that truncated or corrupt files are rejected before any deserialization
+    std::string const ContentFileHeader = "alien content 2\n";
+
+    template <typename T>
+    void writeValue(std::ostream& stream, T const& value)
+    {
+        stream.write(reinterpret_cast<char const*>(&value), sizeof(T));
+    }
+
+    template <typename T>
+    bool readValue(std::istream& stream, T& value)
+    {
+        stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+        return static_cast<bool>(stream);
+    }
+
+    //returns std::nullopt if the stream ends before numBytes could be read (truncated file)
+    std::optional<uint32_t> calcFileChecksum(std::istream& stream, uint64_t numBytes)
+    {
+        auto checksum = crc32(0L, Z_NULL, 0);
+        std::vector<char> buffer(1024 * 1024);
+        uint64_t numBytesRead = 0;
+        while (numBytesRead < numBytes) {
+            auto numBytesToRead = std::min(numBytes - numBytesRead, static_cast<uint64_t>(buffer.size()));
+            stream.read(buffer.data(), numBytesToRead);
+            if (stream.gcount() == 0) {
+                return std::nullopt;
+            }
+            checksum = crc32(checksum, reinterpret_cast<Bytef const*>(buffer.data()), static_cast<uInt>(stream.gcount()));
+            numBytesRead += stream.gcount();
+        }
+        return static_cast<uint32_t>(checksum);
+    }
+
+    //writes are directed to a temporary file which is renamed into place on success, so an
+    //interrupted save never clobbers the previous checkpoint
+    bool renameIntoPlace(std::filesystem::path const& tmpFilename, std::filesystem::path const& filename)
+    {
+        std::error_code errorCode;
+        std::filesystem::rename(tmpFilename, filename, errorCode);
+        if (errorCode) {
+            std::filesystem::remove(tmpFilename, errorCode);
+            return false;
+        }
+        return true;
+    }
+}
+
 namespace cereal
 {
 
@@ -219,28 +273,40 @@ bool Serializer::serializeSimulationToFiles(std::string const& filename, Deseria
         std::filesystem::path symbolsFilename(filename);
         symbolsFilename.replace_extension(std::filesystem::path(".symbols.json"));
 
-        {
-            zstr::ofstream stream(filename, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
-            serializeDataDescription(data.content, stream);
+        std::filesystem::path metadataFilename(filename);
+        metadataFilename.replace_extension(std::filesystem::path(".meta.json"));
+
+        if (!serializeDataDescriptionToFile(filename, data.content)) {
+            return false;
+        }
+        if (!serializeMetadataToFile(metadataFilename.string(), calcMetadata(data))) {
+            return false;
         }
         {
-            std::ofstream stream(settingsFilename.string(), std::ios::binary);
+            auto tmpFilename = settingsFilename;
+            tmpFilename += ".tmp";
+            std::ofstream stream(tmpFilename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
             serializeTimestepAndSettings(data.timestep, data.settings, stream);
             stream.close();
+            if (!renameIntoPlace(tmpFilename, settingsFilename)) {
+                return false;
+            }
         }
         {
-            std::ofstream stream(symbolsFilename.string(), std::ios::binary);
+            auto tmpFilename = symbolsFilename;
+            tmpFilename += ".tmp";
+            std::ofstream stream(tmpFilename.string(), std::ios::binary);
             if (!stream) {
                 return false;
             }
             serializeSymbolMap(data.symbolMap, stream);
             stream.close();
+            if (!renameIntoPlace(tmpFilename, symbolsFilename)) {
+                return false;
+            }
         }
         return true;
     } catch (...) {
@@ -291,12 +357,9 @@ bool Serializer::serializeSimulationToStrings(
     try {
         {
             std::stringstream stdStream;
-            zstr::ostream stream(stdStream, std::ios::binary);
-            if (!stream) {
-                return false;
-            }
+            ParallelGzipOStream stream(stdStream);
             serializeDataDescription(data.content, stream);
-            stream.flush();
+            stream.finish();
             content = stdStream.str();
         }
         {
@@ -320,11 +383,20 @@ bool Serializer::deserializeSimulationFromStrings(
     std::string const& content,
     std::string const& timestepAndSettings,
     std::string const& symbolMap)
+{
+    std::stringstream contentStream(content);
+    return deserializeSimulationFromStreams(data, contentStream, timestepAndSettings, symbolMap);
+}
+
+bool Serializer::deserializeSimulationFromStreams(
+    DeserializedSimulation& data,
+    std::istream& content,
+    std::string const& timestepAndSettings,
+    std::string const& symbolMap)
 {
     try {
         {
-            std::stringstream stdStream(content);
-            zstr::istream stream(stdStream, std::ios::binary);
+            zstr::istream stream(content, std::ios::binary);
             if (!stream) {
                 return false;
             }
@@ -406,18 +478,179 @@ bool Serializer::deserializeSimulationFromSingleString(DeserializedSimulation& d
 bool Serializer::serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content)
 {
     try {
-        zstr::ofstream fileStream(filename, std::ios::binary);
-        if (!fileStream) {
+        return serializeDataDescriptionToFile(filename, content);
+    } catch (...) {
+        return false;
+    }
+}
+
+SimulationFileMetadata Serializer::calcMetadata(DeserializedSimulation const& data)
+{
+    SimulationFileMetadata result;
+    result.timestep = data.timestep;
+    result.worldSize = {data.settings.generalSettings.worldSizeX, data.settings.generalSettings.worldSizeY};
+    result.numClusters = toInt(data.content.clusters.size());
+    result.numParticles = toInt(data.content.particles.size());
+
+    auto boundingBoxInitialized = false;
+    auto addToBoundingBox = [&](RealVector2D const& pos) {
+        if (!boundingBoxInitialized) {
+            result.boundingBox = {pos, pos};
+            boundingBoxInitialized = true;
+        } else {
+            result.boundingBox.topLeft.x = std::min(result.boundingBox.topLeft.x, pos.x);
+            result.boundingBox.topLeft.y = std::min(result.boundingBox.topLeft.y, pos.y);
+            result.boundingBox.bottomRight.x = std::max(result.boundingBox.bottomRight.x, pos.x);
+            result.boundingBox.bottomRight.y = std::max(result.boundingBox.bottomRight.y, pos.y);
+        }
+    };
+
+    for (auto const& cluster : data.content.clusters) {
+        result.numCells += toInt(cluster.cells.size());
+        for (auto const& cell : cluster.cells) {
+            ++result.numCellsByColor[cell.metadata.color % 7];
+            result.numTokens += toInt(cell.tokens.size());
+            addToBoundingBox(cell.pos);
+        }
+    }
+    for (auto const& particle : data.content.particles) {
+        addToBoundingBox(particle.pos);
+    }
+    return result;
+}
+
+bool Serializer::serializeMetadataToFile(std::string const& filename, SimulationFileMetadata const& metadata)
+{
+    try {
+        boost::property_tree::ptree tree;
+        tree.put("timestep", metadata.timestep);
+        tree.put("world size.x", metadata.worldSize.x);
+        tree.put("world size.y", metadata.worldSize.y);
+        tree.put("clusters", metadata.numClusters);
+        tree.put("cells", metadata.numCells);
+        tree.put("particles", metadata.numParticles);
+        tree.put("tokens", metadata.numTokens);
+        boost::property_tree::ptree colorsTree;
+        for (auto const& numCells : metadata.numCellsByColor) {
+            boost::property_tree::ptree colorTree;
+            colorTree.put("", numCells);
+            colorsTree.push_back(std::make_pair("", colorTree));
+        }
+        tree.add_child("cells by color", colorsTree);
+        tree.put("bounding box.top left.x", metadata.boundingBox.topLeft.x);
+        tree.put("bounding box.top left.y", metadata.boundingBox.topLeft.y);
+        tree.put("bounding box.bottom right.x", metadata.boundingBox.bottomRight.x);
+        tree.put("bounding box.bottom right.y", metadata.boundingBox.bottomRight.y);
+
+        std::filesystem::path metadataFilename(filename);
+        auto tmpFilename = metadataFilename;
+        tmpFilename += ".tmp";
+        std::ofstream stream(tmpFilename.string(), std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        boost::property_tree::write_json(stream, tree);
+        stream.close();
+        return renameIntoPlace(tmpFilename, metadataFilename);
+    } catch (...) {
+        return false;
+    }
+}
+
+bool Serializer::deserializeMetadataFromFile(SimulationFileMetadata& metadata, std::string const& filename)
+{
+    try {
+        std::filesystem::path metadataFilename(filename);
+        metadataFilename.replace_extension(std::filesystem::path(".meta.json"));
+
+        std::ifstream stream(metadataFilename.string(), std::ios::binary);
+        if (!stream) {
             return false;
         }
-        serializeDataDescription(content, fileStream);
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(stream, tree);
+
+        metadata.timestep = tree.get<uint64_t>("timestep");
+        metadata.worldSize.x = tree.get<int>("world size.x");
+        metadata.worldSize.y = tree.get<int>("world size.y");
+        metadata.numClusters = tree.get<int>("clusters");
+        metadata.numCells = tree.get<int>("cells");
+        metadata.numParticles = tree.get<int>("particles");
+        metadata.numTokens = tree.get<int>("tokens");
+        auto index = 0;
+        for (auto const& [key, colorTree] : tree.get_child("cells by color")) {
+            if (index < 7) {
+                metadata.numCellsByColor[index++] = colorTree.get_value<int>();
+            }
+        }
+        metadata.boundingBox.topLeft.x = tree.get<float>("bounding box.top left.x");
+        metadata.boundingBox.topLeft.y = tree.get<float>("bounding box.top left.y");
+        metadata.boundingBox.bottomRight.x = tree.get<float>("bounding box.bottom right.x");
+        metadata.boundingBox.bottomRight.y = tree.get<float>("bounding box.bottom right.y");
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool Serializer::serializeMetadataSidecar(std::string const& filename, DeserializedSimulation const& data)
+{
+    try {
+        std::filesystem::path metadataFilename(filename);
+        metadataFilename.replace_extension(std::filesystem::path(".meta.json"));
+        return serializeMetadataToFile(metadataFilename.string(), calcMetadata(data));
+    } catch (...) {
+        return false;
+    }
+}
 
+bool Serializer::serializeContentToString(std::string& output, ClusteredDataDescription const& content)
+{
+    try {
+        std::stringstream stdStream;
+        ParallelGzipOStream stream(stdStream);
+        serializeDataDescription(content, stream);
+        stream.finish();
+        output = stdStream.str();
         return true;
     } catch (...) {
         return false;
     }
 }
 
+bool Serializer::deserializeContentFromString(ClusteredDataDescription& content, std::string const& input)
+{
+    try {
+        std::stringstream stdStream(input);
+        zstr::istream stream(stdStream, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        deserializeDataDescription(content, stream);
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+uint64_t Serializer::calcClusterHash(ClusterDescription const& cluster)
+{
+    std::stringstream stream;
+    {
+        cereal::PortableBinaryOutputArchive archive(stream);
+        archive(cluster);
+    }
+
+    //FNV-1a over the serialized bytes: stable across program runs, unlike a hash of the in-memory
+    //representation
+    auto data = stream.str();
+    uint64_t result = 0xcbf29ce484222325ull;
+    for (auto c : data) {
+        result = (result ^ static_cast<unsigned char>(c)) * 0x100000001b3ull;
+    }
+    return result;
+}
+
 bool Serializer::deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filename)
 {
     try {
@@ -430,6 +663,78 @@ bool Serializer::deserializeContentFromFile(ClusteredDataDescription& content, s
     }
 }
 
+bool Serializer::serializeAuxiliaryDataToFiles(std::string const& filename, uint64_t timestep, Settings const& settings, SymbolMap const& symbolMap)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+
+        std::filesystem::path symbolsFilename(filename);
+        symbolsFilename.replace_extension(std::filesystem::path(".symbols.json"));
+
+        {
+            auto tmpFilename = settingsFilename;
+            tmpFilename += ".tmp";
+            std::ofstream stream(tmpFilename.string(), std::ios::binary);
+            if (!stream) {
+                return false;
+            }
+            serializeTimestepAndSettings(timestep, settings, stream);
+            stream.close();
+            if (!renameIntoPlace(tmpFilename, settingsFilename)) {
+                return false;
+            }
+        }
+        {
+            auto tmpFilename = symbolsFilename;
+            tmpFilename += ".tmp";
+            std::ofstream stream(tmpFilename.string(), std::ios::binary);
+            if (!stream) {
+                return false;
+            }
+            serializeSymbolMap(symbolMap, stream);
+            stream.close();
+            if (!renameIntoPlace(tmpFilename, symbolsFilename)) {
+                return false;
+            }
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
+bool Serializer::deserializeAuxiliaryDataFromFiles(uint64_t& timestep, Settings& settings, SymbolMap& symbolMap, std::string const& filename)
+{
+    try {
+        std::filesystem::path settingsFilename(filename);
+        settingsFilename.replace_extension(std::filesystem::path(".settings.json"));
+
+        std::filesystem::path symbolsFilename(filename);
+        symbolsFilename.replace_extension(std::filesystem::path(".symbols.json"));
+
+        {
+            std::ifstream stream(settingsFilename.string(), std::ios::binary);
+            if (!stream) {
+                return false;
+            }
+            deserializeTimestepAndSettings(timestep, settings, stream);
+            stream.close();
+        }
+        {
+            std::ifstream stream(symbolsFilename.string(), std::ios::binary);
+            if (!stream) {
+                return false;
+            }
+            deserializeSymbolMap(symbolMap, stream);
+            stream.close();
+        }
+        return true;
+    } catch (...) {
+        return false;
+    }
+}
+
 bool Serializer::serializeSymbolsToFile(std::string const& filename, SymbolMap const& symbolMap)
 {
     try {
@@ -467,9 +772,42 @@ void Serializer::serializeDataDescription(ClusteredDataDescription const& data,
     archive(data);
 }
 
+bool Serializer::serializeDataDescriptionToFile(std::string const& filename, ClusteredDataDescription const& data)
+{
+    auto tmpFilename = std::filesystem::path(filename);
+    tmpFilename += ".tmp";
+
+    auto success = false;
+    {
+        //the content is compressed in chunks on all host cores; the concatenated gzip members
+        //remain readable by the single-threaded zstr decompressor
+        std::ofstream fileStream(tmpFilename.string(), std::ios::binary);
+        if (!fileStream) {
+            return false;
+        }
+        fileStream.write(ContentFileHeader.data(), ContentFileHeader.size());
+        writeValue(fileStream, static_cast<uint64_t>(0));    //payload length, patched below
+        writeValue(fileStream, static_cast<uint32_t>(0));    //payload checksum, patched below
+        ParallelGzipOStream stream(fileStream);
+        serializeDataDescription(data, stream);
+        stream.finish();
+
+        fileStream.seekp(ContentFileHeader.size());
+        writeValue(fileStream, stream.getNumBytesWritten());
+        writeValue(fileStream, stream.getChecksum());
+        success = static_cast<bool>(fileStream);
+    }
+    if (!success) {
+        std::error_code errorCode;
+        std::filesystem::remove(tmpFilename, errorCode);
+        return false;
+    }
+    return renameIntoPlace(tmpFilename, filename);
+}
+
 void Serializer::serializeTimestepAndSettings(uint64_t timestep, Settings const& generalSettings, std::ostream& stream)
 {
-    boost::property_tree::json_parser::write_json(stream, SettingsParser::encode(timestep, generalSettings));
+    stream << SettingsParser::encode(timestep, generalSettings).toJson();
 }
 
 void Serializer::serializeSymbolMap(SymbolMap const symbols, std::ostream& stream)
@@ -484,6 +822,43 @@ void Serializer::serializeSymbolMap(SymbolMap const symbols, std::ostream& strea
 
 bool Serializer::deserializeDataDescription(ClusteredDataDescription& data, std::string const& filename)
 {
+    //current files identify themselves by a header; no decompression or probing is needed to
+    //detect the format
+    {
+        std::ifstream fileStream(filename, std::ios::binary);
+        if (!fileStream) {
+            return false;
+        }
+        std::string header(ContentFileHeader.size(), '\0');
+        fileStream.read(header.data(), header.size());
+        if (fileStream && header == ContentFileHeader) {
+
+            //length and checksum of the compressed payload are verified first, so a truncated or
+            //corrupt file is rejected before any decompression or deserialization is attempted
+            uint64_t numPayloadBytes;
+            uint32_t checksum;
+            if (!readValue(fileStream, numPayloadBytes) || !readValue(fileStream, checksum)) {
+                return false;
+            }
+            auto payloadStart = fileStream.tellg();
+            auto checksumOfFile = calcFileChecksum(fileStream, numPayloadBytes);
+            if (!checksumOfFile || *checksumOfFile != checksum) {
+                return false;
+            }
+            fileStream.clear();
+            fileStream.seekg(payloadStart);
+            try {
+                zstr::istream stream(fileStream, std::ios::binary);
+                deserializeDataDescription(data, stream);
+                return true;
+            } catch (...) {
+                return false;
+            }
+        }
+    }
+
+    //files from older versions carry no header; their format can only be probed by attempting
+    //deserialization
     try {
         zstr::ifstream stream(filename, std::ios::binary);
         if (!stream) {
@@ -533,9 +908,8 @@ void Serializer::DEPREACATED_deserializeDataDescription(ClusteredDataDescription
 
 void Serializer::deserializeTimestepAndSettings(uint64_t& timestep, Settings& settings, std::istream& stream)
 {
-    boost::property_tree::ptree tree;
-    boost::property_tree::read_json(stream, tree);
-    std::tie(timestep, settings) = SettingsParser::decodeTimestepAndSettings(tree);
+    auto json = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    std::tie(timestep, settings) = SettingsParser::decodeTimestepAndSettings(JsonDocument::fromJson(json));
 }
 
 void Serializer::deserializeSymbolMap(SymbolMap& symbolMap, std::istream& stream)
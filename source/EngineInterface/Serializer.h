@@ -8,6 +8,7 @@
 #include "SimulationParameters.h"
 #include "GeneralSettings.h"
 #include "Descriptions.h"
+#include "SimulationFileMetadata.h"
 
 struct DeserializedSimulation
 {
@@ -34,6 +35,14 @@ public:
         std::string const& timestepAndSettings,
         std::string const& symbolMap);
 
+    //variant for streamed sources (e.g. a network download): the content is decompressed and
+    //deserialized incrementally while it is read, so the caller need not buffer it as a whole
+    static bool deserializeSimulationFromStreams(
+        DeserializedSimulation& data,
+        std::istream& content,
+        std::string const& timestepAndSettings,
+        std::string const& symbolMap);
+
 /*
     static bool serializeSimulationToSingleString(std::string& output, DeserializedSimulation const& data);
     static bool deserializeSimulationFromSingleString(DeserializedSimulation& data, std::string const& input);
@@ -42,11 +51,31 @@ public:
     static bool serializeContentToFile(std::string const& filename, ClusteredDataDescription const& content);
     static bool deserializeContentFromFile(ClusteredDataDescription& content, std::string const& filenam);
 
+    //building blocks of the differential world sync between two program instances: a compressed
+    //content payload and a per-cluster content hash for cheap equality checks
+    static bool serializeContentToString(std::string& output, ClusteredDataDescription const& content);
+    static bool deserializeContentFromString(ClusteredDataDescription& content, std::string const& input);
+    static uint64_t calcClusterHash(ClusterDescription const& cluster);
+
+    //writes/reads only the settings and symbols sidecar files; the content file is handled elsewhere
+    //(e.g. by the raw snapshot path of the engine)
+    static bool serializeAuxiliaryDataToFiles(std::string const& filename, uint64_t timestep, Settings const& settings, SymbolMap const& symbolMap);
+    static bool deserializeAuxiliaryDataFromFiles(uint64_t& timestep, Settings& settings, SymbolMap& symbolMap, std::string const& filename);
+
     static bool serializeSymbolsToFile(std::string const& filename, SymbolMap const& symbolMap);
     static bool deserializeSymbolsFromFile(SymbolMap& symbolMap, std::string const& filename);
 
+    //reads only the .meta.json sidecar written next to the content file by
+    //serializeSimulationToFiles; saves from older program versions have none => false
+    static bool deserializeMetadataFromFile(SimulationFileMetadata& metadata, std::string const& filename);
+
+    //writes (or rewrites) the .meta.json sidecar next to an existing content file; used to
+    //backfill the sidecars of saves from program versions that did not write them
+    static bool serializeMetadataSidecar(std::string const& filename, DeserializedSimulation const& data);
+
 private:
     static void serializeDataDescription(ClusteredDataDescription const& data, std::ostream& stream);
+    static bool serializeDataDescriptionToFile(std::string const& filename, ClusteredDataDescription const& data);
     static void serializeTimestepAndSettings(uint64_t timestep, Settings const& generalSettings, std::ostream& stream);
     static void serializeSymbolMap(SymbolMap const symbols, std::ostream& stream);
 
@@ -55,4 +84,7 @@ private:
     static void DEPREACATED_deserializeDataDescription(ClusteredDataDescription& data, std::istream& stream);
     static void deserializeTimestepAndSettings(uint64_t& timestep, Settings& settings, std::istream& stream);
     static void deserializeSymbolMap(SymbolMap& symbolMap, std::istream& stream);
+
+    static SimulationFileMetadata calcMetadata(DeserializedSimulation const& data);
+    static bool serializeMetadataToFile(std::string const& filename, SimulationFileMetadata const& metadata);
 };
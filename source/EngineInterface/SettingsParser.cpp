@@ -3,15 +3,14 @@
 #include "GeneralSettings.h"
 #include "Settings.h"
 
-boost::property_tree::ptree SettingsParser::encode(uint64_t timestep, Settings settings)
+JsonDocument SettingsParser::encode(uint64_t timestep, Settings settings)
 {
-    boost::property_tree::ptree tree;
+    JsonDocument tree;
     encodeDecode(tree, timestep, settings, ParserTask::Encode);
     return tree;
 }
 
-std::pair<uint64_t, Settings> SettingsParser::decodeTimestepAndSettings(
-    boost::property_tree::ptree tree)
+std::pair<uint64_t, Settings> SettingsParser::decodeTimestepAndSettings(JsonDocument tree)
 {
     uint64_t timestep;
     Settings settings;
@@ -25,7 +24,7 @@ namespace
     std::unordered_map<std::string, SpotShape> shapeEnumMap = {{"circular", SpotShape::Circular}, {"rectangular", SpotShape::Rectangular}};
 }
 
-void SettingsParser::encodeDecode(boost::property_tree::ptree& tree, uint64_t& timestep, Settings& settings, ParserTask ParserTask)
+void SettingsParser::encodeDecode(JsonDocument& tree, uint64_t& timestep, Settings& settings, ParserTask ParserTask)
 {
     Settings defaultSettings;
 
@@ -191,6 +190,12 @@ void SettingsParser::encodeDecode(boost::property_tree::ptree& tree, uint64_t& t
         defaultPar.radiationVelocityPerturbation,
         "simulation parameters.radiation.velocity perturbation",
         ParserTask);
+    JsonParser::encodeDecode(
+        tree,
+        simPar.particleSubcyclingStride,
+        defaultPar.particleSubcyclingStride,
+        "simulation parameters.particle.subcycling stride",
+        ParserTask);
 
     //spots
     auto& spots = settings.simulationParametersSpots;
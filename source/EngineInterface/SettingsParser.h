@@ -1,7 +1,5 @@
 #pragma once
 
-#include <boost/property_tree/ptree.hpp>
-
 #include "Base/JsonParser.h"
 
 #include "Definitions.h"
@@ -9,11 +7,10 @@
 class SettingsParser
 {
 public:
-    static boost::property_tree::ptree encode(uint64_t timestep, Settings parameters);
-    static std::pair<uint64_t, Settings> decodeTimestepAndSettings(
-        boost::property_tree::ptree tree);
+    static JsonDocument encode(uint64_t timestep, Settings parameters);
+    static std::pair<uint64_t, Settings> decodeTimestepAndSettings(JsonDocument tree);
 
 private:
     static void
-    encodeDecode(boost::property_tree::ptree& tree, uint64_t& timestep, Settings& settings, ParserTask task);
+    encodeDecode(JsonDocument& tree, uint64_t& timestep, Settings& settings, ParserTask task);
 };
\ No newline at end of file
@@ -3,6 +3,10 @@
 struct ShallowUpdateSelectionData
 {
     bool considerClusters = true;
+
+    //freezes the topology during active drags: the move skips the disconnect/reconnect passes and
+    //only updates positions; the caller performs one reconnection pass on mouse release instead
+    bool deferReconnection = false;
     float posDeltaX = 0;
     float posDeltaY = 0;
     float velDeltaX = 0;
@@ -1,11 +1,24 @@
 #pragma once
+#include <chrono>
+#include <future>
+
+#include "CellBatchData.h"
+#include "CellEvent.h"
+#include "DataAccessSchema.h"
 #include "Definitions.h"
+#include "LineageRecord.h"
+#include "EditCommands.h"
+#include "GpuMemoryInfo.h"
+#include "ReplicationTransform.h"
+#include "KernelProfileData.h"
+#include "KernelTiming.h"
 #include "OverlayDescriptions.h"
 #include "SelectionShallowData.h"
 #include "Settings.h"
 #include "ShallowUpdateSelectionData.h"
 #include "SimulationController.h"
 #include "SymbolMap.h"
+#include "WorldGenerationSpec.h"
 
 class _SimulationController
 {
@@ -27,13 +40,74 @@ public:
 
     virtual ClusteredDataDescription getClusteredSimulationData() = 0;
     virtual DataDescription getSimulationData() = 0;
+
+    //reduced-schema variant: metadata strings (and optionally token memories) are skipped during
+    //the extraction, which shrinks monitoring snapshots considerably; the skipped fields arrive
+    //empty in the returned description
+    virtual DataDescription getSimulationData(DataAccessSchema const& schema) = 0;
     virtual ClusteredDataDescription getSelectedClusteredSimulationData(bool includeClusters) = 0;
     virtual DataDescription getSelectedSimulationData(bool includeClusters) = 0;
     virtual DataDescription getInspectedSimulationData(std::vector<uint64_t> entityIds) = 0;
 
+    //batch primitive for automation and script bindings: the cell attributes in the rect as
+    //columnar arrays, extracted in a single guarded transfer without building description
+    //objects; pair with applyEnergyDeltaToCells for a read-modify-write automation loop that
+    //acquires the engine twice per step instead of once per cell
+    virtual CellBatchData queryCellBatch(IntVector2D const& rectUpperLeft, IntVector2D const& rectLowerRight) = 0;
+
+    //subscription-based inspection channel: the engine pushes fresh data for the registered
+    //entities at the given rate between timestep batches, decoupled from GUI polling; an empty
+    //id list unsubscribes. Each pushed description is obtained exactly once via fetchInspectionData
+    virtual void setInspectedEntityIds(std::vector<uint64_t> const& entityIds, std::chrono::milliseconds const& updateInterval) = 0;
+    virtual std::optional<DataDescription> fetchInspectionData() = 0;
+
     virtual void addAndSelectSimulationData(DataDescription const& dataToAdd) = 0;
     virtual void setClusteredSimulationData(ClusteredDataDescription const& dataToUpdate) = 0;
     virtual void setSimulationData(DataDescription const& dataToUpdate) = 0;
+
+    //future-based variants, executed by the worker thread between timestep batches instead of
+    //stalling the caller at the access gate; a get-modify-set cycle can thereby overlap
+    //extraction, host-side processing and re-upload
+    virtual std::future<DataDescription> getSimulationData_async() = 0;
+    virtual std::future<void> setSimulationData_async(DataDescription dataToUpdate) = 0;
+    virtual std::future<void> calcSingleTimestep_async() = 0;
+
+    //raw snapshots write the transfer arrays directly to disk; fast but tied to the in-memory layout
+    virtual bool saveSimulationDataToFile(std::string const& filename) = 0;
+    virtual void saveSimulationDataToFile_async(std::string const& filename) = 0;    //disk write runs on a background thread
+    virtual bool loadSimulationDataFromFile(std::string const& filename) = 0;
+
+    //renders the given world section into an offscreen buffer and returns the pixels
+    //(imageSize.x * imageSize.y values in bbbbggggrrrr format, 3 x 16 bit lanes)
+    virtual std::vector<uint64_t>
+    getImageData(RealVector2D const& rectUpperLeft, RealVector2D const& rectLowerRight, IntVector2D const& imageSize, double zoom) = 0;
+
+    //renders a low-resolution thumbnail of the whole world from the density map maintained for
+    //the sensors (imageSize.x * imageSize.y values in bbbbggggrrrr format, 3 x 16 bit lanes);
+    //cheap enough to be polled periodically for the navigation minimap
+    virtual std::vector<uint64_t> getThumbnail(IntVector2D const& imageSize) = 0;
+
+    //renders the given world section into an offscreen buffer and writes a png file; the engine is
+    //only blocked for the render itself, the encoding and the disk write run on a background thread
+    virtual void saveSimulationImageToFile_async(
+        std::string const& filename,
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom) = 0;
+
+    //continuous timelapse capture: one numbered png frame of the given world section per
+    //timestep stride, rendered between timestep batches and encoded on a background thread;
+    //frames are dropped rather than slowing the simulation down when the encoder falls behind
+    virtual void startTimelapse(
+        std::string const& filenamePrefix,
+        RealVector2D const& rectUpperLeft,
+        RealVector2D const& rectLowerRight,
+        IntVector2D const& imageSize,
+        double zoom,
+        int timestepStride) = 0;
+    virtual void stopTimelapse() = 0;
+
     virtual void removeSelectedEntities(bool includeClusters) = 0;
     virtual void relaxSelectedEntities(bool includeClusters) = 0;
     virtual void uniformVelocitiesForSelectedEntities(bool includeClusters) = 0;
@@ -41,11 +115,61 @@ public:
     virtual void removeStickiness(bool includeClusters) = 0;
     virtual void setBarrier(bool value, bool includeClusters) = 0;
     virtual void colorSelectedEntities(unsigned char color, bool includeClusters) = 0;
+    virtual void scaleEnergyForSelectedEntities(float factor, bool includeClusters) = 0;
+    virtual void setBranchNumberForSelectedEntities(int branchNumber, bool includeClusters) = 0;
+
+    //recolors every cluster of the world with a random color from the given palette on the GPU
+    virtual void colorizeClusters(std::vector<int> const& colorCodes) = 0;
+
+    //batch primitive: adds the delta to the energy of every listed cell in one kernel pass
+    virtual void applyEnergyDeltaToCells(std::vector<uint64_t> const& cellIds, float energyDelta) = 0;
     virtual void reconnectSelectedEntities() = 0;
+    //executes several edit commands back-to-back within one access acquisition; macro-style
+    //editing scripts should prefer this over issuing the commands one by one, since each single
+    //command pays the fixed cost of gating the worker and synchronizing the GPU
+    virtual void executeEditBatch(std::vector<EditCommand> const& commands) = 0;
+    //duplicates the current selection on the GPU; much faster than extracting and re-adding the
+    //data for large patterns
+    virtual void cloneSelectedEntities(RealVector2D const& posDelta, bool includeClusters) = 0;
+    //stamps one transformed copy of the current selection per transform on the GPU; requires a
+    //cluster-complete selection, which afterwards covers the originals and all copies
+    virtual void replicateSelectedEntities(std::vector<ReplicationTransform> const& transforms, RealVector2D const& center) = 0;
+    //paints unconnected barrier cells along the stroke polyline directly on the GPU; far faster
+    //than uploading a description per brush move when authoring large maps. Stroke continuations
+    //pass paintFirstVertex = false so the cell at their starting point is not duplicated
+    virtual void drawBarrier(std::vector<RealVector2D> const& stroke, bool paintFirstVertex, float cellDistance, float energy, int colorCode) = 0;
+    //converts an image to a cell pattern entirely on the GPU: one cell per sufficiently bright
+    //pixel with the closest matching individual cell color, connected to its lattice neighbors
+    //and centered on the given world position; the created pattern takes over the selection.
+    //Building a per-pixel description on the host takes minutes for large images
+    virtual void convertImageToPattern(std::vector<unsigned char> const& imageData, int width, int height, int numChannels, RealVector2D const& center) = 0;
+    //seeds the world with randomly distributed cells and energy particles drawn from the spec,
+    //generated in place on the GPU; intended for freshly created (empty) worlds, where it replaces
+    //building and uploading a host-side description entity by entity
+    virtual void generateWorld(WorldGenerationSpec const& spec) = 0;
+    //freezes the simulation inside the given world rect: cells and particles in the zone are
+    //excluded from the physics and process stages of the timestep until the zone is cleared, so a
+    //cordoned-off area costs (almost) nothing in long runs; the zone does not alter world content
+    virtual void setFreezeZone(std::optional<RealRect> const& zone) = 0;
     virtual void changeCell(CellDescription const& changedCell) = 0;
     virtual void changeParticle(ParticleDescription const& changedParticle) = 0;
 
     virtual void calcSingleTimestep() = 0;
+
+    //executes several timesteps back-to-back with a single synchronization at the end
+    virtual void calcTimesteps(int numTimesteps) = 0;
+
+    //advances one timestep with every GPU kernel launched individually and timed via cuda
+    //events; far slower than calcSingleTimestep, only used by the benchmarks target
+    virtual std::vector<KernelTiming> benchmarkTimestep() = 0;
+
+    //opt-in profiling: while enabled, timesteps are calculated with the per-kernel timed launch
+    //path (considerably slower) and the times are accumulated per kernel; enabling resets the
+    //accumulated data
+    virtual void setKernelProfilingEnabled(bool enabled) = 0;
+    virtual bool isKernelProfilingEnabled() const = 0;
+    virtual KernelProfileData getKernelProfileData() const = 0;
+
     virtual void runSimulation() = 0;
     virtual void pauseSimulation() = 0;
 
@@ -54,6 +178,9 @@ public:
     virtual void closeSimulation() = 0;
 
     virtual uint64_t getCurrentTimestep() const = 0;
+
+    //incremented on every data manipulation; together with the timestep it identifies the world content
+    virtual uint64_t getWorldVersion() const = 0;
     virtual void setCurrentTimestep(uint64_t value) = 0;
 
     virtual SimulationParameters const& getSimulationParameters() const = 0;
@@ -69,6 +196,11 @@ public:
     virtual GpuSettings getOriginalGpuSettings() const = 0;
     virtual void setGpuSettings_async(GpuSettings const& gpuSettings) = 0;
 
+    //sweeps launch geometries (blocks / threads per block) against the live world for a few
+    //hundred timesteps each and adopts the fastest one; blocks the caller for the whole sweep
+    //and advances the simulation meanwhile
+    virtual GpuSettings autoTuneGpuSettings() = 0;
+
     virtual FlowFieldSettings getFlowFieldSettings() const = 0;
     virtual FlowFieldSettings getOriginalFlowFieldSettings() const = 0;
     virtual void setOriginalFlowFieldCenter(FlowCenter const& value, int index) = 0;
@@ -80,6 +212,10 @@ public:
     virtual void swapSelection(RealVector2D const& pos, float radius) = 0;
     virtual SelectionShallowData getSelectionShallowData() = 0;
     virtual void shallowUpdateSelectedEntities(ShallowUpdateSelectionData const& updateData) = 0;
+
+    //queues the update for the worker thread; successive deltas of the same kind are coalesced
+    //into a single GPU update, so this is the right variant for per-mouse-move drag events
+    virtual void shallowUpdateSelectedEntities_async(ShallowUpdateSelectionData const& updateData) = 0;
     virtual void setSelection(RealVector2D const& startPos, RealVector2D const& endPos) = 0;
     virtual void removeSelection() = 0;
     virtual bool updateSelectionIfNecessary() = 0;
@@ -92,8 +228,62 @@ public:
     virtual void setSymbolMap(SymbolMap const& symbolMap) = 0;
     virtual MonitorData getStatistics() const = 0;
 
+    //fast-forward mode: the GPU runs instrumentation-free timestep kernel variants (no process
+    //statistics, no sampled invariant checks) and the statistics are reduced to entity counts;
+    //intended for skipping ahead quickly, not for observing the world
+    virtual void setTurboMode(bool value) = 0;
+    virtual bool isTurboMode() const = 0;
+
+    //defines the user rects for the region-scoped statistics: the GPU reduces cell/token/energy
+    //metrics per region together with the global values and reports them in MonitorData::regions,
+    //behind one entry per parameter spot (its core area, without the fadeout zone)
+    virtual void setStatisticsRects(std::vector<RealRect> const& rects) = 0;
+
+    //returns the birth/death records accumulated since the last call in chronological order; the
+    //stream is lossy under extreme churn (ring buffer semantics), so it suits visualization and
+    //lineage sampling but not exact accounting
+    virtual std::vector<CellEvent> retrieveCellEvents() = 0;
+
+    //optional lineage tracking: while enabled, every constructed cell contributes a replication
+    //record (child id, constructing cell id, lineage founder id, timestep), from which ancestry
+    //trees are assembled on the host without snapshot diffing; same lossy ring semantics as the
+    //cell events
+    virtual void setLineageTrackingEnabled(bool enabled) = 0;
+    virtual std::vector<LineageRecord> retrieveLineageRecords() = 0;
+
+    //order-independent 64-bit hash over the world state (entity ids, quantized positions and
+    //connections), computed on the GPU; much cheaper than downloading and comparing the full
+    //world state when checking two checkpoints for equality
+    virtual uint64_t calcWorldHash() = 0;
+
+    //snapshot of the GPU memory situation: acquired and peak bytes, free device memory, a
+    //per-array breakdown of the entity arrays and a forecast of the next resize
+    virtual GpuMemoryInfo getGpuMemoryInfo() = 0;
+
+    //latency telemetry (p50/p95/p99 of the per-timestep wall time, the engine access wait time
+    //and the TO transfer time) as a json document; a summary is also logged periodically
+    virtual std::string getTelemetryJson() const = 0;
+
+    //publishes the statistics, latency percentiles and entity array fill levels into the
+    //shared-memory segment LiveTelemetryChannelName at the monitor cadence, so external
+    //exporters (e.g. Prometheus) can scrape them without log parsing; see LiveTelemetrySnapshot
+    //for the binary layout and the seqlock read protocol
+    virtual void setLiveTelemetryEnabled(bool enabled) = 0;
+
     virtual std::optional<int> getTpsRestriction() const = 0;
     virtual void setTpsRestriction(std::optional<int> const& value) = 0;
 
+    //display refresh rate for the engine's timestep/render governor: timestep batches are sized
+    //to finish before the next expected frame request and late render requests fall back to the
+    //last completed frame; 0 disables the governor
+    virtual void setFramesPerSecond(int value) = 0;
+
+    //rolling in-memory checkpoint ring: while enabled the engine keeps host-side copies of the
+    //entity arrays every <timesteps> steps, so recent moments can be rewound to without disk
+    //access; 0 disables checkpointing and clears the ring
+    virtual void setCheckpointInterval(int timesteps) = 0;
+    virtual std::vector<uint64_t> getCheckpointTimesteps() const = 0;
+    virtual std::optional<uint64_t> rewindToLastCheckpoint() = 0;  //returns the restored timestep
+
     virtual float getTps() const = 0;
 };
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "Base/Definitions.h"
+
+//compact statistics of a saved simulation, written as a .meta.json sidecar next to the content
+//file so that cataloging tools can index a save without reading and decompressing the content
+struct SimulationFileMetadata
+{
+    uint64_t timestep = 0;
+    IntVector2D worldSize;
+    int numClusters = 0;
+    int numCells = 0;
+    int numParticles = 0;
+    int numTokens = 0;
+    int numCellsByColor[7] = {0, 0, 0, 0, 0, 0, 0};
+    RealRect boundingBox;    //of all cells and particles; empty world => zero rect
+};
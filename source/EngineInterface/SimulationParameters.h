@@ -43,6 +43,10 @@ struct SimulationParameters
     float radiationVelocityMultiplier = 1.0f;
     float radiationVelocityPerturbation = 0.5f;
 
+    //maximum timestep stride for energy particles in cell-free sectors: such particles integrate
+    //only every stride-th timestep with scaled dt; 1 disables subcycling
+    int particleSubcyclingStride = 4;
+
     bool operator==(SimulationParameters const& other) const
     {
         return spotValues == other.spotValues && timestepSize == other.timestepSize && cellMaxVel == other.cellMaxVel
@@ -73,6 +77,7 @@ struct SimulationParameters
             && radiationExponent == other.radiationExponent && radiationProb == other.radiationProb
             && radiationVelocityMultiplier == other.radiationVelocityMultiplier
             && radiationVelocityPerturbation == other.radiationVelocityPerturbation
+            && particleSubcyclingStride == other.particleSubcyclingStride
             && cellRepulsionStrength == other.cellRepulsionStrength;
     }
 
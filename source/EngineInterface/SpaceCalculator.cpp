@@ -1,5 +1,6 @@
 #include "SpaceCalculator.h"
 
+#include <algorithm>
 #include <cmath>
 
 #include "Base/Math.h"
@@ -41,3 +42,45 @@ RealVector2D SpaceCalculator::getCorrectedPosition(RealVector2D const& pos) cons
     correctPosition(result);
     return result;
 }
+
+RealVector2D SpaceCalculator::getCorrectedDisplacement(RealVector2D const& displacement) const
+{
+    auto result = displacement;
+    correctDisplacement(result);
+    return result;
+}
+
+RealVector2D SpaceCalculator::calcCenter(std::vector<RealVector2D> const& positions) const
+{
+    if (positions.empty()) {
+        return RealVector2D();
+    }
+
+    //mean of the displacements from a common anchor; for spans which do not wrap this equals the
+    //plain mean of the positions
+    auto const& anchor = positions.front();
+    RealVector2D displacementSum;
+    for (auto const& position : positions) {
+        displacementSum += getCorrectedDisplacement(position - anchor);
+    }
+    return getCorrectedPosition(anchor + displacementSum / toFloat(positions.size()));
+}
+
+RealRect SpaceCalculator::calcBoundingBox(std::vector<RealVector2D> const& positions) const
+{
+    if (positions.empty()) {
+        return RealRect();
+    }
+
+    auto const& anchor = positions.front();
+    RealVector2D min;
+    RealVector2D max;
+    for (auto const& position : positions) {
+        auto displacement = getCorrectedDisplacement(position - anchor);
+        min.x = std::min(min.x, displacement.x);
+        min.y = std::min(min.y, displacement.y);
+        max.x = std::max(max.x, displacement.x);
+        max.y = std::max(max.y, displacement.y);
+    }
+    return RealRect{anchor + min, anchor + max};
+}
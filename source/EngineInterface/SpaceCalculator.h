@@ -10,6 +10,14 @@ public:
     float distance(RealVector2D const& a, RealVector2D const& b) const;
 
     RealVector2D getCorrectedPosition(RealVector2D const& pos) const;
+    RealVector2D getCorrectedDisplacement(RealVector2D const& displacement) const;
+
+    //bulk operations for the host-side pattern tools: a whole span of positions is processed in
+    //one pass with the wraparound corrected against a common anchor, so spans which straddle the
+    //torus seam yield a center close to the cells and a tight bounding box instead of values
+    //spanning the entire world
+    RealVector2D calcCenter(std::vector<RealVector2D> const& positions) const;
+    RealRect calcBoundingBox(std::vector<RealVector2D> const& positions) const;
 
 private:
     void correctDisplacement(RealVector2D& displacement) const;
@@ -0,0 +1,28 @@
+#pragma once
+
+//distribution spec for device-side procedural world seeding (see
+//_SimulationController::generateWorld): instead of building a per-entity description on the host
+//and pushing it through the converter path, a generation kernel instantiates the entities in
+//place from this spec, which populates even huge worlds in seconds
+struct WorldGenerationSpec
+{
+    //average number of seed cells resp. energy particles per world pixel
+    float cellDensity = 0.02f;
+    float particleDensity = 0.02f;
+
+    //relative mix of the seven individual cell colors; the particle colors follow the same mix.
+    //Entries that sum to zero fall back to color 0
+    float colorRatios[7] = {1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f, 1.0f};
+
+    //cell energies are drawn uniformly from [minCellEnergy, maxCellEnergy]
+    float minCellEnergy = 50.0f;
+    float maxCellEnergy = 200.0f;
+    float particleEnergy = 50.0f;
+
+    //velocity components are drawn uniformly from [-maxVelocity, maxVelocity]
+    float maxVelocity = 0.5f;
+
+    //encloses the world with a rectangular frame of barrier cells spaced one unit apart
+    bool borderBarrier = false;
+    float barrierEnergy = 100.0f;
+};
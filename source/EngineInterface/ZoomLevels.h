@@ -5,4 +5,16 @@ namespace Const
     int const ZoomLevelForAutomaticEditorSwitch = 32;
     int const ZoomLevelForAutomaticVectorViewSwitch = 2;
     int const MinZoomLevelForEditor = 4;
+
+    //below this zoom the cells are plain dots without connection lines and the tile-based
+    //renderer is used
+    float const ZoomLevelForTileRendering = 1.0f;
+
+    //below this zoom a pixel covers at least one slot of the density map and the cells are
+    //rendered from the density map instead of being iterated
+    float const ZoomLevelForDensityLodRendering = 0.125f;
+
+    //below this zoom a pixel covers at least one coarse slot of the density map and the renderer
+    //samples the pre-aggregated coarse level instead of every base slot
+    float const ZoomLevelForCoarseDensityLodRendering = 0.03125f;
 }
\ No newline at end of file
@@ -426,3 +426,79 @@ TEST_F(CellComputationTests, divisionByZero)
     auto data = runSimpleCellComputer(program);
     EXPECT_EQ(0, data.at(1));
 }
+
+TEST_F(CellComputationTests, optimizationConstantFolding)
+{
+    std::string program = "mov [1], 1\n"
+                     "add [1], 2\n"
+                     "mul [1], 3";
+    auto symbols = _simController->getSymbolMap();
+    auto parameters = _simController->getSimulationParameters();
+    auto compiledProgram = CellComputationCompiler::compileSourceCode(program, symbols, parameters);
+    EXPECT_TRUE(compiledProgram.compilationOk);
+    EXPECT_EQ(3, compiledProgram.compilation.size());  //folded to a single mov
+
+    auto data = runSimpleCellComputer(program);
+    EXPECT_EQ(9, data.at(1));
+}
+
+TEST_F(CellComputationTests, optimizationDeadStoreElimination)
+{
+    std::string program = "mov [1], 3\n"
+                     "mov [1], 5";
+    auto symbols = _simController->getSymbolMap();
+    auto parameters = _simController->getSimulationParameters();
+    auto compiledProgram = CellComputationCompiler::compileSourceCode(program, symbols, parameters);
+    EXPECT_TRUE(compiledProgram.compilationOk);
+    EXPECT_EQ(3, compiledProgram.compilation.size());
+
+    auto data = runSimpleCellComputer(program);
+    EXPECT_EQ(5, data.at(1));
+}
+
+TEST_F(CellComputationTests, optimizationKeepsStoreReadByIndirection)
+{
+    //the second instruction reads [1] through the indirection => the first store must survive
+    std::string program = "mov [1], 3\n"
+                     "mov [[1]], 5";
+    auto symbols = _simController->getSymbolMap();
+    auto parameters = _simController->getSimulationParameters();
+    auto compiledProgram = CellComputationCompiler::compileSourceCode(program, symbols, parameters);
+    EXPECT_TRUE(compiledProgram.compilationOk);
+    EXPECT_EQ(6, compiledProgram.compilation.size());
+}
+
+TEST_F(CellComputationTests, optimizationKeepsConditionalStores)
+{
+    //stores inside a conditional execute only sometimes => nothing may be folded across it
+    std::string program = "mov [1], 1\n"
+                     "if [1] = 1\n"
+                     "add [1], 2\n"
+                     "endif";
+    auto symbols = _simController->getSymbolMap();
+    auto parameters = _simController->getSimulationParameters();
+    auto compiledProgram = CellComputationCompiler::compileSourceCode(program, symbols, parameters);
+    EXPECT_TRUE(compiledProgram.compilationOk);
+    EXPECT_EQ(12, compiledProgram.compilation.size());
+
+    auto data = runSimpleCellComputer(program);
+    EXPECT_EQ(3, data.at(1));
+}
+
+TEST_F(CellComputationTests, bulkCompilationStampsAllCells)
+{
+    std::string program = "mov [1], 0x2a";
+    auto symbols = _simController->getSymbolMap();
+    auto parameters = _simController->getSimulationParameters();
+
+    std::vector<CellDescription> cells(3);
+    std::vector<CellDescription*> cellPointers;
+    for (auto& cell : cells) {
+        cellPointers.emplace_back(&cell);
+    }
+    auto compiledProgram = CellComputationCompiler::compileSourceCode(program, symbols, parameters, cellPointers);
+    EXPECT_TRUE(compiledProgram.compilationOk);
+    for (auto const& cell : cells) {
+        EXPECT_EQ(compiledProgram.compilation, cell.cellFeature.constData);
+    }
+}
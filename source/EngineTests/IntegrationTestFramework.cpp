@@ -2,21 +2,49 @@
 
 #include "Base/NumberGenerator.h"
 #include "EngineInterface/SimulationParameters.h"
+#include "EngineInterface/SimulationParametersSpots.h"
 #include "EngineImpl/SimulationControllerImpl.h"
 
+SimulationController IntegrationTestFramework::_sharedSimController;
+IntVector2D IntegrationTestFramework::_sharedUniverseSize;
+
 IntegrationTestFramework::IntegrationTestFramework(IntVector2D const& universeSize)
 {
+    if (_sharedSimController && _sharedUniverseSize == universeSize) {
+        _simController = _sharedSimController;
+
+        //restore the pristine state a freshly created simulation would have; tests may have
+        //changed the parameters or advanced the timestep
+        _simController->clear();
+        _simController->setCurrentTimestep(0);
+        _simController->setSimulationParameters_async(SimulationParameters());
+        _simController->setSimulationParametersSpots_async(SimulationParametersSpots());
+        return;
+    }
+    shutdownSharedEngine();
+
     _simController = std::make_shared<_SimulationControllerImpl>();
     Settings settings;
     settings.generalSettings.worldSizeX = universeSize.x;
     settings.generalSettings.worldSizeY = universeSize.y;
     SymbolMap symbolMap;
     _simController->newSimulation(0, settings, symbolMap);
+
+    _sharedSimController = _simController;
+    _sharedUniverseSize = universeSize;
 }
 
 IntegrationTestFramework::~IntegrationTestFramework()
 {
-    _simController->closeSimulation();
+    //the engine stays initialized for the next fixture, see shutdownSharedEngine
+}
+
+void IntegrationTestFramework::shutdownSharedEngine()
+{
+    if (_sharedSimController) {
+        _sharedSimController->closeSimulation();
+        _sharedSimController.reset();
+    }
 }
 
 TokenDescription IntegrationTestFramework::createSimpleToken() const
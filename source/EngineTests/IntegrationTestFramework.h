@@ -12,9 +12,19 @@ public:
     IntegrationTestFramework(IntVector2D const& universeSize);
     virtual ~IntegrationTestFramework();
 
+    //closes the engine shared across the fixtures; called once after all tests have run
+    static void shutdownSharedEngine();
+
 protected:
     TokenDescription createSimpleToken() const;
     std::unordered_map<uint64_t, CellDescription> getCellById(DataDescription const& data) const;
 
     SimulationController _simController;
+
+private:
+    //one engine instance (CUDA context, device arrays) is shared across the fixtures and only
+    //recreated when a test requires a different world size, so the seconds of CUDA setup per
+    //fixture become a one-off cost per world size; the per-test reset is a GPU-side clear
+    static SimulationController _sharedSimController;
+    static IntVector2D _sharedUniverseSize;
 };
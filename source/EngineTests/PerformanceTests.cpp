@@ -0,0 +1,148 @@
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "EngineInterface/Serializer.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+//performance regression tests: a curated corpus of example worlds is run at steady state and the
+//measured TPS is compared against a per-machine baseline file with tolerance; on the first run
+//(or for new corpus entries) the measured value is recorded as baseline and the test is skipped,
+//since absolute TPS numbers are not comparable between machines
+class PerformanceTests : public ::testing::Test
+{
+public:
+    static auto constexpr NumWarmupTimesteps = 100;
+    static auto constexpr NumMeasuredTimesteps = 500;
+    static auto constexpr Tolerance = 0.15;  //run-to-run jitter on a busy machine stays well below this
+
+protected:
+    void runCorpusEntry(std::string const& name, std::string const& relativeFilename);
+
+private:
+    std::optional<std::string> resolveCorpusFilename(std::string const& relativeFilename) const;
+    double measureTps(DeserializedSimulation const& simulationData) const;
+
+    static std::string const& getBaselineFilename();
+    static std::optional<double> readBaseline(std::string const& name);
+    static void writeBaseline(std::string const& name, double tps);
+};
+
+void PerformanceTests::runCorpusEntry(std::string const& name, std::string const& relativeFilename)
+{
+    auto filename = resolveCorpusFilename(relativeFilename);
+    if (!filename) {
+        GTEST_SKIP() << "corpus file '" << relativeFilename << "' not available";
+    }
+
+    DeserializedSimulation simulationData;
+    try {
+        if (!Serializer::deserializeSimulationFromFiles(simulationData, *filename)) {
+            GTEST_SKIP() << "corpus file '" << *filename << "' could not be read";
+        }
+    } catch (std::exception const&) {
+        GTEST_SKIP() << "corpus file '" << *filename << "' could not be read";
+    }
+
+    auto tps = measureTps(simulationData);
+
+    auto baseline = readBaseline(name);
+    if (!baseline) {
+        writeBaseline(name, tps);
+        GTEST_SKIP() << "no baseline for '" << name << "': recorded " << tps << " TPS";
+    }
+    EXPECT_GE(tps, *baseline * (1.0 - Tolerance)) << "'" << name << "' dropped below baseline of " << *baseline << " TPS";
+}
+
+std::optional<std::string> PerformanceTests::resolveCorpusFilename(std::string const& relativeFilename) const
+{
+    //the tests may be started from the build directory or from the repository root
+    for (auto const& root : {std::string(), std::string("../"), std::string("../../")}) {
+        auto candidate = root + relativeFilename;
+        if (std::filesystem::exists(candidate)) {
+            return candidate;
+        }
+    }
+    return std::nullopt;
+}
+
+double PerformanceTests::measureTps(DeserializedSimulation const& simulationData) const
+{
+    auto simController = std::make_shared<_SimulationControllerImpl>();
+    simController->newSimulation(simulationData.timestep, simulationData.settings, simulationData.symbolMap);
+    simController->setClusteredSimulationData(simulationData.content);
+
+    simController->calcTimesteps(NumWarmupTimesteps);
+
+    auto startTimepoint = std::chrono::steady_clock::now();
+    simController->calcTimesteps(NumMeasuredTimesteps);
+    auto durationInUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+
+    simController->closeSimulation();
+    return static_cast<double>(NumMeasuredTimesteps) * 1000000.0 / static_cast<double>(durationInUs);
+}
+
+std::string const& PerformanceTests::getBaselineFilename()
+{
+    static std::string const result = "performanceBaselines.json";
+    return result;
+}
+
+std::optional<double> PerformanceTests::readBaseline(std::string const& name)
+{
+    if (!std::filesystem::exists(getBaselineFilename())) {
+        return std::nullopt;
+    }
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(getBaselineFilename(), tree);
+    if (auto baseline = tree.get_optional<double>(boost::property_tree::path(name, '/'))) {
+        return *baseline;
+    }
+    return std::nullopt;
+}
+
+void PerformanceTests::writeBaseline(std::string const& name, double tps)
+{
+    boost::property_tree::ptree tree;
+    if (std::filesystem::exists(getBaselineFilename())) {
+        boost::property_tree::read_json(getBaselineFilename(), tree);
+    }
+    tree.put(boost::property_tree::path(name, '/'), tps);
+    boost::property_tree::write_json(getBaselineFilename(), tree);
+}
+
+TEST_F(PerformanceTests, smallWorld)
+{
+    runCorpusEntry("small world", "examples/simulations/physics/Soft Balls.sim");
+}
+
+TEST_F(PerformanceTests, mediumWorld)
+{
+    runCorpusEntry("medium world", "examples/simulations/evolution/Hexagons.sim");
+}
+
+TEST_F(PerformanceTests, largeWorld)
+{
+    runCorpusEntry("large world", "examples/simulations/demos/Dark Forest.sim");
+}
+
+TEST_F(PerformanceTests, tokenHeavyWorld)
+{
+    runCorpusEntry("token-heavy world", "examples/simulations/evolution/Loops.sim");
+}
+
+TEST_F(PerformanceTests, clusterHeavyWorld)
+{
+    runCorpusEntry("cluster-heavy world", "examples/simulations/physics/Sand Stones.sim");
+}
+
+TEST_F(PerformanceTests, particleHeavyWorld)
+{
+    runCorpusEntry("particle-heavy world", "examples/simulations/physics/Complex Fluids.sim");
+}
@@ -0,0 +1,123 @@
+#include <algorithm>
+#include <cstring>
+
+#include <gtest/gtest.h>
+
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+//replay tests verify the deterministic mode: the same initial world must evolve to the same state
+//on every run; unlike the other integration tests a fresh simulation controller is created per run,
+//since the random number streams are seeded at simulation creation
+class ReplayTests : public ::testing::Test
+{
+public:
+    static auto constexpr UniverseSize = 200;
+    static auto constexpr NumTimesteps = 50;
+
+protected:
+    DataDescription createWorld() const;
+    SimulationController runSimulation(DataDescription const& world, int numTimesteps) const;
+    uint64_t runAndGetWorldHash(DataDescription const& world, int numTimesteps) const;
+
+private:
+    uint64_t calcWorldHash(DataDescription const& data) const;
+};
+
+DataDescription ReplayTests::createWorld() const
+{
+    return DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters()
+                                             .width(20)
+                                             .height(20)
+                                             .center({toFloat(UniverseSize) / 2, toFloat(UniverseSize) / 2}));
+}
+
+SimulationController ReplayTests::runSimulation(DataDescription const& world, int numTimesteps) const
+{
+    Settings settings;
+    settings.generalSettings.worldSizeX = UniverseSize;
+    settings.generalSettings.worldSizeY = UniverseSize;
+    settings.gpuSettings.deterministicMode = true;
+    SymbolMap symbolMap;
+
+    auto simController = std::make_shared<_SimulationControllerImpl>();
+    simController->newSimulation(0, settings, symbolMap);
+    simController->setSimulationData(world);
+    simController->calcTimesteps(numTimesteps);
+    return simController;
+}
+
+uint64_t ReplayTests::runAndGetWorldHash(DataDescription const& world, int numTimesteps) const
+{
+    auto simController = runSimulation(world, numTimesteps);
+    auto result = calcWorldHash(simController->getSimulationData());
+    simController->closeSimulation();
+    return result;
+}
+
+uint64_t ReplayTests::calcWorldHash(DataDescription const& data) const
+{
+    uint64_t result = 0;
+    auto combine = [&result](uint64_t value) { result ^= value + 0x9e3779b97f4a7c15ull + (result << 6) + (result >> 2); };
+    auto combineReal = [&combine](double value) {
+        uint64_t raw = 0;
+        std::memcpy(&raw, &value, sizeof(value));
+        combine(raw);
+    };
+
+    //the descriptions are sorted by id beforehand, since the download order depends on the
+    //in-memory order of the entities, which is not part of the observable world state
+    auto cells = data.cells;
+    std::sort(cells.begin(), cells.end(), [](auto const& left, auto const& right) { return left.id < right.id; });
+    for (auto const& cell : cells) {
+        combine(cell.id);
+        combineReal(cell.pos.x);
+        combineReal(cell.pos.y);
+        combineReal(cell.vel.x);
+        combineReal(cell.vel.y);
+        combineReal(cell.energy);
+        for (auto const& connection : cell.connections) {
+            combine(connection.cellId);
+            combineReal(connection.distance);
+            combineReal(connection.angleFromPrevious);
+        }
+    }
+
+    auto particles = data.particles;
+    std::sort(particles.begin(), particles.end(), [](auto const& left, auto const& right) { return left.id < right.id; });
+    for (auto const& particle : particles) {
+        combine(particle.id);
+        combineReal(particle.pos.x);
+        combineReal(particle.pos.y);
+        combineReal(particle.vel.x);
+        combineReal(particle.vel.y);
+        combineReal(particle.energy);
+    }
+    return result;
+}
+
+TEST_F(ReplayTests, identicalWorldHashAfterReplay)
+{
+    auto world = createWorld();
+
+    auto firstHash = runAndGetWorldHash(world, NumTimesteps);
+    auto secondHash = runAndGetWorldHash(world, NumTimesteps);
+
+    EXPECT_EQ(firstHash, secondHash);
+}
+
+TEST_F(ReplayTests, identicalGpuWorldHashAfterReplay)
+{
+    auto world = createWorld();
+
+    auto firstController = runSimulation(world, NumTimesteps);
+    auto firstHash = firstController->calcWorldHash();
+    firstController->closeSimulation();
+
+    auto secondController = runSimulation(world, NumTimesteps);
+    auto secondHash = secondController->calcWorldHash();
+    secondController->closeSimulation();
+
+    EXPECT_EQ(firstHash, secondHash);
+}
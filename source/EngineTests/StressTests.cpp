@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <boost/property_tree/json_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/DescriptionHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SimulationParameters.h"
+#include "EngineImpl/SimulationControllerImpl.h"
+
+//structural-churn stress benchmark: a synthesized world engineered to maximize connect/disconnect
+//rates, token branching and mass death, i.e. the pressure on CellConnectionProcessor and the
+//operation queues. Churn storms are the worst production scenario and no corpus entry reproduces
+//them reliably, so the scenario is generated instead of loaded from a file. Besides the
+//throughput, the per-timestep latency spread is measured, since churn shows up as latency spikes
+//long before the average drops. Both metrics use the same per-machine baseline file and
+//skip-on-first-run scheme as the corpus-based performance tests
+class StressTests : public ::testing::Test
+{
+public:
+    static auto constexpr UniverseSize = 512;
+    static auto constexpr NumClusters = 3000;
+    static auto constexpr NumWarmupTimesteps = 100;
+    static auto constexpr NumMeasuredTimesteps = 500;
+    static auto constexpr TpsTolerance = 0.15;
+    static auto constexpr SpikeTolerance = 0.5;  //the maximum latency jitters much more than the throughput
+
+protected:
+    DataDescription createChurnWorld(SimulationParameters const& parameters) const;
+
+    static std::string const& getBaselineFilename();
+    static std::optional<double> readBaseline(std::string const& name);
+    static void writeBaseline(std::string const& name, double value);
+};
+
+DataDescription StressTests::createChurnWorld(SimulationParameters const& parameters) const
+{
+    //small clusters with round-robin branch numbers: a token branches at every cell with several
+    //successors, and colliding clusters fuse into aggregates which the physics tears apart again
+    auto seed = DescriptionHelper::createRect(DescriptionHelper::CreateRectParameters().width(3).height(3));
+    for (int i = 0; i < toInt(seed.cells.size()); ++i) {
+        seed.cells.at(i).tokenBranchNumber = i % parameters.cellMaxTokenBranchNumber;
+    }
+    auto token =
+        TokenDescription().setEnergy(parameters.tokenMinEnergy * 2).setData(std::string(parameters.tokenMemorySize, 0));
+    seed.cells.at(0).addToken(token);
+
+    auto overlappingCheckSuccessful = true;  //no overlapping check: collisions are the point here
+    return DescriptionHelper::randomMultiply(
+        seed,
+        DescriptionHelper::RandomMultiplyParameters()
+            .number(NumClusters)
+            .minVelX(-1.0f)
+            .maxVelX(1.0f)
+            .minVelY(-1.0f)
+            .maxVelY(1.0f)
+            .minAngularVel(-10.0f)
+            .maxAngularVel(10.0f),
+        {UniverseSize, UniverseSize},
+        DataDescription(),
+        overlappingCheckSuccessful);
+}
+
+TEST_F(StressTests, structuralChurn)
+{
+    auto simController = std::make_shared<_SimulationControllerImpl>();
+    Settings settings;
+    settings.generalSettings.worldSizeX = UniverseSize;
+    settings.generalSettings.worldSizeY = UniverseSize;
+    SymbolMap symbolMap;
+    simController->newSimulation(0, settings, symbolMap);
+
+    auto parameters = simController->getSimulationParameters();
+    parameters.spotValues.cellFusionVelocity = 0.2f;  //almost every collision connects
+    parameters.spotValues.cellMaxForce = 0.3f;        //and moderate stress tears the aggregates apart again
+    parameters.spotValues.cellMinEnergy = 80.0f;      //close to the initial cell energy => steady mass death
+    parameters.spotValues.radiationFactor = 0.002f;   //drains the cells towards the death threshold
+    simController->setSimulationParameters_async(parameters);
+    simController->setSimulationData(createChurnWorld(parameters));
+
+    simController->calcTimesteps(NumWarmupTimesteps);
+
+    //verify that the scenario produces the churn it is supposed to; without this check the
+    //benchmark could silently degenerate into an ordinary physics benchmark
+    auto numStructuralEvents = 0;
+    for (int i = 0; i < 20; ++i) {
+        simController->calcSingleTimestep();
+        auto statistics = simController->getStatistics();
+        numStructuralEvents += statistics.numCreatedConnections + statistics.numDestroyedConnections + statistics.numDeletedCells;
+    }
+    ASSERT_GT(numStructuralEvents, 0) << "the stress world produced no structural operations";
+
+    std::vector<double> latenciesInUs;
+    latenciesInUs.reserve(NumMeasuredTimesteps);
+    auto startTimepoint = std::chrono::steady_clock::now();
+    for (int i = 0; i < NumMeasuredTimesteps; ++i) {
+        auto stepTimepoint = std::chrono::steady_clock::now();
+        simController->calcSingleTimestep();
+        latenciesInUs.emplace_back(static_cast<double>(
+            std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - stepTimepoint).count()));
+    }
+    auto durationInUs =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - startTimepoint).count();
+    simController->closeSimulation();
+
+    auto tps = static_cast<double>(NumMeasuredTimesteps) * 1000000.0 / static_cast<double>(durationInUs);
+
+    //spike factor: worst timestep relative to the median; a growing value means the operation
+    //processing stalls under churn although the average throughput may still look fine
+    std::nth_element(latenciesInUs.begin(), latenciesInUs.begin() + NumMeasuredTimesteps / 2, latenciesInUs.end());
+    auto medianLatencyInUs = latenciesInUs.at(NumMeasuredTimesteps / 2);
+    auto maxLatencyInUs = *std::max_element(latenciesInUs.begin(), latenciesInUs.end());
+    auto spikeFactor = maxLatencyInUs / medianLatencyInUs;
+
+    auto tpsBaseline = readBaseline("stressChurn/tps");
+    auto spikeBaseline = readBaseline("stressChurn/latencySpikeFactor");
+    if (!tpsBaseline || !spikeBaseline) {
+        writeBaseline("stressChurn/tps", tps);
+        writeBaseline("stressChurn/latencySpikeFactor", spikeFactor);
+        GTEST_SKIP() << "no baseline for 'stressChurn': recorded " << tps << " TPS, spike factor " << spikeFactor;
+    }
+    EXPECT_GE(tps, *tpsBaseline * (1.0 - TpsTolerance)) << "'stressChurn' dropped below baseline of " << *tpsBaseline << " TPS";
+    EXPECT_LE(spikeFactor, *spikeBaseline * (1.0 + SpikeTolerance))
+        << "'stressChurn' latency spike factor exceeded baseline of " << *spikeBaseline;
+}
+
+std::string const& StressTests::getBaselineFilename()
+{
+    //shared with the corpus-based performance tests; the stress entries live under their own key
+    static std::string const result = "performanceBaselines.json";
+    return result;
+}
+
+std::optional<double> StressTests::readBaseline(std::string const& name)
+{
+    if (!std::filesystem::exists(getBaselineFilename())) {
+        return std::nullopt;
+    }
+    boost::property_tree::ptree tree;
+    boost::property_tree::read_json(getBaselineFilename(), tree);
+    if (auto baseline = tree.get_optional<double>(boost::property_tree::path(name, '/'))) {
+        return *baseline;
+    }
+    return std::nullopt;
+}
+
+void StressTests::writeBaseline(std::string const& name, double value)
+{
+    boost::property_tree::ptree tree;
+    if (std::filesystem::exists(getBaselineFilename())) {
+        boost::property_tree::read_json(getBaselineFilename(), tree);
+    }
+    tree.put(boost::property_tree::path(name, '/'), value);
+    boost::property_tree::write_json(getBaselineFilename(), tree);
+}
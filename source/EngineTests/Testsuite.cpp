@@ -1,7 +1,13 @@
 #include <gtest/gtest.h>
 
+#include "IntegrationTestFramework.h"
+
 int main(int argc, char** argv)
 {
     ::testing::InitGoogleTest(&argc, argv);
-    return RUN_ALL_TESTS();
+    auto result = RUN_ALL_TESTS();
+
+    //release the engine shared across the integration test fixtures before process teardown
+    IntegrationTestFramework::shutdownSharedEngine();
+    return result;
 }
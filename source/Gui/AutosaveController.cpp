@@ -1,11 +1,145 @@
 #include "AutosaveController.h"
 
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
 #include <imgui.h>
+#include <zstr.hpp>
 
 #include "Base/Resources.h"
 #include "EngineInterface/Serializer.h"
 #include "GlobalSettings.h"
 
+namespace
+{
+    //tiered retention for the autosave history: every save is kept for an hour, hourly saves for
+    //a day and daily saves beyond that
+    auto constexpr KeepEverySaveFor = std::chrono::hours(1);
+    auto constexpr KeepHourlySavesFor = std::chrono::hours(24);
+
+    auto constexpr SidecarExtensions = {".settings.json", ".symbols.json"};
+
+    //strips a trailing ".gz" so that the sidecars of a compressed archive are found as well
+    std::filesystem::path baseSimFilename(std::filesystem::path const& filename)
+    {
+        auto result = filename;
+        if (result.extension() == ".gz") {
+            result.replace_extension();
+        }
+        return result;
+    }
+
+    void removeArchivedSave(std::filesystem::path const& filename)
+    {
+        std::error_code errorCode;
+        std::filesystem::remove(filename, errorCode);
+        for (auto const& extension : SidecarExtensions) {
+            auto sidecar = baseSimFilename(filename);
+            sidecar.replace_extension(std::filesystem::path(extension));
+            std::filesystem::remove(sidecar, errorCode);
+        }
+    }
+
+    //recompresses an archived raw snapshot into a gzip container; old tiers are rarely restored,
+    //so trading decompression on a restore for disk space is worthwhile
+    void compressArchivedSave(std::filesystem::path const& filename)
+    {
+        auto compressedFilename = filename;
+        compressedFilename += ".gz";
+        {
+            std::ifstream input(filename, std::ios::binary);
+            if (!input) {
+                return;
+            }
+            zstr::ofstream output(compressedFilename.string(), std::ios::binary);
+            if (!output) {
+                return;
+            }
+            output << input.rdbuf();
+        }
+        std::error_code errorCode;
+        std::filesystem::remove(filename, errorCode);
+    }
+
+    //runs on the background IO thread: copies the current autosave into the history directory
+    //under a timestamped name, then applies the tiered retention and the recompression
+    void archiveAndPrune()
+    {
+        namespace fs = std::filesystem;
+        std::error_code errorCode;
+        fs::create_directories(Const::AutosaveDirectory, errorCode);
+
+        //archive the current autosave; thanks to the tmp-and-rename writes the copy is a
+        //consistent snapshot even while the next save is in flight
+        if (fs::exists(Const::AutosaveFile, errorCode)) {
+            auto time = std::time(nullptr);
+            std::stringstream stamp;
+            stamp << "autosave_" << std::put_time(std::localtime(&time), "%Y%m%d-%H%M%S");
+            auto archivedFilename = fs::path(Const::AutosaveDirectory) / (stamp.str() + ".sim");
+            fs::copy_file(Const::AutosaveFile, archivedFilename, fs::copy_options::overwrite_existing, errorCode);
+            for (auto const& extension : SidecarExtensions) {
+                auto source = fs::path(Const::AutosaveFile);
+                source.replace_extension(fs::path(extension));
+                auto target = archivedFilename;
+                target.replace_extension(fs::path(extension));
+                if (fs::exists(source, errorCode)) {
+                    fs::copy_file(source, target, fs::copy_options::overwrite_existing, errorCode);
+                }
+            }
+        }
+
+        //tiered retention: bucket each archived save by age (per save, per hour, per day) and
+        //keep only the newest save of each bucket
+        struct ArchivedSave
+        {
+            fs::path filename;
+            fs::file_time_type writeTime;
+        };
+        std::map<std::pair<int, int64_t>, ArchivedSave> keptSaves;
+        auto now = fs::file_time_type::clock::now();
+        int uniqueBucket = 0;
+        for (auto const& entry : fs::directory_iterator(Const::AutosaveDirectory, errorCode)) {
+            auto const& filename = entry.path();
+            if (filename.filename().string().rfind("autosave_", 0) != 0 || baseSimFilename(filename).extension() != ".sim") {
+                continue;
+            }
+            auto writeTime = fs::last_write_time(filename, errorCode);
+            if (errorCode) {
+                continue;
+            }
+            auto age = now - writeTime;
+            std::pair<int, int64_t> bucket;
+            if (age < KeepEverySaveFor) {
+                bucket = {0, uniqueBucket++};
+            } else if (age < KeepHourlySavesFor) {
+                bucket = {1, std::chrono::duration_cast<std::chrono::hours>(writeTime.time_since_epoch()).count()};
+            } else {
+                bucket = {2, std::chrono::duration_cast<std::chrono::hours>(writeTime.time_since_epoch()).count() / 24};
+            }
+            auto [keptSave, inserted] = keptSaves.emplace(bucket, ArchivedSave{filename, writeTime});
+            if (!inserted) {
+                if (writeTime > keptSave->second.writeTime) {
+                    removeArchivedSave(keptSave->second.filename);
+                    keptSave->second = ArchivedSave{filename, writeTime};
+                } else {
+                    removeArchivedSave(filename);
+                }
+            }
+        }
+
+        //compaction: surviving saves beyond the keep-everything tier are stored gzip-compressed
+        for (auto const& [bucket, archivedSave] : keptSaves) {
+            if (bucket.first > 0 && archivedSave.filename.extension() == ".sim") {
+                compressArchivedSave(archivedSave.filename);
+            }
+        }
+    }
+}
+
 _AutosaveController::_AutosaveController(SimulationController const& simController)
     : _simController(simController)
 {
@@ -16,14 +150,15 @@ _AutosaveController::_AutosaveController(SimulationController const& simControll
 _AutosaveController::~_AutosaveController()
 {
     GlobalSettings::getInstance().setBoolState("controllers.auto save.active", _on);
+    joinIoThread();
 }
 
 void _AutosaveController::shutdown()
 {
-    if (!_on) {
-        return;
+    if (_on) {
+        onSave(false);    //the final save before shutdown must be finished before the engine is destroyed
     }
-    onSave();
+    joinIoThread();
 }
 
 bool _AutosaveController::isOn() const
@@ -44,7 +179,7 @@ void _AutosaveController::process()
 
     auto durationSinceStart = std::chrono::duration_cast<std::chrono::minutes>(std::chrono::steady_clock::now() - *_startTimePoint).count();
     if (durationSinceStart > 0 && durationSinceStart % 20 == 0 && !_alreadySaved) {
-        onSave();
+        onSave(true);
         _alreadySaved = true;
     }
     if (durationSinceStart > 0 && durationSinceStart % 20 == 1 && _alreadySaved) {
@@ -52,12 +187,37 @@ void _AutosaveController::process()
     }
 }
 
-void _AutosaveController::onSave()
+void _AutosaveController::onSave(bool async)
 {
-    DeserializedSimulation sim;
-    sim.timestep = _simController->getCurrentTimestep();
-    sim.settings = _simController->getSettings();
-    sim.symbolMap = _simController->getSymbolMap();
-    sim.content = _simController->getClusteredSimulationData();
-    Serializer::serializeSimulationToFiles(Const::AutosaveFile, sim);
+    //a world that has neither stepped nor been edited since the last checkpoint would be rewritten
+    //byte-identically; skip the save in that case
+    auto checkpointState = std::make_pair(_simController->getCurrentTimestep(), _simController->getWorldVersion());
+    if (_lastCheckpointState == checkpointState) {
+        return;
+    }
+
+    //the previous autosave becomes part of the history before it is overwritten; archival,
+    //retention and recompression run on the background IO thread
+    joinIoThread();
+    _ioThread = std::thread([] { archiveAndPrune(); });
+
+    //the content is saved as a raw snapshot: it avoids the costly description building and keeps
+    //the freeze on large worlds short
+    Serializer::serializeAuxiliaryDataToFiles(
+        Const::AutosaveFile, _simController->getCurrentTimestep(), _simController->getSettings(), _simController->getSymbolMap());
+    if (async) {
+        //only the brief extraction into the transfer buffers pauses the engine; the disk write
+        //runs on a background thread and its result is not tracked
+        _simController->saveSimulationDataToFile_async(Const::AutosaveFile);
+        _lastCheckpointState = checkpointState;
+    } else if (_simController->saveSimulationDataToFile(Const::AutosaveFile)) {
+        _lastCheckpointState = checkpointState;
+    }
+}
+
+void _AutosaveController::joinIoThread()
+{
+    if (_ioThread.joinable()) {
+        _ioThread.join();
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <thread>
 
 #include "EngineInterface/SimulationController.h"
 #include "Definitions.h"
@@ -19,11 +20,19 @@ public:
     void process();
 
 private:
-    void onSave();
+    void onSave(bool async);
+    void joinIoThread();
 
     SimulationController _simController;
 
+    //background IO thread for the autosave history: archives the previous save, applies the
+    //tiered retention and recompresses old archives; owns the history files until joined
+    std::thread _ioThread;
+
     bool _on = true;
     std::optional<std::chrono::steady_clock::time_point> _startTimePoint;
     bool _alreadySaved = false;
+
+    //timestep and world version of the last checkpoint; unchanged values mean the files on disk are already identical
+    std::optional<std::pair<uint64_t, uint64_t>> _lastCheckpointState;
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "BrowserWindow.h"
 
+#include <chrono>
+
 #include <boost/algorithm/string/join.hpp>
 #include <imgui.h>
 
@@ -20,6 +22,42 @@
 #include "MessageDialog.h"
 #include "LoginDialog.h"
 #include "UploadSimulationDialog.h"
+#include "OpenGLHelper.h"
+
+namespace
+{
+    auto constexpr PageSize = 100;
+
+    std::string toOrderByField(int columnId)
+    {
+        switch (columnId) {
+        case RemoteSimulationDataColumnId_Timestamp:
+            return "timestamp";
+        case RemoteSimulationDataColumnId_UserName:
+            return "userName";
+        case RemoteSimulationDataColumnId_SimulationName:
+            return "simulationName";
+        case RemoteSimulationDataColumnId_Description:
+            return "description";
+        case RemoteSimulationDataColumnId_Likes:
+            return "likes";
+        case RemoteSimulationDataColumnId_NumDownloads:
+            return "numDownloads";
+        case RemoteSimulationDataColumnId_Width:
+            return "width";
+        case RemoteSimulationDataColumnId_Height:
+            return "height";
+        case RemoteSimulationDataColumnId_Particles:
+            return "particles";
+        case RemoteSimulationDataColumnId_FileSize:
+            return "fileSize";
+        case RemoteSimulationDataColumnId_Version:
+            return "version";
+        default:
+            return std::string();
+        }
+    }
+}
 
 _BrowserWindow::_BrowserWindow(
     SimulationController const& simController,
@@ -55,39 +93,111 @@ void _BrowserWindow::onRefresh()
 
 void _BrowserWindow::refreshIntern(bool firstTimeStartup)
 {
-    try {
-        if (!_networkController->getRemoteSimulationDataList(_remoteSimulationDatas, !firstTimeStartup)) {
-            if (!firstTimeStartup) {
-                MessageDialog::getInstance().show("Error", "Failed to retrieve browser data.");
+    if (_pendingRefresh) {
+        return;    //a refresh is already underway
+    }
+
+    //all server round trips run on a background task; dialogs may only be opened on the GUI
+    //thread, so errors are carried in the result and shown in applyRefreshResult
+    auto networkController = _networkController;
+    auto pageIndex = _pageIndex;
+    auto filter = _filter;
+    auto orderBy = _serverOrderBy;
+    _pendingRefresh = std::async(std::launch::async, [networkController, firstTimeStartup, pageIndex, filter, orderBy] {
+        RefreshResult result;
+        result.showErrors = !firstTimeStartup;
+        try {
+            //the paged query lets the server filter, sort and slice; older servers answer with
+            //the full list instead, and the client keeps filtering and paging on its own
+            result.totalCount =
+                networkController->getRemoteSimulationDataPage(result.remoteSimulationDatas, pageIndex, PageSize, filter, orderBy, !firstTimeStartup);
+            if (!result.totalCount && !networkController->getRemoteSimulationDataList(result.remoteSimulationDatas, !firstTimeStartup)) {
+                result.errorMessage = "Failed to retrieve browser data.";
+                return result;
             }
+            result.success = true;
+        } catch (std::exception const& e) {
+            result.errorMessage = e.what();
         }
-        _filteredRemoteSimulationDatas = _remoteSimulationDatas;
+        return result;
+    });
+}
 
-        if (_networkController->getLoggedInUserName()) {
-            std::vector<std::string> likedIds;
-            if (!_networkController->getLikedSimulationIdList(likedIds)) {
-                MessageDialog::getInstance().show("Error", "Failed to retrieve browser data.");
-            }
-            _likedIds = std::unordered_set<std::string>(likedIds.begin(), likedIds.end());
-        } else {
-            _likedIds.clear();
+void _BrowserWindow::applyRefreshResult()
+{
+    auto result = _pendingRefresh->get();
+    _pendingRefresh.reset();
+
+    if (!result.success) {
+        if (result.showErrors) {
+            MessageDialog::getInstance().show("Error", result.errorMessage);
         }
+        return;
+    }
+
+    _remoteSimulationDatas = std::move(result.remoteSimulationDatas);
+    _filteredRemoteSimulationDatas = _remoteSimulationDatas;
+    _serverPagingActive = result.totalCount.has_value();
+    _numRemoteSimulations = _serverPagingActive ? *result.totalCount : toInt(_remoteSimulationDatas.size());
+    if (!_networkController->getLoggedInUserName()) {
+        _likedIds.clear();
+    }
+    sortTable();
 
-        sortTable();
-    } catch (std::exception const& e) {
-        if (!firstTimeStartup) {
-            MessageDialog::getInstance().show("Error", e.what());
+    //the rows are on screen from this frame on; the like information (liked ids and the batched
+    //user likes of all rows) follows with a second task so that its round trips never delay the
+    //list itself
+    if (!_pendingLikes) {
+        auto networkController = _networkController;
+        std::vector<std::string> simIds;
+        for (auto const& entry : _remoteSimulationDatas) {
+            if (entry.likes > 0) {
+                simIds.emplace_back(entry.id);
+            }
         }
+        _pendingLikes = std::async(std::launch::async, [networkController, simIds] {
+            LikesResult result;
+            try {
+                if (networkController->getLoggedInUserName()) {
+                    std::vector<std::string> likedIds;
+                    if (networkController->getLikedSimulationIdList(likedIds)) {
+                        result.likedIds = std::unordered_set<std::string>(likedIds.begin(), likedIds.end());
+                        result.likedIdsValid = true;
+                    }
+                }
+
+                //a server without the batched endpoint leaves the cache empty and the tooltips
+                //fetch lazily as before
+                if (!simIds.empty()) {
+                    result.userLikesByIdValid = networkController->getUserLikesForSimulations(result.userLikesById, simIds);
+                }
+            } catch (...) {
+            }
+            return result;
+        });
     }
 }
 
 void _BrowserWindow::processIntern()
 {
+    if (_pendingRefresh && _pendingRefresh->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        applyRefreshResult();
+    }
+    if (_pendingLikes && _pendingLikes->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto likesResult = _pendingLikes->get();
+        _pendingLikes.reset();
+        if (likesResult.likedIdsValid) {
+            _likedIds = std::move(likesResult.likedIds);
+        }
+        if (likesResult.userLikesByIdValid) {
+            _userLikesByIdCache = std::move(likesResult.userLikesById);
+        }
+    }
     processToolbar();
     processTable();
     processStatus();
     processFilter();
-    if(_scheduleRefresh) {
+    if (_scheduleRefresh && !_pendingRefresh) {
         onRefresh();
         _scheduleRefresh = false;
     }
@@ -139,9 +249,14 @@ void _BrowserWindow::processTable()
     static ImGuiTableFlags flags = ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_Sortable
         | ImGuiTableFlags_SortMulti | ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_NoBordersInBody
         | ImGuiTableFlags_ScrollY;
-    if (ImGui::BeginTable("Browser", 12, flags, ImVec2(0, ImGui::GetContentRegionAvail().y - styleRepository.scaleContent(63.0f)), 0.0f)) {
+    if (ImGui::BeginTable("Browser", 13, flags, ImVec2(0, ImGui::GetContentRegionAvail().y - styleRepository.scaleContent(63.0f)), 0.0f)) {
         ImGui::TableSetupColumn(
             "Actions", ImGuiTableColumnFlags_PreferSortDescending | ImGuiTableColumnFlags_WidthFixed, 0.0f, RemoteSimulationDataColumnId_Actions);
+        ImGui::TableSetupColumn(
+            "Preview",
+            ImGuiTableColumnFlags_NoSort | ImGuiTableColumnFlags_WidthFixed,
+            styleRepository.scaleContent(60.0f),
+            RemoteSimulationDataColumnId_Preview);
         ImGui::TableSetupColumn(
             "Timestamp",
             ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending,
@@ -175,6 +290,19 @@ void _BrowserWindow::processTable()
         //sort our data if sort specs have been changed!
         if (ImGuiTableSortSpecs* sortSpecs = ImGui::TableGetSortSpecs()) {
             if (sortSpecs->SpecsDirty || _scheduleSort) {
+
+                //with server-side paging the primary sort must happen on the server, otherwise
+                //only the current page would be sorted
+                if (_serverPagingActive && sortSpecs->SpecsCount > 0) {
+                    auto const& spec = sortSpecs->Specs[0];
+                    auto orderBy = toOrderByField(spec.ColumnUserID)
+                        + (spec.SortDirection == ImGuiSortDirection_Descending ? " desc" : " asc");
+                    if (orderBy != _serverOrderBy) {
+                        _serverOrderBy = orderBy;
+                        _pageIndex = 0;
+                        _scheduleRefresh = true;
+                    }
+                }
                 if (_filteredRemoteSimulationDatas.size() > 1) {
                     std::sort(_filteredRemoteSimulationDatas.begin(), _filteredRemoteSimulationDatas.end(), [&](auto const& left, auto const& right) {
                         return RemoteSimulationData::compare(&left, &right, sortSpecs) < 0;
@@ -225,6 +353,9 @@ void _BrowserWindow::processTable()
                 AlienImGui::Tooltip("Delete");
 
                 ImGui::TableNextColumn();
+                processPreview(item->id);
+
+                ImGui::TableNextColumn();
 
 /*
                 ImGuiSelectableFlags selectableFlags = ImGuiSelectableFlags_SpanAllColumns | ImGuiSelectableFlags_AllowItemOverlap;
@@ -264,6 +395,41 @@ void _BrowserWindow::processTable()
     }
 }
 
+void _BrowserWindow::processPreview(std::string const& id)
+{
+    auto textureIt = _previewTextureById.find(id);
+    if (textureIt == _previewTextureById.end()) {
+
+        //previews are only requested for rows inside the clipper range, i.e. while they are
+        //visible; the download runs on a background task so that scrolling never waits for the
+        //server
+        auto pendingIt = _pendingPreviewById.find(id);
+        if (pendingIt == _pendingPreviewById.end()) {
+            auto networkController = _networkController;
+            _pendingPreviewById.emplace(id, std::async(std::launch::async, [networkController, id] {
+                std::string preview;
+                if (!networkController->downloadPreview(preview, id)) {
+                    return std::string();
+                }
+                return preview;
+            }));
+        } else if (pendingIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+            auto data = pendingIt->second.get();
+            _pendingPreviewById.erase(pendingIt);
+
+            //an empty or undecodable response means the server holds no preview (e.g. uploads
+            //from older program versions); the cell then simply stays empty
+            _previewTextureById.emplace(id, data.empty() ? std::nullopt : OpenGLHelper::loadTextureFromMemory(data));
+        }
+        return;
+    }
+    if (auto const& texture = textureIt->second) {
+        auto height = StyleRepository::getInstance().scaleContent(30.0f);
+        auto width = height * toFloat(texture->width) / toFloat(texture->height);
+        ImGui::Image(reinterpret_cast<void*>(static_cast<intptr_t>(texture->textureId)), ImVec2(width, height));
+    }
+}
+
 void _BrowserWindow::processStatus()
 {
     auto styleRepository = StyleRepository::getInstance();
@@ -272,7 +438,7 @@ void _BrowserWindow::processStatus()
         ImGui::PushStyleColor(ImGuiCol_Text, (ImVec4)Const::LogMessageColor);
         std::string statusText;
         statusText += std::string(" " ICON_FA_INFO_CIRCLE " ");
-        statusText += std::to_string(_remoteSimulationDatas.size()) + " simulations found";
+        statusText += std::to_string(_numRemoteSimulations) + " simulations found";
 
         statusText += std::string("  " ICON_FA_INFO_CIRCLE " ");
         if (auto userName = _networkController->getLoggedInUserName()) {
@@ -294,13 +460,42 @@ void _BrowserWindow::processStatus()
 void _BrowserWindow::processFilter()
 {
     if (AlienImGui::InputText(AlienImGui::InputTextParameters().name("Filter"), _filter)) {
-        _filteredRemoteSimulationDatas.clear();
-        for (auto const& entry : _remoteSimulationDatas) {
-            if (entry.matchWithFilter(_filter)) {
-                _filteredRemoteSimulationDatas.emplace_back(entry);
+        if (_serverPagingActive) {
+            _pageIndex = 0;
+            _scheduleRefresh = true;
+        } else {
+            _filteredRemoteSimulationDatas.clear();
+            for (auto const& entry : _remoteSimulationDatas) {
+                if (entry.matchWithFilter(_filter)) {
+                    _filteredRemoteSimulationDatas.emplace_back(entry);
+                }
             }
         }
     }
+    if (_serverPagingActive) {
+        ImGui::SameLine();
+        processPageControls();
+    }
+}
+
+void _BrowserWindow::processPageControls()
+{
+    auto numPages = std::max(1, (_numRemoteSimulations + PageSize - 1) / PageSize);
+    ImGui::BeginDisabled(_pageIndex <= 0 || _pendingRefresh.has_value());
+    if (AlienImGui::Button(ICON_FA_CHEVRON_LEFT)) {
+        --_pageIndex;
+        _scheduleRefresh = true;
+    }
+    ImGui::EndDisabled();
+    ImGui::SameLine();
+    AlienImGui::Text("Page " + std::to_string(_pageIndex + 1) + "/" + std::to_string(numPages));
+    ImGui::SameLine();
+    ImGui::BeginDisabled(_pageIndex >= numPages - 1 || _pendingRefresh.has_value());
+    if (AlienImGui::Button(ICON_FA_CHEVRON_RIGHT)) {
+        ++_pageIndex;
+        _scheduleRefresh = true;
+    }
+    ImGui::EndDisabled();
 }
 
 void _BrowserWindow::processShortenedText(std::string const& text) {
@@ -342,15 +537,12 @@ void _BrowserWindow::sortTable()
 
 void _BrowserWindow::onOpenSimulation(std::string const& id)
 {
-    std::string content, settings, symbolMap;
-    if (!_networkController->downloadSimulation(content, settings, symbolMap, id)) {
+    DeserializedSimulation deserializedSim;
+    if (!_networkController->downloadSimulation(deserializedSim, id)) {
         MessageDialog::getInstance().show("Error", "Failed to download simulation.");
         return;
     }
 
-    DeserializedSimulation deserializedSim;
-    Serializer::deserializeSimulationFromStrings(deserializedSim, content, settings, symbolMap);
-
     _simController->closeSimulation();
     _statisticsWindow->reset();
 
@@ -393,15 +585,26 @@ bool _BrowserWindow::isLiked(std::string const& id)
 
 std::string _BrowserWindow::getUserLikes(std::string const& id)
 {
-    std::set<std::string> userLikes;
-
     auto findResult = _userLikesByIdCache.find(id);
     if (findResult != _userLikesByIdCache.end()) {
-        userLikes = findResult->second;
-    } else {
-        _networkController->getUserLikesForSimulation(userLikes, id);
-        _userLikesByIdCache.emplace(id, userLikes);
+        return boost::algorithm::join(findResult->second, ", ");
     }
 
-    return boost::algorithm::join(userLikes, ", ");
+    //not prefetched (older server or invalidated by a like toggle): fetch on a background task
+    //and show a placeholder until the result arrives
+    auto pendingIt = _pendingUserLikesById.find(id);
+    if (pendingIt == _pendingUserLikesById.end()) {
+        auto networkController = _networkController;
+        _pendingUserLikesById.emplace(id, std::async(std::launch::async, [networkController, id] {
+            std::set<std::string> userLikes;
+            networkController->getUserLikesForSimulation(userLikes, id);
+            return userLikes;
+        }));
+    } else if (pendingIt->second.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto userLikes = pendingIt->second.get();
+        _pendingUserLikesById.erase(pendingIt);
+        _userLikesByIdCache.emplace(id, userLikes);
+        return boost::algorithm::join(userLikes, ", ");
+    }
+    return "...";
 }
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "EngineInterface/Definitions.h"
 
 #include "AlienWindow.h"
@@ -23,12 +25,15 @@ public:
 
 private:
     void refreshIntern(bool firstTimeStartup);
+    void applyRefreshResult();
 
     void processIntern() override;
 
     void processTable();
+    void processPreview(std::string const& id);
     void processStatus();
     void processFilter();
+    void processPageControls();
     void processToolbar();
     void processShortenedText(std::string const& text);
     bool processDetailButton();
@@ -47,12 +52,48 @@ private:
     bool _scheduleRefresh = false;
     bool _scheduleSort = false;
     std::string _filter;
+
+    //server-side paging: active as soon as the server answers the paged query; filtering and
+    //primary sorting then happen on the server and the client only holds one page
+    bool _serverPagingActive = false;
+    int _pageIndex = 0;
+    int _numRemoteSimulations = 0;
+    std::string _serverOrderBy;
     std::unordered_set<std::string> _selectionIds;
     std::unordered_set<std::string> _likedIds;
     std::unordered_map<std::string, std::set<std::string>> _userLikesByIdCache;
     std::vector<RemoteSimulationData> _remoteSimulationDatas;
     std::vector<RemoteSimulationData> _filteredRemoteSimulationDatas;
 
+    //preview thumbnails: fetched on background tasks for the visible rows only and cached as
+    //textures; std::nullopt means the server holds no preview for that simulation
+    std::unordered_map<std::string, std::optional<TextureData>> _previewTextureById;
+    std::unordered_map<std::string, std::future<std::string>> _pendingPreviewById;
+
+    //a refresh runs on a background task so that the server round trips never block the GUI; the
+    //result is applied in processIntern once the future is ready
+    struct RefreshResult
+    {
+        bool success = false;
+        bool showErrors = false;
+        std::string errorMessage;
+        std::vector<RemoteSimulationData> remoteSimulationDatas;
+        std::optional<int> totalCount;    //set if the server answered the paged query
+    };
+    std::optional<std::future<RefreshResult>> _pendingRefresh;
+
+    //the like information arrives with a second background task started after the rows have been
+    //applied, so the table renders as soon as the list itself is parsed
+    struct LikesResult
+    {
+        std::unordered_set<std::string> likedIds;
+        bool likedIdsValid = false;
+        std::unordered_map<std::string, std::set<std::string>> userLikesById;
+        bool userLikesByIdValid = false;
+    };
+    std::optional<std::future<LikesResult>> _pendingLikes;
+    std::unordered_map<std::string, std::future<std::set<std::string>>> _pendingUserLikesById;
+
     SimulationController _simController;
     NetworkController _networkController;
     StatisticsWindow _statisticsWindow;
@@ -4,8 +4,6 @@
 
 #include "Base/Definitions.h"
 #include "EngineInterface/Colors.h"
-#include "EngineInterface/Descriptions.h"
-#include "EngineInterface/DescriptionHelper.h"
 #include "EngineInterface/SimulationController.h"
 
 #include "AlienImGui.h"
@@ -88,20 +86,14 @@ void _ColorizeDialog::colorCheckbox(std::string id, uint32_t cellColor, bool& ch
 
 void _ColorizeDialog::onColorize()
 {
-    auto timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
-    auto settings = _simController->getSettings();
-    auto symbolMap = _simController->getSymbolMap();
-    auto content = _simController->getClusteredSimulationData();
-
     std::vector<int> colorCodes;
     for (int i = 0; i < 7; ++i) {
         if(_checkColors[i]) {
             colorCodes.emplace_back(i);
         }
     }
-    DescriptionHelper::colorize(content, colorCodes);
 
-    _simController->closeSimulation();
-    _simController->newSimulation(timestep, settings, symbolMap);
-    _simController->setClusteredSimulationData(content);
+    //the colorization runs entirely on the GPU; the former roundtrip through host descriptions
+    //took minutes for large worlds
+    _simController->colorizeClusters(colorCodes);
 }
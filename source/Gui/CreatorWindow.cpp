@@ -12,6 +12,7 @@
 #include "Base/Math.h"
 #include "EngineInterface/Descriptions.h"
 #include "EngineInterface/DescriptionHelper.h"
+#include "UndoBuffer.h"
 #include "EngineInterface/SimulationController.h"
 
 #include "GlobalSettings.h"
@@ -146,6 +147,27 @@ void _CreatorWindow::onDrawing()
 {
     auto mousePos = ImGui::GetMousePos();
     auto pos = _viewport->mapViewToWorldPosition({mousePos.x, mousePos.y});
+
+    //barrier strokes are painted directly on the GPU without a description roundtrip per mouse move
+    if (_barrier) {
+        if (!_lastBarrierStrokePos) {
+            _simController->removeSelection();
+            _simController->drawBarrier({pos}, true, _cellDistance, _energy, _editorModel->getDefaultColorCode());
+            _lastBarrierStrokePos = pos;
+        } else {
+            auto lastPos = *_lastBarrierStrokePos;
+            auto distance = Math::length(pos - lastPos);
+            if (distance >= _cellDistance) {
+                _simController->drawBarrier({lastPos, pos}, false, _cellDistance, _energy, _editorModel->getDefaultColorCode());
+                for (float l = _cellDistance; l <= distance; l += _cellDistance) {
+                    _lastBarrierStrokePos = lastPos + (pos - lastPos) * (l / distance);    //last painted cell, mirrors the kernel's sampling
+                }
+            }
+        }
+        _editorModel->update();
+        return;
+    }
+
     if (!_drawing.isEmpty()) {
         _simController->removeSelectedEntities(false);
     }
@@ -197,6 +219,7 @@ void _CreatorWindow::onDrawing()
 void _CreatorWindow::finishDrawing()
 {
     _drawing.clear();
+    _lastBarrierStrokePos.reset();
 }
 
 void _CreatorWindow::createCell()
@@ -209,6 +232,7 @@ void _CreatorWindow::createCell()
                     .setMetadata(CellMetadata().setColor(_editorModel->getDefaultColorCode()))
                     .setBarrier(_barrier);
     auto data = DataDescription().addCell(cell);
+    _editorModel->getUndoBuffer()->capture(DataDescription(), _UndoBuffer::RestoreMode::ReplaceSelection, true);
     _simController->addAndSelectSimulationData(data);
     incBranchNumber();
 }
@@ -217,6 +241,7 @@ void _CreatorWindow::createParticle()
 {
     auto particle = ParticleDescription().setPos(getRandomPos()).setEnergy(_energy);
     auto data = DataDescription().addParticle(particle);
+    _editorModel->getUndoBuffer()->capture(DataDescription(), _UndoBuffer::RestoreMode::ReplaceSelection, true);
     _simController->addAndSelectSimulationData(data);
 }
 
@@ -238,6 +263,7 @@ void _CreatorWindow::createRectangle()
                                                   .center(getRandomPos())
                                                   .barrier(_barrier));
 
+    _editorModel->getUndoBuffer()->capture(DataDescription(), _UndoBuffer::RestoreMode::ReplaceSelection, true);
     _simController->addAndSelectSimulationData(data);
 }
 
@@ -283,6 +309,7 @@ void _CreatorWindow::createHexagon()
         DescriptionHelper::removeStickiness(data);
     }
     data.setCenter(getRandomPos());
+    _editorModel->getUndoBuffer()->capture(DataDescription(), _UndoBuffer::RestoreMode::ReplaceSelection, true);
     _simController->addAndSelectSimulationData(data);
 }
 
@@ -324,6 +351,7 @@ void _CreatorWindow::createDisc()
         DescriptionHelper::removeStickiness(data);
     }
     data.setCenter(getRandomPos());
+    _editorModel->getUndoBuffer()->capture(DataDescription(), _UndoBuffer::RestoreMode::ReplaceSelection, true);
     _simController->addAndSelectSimulationData(data);
 }
 
@@ -59,6 +59,7 @@ private:
 
     //paint
     DataDescription _drawing;
+    std::optional<RealVector2D> _lastBarrierStrokePos;
 
     CreationMode _mode = CreationMode::CreateCell;
 
@@ -17,6 +17,9 @@ using Shader = std::shared_ptr<_Shader>;
 class _SimulationScrollbar;
 using SimulationScrollbar = std::shared_ptr<_SimulationScrollbar>;
 
+class _SimulationMinimap;
+using SimulationMinimap = std::shared_ptr<_SimulationMinimap>;
+
 class _Viewport;
 using Viewport = std::shared_ptr<_Viewport>;
 
@@ -34,6 +37,9 @@ using SimulationParametersWindow = std::shared_ptr<_SimulationParametersWindow>;
 class _StatisticsWindow;
 using StatisticsWindow = std::shared_ptr<_StatisticsWindow>;
 
+class _KernelProfilerWindow;
+using KernelProfilerWindow = std::shared_ptr<_KernelProfilerWindow>;
+
 class _ModeController;
 using ModeController = std::shared_ptr<_ModeController>;
 
@@ -85,6 +91,9 @@ using DisplaySettingsDialog = std::shared_ptr<_DisplaySettingsDialog>;
 class _EditorModel;
 using EditorModel = std::shared_ptr<_EditorModel>;
 
+class _UndoBuffer;
+using UndoBuffer = std::shared_ptr<_UndoBuffer>;
+
 class _EditorController;
 using EditorController = std::shared_ptr<_EditorController>;
 
@@ -127,6 +136,9 @@ using PatternAnalysisDialog = std::shared_ptr<_PatternAnalysisDialog>;
 class _ExportStatisticsDialog;
 using ExportStatisticsDialog = std::shared_ptr<_ExportStatisticsDialog>;
 
+class _StatisticsFileRecorder;
+using StatisticsFileRecorder = std::shared_ptr<_StatisticsFileRecorder>;
+
 class _SimulationParametersChanger;
 using SimulationParametersChanger = std::shared_ptr<_SimulationParametersChanger>;
 
@@ -162,6 +174,9 @@ using DeleteUserDialog = std::shared_ptr<_DeleteUserDialog>;
 class _NetworkSettingsDialog;
 using NetworkSettingsDialog = std::shared_ptr<_NetworkSettingsDialog>;
 
+class _PeerSyncDialog;
+using PeerSyncDialog = std::shared_ptr<_PeerSyncDialog>;
+
 class _ResetPasswordDialog;
 using ResetPasswordDialog = std::shared_ptr<_ResetPasswordDialog>;
 
@@ -15,6 +15,12 @@
 #include "MultiplierWindow.h"
 #include "SymbolsWindow.h"
 
+namespace
+{
+    //rate at which the engine pushes fresh data for the inspected entities
+    std::chrono::milliseconds const InspectionUpdateInterval(50);
+}
+
 _EditorController::_EditorController(SimulationController const& simController, Viewport const& viewport)
     : _simController(simController)
     , _viewport(viewport)
@@ -101,6 +107,11 @@ void _EditorController::process()
         if (_editorModel->isDrawMode()) {
             _creatorWindow->finishDrawing();
         }
+        if (_deferredReconnectPending) {
+            _deferredReconnectPending = false;
+            _simController->reconnectSelectedEntities();
+            _editorModel->update();
+        }
     }
     if (ImGui::IsMouseReleased(ImGuiMouseButton_Right)) {
         if (!_simController->isSimulationRunning()) {
@@ -225,14 +236,30 @@ void _EditorController::processInspectorWindows()
 
     //update inspected entities from simulation
     if (inspectedEntities.empty()) {
+        if (!_subscribedInspectionIds.empty()) {
+            _simController->setInspectedEntityIds({}, InspectionUpdateInterval);
+            _subscribedInspectionIds.clear();
+        }
         return;
     }
     std::vector<uint64_t> entityIds;
     for (auto const& entity : inspectedEntities) {
         entityIds.emplace_back(DescriptionHelper::getId(entity));
     }
-    auto inspectedData = _simController->getInspectedSimulationData(entityIds);
-    auto newInspectedEntities = DescriptionHelper::getEntities(inspectedData);
+
+    //the engine pushes fresh data for the subscribed ids at its own rate between timestep
+    //batches (also after edits, which covers the windows' own changeCell calls); here only the
+    //subscription is kept up to date and arrived data is applied
+    if (_subscribedInspectionIds != entityIds) {
+        _simController->setInspectedEntityIds(entityIds, InspectionUpdateInterval);
+        _subscribedInspectionIds = entityIds;
+    }
+
+    auto inspectedData = _simController->fetchInspectionData();
+    if (!inspectedData) {
+        return;
+    }
+    auto newInspectedEntities = DescriptionHelper::getEntities(*inspectedData);
     _editorModel->setInspectedEntities(newInspectedEntities);
 
     inspectorWindows.clear();
@@ -328,8 +355,19 @@ void _EditorController::moveSelectedEntities(
     updateData.considerClusters = _editorModel->isRolloutToClusters();
     updateData.posDeltaX = delta.x;
     updateData.posDeltaY = delta.y;
-    _simController->shallowUpdateSelectedEntities(updateData);
-    _editorModel->update();
+
+    //freeze the topology while the mouse is down; a single reconnection pass runs on release
+    //instead of validating the connections on every mouse-move event
+    updateData.deferReconnection = true;
+    if (!updateData.considerClusters && (delta.x != 0 || delta.y != 0)) {
+        _deferredReconnectPending = true;
+    }
+
+    //the update is queued for the worker thread so that a burst of mouse-move events does not
+    //trigger a blocking GPU round trip each; the cached selection centers are shifted locally
+    //to keep the editor windows in sync until the queued update is applied
+    _simController->shallowUpdateSelectedEntities_async(updateData);
+    _editorModel->shiftSelectionCenters(delta);
 }
 
 void _EditorController::applyForces(RealVector2D const& viewPos, RealVector2D const& prevViewPos)
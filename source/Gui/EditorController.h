@@ -62,6 +62,7 @@ private:
     bool _on = false;
 
     std::optional<RealVector2D> _prevMousePosInt;
+    bool _deferredReconnectPending = false;
 
     struct SelectionRect
     {
@@ -71,4 +72,8 @@ private:
     std::optional<SelectionRect> _selectionRect;
     std::vector<InspectorWindow> _inspectorWindows;
     DataDescription _drawing;
+
+    //ids currently subscribed at the engine's inspection channel; the engine pushes fresh data
+    //for them at its own rate, so only subscription changes need a call here
+    std::vector<uint64_t> _subscribedInspectionIds;
 };
\ No newline at end of file
@@ -3,9 +3,12 @@
 #include "EngineInterface/DescriptionHelper.h"
 #include "EngineInterface/SimulationController.h"
 
+#include "UndoBuffer.h"
+
 _EditorModel::_EditorModel(SimulationController const& simController)
     : _simController(simController)
 {
+    _undoBuffer = std::make_shared<_UndoBuffer>();
     clear();
 }
 
@@ -19,6 +22,14 @@ void _EditorModel::update()
     _selectionShallowData = _simController->getSelectionShallowData();
 }
 
+void _EditorModel::shiftSelectionCenters(RealVector2D const& delta)
+{
+    _selectionShallowData.centerPosX += delta.x;
+    _selectionShallowData.centerPosY += delta.y;
+    _selectionShallowData.clusterCenterPosX += delta.x;
+    _selectionShallowData.clusterCenterPosY += delta.y;
+}
+
 bool _EditorModel::isSelectionEmpty() const
 {
     return 0 == _selectionShallowData.numCells && 0 == _selectionShallowData.numClusterCells
@@ -33,6 +44,7 @@ bool _EditorModel::isCellSelectionEmpty() const
 void _EditorModel::clear()
 {
     _selectionShallowData = SelectionShallowData();
+    _undoBuffer->clear();    //snapshots from another world must not be restored into this one
 }
 
 std::vector<CellOrParticleDescription> _EditorModel::fetchEntitiesToInspect()
@@ -111,3 +123,8 @@ bool _EditorModel::isRolloutToClusters() const
 {
     return _rolloutToClusters && !_forceNoRollout;
 }
+
+UndoBuffer _EditorModel::getUndoBuffer() const
+{
+    return _undoBuffer;
+}
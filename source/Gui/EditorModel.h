@@ -14,6 +14,10 @@ public:
     SelectionShallowData const& getSelectionShallowData() const;
     void update();
 
+    //applies a drag delta to the cached selection centers without a GPU round trip; used while
+    //the corresponding entity update is still queued in the engine
+    void shiftSelectionCenters(RealVector2D const& delta);
+
     bool isSelectionEmpty() const;
     bool isCellSelectionEmpty() const;
     void clear();
@@ -38,8 +42,13 @@ public:
     void setRolloutToClusters(bool value);
     bool isRolloutToClusters() const;
 
+    //shared by the editor windows: every destructive operation deposits a snapshot of the
+    //affected entities here before it runs
+    UndoBuffer getUndoBuffer() const;
+
 private:
     SimulationController _simController;
+    UndoBuffer _undoBuffer;
     SelectionShallowData _selectionShallowData;
 
     std::vector<CellOrParticleDescription> _entitiesToInspect;
@@ -1,28 +1,108 @@
 #include "ExportStatisticsDialog.h"
 
+#include <algorithm>
 #include <fstream>
+#include <imgui.h>
 #include <ImFileDialog.h>
 
 #include "Base/Definitions.h"
 
+#include "AlienImGui.h"
 #include "GlobalSettings.h"
 #include "MessageDialog.h"
+#include "StatisticsFileRecorder.h"
 
-_ExportStatisticsDialog::_ExportStatisticsDialog()
+namespace
+{
+    auto const MaxContentTextWidth = 190.0f;
+}
+
+_ExportStatisticsDialog::_ExportStatisticsDialog(StatisticsFileRecorder const& statisticsFileRecorder)
+    : _statisticsFileRecorder(statisticsFileRecorder)
 {
     auto path = std::filesystem::current_path();
     if (path.has_parent_path()) {
         path = path.parent_path();
     }
-    _startingPath = GlobalSettings::getInstance().getStringState("dialogs.export statistics.starting path", path.string());
+    auto& settings = GlobalSettings::getInstance();
+    _startingPath = settings.getStringState("dialogs.export statistics.starting path", path.string());
+    _recordingInterval = settings.getIntState("dialogs.export statistics.recording interval", _recordingInterval);
+    _maxSamplesPerFile = settings.getIntState("dialogs.export statistics.max samples per file", _maxSamplesPerFile);
 }
 
 _ExportStatisticsDialog::~_ExportStatisticsDialog()
 {
-    GlobalSettings::getInstance().setStringState("dialogs.export statistics.starting path", _startingPath);
+    auto& settings = GlobalSettings::getInstance();
+    settings.setStringState("dialogs.export statistics.starting path", _startingPath);
+    settings.setIntState("dialogs.export statistics.recording interval", _recordingInterval);
+    settings.setIntState("dialogs.export statistics.max samples per file", _maxSamplesPerFile);
 }
 
 void _ExportStatisticsDialog::process()
+{
+    processDialog();
+    processExportFileDialog();
+    processRecordFileDialog();
+}
+
+void _ExportStatisticsDialog::show(LongtermStatistics const& longtermStatistics)
+{
+    _statistics = longtermStatistics;
+    _show = true;
+}
+
+void _ExportStatisticsDialog::processDialog()
+{
+    if (!_show) {
+        return;
+    }
+    ImGui::OpenPopup("Export statistics");
+    if (ImGui::BeginPopupModal("Export statistics", NULL, ImGuiWindowFlags_None)) {
+        if (AlienImGui::Button("Export accumulated history")) {
+            ifd::FileDialog::Instance().Save(
+                "ExportStatisticsDialog", "Export statistics", "Comma-separated values (*.csv){.csv},.*", _startingPath);
+        }
+
+        AlienImGui::Separator();
+        AlienImGui::Group("Continuous recording");
+        AlienImGui::Text("Streams a sample to a csv file in the background while the simulation runs.\nThe file is rotated when it is full.");
+
+        AlienImGui::InputInt(
+            AlienImGui::InputIntParameters()
+                .name("Sample interval")
+                .textWidth(MaxContentTextWidth)
+                .defaultValue(1000)
+                .tooltip(std::string("Number of time steps between two recorded samples.")),
+            _recordingInterval);
+        AlienImGui::InputInt(
+            AlienImGui::InputIntParameters()
+                .name("Samples per file")
+                .textWidth(MaxContentTextWidth)
+                .defaultValue(100000)
+                .tooltip(std::string("When a file contains this many samples, it is closed and the recording continues in the next file.")),
+            _maxSamplesPerFile);
+
+        if (!_statisticsFileRecorder->isRecording()) {
+            if (AlienImGui::Button("Start recording")) {
+                ifd::FileDialog::Instance().Save(
+                    "RecordStatisticsDialog", "Record statistics", "Comma-separated values (*.csv){.csv},.*", _startingPath);
+            }
+        } else {
+            if (AlienImGui::Button("Stop recording")) {
+                _statisticsFileRecorder->stopRecording();
+            }
+        }
+
+        AlienImGui::Separator();
+        if (AlienImGui::Button("Close")) {
+            ImGui::CloseCurrentPopup();
+            _show = false;
+        }
+        ImGui::EndPopup();
+    }
+}
+
+void _ExportStatisticsDialog::processExportFileDialog()
 {
     if (!ifd::FileDialog::Instance().IsDone("ExportStatisticsDialog")) {
         return;
@@ -38,10 +118,20 @@ void _ExportStatisticsDialog::process()
     ifd::FileDialog::Instance().Close();
 }
 
-void _ExportStatisticsDialog::show(LongtermStatistics const& longtermStatistics)
+void _ExportStatisticsDialog::processRecordFileDialog()
 {
-    _statistics = longtermStatistics;
-    ifd::FileDialog::Instance().Save("ExportStatisticsDialog", "Export statistics", "Comma-separated values (*.csv){.csv},.*", _startingPath);
+    if (!ifd::FileDialog::Instance().IsDone("RecordStatisticsDialog")) {
+        return;
+    }
+    if (ifd::FileDialog::Instance().HasResult()) {
+        auto firstFilename = ifd::FileDialog::Instance().GetResult();
+        auto firstFilenameCopy = firstFilename;
+        _startingPath = firstFilenameCopy.remove_filename().string();
+
+        _statisticsFileRecorder->startRecording(
+            firstFilename.string(), std::max(1, _recordingInterval), std::max(1, _maxSamplesPerFile));
+    }
+    ifd::FileDialog::Instance().Close();
 }
 
 void _ExportStatisticsDialog::onSaveStatistics(std::string const& filename)
@@ -58,11 +148,12 @@ void _ExportStatisticsDialog::onSaveStatistics(std::string const& filename)
     }
 
     file << "time step, cells, cells (color 0), cells (color 1), cells (color 2), cells (color 3), cells (color 4), cells (color 5), cells (color 6), "
-         << "cell connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities"
+         << "cell connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities, "
+         << "created connections, destroyed connections, deleted cells, moved tokens"
          << std::endl;
     for (int i = 0; i < _statistics.timestepHistory.size(); ++i) {
         file << static_cast<uint64_t>(_statistics.timestepHistory.at(i));
-        for (int j = 0; j <= 14; ++j) {
+        for (int j = 0; j <= 18; ++j) {
             file << ", " << static_cast<uint64_t>(_statistics.datas[j].at(i));
         }
         file << std::endl;
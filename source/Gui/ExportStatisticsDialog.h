@@ -8,7 +8,7 @@
 class _ExportStatisticsDialog
 {
 public:
-    _ExportStatisticsDialog();
+    _ExportStatisticsDialog(StatisticsFileRecorder const& statisticsFileRecorder);
     ~_ExportStatisticsDialog();
 
     void process();
@@ -16,8 +16,17 @@ public:
     void show(LongtermStatistics const& longtermStatistics);
 
 private:
+    void processDialog();
+    void processExportFileDialog();
+    void processRecordFileDialog();
     void onSaveStatistics(std::string const& filename);
 
+    StatisticsFileRecorder _statisticsFileRecorder;
+
     std::string _startingPath;
     LongtermStatistics _statistics;
+
+    bool _show = false;
+    int _recordingInterval = 1000;    //in timesteps
+    int _maxSamplesPerFile = 100000;  //rotation threshold
 };
@@ -2,15 +2,7 @@
 
 void _FpsController::processForceFps(int fps)
 {
-    auto callTimepoint = std::chrono::steady_clock::now();
-    if (_lastCallTimepoint) {
-        auto desiredDuration = std::chrono::milliseconds(1000 / fps);
-        auto actualDuration = std::chrono::duration_cast<std::chrono::milliseconds>(callTimepoint - *_lastCallTimepoint);
-        auto remainingTime = desiredDuration - actualDuration;
-        if (remainingTime.count() > 0) {
-            while (std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - callTimepoint) < remainingTime) {
-            }
-        }
-    }
-    _lastCallTimepoint = callTimepoint;
+    //hybrid sleep/spin pacing with drift correction, shared with the engine's TPS governor; a
+    //plain sleep overshoots by the OS timer quantum and a plain spin burns a core
+    _pacer.pace(std::chrono::microseconds(1000000 / fps));
 }
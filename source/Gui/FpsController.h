@@ -2,6 +2,8 @@
 
 #include <chrono>
 
+#include "Base/IntervalPacer.h"
+
 #include "Definitions.h"
 
 class _FpsController
@@ -10,5 +12,5 @@ public:
     void processForceFps(int fps);
 
 private:
-    std::optional<std::chrono::steady_clock::time_point> _lastCallTimepoint;
-};
\ No newline at end of file
+    IntervalPacer _pacer;
+};
@@ -1,15 +1,12 @@
 #include "GlobalSettings.h"
 
-#include <sstream>
 #include <fstream>
 
-#include <boost/property_tree/json_parser.hpp>
-
 #include "Base/Resources.h"
 
 struct GlobalSettingsImpl
 {
-    boost::property_tree::ptree _tree;
+    JsonDocument _tree;
 };
 
 
@@ -80,6 +77,24 @@ void GlobalSettings::encodeDecodeGpuSettings(GpuSettings& gpuSettings, ParserTas
         defaultSettings.numThreadsPerBlock,
         "settings.gpu.num threads per block",
         task);
+    JsonParser::encodeDecode(
+        _impl->_tree,
+        gpuSettings.fusedPhysics,
+        defaultSettings.fusedPhysics,
+        "settings.gpu.fused physics",
+        task);
+    JsonParser::encodeDecode(
+        _impl->_tree,
+        gpuSettings.jitCellComputation,
+        defaultSettings.jitCellComputation,
+        "settings.gpu.jit cell computation",
+        task);
+    JsonParser::encodeDecode(
+        _impl->_tree,
+        gpuSettings.deterministicMode,
+        defaultSettings.deterministicMode,
+        "settings.gpu.deterministic mode",
+        task);
 }
 
 GlobalSettings::GlobalSettings()
@@ -93,9 +108,7 @@ GlobalSettings::GlobalSettings()
         auto data = std::string(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
         stream.close();
 
-        std::stringstream ss;
-        ss << data;
-        boost::property_tree::read_json(ss, _impl->_tree);
+        _impl->_tree = JsonDocument::fromJson(data);
     } catch (...) {
         //do nothing
     }
@@ -104,9 +117,7 @@ GlobalSettings::GlobalSettings()
 GlobalSettings::~GlobalSettings()
 {
     try {
-        std::stringstream ss;
-        boost::property_tree::json_parser::write_json(ss, _impl->_tree);
-        auto data = ss.str();
+        auto data = _impl->_tree.toJson();
 
         std::ofstream stream(Const::SettingsFilename, std::ios::binary);
         if (stream) {
@@ -11,6 +11,12 @@
 namespace
 {
     auto const MaxContentTextWidth = 180.0f;
+    auto const MemoryInfoUpdateInterval = std::chrono::milliseconds(1000);
+
+    std::string formatMemory(uint64_t bytes)
+    {
+        return StringHelper::format(static_cast<float>(bytes) / 1048576.0f, 1) + " MB";
+    }
 }
 
 _GpuSettingsDialog::_GpuSettingsDialog(SimulationController const& simController)
@@ -54,6 +60,33 @@ void _GpuSettingsDialog::process()
                 .tooltip(std::string("Number of GPU threads per blocks.")),
             gpuSettings.numThreadsPerBlock);
 
+        AlienImGui::Checkbox(
+            AlienImGui::CheckboxParameters()
+                .name("Fused physics kernel")
+                .textWidth(MaxContentTextWidth)
+                .defaultValue(origGpuSettings.fusedPhysics)
+                .tooltip(std::string("Executes the physics stages of a time step in a single fused kernel. Reduces global memory traffic for "
+                                     "large worlds but limits the number of usable blocks.")),
+            gpuSettings.fusedPhysics);
+
+        AlienImGui::Checkbox(
+            AlienImGui::CheckboxParameters()
+                .name("JIT cell programs (experimental)")
+                .textWidth(MaxContentTextWidth)
+                .defaultValue(origGpuSettings.jitCellComputation)
+                .tooltip(std::string("Compiles the most frequent cell programs to native GPU code at runtime and falls back to "
+                                     "interpretation for rare genomes. Experimental.")),
+            gpuSettings.jitCellComputation);
+
+        AlienImGui::Checkbox(
+            AlienImGui::CheckboxParameters()
+                .name("Deterministic mode")
+                .textWidth(MaxContentTextWidth)
+                .defaultValue(origGpuSettings.deterministicMode)
+                .tooltip(std::string("Makes simulation runs reproducible by seeding the random number streams and processing structural "
+                                     "changes in a fixed order. Considerably slower and only effective from the start of a simulation.")),
+            gpuSettings.deterministicMode);
+
         ImGui::Spacing();
         ImGui::Separator();
         ImGui::Spacing();
@@ -71,6 +104,52 @@ void _GpuSettingsDialog::process()
 
         AlienImGui::Separator();
 
+        //the query briefly takes the engine access gate, therefore it is only refreshed periodically
+        auto now = std::chrono::steady_clock::now();
+        if (!_lastMemoryInfoUpdate || now - *_lastMemoryInfoUpdate > MemoryInfoUpdateInterval) {
+            _memoryInfo = _simController->getGpuMemoryInfo();
+            _lastMemoryInfoUpdate = now;
+        }
+
+        ImGui::Text("GPU memory");
+        AlienImGui::Text("Acquired: " + formatMemory(_memoryInfo->acquiredInBytes) + " (peak: " + formatMemory(_memoryInfo->peakAcquiredInBytes) + ")");
+        AlienImGui::Text(
+            "Free device memory: " + formatMemory(_memoryInfo->freeDeviceMemoryInBytes) + " of "
+            + formatMemory(_memoryInfo->totalDeviceMemoryInBytes));
+        AlienImGui::Text("Next resize forecast: " + formatMemory(_memoryInfo->nextResizeForecastInBytes));
+        if (_memoryInfo->nextResizeForecastInBytes > _memoryInfo->freeDeviceMemoryInBytes) {
+            ImGui::PushStyleColor(ImGuiCol_Text, (ImU32)ImColor(0.9f, 0.3f, 0.3f));
+            AlienImGui::Text("The next entity array resize may exceed the device memory!");
+            ImGui::PopStyleColor();
+        }
+
+        if (ImGui::BeginTable("gpu memory", 3, ImGuiTableFlags_BordersInnerH)) {
+            ImGui::TableSetupColumn("Array");
+            ImGui::TableSetupColumn("Used");
+            ImGui::TableSetupColumn("Reserved");
+            ImGui::TableHeadersRow();
+            for (auto const& arrayInfo : _memoryInfo->entityArrays) {
+                ImGui::TableNextRow();
+                ImGui::TableNextColumn();
+                AlienImGui::Text(arrayInfo.name);
+                ImGui::TableNextColumn();
+                AlienImGui::Text(formatMemory(arrayInfo.usedInBytes));
+                ImGui::TableNextColumn();
+                AlienImGui::Text(formatMemory(arrayInfo.sizeInBytes));
+            }
+            ImGui::EndTable();
+        }
+
+        AlienImGui::Separator();
+
+        if (AlienImGui::Button("Auto tune")) {
+            gpuSettings = _simController->autoTuneGpuSettings();
+        }
+        AlienImGui::Tooltip(std::string("Sweeps block and thread counts against the current world and adopts the fastest configuration. "
+                                        "Takes a while and advances the simulation meanwhile."));
+
+        AlienImGui::Separator();
+
         if (AlienImGui::Button("OK")) {
             ImGui::CloseCurrentPopup();
             _show = false;
@@ -1,6 +1,10 @@
 #pragma once
 
+#include <chrono>
+#include <optional>
+
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/GpuMemoryInfo.h"
 #include "EngineInterface/GpuSettings.h"
 #include "Definitions.h"
 
@@ -20,4 +24,7 @@ private:
 
     bool _show = false;
     GpuSettings _gpuSettings;
+
+    std::optional<GpuMemoryInfo> _memoryInfo;
+    std::optional<std::chrono::steady_clock::time_point> _lastMemoryInfoUpdate;
 };
\ No newline at end of file
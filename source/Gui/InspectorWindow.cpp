@@ -252,10 +252,14 @@ void _InspectorWindow::showCellCodeTab(CellDescription& cell)
                 if (_lastCompilationResult) {
                     _lastCompilationResult->compilationOk = true;
                 }
-                return CellComputationCompiler::decompileSourceCode(
-                    cell.cellFeature.constData,
-                    _simController->getSymbolMap(),
-                    _simController->getSimulationParameters());
+                if (!_decompiledConstData || *_decompiledConstData != cell.cellFeature.constData) {
+                    _decompiledSourcecode = CellComputationCompiler::decompileSourceCode(
+                        cell.cellFeature.constData,
+                        _simController->getSymbolMap(),
+                        _simController->getSimulationParameters());
+                    _decompiledConstData = cell.cellFeature.constData;
+                }
+                return _decompiledSourcecode;
             }
             return cell.metadata.computerSourcecode;
         }();
@@ -384,13 +388,7 @@ void _InspectorWindow::showTokenTab(CellDescription& cell, int tokenIndex)
         auto dataSize = token.data.size();
         token.data.copy(_tokenMemory, dataSize);
 
-        std::map<int, std::vector<std::string>> addressToSymbolNamesMap;
-        auto const& symbolMap = _simController->getSymbolMap();
-        for (auto const& [key, value] : symbolMap) {
-            if (auto address = CellComputationCompiler::extractAddress(value)) {
-                addressToSymbolNamesMap[*address].emplace_back(key);
-            }
-        }
+        auto const& addressToSymbolNamesMap = getAddressToSymbolNamesMap();
         int currentMemoryEditIndex = 0;
         if (addressToSymbolNamesMap.empty() || addressToSymbolNamesMap.begin()->first != 0) {
             int numBytes = addressToSymbolNamesMap.empty() ? 256 : addressToSymbolNamesMap.begin()->first;
@@ -919,3 +917,18 @@ void _InspectorWindow::delToken(CellDescription& cell, int index)
     cell.tokens.erase(cell.tokens.begin() + index);
 }
 
+std::map<int, std::vector<std::string>> const& _InspectorWindow::getAddressToSymbolNamesMap()
+{
+    auto const& symbolMap = _simController->getSymbolMap();
+    if (!_symbolMapOfLayout || *_symbolMapOfLayout != symbolMap) {
+        _addressToSymbolNamesMap.clear();
+        for (auto const& [key, value] : symbolMap) {
+            if (auto address = CellComputationCompiler::extractAddress(value)) {
+                _addressToSymbolNamesMap[*address].emplace_back(key);
+            }
+        }
+        _symbolMapOfLayout = symbolMap;
+    }
+    return _addressToSymbolNamesMap;
+}
+
@@ -2,6 +2,7 @@
 
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/SymbolMap.h"
 #include "Definitions.h"
 
 struct MemoryEditor;
@@ -53,6 +54,8 @@ private:
     void addToken(CellDescription& cell);
     void delToken(CellDescription& cell, int index);
 
+    std::map<int, std::vector<std::string>> const& getAddressToSymbolNamesMap();
+
 private:
     std::shared_ptr<MemoryEditor> _cellDataMemoryEdit;
     std::shared_ptr<MemoryEditor> _cellInstructionMemoryEdit;
@@ -64,6 +67,16 @@ private:
     EditorModel _editorModel;
     RealVector2D _initialPos;
 
+    //token memory layout derived from the symbol map; parsing the symbols every frame for every
+    //open token tab is too costly, so the layout is rebuilt only when the symbol map changes
+    std::map<int, std::vector<std::string>> _addressToSymbolNamesMap;
+    std::optional<SymbolMap> _symbolMapOfLayout;
+
+    //decompiling a large program on every refresh is visibly slow, so the code tab reuses the
+    //decompiled text while the compiled data is unchanged
+    std::optional<std::string> _decompiledConstData;
+    std::string _decompiledSourcecode;
+
     bool _on = true;
     uint64_t _entityId = 0;
     char _cellCode[1024 * 16];
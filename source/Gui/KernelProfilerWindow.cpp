@@ -0,0 +1,74 @@
+#include "KernelProfilerWindow.h"
+
+#include <imgui.h>
+
+#include "EngineInterface/SimulationController.h"
+
+#include "AlienImGui.h"
+#include "StyleRepository.h"
+
+_KernelProfilerWindow::_KernelProfilerWindow(SimulationController const& simController)
+    : _AlienWindow("Kernel profiler", "windows.kernel profiler", false)
+    , _simController(simController)
+{}
+
+void _KernelProfilerWindow::processIntern()
+{
+    auto profilingEnabled = _simController->isKernelProfilingEnabled();
+    if (AlienImGui::ToggleButton(
+            AlienImGui::ToggleButtonParameters().name("Profiling").tooltip(
+                "While profiling is enabled the timestep kernels are launched individually and timed, which reduces the TPS considerably."),
+            profilingEnabled)) {
+        _simController->setKernelProfilingEnabled(profilingEnabled);
+        _profileCacheState = std::nullopt;
+    }
+
+    //the accumulated timings only change when timesteps run, so the engine is re-queried once
+    //per world change instead of once per rendered frame
+    auto profileState = std::make_pair(_simController->getCurrentTimestep(), _simController->getWorldVersion());
+    if (_profileCacheState != profileState) {
+        _profileCacheState = profileState;
+        _cachedProfileData = _simController->getKernelProfileData();
+    }
+    auto const& profileData = _cachedProfileData;
+    if (0 == profileData.numTimesteps) {
+        ImGui::Spacing();
+        ImGui::TextDisabled("No data collected. Enable profiling and run the simulation.");
+        return;
+    }
+
+    ImGui::SameLine();
+    AlienImGui::Text("Measured time steps: " + std::to_string(profileData.numTimesteps));
+
+    auto totalInMs = 0.0;
+    for (auto const& timing : profileData.totalTimings) {
+        totalInMs += timing.durationInMs;
+    }
+
+    if (ImGui::BeginTable(
+            "Kernel profiler",
+            3,
+            ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersV | ImGuiTableFlags_ScrollY,
+            ImVec2(0, 0))) {
+        ImGui::TableSetupColumn("Kernel", ImGuiTableColumnFlags_WidthStretch);
+        ImGui::TableSetupColumn("Avg time in ms", ImGuiTableColumnFlags_WidthFixed, StyleRepository::getInstance().scaleContent(110.0f));
+        ImGui::TableSetupColumn("Share", ImGuiTableColumnFlags_WidthFixed, StyleRepository::getInstance().scaleContent(60.0f));
+        ImGui::TableSetupScrollFreeze(0, 1);
+        ImGui::TableHeadersRow();
+
+        for (auto const& timing : profileData.totalTimings) {
+            ImGui::TableNextRow();
+
+            ImGui::TableNextColumn();
+            AlienImGui::Text(timing.kernelName);
+
+            ImGui::TableNextColumn();
+            auto avgInMs = timing.durationInMs / profileData.numTimesteps;
+            ImGui::Text("%.4f", avgInMs);
+
+            ImGui::TableNextColumn();
+            ImGui::Text("%.1f%%", timing.durationInMs / totalInMs * 100.0);
+        }
+        ImGui::EndTable();
+    }
+}
@@ -0,0 +1,21 @@
+#pragma once
+
+#include "EngineInterface/Definitions.h"
+#include "EngineInterface/KernelProfileData.h"
+
+#include "Definitions.h"
+#include "AlienWindow.h"
+
+class _KernelProfilerWindow : public _AlienWindow
+{
+public:
+    _KernelProfilerWindow(SimulationController const& simController);
+
+private:
+    void processIntern();
+
+    SimulationController _simController;
+
+    KernelProfileData _cachedProfileData;
+    std::optional<std::pair<uint64_t, uint64_t>> _profileCacheState;  //timestep and world version of the last query
+};
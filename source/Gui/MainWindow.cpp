@@ -31,6 +31,7 @@
 #include "SpatialControlWindow.h"
 #include "SimulationParametersWindow.h"
 #include "StatisticsWindow.h"
+#include "KernelProfilerWindow.h"
 #include "GpuSettingsDialog.h"
 #include "Viewport.h"
 #include "NewSimulationDialog.h"
@@ -66,6 +67,7 @@
 #include "ActivateUserDialog.h"
 #include "DeleteUserDialog.h"
 #include "NetworkSettingsDialog.h"
+#include "PeerSyncDialog.h"
 #include "ResetPasswordDialog.h"
 #include "NewPasswordDialog.h"
 #include "ImageToPatternDialog.h"
@@ -120,6 +122,9 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
         throw std::runtime_error("Failed to initialize GLAD");
     }
 
+    //only the objects needed for the startup screen and the simulation view are built before the
+    //first paint; the secondary windows and dialogs follow in initSecondaryObjects once the
+    //first frame is on screen
     auto worldSize = _simController->getWorldSize();
     _viewport = std::make_shared<_Viewport>(_windowController);
     _uiController = std::make_shared<_UiController>();
@@ -128,15 +133,23 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
     _editorController =
         std::make_shared<_EditorController>(_simController, _viewport);
     _modeController = std::make_shared<_ModeController>(_editorController);
-    _networkController = std::make_shared<_NetworkController>();
     _simulationView = std::make_shared<_SimulationView>(_simController, _modeController, _viewport);
     simulationViewPtr = _simulationView.get();
     _statisticsWindow = std::make_shared<_StatisticsWindow>(_simController);
     _temporalControlWindow = std::make_shared<_TemporalControlWindow>(_simController, _statisticsWindow);
+    _startupController = std::make_shared<_StartupController>(_simController, _temporalControlWindow, _viewport);
+    _fpsController = std::make_shared<_FpsController>();
+
+    _window = windowData.window;
+}
+
+void _MainWindow::initSecondaryObjects()
+{
+    _networkController = std::make_shared<_NetworkController>();
+    _kernelProfilerWindow = std::make_shared<_KernelProfilerWindow>(_simController);
     _spatialControlWindow = std::make_shared<_SpatialControlWindow>(_simController, _viewport);
     _simulationParametersWindow = std::make_shared<_SimulationParametersWindow>(_simController);
     _gpuSettingsDialog = std::make_shared<_GpuSettingsDialog>(_simController);
-    _startupController = std::make_shared<_StartupController>(_simController, _temporalControlWindow, _viewport);
     _flowGeneratorWindow = std::make_shared<_FlowGeneratorWindow>(_simController);
     _aboutDialog = std::make_shared<_AboutDialog>();
     _colorizeDialog = std::make_shared<_ColorizeDialog>(_simController);
@@ -147,7 +160,6 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
     _saveSimulationDialog = std::make_shared<_SaveSimulationDialog>(_simController);
     _displaySettingsDialog = std::make_shared<_DisplaySettingsDialog>(_windowController);
     _patternAnalysisDialog = std::make_shared<_PatternAnalysisDialog>(_simController);
-    _fpsController = std::make_shared<_FpsController>();
     _browserWindow = std::make_shared<_BrowserWindow>(_simController, _networkController, _statisticsWindow, _viewport, _temporalControlWindow);
     _activateUserDialog = std::make_shared<_ActivateUserDialog>(_browserWindow, _networkController);
     _createUserDialog = std::make_shared<_CreateUserDialog>(_activateUserDialog, _networkController);
@@ -157,6 +169,7 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
     _uploadSimulationDialog = std::make_shared<_UploadSimulationDialog>(_browserWindow, _simController, _networkController);
     _deleteUserDialog = std::make_shared<_DeleteUserDialog>(_browserWindow, _networkController);
     _networkSettingsDialog = std::make_shared<_NetworkSettingsDialog>(_browserWindow, _networkController);
+    _peerSyncDialog = std::make_shared<_PeerSyncDialog>(_simController);
     _imageToPatternDialog = std::make_shared<_ImageToPatternDialog>(_viewport, _simController);
 
     //cyclic references
@@ -181,8 +194,6 @@ _MainWindow::_MainWindow(SimulationController const& simController, SimpleLogger
         GLuint texID = reinterpret_cast<uintptr_t>(tex);
         glDeleteTextures(1, &texID);
     };
-
-    _window = windowData.window;
 }
 
 void _MainWindow::mainLoop()
@@ -285,6 +296,13 @@ void _MainWindow::processUninitialized()
     std::this_thread::sleep_for(std::chrono::milliseconds(10));
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     glfwSwapBuffers(_window);
+
+    //the first frame is on screen; the secondary windows and dialogs are built now, while the
+    //logo is displayed and the autosave loads in the background
+    if (!_secondaryObjectsInitialized) {
+        initSecondaryObjects();
+        _secondaryObjectsInitialized = true;
+    }
 }
 
 void _MainWindow::processRequestLoading()
@@ -349,6 +367,7 @@ void _MainWindow::renderSimulation()
     ImGui::Render();
 
     _fpsController->processForceFps(_windowController->getFps());
+    _simController->setFramesPerSecond(_windowController->getFps());
 
     ImGui_ImplOpenGL3_RenderDrawData(ImGui::GetDrawData());
     glfwSwapBuffers(_window);
@@ -416,6 +435,11 @@ void _MainWindow::processMenubar()
             }
             ImGui::EndDisabled();
 
+            ImGui::Separator();
+            if (ImGui::MenuItem("Peer synchronization")) {
+                _peerSyncDialog->show();
+            }
+
             ImGui::Separator();
             ImGui::BeginDisabled(!_networkController->getLoggedInUserName());
             if (ImGui::MenuItem("Delete", "ALT+J")) {
@@ -444,6 +468,9 @@ void _MainWindow::processMenubar()
             if (ImGui::MenuItem("Log", "ALT+6", _logWindow->isOn())) {
                 _logWindow->setOn(!_logWindow->isOn());
             }
+            if (ImGui::MenuItem("Kernel profiler", "ALT+7", _kernelProfilerWindow->isOn())) {
+                _kernelProfilerWindow->setOn(!_kernelProfilerWindow->isOn());
+            }
             AlienImGui::EndMenuButton();
         }
 
@@ -611,6 +638,9 @@ void _MainWindow::processMenubar()
         if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_6)) {
             _logWindow->setOn(!_logWindow->isOn());
         }
+        if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_7)) {
+            _kernelProfilerWindow->setOn(!_kernelProfilerWindow->isOn());
+        }
 
         if (io.KeyAlt && ImGui::IsKeyPressed(GLFW_KEY_E)) {
             _modeController->setMode(
@@ -692,6 +722,7 @@ void _MainWindow::processDialogs()
     _uploadSimulationDialog->process();
     _deleteUserDialog->process();
     _networkSettingsDialog->process();
+    _peerSyncDialog->process();
     _resetPasswordDialog->process();
     _newPasswordDialog->process();
 
@@ -706,6 +737,7 @@ void _MainWindow::processWindows()
     _spatialControlWindow->process();
     _modeController->process();
     _statisticsWindow->process();
+    _kernelProfilerWindow->process();
     _simulationParametersWindow->process();
     _flowGeneratorWindow->process();
     _logWindow->process();
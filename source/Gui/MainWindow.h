@@ -13,6 +13,10 @@ public:
 private:
     char const* initGlfw();  //return glsl version
 
+    //builds the windows and dialogs that are not needed for the startup screen; called once the
+    //first frame has been presented so that the window appears immediately
+    void initSecondaryObjects();
+
     void processUninitialized();
     void processRequestLoading();
     void processLoadingSimulation();
@@ -42,6 +46,7 @@ private:
     SpatialControlWindow _spatialControlWindow;
     SimulationParametersWindow _simulationParametersWindow;
     StatisticsWindow _statisticsWindow;
+    KernelProfilerWindow _kernelProfilerWindow;
     FlowGeneratorWindow _flowGeneratorWindow;
     LogWindow _logWindow;
     GettingStartedWindow _gettingStartedWindow;
@@ -61,6 +66,7 @@ private:
     ActivateUserDialog _activateUserDialog;
     DeleteUserDialog _deleteUserDialog;
     NetworkSettingsDialog _networkSettingsDialog;
+    PeerSyncDialog _peerSyncDialog;
     ResetPasswordDialog _resetPasswordDialog;
     NewPasswordDialog _newPasswordDialog;
     ImageToPatternDialog _imageToPatternDialog;
@@ -86,4 +92,5 @@ private:
     bool _helpMenuToggled = false;
     bool _showExitDialog = false;
     bool _renderSimulation = true;
+    bool _secondaryObjectsInitialized = false;
 };
\ No newline at end of file
@@ -5,6 +5,7 @@
 #include "Fonts/IconsFontAwesome5.h"
 #include "Fonts/AlienIconFont.h"
 
+#include "Base/NumberGenerator.h"
 #include "EngineInterface/SimulationController.h"
 #include "AlienImGui.h"
 #include "EditorModel.h"
@@ -57,21 +58,22 @@ void _MultiplierWindow::processIntern()
             || (_selectionDataAfterMultiplication && _selectionDataAfterMultiplication->compareNumbers(_editorModel->getSelectionShallowData())));
         if (AlienImGui::Button("Build")) {
             _origSelection = _simController->getSelectedSimulationData(true);
-            auto multiplicationResult = [&] {
-                if (_mode == MultiplierMode::Grid) {
-                    return DescriptionHelper::gridMultiply(_origSelection, _gridParameters);
-                }
+
+            //grid mode and random mode without overlapping check need no host-side duplication:
+            //only the per-copy transforms are built here and the copies are stamped on the GPU
+            if (_mode == MultiplierMode::Grid || !_randomParameters._overlappingCheck) {
+                _simController->replicateSelectedEntities(calcReplicationTransforms(), _origSelection.calcCenter());
+            } else {
                 auto data = _simController->getSimulationData();
                 auto overlappingCheckSuccessful = true;
-                auto result = DescriptionHelper::randomMultiply(
+                auto multiplicationResult = DescriptionHelper::randomMultiply(
                     _origSelection, _randomParameters, _simController->getWorldSize(), std::move(data), overlappingCheckSuccessful);
                 if (!overlappingCheckSuccessful) {
                     MessageDialog::getInstance().show("Random multiplication", "Non-overlapping copies could not be created.");
                 }
-                return result;
-            }();
-            _simController->removeSelectedEntities(true);
-            _simController->addAndSelectSimulationData(multiplicationResult);
+                _simController->removeSelectedEntities(true);
+                _simController->addAndSelectSimulationData(multiplicationResult);
+            }
 
             _editorModel->update();
             _selectionDataAfterMultiplication = _editorModel->getSelectionShallowData();
@@ -152,3 +154,38 @@ void _MultiplierWindow::processRandomPanel()
     AlienImGui::Checkbox(AlienImGui::CheckboxParameters().name("Overlapping check").textWidth(MaxContentTextWidth), _randomParameters._overlappingCheck);
 }
 
+std::vector<ReplicationTransform> _MultiplierWindow::calcReplicationTransforms() const
+{
+    std::vector<ReplicationTransform> result;
+    if (_mode == MultiplierMode::Grid) {
+        for (int i = 0; i < _gridParameters._horizontalNumber; ++i) {
+            for (int j = 0; j < _gridParameters._verticalNumber; ++j) {
+                if (0 == i && 0 == j) {
+                    continue;    //the original stays in place
+                }
+                ReplicationTransform transform;
+                transform.posDeltaX = i * _gridParameters._horizontalDistance;
+                transform.posDeltaY = j * _gridParameters._verticalDistance;
+                transform.angle = i * _gridParameters._horizontalAngleInc + j * _gridParameters._verticalAngleInc;
+                transform.velDeltaX = i * _gridParameters._horizontalVelXinc + j * _gridParameters._verticalVelXinc;
+                transform.velDeltaY = i * _gridParameters._horizontalVelYinc + j * _gridParameters._verticalVelYinc;
+                transform.angularVelDelta = i * _gridParameters._horizontalAngularVelInc + j * _gridParameters._verticalAngularVelInc;
+                result.emplace_back(transform);
+            }
+        }
+    } else {
+        auto& numberGen = NumberGenerator::getInstance();
+        auto worldSize = _simController->getWorldSize();
+        for (int i = 0; i < _randomParameters._number; ++i) {
+            ReplicationTransform transform;
+            transform.posDeltaX = toFloat(numberGen.getRandomReal(0, toInt(worldSize.x)));
+            transform.posDeltaY = toFloat(numberGen.getRandomReal(0, toInt(worldSize.y)));
+            transform.angle = toFloat(toInt(numberGen.getRandomReal(_randomParameters._minAngle, _randomParameters._maxAngle)));
+            transform.velDeltaX = toFloat(numberGen.getRandomReal(_randomParameters._minVelX, _randomParameters._maxVelX));
+            transform.velDeltaY = toFloat(numberGen.getRandomReal(_randomParameters._minVelY, _randomParameters._maxVelY));
+            transform.angularVelDelta = toFloat(numberGen.getRandomReal(_randomParameters._minAngularVel, _randomParameters._maxAngularVel));
+            result.emplace_back(transform);
+        }
+    }
+    return result;
+}
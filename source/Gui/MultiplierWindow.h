@@ -3,6 +3,7 @@
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/DescriptionHelper.h"
 #include "EngineInterface/SelectionShallowData.h"
+#include "EngineInterface/ReplicationTransform.h"
 
 #include "Definitions.h"
 #include "AlienWindow.h"
@@ -23,6 +24,9 @@ private:
     void processGridPanel();
     void processRandomPanel();
 
+    //per-copy transforms for the device-side replication, mirroring gridMultiply/randomMultiply
+    std::vector<ReplicationTransform> calcReplicationTransforms() const;
+
     EditorModel _editorModel; 
     SimulationController _simController;
     Viewport _viewport;
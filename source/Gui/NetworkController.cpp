@@ -1,12 +1,24 @@
 #include "NetworkController.h"
 
+#include <atomic>
+#include <iomanip>
+#include <mutex>
+#include <thread>
+
+#include <boost/algorithm/string/join.hpp>
 #include <boost/property_tree/json_parser.hpp>
 
 #define CPPHTTPLIB_OPENSSL_SUPPORT
 #include <cpp-httplib/httplib.h>
+#include <openssl/sha.h>
+#include <zlib.h>
+#include <zstr.hpp>
 
+#include "Base/NumberGenerator.h"
 #include "Base/Resources.h"
 #include "Base/LoggingService.h"
+#include "EngineInterface/ParallelGzipStream.h"
+#include "EngineInterface/Serializer.h"
 
 #include "GlobalSettings.h"
 #include "RemoteSimulationDataParser.h"
@@ -14,11 +26,17 @@
 _NetworkController::_NetworkController()
 {
     _serverAddress = GlobalSettings::getInstance().getStringState("settings.server", "alien-project.org");
+    _simulationListEtag = GlobalSettings::getInstance().getStringState("settings.simulation list cache.etag", "");
+    _simulationListLastModified = GlobalSettings::getInstance().getStringState("settings.simulation list cache.last modified", "");
+    _simulationListBody = GlobalSettings::getInstance().getStringState("settings.simulation list cache.content", "");
 }
 
 _NetworkController::~_NetworkController()
 {
     GlobalSettings::getInstance().setStringState("settings.server", _serverAddress);
+    GlobalSettings::getInstance().setStringState("settings.simulation list cache.etag", _simulationListEtag);
+    GlobalSettings::getInstance().setStringState("settings.simulation list cache.last modified", _simulationListLastModified);
+    GlobalSettings::getInstance().setStringState("settings.simulation list cache.content", _simulationListBody);
 }
 
 std::string _NetworkController::getServerAddress() const
@@ -53,10 +71,116 @@ namespace
         }
     }
 
+    //persistent connection pool: a released client keeps its socket and TLS session alive, so a
+    //follow-up request skips the full handshake that previously preceded every call; each client
+    //serves one request at a time since httplib clients are not safe for concurrent use
+    class ClientPool
+    {
+    public:
+        static ClientPool& getInstance()
+        {
+            static ClientPool instance;
+            return instance;
+        }
+
+        std::shared_ptr<httplib::SSLClient> acquire(std::string const& serverAddress)
+        {
+            {
+                std::lock_guard lock(_mutex);
+                if (serverAddress != _serverAddress) {
+                    _idleClients.clear();    //e.g. after a server change in the network settings
+                    _serverAddress = serverAddress;
+                }
+                if (!_idleClients.empty()) {
+                    auto result = _idleClients.back();
+                    _idleClients.pop_back();
+                    return result;
+                }
+            }
+            auto result = std::make_shared<httplib::SSLClient>(serverAddress);
+            configureClient(*result);
+            result->set_keep_alive(true);
+            return result;
+        }
+
+        void release(std::string const& serverAddress, std::shared_ptr<httplib::SSLClient> client)
+        {
+            std::lock_guard lock(_mutex);
+            if (serverAddress == _serverAddress && _idleClients.size() < MaxIdleClients) {
+                _idleClients.emplace_back(std::move(client));
+            }
+        }
+
+    private:
+        static auto constexpr MaxIdleClients = 4;
+
+        std::mutex _mutex;
+        std::string _serverAddress;
+        std::vector<std::shared_ptr<httplib::SSLClient>> _idleClients;
+    };
+
+    //scoped lease on a pooled client
+    class PooledClient
+    {
+    public:
+        PooledClient(std::string const& serverAddress)
+            : _serverAddress(serverAddress)
+            , _client(ClientPool::getInstance().acquire(serverAddress))
+        {}
+
+        ~PooledClient() { ClientPool::getInstance().release(_serverAddress, std::move(_client)); }
+
+        httplib::SSLClient& operator*() const { return *_client; }
+        httplib::SSLClient* operator->() const { return _client.get(); }
+
+    private:
+        std::string _serverAddress;
+        std::shared_ptr<httplib::SSLClient> _client;
+    };
+
+    //token bucket: short bursts pass through unthrottled, sustained traffic (e.g. from the
+    //background refresh tasks) is limited so that the server is never hammered
+    class RequestRateLimiter
+    {
+    public:
+        static RequestRateLimiter& getInstance()
+        {
+            static RequestRateLimiter instance;
+            return instance;
+        }
+
+        void waitForSlot()
+        {
+            std::unique_lock lock(_mutex);
+            while (true) {
+                auto now = std::chrono::steady_clock::now();
+                auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - _lastRefill).count();
+                _tokens = std::min(toFloat(MaxBurstRequests), _tokens + toFloat(elapsed) * RequestsPerSecond / 1000.0f);
+                _lastRefill = now;
+                if (_tokens >= 1.0f) {
+                    _tokens -= 1.0f;
+                    return;
+                }
+                lock.unlock();
+                std::this_thread::sleep_for(std::chrono::milliseconds(50));
+                lock.lock();
+            }
+        }
+
+    private:
+        static auto constexpr MaxBurstRequests = 10;
+        static auto constexpr RequestsPerSecond = 5.0f;
+
+        std::mutex _mutex;
+        float _tokens = toFloat(MaxBurstRequests);
+        std::chrono::steady_clock::time_point _lastRefill = std::chrono::steady_clock::now();
+    };
+
     httplib::Result executeRequest(std::function<httplib::Result()> const& func, bool withRetry = true)
     {
         auto attempt = 0;
         while(true) {
+            RequestRateLimiter::getInstance().waitForSlot();
             auto result = func();
             if (result) {
                 return result;
@@ -91,14 +215,183 @@ namespace
         }
     }
 
+    uint64_t constexpr TransferChunkSize = 4 * 1024 * 1024;
+
+    std::string calcSha256Hex(char const* data, size_t size)
+    {
+        unsigned char hash[SHA256_DIGEST_LENGTH];
+        SHA256(reinterpret_cast<unsigned char const*>(data), size, hash);
+
+        std::stringstream stream;
+        for (auto byte : hash) {
+            stream << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
+        }
+        return stream.str();
+    }
+
+    std::optional<uint64_t> parseTotalSizeFromContentRange(std::string const& contentRange)
+    {
+        //format: "bytes <first>-<last>/<total>"
+        auto slashPos = contentRange.find('/');
+        if (slashPos == std::string::npos) {
+            return std::nullopt;
+        }
+        try {
+            return std::stoull(contentRange.substr(slashPos + 1));
+        } catch (...) {
+            return std::nullopt;
+        }
+    }
+
+    //pull-based stream source for large downloads: each buffer refill fetches the next range
+    //chunk, so a decompressor or deserializer reading from it never sees more than one chunk of
+    //the body in memory; a dropped connection only costs the chunk in flight thanks to the
+    //per-request retries, and servers that ignore the Range header deliver the whole body with
+    //the first refill
+    class HttpRangeSourceBuf : public std::streambuf
+    {
+    public:
+        HttpRangeSourceBuf(std::string const& serverAddress, std::string const& path, httplib::Params const& params)
+            : _clientLease(serverAddress)
+            , _path(path)
+            , _params(params)
+        {}
+
+        bool failed() const { return _failed; }
+
+    protected:
+        int_type underflow() override
+        {
+            if (gptr() < egptr()) {
+                return traits_type::to_int_type(*gptr());
+            }
+            if (_failed || _finished) {
+                return traits_type::eof();
+            }
+            try {
+                auto last = _offset + TransferChunkSize - 1;
+                httplib::Headers headers = {{"Range", "bytes=" + std::to_string(_offset) + "-" + std::to_string(last)}};
+                if (!_etag.empty()) {
+                    headers.emplace("If-Range", _etag);    //a changed file mid-transfer must not yield a mixed result
+                }
+                auto result = executeRequest([&] { return _clientLease->Get(_path.c_str(), _params, headers); });
+                if (200 == result->status && 0 == _offset) {
+                    _buffer = result->body;    //range not supported => the whole body arrived at once
+                    _finished = true;
+                } else if (206 == result->status) {
+                    if (0 == _offset) {
+                        auto totalSize = parseTotalSizeFromContentRange(result->get_header_value("Content-Range"));
+                        if (!totalSize) {
+                            _failed = true;
+                            return traits_type::eof();
+                        }
+                        _totalSize = *totalSize;
+                        _etag = result->get_header_value("ETag");
+                    }
+                    _buffer = result->body;
+                    _offset += _buffer.size();
+                    if (_buffer.empty() || _offset >= _totalSize) {
+                        _finished = true;
+                    }
+                } else {
+                    _failed = true;
+                    return traits_type::eof();
+                }
+            } catch (...) {
+                _failed = true;
+                return traits_type::eof();
+            }
+            if (_buffer.empty()) {
+                return traits_type::eof();
+            }
+            setg(_buffer.data(), _buffer.data(), _buffer.data() + _buffer.size());
+            return traits_type::to_int_type(*gptr());
+        }
+
+    private:
+        PooledClient _clientLease;
+        std::string _path;
+        httplib::Params _params;
+
+        std::string _buffer;
+        uint64_t _offset = 0;
+        uint64_t _totalSize = 0;
+        std::string _etag;
+        bool _finished = false;
+        bool _failed = false;
+    };
+
+    //saved contents are compressed for autosave speed, not for size; before spending egress
+    //bandwidth the content is recompressed at maximum gzip level, independent of the on-disk
+    //format. The original bytes are kept if recompression does not pay off
+    std::string recompressForUpload(std::string const& content)
+    {
+        try {
+            std::stringstream contentStream(content);
+            zstr::istream decompressor(contentStream, std::ios::binary);
+
+            std::stringstream recompressedStream;
+            ParallelGzipOStream compressor(recompressedStream, Z_BEST_COMPRESSION);
+            std::vector<char> buffer(1024 * 1024);
+            while (decompressor) {
+                decompressor.read(buffer.data(), buffer.size());
+                compressor.write(buffer.data(), decompressor.gcount());
+            }
+            compressor.finish();
+
+            auto result = recompressedStream.str();
+            if (result.size() < content.size()) {
+                log(Priority::Important,
+                    "network: content recompressed from " + std::to_string(content.size() / 1024) + " KB to " + std::to_string(result.size() / 1024)
+                        + " KB");
+                return result;
+            }
+            return content;
+        } catch (...) {
+            return content;    //e.g. content in an unexpected format => upload it as it is
+        }
+    }
+
+    //posts the content in separate, individually retried and hash-verified chunks; a negative
+    //response (e.g. a server without the chunk endpoint) makes the caller fall back to the
+    //single-post upload
+    bool uploadContentChunked(
+        httplib::SSLClient& client,
+        std::string const& userName,
+        std::string const& password,
+        std::string const& uploadId,
+        std::string const& content)
+    {
+        auto numChunks = (content.size() + TransferChunkSize - 1) / TransferChunkSize;
+        for (uint64_t chunkIndex = 0; chunkIndex < numChunks; ++chunkIndex) {
+            auto offset = chunkIndex * TransferChunkSize;
+            auto chunkSize = std::min(TransferChunkSize, content.size() - offset);
+            auto chunk = content.substr(offset, chunkSize);
+
+            httplib::MultipartFormDataItems items = {
+                {"userName", userName, "", ""},
+                {"password", password, "", ""},
+                {"uploadId", uploadId, "", ""},
+                {"chunkIndex", std::to_string(chunkIndex), "", ""},
+                {"numChunks", std::to_string(numChunks), "", ""},
+                {"chunkHash", calcSha256Hex(chunk.data(), chunk.size()), "", ""},
+                {"content", chunk, "", "application/octet-stream"},
+            };
+            auto result = executeRequest([&] { return client.Post("/alien-server/uploadsimulationchunk.php", items); });
+            if (200 != result->status || !parseBoolResult(result->body)) {
+                return false;
+            }
+        }
+        return true;
+    }
 }
 
 bool _NetworkController::createUser(std::string const& userName, std::string const& password, std::string const& email)
 {
     log(Priority::Important, "network: create user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -114,8 +407,8 @@ bool _NetworkController::activateUser(std::string const& userName, std::string c
 {
     log(Priority::Important, "network: activate user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -131,8 +424,8 @@ bool _NetworkController::login(std::string const& userName, std::string const& p
 {
     log(Priority::Important, "network: login user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -160,8 +453,8 @@ bool _NetworkController::deleteUser()
 {
     log(Priority::Important, "network: delete user '" + *_loggedInUserName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -181,8 +474,8 @@ bool _NetworkController::resetPassword(std::string const& userName, std::string
 {
     log(Priority::Important, "network: reset password of user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -197,8 +490,8 @@ bool _NetworkController::setNewPassword(std::string const& userName, std::string
 {
     log(Priority::Important, "network: set new password for user '" + userName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", userName);
@@ -214,30 +507,108 @@ bool _NetworkController::getRemoteSimulationDataList(std::vector<RemoteSimulatio
 {
     log(Priority::Important, "network: get simulation list");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
+
+    //the list rarely changes between refreshes: the last response is revalidated with a
+    //conditional request, so an unchanged list costs one 304 response instead of a full transfer
+    httplib::Headers headers;
+    if (!_simulationListBody.empty()) {
+        if (!_simulationListEtag.empty()) {
+            headers.emplace("If-None-Match", _simulationListEtag);
+        }
+        if (!_simulationListLastModified.empty()) {
+            headers.emplace("If-Modified-Since", _simulationListLastModified);
+        }
+    }
+    auto postResult = executeRequest([&] { return client.Get("/alien-server/getsimulationinfo.php", headers); }, withRetry);
 
-    auto postResult = executeRequest([&] { return client.Get("/alien-server/getsimulationinfo.php"); }, withRetry);
+    auto notModified = 304 == postResult->status;
+    if (notModified && _parsedSimulationList) {
+        result = *_parsedSimulationList;    //not modified and already parsed in this session
+        return true;
+    }
 
+    auto const& body = notModified ? _simulationListBody : postResult->body;
     try {
-        std::stringstream stream(postResult->body);
+        std::stringstream stream(body);
         boost::property_tree::ptree tree;
         boost::property_tree::read_json(stream, tree);
         result.clear();
         result = RemoteSimulationDataParser::decode(tree);
+        if (!notModified) {
+            _simulationListEtag = postResult->get_header_value("ETag");
+            _simulationListLastModified = postResult->get_header_value("Last-Modified");
+
+            //without a validator a conditional request is pointless, so nothing is cached
+            _simulationListBody = _simulationListEtag.empty() && _simulationListLastModified.empty() ? std::string() : postResult->body;
+        }
+        _parsedSimulationList = result;
         return true;
     } catch (...) {
-        logNetworkError(postResult->body);
+        logNetworkError(body);
+
+        //a stale or corrupt cache must not wedge the refresh
+        _simulationListEtag.clear();
+        _simulationListLastModified.clear();
+        _simulationListBody.clear();
+        _parsedSimulationList.reset();
         return false;
     }
 }
 
+std::optional<int> _NetworkController::getRemoteSimulationDataPage(
+    std::vector<RemoteSimulationData>& result,
+    int page,
+    int pageSize,
+    std::string const& filter,
+    std::string const& orderBy,
+    bool withRetry) const
+{
+    log(Priority::Important, "network: get simulation list page " + std::to_string(page));
+
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
+
+    httplib::Params params;
+    params.emplace("page", std::to_string(page));
+    params.emplace("pageSize", std::to_string(pageSize));
+    if (!filter.empty()) {
+        params.emplace("filter", filter);
+    }
+    if (!orderBy.empty()) {
+        params.emplace("orderBy", orderBy);
+    }
+
+    auto postResult = executeRequest([&] { return client.Post("/alien-server/getsimulationinfo.php", params); }, withRetry);
+
+    try {
+        std::stringstream stream(postResult->body);
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(stream, tree);
+
+        //a server without the search index ignores the parameters and answers with the full list
+        //as a plain array instead of the paged object
+        auto totalCount = tree.get_optional<int>("totalCount");
+        auto simulations = tree.get_child_optional("simulations");
+        if (!totalCount || !simulations) {
+            return std::nullopt;
+        }
+        result.clear();
+        result = RemoteSimulationDataParser::decode(*simulations);
+        return *totalCount;
+    } catch (...) {
+        logNetworkError(postResult->body);
+        return std::nullopt;
+    }
+}
+
 bool _NetworkController::getLikedSimulationIdList(std::vector<std::string>& result) const
 {
     log(Priority::Important, "network: get liked simulations");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -265,8 +636,8 @@ bool _NetworkController::getUserLikesForSimulation(std::set<std::string>& result
 {
     log(Priority::Important, "network: get user likes for simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("simId", simId);
@@ -289,12 +660,40 @@ bool _NetworkController::getUserLikesForSimulation(std::set<std::string>& result
     }
 }
 
+bool _NetworkController::getUserLikesForSimulations(std::unordered_map<std::string, std::set<std::string>>& result, std::vector<std::string> const& simIds)
+{
+    log(Priority::Important, "network: get user likes for " + std::to_string(simIds.size()) + " simulations");
+
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
+
+    httplib::Params params;
+    params.emplace("simIds", boost::algorithm::join(simIds, ","));
+
+    auto postResult = executeRequest([&] { return client.Post("/alien-server/getuserlikes.php", params); });
+
+    try {
+        std::stringstream stream(postResult->body);
+        boost::property_tree::ptree tree;
+        boost::property_tree::read_json(stream, tree);
+
+        result.clear();
+        for (auto const& [key, subTree] : tree) {
+            result[subTree.get<std::string>("simId")].insert(subTree.get<std::string>("userName"));
+        }
+        return true;
+    } catch (...) {
+        logNetworkError(postResult->body);
+        return false;
+    }
+}
+
 bool _NetworkController::toggleLikeSimulation(std::string const& simId)
 {
     log(Priority::Important, "network: toggle like for simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
@@ -313,12 +712,15 @@ bool _NetworkController::uploadSimulation(
     int particles,
     std::string const& content,
     std::string const& settings,
-    std::string const& symbolMap)
+    std::string const& symbolMap,
+    std::string const& preview)
 {
     log(Priority::Important, "network: upload simulation with name='" + simulationName + "'");
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    auto contentForUpload = recompressForUpload(content);
+
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::MultipartFormDataItems items = {
         {"userName", *_loggedInUserName, "", ""},
@@ -329,39 +731,83 @@ bool _NetworkController::uploadSimulation(
         {"height", std::to_string(size.y), "", ""},
         {"particles", std::to_string(particles), "", ""},
         {"version", Const::ProgramVersion, "", ""},
-        {"content", content, "", "application/octet-stream"},
         {"settings", settings, "", ""},
         {"symbolMap", symbolMap, "", ""},
+        {"preview", preview, "", "image/png"},    //servers without preview support ignore the field
     };
 
+    //large contents go through the chunked protocol so that a dropped connection only costs the
+    //chunk in flight; the final request then references the upload id instead of carrying the
+    //body. If the server lacks the chunk endpoint, the legacy single-post upload is used
+    if (contentForUpload.size() > TransferChunkSize) {
+        auto uploadId = std::to_string(NumberGenerator::getInstance().getId());
+        if (uploadContentChunked(client, *_loggedInUserName, *_password, uploadId, contentForUpload)) {
+            items.push_back({"uploadId", uploadId, "", ""});
+            auto result = executeRequest([&] { return client.Post("/alien-server/uploadsimulation.php", items); });
+            return parseBoolResult(result->body);
+        }
+        log(Priority::Important, "network: chunked upload not supported by the server, using single-post upload");
+    }
+
+    items.push_back({"content", contentForUpload, "", "application/octet-stream"});
     auto result = executeRequest([&] { return client.Post("/alien-server/uploadsimulation.php", items); });
 
     return parseBoolResult(result->body);
 }
 
-bool _NetworkController::downloadSimulation(std::string& content, std::string& settings, std::string& symbolMap, std::string const& simId)
+bool _NetworkController::downloadSimulation(DeserializedSimulation& result, std::string const& simId)
 {
     log(Priority::Important, "network: download simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("id", simId);
 
     try {
+        std::string settings;
+        std::string symbolMap;
         {
-            auto result = executeRequest([&] { return client.Get("/alien-server/downloadcontent.php", params, {}); });
-            content = result->body;
+            auto getResult = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
+            settings = getResult->body;
         }
         {
-            auto result = executeRequest([&] { return client.Get("/alien-server/downloadsettings.php", params, {}); });
-            settings = result->body;
+            auto getResult = executeRequest([&] { return client.Get("/alien-server/downloadsymbolmap.php", params, {}); });
+            symbolMap = getResult->body;
         }
-        {
-            auto result = executeRequest([&] { return client.Get("/alien-server/downloadsymbolmap.php", params, {}); });
-            symbolMap = result->body;
+
+        //the content is by far the largest part: it is pulled chunk by chunk and decompressed and
+        //deserialized while it is received, so the complete body is never held in memory
+        HttpRangeSourceBuf contentBuf(_serverAddress, "/alien-server/downloadcontent.php", params);
+        std::istream contentStream(&contentBuf);
+        if (!Serializer::deserializeSimulationFromStreams(result, contentStream, settings, symbolMap) || contentBuf.failed()) {
+            log(Priority::Important, "network: an error occurred");
+            return false;
+        }
+        return true;
+    } catch (...) {
+        log(Priority::Important, "network: an error occurred");
+        return false;
+    }
+}
+
+bool _NetworkController::downloadPreview(std::string& preview, std::string const& simId) const
+{
+    log(Priority::Important, "network: download preview for simulation with id=" + simId);
+
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
+
+    httplib::Params params;
+    params.emplace("id", simId);
+
+    try {
+        auto result = executeRequest([&] { return client.Get("/alien-server/downloadpreview.php", params, {}); }, false);
+        if (result->status != 200 || result->body.empty()) {
+            return false;
         }
+        preview = result->body;
         return true;
     } catch (...) {
         log(Priority::Important, "network: an error occurred");
@@ -373,8 +819,8 @@ bool _NetworkController::deleteSimulation(std::string const& simId)
 {
     log(Priority::Important, "network: delete simulation with id=" + simId);
 
-    httplib::SSLClient client(_serverAddress);
-    configureClient(client);
+    PooledClient clientLease(_serverAddress);
+    auto& client = *clientLease;
 
     httplib::Params params;
     params.emplace("userName", *_loggedInUserName);
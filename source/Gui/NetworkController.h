@@ -3,6 +3,8 @@
 #include "RemoteSimulationData.h"
 #include "Definitions.h"
 
+struct DeserializedSimulation;
+
 class _NetworkController
 {
 public:
@@ -23,8 +25,23 @@ public:
     bool setNewPassword(std::string const& userName, std::string const& newPassword, std::string const& confirmationCode);
 
     bool getRemoteSimulationDataList(std::vector<RemoteSimulationData>& result, bool withRetry) const;
+
+    //paged variant: lets the server filter, sort and slice the list and returns the total number
+    //of matching simulations; returns std::nullopt on servers without the search index, making
+    //the caller fall back to the full list with client-side filtering
+    std::optional<int> getRemoteSimulationDataPage(
+        std::vector<RemoteSimulationData>& result,
+        int page,
+        int pageSize,
+        std::string const& filter,
+        std::string const& orderBy,
+        bool withRetry) const;
     bool getLikedSimulationIdList(std::vector<std::string>& result) const;
     bool getUserLikesForSimulation(std::set<std::string>& result, std::string const& simId);
+
+    //batched variant for the browser: fetches the likes of many simulations in one request;
+    //returns false on servers that only know the single-id query
+    bool getUserLikesForSimulations(std::unordered_map<std::string, std::set<std::string>>& result, std::vector<std::string> const& simIds);
     bool toggleLikeSimulation(std::string const& simId);
 
     bool uploadSimulation(
@@ -34,12 +51,27 @@ public:
         int particles,
         std::string const& content,
         std::string const& settings,
-        std::string const& symbolMap);
-    bool downloadSimulation(std::string& content, std::string& settings, std::string& symbolMap, std::string const& simId);
+        std::string const& symbolMap,
+        std::string const& preview);    //png-encoded thumbnail, cached on the server
+    //the content is streamed: it is decompressed and deserialized chunk by chunk while it is
+    //received, so the memory footprint is bounded by the resulting description, not the transfer
+    bool downloadSimulation(DeserializedSimulation& result, std::string const& simId);
+
+    //fetches the png preview of a simulation; returns false if the server holds none (e.g. for
+    //simulations uploaded by older program versions)
+    bool downloadPreview(std::string& preview, std::string const& simId) const;
     bool deleteSimulation(std::string const& simId);
 
 private:
     std::string _serverAddress;
     std::optional<std::string> _loggedInUserName;
     std::optional<std::string> _password;
+
+    //client-side cache for the simulation list: the raw server response and its validators are
+    //persisted via GlobalSettings and revalidated with a conditional request on the next refresh;
+    //mutable because the cache is an implementation detail of the const getter
+    mutable std::string _simulationListEtag;
+    mutable std::string _simulationListLastModified;
+    mutable std::string _simulationListBody;
+    mutable std::optional<std::vector<RemoteSimulationData>> _parsedSimulationList;
 };
@@ -3,6 +3,7 @@
 #include <imgui.h>
 
 #include "EngineInterface/SimulationController.h"
+#include "EngineInterface/WorldGenerationSpec.h"
 #include "Viewport.h"
 #include "StatisticsWindow.h"
 #include "TemporalControlWindow.h"
@@ -26,12 +27,16 @@ _NewSimulationDialog::_NewSimulationDialog(
 {
     _adoptSimulationParameters = GlobalSettings::getInstance().getBoolState("dialogs.new simulation.adopt simulation parameters", true);
     _adoptSymbols = GlobalSettings::getInstance().getBoolState("dialogs.new simulation.adopt symbols", true);
+    _populateRandomly = GlobalSettings::getInstance().getBoolState("dialogs.new simulation.populate randomly", false);
+    _borderBarrier = GlobalSettings::getInstance().getBoolState("dialogs.new simulation.border barrier", false);
 }
 
 _NewSimulationDialog::~_NewSimulationDialog()
 {
     GlobalSettings::getInstance().setBoolState("dialogs.new simulation.adopt simulation parameters", _adoptSimulationParameters);
     GlobalSettings::getInstance().setBoolState("dialogs.new simulation.adopt symbols", _adoptSymbols);
+    GlobalSettings::getInstance().setBoolState("dialogs.new simulation.populate randomly", _populateRandomly);
+    GlobalSettings::getInstance().setBoolState("dialogs.new simulation.border barrier", _borderBarrier);
 }
 
 void _NewSimulationDialog::process()
@@ -48,6 +53,20 @@ void _NewSimulationDialog::process()
         AlienImGui::Checkbox(
             AlienImGui::CheckboxParameters().name("Adopt simulation parameters").textWidth(0), _adoptSimulationParameters);
         AlienImGui::Checkbox(AlienImGui::CheckboxParameters().name("Adopt symbols").textWidth(0), _adoptSymbols);
+        AlienImGui::Checkbox(
+            AlienImGui::CheckboxParameters()
+                .name("Populate randomly")
+                .textWidth(0)
+                .tooltip("Seeds the new world with randomly distributed cells and energy particles, generated directly on the GPU."),
+            _populateRandomly);
+        if (_populateRandomly) {
+            AlienImGui::InputFloat(
+                AlienImGui::InputFloatParameters().name("Cell density").step(0.01f).format("%.4f").textWidth(ContentTextInputWidth), _cellDensity);
+            AlienImGui::InputFloat(
+                AlienImGui::InputFloatParameters().name("Energy particle density").step(0.01f).format("%.4f").textWidth(ContentTextInputWidth),
+                _particleDensity);
+            AlienImGui::Checkbox(AlienImGui::CheckboxParameters().name("Border barrier").textWidth(0), _borderBarrier);
+        }
 
         AlienImGui::Separator();
         if (AlienImGui::Button("OK")) {
@@ -66,6 +85,8 @@ void _NewSimulationDialog::process()
         ImGui::EndPopup();
         _width = std::max(1, _width);
         _height = std::max(1, _height);
+        _cellDensity = std::max(0.0f, _cellDensity);
+        _particleDensity = std::max(0.0f, _particleDensity);
     }
 }
 
@@ -100,6 +121,13 @@ void _NewSimulationDialog::onNewSimulation()
     settings.flowFieldSettings.centers[0].posY = toFloat(_height) / 2;
 
     _simController->newSimulation(0, settings, symbolMap);
+    if (_populateRandomly) {
+        WorldGenerationSpec spec;
+        spec.cellDensity = _cellDensity;
+        spec.particleDensity = _particleDensity;
+        spec.borderBarrier = _borderBarrier;
+        _simController->generateWorld(spec);
+    }
     _viewport->setCenterInWorldPos({toFloat(_width) / 2, toFloat(_height) / 2});
     _viewport->setZoomFactor(4.0f);
     _temporalControlWindow->onSnapshot();
@@ -32,4 +32,8 @@ private:
     bool _adoptSymbols = true;
     int _width = 0;
     int _height = 0;
+    bool _populateRandomly = false;
+    bool _borderBarrier = false;
+    float _cellDensity = 0.02f;
+    float _particleDensity = 0.02f;
 };
\ No newline at end of file
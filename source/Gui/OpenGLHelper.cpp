@@ -29,3 +29,24 @@ auto OpenGLHelper::loadTexture(std::string const& filename) -> TextureData
     stbi_image_free(data);
     return {textureId, width, height};
 }
+
+auto OpenGLHelper::loadTextureFromMemory(std::string const& data) -> std::optional<TextureData>
+{
+    int width, height, nrChannels;
+    unsigned char* pixels = stbi_load_from_memory(
+        reinterpret_cast<unsigned char const*>(data.data()), static_cast<int>(data.size()), &width, &height, &nrChannels, 4);
+    if (!pixels) {
+        return std::nullopt;
+    }
+
+    unsigned int textureId;
+    glGenTextures(1, &textureId);
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+    stbi_image_free(pixels);
+    return TextureData{textureId, width, height};
+}
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "Definitions.h"
 
 class OpenGLHelper
@@ -7,4 +9,8 @@ class OpenGLHelper
 public:
     //returns id
     static TextureData loadTexture(std::string const& filename);
+
+    //creates a texture from encoded image data (e.g. a png downloaded from the server);
+    //returns std::nullopt if the data cannot be decoded
+    static std::optional<TextureData> loadTextureFromMemory(std::string const& data);
 };
@@ -2,6 +2,7 @@
 
 #include <imgui.h>
 
+#include "EngineInterface/DescriptionHelper.h"
 #include "EngineInterface/SimulationController.h"
 #include "EngineInterface/Serializer.h"
 #include "ImFileDialog.h"
@@ -44,7 +45,7 @@ void _OpenPatternDialog::process()
         ClusteredDataDescription content;
         if (Serializer::deserializeContentFromFile(content, firstFilename.string())) {
             auto center = _viewport->getCenterInWorldPos();
-            content.setCenter(center);
+            DescriptionHelper::setCenter(content, center, _simController->getWorldSize());
             _simController->addAndSelectSimulationData(DataDescription(content));
             _editorModel->update();
         } else {
@@ -8,6 +8,7 @@
 #include <ImFileDialog.h>
 
 #include "EngineInterface/Descriptions.h"
+#include "EngineInterface/PatternAnalysis.h"
 #include "EngineInterface/Serializer.h"
 #include "EngineInterface/SimulationController.h"
 #include "GlobalSettings.h"
@@ -51,7 +52,8 @@ void _PatternAnalysisDialog::show()
 
 void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string const& filename)
 {
-    auto const partitionClassDataByDescription = calcPartitionData();
+    //the partitioning itself lives in PatternAnalysis and is shared with the offline analyzer
+    auto const partitionData = PatternAnalysis::calcRepetitiveActiveClusters(_simController->getClusteredSimulationData());
 
     std::ofstream file;
     file.open(filename, std::ios_base::out);
@@ -60,17 +62,8 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
         return;
     }
 
-    int sum = 0;
-    std::vector<PartitionClassData> partitionData;
-    for (auto const& [analysisDesc, partitionClassData] : partitionClassDataByDescription) {
-        if (partitionClassData.numberOfElements > 1 && analysisDesc.hasToken) {
-            partitionData.emplace_back(partitionClassData);
-        }
-    }
-    std::sort(partitionData.begin(), partitionData.end());
-
     file << "number of repetitive active clusters: " << partitionData.size() << std::endl << std::endl;
-    for (auto const& [index, partitionClassData] : partitionData | boost::adaptors::reversed | boost::adaptors::indexed(1)) {
+    for (auto const& [index, partitionClassData] : partitionData | boost::adaptors::indexed(1)) {
 
         file << "cluster " << index << ": " << partitionClassData.numberOfElements << " exemplars" << std::endl;
 
@@ -96,61 +89,3 @@ void _PatternAnalysisDialog::saveRepetitiveActiveClustersToFiles(std::string con
     }
     MessageDialog::getInstance().show("Analysis result", messageStream.str());
 }
-
-auto _PatternAnalysisDialog::calcPartitionData() const -> std::map<ClusterAnalysisDescription, PartitionClassData>
-{
-    auto data = _simController->getClusteredSimulationData();
-
-    std::map<ClusterAnalysisDescription, PartitionClassData> result;
-
-    for (auto const& cluster : data.clusters) {
-        auto const clusterAnalysisData = getAnalysisDescription(cluster);
-        auto& partitionData = result[clusterAnalysisData];
-        if (1 == ++partitionData.numberOfElements) {
-            partitionData.representant = cluster;
-        }
-    }
-    return result;
-}
-
-auto _PatternAnalysisDialog::getAnalysisDescription(ClusterDescription const& cluster) const -> ClusterAnalysisDescription
-{
-    ClusterAnalysisDescription result;
-    result.hasToken = false;
-
-    std::map<uint64_t, CellAnalysisDescription> cellAnalysisDescById;
-    auto insertCellAnalysisDescription = [&cellAnalysisDescById](CellDescription const& cell) {
-        if (cellAnalysisDescById.find(cell.id) == cellAnalysisDescById.end()) {
-            CellAnalysisDescription result;
-            result.maxConnections = cell.maxConnections;
-            result.numConnections = cell.connections.size();
-            result.tokenBlocked = cell.tokenBlocked;
-            result.tokenBranchNumber = cell.tokenBranchNumber;
-            //            result.color = cell.metadata.color;
-
-            CellFeatureAnalysisDescription featureAnalysisData;
-            featureAnalysisData.cellFunction = cell.cellFeature.getType();
-            result.feature = featureAnalysisData;
-
-            cellAnalysisDescById.insert_or_assign(cell.id, result);
-        }
-    };
-
-    std::map<uint64_t, int> cellDescIndexById;
-    for (auto const& [index, cell] : cluster.cells | boost::adaptors::indexed(0)) {
-        cellDescIndexById.insert_or_assign(cell.id, toInt(index));
-    }
-
-    for (auto const& cell : cluster.cells) {
-        insertCellAnalysisDescription(cell);
-        for (auto const& connection : cell.connections) {
-            auto connectingCellId = connection.cellId;
-            insertCellAnalysisDescription(cluster.cells.at(cellDescIndexById.at(connectingCellId)));
-            result.connectedCells.insert(std::set<CellAnalysisDescription>{cellAnalysisDescById.at(cell.id), cellAnalysisDescById.at(connectingCellId)});
-        }
-        if (cell.tokens.size() > 0) {
-            result.hasToken = true;
-        }
-    }
-    return result;
-}
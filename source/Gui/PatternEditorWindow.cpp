@@ -10,6 +10,7 @@
 #include "EngineInterface/SimulationController.h"
 
 #include "EditorModel.h"
+#include "UndoBuffer.h"
 #include "StyleRepository.h"
 #include "GlobalSettings.h"
 #include "AlienImGui.h"
@@ -83,6 +84,14 @@ void _PatternEditorWindow::processIntern()
     }
     ImGui::EndDisabled();
 
+    //undo button
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!_editorModel->getUndoBuffer()->canUndo());
+    if (AlienImGui::ToolbarButton(ICON_FA_UNDO)) {
+        onUndo();
+    }
+    ImGui::EndDisabled();
+
     //inspector button
     ImGui::SameLine();
     ImGui::BeginDisabled(!isInspectionPossible());
@@ -197,41 +206,49 @@ void _PatternEditorWindow::processIntern()
 
         AlienImGui::Group("Color");
         if (colorButton("    ##color1", Const::IndividualCellColor1)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(0, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(0);
         }
         ImGui::SameLine();
         if (colorButton("    ##color2", Const::IndividualCellColor2)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(1, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(1);
         }
         ImGui::SameLine();
         if (colorButton("    ##color3", Const::IndividualCellColor3)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(2, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(2);
         }
         ImGui::SameLine();
         if (colorButton("    ##color4", Const::IndividualCellColor4)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(3, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(3);
         }
         ImGui::SameLine();
         if (colorButton("    ##color5", Const::IndividualCellColor5)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(4, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(4);
         }
         ImGui::SameLine();
         if (colorButton("    ##color6", Const::IndividualCellColor6)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(5, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(5);
         }
         ImGui::SameLine();
         if (colorButton("    ##color7", Const::IndividualCellColor7)) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->colorSelectedEntities(6, _editorModel->isRolloutToClusters());
             _editorModel->setDefaultColorCode(6);
         }
         AlienImGui::Group("Further actions");
         if (ImGui::Button("Set uniform velocities")) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->uniformVelocitiesForSelectedEntities(_editorModel->isRolloutToClusters());
         }
         ImGui::EndDisabled();
@@ -239,6 +256,7 @@ void _PatternEditorWindow::processIntern()
         ImGui::BeginDisabled(_editorModel->isCellSelectionEmpty());
 
         if (ImGui::Button("Release stresses")) {
+            captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
             _simController->relaxSelectedEntities(_editorModel->isRolloutToClusters());
         }
         if (ImGui::Button("Generate token pathways")) {
@@ -299,6 +317,9 @@ bool _PatternEditorWindow::isCopyingPossible() const
 void _PatternEditorWindow::onCopy()
 {
     _copiedSelection = _simController->getSelectedSimulationData(_editorModel->isRolloutToClusters());
+    _copiedSelectionWorldVersion = _simController->getWorldVersion();
+    _copiedSelectionTimestep = _simController->getCurrentTimestep();
+    _copiedSelectionRolloutToClusters = _editorModel->isRolloutToClusters();
 }
 
 bool _PatternEditorWindow::isPastingPossible() const
@@ -308,9 +329,23 @@ bool _PatternEditorWindow::isPastingPossible() const
 
 void _PatternEditorWindow::onPaste()
 {
-    auto data = *_copiedSelection;
     auto center = _viewport->getCenterInWorldPos();
-    data.setCenter(center);
+
+    //fast path: while the world is unchanged since the copy the clipboard equals the live
+    //selection and is cloned directly on the GPU instead of re-uploading the description
+    if (_copiedSelectionWorldVersion == _simController->getWorldVersion()
+        && _copiedSelectionTimestep == _simController->getCurrentTimestep()) {
+        auto const& selection = _editorModel->getSelectionShallowData();
+        auto selectionCenter = _copiedSelectionRolloutToClusters
+            ? RealVector2D(selection.clusterCenterPosX, selection.clusterCenterPosY)
+            : RealVector2D(selection.centerPosX, selection.centerPosY);
+        _simController->cloneSelectedEntities(center - selectionCenter, _copiedSelectionRolloutToClusters);
+        _editorModel->update();
+        return;
+    }
+
+    auto data = *_copiedSelection;
+    DescriptionHelper::setCenter(data, center, _simController->getWorldSize());
     _simController->addAndSelectSimulationData(data);
     _editorModel->update();
 }
@@ -322,16 +357,41 @@ bool _PatternEditorWindow::isDeletingPossible() const
 
 void _PatternEditorWindow::onDelete()
 {
+    captureUndoSnapshot(_UndoBuffer::RestoreMode::AddEntities);
     _simController->removeSelectedEntities(_editorModel->isRolloutToClusters());
     _editorModel->update();
 }
 
+void _PatternEditorWindow::onUndo()
+{
+    auto snapshot = _editorModel->getUndoBuffer()->fetchSnapshotForUndo();
+    if (!snapshot) {
+        return;
+    }
+
+    //a modifying operation left its entities in place and still selected, so they are replaced;
+    //after a deleting operation the selection is empty and nothing is removed
+    if (_UndoBuffer::RestoreMode::ReplaceSelection == snapshot->mode) {
+        _simController->removeSelectedEntities(snapshot->includeClusters);
+    }
+    _simController->addAndSelectSimulationData(snapshot->data);
+    _editorModel->update();
+}
+
+void _PatternEditorWindow::captureUndoSnapshot(_UndoBuffer::RestoreMode mode)
+{
+    auto includeClusters = _editorModel->isRolloutToClusters();
+    _editorModel->getUndoBuffer()->capture(_simController->getSelectedSimulationData(includeClusters), mode, includeClusters);
+}
+
 void _PatternEditorWindow::onGenerateBranchNumbers()
 {
     auto dataWithClusters = _simController->getSelectedSimulationData(true);
     auto dataWithoutClusters = _simController->getSelectedSimulationData(false);
     std::unordered_set<uint64_t> cellIds = dataWithoutClusters.getCellIds();
 
+    _editorModel->getUndoBuffer()->capture(dataWithClusters, _UndoBuffer::RestoreMode::ReplaceSelection, true);
+
     auto parameters = _simController->getSimulationParameters();
     DescriptionHelper::generateBranchNumbers(dataWithClusters, cellIds, parameters.cellMaxTokenBranchNumber);
 
@@ -341,16 +401,19 @@ void _PatternEditorWindow::onGenerateBranchNumbers()
 
 void _PatternEditorWindow::onMakeSticky()
 {
+    captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
     _simController->makeSticky(_editorModel->isRolloutToClusters());
 }
 
 void _PatternEditorWindow::onRemoveStickiness()
 {
+    captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
     _simController->removeStickiness(_editorModel->isRolloutToClusters());
 }
 
 void _PatternEditorWindow::onSetBarrier(bool value)
 {
+    captureUndoSnapshot(_UndoBuffer::RestoreMode::ReplaceSelection);
     _simController->setBarrier(value, _editorModel->isRolloutToClusters());
 }
 
@@ -5,6 +5,7 @@
 #include "EngineInterface/Descriptions.h"
 #include "Definitions.h"
 #include "AlienWindow.h"
+#include "UndoBuffer.h"
 
 class _PatternEditorWindow : public _AlienWindow
 {
@@ -23,10 +24,15 @@ public:
     void onPaste();
     bool isDeletingPossible() const;
     void onDelete();
+    void onUndo();
 
 private:
     void processIntern() override;
 
+    //extracts the current selection and deposits it in the undo buffer; called before every
+    //destructive operation
+    void captureUndoSnapshot(_UndoBuffer::RestoreMode mode);
+
     void onGenerateBranchNumbers();
     void onMakeSticky();
     void onRemoveStickiness();
@@ -44,4 +50,10 @@ private:
     float _angularVel = 0;
     std::optional<SelectionShallowData> _lastSelection;
     std::optional<DataDescription> _copiedSelection;
+
+    //identifies the world state at copy time: while the world is unchanged the clipboard equals
+    //the live selection and pasting can clone it directly on the GPU
+    uint64_t _copiedSelectionWorldVersion = 0;
+    uint64_t _copiedSelectionTimestep = 0;
+    bool _copiedSelectionRolloutToClusters = false;
 };
\ No newline at end of file
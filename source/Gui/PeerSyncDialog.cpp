@@ -0,0 +1,224 @@
+#include "PeerSyncDialog.h"
+
+#include <sstream>
+
+#include <boost/algorithm/string.hpp>
+#include <boost/property_tree/json_parser.hpp>
+#include <imgui.h>
+
+#define CPPHTTPLIB_OPENSSL_SUPPORT
+#include <cpp-httplib/httplib.h>
+
+#include "Base/LoggingService.h"
+#include "Base/StringHelper.h"
+#include "EngineInterface/Descriptions.h"
+#include "EngineInterface/Serializer.h"
+#include "EngineInterface/SimulationController.h"
+
+#include "AlienImGui.h"
+#include "GlobalSettings.h"
+#include "MessageDialog.h"
+#include "StyleRepository.h"
+
+namespace
+{
+    auto const MaxContentTextWidth = 150.0f;
+
+    std::string encodeManifest(uint64_t timestep, std::vector<ClusterDescription> const& clusters)
+    {
+        boost::property_tree::ptree tree;
+        tree.put("timestep", timestep);
+        boost::property_tree::ptree clustersTree;
+        for (auto const& cluster : clusters) {
+            boost::property_tree::ptree clusterTree;
+            clusterTree.put("id", cluster.id);
+            clusterTree.put("hash", Serializer::calcClusterHash(cluster));
+            clustersTree.push_back(std::make_pair("", clusterTree));
+        }
+        tree.add_child("clusters", clustersTree);
+
+        std::stringstream stream;
+        boost::property_tree::write_json(stream, tree);
+        return stream.str();
+    }
+}
+
+_PeerSyncDialog::_PeerSyncDialog(SimulationController const& simController)
+    : _simController(simController)
+{
+    _peerAddress = GlobalSettings::getInstance().getStringState("dialogs.peer sync.peer address", "");
+    _port = GlobalSettings::getInstance().getIntState("dialogs.peer sync.port", _port);
+}
+
+_PeerSyncDialog::~_PeerSyncDialog()
+{
+    GlobalSettings::getInstance().setStringState("dialogs.peer sync.peer address", _peerAddress);
+    GlobalSettings::getInstance().setIntState("dialogs.peer sync.port", _port);
+    if (_server) {
+        _server->stop();
+        _serverThread.join();
+    }
+}
+
+void _PeerSyncDialog::process()
+{
+    if (!_show) {
+        return;
+    }
+    ImGui::OpenPopup("Peer synchronization");
+    if (ImGui::BeginPopupModal("Peer synchronization", NULL, ImGuiWindowFlags_None)) {
+        AlienImGui::Text("Provide world to peers");
+        AlienImGui::InputInt(AlienImGui::InputIntParameters().name("Port").textWidth(MaxContentTextWidth), _port);
+        if (AlienImGui::Button(_server ? "Stop providing" : "Start providing")) {
+            onToggleServing();
+        }
+
+        AlienImGui::Separator();
+
+        AlienImGui::Text("Fetch world from peer");
+        AlienImGui::InputText(AlienImGui::InputTextParameters().name("Peer address").textWidth(MaxContentTextWidth), _peerAddress);
+        if (AlienImGui::Button("Synchronize now")) {
+            onSynchronize();
+        }
+        if (!_lastSyncResult.empty()) {
+            AlienImGui::Text(_lastSyncResult);
+        }
+
+        AlienImGui::Separator();
+
+        if (AlienImGui::Button("Close")) {
+            ImGui::CloseCurrentPopup();
+            _show = false;
+        }
+        ImGui::SetItemDefaultFocus();
+
+        ImGui::EndPopup();
+    }
+}
+
+void _PeerSyncDialog::show()
+{
+    _show = true;
+}
+
+void _PeerSyncDialog::onToggleServing()
+{
+    if (_server) {
+        _server->stop();
+        _serverThread.join();
+        _server.reset();
+        log(Priority::Important, "peer sync: stopped providing");
+        return;
+    }
+
+    auto server = std::make_shared<httplib::Server>();
+    auto simController = _simController;
+
+    //the manifest lists every cluster with its content hash so that a peer can decide which
+    //clusters it actually needs
+    server->Get("/world-sync/manifest", [simController](httplib::Request const& request, httplib::Response& response) {
+        auto content = simController->getClusteredSimulationData();
+        response.set_content(encodeManifest(simController->getCurrentTimestep(), content.clusters), "application/json");
+    });
+
+    //delivers the requested clusters together with all particles; particles are small compared to
+    //the clusters and carry no stable identity, so they are always transferred as a whole
+    server->Get("/world-sync/clusters", [simController](httplib::Request const& request, httplib::Response& response) {
+        std::unordered_set<uint64_t> ids;
+        std::vector<std::string> idStrings;
+        boost::split(idStrings, request.get_param_value("ids"), boost::is_any_of(","));
+        for (auto const& idString : idStrings) {
+            if (!idString.empty()) {
+                ids.insert(std::stoull(idString));
+            }
+        }
+
+        auto content = simController->getClusteredSimulationData();
+        ClusteredDataDescription payload;
+        for (auto& cluster : content.clusters) {
+            if (ids.find(cluster.id) != ids.end()) {
+                payload.clusters.emplace_back(std::move(cluster));
+            }
+        }
+        payload.particles = std::move(content.particles);
+
+        std::string serializedPayload;
+        if (!Serializer::serializeContentToString(serializedPayload, payload)) {
+            response.status = 500;
+            return;
+        }
+        response.set_content(serializedPayload, "application/octet-stream");
+    });
+
+    _server = server;
+    auto port = _port;
+    _serverThread = std::thread([server, port] { server->listen("0.0.0.0", port); });
+    log(Priority::Important, "peer sync: providing world on port " + std::to_string(_port));
+}
+
+void _PeerSyncDialog::onSynchronize()
+{
+    try {
+        log(Priority::Important, "peer sync: synchronize with " + _peerAddress);
+
+        httplib::Client client(_peerAddress);
+        client.set_read_timeout(60, 0);
+
+        auto manifestResult = client.Get("/world-sync/manifest");
+        if (!manifestResult || 200 != manifestResult->status) {
+            throw std::runtime_error("The peer could not be reached.");
+        }
+        std::stringstream manifestStream(manifestResult->body);
+        boost::property_tree::ptree manifestTree;
+        boost::property_tree::read_json(manifestStream, manifestTree);
+        auto peerTimestep = manifestTree.get<uint64_t>("timestep");
+        std::unordered_map<uint64_t, uint64_t> peerHashById;
+        for (auto const& [key, clusterTree] : manifestTree.get_child("clusters")) {
+            peerHashById.emplace(clusterTree.get<uint64_t>("id"), clusterTree.get<uint64_t>("hash"));
+        }
+
+        //unchanged clusters are reused from the local world; only clusters the peer has in a
+        //different or unknown version are transferred
+        auto localContent = _simController->getClusteredSimulationData();
+        ClusteredDataDescription nextContent;
+        std::unordered_set<uint64_t> reusedIds;
+        for (auto& cluster : localContent.clusters) {
+            auto peerHash = peerHashById.find(cluster.id);
+            if (peerHash != peerHashById.end() && peerHash->second == Serializer::calcClusterHash(cluster)) {
+                reusedIds.insert(cluster.id);
+                nextContent.clusters.emplace_back(std::move(cluster));
+            }
+        }
+        std::vector<std::string> idsToFetch;
+        for (auto const& [id, hash] : peerHashById) {
+            if (reusedIds.find(id) == reusedIds.end()) {
+                idsToFetch.emplace_back(std::to_string(id));
+            }
+        }
+
+        httplib::Params params;
+        params.emplace("ids", boost::algorithm::join(idsToFetch, ","));
+        auto payloadResult = client.Get("/world-sync/clusters", params, {});
+        if (!payloadResult || 200 != payloadResult->status) {
+            throw std::runtime_error("The peer could not deliver the changed clusters.");
+        }
+        ClusteredDataDescription fetchedContent;
+        if (!Serializer::deserializeContentFromString(fetchedContent, payloadResult->body)) {
+            throw std::runtime_error("The received world data could not be read.");
+        }
+        for (auto& cluster : fetchedContent.clusters) {
+            nextContent.clusters.emplace_back(std::move(cluster));
+        }
+        nextContent.particles = std::move(fetchedContent.particles);
+
+        _simController->clear();
+        _simController->setClusteredSimulationData(nextContent);
+        _simController->setCurrentTimestep(peerTimestep);
+
+        _lastSyncResult = std::to_string(idsToFetch.size()) + " of " + std::to_string(peerHashById.size()) + " clusters transferred ("
+            + StringHelper::format(toInt(payloadResult->body.size() / 1024)) + " KB)";
+        log(Priority::Important, "peer sync: " + _lastSyncResult);
+    } catch (std::exception const& e) {
+        MessageDialog::getInstance().show("Error", e.what());
+    }
+}
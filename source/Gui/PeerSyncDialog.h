@@ -0,0 +1,39 @@
+#pragma once
+
+#include <thread>
+
+#include "EngineInterface/Definitions.h"
+
+#include "Definitions.h"
+
+namespace httplib
+{
+    class Server;
+}
+
+class _PeerSyncDialog
+{
+public:
+    _PeerSyncDialog(SimulationController const& simController);
+
+    ~_PeerSyncDialog();
+
+    void process();
+
+    void show();
+
+private:
+    void onToggleServing();
+    void onSynchronize();
+
+    SimulationController _simController;
+
+    bool _show = false;
+    std::string _peerAddress;
+    int _port = 27363;
+    std::string _lastSyncResult;
+
+    //serving runs on its own thread since httplib's listen call blocks
+    std::shared_ptr<httplib::Server> _server;
+    std::thread _serverThread;
+};
@@ -17,7 +17,8 @@ enum RemoteSimulationDataColumnId
     RemoteSimulationDataColumnId_Particles,
     RemoteSimulationDataColumnId_FileSize,
     RemoteSimulationDataColumnId_Version,
-    RemoteSimulationDataColumnId_Actions
+    RemoteSimulationDataColumnId_Actions,
+    RemoteSimulationDataColumnId_Preview
 };
 
 class RemoteSimulationData
@@ -3,10 +3,16 @@
 #include <imgui.h>
 
 #include "Base/StringHelper.h"
+#include "EngineInterface/Enums.h"
 #include "StyleRepository.h"
 #include "GlobalSettings.h"
 #include "EditorModel.h"
 
+namespace
+{
+    char const* const CellFunctionNames[] = {"Computation", "Communication", "Scanner", "Digestion", "Construction", "Sensor", "Muscle"};
+}
+
 _SelectionWindow::_SelectionWindow(EditorModel const& editorModel)
     : _AlienWindow("Selection", "editor.selection", true), _editorModel(editorModel)
 {
@@ -35,4 +41,32 @@ void _SelectionWindow::processIntern()
     ImGui::TextUnformatted(StringHelper::format(selection.numParticles).c_str());
     ImGui::PopStyleColor();
     ImGui::PopFont();
+
+    ImGui::Text("Total energy");
+    ImGui::PushFont(StyleRepository::getInstance().getLargeFont());
+    ImGui::PushStyleColor(ImGuiCol_Text, Const::TextDecentColor);
+    ImGui::TextUnformatted(StringHelper::format(selection.cellEnergy + selection.particleEnergy, 0).c_str());
+    ImGui::PopStyleColor();
+    ImGui::PopFont();
+
+    //composition of the selected cells, reduced on the GPU together with the counts above
+    if (selection.numCells > 0) {
+        ImGui::Text("Cell functions");
+        ImGui::PushStyleColor(ImGuiCol_Text, Const::TextDecentColor);
+        for (int i = 0; i < Enums::CellFunction_Count; ++i) {
+            if (selection.numCellsByFunction[i] > 0) {
+                ImGui::Text("%s: %s", CellFunctionNames[i], StringHelper::format(selection.numCellsByFunction[i]).c_str());
+            }
+        }
+        ImGui::PopStyleColor();
+
+        ImGui::Text("Cell colors");
+        ImGui::PushStyleColor(ImGuiCol_Text, Const::TextDecentColor);
+        for (int i = 0; i < 7; ++i) {
+            if (selection.numCellsByColor[i] > 0) {
+                ImGui::Text("Color %d: %s", i + 1, StringHelper::format(selection.numCellsByColor[i]).c_str());
+            }
+        }
+        ImGui::PopStyleColor();
+    }
 }
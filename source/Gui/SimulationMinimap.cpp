@@ -0,0 +1,150 @@
+#include "SimulationMinimap.h"
+
+#include <algorithm>
+
+#include <glad/glad.h>
+#include <imgui.h>
+
+#include "EngineInterface/SimulationController.h"
+#include "Viewport.h"
+#include "StyleRepository.h"
+
+namespace
+{
+    //horizontal resolution of the world thumbnail; the vertical resolution follows from the
+    //world aspect ratio
+    auto const ThumbnailWidth = 256;
+
+    //a changed world triggers a thumbnail refresh at most this often
+    auto const ThumbnailRefreshInterval = std::chrono::milliseconds(500);
+
+    auto const ViewMarkerColor = IM_COL32(255, 255, 255, 160);
+}
+
+_SimulationMinimap::_SimulationMinimap(SimulationController const& simController, Viewport const& viewport)
+    : _simController(simController)
+    , _viewport(viewport)
+{
+    glGenTextures(1, &_textureId);
+    glBindTexture(GL_TEXTURE_2D, _textureId);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+}
+
+_SimulationMinimap::~_SimulationMinimap()
+{
+    glDeleteTextures(1, &_textureId);
+}
+
+void _SimulationMinimap::process(RealRect const& rect)
+{
+    updateThumbnailIfNecessary();
+    if (!_thumbnailPresent) {
+        return;
+    }
+
+    processEvents(rect);
+
+    auto size = rect.bottomRight - rect.topLeft;
+    ImGuiWindowFlags windowFlags =
+        ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_NoDecoration;
+
+    ImGui::SetNextWindowPos(ImVec2(rect.topLeft.x, rect.topLeft.y));
+    ImGui::SetNextWindowSize(ImVec2(size.x, size.y));
+    ImGui::SetNextWindowBgAlpha(Const::WindowAlpha * ImGui::GetStyle().Alpha);
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowBorderSize, 0);
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+    ImGui::Begin("SimMinimap", NULL, windowFlags);
+
+    auto drawList = ImGui::GetWindowDrawList();
+    drawList->AddImage(
+        reinterpret_cast<ImTextureID>(static_cast<intptr_t>(_textureId)),
+        ImVec2(rect.topLeft.x, rect.topLeft.y),
+        ImVec2(rect.bottomRight.x, rect.bottomRight.y));
+
+    auto markerRect = calcViewMarkerRect(rect);
+    ImColor markerColor = ImColor(ViewMarkerColor);
+    markerColor.Value.w *= ImGui::GetStyle().Alpha;
+    drawList->AddRect(
+        ImVec2(markerRect.topLeft.x, markerRect.topLeft.y),
+        ImVec2(markerRect.bottomRight.x, markerRect.bottomRight.y),
+        markerColor);
+
+    ImGui::End();
+    ImGui::PopStyleVar(2);
+}
+
+void _SimulationMinimap::processEvents(RealRect const& rect)
+{
+    auto mousePos = ImGui::GetMousePos();
+    auto mouseInside = mousePos.x >= rect.topLeft.x && mousePos.x <= rect.bottomRight.x && mousePos.y >= rect.topLeft.y
+        && mousePos.y <= rect.bottomRight.y;
+
+    if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && mouseInside) {
+        _dragActive = true;
+    }
+    if (_dragActive && ImGui::IsMouseDown(ImGuiMouseButton_Left)) {
+        auto size = rect.bottomRight - rect.topLeft;
+        auto worldSize = _simController->getWorldSize();
+        auto relPos = RealVector2D{
+            std::min(std::max((mousePos.x - rect.topLeft.x) / size.x, 0.0f), 1.0f),
+            std::min(std::max((mousePos.y - rect.topLeft.y) / size.y, 0.0f), 1.0f)};
+        _viewport->setCenterInWorldPos({relPos.x * worldSize.x, relPos.y * worldSize.y});
+    }
+    if (ImGui::IsMouseReleased(ImGuiMouseButton_Left)) {
+        _dragActive = false;
+    }
+}
+
+void _SimulationMinimap::updateThumbnailIfNecessary()
+{
+    auto timestep = _simController->getCurrentTimestep();
+    auto worldVersion = _simController->getWorldVersion();
+    auto worldUnchanged = _thumbnailPresent && timestep == _lastTimestep && worldVersion == _lastWorldVersion;
+    auto now = std::chrono::steady_clock::now();
+    if (worldUnchanged || (_lastRefreshTimepoint && now - *_lastRefreshTimepoint < ThumbnailRefreshInterval)) {
+        return;
+    }
+    _lastTimestep = timestep;
+    _lastWorldVersion = worldVersion;
+    _lastRefreshTimepoint = now;
+
+    auto worldSize = _simController->getWorldSize();
+    IntVector2D thumbnailSize{ThumbnailWidth, std::max(1, ThumbnailWidth * worldSize.y / worldSize.x)};
+    auto thumbnail = _simController->getThumbnail(thumbnailSize);
+
+    //converts the 16 bit lanes in bbbbggggrrrr format to 8 bit rgba for the texture upload
+    std::vector<unsigned char> rgba(static_cast<size_t>(thumbnailSize.x) * thumbnailSize.y * 4);
+    for (size_t i = 0; i < thumbnail.size(); ++i) {
+        auto pixel = thumbnail[i];
+        rgba[i * 4] = static_cast<unsigned char>((pixel >> 8) & 0xff);
+        rgba[i * 4 + 1] = static_cast<unsigned char>((pixel >> 24) & 0xff);
+        rgba[i * 4 + 2] = static_cast<unsigned char>((pixel >> 40) & 0xff);
+        rgba[i * 4 + 3] = 0xff;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, _textureId);
+    if (thumbnailSize.x != _thumbnailSize.x || thumbnailSize.y != _thumbnailSize.y) {
+        glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, thumbnailSize.x, thumbnailSize.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+        _thumbnailSize = thumbnailSize;
+    } else {
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, thumbnailSize.x, thumbnailSize.y, GL_RGBA, GL_UNSIGNED_BYTE, rgba.data());
+    }
+    _thumbnailPresent = true;
+}
+
+RealRect _SimulationMinimap::calcViewMarkerRect(RealRect const& rect) const
+{
+    auto worldSize = _simController->getWorldSize();
+    auto worldRect = _viewport->getVisibleWorldRect();
+    auto size = rect.bottomRight - rect.topLeft;
+
+    auto toMinimapPos = [&](RealVector2D const& worldPos) {
+        return RealVector2D{
+            rect.topLeft.x + std::min(std::max(worldPos.x / worldSize.x, 0.0f), 1.0f) * size.x,
+            rect.topLeft.y + std::min(std::max(worldPos.y / worldSize.y, 0.0f), 1.0f) * size.y};
+    };
+    return {toMinimapPos(worldRect.topLeft), toMinimapPos(worldRect.bottomRight)};
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <chrono>
+
+#include "Base/Definitions.h"
+#include "EngineInterface/Definitions.h"
+
+#include "Definitions.h"
+
+class _SimulationMinimap
+{
+public:
+    _SimulationMinimap(SimulationController const& simController, Viewport const& viewport);
+    ~_SimulationMinimap();
+
+    void process(RealRect const& rect);
+
+private:
+    void processEvents(RealRect const& rect);
+    void updateThumbnailIfNecessary();
+    RealRect calcViewMarkerRect(RealRect const& rect) const;
+
+    SimulationController _simController;
+    Viewport _viewport;
+
+    unsigned int _textureId = 0;
+    IntVector2D _thumbnailSize{0, 0};
+    bool _thumbnailPresent = false;
+
+    //change detection: the thumbnail is only re-rendered when the world (timestep + world
+    //version) has changed and the refresh interval has elapsed
+    uint64_t _lastTimestep = 0;
+    uint64_t _lastWorldVersion = 0;
+    std::optional<std::chrono::steady_clock::time_point> _lastRefreshTimepoint;
+
+    bool _dragActive = false;
+};
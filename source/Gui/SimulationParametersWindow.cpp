@@ -162,6 +162,16 @@ void _SimulationParametersWindow::processBase(
                 .tooltip(std::string("Time duration calculated in a single step. Smaller values increase the accuracy "
                                      "of the simulation.")),
             simParameters.timestepSize);
+        AlienImGui::SliderInt(
+            AlienImGui::SliderIntParameters()
+                .name("Particle subcycling stride")
+                .textWidth(MaxContentTextWidth)
+                .defaultValue(origSimParameters.particleSubcyclingStride)
+                .min(1)
+                .max(8)
+                .tooltip(std::string("Energy particles far away from any cell are only updated every given number of time steps (with a "
+                                     "correspondingly larger step). A value of 1 disables subcycling.")),
+            simParameters.particleSubcyclingStride);
 
         /**
          * General physics
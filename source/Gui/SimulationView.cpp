@@ -7,6 +7,7 @@
 #include "EngineInterface/SimulationController.h"
 
 #include "Shader.h"
+#include "SimulationMinimap.h"
 #include "SimulationScrollbar.h"
 #include "Viewport.h"
 #include "ModeController.h"
@@ -19,6 +20,14 @@ namespace
     auto const MotionBlurZooming = 0.5f;
     auto const ZoomFactorForOverlay = 16.0f;
 
+    //the renderer presents the previously completed frame and draws the new one asynchronously,
+    //so the texture is up to date only after two draw calls with unchanged content
+    auto const NumDrawCallsUntilTextureCurrent = 2;
+
+    //an unchanged view is still re-rendered at a low rate as a safety net for changes that are
+    //not covered by the world version (e.g. edited simulation parameters)
+    auto const StaticViewRefreshInterval = std::chrono::milliseconds(500);
+
     std::unordered_map<Enums::CellFunction, std::string> cellFunctionToStringMap = {
         {Enums::CellFunction_Computation, "Computation"},
         {Enums::CellFunction_Communication, "Communication"},
@@ -46,6 +55,7 @@ _SimulationView::_SimulationView(
         "SimScrollbarX", _SimulationScrollbar ::Orientation::Horizontal, _simController, _viewport);
     _scrollbarY = std::make_shared<_SimulationScrollbar>(
         "SimScrollbarY", _SimulationScrollbar::Orientation::Vertical, _simController, _viewport);
+    _minimap = std::make_shared<_SimulationMinimap>(_simController, _viewport);
 
     // set up vertex data (and buffer(s)) and configure vertex attributes
     // ------------------------------------------------------------------
@@ -250,10 +260,6 @@ void _SimulationView::processContent()
 
 void _SimulationView::processControls()
 {
-    auto worldRect = _viewport->getVisibleWorldRect();
-    auto visibleWorldSize = worldRect.bottomRight - worldRect.topLeft;
-    auto worldSize = _simController->getWorldSize();
-
     ImGuiStyle& style = ImGui::GetStyle();
     float childHeight = 1 + style.ScrollbarSize + style.WindowPadding.y * 2.0f;
     float childWidth = 1 + style.ScrollbarSize + style.WindowPadding.x * 2.0f;
@@ -266,6 +272,19 @@ void _SimulationView::processControls()
     _scrollbarY->process(
         {{viewport->Size.x - scrollbarThickness, viewport->Pos.y + mainMenubarHeight},
          {1, viewport->Size.y - 1 - scrollbarThickness}});
+
+    //minimap in the lower left corner above the horizontal scrollbar, sized to the world aspect
+    //ratio with a fixed maximum extent
+    auto worldSize = _simController->getWorldSize();
+    auto maxMinimapExtent = StyleRepository::getInstance().scaleContent(200.0f);
+    RealVector2D minimapSize;
+    if (worldSize.x >= worldSize.y) {
+        minimapSize = {maxMinimapExtent, maxMinimapExtent * toFloat(worldSize.y) / toFloat(worldSize.x)};
+    } else {
+        minimapSize = {maxMinimapExtent * toFloat(worldSize.x) / toFloat(worldSize.y), maxMinimapExtent};
+    }
+    RealVector2D minimapTopLeft{viewport->Pos.x, viewport->Size.y - scrollbarThickness - minimapSize.y};
+    _minimap->process({minimapTopLeft, minimapTopLeft + minimapSize});
 }
 
 bool _SimulationView::isOverlayActive() const
@@ -278,25 +297,54 @@ void _SimulationView::setOverlayActive(bool active)
     _isOverlayActive = active;
 }
 
+bool _SimulationView::RenderedView::operator==(RenderedView const& other) const
+{
+    return timestep == other.timestep && worldVersion == other.worldVersion && worldRect.topLeft == other.worldRect.topLeft
+        && worldRect.bottomRight == other.worldRect.bottomRight && viewSize == other.viewSize && zoom == other.zoom
+        && overlayActive == other.overlayActive;
+}
+
 void _SimulationView::updateImageFromSimulation()
 {
     auto worldRect = _viewport->getVisibleWorldRect();
     auto viewSize = _viewport->getViewSize();
     auto zoomFactor = _viewport->getZoomFactor();
-
-    if (_isOverlayActive && zoomFactor >= ZoomFactorForOverlay) {
-        auto overlay = _simController->tryDrawVectorGraphicsAndReturnOverlay(
-            worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
-        if (overlay) {
-            std::sort(overlay->elements.begin(), overlay->elements.end(), [](OverlayElementDescription const& left, OverlayElementDescription const& right) {
-                return left.id < right.id;
-            });
-            _overlay = overlay;
+    auto overlayActive = _isOverlayActive && zoomFactor >= ZoomFactorForOverlay;
+
+    //as long as neither the world (timestep + world version, which also covers edit operations)
+    //nor the view has changed, the texture already shows the correct frame and the renderer is
+    //not invoked; with a TPS restriction this decouples the render kernels from the gui frame
+    //rate, while the motion blur keeps accumulating in the fragment shader over the persistent
+    //framebuffer texture
+    RenderedView currentView{
+        _simController->getCurrentTimestep(), _simController->getWorldVersion(), worldRect, viewSize, zoomFactor, overlayActive};
+    auto now = std::chrono::steady_clock::now();
+    auto viewUnchanged = _lastRenderedView && *_lastRenderedView == currentView;
+    auto skipRendering = viewUnchanged && _numEqualFrames >= NumDrawCallsUntilTextureCurrent && _lastRenderTimepoint
+        && now - *_lastRenderTimepoint < StaticViewRefreshInterval;
+
+    //the cached overlay below is still drawn when the rendering is skipped, since the gui
+    //redraws from scratch every frame
+    if (!skipRendering) {
+        _numEqualFrames = viewUnchanged ? _numEqualFrames + 1 : 0;
+        _lastRenderedView = currentView;
+        _lastRenderTimepoint = now;
+
+        if (overlayActive) {
+            auto overlay = _simController->tryDrawVectorGraphicsAndReturnOverlay(
+                worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
+            if (overlay) {
+                std::sort(
+                    overlay->elements.begin(),
+                    overlay->elements.end(),
+                    [](OverlayElementDescription const& left, OverlayElementDescription const& right) { return left.id < right.id; });
+                _overlay = overlay;
+            }
+        } else {
+            _simController->tryDrawVectorGraphics(
+                worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
+            _overlay = std::nullopt;
         }
-    } else {
-        _simController->tryDrawVectorGraphics(
-            worldRect.topLeft, worldRect.bottomRight, {viewSize.x, viewSize.y}, zoomFactor);
-        _overlay = std::nullopt;
     }
 
     if(_overlay) {
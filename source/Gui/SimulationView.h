@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "Base/Definitions.h"
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/OverlayDescriptions.h"
@@ -42,6 +44,7 @@ private:
     //widgets
     SimulationScrollbar _scrollbarX;
     SimulationScrollbar _scrollbarY;
+    SimulationMinimap _minimap;
 
     //overlay
     bool _isOverlayActive = false;
@@ -60,6 +63,24 @@ private:
     std::optional<RealVector2D> _worldPosForMovement;
     std::optional<IntVector2D> _prevMousePosInt;
 
+    //change detection: while neither the world (timestep + world version) nor the view has
+    //changed, the renderer is skipped and the texture keeps showing the cached frame; this
+    //covers paused simulations as well as gui frames between timesteps at restricted TPS
+    struct RenderedView
+    {
+        uint64_t timestep = 0;
+        uint64_t worldVersion = 0;
+        RealRect worldRect;
+        IntVector2D viewSize;
+        float zoom = 0;
+        bool overlayActive = false;
+
+        bool operator==(RenderedView const& other) const;
+    };
+    std::optional<RenderedView> _lastRenderedView;
+    int _numEqualFrames = 0;
+    std::optional<std::chrono::steady_clock::time_point> _lastRenderTimepoint;
+
     Viewport _viewport;
     ModeController _modeWindow;
     SimulationController _simController;
@@ -13,6 +13,11 @@
 #include "GlobalSettings.h"
 #include "AlienImGui.h"
 
+namespace
+{
+    std::chrono::milliseconds const CenterOnSelectionUpdate(30);
+}
+
 _SpatialControlWindow::_SpatialControlWindow(SimulationController const& simController, Viewport const& viewport)
     : _AlienWindow("Spatial control", "windows.spatial control", true)
     , _simController(simController)
@@ -27,6 +32,8 @@ void _SpatialControlWindow::processIntern()
     processZoomOutButton();
     ImGui::SameLine();
     processResizeButton();
+    ImGui::SameLine();
+    processFreezeButton();
 
     ImGui::Spacing();
     ImGui::Spacing();
@@ -61,6 +68,18 @@ void _SpatialControlWindow::processIntern()
         ImGui::PopStyleColor();
         ImGui::PopFont();
 
+        if (_freezeZone) {
+            ImGui::Text("Freeze zone");
+            ImGui::PushFont(StyleRepository::getInstance().getLargeFont());
+            ImGui::PushStyleColor(ImGuiCol_Text, Const::TextDecentColor);
+            ImGui::TextUnformatted(
+                (StringHelper::format(_freezeZone->topLeft.x, 0) + ", " + StringHelper::format(_freezeZone->topLeft.y, 0) + " - "
+                 + StringHelper::format(_freezeZone->bottomRight.x, 0) + ", " + StringHelper::format(_freezeZone->bottomRight.y, 0))
+                    .c_str());
+            ImGui::PopStyleColor();
+            ImGui::PopFont();
+        }
+
         AlienImGui::Separator();
         AlienImGui::ToggleButton(AlienImGui::ToggleButtonParameters().name("Autotracking on selection"), _centerSelection);
         ImGui::Spacing();
@@ -104,6 +123,19 @@ void _SpatialControlWindow::processResizeButton()
     }
 }
 
+void _SpatialControlWindow::processFreezeButton()
+{
+    //freezes the simulation in the currently visible world rect; a second click releases the zone
+    if (AlienImGui::ToolbarButton(ICON_FA_SNOWFLAKE)) {
+        if (_freezeZone) {
+            _freezeZone = std::nullopt;
+        } else {
+            _freezeZone = _viewport->getVisibleWorldRect();
+        }
+        _simController->setFreezeZone(_freezeZone);
+    }
+}
+
 void _SpatialControlWindow::processResizeDialog()
 {
     ImVec2 center = ImGui::GetMainViewport()->GetCenter();
@@ -163,11 +195,21 @@ void _SpatialControlWindow::processResizeDialog()
 
 void _SpatialControlWindow::processCenterOnSelection()
 {
-    if (_centerSelection && _simController->isSimulationRunning()) {
-        auto shallowData = _simController->getSelectionShallowData();
-        if (shallowData.numCells > 0 || shallowData.numParticles > 0) {
-            _viewport->setCenterInWorldPos({shallowData.centerPosX, shallowData.centerPosY});
-        }
+    if (!_centerSelection || !_simController->isSimulationRunning()) {
+        return;
+    }
+
+    //reading the selection data acquires the engine access gate, so the position is polled on a
+    //fixed cadence instead of once per rendered frame
+    auto timePoint = std::chrono::steady_clock::now();
+    if (_lastSelectionQueryTimePoint && timePoint - *_lastSelectionQueryTimePoint < CenterOnSelectionUpdate) {
+        return;
+    }
+    _lastSelectionQueryTimePoint = timePoint;
+
+    auto shallowData = _simController->getSelectionShallowData();
+    if (shallowData.numCells > 0 || shallowData.numParticles > 0) {
+        _viewport->setCenterInWorldPos({shallowData.centerPosX, shallowData.centerPosY});
     }
 }
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <chrono>
+
 #include "EngineInterface/Definitions.h"
 #include "EngineInterface/Descriptions.h"
 
@@ -18,6 +20,7 @@ private:
     void processZoomInButton();
     void processZoomOutButton();
     void processResizeButton();
+    void processFreezeButton();
 
     void processResizeDialog();
     void processCenterOnSelection();
@@ -28,8 +31,10 @@ private:
     Viewport _viewport;
 
     bool _showResizeDialog = false;
+    std::optional<RealRect> _freezeZone;
     bool _scaleContent = false;
     bool _centerSelection = false;
+    std::optional<std::chrono::steady_clock::time_point> _lastSelectionQueryTimePoint;
     int _width = 0;
     int _height = 0;
 };
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "StartupController.h"
 
+#include <fstream>
+
 #include <imgui.h>
 
 #include "Base/Definitions.h"
@@ -17,6 +19,31 @@ namespace
     std::chrono::milliseconds::rep const LogoDuration = 1500;
     std::chrono::milliseconds::rep const FadeOutDuration = 1500;
     std::chrono::milliseconds::rep const FadeInDuration = 500;
+
+    //raw snapshots start with this marker (see EngineWorker::writeSnapshotFile); the format
+    //matters here because legacy autosaves contain a serialized description whose costly parse
+    //belongs on the loader thread
+    std::string const RawSnapshotPrefix = "alien raw snapshot";
+
+    bool isRawSnapshotFile(std::string const& filename)
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        if (!stream) {
+            return false;
+        }
+        std::string prefix(RawSnapshotPrefix.size(), '\0');
+        stream.read(prefix.data(), prefix.size());
+        return stream && prefix == RawSnapshotPrefix;
+    }
+
+    //reads the file once so that the memory-mapped upload on the gui thread hits the page cache
+    void warmFileCache(std::string const& filename)
+    {
+        std::ifstream stream(filename, std::ios::binary);
+        std::vector<char> buffer(1 << 20);
+        while (stream.read(buffer.data(), buffer.size()) || stream.gcount() > 0) {
+        }
+    }
 }
 
 _StartupController::_StartupController(SimulationController const& simController, TemporalControlWindow const& temporalControlWindow, Viewport const& viewport)
@@ -26,31 +53,74 @@ _StartupController::_StartupController(SimulationController const& simController
 {
     _logo = OpenGLHelper::loadTexture(Const::LogoFilename);
     _startupTimepoint = std::chrono::steady_clock::now();
+
+    //the disk reads and the parse run concurrently with the logo display
+    _loaderThread = std::thread([this] { loadAutosave(); });
+}
+
+_StartupController::~_StartupController()
+{
+    joinLoaderThread();
+}
+
+void _StartupController::loadAutosave()
+{
+    auto& loaded = _loadedAutosave;
+    loaded.auxiliaryDataLoaded = Serializer::deserializeAuxiliaryDataFromFiles(
+        loaded.data.timestep, loaded.data.settings, loaded.data.symbolMap, Const::AutosaveFile);
+    if (loaded.auxiliaryDataLoaded) {
+        if (isRawSnapshotFile(Const::AutosaveFile)) {
+            loaded.isRawSnapshot = true;
+            warmFileCache(Const::AutosaveFile);
+        } else {
+            //older autosaves contain a serialized description instead of a raw snapshot
+            loaded.contentLoaded = Serializer::deserializeContentFromFile(loaded.data.content, Const::AutosaveFile);
+        }
+    }
+    _loaderFinished.store(true);
+}
+
+void _StartupController::joinLoaderThread()
+{
+    if (_loaderThread.joinable()) {
+        _loaderThread.join();
+    }
 }
 
 void _StartupController::process()
 {
     if (_state == State::Unintialized) {
-        processWindow();
         auto now = std::chrono::steady_clock::now();
         auto millisecSinceStartup =
             std::chrono::duration_cast<std::chrono::milliseconds>(now - *_startupTimepoint).count();
-        if (millisecSinceStartup > LogoDuration) {
+
+        //a slow disk keeps the logo with a loading hint on screen instead of freezing the window
+        _showLoadingHint = millisecSinceStartup > LogoDuration && !_loaderFinished.load();
+        processWindow();
+        if (millisecSinceStartup > LogoDuration && _loaderFinished.load()) {
+            _showLoadingHint = false;
             activate();
         }
         return;
     }
 
     if (_state == State::RequestLoading) {
-        DeserializedSimulation deserializedData;
-        if (!Serializer::deserializeSimulationFromFiles(deserializedData, Const::AutosaveFile)) {
+        joinLoaderThread();
+        auto& deserializedData = _loadedAutosave.data;
+        if (!_loadedAutosave.auxiliaryDataLoaded) {
             MessageDialog::getInstance().show("Error", "The default simulation file could not be read. An empty simulation will be created.");
+            deserializedData.timestep = 0;
             deserializedData.settings.generalSettings.worldSizeX = 1000;
             deserializedData.settings.generalSettings.worldSizeY = 500;
         }
 
         _simController->newSimulation(deserializedData.timestep, deserializedData.settings, deserializedData.symbolMap);
-        _simController->setClusteredSimulationData(deserializedData.content);
+        if (_loadedAutosave.isRawSnapshot) {
+            _simController->loadSimulationDataFromFile(Const::AutosaveFile);
+        } else if (_loadedAutosave.contentLoaded) {
+            _simController->setClusteredSimulationData(deserializedData.content);
+            deserializedData.content = {};  //the parsed description is no longer needed
+        }
         _viewport->setCenterInWorldPos(
             {toFloat(deserializedData.settings.generalSettings.worldSizeX) / 2,
              toFloat(deserializedData.settings.generalSettings.worldSizeY) / 2});
@@ -138,4 +208,13 @@ void _StartupController::processWindow()
         {center.x - styleRep.scaleContent(50), center.y + styleRep.scaleContent(220)},
         textColor,
         ("Version " + Const::ProgramVersion).c_str());
+
+    if (_showLoadingHint) {
+        drawList->AddText(
+            styleRep.getMediumFont(),
+            styleRep.scaleContent(20.0f),
+            {center.x - styleRep.scaleContent(80), center.y + styleRep.scaleContent(260)},
+            textColor,
+            "Loading simulation ...");
+    }
 }
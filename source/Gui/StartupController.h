@@ -1,14 +1,18 @@
 #pragma once
 
+#include <atomic>
 #include <chrono>
+#include <thread>
 
 #include "EngineInterface/Definitions.h"
+#include "EngineInterface/Serializer.h"
 #include "Definitions.h"
 
 class _StartupController
 {
 public:
     _StartupController(SimulationController const& simController, TemporalControlWindow const& temporalControlWindow, Viewport const& viewport);
+    ~_StartupController();
 
     void process();
     enum class State
@@ -25,6 +29,8 @@ public:
 
 private:
     void processWindow();
+    void loadAutosave();  //runs on the loader thread
+    void joinLoaderThread();
 
     SimulationController _simController;
     TemporalControlWindow _temporalControlWindow;
@@ -34,4 +40,18 @@ private:
     TextureData _logo;
     std::optional<std::chrono::steady_clock::time_point> _startupTimepoint;
     std::optional<std::chrono::steady_clock::time_point> _lastActivationTimepoint;
+
+    //the autosave is read and parsed on a background thread while the logo is displayed, so the
+    //first paint does not wait for the disk; the gui thread only performs the engine upload
+    struct LoadedAutosave
+    {
+        DeserializedSimulation data;
+        bool auxiliaryDataLoaded = false;
+        bool isRawSnapshot = false;
+        bool contentLoaded = false;  //legacy autosaves: description parsed into data.content
+    };
+    LoadedAutosave _loadedAutosave;
+    std::atomic<bool> _loaderFinished{false};
+    std::thread _loaderThread;
+    bool _showLoadingHint = false;
 };
@@ -0,0 +1,185 @@
+#include "StatisticsFileRecorder.h"
+
+#include <filesystem>
+#include <sstream>
+#include <iomanip>
+
+#include "Base/LoggingService.h"
+
+namespace
+{
+    auto constexpr MaxQueuedSamples = 10000;  //samples are dropped beyond this if the disk cannot keep up
+
+    std::string composeFilename(std::string const& baseFilename, int fileIndex)
+    {
+        auto path = std::filesystem::path(baseFilename);
+        std::stringstream suffix;
+        suffix << "_" << std::setfill('0') << std::setw(4) << fileIndex;
+        auto result = path;
+        result.replace_filename(path.stem().string() + suffix.str() + path.extension().string());
+        return result.string();
+    }
+}
+
+_StatisticsFileRecorder::_StatisticsFileRecorder()
+{
+    _thread = std::thread(&_StatisticsFileRecorder::recordingLoop, this);
+}
+
+_StatisticsFileRecorder::~_StatisticsFileRecorder()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _terminateThread = true;
+    }
+    _conditionVariable.notify_one();
+    if (_thread.joinable()) {
+        _thread.join();
+    }
+}
+
+void _StatisticsFileRecorder::startRecording(std::string const& filename, int timestepInterval, int maxSamplesPerFile)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _baseFilename = filename;
+        _maxSamplesPerFile = maxSamplesPerFile;
+        _resetRequested = true;
+    }
+    _timestepInterval = timestepInterval;
+    _lastRecordedTimestep.reset();
+    _recording = true;
+    log(Priority::Important, "statistics recording to '" + filename + "' started");
+}
+
+void _StatisticsFileRecorder::stopRecording()
+{
+    _recording = false;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _closeFileRequested = true;
+    }
+    _conditionVariable.notify_one();
+    log(Priority::Important, "statistics recording stopped");
+}
+
+bool _StatisticsFileRecorder::isRecording() const
+{
+    return _recording;
+}
+
+void _StatisticsFileRecorder::record(MonitorData const& statistics)
+{
+    if (!_recording) {
+        return;
+    }
+    if (_lastRecordedTimestep && statistics.timeStep < *_lastRecordedTimestep + _timestepInterval) {
+        return;
+    }
+    _lastRecordedTimestep = statistics.timeStep;
+
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_queue.size() >= MaxQueuedSamples) {
+            return;
+        }
+        _queue.emplace_back(statistics);
+    }
+    _conditionVariable.notify_one();
+}
+
+void _StatisticsFileRecorder::recordingLoop()
+{
+    for (;;) {
+        std::vector<MonitorData> samples;
+        bool reset;
+        bool close;
+        bool terminate;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _conditionVariable.wait(lock, [this] { return !_queue.empty() || _closeFileRequested || _terminateThread; });
+            samples.assign(_queue.begin(), _queue.end());
+            _queue.clear();
+            reset = _resetRequested;
+            close = _closeFileRequested;
+            terminate = _terminateThread;
+            _resetRequested = false;
+            _closeFileRequested = false;
+            if (reset) {
+                _currentBaseFilename = _baseFilename;
+                _currentMaxSamplesPerFile = _maxSamplesPerFile;
+            }
+        }
+        if (reset) {
+            closeFile();
+            _fileIndex = 0;
+        }
+
+        writeSamples(samples);
+
+        if (close || terminate) {
+            closeFile();
+        }
+        if (terminate) {
+            return;
+        }
+    }
+}
+
+void _StatisticsFileRecorder::writeSamples(std::vector<MonitorData> const& samples)
+{
+    for (auto const& statistics : samples) {
+        if (!_file.is_open() || _numSamplesInFile >= _currentMaxSamplesPerFile) {
+            openNextFile();
+            if (!_file.is_open()) {
+                return;
+            }
+        }
+
+        int numCells = 0;
+        for (int i = 0; i < 7; ++i) {
+            numCells += statistics.numCellsByColor[i];
+        }
+        _file << statistics.timeStep << ", " << numCells;
+        for (int i = 0; i < 7; ++i) {
+            _file << ", " << statistics.numCellsByColor[i];
+        }
+        _file << ", " << statistics.numConnections << ", " << statistics.numParticles << ", " << statistics.numTokens << ", " << statistics.numCreatedCells
+              << ", " << statistics.numSuccessfulAttacks << ", " << statistics.numFailedAttacks << ", " << statistics.numMuscleActivities << ", "
+              << statistics.numCreatedConnections << ", " << statistics.numDestroyedConnections << ", " << statistics.numDeletedCells << ", "
+              << statistics.numMovedTokens << ", " << statistics.totalInternalEnergy << "\n";
+        ++_numSamplesInFile;
+    }
+
+    //one flush per batch: a crash loses at most the samples of the last batch
+    if (_file.is_open()) {
+        _file.flush();
+    }
+}
+
+void _StatisticsFileRecorder::openNextFile()
+{
+    closeFile();
+
+    auto filename = composeFilename(_currentBaseFilename, _fileIndex);
+    _file.open(filename, std::ios_base::out);
+    if (!_file) {
+        log(Priority::Important, "statistics recording: the file '" + filename + "' could not be opened");
+        return;
+    }
+    ++_fileIndex;
+    _numSamplesInFile = 0;
+
+    _file << "time step, cells, cells (color 0), cells (color 1), cells (color 2), cells (color 3), cells (color 4), cells (color 5), cells (color 6), "
+          << "cell connections, particles, tokens, created cells, successful attacks, failed attacks, muscle activities, "
+          << "created connections, destroyed connections, deleted cells, moved tokens, internal energy"
+          << "\n";
+}
+
+void _StatisticsFileRecorder::closeFile()
+{
+    if (_file.is_open()) {
+        _file.close();
+    }
+    _numSamplesInFile = 0;
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <thread>
+
+#include "EngineInterface/MonitorData.h"
+
+#include "Definitions.h"
+
+class _StatisticsFileRecorder
+{
+public:
+    _StatisticsFileRecorder();
+    ~_StatisticsFileRecorder();
+
+    void startRecording(std::string const& filename, int timestepInterval, int maxSamplesPerFile);
+    void stopRecording();
+    bool isRecording() const;
+
+    //called once per frame on the GUI thread; only enqueues the sample, the formatting and the
+    //disk write run on the recorder thread
+    void record(MonitorData const& statistics);
+
+private:
+    void recordingLoop();
+    void writeSamples(std::vector<MonitorData> const& samples);
+    void openNextFile();
+    void closeFile();
+
+    //GUI thread only
+    bool _recording = false;
+    int _timestepInterval = 1000;
+    std::optional<uint64_t> _lastRecordedTimestep;
+
+    //shared between the GUI thread and the recorder thread
+    std::mutex _mutex;
+    std::condition_variable _conditionVariable;
+    std::deque<MonitorData> _queue;
+    std::string _baseFilename;
+    int _maxSamplesPerFile = 100000;
+    bool _resetRequested = false;
+    bool _closeFileRequested = false;
+    bool _terminateThread = false;
+
+    //recorder thread only
+    std::ofstream _file;
+    std::string _currentBaseFilename;
+    int _currentMaxSamplesPerFile = 0;
+    int _fileIndex = 0;
+    int _numSamplesInFile = 0;
+
+    std::thread _thread;
+};
@@ -1,15 +1,30 @@
 #include "StatisticsHistory.h"
 
+#include <algorithm>
+
 #include "EngineInterface/MonitorData.h"
 
 #include <imgui.h>
 
+namespace
+{
+    auto constexpr TruncateBlockSize = 500;
+}
+
 void LiveStatistics::truncate()
 {
-    if (!timepointsHistory.empty() && timepointsHistory.back() - timepointsHistory.front() > (MaxLiveHistory + 1.0f)) {
-        timepointsHistory.erase(timepointsHistory.begin());
-        for(auto& data : datas) {
-            data.erase(data.begin());
+    //outdated samples are dropped in blocks: erasing them one by one would copy the entire
+    //history every frame
+    if (timepointsHistory.empty()) {
+        return;
+    }
+    auto cutoff = timepointsHistory.back() - (MaxLiveHistory + 1.0f);
+    auto numOutdated =
+        std::lower_bound(timepointsHistory.begin(), timepointsHistory.end(), cutoff) - timepointsHistory.begin();
+    if (numOutdated > TruncateBlockSize) {
+        timepointsHistory.erase(timepointsHistory.begin(), timepointsHistory.begin() + numOutdated);
+        for (auto& data : datas) {
+            data.erase(data.begin(), data.begin() + numOutdated);
         }
     }
 }
@@ -35,26 +50,70 @@ void LiveStatistics::add(MonitorData const& newStatistics)
     datas[12].emplace_back(toFloat(newStatistics.numSuccessfulAttacks));
     datas[13].emplace_back(toFloat(newStatistics.numFailedAttacks));
     datas[14].emplace_back(toFloat(newStatistics.numMuscleActivities));
+    datas[15].emplace_back(toFloat(newStatistics.numCreatedConnections));
+    datas[16].emplace_back(toFloat(newStatistics.numDestroyedConnections));
+    datas[17].emplace_back(toFloat(newStatistics.numDeletedCells));
+    datas[18].emplace_back(toFloat(newStatistics.numMovedTokens));
 }
 
 void LongtermStatistics::add(MonitorData const& newStatistics)
 {
-    if (timestepHistory.empty() || newStatistics.timeStep - timestepHistory.back() > LongtermTimestepDelta) {
+    if (timestepHistory.empty() || toFloat(newStatistics.timeStep) - timestepHistory.back() > timestepDelta) {
+        condenseIfFull();
+
         timestepHistory.emplace_back(toFloat(newStatistics.timeStep));
+        std::array<float, 19> values;
         int numCells = 0;
         for (int i = 0; i < 7; ++i) {
             numCells += newStatistics.numCellsByColor[i];
         }
-        datas[0].emplace_back(toFloat(numCells));
+        values[0] = toFloat(numCells);
         for (int i = 0; i < 7; ++i) {
-            datas[1 + i].emplace_back(toFloat(newStatistics.numCellsByColor[i]));
+            values[1 + i] = toFloat(newStatistics.numCellsByColor[i]);
+        }
+        values[8] = toFloat(newStatistics.numConnections);
+        values[9] = toFloat(newStatistics.numParticles);
+        values[10] = toFloat(newStatistics.numTokens);
+        values[11] = toFloat(newStatistics.numCreatedCells);
+        values[12] = toFloat(newStatistics.numSuccessfulAttacks);
+        values[13] = toFloat(newStatistics.numFailedAttacks);
+        values[14] = toFloat(newStatistics.numMuscleActivities);
+        values[15] = toFloat(newStatistics.numCreatedConnections);
+        values[16] = toFloat(newStatistics.numDestroyedConnections);
+        values[17] = toFloat(newStatistics.numDeletedCells);
+        values[18] = toFloat(newStatistics.numMovedTokens);
+
+        //a fresh bin contains a single sample
+        for (int i = 0; i < 19; ++i) {
+            datas[i].emplace_back(values[i]);
+            datasMin[i].emplace_back(values[i]);
+            datasMax[i].emplace_back(values[i]);
+        }
+    }
+}
+
+void LongtermStatistics::condenseIfFull()
+{
+    if (timestepHistory.size() < MaxSamples) {
+        return;
+    }
+
+    //merge adjacent bins: the history covers the same time range at half the resolution while
+    //the minima and maxima of the merged bins are preserved
+    auto newSize = timestepHistory.size() / 2;
+    for (size_t i = 0; i < newSize; ++i) {
+        timestepHistory[i] = timestepHistory[2 * i];
+    }
+    timestepHistory.resize(newSize);
+    for (int j = 0; j < 19; ++j) {
+        for (size_t i = 0; i < newSize; ++i) {
+            datas[j][i] = (datas[j][2 * i] + datas[j][2 * i + 1]) / 2;
+            datasMin[j][i] = std::min(datasMin[j][2 * i], datasMin[j][2 * i + 1]);
+            datasMax[j][i] = std::max(datasMax[j][2 * i], datasMax[j][2 * i + 1]);
         }
-        datas[8].emplace_back(toFloat(newStatistics.numConnections));
-        datas[9].emplace_back(toFloat(newStatistics.numParticles));
-        datas[10].emplace_back(toFloat(newStatistics.numTokens));
-        datas[11].emplace_back(toFloat(newStatistics.numCreatedCells));
-        datas[12].emplace_back(toFloat(newStatistics.numSuccessfulAttacks));
-        datas[13].emplace_back(toFloat(newStatistics.numFailedAttacks));
-        datas[14].emplace_back(toFloat(newStatistics.numMuscleActivities));
+        datas[j].resize(newSize);
+        datasMin[j].resize(newSize);
+        datasMax[j].resize(newSize);
     }
+    timestepDelta *= 2;
 }
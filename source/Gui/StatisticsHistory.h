@@ -12,20 +12,33 @@ struct LiveStatistics
     float history = 10.0f;   //in seconds
 
     std::vector<float> timepointsHistory;
-    std::array<std::vector<float>, 15>
-        datas;  //cells, cells by colors (7x), particles, tokens, created cells, successful attacks, failed attacks, muscle activities
+    std::array<std::vector<float>, 19>
+        datas;  //cells, cells by colors (7x), particles, tokens, created cells, successful attacks, failed attacks, muscle activities,
+                //created connections, destroyed connections, deleted cells, moved tokens
 
     void truncate();
     void add(MonitorData const& statistics);
 };
 
+//bounded history over an unlimited time range: when the buffers are full, adjacent samples are
+//merged to min/max/avg bins and the sample interval doubles, so the memory and the plot cost
+//stay constant for arbitrarily long runs
 struct LongtermStatistics
 {
     static float constexpr LongtermTimestepDelta = 1000.0f;
+    static int constexpr MaxSamples = 2048;
+
+    float timestepDelta = LongtermTimestepDelta;  //doubles with every merge
 
     std::vector<float> timestepHistory;
-    std::array<std::vector<float>, 15>
-        datas;  //cells, cells by colors (7x), particles, tokens, created cells, successful attacks, failed attacks, muscle activities
+    std::array<std::vector<float>, 19>
+        datas;  //bin averages: cells, cells by colors (7x), particles, tokens, created cells, successful attacks, failed attacks, muscle activities,
+                //created connections, destroyed connections, deleted cells, moved tokens
+    std::array<std::vector<float>, 19> datasMin;
+    std::array<std::vector<float>, 19> datasMax;
 
     void add(MonitorData const& statistics);
+
+private:
+    void condenseIfFull();
 };
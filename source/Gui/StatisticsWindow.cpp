@@ -13,12 +13,14 @@
 #include "GlobalSettings.h"
 #include "AlienImGui.h"
 #include "ExportStatisticsDialog.h"
+#include "StatisticsFileRecorder.h"
 
 _StatisticsWindow::_StatisticsWindow(SimulationController const& simController)
     : _AlienWindow("Statistics", "windows.statistics", false)
     , _simController(simController)
 {
-    _exportStatisticsDialog = std::make_shared<_ExportStatisticsDialog>();
+    _statisticsFileRecorder = std::make_shared<_StatisticsFileRecorder>();
+    _exportStatisticsDialog = std::make_shared<_ExportStatisticsDialog>(_statisticsFileRecorder);
 }
 
 namespace
@@ -40,6 +42,7 @@ void _StatisticsWindow::reset()
 {
     _liveStatistics = LiveStatistics();
     _longtermStatistics = LongtermStatistics();
+    _lastStatisticsState = std::nullopt;
 }
 
 void _StatisticsWindow::processIntern()
@@ -145,6 +148,30 @@ void _StatisticsWindow::processLiveStatistics()
         ImGui::TableSetColumnIndex(1);
         processLivePlot(8, _liveStatistics.datas[14]);
 
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Created connections");
+        ImGui::TableSetColumnIndex(1);
+        processLivePlot(9, _liveStatistics.datas[15]);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Destroyed connections");
+        ImGui::TableSetColumnIndex(1);
+        processLivePlot(10, _liveStatistics.datas[16]);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Deleted cells");
+        ImGui::TableSetColumnIndex(1);
+        processLivePlot(11, _liveStatistics.datas[17]);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Moved tokens");
+        ImGui::TableSetColumnIndex(1);
+        processLivePlot(12, _liveStatistics.datas[18]);
+
         ImPlot::PopColormap();
         ImGui::EndTable();
     }
@@ -172,7 +199,7 @@ void _StatisticsWindow::processLongtermStatistics()
         }
 
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(0, _longtermStatistics.datas[0]);
+        processLongtermPlot(0, 0);
         if (_showCellsByColor) {
             processLongtermPlotForCellsByColor(1);
         }
@@ -181,19 +208,19 @@ void _StatisticsWindow::processLongtermStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Cell connections");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(2, _longtermStatistics.datas[8]);
+        processLongtermPlot(2, 8);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Energy particles");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(3, _longtermStatistics.datas[9]);
+        processLongtermPlot(3, 9);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Tokens");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(4, _longtermStatistics.datas[10]);
+        processLongtermPlot(4, 10);
         ImPlot::PopColormap();
         ImGui::EndTable();
     }
@@ -213,25 +240,49 @@ void _StatisticsWindow::processLongtermStatistics()
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Created cells");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(5, _longtermStatistics.datas[11]);
+        processLongtermPlot(5, 11);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Successful attacks");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(6, _longtermStatistics.datas[12]);
+        processLongtermPlot(6, 12);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Failed attacks");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(7, _longtermStatistics.datas[13]);
+        processLongtermPlot(7, 13);
 
         ImGui::TableNextRow();
         ImGui::TableSetColumnIndex(0);
         AlienImGui::Text("Muscle activities");
         ImGui::TableSetColumnIndex(1);
-        processLongtermPlot(8, _longtermStatistics.datas[14]);
+        processLongtermPlot(8, 14);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Created connections");
+        ImGui::TableSetColumnIndex(1);
+        processLongtermPlot(9, 15);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Destroyed connections");
+        ImGui::TableSetColumnIndex(1);
+        processLongtermPlot(10, 16);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Deleted cells");
+        ImGui::TableSetColumnIndex(1);
+        processLongtermPlot(11, 17);
+
+        ImGui::TableNextRow();
+        ImGui::TableSetColumnIndex(0);
+        AlienImGui::Text("Moved tokens");
+        ImGui::TableSetColumnIndex(1);
+        processLongtermPlot(12, 18);
 
         ImPlot::PopColormap();
         ImGui::EndTable();
@@ -322,9 +373,10 @@ void _StatisticsWindow::processLivePlotForCellsByColor(int row)
     ImGui::PopID();
 }
 
-void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& valueHistory)
+void _StatisticsWindow::processLongtermPlot(int row, int colIndex)
 {
-    auto maxValue = getMax(valueHistory);
+    auto const& valueHistory = _longtermStatistics.datas[colIndex];
+    auto maxValue = getMax(_longtermStatistics.datasMax[colIndex]);
 
     ImGui::PushID(row);
     ImPlot::PushStyleColor(ImPlotCol_FrameBg, (ImU32)ImColor(0.0f, 0.0f, 0.0f, ImGui::GetStyle().Alpha));
@@ -352,6 +404,17 @@ void _StatisticsWindow::processLongtermPlot(int row, std::vector<float> const& v
         ImPlot::PushStyleColor(ImPlotCol_Line, color);
         ImPlot::PlotLine(
             "##", _longtermStatistics.timestepHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
+
+        //band between the minima and maxima of the downsampled bins
+        ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.4f);
+        ImPlot::PlotShaded(
+            "##",
+            _longtermStatistics.timestepHistory.data(),
+            _longtermStatistics.datasMin[colIndex].data(),
+            _longtermStatistics.datasMax[colIndex].data(),
+            toInt(valueHistory.size()));
+        ImPlot::PopStyleVar();
+
         ImPlot::PushStyleVar(ImPlotStyleVar_FillAlpha, 0.25f);
         ImPlot::PlotShaded(
             "##", _longtermStatistics.timestepHistory.data(), valueHistory.data(), toInt(valueHistory.size()));
@@ -401,10 +464,20 @@ void _StatisticsWindow::processLongtermPlotForCellsByColor(int row)
 
 void _StatisticsWindow::processBackground()
 {
+    //the statistics only change when the world does, so with an unchanged timestep and world
+    //version the engine is not queried at all (e.g. while the simulation is paused)
+    auto statisticsState = std::make_pair(_simController->getCurrentTimestep(), _simController->getWorldVersion());
+    if (_lastStatisticsState == statisticsState) {
+        return;
+    }
+    _lastStatisticsState = statisticsState;
+
     auto newStatistics = _simController->getStatistics();
     _liveStatistics.add(newStatistics);
 
     _longtermStatistics.add(newStatistics);
+
+    _statisticsFileRecorder->record(newStatistics);
 }
 
 uint32_t _StatisticsWindow::getCellColor(int i) const
@@ -20,7 +20,7 @@ private:
 
     void processLivePlot(int row, std::vector<float> const& valueHistory);
     void processLivePlotForCellsByColor(int row);
-    void processLongtermPlot(int row, std::vector<float> const& valueHistory);
+    void processLongtermPlot(int row, int colIndex);
     void processLongtermPlotForCellsByColor(int row);
 
     void processBackground() override;
@@ -29,10 +29,13 @@ private:
 
     SimulationController _simController;
     ExportStatisticsDialog _exportStatisticsDialog;
+    StatisticsFileRecorder _statisticsFileRecorder;
 
     bool _live = true;
     bool _showCellsByColor = false;
 
     LiveStatistics _liveStatistics;
     LongtermStatistics _longtermStatistics;
+
+    std::optional<std::pair<uint64_t, uint64_t>> _lastStatisticsState;  //timestep and world version of the last sample
 };
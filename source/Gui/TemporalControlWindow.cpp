@@ -43,6 +43,8 @@ void _TemporalControlWindow::processIntern()
     processSnapshotButton();
     ImGui::SameLine();
     processRestoreButton();
+    ImGui::SameLine();
+    processRewindButton();
 
     AlienImGui::Separator();
 
@@ -52,6 +54,10 @@ void _TemporalControlWindow::processIntern()
 
         AlienImGui::Separator();
         processTpsRestriction();
+        processFastForward();
+
+        AlienImGui::Separator();
+        processCheckpoints();
     }
     ImGui::EndChild();
 }
@@ -94,6 +100,44 @@ void _TemporalControlWindow::processTpsRestriction()
     ImGui::EndDisabled();
 }
 
+void _TemporalControlWindow::processFastForward()
+{
+    if (AlienImGui::ToggleButton(
+            AlienImGui::ToggleButtonParameters()
+                .name("Fast forward")
+                .tooltip("Runs the simulation with all instrumentation switched off. The statistics are reduced to "
+                         "entity counts and no cell events are recorded while active."),
+            _fastForward)) {
+        _simController->setTurboMode(_fastForward);
+    }
+}
+
+void _TemporalControlWindow::processCheckpoints()
+{
+    if (AlienImGui::ToggleButton(AlienImGui::ToggleButtonParameters().name("Checkpoints"), _checkpointsEnabled)) {
+        _checkpointCacheState = std::nullopt;
+    }
+    ImGui::SameLine();
+    ImGui::BeginDisabled(!_checkpointsEnabled);
+    ImGui::PushItemWidth(ImGui::GetContentRegionAvail().x);
+    ImGui::SliderInt("##checkpointInterval", &_checkpointInterval, 100, 100000, "every %d time steps", ImGuiSliderFlags_Logarithmic);
+    if (_checkpointsEnabled) {
+        _simController->setCheckpointInterval(_checkpointInterval);
+    } else {
+        _simController->setCheckpointInterval(0);
+    }
+    ImGui::PopItemWidth();
+    ImGui::EndDisabled();
+
+    auto const& checkpointTimesteps = getCachedCheckpointTimesteps();
+    if (!checkpointTimesteps.empty()) {
+        ImGui::Text(
+            "%d checkpoints (back to time step %s)",
+            toInt(checkpointTimesteps.size()),
+            StringHelper::format(checkpointTimesteps.front()).c_str());
+    }
+}
+
 void _TemporalControlWindow::processRunButton()
 {
     ImGui::BeginDisabled(_simController->isSimulationRunning());
@@ -157,3 +201,27 @@ void _TemporalControlWindow::processRestoreButton()
     }
     ImGui::EndDisabled();
 }
+
+void _TemporalControlWindow::processRewindButton()
+{
+    ImGui::BeginDisabled(getCachedCheckpointTimesteps().empty());
+    if (AlienImGui::ToolbarButton(ICON_FA_HISTORY)) {
+        _statisticsWindow->reset();
+        _simController->rewindToLastCheckpoint();
+        _history.clear();
+        _checkpointCacheState = std::nullopt;
+    }
+    ImGui::EndDisabled();
+}
+
+std::vector<uint64_t> const& _TemporalControlWindow::getCachedCheckpointTimesteps()
+{
+    //checkpoints are only captured when the simulation advances, so the list is re-read once per
+    //world change instead of several times per rendered frame
+    auto checkpointState = std::make_pair(_simController->getCurrentTimestep(), _simController->getWorldVersion());
+    if (_checkpointCacheState != checkpointState) {
+        _checkpointCacheState = checkpointState;
+        _cachedCheckpointTimesteps = _simController->getCheckpointTimesteps();
+    }
+    return _cachedCheckpointTimesteps;
+}
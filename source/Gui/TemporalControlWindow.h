@@ -19,6 +19,8 @@ private:
     void processTpsInfo();
     void processTotalTimestepsInfo();
     void processTpsRestriction();
+    void processFastForward();
+    void processCheckpoints();
 
     void processRunButton();
     void processPauseButton();
@@ -26,6 +28,9 @@ private:
     void processStepForwardButton();
     void processSnapshotButton();
     void processRestoreButton();
+    void processRewindButton();
+
+    std::vector<uint64_t> const& getCachedCheckpointTimesteps();
 
     SimulationController _simController; 
     StatisticsWindow _statisticsWindow;
@@ -41,4 +46,11 @@ private:
 
     bool _slowDown = false;
     int _tpsRestriction = 30;
+
+    bool _fastForward = false;
+
+    bool _checkpointsEnabled = false;
+    int _checkpointInterval = 1000;
+    std::vector<uint64_t> _cachedCheckpointTimesteps;
+    std::optional<std::pair<uint64_t, uint64_t>> _checkpointCacheState;  //timestep and world version of the last query
 };
\ No newline at end of file
@@ -0,0 +1,60 @@
+#include "UndoBuffer.h"
+
+namespace
+{
+    //bounds the memory of all snapshots together; large enough for several region-sized edits,
+    //small against the multi-GB footprint of a full-world snapshot
+    uint64_t const MemoryBudget = 256 * 1024 * 1024;
+}
+
+void _UndoBuffer::capture(DataDescription const& affectedData, RestoreMode mode, bool includeClusters)
+{
+    auto memory = estimateMemory(affectedData);
+    if (memory > MemoryBudget) {
+        return;    //a snapshot that alone exceeds the budget would evict everything and then be evicted itself
+    }
+    _entries.emplace_back(Entry{{affectedData, mode, includeClusters}, memory});
+    _usedMemory += memory;
+
+    while (_usedMemory > MemoryBudget && !_entries.empty()) {
+        _usedMemory -= _entries.front().memory;
+        _entries.pop_front();
+    }
+}
+
+bool _UndoBuffer::canUndo() const
+{
+    return !_entries.empty();
+}
+
+std::optional<_UndoBuffer::Snapshot> _UndoBuffer::fetchSnapshotForUndo()
+{
+    if (_entries.empty()) {
+        return std::nullopt;
+    }
+    auto entry = std::move(_entries.back());
+    _entries.pop_back();
+    _usedMemory -= entry.memory;
+    return std::move(entry.snapshot);
+}
+
+void _UndoBuffer::clear()
+{
+    _entries.clear();
+    _usedMemory = 0;
+}
+
+uint64_t _UndoBuffer::estimateMemory(DataDescription const& data)
+{
+    uint64_t result = 0;
+    for (auto const& cell : data.cells) {
+        result += sizeof(CellDescription) + cell.metadata.name.size() + cell.metadata.description.size()
+            + cell.metadata.computerSourcecode.size() + cell.cellFeature.constData.size()
+            + cell.cellFeature.volatileData.size() + cell.connections.size() * sizeof(ConnectionDescription);
+        for (auto const& token : cell.tokens) {
+            result += sizeof(TokenDescription) + token.data.size();
+        }
+    }
+    result += data.particles.size() * sizeof(ParticleDescription);
+    return result;
+}
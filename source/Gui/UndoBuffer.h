@@ -0,0 +1,44 @@
+#pragma once
+
+#include <deque>
+
+#include "EngineInterface/Descriptions.h"
+#include "Definitions.h"
+
+//snapshots of the entities affected by an editor operation; restoring one replaces only what the
+//operation touched instead of reloading the whole world. The total memory is bounded: when the
+//budget is exceeded the oldest snapshots are evicted
+class _UndoBuffer
+{
+public:
+    enum class RestoreMode
+    {
+        AddEntities,        //the operation removed the captured entities; undo re-adds them
+        ReplaceSelection    //the operation modified the entities in place; undo replaces the selection
+    };
+
+    struct Snapshot
+    {
+        DataDescription data;
+        RestoreMode mode;
+        bool includeClusters;
+    };
+
+    void capture(DataDescription const& affectedData, RestoreMode mode, bool includeClusters);
+
+    bool canUndo() const;
+    std::optional<Snapshot> fetchSnapshotForUndo();
+
+    void clear();
+
+private:
+    static uint64_t estimateMemory(DataDescription const& data);
+
+    struct Entry
+    {
+        Snapshot snapshot;
+        uint64_t memory = 0;
+    };
+    std::deque<Entry> _entries;
+    uint64_t _usedMemory = 0;
+};
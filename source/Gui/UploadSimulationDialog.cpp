@@ -1,6 +1,9 @@
 #include "UploadSimulationDialog.h"
 
+#include <chrono>
+
 #include <imgui.h>
+#include <stb_image_write.h>
 
 #include "EngineInterface/Serializer.h"
 #include "EngineInterface/SimulationController.h"
@@ -12,6 +15,40 @@
 #include "StyleRepository.h"
 #include "BrowserWindow.h"
 
+namespace
+{
+    auto const MaxPreviewSize = 256;  //in pixels
+
+    //renders the whole world at thumbnail scale and encodes it as png; the preview is cached on
+    //the server and shown in the browser table
+    std::string createPreview(SimulationController const& simController)
+    {
+        auto worldSize = simController->getWorldSize();
+        auto zoom = std::min(toFloat(MaxPreviewSize) / toFloat(worldSize.x), toFloat(MaxPreviewSize) / toFloat(worldSize.y));
+        IntVector2D imageSize{std::max(1, toInt(toFloat(worldSize.x) * zoom)), std::max(1, toInt(toFloat(worldSize.y) * zoom))};
+        auto imageData = simController->getImageData({0, 0}, {toFloat(worldSize.x), toFloat(worldSize.y)}, imageSize, zoom);
+
+        std::vector<unsigned char> rgb(static_cast<size_t>(imageSize.x) * imageSize.y * 3);
+        for (size_t i = 0; i < imageData.size(); ++i) {
+            auto pixel = imageData[i];
+            rgb[i * 3] = static_cast<unsigned char>((pixel >> 8) & 0xff);
+            rgb[i * 3 + 1] = static_cast<unsigned char>((pixel >> 24) & 0xff);
+            rgb[i * 3 + 2] = static_cast<unsigned char>((pixel >> 40) & 0xff);
+        }
+
+        std::string result;
+        stbi_write_png_to_func(
+            [](void* context, void* data, int size) { static_cast<std::string*>(context)->append(static_cast<char const*>(data), size); },
+            &result,
+            imageSize.x,
+            imageSize.y,
+            3,
+            rgb.data(),
+            imageSize.x * 3);
+        return result;
+    }
+}
+
 _UploadSimulationDialog::_UploadSimulationDialog(
     BrowserWindow const& browserWindow,
     SimulationController const& simController,
@@ -34,6 +71,16 @@ _UploadSimulationDialog::~_UploadSimulationDialog()
 
 void _UploadSimulationDialog::process()
 {
+    if (_pendingUpload && _pendingUpload->wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+        auto success = _pendingUpload->get();
+        _pendingUpload.reset();
+        if (success) {
+            _browserWindow->onRefresh();
+        } else {
+            MessageDialog::getInstance().show("Error", "Failed to upload simulation.");
+        }
+    }
+
     if (!_show) {
         return;
     }
@@ -86,28 +133,35 @@ void _UploadSimulationDialog::show()
 
 void _UploadSimulationDialog::onUpload()
 {
+    if (_pendingUpload) {
+        return;    //an upload is already underway
+    }
+
+    //the world extraction and the preview rendering need the GPU and stay on this thread; the
+    //expensive rest (serialization, recompression, transfer) moves to a background task
     DeserializedSimulation sim;
     sim.timestep = static_cast<uint32_t>(_simController->getCurrentTimestep());
     sim.settings = _simController->getSettings();
     sim.symbolMap = _simController->getSymbolMap();
     sim.content = _simController->getClusteredSimulationData();
-
-    std::string content, settings, symbolMap;
-    if (!Serializer::serializeSimulationToStrings(content, settings, symbolMap, sim)) {
-        MessageDialog::getInstance().show("Save simulation", "The simulation could not be uploaded.");
-        return;
-    }
-
-    if (!_networkController->uploadSimulation(
-        _simName,
-        _simDescription,
-        {sim.settings.generalSettings.worldSizeX, sim.settings.generalSettings.worldSizeY},
-        sim.content.getNumberOfCellAndParticles(),
-        content,
-        settings,
-        symbolMap)) {
-        MessageDialog::getInstance().show("Error", "Failed to upload simulation.");
-        return;
-    }
-    _browserWindow->onRefresh();
+    auto preview = createPreview(_simController);
+
+    auto networkController = _networkController;
+    auto simName = _simName;
+    auto simDescription = _simDescription;
+    _pendingUpload = std::async(std::launch::async, [networkController, simName, simDescription, sim = std::move(sim), preview = std::move(preview)] {
+        std::string content, settings, symbolMap;
+        if (!Serializer::serializeSimulationToStrings(content, settings, symbolMap, sim)) {
+            return false;
+        }
+        return networkController->uploadSimulation(
+            simName,
+            simDescription,
+            {sim.settings.generalSettings.worldSizeX, sim.settings.generalSettings.worldSizeY},
+            sim.content.getNumberOfCellAndParticles(),
+            content,
+            settings,
+            symbolMap,
+            preview);
+    });
 }
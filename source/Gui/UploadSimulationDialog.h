@@ -1,5 +1,7 @@
 #pragma once
 
+#include <future>
+
 #include "EngineInterface/Definitions.h"
 #include "Definitions.h"
 
@@ -26,4 +28,8 @@ private:
 
     std::string _origSimName;
     std::string _origSimDescription;
+
+    //serialization, recompression and transfer run on a background task; the outcome is picked up
+    //in process()
+    std::optional<std::future<bool>> _pendingUpload;
 };
\ No newline at end of file
@@ -17,6 +17,7 @@ float _Viewport::getZoomFactor() const
 void _Viewport::setZoomFactor(float zoomFactor)
 {
     _zoomFactor = zoomFactor;
+    _visibleWorldRect.reset();
 }
 
 RealVector2D _Viewport::getCenterInWorldPos() const
@@ -27,6 +28,7 @@ RealVector2D _Viewport::getCenterInWorldPos() const
 void _Viewport::setCenterInWorldPos(RealVector2D const& worldCenter)
 {
     _worldCenter = worldCenter;
+    _visibleWorldRect.reset();
 }
 
 IntVector2D _Viewport::getViewSize() const
@@ -37,12 +39,14 @@ IntVector2D _Viewport::getViewSize() const
 void _Viewport::setViewSize(IntVector2D const& viewSize)
 {
     _viewSize = viewSize;
+    _visibleWorldRect.reset();
 }
 
 void _Viewport::zoom(IntVector2D const& viewPos, float factor)
 {
     auto worldPos = mapViewToWorldPosition({toFloat(viewPos.x), toFloat(viewPos.y)});
     _zoomFactor *= factor;
+    _visibleWorldRect.reset();
     centerTo(worldPos, viewPos);
 }
 
@@ -62,6 +66,7 @@ void _Viewport::centerTo(RealVector2D const& worldPosition, IntVector2D const& v
         toFloat(viewPos.x) - toFloat(_viewSize.x) / 2.0f, toFloat(viewPos.y) - toFloat(_viewSize.y) / 2.0f};
     auto deltaWorldPos = deltaViewPos / _zoomFactor;
     _worldCenter = worldPosition - deltaWorldPos;
+    _visibleWorldRect.reset();
 }
 
 RealVector2D _Viewport::mapViewToWorldPosition(RealVector2D const& viewPos) const
@@ -80,7 +85,12 @@ RealVector2D _Viewport::mapWorldToViewPosition(RealVector2D const& worldPos) con
 
 RealRect _Viewport::getVisibleWorldRect() const
 {
-    auto topLeft = mapViewToWorldPosition(RealVector2D{0, 0});
-    auto bottomRight = mapViewToWorldPosition(RealVector2D{toFloat(_viewSize.x - 1), toFloat(_viewSize.y - 1)});
-    return {topLeft, bottomRight};
+    //computed once per viewport change: the scrollbars alone query the rect several times per
+    //frame for hit testing
+    if (!_visibleWorldRect) {
+        auto topLeft = mapViewToWorldPosition(RealVector2D{0, 0});
+        auto bottomRight = mapViewToWorldPosition(RealVector2D{toFloat(_viewSize.x - 1), toFloat(_viewSize.y - 1)});
+        _visibleWorldRect = RealRect{topLeft, bottomRight};
+    }
+    return *_visibleWorldRect;
 }
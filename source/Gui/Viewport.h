@@ -25,6 +25,10 @@ public:
     void centerTo(RealVector2D const& worldPosition, IntVector2D const& viewPos);
     RealVector2D mapViewToWorldPosition(RealVector2D const& viewPos) const;
     RealVector2D mapWorldToViewPosition(RealVector2D const& worldPos) const;
+
+    //the single source of the culling bounds: the rendering, the overlay extraction and the
+    //scrollbars all consume this rect, so they agree on the visible area; the result is cached
+    //until the viewport changes
     RealRect getVisibleWorldRect() const;
 
 private:
@@ -32,4 +36,6 @@ private:
     float _zoomSensitivity = 1.03f;
     RealVector2D _worldCenter;
     IntVector2D _viewSize;
+
+    mutable std::optional<RealRect> _visibleWorldRect;
 };
\ No newline at end of file